@@ -0,0 +1,504 @@
+/*****************************************************************************
+ * bench_atsc_text.c: ATSC multiple_string_structure decoder benchmark
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Builds the guide of a full PSIP transport stream (EIT-0 to EIT-127, 16
+ * days) with Huffman compressed titles and descriptions, then decodes it
+ * with the lookup table decoder of the library and with a bit by bit tree
+ * walk, checks that both give back the original text and prints their
+ * throughput. The Annex C tables of A/65 are not distributed with
+ * libdvbpsi, the trees used here are computed from the guide itself in the
+ * same layout.
+ *
+ * Usage: bench_atsc_text [iterations]
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* The libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/atsc_text.h"
+#else
+#include <dvbpsi/atsc_text.h>
+#endif
+
+#define CHANNELS            30
+#define EITS                128     /* 3 hours each */
+#define EVENTS_PER_EIT      3
+#define EVENTS              (CHANNELS * EITS * EVENTS_PER_EIT)
+
+#define CONTEXTS            128
+#define ESCAPE              0x1b
+
+/*****************************************************************************
+ * Guide text
+ *****************************************************************************/
+static const char *ppsz_words[] =
+{
+    "News", "Weather", "Sports", "Tonight", "Live", "Movie", "the", "Adventures",
+    "of", "Morning", "Show", "Kitchen", "Nature", "World", "Cup", "Classic",
+    "Cinema", "Family", "Hour", "Comedy", "Drama", "Special", "Report", "Late",
+    "Night", "Music", "Awards", "Caf\xe9", "and", "a", "in", "with", "their",
+    "new", "life", "city", "game", "final", "story", "season", "episode",
+    "friends", "home", "team", "journey", "secret", "history", "America",
+};
+#define WORDS (sizeof(ppsz_words) / sizeof(ppsz_words[0]))
+
+static uint32_t i_seed = 1;
+
+static unsigned int Random(unsigned int i_max)
+{
+    i_seed = i_seed * 1103515245 + 12345;
+    return (i_seed >> 16) % i_max;
+}
+
+static size_t MakeText(char *psz_text, unsigned int i_min, unsigned int i_max)
+{
+    size_t i_length = 0;
+
+    psz_text[0] = '\0';
+    while (i_length < i_min)
+    {
+        const char *psz_word = ppsz_words[Random(WORDS)];
+        size_t i_word = strlen(psz_word);
+        if (i_length + i_word + 2 > i_max)
+            break;
+        if (i_length)
+            psz_text[i_length++] = ' ';
+        memcpy(psz_text + i_length, psz_word, i_word + 1);
+        i_length += i_word;
+    }
+    return i_length;
+}
+
+/*****************************************************************************
+ * Order-1 Huffman code in the A/65 Annex C layout
+ *****************************************************************************/
+typedef struct code_s
+{
+    uint32_t    pi_count[CONTEXTS][CONTEXTS];
+    uint64_t    pi_code[CONTEXTS][CONTEXTS];
+    uint8_t     pi_length[CONTEXTS][CONTEXTS];
+
+    uint8_t     p_tree[2 * CONTEXTS + CONTEXTS * 2 * (CONTEXTS - 1)];
+    size_t      i_tree;
+} code_t;
+
+typedef struct node_s
+{
+    uint32_t    i_weight;
+    int         i_child[2];
+    int         i_symbol;       /* -1 for internal nodes */
+} node_t;
+
+static void CodeCount(code_t *p_code, const char *psz_text)
+{
+    unsigned int i_context = 0;
+
+    for (const uint8_t *p = (const uint8_t *)psz_text; ; p++)
+    {
+        unsigned int i_symbol = *p < 0x80 ? *p : ESCAPE;
+        p_code->pi_count[i_context][i_symbol]++;
+        if (*p == '\0')
+            break;
+        i_context = *p < 0x80 ? *p : 0;
+    }
+}
+
+static void CodeAssign(code_t *p_code, unsigned int i_context, const node_t *p_nodes,
+                       int i_node, uint64_t i_bits, uint8_t i_length)
+{
+    if (p_nodes[i_node].i_symbol >= 0)
+    {
+        p_code->pi_code[i_context][p_nodes[i_node].i_symbol] = i_bits;
+        p_code->pi_length[i_context][p_nodes[i_node].i_symbol] = i_length;
+        return;
+    }
+    CodeAssign(p_code, i_context, p_nodes, p_nodes[i_node].i_child[0], i_bits << 1, i_length + 1);
+    CodeAssign(p_code, i_context, p_nodes, p_nodes[i_node].i_child[1], (i_bits << 1) | 1, i_length + 1);
+}
+
+/* Build the tree of one prior symbol and append it to p_tree */
+static void CodeBuild(code_t *p_code, unsigned int i_context)
+{
+    node_t p_nodes[2 * CONTEXTS];
+    bool pb_used[2 * CONTEXTS];
+    int pi_index[2 * CONTEXTS], pi_queue[CONTEXTS];
+    int i_nodes = 0;
+
+    /* All printable characters, END and ESCAPE can follow any character */
+    for (int i = 0; i < CONTEXTS; i++)
+    {
+        uint32_t i_weight = p_code->pi_count[i_context][i];
+        if (i >= 0x20 && i < 0x7f)
+            i_weight++;
+        if (i == 0 || i == ESCAPE)
+            i_weight++;
+        if (i_weight == 0)
+            continue;
+        p_nodes[i_nodes].i_weight = i_weight;
+        p_nodes[i_nodes].i_symbol = i;
+        pb_used[i_nodes++] = false;
+    }
+
+    int i_leaves = i_nodes;
+    for (int i_merge = 0; i_merge < i_leaves - 1; i_merge++)
+    {
+        int pi_min[2] = { -1, -1 };
+        for (int i = 0; i < i_nodes; i++)
+        {
+            if (pb_used[i])
+                continue;
+            if (pi_min[0] < 0 || p_nodes[i].i_weight < p_nodes[pi_min[0]].i_weight)
+            {
+                pi_min[1] = pi_min[0];
+                pi_min[0] = i;
+            }
+            else if (pi_min[1] < 0 || p_nodes[i].i_weight < p_nodes[pi_min[1]].i_weight)
+                pi_min[1] = i;
+        }
+        pb_used[pi_min[0]] = pb_used[pi_min[1]] = true;
+        p_nodes[i_nodes].i_weight = p_nodes[pi_min[0]].i_weight + p_nodes[pi_min[1]].i_weight;
+        p_nodes[i_nodes].i_child[0] = pi_min[0];
+        p_nodes[i_nodes].i_child[1] = pi_min[1];
+        p_nodes[i_nodes].i_symbol = -1;
+        pb_used[i_nodes++] = false;
+    }
+
+    int i_root = i_nodes - 1;
+    CodeAssign(p_code, i_context, p_nodes, i_root, 0, 0);
+
+    /* Number the internal nodes breadth first, the root is node 0 */
+    int i_head = 0, i_tail = 0;
+    pi_queue[i_tail++] = i_root;
+    while (i_head < i_tail)
+    {
+        int i_node = pi_queue[i_head];
+        pi_index[i_node] = i_head++;
+        for (int i = 0; i < 2; i++)
+            if (p_nodes[p_nodes[i_node].i_child[i]].i_symbol < 0)
+                pi_queue[i_tail++] = p_nodes[i_node].i_child[i];
+    }
+
+    p_code->p_tree[2 * i_context] = p_code->i_tree >> 8;
+    p_code->p_tree[2 * i_context + 1] = p_code->i_tree & 0xff;
+    for (int i = 0; i < i_tail; i++)
+    {
+        for (int j = 0; j < 2; j++)
+        {
+            const node_t *p_child = &p_nodes[p_nodes[pi_queue[i]].i_child[j]];
+            p_code->p_tree[p_code->i_tree++] = p_child->i_symbol >= 0 ?
+                0x80 | p_child->i_symbol : pi_index[p_nodes[pi_queue[i]].i_child[j]];
+        }
+    }
+}
+
+static void CodeBuildAll(code_t *p_code)
+{
+    p_code->i_tree = 2 * CONTEXTS;
+    for (unsigned int i = 0; i < CONTEXTS; i++)
+        CodeBuild(p_code, i);
+}
+
+/*****************************************************************************
+ * Encoding
+ *****************************************************************************/
+typedef struct bit_writer_s
+{
+    uint8_t    *p_data;
+    size_t      i_size;
+    size_t      i_bits;
+} bit_writer_t;
+
+static bool PutBits(bit_writer_t *p_writer, uint64_t i_value, unsigned int i_count)
+{
+    for (unsigned int i = i_count; i > 0; i--, p_writer->i_bits++)
+    {
+        size_t i_byte = p_writer->i_bits >> 3;
+        if (i_byte >= p_writer->i_size)
+            return false;
+        if ((p_writer->i_bits & 7) == 0)
+            p_writer->p_data[i_byte] = 0;
+        if ((i_value >> (i - 1)) & 1)
+            p_writer->p_data[i_byte] |= 0x80 >> (p_writer->i_bits & 7);
+    }
+    return true;
+}
+
+/* Encode a single string, single segment multiple_string_structure */
+static size_t Encode(const code_t *p_code, uint8_t i_compression, const char *psz_text,
+                     uint8_t *p_mss, size_t i_size)
+{
+    bit_writer_t writer = { p_mss + 8, i_size - 8 < 255 ? i_size - 8 : 255, 0 };
+    unsigned int i_context = 0;
+
+    for (const uint8_t *p = (const uint8_t *)psz_text; ; p++)
+    {
+        unsigned int i_symbol = *p < 0x80 ? *p : ESCAPE;
+        if (!PutBits(&writer, p_code->pi_code[i_context][i_symbol],
+                     p_code->pi_length[i_context][i_symbol]))
+            return 0;
+        if (i_symbol == ESCAPE && !PutBits(&writer, *p, 8))
+            return 0;
+        if (*p == '\0')
+            break;
+        i_context = *p < 0x80 ? *p : 0;
+    }
+
+    size_t i_bytes = (writer.i_bits + 7) >> 3;
+    p_mss[0] = 1;                       /* number_strings */
+    memcpy(p_mss + 1, "eng", 3);
+    p_mss[4] = 1;                       /* number_segments */
+    p_mss[5] = i_compression;
+    p_mss[6] = 0xff;                    /* mode */
+    p_mss[7] = i_bytes;
+    return 8 + i_bytes;
+}
+
+/*****************************************************************************
+ * Bit by bit reference decoder
+ *****************************************************************************/
+static size_t DecodeBitByBit(const uint8_t *p_tree, const uint8_t *p_mss, char *psz_text)
+{
+    const uint8_t *p_data = p_mss + 8;
+    size_t i_total = 8 * (size_t)p_mss[7];
+    size_t i_pos = 0, i_length = 0;
+    unsigned int i_context = 0;
+
+    while (i_pos < i_total)
+    {
+        const uint8_t *p_root = p_tree + ((p_tree[2 * i_context] << 8) | p_tree[2 * i_context + 1]);
+        unsigned int i_node = 0, i_char;
+
+        for (;;)
+        {
+            if (i_pos >= i_total)
+                goto end;
+            unsigned int i_bit = (p_data[i_pos >> 3] >> (7 - (i_pos & 7))) & 1;
+            uint8_t i_child = p_root[2 * i_node + i_bit];
+            i_pos++;
+            if (i_child & 0x80)
+            {
+                i_char = i_child & 0x7f;
+                break;
+            }
+            i_node = i_child;
+        }
+
+        if (i_char == 0)
+            break;
+        if (i_char == ESCAPE)
+        {
+            i_char = 0;
+            for (int i = 0; i < 8; i++, i_pos++)
+                i_char = (i_char << 1) | ((p_data[i_pos >> 3] >> (7 - (i_pos & 7))) & 1);
+        }
+
+        /* ISO 8859-1 to UTF-8 */
+        if (i_char < 0x80)
+            psz_text[i_length++] = i_char;
+        else
+        {
+            psz_text[i_length++] = 0xc0 | (i_char >> 6);
+            psz_text[i_length++] = 0x80 | (i_char & 0x3f);
+        }
+        i_context = i_char < 0x80 ? i_char : 0;
+    }
+end:
+    psz_text[i_length] = '\0';
+    return i_length;
+}
+
+/*****************************************************************************
+ * Latin1ToUTF8
+ *****************************************************************************/
+static void Latin1ToUTF8(const char *psz_in, char *psz_out)
+{
+    for (const uint8_t *p = (const uint8_t *)psz_in; *p; p++)
+    {
+        if (*p < 0x80)
+            *psz_out++ = *p;
+        else
+        {
+            *psz_out++ = 0xc0 | (*p >> 6);
+            *psz_out++ = 0x80 | (*p & 0x3f);
+        }
+    }
+    *psz_out = '\0';
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(int i_argc, char *pa_argv[])
+{
+    int i_iterations = i_argc > 1 ? atoi(pa_argv[1]) : 20;
+    if (i_iterations <= 0)
+        i_iterations = 1;
+
+    /* Titles are EIT title_text, descriptions ETT extended_text_message */
+    char (*p_titles)[64] = malloc(EVENTS * sizeof(*p_titles));
+    char (*p_descriptions)[256] = malloc(EVENTS * sizeof(*p_descriptions));
+    uint8_t (*p_title_mss)[256] = malloc(EVENTS * sizeof(*p_title_mss));
+    uint8_t (*p_description_mss)[264] = malloc(EVENTS * sizeof(*p_description_mss));
+    code_t *p_title_code = calloc(1, sizeof(code_t));
+    code_t *p_description_code = calloc(1, sizeof(code_t));
+    dvbpsi_atsc_text_t *p_text = dvbpsi_atsc_text_new();
+    int i_ret = 1;
+
+    if (!p_titles || !p_descriptions || !p_title_mss || !p_description_mss ||
+        !p_title_code || !p_description_code || !p_text)
+    {
+        fprintf(stderr, "out of memory\n");
+        goto out;
+    }
+
+    for (int i = 0; i < EVENTS; i++)
+    {
+        MakeText(p_titles[i], 10, sizeof(p_titles[i]));
+        MakeText(p_descriptions[i], 150, 240);
+        CodeCount(p_title_code, p_titles[i]);
+        CodeCount(p_description_code, p_descriptions[i]);
+    }
+    CodeBuildAll(p_title_code);
+    CodeBuildAll(p_description_code);
+
+    if (!dvbpsi_atsc_text_set_huffman(p_text, DVBPSI_ATSC_TEXT_HUFFMAN_TITLE,
+                                      p_title_code->p_tree, p_title_code->i_tree) ||
+        !dvbpsi_atsc_text_set_huffman(p_text, DVBPSI_ATSC_TEXT_HUFFMAN_DESCRIPTION,
+                                      p_description_code->p_tree, p_description_code->i_tree))
+    {
+        fprintf(stderr, "cannot load the decode trees\n");
+        goto out;
+    }
+
+    size_t i_compressed = 0, i_uncompressed = 0;
+    for (int i = 0; i < EVENTS; i++)
+    {
+        size_t i_title = Encode(p_title_code, DVBPSI_ATSC_TEXT_HUFFMAN_TITLE, p_titles[i],
+                                p_title_mss[i], sizeof(p_title_mss[i]));
+        size_t i_description = Encode(p_description_code, DVBPSI_ATSC_TEXT_HUFFMAN_DESCRIPTION,
+                                      p_descriptions[i], p_description_mss[i],
+                                      sizeof(p_description_mss[i]));
+        if (i_title == 0 || i_description == 0)
+        {
+            fprintf(stderr, "event %d does not fit in a segment\n", i);
+            goto out;
+        }
+        i_compressed += i_title + i_description;
+        i_uncompressed += strlen(p_titles[i]) + strlen(p_descriptions[i]);
+    }
+
+    printf("guide: %d channels, %d events, %zu text bytes, %zu compressed bytes\n",
+           CHANNELS, EVENTS, i_uncompressed, i_compressed);
+
+    /* Check both decoders against the original text */
+    for (int i = 0; i < EVENTS; i++)
+    {
+        char psz_expected[512], psz_reference[512], p_buffer[512];
+        dvbpsi_atsc_string_t string;
+
+        for (int j = 0; j < 2; j++)
+        {
+            const uint8_t *p_mss = j ? p_description_mss[i] : p_title_mss[i];
+            const code_t *p_code = j ? p_description_code : p_title_code;
+
+            Latin1ToUTF8(j ? p_descriptions[i] : p_titles[i], psz_expected);
+            DecodeBitByBit(p_code->p_tree, p_mss, psz_reference);
+            if (dvbpsi_atsc_text_decode(p_text, p_mss, 8 + p_mss[7], &string, 1,
+                                        p_buffer, sizeof(p_buffer)) != 1 ||
+                !string.b_complete || strcmp(string.psz_text, psz_expected) ||
+                strcmp(psz_reference, psz_expected))
+            {
+                fprintf(stderr, "event %d: decoding mismatch\n", i);
+                goto out;
+            }
+        }
+    }
+
+    /* Throughput */
+    size_t i_text = 0;
+    clock_t i_start = clock();
+    for (int k = 0; k < i_iterations; k++)
+    {
+        for (int i = 0; i < EVENTS; i++)
+        {
+            char p_buffer[512];
+            dvbpsi_atsc_string_t string;
+
+            dvbpsi_atsc_text_decode(p_text, p_title_mss[i], 8 + p_title_mss[i][7],
+                                    &string, 1, p_buffer, sizeof(p_buffer));
+            i_text += string.i_length;
+            dvbpsi_atsc_text_decode(p_text, p_description_mss[i], 8 + p_description_mss[i][7],
+                                    &string, 1, p_buffer, sizeof(p_buffer));
+            i_text += string.i_length;
+        }
+    }
+    double f_table = (double)(clock() - i_start) / CLOCKS_PER_SEC;
+
+    i_start = clock();
+    for (int k = 0; k < i_iterations; k++)
+    {
+        for (int i = 0; i < EVENTS; i++)
+        {
+            char p_buffer[512];
+            i_text -= DecodeBitByBit(p_title_code->p_tree, p_title_mss[i], p_buffer);
+            i_text -= DecodeBitByBit(p_description_code->p_tree, p_description_mss[i], p_buffer);
+        }
+    }
+    double f_bitwise = (double)(clock() - i_start) / CLOCKS_PER_SEC;
+
+    if (f_table < 1e-6)
+        f_table = 1e-6;
+    if (f_bitwise < 1e-6)
+        f_bitwise = 1e-6;
+
+    double f_mbytes = (double)i_compressed * i_iterations / 1000000.;
+    double f_strings = 2. * EVENTS * i_iterations;
+    printf("lookup tables: %8.3f s, %8.1f MB/s, %10.0f strings/s\n",
+           f_table, f_mbytes / f_table, f_strings / f_table);
+    printf("bit by bit:    %8.3f s, %8.1f MB/s, %10.0f strings/s\n",
+           f_bitwise, f_mbytes / f_bitwise, f_strings / f_bitwise);
+    i_ret = i_text == 0 ? 0 : 1;
+
+out:
+    dvbpsi_atsc_text_delete(p_text);
+    free(p_description_code);
+    free(p_title_code);
+    free(p_description_mss);
+    free(p_title_mss);
+    free(p_descriptions);
+    free(p_titles);
+    return i_ret;
+}
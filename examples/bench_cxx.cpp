@@ -0,0 +1,263 @@
+/*****************************************************************************
+ * bench_cxx.cpp: overhead of the C++ interface against the C API
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Generates a PMT stream cycling through all 32 versions, so that every
+ * table is decoded, then decodes it through the C API and through
+ * dvbpsi.hpp. Both callbacks walk the ES loop and the descriptor loops and
+ * compute the same checksum. The time per table of both is printed.
+ *
+ * Usage: bench_cxx [iterations]
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include <stdbool.h>
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* The libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/demux.h"
+#include "../src/tables/pat.h"
+#include "../src/tables/pmt.h"
+#include "../src/tables/sdt.h"
+#include "../src/tables/eit.h"
+#include "../src/tables/nit.h"
+#include "../src/tables/bat.h"
+#include "../src/dvbpsi.hpp"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/demux.h>
+#include <dvbpsi/pat.h>
+#include <dvbpsi/pmt.h>
+#include <dvbpsi/sdt.h>
+#include <dvbpsi/eit.h>
+#include <dvbpsi/nit.h>
+#include <dvbpsi/bat.h>
+#include <dvbpsi/dvbpsi.hpp>
+#endif
+
+#define PMT_PID         0x100
+#define PROGRAM         1
+#define VERSIONS        32
+#define ES_COUNT        40
+
+/*****************************************************************************
+ * Stream generation
+ *****************************************************************************/
+static void Packetize(std::vector<uint8_t> &stream, const dvbpsi_psi_section_t *p_section)
+{
+    for (; p_section; p_section = p_section->p_next)
+    {
+        const uint8_t *p_data = p_section->p_data;
+        size_t i_left = (size_t)p_section->i_length + 3;
+        bool b_first = true;
+
+        while (i_left)
+        {
+            uint8_t p_packet[188];
+            size_t i_pos = 4;
+            memset(p_packet, 0xff, sizeof(p_packet));
+            p_packet[0] = 0x47;
+            p_packet[1] = (b_first ? 0x40 : 0x00) | (PMT_PID >> 8);
+            p_packet[2] = PMT_PID & 0xff;
+            p_packet[3] = 0x10;         /* continuity_counter set when pushed */
+            if (b_first)
+                p_packet[i_pos++] = 0;  /* pointer_field */
+
+            size_t i_copy = i_left < 188 - i_pos ? i_left : 188 - i_pos;
+            memcpy(p_packet + i_pos, p_data, i_copy);
+            p_data += i_copy;
+            i_left -= i_copy;
+            b_first = false;
+            stream.insert(stream.end(), p_packet, p_packet + 188);
+        }
+    }
+}
+
+static bool MakeStream(std::vector<uint8_t> &stream)
+{
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (!p_dvbpsi)
+        return false;
+
+    for (int i_version = 0; i_version < VERSIONS; i_version++)
+    {
+        dvbpsi_pmt_t *p_pmt = dvbpsi_pmt_new(PROGRAM, i_version, true, 0x101);
+        if (!p_pmt)
+            break;
+        for (int i = 0; i < ES_COUNT; i++)
+        {
+            uint8_t p_lang[4] = { 'e', 'n', 'g', 0 };
+            uint8_t i_tag = i;
+            dvbpsi_pmt_es_t *p_es = dvbpsi_pmt_es_add(p_pmt, i ? 0x04 : 0x1b,
+                                                      0x101 + i + i_version);
+            if (p_es)
+            {
+                dvbpsi_pmt_es_descriptor_add(p_es, 0x0a, 4, p_lang);
+                dvbpsi_pmt_es_descriptor_add(p_es, 0x52, 1, &i_tag);
+            }
+        }
+        dvbpsi_psi_section_t *p_sections = dvbpsi_pmt_sections_generate(p_dvbpsi, p_pmt);
+        Packetize(stream, p_sections);
+        dvbpsi_DeletePSISections(p_sections);
+        dvbpsi_pmt_delete(p_pmt);
+    }
+
+    dvbpsi_delete(p_dvbpsi);
+    return stream.size() / 188 >= VERSIONS;
+}
+
+/* both decoders push the stream the same way */
+template <typename Push>
+static void PushStream(std::vector<uint8_t> &stream, int i_iterations, Push push)
+{
+    uint8_t i_cc = 0;
+    for (int i = 0; i < i_iterations; i++)
+        for (size_t i_pos = 0; i_pos < stream.size(); i_pos += 188)
+        {
+            uint8_t *p_packet = &stream[i_pos];
+            p_packet[3] = 0x10 | (i_cc++ & 0x0f);
+            push(p_packet);
+        }
+}
+
+/*****************************************************************************
+ * C API
+ *****************************************************************************/
+typedef struct
+{
+    uint32_t i_sum;
+    uint32_t i_tables;
+} bench_t;
+
+static void PMTCallback(void *p_cb_data, dvbpsi_pmt_t *p_pmt)
+{
+    bench_t *p_bench = (bench_t *)p_cb_data;
+    for (dvbpsi_pmt_es_t *p_es = p_pmt->p_first_es; p_es; p_es = p_es->p_next)
+    {
+        p_bench->i_sum += p_es->i_type + p_es->i_pid;
+        for (dvbpsi_descriptor_t *p_dr = p_es->p_first_descriptor; p_dr; p_dr = p_dr->p_next)
+            for (int i = 0; i < p_dr->i_length; i++)
+                p_bench->i_sum += p_dr->p_data[i];
+    }
+    p_bench->i_tables++;
+    dvbpsi_pmt_delete(p_pmt);
+}
+
+static bench_t BenchC(std::vector<uint8_t> &stream, int i_iterations)
+{
+    bench_t bench = { 0, 0 };
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (!p_dvbpsi || !dvbpsi_pmt_attach(p_dvbpsi, PROGRAM, PMTCallback, &bench))
+    {
+        dvbpsi_delete(p_dvbpsi);
+        return bench;
+    }
+
+    PushStream(stream, i_iterations,
+               [p_dvbpsi](const uint8_t *p_packet) { dvbpsi_packet_push(p_dvbpsi, p_packet); });
+
+    dvbpsi_pmt_detach(p_dvbpsi);
+    dvbpsi_delete(p_dvbpsi);
+    return bench;
+}
+
+/*****************************************************************************
+ * C++ interface
+ *****************************************************************************/
+static bench_t BenchCxx(std::vector<uint8_t> &stream, int i_iterations)
+{
+    bench_t bench = { 0, 0 };
+    dvbpsi::handle h;
+    if (!h.attach_pmt(PROGRAM, [&bench](dvbpsi::pmt pmt) {
+            for (const dvbpsi_pmt_es_t &es : pmt.es())
+            {
+                bench.i_sum += es.i_type + es.i_pid;
+                for (const dvbpsi_descriptor_t &dr : dvbpsi::descriptors(es))
+                    for (uint8_t i_byte : dvbpsi::payload(dr))
+                        bench.i_sum += i_byte;
+            }
+            bench.i_tables++;
+        }))
+        return bench;
+
+    PushStream(stream, i_iterations, [&h](const uint8_t *p_packet) { h.push(p_packet); });
+    return bench;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(int i_argc, char *pa_argv[])
+{
+    int i_iterations = i_argc > 1 ? atoi(pa_argv[1]) : 2000;
+    if (i_iterations <= 0)
+        i_iterations = 1;
+
+    std::vector<uint8_t> stream;
+    if (!MakeStream(stream))
+    {
+        fprintf(stderr, "cannot generate the PMT stream\n");
+        return 1;
+    }
+
+    clock_t i_start = clock();
+    bench_t c = BenchC(stream, i_iterations);
+    clock_t i_c = clock() - i_start;
+
+    i_start = clock();
+    bench_t cxx = BenchCxx(stream, i_iterations);
+    clock_t i_cxx = clock() - i_start;
+
+    if (c.i_tables != (uint32_t)i_iterations * VERSIONS
+        || cxx.i_tables != c.i_tables || cxx.i_sum != c.i_sum)
+    {
+        fprintf(stderr, "decoding differs: C %u tables (sum %u), C++ %u tables (sum %u)\n",
+                c.i_tables, c.i_sum, cxx.i_tables, cxx.i_sum);
+        return 1;
+    }
+
+    printf("%u PMT, %d ES each, %d packets per version\n",
+           c.i_tables, ES_COUNT, (int)(stream.size() / 188 / VERSIONS));
+    printf("  C API:         %.1f ns per table\n",
+           1e9 * i_c / CLOCKS_PER_SEC / c.i_tables);
+    printf("  C++ interface: %.1f ns per table (%+.1f %%)\n",
+           1e9 * i_cxx / CLOCKS_PER_SEC / cxx.i_tables,
+           i_c ? 100.0 * ((double)i_cxx - i_c) / i_c : 0.0);
+    return 0;
+}
@@ -0,0 +1,326 @@
+/*****************************************************************************
+ * bench_splice.c: accuracy of the splice scheduler on the PCR timeline
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Simulates a constant bitrate transport stream whose PCR_PID carries a PCR
+ * every pcr_interval milliseconds, with packet arrival dates disturbed by a
+ * random network jitter, and a splice_insert() every two seconds for a
+ * random splice time six to seven seconds later. The lateness (i_late) of
+ * the preroll and splice point callbacks is collected and its distribution
+ * printed, once with every packet pushed to the scheduler and once with the
+ * PCR packets only, together with the time spent per pushed packet.
+ *
+ * Usage: bench_splice [pcr_interval_ms [jitter_us [seconds]]]
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* The libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/descriptor.h"
+#include "../src/tables/sis.h"
+#include "../src/splice.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/sis.h>
+#include <dvbpsi/splice.h>
+#endif
+
+#define BITRATE         8000000     /* bits per second */
+#define PCR_PID         0x100
+#define VIDEO_PID       0x101
+#define PCR_ORIGIN      UINT64_C(0x1fff000000)  /* wraps during the run */
+#define SPLICE_PERIOD   2000000     /* a splice_insert() every 2 s */
+#define SPLICE_AHEAD    6000000     /* splice time 6 s after the command */
+
+/* lateness histogram in 10 us buckets */
+#define BUCKET_US       10
+#define BUCKETS         10000
+
+/*****************************************************************************
+ * Lateness statistics
+ *****************************************************************************/
+typedef struct stats_s
+{
+    uint32_t    pi_buckets[BUCKETS];
+    uint32_t    i_count;
+    int64_t     i_min;
+    int64_t     i_max;
+    int64_t     i_total;
+} stats_t;
+
+static void StatsAdd(stats_t *p_stats, int64_t i_late)
+{
+    int64_t i_bucket = i_late / 27 / BUCKET_US;
+
+    if (p_stats->i_count == 0 || i_late < p_stats->i_min)
+        p_stats->i_min = i_late;
+    if (p_stats->i_count == 0 || i_late > p_stats->i_max)
+        p_stats->i_max = i_late;
+    p_stats->i_count++;
+    p_stats->i_total += i_late;
+
+    if (i_bucket < 0)
+        i_bucket = 0;
+    if (i_bucket >= BUCKETS)
+        i_bucket = BUCKETS - 1;
+    p_stats->pi_buckets[i_bucket]++;
+}
+
+/* upper bound of the bucket holding the given fraction of the callbacks */
+static int64_t StatsPercentile(const stats_t *p_stats, double f_fraction)
+{
+    uint32_t i_target = (uint32_t)(f_fraction * p_stats->i_count + 0.5);
+    uint32_t i_sum = 0;
+
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        i_sum += p_stats->pi_buckets[i];
+        if (i_sum >= i_target)
+            return (int64_t)(i + 1) * BUCKET_US;
+    }
+    return (int64_t)BUCKETS * BUCKET_US;
+}
+
+static void StatsPrint(const char *psz_name, const stats_t *p_stats)
+{
+    if (p_stats->i_count == 0)
+    {
+        printf("  %-10s no callback\n", psz_name);
+        return;
+    }
+    printf("  %-10s %5u callbacks, late min %.1f us, mean %.1f us, max %.1f us, "
+           "p50 < %"PRId64" us, p99 < %"PRId64" us\n", psz_name, p_stats->i_count,
+           p_stats->i_min / 27.0, p_stats->i_total / 27.0 / p_stats->i_count,
+           p_stats->i_max / 27.0, StatsPercentile(p_stats, 0.5),
+           StatsPercentile(p_stats, 0.99));
+}
+
+typedef struct bench_s
+{
+    stats_t     preroll;
+    stats_t     point;
+    uint32_t    i_returns;
+} bench_t;
+
+static void SpliceCallback(void *p_cb_data, const dvbpsi_splice_event_t *p_event)
+{
+    bench_t *p_bench = (bench_t *)p_cb_data;
+
+    switch (p_event->i_action)
+    {
+        case DVBPSI_SPLICE_PREROLL:
+            StatsAdd(&p_bench->preroll, p_event->i_late);
+            break;
+        case DVBPSI_SPLICE_POINT:
+            StatsAdd(&p_bench->point, p_event->i_late);
+            break;
+        case DVBPSI_SPLICE_RETURN:
+            p_bench->i_returns++;
+            break;
+        default:
+            break;
+    }
+}
+
+/*****************************************************************************
+ * Stream simulation
+ *****************************************************************************/
+static uint32_t i_seed = 1;
+
+static unsigned int Random(unsigned int i_max)
+{
+    i_seed = i_seed * 1103515245 + 12345;
+    return i_max ? (i_seed >> 8) % i_max : 0;
+}
+
+static void MakePCRPacket(uint8_t *p_packet, uint64_t i_pcr)
+{
+    uint64_t i_base = (i_pcr / 300) & UINT64_C(0x1ffffffff);
+    uint16_t i_ext = i_pcr % 300;
+
+    memset(p_packet, 0xff, 188);
+    p_packet[0] = 0x47;
+    p_packet[1] = PCR_PID >> 8;
+    p_packet[2] = PCR_PID & 0xff;
+    p_packet[3] = 0x20;             /* adaptation field only */
+    p_packet[4] = 183;
+    p_packet[5] = 0x10;             /* PCR_flag */
+    p_packet[6] = i_base >> 25;
+    p_packet[7] = i_base >> 17;
+    p_packet[8] = i_base >> 9;
+    p_packet[9] = i_base >> 1;
+    p_packet[10] = ((i_base & 0x01) << 7) | 0x7e | (i_ext >> 8);
+    p_packet[11] = i_ext & 0xff;
+}
+
+static void PushSpliceInsert(dvbpsi_splice_scheduler_t *p_sched, uint32_t i_event_id,
+                             uint64_t i_pts)
+{
+    dvbpsi_sis_t sis;
+    dvbpsi_sis_splice_time_t splice_time;
+    dvbpsi_sis_break_duration_t break_duration;
+
+    dvbpsi_sis_init(&sis, 0xfc, 0, 0, true, 0);
+    memset(&splice_time, 0, sizeof(splice_time));
+    splice_time.b_time_specified_flag = true;
+    splice_time.i_pts_time = i_pts & UINT64_C(0x1ffffffff);
+    break_duration.b_auto_return = true;
+    break_duration.i_duration = 90000;          /* 1 s break */
+
+    dvbpsi_sis_cmd_splice_insert_t *p_insert = &sis.cmd.splice_insert;
+    memset(p_insert, 0, sizeof(*p_insert));
+    p_insert->i_splice_event_id = i_event_id;
+    p_insert->b_out_of_network_indicator = true;
+    p_insert->b_program_splice_flag = true;
+    p_insert->b_duration_flag = true;
+    p_insert->p_splice_time = &splice_time;
+    p_insert->p_break_duration = &break_duration;
+
+    sis.i_splice_command_type = 0x05;
+    sis.p_splice_command = p_insert;
+    sis.b_splice_command_valid = true;
+
+    dvbpsi_splice_scheduler_sis_push(p_sched, &sis);
+}
+
+static double Run(bench_t *p_bench, int i_pcr_interval, int i_jitter, int i_seconds,
+                  bool b_pcr_only)
+{
+    dvbpsi_splice_config_t config;
+    dvbpsi_splice_config_default(&config);
+    config.i_pcr_pid = PCR_PID;
+
+    dvbpsi_splice_scheduler_t *p_sched =
+                dvbpsi_splice_scheduler_new(&config, SpliceCallback, p_bench);
+    if (p_sched == NULL)
+        return -1.0;
+
+    uint8_t p_video[188];
+    memset(p_video, 0xff, sizeof(p_video));
+    p_video[0] = 0x47;
+    p_video[1] = 0x40 | (VIDEO_PID >> 8);
+    p_video[2] = VIDEO_PID & 0xff;
+    p_video[3] = 0x10;
+
+    /* one packet every 188 * 8 bits at the bitrate, in microseconds */
+    const double f_packet = 188.0 * 8 * 1000000 / BITRATE;
+    const int64_t i_end = (int64_t)i_seconds * 1000000;
+    int64_t i_next_pcr = 0, i_next_splice = 0;
+    uint32_t i_event_id = 0;
+    uint64_t i_pushed = 0;
+    uint8_t p_pcr[188];
+
+    i_seed = 1;
+    clock_t i_start = clock();
+    for (uint64_t i_packet = 0; ; i_packet++)
+    {
+        int64_t i_time = (int64_t)(i_packet * f_packet);
+        if (i_time >= i_end)
+            break;
+
+        /* PCR of the departure time, arrival date with the network jitter */
+        uint64_t i_pcr = (PCR_ORIGIN + (uint64_t)i_time * 27) % (UINT64_C(0x200000000) * 300);
+        int64_t i_date = i_time + Random(i_jitter + 1);
+
+        if (i_time >= i_next_splice)
+        {
+            /* splice times are not aligned on packets nor PCRs */
+            PushSpliceInsert(p_sched, i_event_id++, (i_pcr / 300) + Random(90000) +
+                             (uint64_t)SPLICE_AHEAD * 90 / 1000);
+            i_next_splice += SPLICE_PERIOD;
+        }
+
+        if (i_time >= i_next_pcr)
+        {
+            MakePCRPacket(p_pcr, i_pcr);
+            dvbpsi_splice_scheduler_packet_push(p_sched, p_pcr, i_date);
+            i_next_pcr += (int64_t)i_pcr_interval * 1000;
+            i_pushed++;
+        }
+        else if (!b_pcr_only)
+        {
+            dvbpsi_splice_scheduler_packet_push(p_sched, p_video, i_date);
+            i_pushed++;
+        }
+    }
+    clock_t i_cpu = clock() - i_start;
+
+    dvbpsi_splice_scheduler_delete(p_sched);
+    return i_pushed ? 1e9 * i_cpu / CLOCKS_PER_SEC / i_pushed : 0.0;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(int i_argc, char *pa_argv[])
+{
+    int i_pcr_interval = i_argc > 1 ? atoi(pa_argv[1]) : 40;
+    int i_jitter = i_argc > 2 ? atoi(pa_argv[2]) : 100;
+    int i_seconds = i_argc > 3 ? atoi(pa_argv[3]) : 600;
+
+    if (i_pcr_interval <= 0 || i_jitter < 0 || i_seconds <= 0)
+    {
+        fprintf(stderr, "Usage: bench_splice [pcr_interval_ms [jitter_us [seconds]]]\n");
+        return 1;
+    }
+
+    printf("%d s at %d bit/s, PCR every %d ms, arrival jitter up to %d us\n",
+           i_seconds, BITRATE, i_pcr_interval, i_jitter);
+
+    for (int i = 0; i < 2; i++)
+    {
+        bool b_pcr_only = (i == 1);
+        bench_t *p_bench = calloc(1, sizeof(bench_t));
+        if (p_bench == NULL)
+            return 1;
+
+        double f_ns = Run(p_bench, i_pcr_interval, i_jitter, i_seconds, b_pcr_only);
+        if (f_ns < 0)
+        {
+            free(p_bench);
+            return 1;
+        }
+
+        printf("%s: %.1f ns per pushed packet, %u breaks returned\n",
+               b_pcr_only ? "PCR packets only" : "all packets",
+               f_ns, p_bench->i_returns);
+        StatsPrint("preroll", &p_bench->preroll);
+        StatsPrint("point", &p_bench->point);
+        free(p_bench);
+    }
+    return 0;
+}
@@ -56,6 +56,7 @@
 #ifdef DVBPSI_DIST
 #include "../src/dvbpsi.h"
 #include "../src/psi.h"
+#include "../src/ts.h"
 #include "../src/tables/pat.h"
 #include "../src/descriptor.h"
 #include "../src/tables/pmt.h"
@@ -63,6 +64,7 @@
 #else
 #include <dvbpsi/dvbpsi.h>
 #include <dvbpsi/psi.h>
+#include <dvbpsi/ts.h>
 #include <dvbpsi/pat.h>
 #include <dvbpsi/descriptor.h>
 #include <dvbpsi/pmt.h>
@@ -714,7 +716,6 @@ int main(int i_argc, char* pa_argv[])
             uint8_t   *p_tmp = &p_data[i];
             uint16_t   i_pid = ((uint16_t)(p_tmp[1] & 0x1f) << 8) + p_tmp[2];
             int        i_cc = (p_tmp[3] & 0x0f);
-            vlc_bool_t b_adaptation = (p_tmp[3] & 0x20); /* adaptation field */
             vlc_bool_t b_discontinuity_seen = VLC_FALSE;
 
 #ifdef HAVE_SYS_SOCKET_H
@@ -764,28 +765,19 @@ int main(int i_argc, char* pa_argv[])
 
             /* Handle discontinuities if they occurred,
              * according to ISO/IEC 13818-1: DIS pages 20-22 */
-            if( b_adaptation )
+            dvbpsi_ts_adaptation_field_t af;
+            if( dvbpsi_ts_adaptation_field_decode( p_tmp, &af ) )
             {
-                vlc_bool_t b_discontinuity_indicator = (p_tmp[5]&0x80);
-                vlc_bool_t b_random_access_indicator = (p_tmp[5]&0x40);
-                vlc_bool_t b_pcr = (p_tmp[5]&0x10);  /* PCR flag */
-
-                if( b_discontinuity_indicator )
+                if( af.b_discontinuity )
                     fprintf( stderr, "Discontinuity indicator (pid %d)\n", i_pid );
-                if( b_random_access_indicator )
+                if( af.b_random_access )
                     fprintf( stderr, "Random access indicator (pid %d)\n", i_pid );
 
                 /* Dump PCR */
-                if( b_pcr && (p_tmp[4] >= 7) )
+                if( af.b_pcr )
                 {
-                    mtime_t i_pcr;  /* 33 bits */
-
-                    i_pcr = ( ( (mtime_t)p_tmp[6] << 25 ) |
-                              ( (mtime_t)p_tmp[7] << 17 ) |
-                              ( (mtime_t)p_tmp[8] << 9 ) |
-                              ( (mtime_t)p_tmp[9] << 1 ) |
-                              ( (mtime_t)p_tmp[10] >> 7 ) ) / 90;
-                    p_stream->pid[i_pid].i_pcr = i_pcr;
+                    /* 27 MHz to ms */
+                    p_stream->pid[i_pid].i_pcr = (mtime_t)(af.i_pcr / 27000);
 
 #ifdef HAVE_SYS_SOCKET_H
                     i_prev_pcr = p_stream->pid[i_pid].i_pcr;
@@ -801,7 +793,7 @@ int main(int i_argc, char* pa_argv[])
 #endif
                     i_bytes = 0; /* reset byte counter */
 
-                    if( b_discontinuity_indicator )
+                    if( af.b_discontinuity )
                     {
                         /* cc discontinuity is expected */
                         fprintf( stderr, "Server signalled the continuity counter discontinuity\n" );
@@ -49,6 +49,7 @@
 #   include "../../src/dvbpsi.h"
 #   include "../../src/demux.h"
 #   include "../../src/psi.h"
+#   include "../../src/ts.h"
 #   include "../../src/descriptor.h"
 #   include "../../src/tables/pat.h"
 #   include "../../src/tables/pmt.h"
@@ -70,6 +71,7 @@
 #   include <dvbpsi/dvbpsi.h>
 #   include <dvbpsi/demux.h>
 #   include <dvbpsi/psi.h>
+#   include <dvbpsi/ts.h>
 #   include <dvbpsi/descriptor.h>
 #   include <dvbpsi/pat.h>
 #   include <dvbpsi/pmt.h>
@@ -1642,8 +1644,30 @@ static void handle_SIS(void* p_data, dvbpsi_sis_t* p_sis)
         case 0x07:
             printf("bandwidth_reservation");
             break;
+        case 0xff:
+            printf("private_command");
+            break;
     }
     printf("\n");
+    if (p_sis->i_splice_command_type == 0x05 && p_sis->p_splice_command)
+    {
+        dvbpsi_sis_cmd_splice_insert_t *p_insert = p_sis->p_splice_command;
+        printf("\t   Splice event id : %u%s\n", p_insert->i_splice_event_id,
+               p_insert->b_splice_event_cancel_indicator ? " (cancelled)" : "");
+        printf("\t   Out of network  : %s\n",
+               p_insert->b_out_of_network_indicator ? "yes" : "no");
+        if (p_insert->p_splice_time && p_insert->p_splice_time->b_time_specified_flag)
+            printf("\t   Splice time     : %"PRIu64"\n", p_insert->p_splice_time->i_pts_time);
+        if (p_insert->p_break_duration)
+            printf("\t   Break duration  : %"PRIu64"%s\n", p_insert->p_break_duration->i_duration,
+                   p_insert->p_break_duration->b_auto_return ? " (auto return)" : "");
+    }
+    else if (p_sis->i_splice_command_type == 0x06 && p_sis->p_splice_command)
+    {
+        dvbpsi_sis_cmd_time_signal_t *p_signal = p_sis->p_splice_command;
+        if (p_signal->p_splice_time->b_time_specified_flag)
+            printf("\t   Splice time     : %"PRIu64"\n", p_signal->p_splice_time->i_pts_time);
+    }
     DumpSISDescriptors("\t   ]", p_sis->p_first_descriptor);
     dvbpsi_sis_delete(p_sis);
 }
@@ -2640,33 +2664,22 @@ bool libdvbpsi_process(ts_stream_t *stream, uint8_t *buf, ssize_t length, mtime_
 
         /* Handle discontinuities if they occurred,
          * according to ISO/IEC 13818-1: DIS pages 20-22 */
-        if (stream->pid[i_pid].b_adaptation_field && (p_tmp[4] > 0))
+        dvbpsi_ts_adaptation_field_t af;
+        if (dvbpsi_ts_adaptation_field_decode(p_tmp, &af) && (af.i_length > 0))
         {
-            bool b_pcr  = (p_tmp[5]&0x10) == 0x10;  /* PCR flag */
-            bool b_opcr = (p_tmp[5]&0x08) == 0x08;  /* OPCR flag */
-
-            stream->pid[i_pid].b_discontinuity_indicator = (p_tmp[5]&0x80) == 0x80;
-            stream->pid[i_pid].b_random_access_indicator = (p_tmp[5]&0x40) == 0x40;
-            stream->pid[i_pid].b_elementary_stream_priority_indicator = (p_tmp[5]&0x20) == 0x20;
-            stream->pid[i_pid].b_splicing_point = (p_tmp[5]&0x04) == 0x04;
-            stream->pid[i_pid].b_transport_private_data = (p_tmp[5]&0x02) == 0x02;
-            stream->pid[i_pid].b_adaptation_field_extension = (p_tmp[5]&0x01) == 0x01;
-
-            uint32_t i_ext = 5;
-
-            if (b_pcr) i_ext += 6;
+            stream->pid[i_pid].b_discontinuity_indicator = af.b_discontinuity;
+            stream->pid[i_pid].b_random_access_indicator = af.b_random_access;
+            stream->pid[i_pid].b_elementary_stream_priority_indicator = af.b_es_priority;
+            stream->pid[i_pid].b_splicing_point = af.b_splicing_point;
+            stream->pid[i_pid].b_transport_private_data = af.b_private_data;
+            stream->pid[i_pid].b_adaptation_field_extension = af.b_extension;
+            stream->pid[i_pid].b_opcr = af.b_opcr;
 
             /* PCR */
-            if (b_pcr && (p_tmp[4] >= 7))
+            if (af.b_pcr)
             {
-                mtime_t i_pcr;  /* 33 bits */
-
-                i_pcr = (( (mtime_t)p_tmp[6] << 25 ) |
-                         ( (mtime_t)p_tmp[7] << 17 ) |
-                         ( (mtime_t)p_tmp[8] << 9 ) |
-                         ( (mtime_t)p_tmp[9] << 1 ) |
-                         ( (mtime_t)(p_tmp[10]&0x80) >> 7 ));
-                i_pcr = i_pcr * 100 / 9;
+                mtime_t i_pcr = (mtime_t)(af.i_pcr / 27); /* 27 MHz to us */
+
                 i_prev_pcr = stream->pid[i_pid].i_pcr;
                 stream->pid[i_pid].i_pcr = i_pcr;
 
@@ -2695,61 +2708,25 @@ bool libdvbpsi_process(ts_stream_t *stream, uint8_t *buf, ssize_t length, mtime_
                 }
             }
 
-            if (b_opcr) i_ext += 6;
+            if (af.b_splicing_point)
+                stream->pid[i_pid].i_splice_countdown = af.i_splice_countdown;
 
-            if (stream->pid[i_pid].b_splicing_point)
-            {
-                i_ext++;
-                /* calculate tcimsbf */
-                stream->pid[i_pid].i_splice_countdown = ((p_tmp[i_ext] & 0x80) == 0x80) ?
-                                        -1 * (p_tmp[i_ext] & 0x7f) : (p_tmp[i_ext] & 0x7f);
-            }
+            if (af.b_private_data)
+                stream->pid[i_pid].i_transport_private_data_length = af.i_private_data_length;
 
-            if (stream->pid[i_pid].b_transport_private_data)
+            dvbpsi_ts_af_extension_t ext;
+            if (af.b_extension)
+                stream->pid[i_pid].i_adaptation_field_extension_length = af.i_extension_length;
+            if (dvbpsi_ts_af_extension_decode(p_tmp, &af, &ext))
             {
-                i_ext++;
-                stream->pid[i_pid].i_transport_private_data_length = p_tmp[i_ext];
-                i_ext += stream->pid[i_pid].i_transport_private_data_length;
+                stream->pid[i_pid].b_ltw = ext.b_ltw;
+                stream->pid[i_pid].b_piecewise_rate = ext.b_piecewise_rate;
+                stream->pid[i_pid].b_seamless_splice = ext.b_seamless_splice;
+                stream->pid[i_pid].b_ltw_valid = ext.b_ltw_valid;
+                stream->pid[i_pid].i_ltw_offset = ext.i_ltw_offset;
+                stream->pid[i_pid].i_piecewise_rate = ext.i_piecewise_rate;
+                stream->pid[i_pid].i_splice_type = ext.i_splice_type;
             }
-
-            if (stream->pid[i_pid].b_adaptation_field_extension)
-            {
-                /* i_ext is start of adaptation_extension field */
-                i_ext++;
-                uint8_t *p_ext = &p_tmp[i_ext];
-                uint32_t i_seamless_splice = i_ext;
-
-                stream->pid[i_pid].i_adaptation_field_extension_length = p_ext[0];
-
-                if (stream->pid[i_pid].i_adaptation_field_extension_length > 0)
-                {
-                    stream->pid[i_pid].b_ltw = (p_ext[1]&0x80) == 0x80;
-                    stream->pid[i_pid].b_piecewise_rate = (p_ext[1]&0x40) == 0x40;
-                    stream->pid[i_pid].b_seamless_splice = (p_ext[1]&0x20) == 0x20;
-
-                    if (stream->pid[i_pid].b_ltw)
-                    {
-                        stream->pid[i_pid].b_ltw_valid = ((p_ext[2]&0x80) == 0x80);
-                        stream->pid[i_pid].i_ltw_offset = ((uint16_t)p_ext[2]&0x7F);
-                        i_seamless_splice += 2;
-                    }
-
-                    if (stream->pid[i_pid].b_piecewise_rate)
-                    {
-                        stream->pid[i_pid].i_piecewise_rate =
-                          (((uint32_t)p_ext[i_seamless_splice] & 0x3F) << 16) |
-                          (((uint32_t)p_ext[i_seamless_splice + 1]) << 8) |
-                           ((uint32_t)p_ext[i_seamless_splice + 2]);
-                        i_seamless_splice += 3;
-                    }
-
-                    if (stream->pid[i_pid].b_seamless_splice)
-                    {
-                        stream->pid[i_pid].i_splice_type =
-                            (p_tmp[i_seamless_splice]&0xF0);
-                    }
-                }
-            } /* end of adaptation_extension_field */
         }
 
         if (b_discontinuity_seen)
@@ -46,6 +46,7 @@
 #include "../src/tables/pat.h"
 #include "../src/tables/pmt.h"
 #include "../src/psi.h"
+#include "../src/ts.h"
 #else
 #include <dvbpsi/dvbpsi.h>
 #include <dvbpsi/descriptor.h>
@@ -53,6 +54,7 @@
 #include <dvbpsi/pat.h>
 #include <dvbpsi/pmt.h>
 #include <dvbpsi/psi.h>
+#include <dvbpsi/ts.h>
 #endif
 
 /*****************************************************************************
@@ -139,22 +141,12 @@ static void PATCallback( void *_unused, dvbpsi_pat_t *p_pat )
 /*****************************************************************************
  * TSHandle: find and decode PSI
  *****************************************************************************/
-static inline uint16_t ts_GetPID( const uint8_t *p_ts )
-{
-    return (((uint16_t)p_ts[1] & 0x1f) << 8) | p_ts[2];
-}
-
-static inline int ts_CheckSync( const uint8_t *p_ts )
-{
-    return p_ts[0] == 0x47;
-}
-
 static void TSHandle( uint8_t *p_ts )
 {
-    uint16_t i_pid = ts_GetPID( p_ts );
+    uint16_t i_pid = dvbpsi_ts_pid( p_ts );
     int i;
 
-    if ( !ts_CheckSync( p_ts ) )
+    if ( p_ts[0] != 0x47 )
     {
         fprintf( stderr, "lost TS synchro, go and fix your file "
 #if defined(WIN32)
@@ -0,0 +1,275 @@
+/*****************************************************************************
+ * replay_sections.c: replay of PSI section dumps
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Replays a file of back to back PSI sections, as read from a Linux DVB
+ * demux device with a section filter, through dvbpsi_section_push():
+ *
+ *   replay_sections [-n] <file>
+ *
+ * -n skips the CRC_32 check, as for sections checked by the demux. PAT
+ * sections go to a PAT decoder, SDT, NIT, BAT and EIT sections to a demux.
+ * It prints a summary of each decoded table, there is no expected output to
+ * compare with.
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* The libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/demux.h"
+#include "../src/descriptor.h"
+#include "../src/tables/pat.h"
+#include "../src/tables/sdt.h"
+#include "../src/tables/nit.h"
+#include "../src/tables/bat.h"
+#include "../src/tables/eit.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/demux.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/pat.h>
+#include <dvbpsi/sdt.h>
+#include <dvbpsi/nit.h>
+#include <dvbpsi/bat.h>
+#include <dvbpsi/eit.h>
+#endif
+
+/*****************************************************************************
+ * ReadSection
+ *****************************************************************************
+ * Read the next section of the dump, skipping stuffing bytes. Returns the
+ * size of the section, 0 at the end of the file.
+ *****************************************************************************/
+static size_t ReadSection(FILE *p_file, uint8_t *p_dst)
+{
+    int i_byte;
+
+    do
+        i_byte = fgetc(p_file);
+    while (i_byte == 0xff);
+    if (i_byte == EOF)
+        return 0;
+
+    p_dst[0] = (uint8_t)i_byte;
+    if (fread(p_dst + 1, 1, 2, p_file) != 2)
+        return 0;
+
+    size_t i_length = ((size_t)(p_dst[1] & 0xf) << 8) | p_dst[2];
+    if (fread(p_dst + 3, 1, i_length, p_file) != i_length)
+        return 0;
+    return 3 + i_length;
+}
+
+/*****************************************************************************
+ * Table callbacks
+ *****************************************************************************/
+static void DumpPAT(void *p_data, dvbpsi_pat_t *p_pat)
+{
+    int i_programs = 0;
+    for (dvbpsi_pat_program_t *p = p_pat->p_first_program; p; p = p->p_next)
+        i_programs++;
+    printf("PAT ts_id %d version %d: %d programs\n",
+           p_pat->i_ts_id, p_pat->i_version, i_programs);
+    dvbpsi_pat_delete(p_pat);
+}
+
+static void DumpSDT(void *p_data, dvbpsi_sdt_t *p_sdt)
+{
+    int i_services = 0;
+    for (dvbpsi_sdt_service_t *p = p_sdt->p_first_service; p; p = p->p_next)
+        i_services++;
+    printf("SDT 0x%02x ts_id %d version %d: %d services\n", p_sdt->i_table_id,
+           p_sdt->i_extension, p_sdt->i_version, i_services);
+    dvbpsi_sdt_delete(p_sdt);
+}
+
+static void DumpNIT(void *p_data, dvbpsi_nit_t *p_nit)
+{
+    int i_ts = 0;
+    for (dvbpsi_nit_ts_t *p = p_nit->p_first_ts; p; p = p->p_next)
+        i_ts++;
+    printf("NIT 0x%02x network_id %d version %d: %d transport streams\n",
+           p_nit->i_table_id, p_nit->i_network_id, p_nit->i_version, i_ts);
+    dvbpsi_nit_delete(p_nit);
+}
+
+static void DumpBAT(void *p_data, dvbpsi_bat_t *p_bat)
+{
+    int i_ts = 0;
+    for (dvbpsi_bat_ts_t *p = p_bat->p_first_ts; p; p = p->p_next)
+        i_ts++;
+    printf("BAT bouquet_id %d version %d: %d transport streams\n",
+           p_bat->i_extension, p_bat->i_version, i_ts);
+    dvbpsi_bat_delete(p_bat);
+}
+
+static void DumpEIT(void *p_data, dvbpsi_eit_t *p_eit)
+{
+    int i_events = 0;
+    for (dvbpsi_eit_event_t *p = p_eit->p_first_event; p; p = p->p_next)
+        i_events++;
+    printf("EIT 0x%02x service_id %d version %d: %d events\n", p_eit->i_table_id,
+           p_eit->i_extension, p_eit->i_version, i_events);
+    dvbpsi_eit_delete(p_eit);
+}
+
+/*****************************************************************************
+ * NewSubtable
+ *****************************************************************************/
+static void NewSubtable(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                        void *p_data)
+{
+    bool b_ok = true;
+
+    if (i_table_id == 0x42 || i_table_id == 0x46)
+        b_ok = dvbpsi_sdt_attach(p_dvbpsi, i_table_id, i_extension, DumpSDT, NULL);
+    else if (i_table_id == 0x40 || i_table_id == 0x41)
+        b_ok = dvbpsi_nit_attach(p_dvbpsi, i_table_id, i_extension, DumpNIT, NULL);
+    else if (i_table_id == 0x4a)
+        b_ok = dvbpsi_bat_attach(p_dvbpsi, i_table_id, i_extension, DumpBAT, NULL);
+    else if (i_table_id >= 0x4e && i_table_id <= 0x6f)
+        b_ok = dvbpsi_eit_attach(p_dvbpsi, i_table_id, i_extension, DumpEIT, NULL);
+
+    if (!b_ok)
+        fprintf(stderr, "failed to attach subdecoder for table 0x%02x\n", i_table_id);
+}
+
+/*****************************************************************************
+ * AttachDemux / DetachDemux
+ *****************************************************************************
+ * The demux API is deprecated, the SI tables have no other dispatcher yet.
+ *****************************************************************************/
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+static bool AttachDemux(dvbpsi_t *p_dvbpsi)
+{
+    return dvbpsi_AttachDemux(p_dvbpsi, NewSubtable, NULL);
+}
+
+static void DetachDemux(dvbpsi_t *p_dvbpsi)
+{
+    dvbpsi_DetachDemux(p_dvbpsi);
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+static void message(dvbpsi_t *handle, const dvbpsi_msg_level_t level, const char* msg)
+{
+    switch(level)
+    {
+        case DVBPSI_MSG_ERROR: fprintf(stderr, "Error: "); break;
+        case DVBPSI_MSG_WARN:  fprintf(stderr, "Warning: "); break;
+        case DVBPSI_MSG_DEBUG: fprintf(stderr, "Debug: "); break;
+        default: /* do nothing */
+            return;
+    }
+    fprintf(stderr, "%s\n", msg);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(int i_argc, char* pa_argv[])
+{
+    bool b_check_crc = true;
+    const char *psz_file = NULL;
+
+    if (i_argc == 3 && strcmp(pa_argv[1], "-n") == 0)
+    {
+        b_check_crc = false;
+        psz_file = pa_argv[2];
+    }
+    else if (i_argc == 2)
+        psz_file = pa_argv[1];
+    else
+    {
+        fprintf(stderr, "usage: %s [-n] <section dump>\n", pa_argv[0]);
+        return 1;
+    }
+
+    FILE *p_file = fopen(psz_file, "rb");
+    if (!p_file)
+    {
+        fprintf(stderr, "cannot open %s\n", psz_file);
+        return 1;
+    }
+
+    int i_ret = 1;
+    dvbpsi_t *p_pat_dvbpsi = dvbpsi_new(&message, DVBPSI_MSG_WARN);
+    dvbpsi_t *p_si_dvbpsi = dvbpsi_new(&message, DVBPSI_MSG_WARN);
+    if (!p_pat_dvbpsi || !p_si_dvbpsi)
+        goto out;
+    if (!dvbpsi_pat_attach(p_pat_dvbpsi, DumpPAT, NULL))
+        goto out;
+    if (!AttachDemux(p_si_dvbpsi))
+        goto out;
+
+    uint8_t section[4096];
+    size_t i_size;
+    unsigned int i_sections = 0, i_rejected = 0;
+
+    while ((i_size = ReadSection(p_file, section)) > 0)
+    {
+        dvbpsi_t *p_dvbpsi = (section[0] == 0x00) ? p_pat_dvbpsi : p_si_dvbpsi;
+
+        /* The index of the section in the dump stands for its date */
+        if (!dvbpsi_section_push(p_dvbpsi, section, i_size, b_check_crc, i_sections))
+            i_rejected++;
+        i_sections++;
+    }
+
+    printf("%u sections replayed, %u rejected\n", i_sections, i_rejected);
+    i_ret = 0;
+
+out:
+    if (p_pat_dvbpsi)
+    {
+        if (dvbpsi_decoder_present(p_pat_dvbpsi))
+            dvbpsi_pat_detach(p_pat_dvbpsi);
+        dvbpsi_delete(p_pat_dvbpsi);
+    }
+    if (p_si_dvbpsi)
+    {
+        if (dvbpsi_decoder_present(p_si_dvbpsi))
+            DetachDemux(p_si_dvbpsi);
+        dvbpsi_delete(p_si_dvbpsi);
+    }
+    fclose(p_file);
+    return i_ret;
+}
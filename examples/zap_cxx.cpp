@@ -0,0 +1,173 @@
+/*****************************************************************************
+ * zap_cxx.cpp: table acquisition of a program with C++20 coroutines
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Reads a transport stream file and acquires the PAT, the PMT of a program
+ * and the SDT like a receiver tuning to it, with the timeouts of a zap.
+ * Packets are dated from their position in the file at a constant bitrate.
+ *
+ * Usage: zap_cxx [-r bitrate] <file> [program]
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <stdbool.h>
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* The libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/demux.h"
+#include "../src/tables/pat.h"
+#include "../src/tables/pmt.h"
+#include "../src/tables/sdt.h"
+#include "../src/tables/eit.h"
+#include "../src/tables/nit.h"
+#include "../src/tables/bat.h"
+#include "../src/dvbpsi.hpp"
+#include "../src/acquire.hpp"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/demux.h>
+#include <dvbpsi/pat.h>
+#include <dvbpsi/pmt.h>
+#include <dvbpsi/sdt.h>
+#include <dvbpsi/eit.h>
+#include <dvbpsi/nit.h>
+#include <dvbpsi/bat.h>
+#include <dvbpsi/dvbpsi.hpp>
+#include <dvbpsi/acquire.hpp>
+#endif
+
+/* timeouts in microseconds, from the repetition rates of EN 300 468 */
+#define PAT_TIMEOUT     INT64_C(500000)
+#define PMT_TIMEOUT     INT64_C(500000)
+#define SDT_TIMEOUT     INT64_C(2500000)
+
+/*****************************************************************************
+ * Zap
+ *****************************************************************************/
+static dvbpsi::task<bool> Zap(dvbpsi::acquirer &acq, int i_program)
+{
+    dvbpsi::pat pat = co_await acq.next_pat(PAT_TIMEOUT);
+    if (!pat)
+    {
+        fprintf(stderr, "no PAT\n");
+        co_return false;
+    }
+    printf("%.3f s: PAT version %d\n", acq.now() / 1e6, pat->i_version);
+
+    /* first program of the PAT by default, number 0 is the NIT */
+    if (i_program < 0)
+        for (const dvbpsi_pat_program_t &program : pat.programs())
+            if (program.i_number != 0)
+            {
+                i_program = program.i_number;
+                break;
+            }
+
+    dvbpsi::pmt pmt = co_await acq.next_pmt(i_program, PMT_TIMEOUT);
+    if (!pmt)
+    {
+        fprintf(stderr, "no PMT for program %d\n", i_program);
+        co_return false;
+    }
+    printf("%.3f s: PMT of program %d, PCR PID 0x%04x\n",
+           acq.now() / 1e6, i_program, pmt->i_pcr_pid);
+    for (const dvbpsi_pmt_es_t &es : pmt.es())
+        printf("  stream_type 0x%02x PID 0x%04x, %d descriptors\n",
+               es.i_type, es.i_pid, (int)dvbpsi::descriptors(es).size());
+
+    dvbpsi::sdt sdt = co_await acq.next_sdt(SDT_TIMEOUT);
+    if (!sdt)
+    {
+        printf("no SDT\n");
+        co_return true;
+    }
+    for (const dvbpsi_sdt_service_t &service : sdt.services())
+        if (service.i_service_id == i_program)
+            printf("%.3f s: SDT, running_status %d, %d descriptors\n", acq.now() / 1e6,
+                   service.i_running_status, (int)dvbpsi::descriptors(service).size());
+    co_return true;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(int i_argc, char *pa_argv[])
+{
+    int64_t i_bitrate = 20000000;
+    int i_arg = 1;
+
+    if (i_argc > 2 && !strcmp(pa_argv[1], "-r"))
+    {
+        i_bitrate = atoll(pa_argv[2]);
+        i_arg += 2;
+    }
+    if (i_arg >= i_argc || i_bitrate <= 0)
+    {
+        fprintf(stderr, "Usage: zap_cxx [-r bitrate] <file> [program]\n");
+        return 1;
+    }
+
+    FILE *p_file = fopen(pa_argv[i_arg], "rb");
+    if (!p_file)
+    {
+        fprintf(stderr, "cannot open %s\n", pa_argv[i_arg]);
+        return 1;
+    }
+    int i_program = i_arg + 1 < i_argc ? atoi(pa_argv[i_arg + 1]) : -1;
+
+    dvbpsi::acquirer acq;
+    dvbpsi::task<bool> zap = Zap(acq, i_program);
+    zap.start();
+
+    uint8_t p_packet[188];
+    int64_t i_offset = 0;
+    while (!zap.done() && fread(p_packet, 188, 1, p_file) == 1)
+    {
+        if (p_packet[0] != 0x47)
+        {
+            fprintf(stderr, "lost TS synchronization\n");
+            break;
+        }
+        acq.push(p_packet, i_offset * 8 * 1000000 / i_bitrate);
+        i_offset += 188;
+    }
+    fclose(p_file);
+
+    /* end of file: the waits in progress give up */
+    acq.cancel();
+    return zap.done() && zap.result() ? 0 : 1;
+}
@@ -0,0 +1,506 @@
+/* This file is generated by applying the dr_codec.xsl stylesheet to the
+ * dr.xml description file. DO NOT EDIT !!! */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/descriptor.h"
+#include "../src/descriptors/dr.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/dr.h>
+#endif
+
+#include "dr_codec.h"
+
+/* hierarchy */
+static bool codec_decode_hierarchy(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_hierarchy_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x04 || p_descriptor->i_length != 4)
+    return false;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_h_type = (v >> 24) & ((UINT64_C(1) << 4) - 1);
+  p_decoded->i_h_layer_index = (v >> 16) & ((UINT64_C(1) << 6) - 1);
+  p_decoded->i_h_embedded_layer = (v >> 8) & ((UINT64_C(1) << 6) - 1);
+  p_decoded->i_h_priority = (v >> 0) & ((UINT64_C(1) << 6) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_hierarchy(const dvbpsi_mpeg_hierarchy_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((UINT64_C(1) << 4) - 1) << 28;
+  v |= ((uint64_t)p_decoded->i_h_type & ((UINT64_C(1) << 4) - 1)) << 24;
+  v |= ((UINT64_C(1) << 2) - 1) << 22;
+  v |= ((uint64_t)p_decoded->i_h_layer_index & ((UINT64_C(1) << 6) - 1)) << 16;
+  v |= ((UINT64_C(1) << 2) - 1) << 14;
+  v |= ((uint64_t)p_decoded->i_h_embedded_layer & ((UINT64_C(1) << 6) - 1)) << 8;
+  v |= ((UINT64_C(1) << 2) - 1) << 6;
+  v |= ((uint64_t)p_decoded->i_h_priority & ((UINT64_C(1) << 6) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+
+  return 4;
+}
+
+static int check_hierarchy(void)
+{
+  CODEC_VARS(mpeg_hierarchy);
+  CODEC_START(hierarchy);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_integer(i_h_type, 4);
+    CODEC_random_integer(i_h_layer_index, 6);
+    CODEC_random_integer(i_h_embedded_layer, 6);
+    CODEC_random_integer(i_h_priority, 6);
+    CODEC_DOJOB(mpeg_hierarchy, hierarchy);
+    CODEC_check_integer(i_h_type);
+    CODEC_check_integer(i_h_layer_index);
+    CODEC_check_integer(i_h_embedded_layer);
+    CODEC_check_integer(i_h_priority);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_hierarchy, hierarchy);
+  CODEC_END(hierarchy);
+
+  return i_err;
+}
+
+/* data stream alignment */
+static bool codec_decode_ds_alignment(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_ds_alignment_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x06 || p_descriptor->i_length != 1)
+    return false;
+
+  v = p[0];
+
+  p_decoded->i_alignment_type = (v >> 0) & ((UINT64_C(1) << 8) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_ds_alignment(const dvbpsi_mpeg_ds_alignment_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_alignment_type & ((UINT64_C(1) << 8) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 0);
+
+  return 1;
+}
+
+static int check_ds_alignment(void)
+{
+  CODEC_VARS(mpeg_ds_alignment);
+  CODEC_START(data stream alignment);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_integer(i_alignment_type, 8);
+    CODEC_DOJOB(mpeg_ds_alignment, ds_alignment);
+    CODEC_check_integer(i_alignment_type);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_ds_alignment, ds_alignment);
+  CODEC_END(data stream alignment);
+
+  return i_err;
+}
+
+/* target background grid */
+static bool codec_decode_target_bg_grid(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_target_bg_grid_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x07 || p_descriptor->i_length != 4)
+    return false;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_horizontal_size = (v >> 18) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_vertical_size = (v >> 4) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_pel_aspect_ratio = (v >> 0) & ((UINT64_C(1) << 4) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_target_bg_grid(const dvbpsi_mpeg_target_bg_grid_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_horizontal_size & ((UINT64_C(1) << 14) - 1)) << 18;
+  v |= ((uint64_t)p_decoded->i_vertical_size & ((UINT64_C(1) << 14) - 1)) << 4;
+  v |= ((uint64_t)p_decoded->i_pel_aspect_ratio & ((UINT64_C(1) << 4) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+
+  return 4;
+}
+
+static int check_target_bg_grid(void)
+{
+  CODEC_VARS(mpeg_target_bg_grid);
+  CODEC_START(target background grid);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_integer(i_horizontal_size, 14);
+    CODEC_random_integer(i_vertical_size, 14);
+    CODEC_random_integer(i_pel_aspect_ratio, 4);
+    CODEC_DOJOB(mpeg_target_bg_grid, target_bg_grid);
+    CODEC_check_integer(i_horizontal_size);
+    CODEC_check_integer(i_vertical_size);
+    CODEC_check_integer(i_pel_aspect_ratio);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_target_bg_grid, target_bg_grid);
+  CODEC_END(target background grid);
+
+  return i_err;
+}
+
+/* video window */
+static bool codec_decode_vwindow(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_vwindow_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x08 || p_descriptor->i_length != 4)
+    return false;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_horizontal_offset = (v >> 18) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_vertical_offset = (v >> 4) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_window_priority = (v >> 0) & ((UINT64_C(1) << 4) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_vwindow(const dvbpsi_mpeg_vwindow_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_horizontal_offset & ((UINT64_C(1) << 14) - 1)) << 18;
+  v |= ((uint64_t)p_decoded->i_vertical_offset & ((UINT64_C(1) << 14) - 1)) << 4;
+  v |= ((uint64_t)p_decoded->i_window_priority & ((UINT64_C(1) << 4) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+
+  return 4;
+}
+
+static int check_vwindow(void)
+{
+  CODEC_VARS(mpeg_vwindow);
+  CODEC_START(video window);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_integer(i_horizontal_offset, 14);
+    CODEC_random_integer(i_vertical_offset, 14);
+    CODEC_random_integer(i_window_priority, 4);
+    CODEC_DOJOB(mpeg_vwindow, vwindow);
+    CODEC_check_integer(i_horizontal_offset);
+    CODEC_check_integer(i_vertical_offset);
+    CODEC_check_integer(i_window_priority);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_vwindow, vwindow);
+  CODEC_END(video window);
+
+  return i_err;
+}
+
+/* system clock */
+static bool codec_decode_system_clock(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_system_clock_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x0b || p_descriptor->i_length != 2)
+    return false;
+
+  v = ((uint64_t)p[0] << 8)
+      | p[1];
+
+  p_decoded->b_external_clock_ref = (v >> 15) & 1;
+  p_decoded->i_clock_accuracy_integer = (v >> 8) & ((UINT64_C(1) << 6) - 1);
+  p_decoded->i_clock_accuracy_exponent = (v >> 5) & ((UINT64_C(1) << 3) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_system_clock(const dvbpsi_mpeg_system_clock_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  if(p_decoded->b_external_clock_ref)
+    v |= UINT64_C(1) << 15;
+  v |= ((UINT64_C(1) << 1) - 1) << 14;
+  v |= ((uint64_t)p_decoded->i_clock_accuracy_integer & ((UINT64_C(1) << 6) - 1)) << 8;
+  v |= ((uint64_t)p_decoded->i_clock_accuracy_exponent & ((UINT64_C(1) << 3) - 1)) << 5;
+  v |= ((UINT64_C(1) << 5) - 1) << 0;
+  p_data[0] = (uint8_t)(v >> 8);
+  p_data[1] = (uint8_t)(v >> 0);
+
+  return 2;
+}
+
+static int check_system_clock(void)
+{
+  CODEC_VARS(mpeg_system_clock);
+  CODEC_START(system clock);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_boolean(b_external_clock_ref);
+    CODEC_random_integer(i_clock_accuracy_integer, 6);
+    CODEC_random_integer(i_clock_accuracy_exponent, 3);
+    CODEC_DOJOB(mpeg_system_clock, system_clock);
+    CODEC_check_boolean(b_external_clock_ref);
+    CODEC_check_integer(i_clock_accuracy_integer);
+    CODEC_check_integer(i_clock_accuracy_exponent);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_system_clock, system_clock);
+  CODEC_END(system clock);
+
+  return i_err;
+}
+
+/* multiplex buffer utilization */
+static bool codec_decode_mx_buff_utilization(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_mx_buff_utilization_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x0c || p_descriptor->i_length != 3)
+    return false;
+
+  v = ((uint64_t)p[0] << 16)
+      | ((uint64_t)p[1] << 8)
+      | p[2];
+
+  p_decoded->b_mdv_valid = (v >> 23) & 1;
+  p_decoded->i_mx_delay_variation = (v >> 8) & ((UINT64_C(1) << 15) - 1);
+  p_decoded->i_mx_strategy = (v >> 5) & ((UINT64_C(1) << 3) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_mx_buff_utilization(const dvbpsi_mpeg_mx_buff_utilization_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  if(p_decoded->b_mdv_valid)
+    v |= UINT64_C(1) << 23;
+  v |= ((uint64_t)p_decoded->i_mx_delay_variation & ((UINT64_C(1) << 15) - 1)) << 8;
+  v |= ((uint64_t)p_decoded->i_mx_strategy & ((UINT64_C(1) << 3) - 1)) << 5;
+  v |= ((UINT64_C(1) << 5) - 1) << 0;
+  p_data[0] = (uint8_t)(v >> 16);
+  p_data[1] = (uint8_t)(v >> 8);
+  p_data[2] = (uint8_t)(v >> 0);
+
+  return 3;
+}
+
+static int check_mx_buff_utilization(void)
+{
+  CODEC_VARS(mpeg_mx_buff_utilization);
+  CODEC_START(multiplex buffer utilization);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_boolean(b_mdv_valid);
+    CODEC_random_integer(i_mx_delay_variation, 15);
+    CODEC_random_integer(i_mx_strategy, 3);
+    CODEC_DOJOB(mpeg_mx_buff_utilization, mx_buff_utilization);
+    CODEC_check_boolean(b_mdv_valid);
+    CODEC_check_integer(i_mx_delay_variation);
+    CODEC_check_integer(i_mx_strategy);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_mx_buff_utilization, mx_buff_utilization);
+  CODEC_END(multiplex buffer utilization);
+
+  return i_err;
+}
+
+/* maximum bitrate */
+static bool codec_decode_max_bitrate(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_max_bitrate_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x0e || p_descriptor->i_length != 3)
+    return false;
+
+  v = ((uint64_t)p[0] << 16)
+      | ((uint64_t)p[1] << 8)
+      | p[2];
+
+  p_decoded->i_max_bitrate = (v >> 0) & ((UINT64_C(1) << 22) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_max_bitrate(const dvbpsi_mpeg_max_bitrate_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((UINT64_C(1) << 2) - 1) << 22;
+  v |= ((uint64_t)p_decoded->i_max_bitrate & ((UINT64_C(1) << 22) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 16);
+  p_data[1] = (uint8_t)(v >> 8);
+  p_data[2] = (uint8_t)(v >> 0);
+
+  return 3;
+}
+
+static int check_max_bitrate(void)
+{
+  CODEC_VARS(mpeg_max_bitrate);
+  CODEC_START(maximum bitrate);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_integer(i_max_bitrate, 22);
+    CODEC_DOJOB(mpeg_max_bitrate, max_bitrate);
+    CODEC_check_integer(i_max_bitrate);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_max_bitrate, max_bitrate);
+  CODEC_END(maximum bitrate);
+
+  return i_err;
+}
+
+/* private data indicator */
+static bool codec_decode_private_data(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_mpeg_private_data_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != 0x0f || p_descriptor->i_length != 4)
+    return false;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_private_data = (v >> 0) & ((UINT64_C(1) << 32) - 1);
+  return true;
+}
+
+static uint8_t codec_encode_private_data(const dvbpsi_mpeg_private_data_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_private_data & ((UINT64_C(1) << 32) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+
+  return 4;
+}
+
+static int check_private_data(void)
+{
+  CODEC_VARS(mpeg_private_data);
+  CODEC_START(private data indicator);
+
+  for(i_loop = 0; !i_err && i_loop < CODEC_LOOPS; i_loop++)
+  {
+    CODEC_random_integer(i_private_data, 32);
+    CODEC_DOJOB(mpeg_private_data, private_data);
+    CODEC_check_integer(i_private_data);
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(mpeg_private_data, private_data);
+  CODEC_END(private data indicator);
+
+  return i_err;
+}
+
+/* main function */
+int main(void)
+{
+  int i_err = 0;
+  i_err |= check_hierarchy();
+  i_err |= check_ds_alignment();
+  i_err |= check_target_bg_grid();
+  i_err |= check_vwindow();
+  i_err |= check_system_clock();
+  i_err |= check_mx_buff_utilization();
+  i_err |= check_max_bitrate();
+  i_err |= check_private_data();
+
+  if(i_err)
+    fprintf(stderr, "At least one test has FAILED !!!\n");
+  else
+    fprintf(stdout, "All tests succeeded.\n");
+
+  return i_err;
+}
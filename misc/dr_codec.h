@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * dr_codec.h: helpers of the generated descriptor codec checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Each check encodes random field values with the generated encoder and
+ * with dvbpsi_gen_*_dr(), which must give the same bytes, then decodes them
+ * with the generated decoder and with dvbpsi_decode_*_dr(), which must give
+ * back the values. The benchmark then times both decoders.
+ *****************************************************************************/
+
+#define CODEC_LOOPS         100000
+#define CODEC_BENCH_LOOPS   1000000
+
+/* xorshift64, the checks are reproducible */
+static uint64_t codec_state = UINT64_C(0x9e3779b97f4a7c15);
+static uint64_t codec_Random(void)
+{
+  codec_state ^= codec_state << 13;
+  codec_state ^= codec_state >> 7;
+  codec_state ^= codec_state << 17;
+  return codec_state;
+}
+
+/* keeps the benchmarked decodings alive */
+static void * volatile codec_sink;
+
+#define CODEC_VARS(api)                                                 \
+  int i_err = 0;                                                        \
+  unsigned int i_loop;                                                  \
+  dvbpsi_##api##_dr_t s_in, s_out, *p_lib;                              \
+  dvbpsi_descriptor_t *p_descriptor;                                    \
+  uint8_t p_data[255];                                                  \
+  uint8_t i_size;                                                       \
+  memset(&s_in, 0, sizeof(s_in));
+
+#define CODEC_START(name)                                               \
+  fprintf(stdout, "\"%s\" descriptor codec check:\n", #name);
+
+#define CODEC_END(name)                                                 \
+  if(i_err)                                                             \
+    fprintf(stderr, "\"%s\" descriptor codec check FAILED !!!\n\n", #name); \
+  else                                                                  \
+    fprintf(stdout, "\"%s\" descriptor codec check succeeded\n\n", #name);
+
+#define CODEC_DOJOB(api, sname)                                         \
+    i_size = codec_encode_##sname(&s_in, p_data);                       \
+    p_descriptor = dvbpsi_gen_##api##_dr(&s_in, false);                 \
+    if(!p_descriptor || p_descriptor->i_length != i_size                \
+       || memcmp(p_descriptor->p_data, p_data, i_size))                 \
+    {                                                                   \
+      fprintf(stderr, "Error: encoders differ\n");                      \
+      i_err = 1;                                                        \
+    }                                                                   \
+    p_lib = p_descriptor ? dvbpsi_decode_##api##_dr(p_descriptor) : NULL; \
+    if(!i_err && (!p_lib || !codec_decode_##sname(p_descriptor, &s_out))) \
+    {                                                                   \
+      fprintf(stderr, "Error: decoding failed\n");                      \
+      i_err = 1;                                                        \
+    }
+
+#define CODEC_CLEAN()                                                   \
+    if(p_descriptor)                                                    \
+      dvbpsi_DeleteDescriptors(p_descriptor);
+
+/* integer */
+#define CODEC_random_integer(name, bitcount)                            \
+    s_in.name = codec_Random() & ((UINT64_C(1) << bitcount) - 1);
+
+#define CODEC_check_integer(name)                                       \
+    if(!i_err && (s_out.name != s_in.name || p_lib->name != s_in.name)) \
+    {                                                                   \
+      fprintf(stderr, "Error: integer %s %llu -> %llu (generated), %llu\n", \
+              #name, (long long unsigned int)s_in.name,                 \
+              (long long unsigned int)s_out.name,                       \
+              (long long unsigned int)p_lib->name);                     \
+      i_err = 1;                                                        \
+    }
+
+/* boolean */
+#define CODEC_random_boolean(name)                                      \
+    s_in.name = codec_Random() & 1;
+
+#define CODEC_check_boolean(name)                                       \
+    if(!i_err && (!s_out.name != !s_in.name || !p_lib->name != !s_in.name)) \
+    {                                                                   \
+      fprintf(stderr, "Error: boolean %s %d -> %d (generated), %d\n",   \
+              #name, s_in.name, s_out.name, p_lib->name);               \
+      i_err = 1;                                                        \
+    }
+
+/* decoding microbenchmark, the dvbpsi_decode_*_dr() timing includes the
+ * allocation of the decoded descriptor */
+#define CODEC_BENCH(api, sname)                                         \
+  if(!i_err)                                                            \
+  {                                                                     \
+    dvbpsi_descriptor_t * volatile p_bench;                             \
+    clock_t i_start, i_lib, i_gen;                                      \
+    p_descriptor = p_bench = dvbpsi_gen_##api##_dr(&s_in, false);       \
+    i_start = clock();                                                  \
+    for(i_loop = 0; i_loop < CODEC_BENCH_LOOPS; i_loop++)               \
+    {                                                                   \
+      codec_sink = dvbpsi_decode_##api##_dr(p_bench);                   \
+      free(p_bench->p_decoded);                                         \
+      p_bench->p_decoded = NULL;                                        \
+    }                                                                   \
+    i_lib = clock() - i_start;                                          \
+    i_start = clock();                                                  \
+    for(i_loop = 0; i_loop < CODEC_BENCH_LOOPS; i_loop++)               \
+    {                                                                   \
+      codec_decode_##sname(p_bench, &s_out);                            \
+      codec_sink = &s_out;                                              \
+    }                                                                   \
+    i_gen = clock() - i_start;                                          \
+    fprintf(stdout, "  decoding: %.1f ns (library), %.1f ns (generated)\n", \
+            1e9 * i_lib / CLOCKS_PER_SEC / CODEC_BENCH_LOOPS,           \
+            1e9 * i_gen / CLOCKS_PER_SEC / CODEC_BENCH_LOOPS);          \
+    dvbpsi_DeleteDescriptors(p_descriptor);                             \
+  }
@@ -0,0 +1,195 @@
+<?xml version="1.0" encoding="iso-8859-1" ?>
+<xsl:stylesheet xmlns:xsl="http://www.w3.org/1999/XSL/Transform" version="1.0">
+
+<!-- Generates specialised decoders and encoders for the fixed layout     -->
+<!-- descriptors of dr.xml (those with tag and api attributes), together  -->
+<!-- with a round trip check against the libdvbpsi decoders and encoders  -->
+<!-- and a decoding microbenchmark. The fields, including the reserved    -->
+<!-- ones, must describe the whole payload, at most 64 bits.              -->
+
+<xsl:output method="text" omit-xml-declaration="yes" indent="no" encoding="iso-8859-1" />
+
+<!--             -->
+<!-- entry point -->
+<!--             -->
+
+<xsl:template match="/dr">/* This file is generated by applying the dr_codec.xsl stylesheet to the
+ * dr.xml description file. DO NOT EDIT !!! */
+
+#include "config.h"
+
+#include &lt;stdio.h&gt;
+#include &lt;stdlib.h&gt;
+#include &lt;stdbool.h&gt;
+#include &lt;string.h&gt;
+#include &lt;time.h&gt;
+
+#if defined(HAVE_INTTYPES_H)
+#include &lt;inttypes.h&gt;
+#elif defined(HAVE_STDINT_H)
+#include &lt;stdint.h&gt;
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/descriptor.h"
+#include "../src/descriptors/dr.h"
+#else
+#include &lt;dvbpsi/dvbpsi.h&gt;
+#include &lt;dvbpsi/descriptor.h&gt;
+#include &lt;dvbpsi/dr.h&gt;
+#endif
+
+#include "dr_codec.h"
+<xsl:apply-templates select="descriptor[@api]" mode="codec" />
+/* main function */
+int main(void)
+{
+  int i_err = 0;
+<xsl:apply-templates select="descriptor[@api]" mode="main" />
+  if(i_err)
+    fprintf(stderr, "At least one test has FAILED !!!\n");
+  else
+    fprintf(stdout, "All tests succeeded.\n");
+
+  return i_err;
+}
+</xsl:template>
+
+<!--               -->
+<!-- layout helpers -->
+<!--               -->
+
+<!-- bit width of a field -->
+<xsl:template name="width">
+  <xsl:choose>
+    <xsl:when test="self::boolean">1</xsl:when>
+    <xsl:otherwise><xsl:value-of select="@bitcount" /></xsl:otherwise>
+  </xsl:choose>
+</xsl:template>
+
+<!-- position of the least significant bit of a field in the payload -->
+<xsl:template name="shift">
+  <xsl:variable name="total" select="sum(../integer/@bitcount) + sum(../reserved/@bitcount)
+                                     + count(../boolean)" />
+  <xsl:variable name="offset" select="sum(preceding-sibling::integer/@bitcount)
+                                      + sum(preceding-sibling::reserved/@bitcount)
+                                      + count(preceding-sibling::boolean)" />
+  <xsl:variable name="width"><xsl:call-template name="width" /></xsl:variable>
+  <xsl:value-of select="$total - $offset - $width" />
+</xsl:template>
+
+<!-- v = p[0] << ... | p[n - 1] -->
+<xsl:template name="load">
+  <xsl:param name="i" select="0" />
+  <xsl:param name="n" />
+  <xsl:choose>
+    <xsl:when test="$i = $n - 1">p[<xsl:value-of select="$i" />]</xsl:when>
+    <xsl:otherwise>((uint64_t)p[<xsl:value-of select="$i" />] &lt;&lt; <xsl:value-of select="8 * ($n - 1 - $i)" />)
+      | <xsl:call-template name="load">
+        <xsl:with-param name="i" select="$i + 1" />
+        <xsl:with-param name="n" select="$n" />
+      </xsl:call-template>
+    </xsl:otherwise>
+  </xsl:choose>
+</xsl:template>
+
+<!-- p_data[i] = v >> ... -->
+<xsl:template name="store">
+  <xsl:param name="i" select="0" />
+  <xsl:param name="n" />
+  <xsl:if test="$i &lt; $n">
+  p_data[<xsl:value-of select="$i" />] = (uint8_t)(v &gt;&gt; <xsl:value-of select="8 * ($n - 1 - $i)" />);<xsl:call-template name="store">
+      <xsl:with-param name="i" select="$i + 1" />
+      <xsl:with-param name="n" select="$n" />
+    </xsl:call-template>
+  </xsl:if>
+</xsl:template>
+
+<!--                 -->
+<!-- codec templates -->
+<!--                 -->
+
+<xsl:template match="descriptor" mode="codec">
+  <xsl:variable name="length" select="(sum(integer/@bitcount) + sum(reserved/@bitcount)
+                                       + count(boolean)) div 8" />
+/* <xsl:value-of select="@name" /> */
+static bool codec_decode_<xsl:value-of select="@sname" />(const dvbpsi_descriptor_t *p_descriptor,
+    dvbpsi_<xsl:value-of select="@api" />_dr_t *p_decoded)
+{
+  const uint8_t *p = p_descriptor->p_data;
+  uint64_t v;
+
+  if(p_descriptor->i_tag != <xsl:value-of select="@tag" /> || p_descriptor->i_length != <xsl:value-of select="$length" />)
+    return false;
+
+  v = <xsl:call-template name="load"><xsl:with-param name="n" select="$length" /></xsl:call-template>;
+<xsl:apply-templates select="integer | boolean" mode="decode" />
+  return true;
+}
+
+static uint8_t codec_encode_<xsl:value-of select="@sname" />(const dvbpsi_<xsl:value-of select="@api" />_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+<xsl:apply-templates select="integer | boolean | reserved" mode="encode" />
+<xsl:call-template name="store"><xsl:with-param name="n" select="$length" /></xsl:call-template>
+
+  return <xsl:value-of select="$length" />;
+}
+
+static int check_<xsl:value-of select="@sname" />(void)
+{
+  CODEC_VARS(<xsl:value-of select="@api" />);
+  CODEC_START(<xsl:value-of select="@name" />);
+
+  for(i_loop = 0; !i_err &amp;&amp; i_loop &lt; CODEC_LOOPS; i_loop++)
+  {<xsl:apply-templates select="integer | boolean" mode="random" />
+    CODEC_DOJOB(<xsl:value-of select="@api" />, <xsl:value-of select="@sname" />);<xsl:apply-templates select="integer | boolean" mode="check" />
+    CODEC_CLEAN();
+  }
+
+  CODEC_BENCH(<xsl:value-of select="@api" />, <xsl:value-of select="@sname" />);
+  CODEC_END(<xsl:value-of select="@name" />);
+
+  return i_err;
+}
+</xsl:template>
+
+<xsl:template match="integer" mode="decode">
+  p_decoded-><xsl:value-of select="@name" /> = (v &gt;&gt; <xsl:call-template name="shift" />) &amp; ((UINT64_C(1) &lt;&lt; <xsl:value-of select="@bitcount" />) - 1);</xsl:template>
+
+<xsl:template match="boolean" mode="decode">
+  p_decoded-><xsl:value-of select="@name" /> = (v &gt;&gt; <xsl:call-template name="shift" />) &amp; 1;</xsl:template>
+
+<xsl:template match="integer" mode="encode">
+  v |= ((uint64_t)p_decoded-><xsl:value-of select="@name" /> &amp; ((UINT64_C(1) &lt;&lt; <xsl:value-of select="@bitcount" />) - 1)) &lt;&lt; <xsl:call-template name="shift" />;</xsl:template>
+
+<xsl:template match="boolean" mode="encode">
+  if(p_decoded-><xsl:value-of select="@name" />)
+    v |= UINT64_C(1) &lt;&lt; <xsl:call-template name="shift" />;</xsl:template>
+
+<xsl:template match="reserved" mode="encode">
+  v |= ((UINT64_C(1) &lt;&lt; <xsl:value-of select="@bitcount" />) - 1) &lt;&lt; <xsl:call-template name="shift" />;</xsl:template>
+
+<xsl:template match="integer" mode="random">
+    CODEC_random_integer(<xsl:value-of select="@name" />, <xsl:value-of select="@bitcount" />);</xsl:template>
+
+<xsl:template match="boolean" mode="random">
+    CODEC_random_boolean(<xsl:value-of select="@name" />);</xsl:template>
+
+<xsl:template match="integer" mode="check">
+    CODEC_check_integer(<xsl:value-of select="@name" />);</xsl:template>
+
+<xsl:template match="boolean" mode="check">
+    CODEC_check_boolean(<xsl:value-of select="@name" />);</xsl:template>
+
+<!--                -->
+<!-- main templates -->
+<!--                -->
+
+<xsl:template match="descriptor" mode="main">  i_err |= check_<xsl:value-of select="@sname" />();
+</xsl:template>
+
+</xsl:stylesheet>
@@ -0,0 +1,60 @@
+<?xml version="1.0" encoding="iso-8859-1" ?>
+<xsl:stylesheet xmlns:xsl="http://www.w3.org/1999/XSL/Transform" version="1.0">
+
+<!-- Generates src/descriptors/mpeg/dr_layout.h, the field extraction and -->
+<!-- insertion of the fixed layout descriptors of dr.xml used by their    -->
+<!-- libdvbpsi decoders and encoders. The checks of tag, length and of an -->
+<!-- existing decoding stay in the hand-written functions. The layout     -->
+<!-- helpers are those of dr_codec.xsl.                                   -->
+<!-- Only the descriptors with an api attribute are generated: the eight  -->
+<!-- fixed layout MPEG descriptors 0x04, 0x06, 0x07, 0x08, 0x0b, 0x0c,    -->
+<!-- 0x0e and 0x0f. The schema has no loop or length field construct, so  -->
+<!-- variable length descriptors stay hand-written.                       -->
+
+<xsl:import href="dr_codec.xsl" />
+
+<xsl:output method="text" omit-xml-declaration="yes" indent="no" encoding="iso-8859-1" />
+
+<!--             -->
+<!-- entry point -->
+<!--             -->
+
+<xsl:template match="/dr">/* This file is generated by applying the dr_layout.xsl stylesheet to the
+ * dr.xml description file. DO NOT EDIT !!! */
+
+#ifndef _DVBPSI_DR_LAYOUT_H_
+#define _DVBPSI_DR_LAYOUT_H_
+<xsl:apply-templates select="descriptor[@api]" mode="include" /><xsl:text>&#10;</xsl:text>
+<xsl:apply-templates select="descriptor[@api]" mode="layout" />
+#endif
+</xsl:template>
+
+<!-- the descriptor headers refuse to be included twice -->
+<xsl:template match="descriptor" mode="include">
+#ifndef _DVBPSI_DR_<xsl:value-of select="translate(substring(@tag, 3), 'abcdef', 'ABCDEF')" />_H_
+#include "dr_<xsl:value-of select="substring(@tag, 3)" />.h"
+#endif</xsl:template>
+
+<xsl:template match="descriptor" mode="layout">
+  <xsl:variable name="length" select="(sum(integer/@bitcount) + sum(reserved/@bitcount)
+                                       + count(boolean)) div 8" />
+/* <xsl:value-of select="@name" /> */
+static inline void dr_layout_decode_<xsl:value-of select="@api" />(const uint8_t *p,
+    dvbpsi_<xsl:value-of select="@api" />_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = <xsl:call-template name="load"><xsl:with-param name="n" select="$length" /></xsl:call-template>;
+<xsl:apply-templates select="integer | boolean" mode="decode" />
+}
+
+static inline void dr_layout_encode_<xsl:value-of select="@api" />(const dvbpsi_<xsl:value-of select="@api" />_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+<xsl:apply-templates select="integer | boolean | reserved" mode="encode" />
+<xsl:call-template name="store"><xsl:with-param name="n" select="$length" /></xsl:call-template>
+}
+</xsl:template>
+
+</xsl:stylesheet>
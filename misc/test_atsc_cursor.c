@@ -0,0 +1,676 @@
+/*****************************************************************************
+ * test_atsc_cursor.c: ATSC VCT and EIT section cursor checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * A VCT of 5 channels and an ATSC EIT of 7 events are built by hand over 3
+ * sections each. The cursors walk the sections, as stored and as given to
+ * a dvbpsi_section_cb, and the channels, events and descriptors they return
+ * are compared with the built ones and with the decoded tables.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/demux.h"
+#include "../src/tables/atsc_vct.h"
+#include "../src/tables/atsc_eit.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/demux.h>
+#include <dvbpsi/atsc_vct.h>
+#include <dvbpsi/atsc_eit.h>
+#endif
+
+#include "test_ts.h"
+
+#define TS_ID           0x0101
+#define SOURCE_ID       0x0042
+#define SECTIONS        3
+
+#define CHANNELS        5
+static const int pi_channels[SECTIONS] = { 2, 2, 1 };
+#define EVENTS          7
+static const int pi_events[SECTIONS] = { 3, 3, 1 };
+
+/*****************************************************************************
+ * Expected channels and events
+ *****************************************************************************/
+static void ChannelName(int c, uint8_t *p_name)
+{
+    static const char psz_name[7] = "CH-";
+
+    memset(p_name, 0, 14);
+    for (int i = 0; i < 3; i++)
+        p_name[2 * i + 1] = psz_name[i];
+    p_name[7] = '0' + c;
+}
+
+/* odd events carry a descriptor, channel 4 has none */
+static bool ChannelDescriptor(int c)
+{
+    return c != 4;
+}
+
+static bool EventDescriptor(int e)
+{
+    return e % 2;
+}
+
+static uint8_t *WriteDescriptor(uint8_t *p, uint8_t i_tag, uint8_t i_byte)
+{
+    p[0] = i_tag;
+    p[1] = 2;
+    p[2] = i_byte;
+    p[3] = 0xff - i_byte;
+    return p + 4;
+}
+
+static int CheckDescriptors(const char *psz_what, int i, dvbpsi_descriptor_iter_t *p_iter,
+                            bool b_expected, uint8_t i_tag, uint8_t i_byte)
+{
+    int i_err = 0;
+
+    if (b_expected != dvbpsi_descriptor_iter_next(p_iter) ||
+        (b_expected && (p_iter->i_tag != i_tag || p_iter->i_length != 2 ||
+                        p_iter->p_data[0] != i_byte ||
+                        p_iter->p_data[1] != 0xff - i_byte)))
+        i_err++;
+    if (dvbpsi_descriptor_iter_next(p_iter))
+        i_err++;
+    if (i_err)
+        fprintf(stderr, "  %s %d: wrong descriptors\n", psz_what, i);
+    return i_err ? 1 : 0;
+}
+
+static int CheckDecodedDescriptors(const char *psz_what, int i,
+                                   const dvbpsi_descriptor_t *p_descriptor,
+                                   bool b_expected, uint8_t i_tag, uint8_t i_byte)
+{
+    if (b_expected ? (p_descriptor == NULL || p_descriptor->p_next ||
+                      p_descriptor->i_tag != i_tag || p_descriptor->i_length != 2 ||
+                      p_descriptor->p_data[0] != i_byte ||
+                      p_descriptor->p_data[1] != 0xff - i_byte)
+                   : p_descriptor != NULL)
+    {
+        fprintf(stderr, "  %s %d: wrong decoded descriptors\n", psz_what, i);
+        return 1;
+    }
+    return 0;
+}
+
+/*****************************************************************************
+ * Section building
+ *****************************************************************************/
+static dvbpsi_psi_section_t *NewSection(uint8_t i_table_id, uint16_t i_extension,
+                                        uint8_t i_number, uint8_t **pp)
+{
+    dvbpsi_psi_section_t *p_section = dvbpsi_NewPSISection(1024);
+
+    p_section->i_table_id = i_table_id;
+    p_section->b_syntax_indicator = true;
+    p_section->b_private_indicator = true;
+    p_section->i_extension = i_extension;
+    p_section->i_version = 3;
+    p_section->b_current_next = true;
+    p_section->i_number = i_number;
+    p_section->i_last_number = SECTIONS - 1;
+    p_section->p_payload_start = p_section->p_data + 8;
+    *pp = p_section->p_payload_start;
+    return p_section;
+}
+
+static void BuildSection(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section, uint8_t *p)
+{
+    p_section->p_payload_end = p;
+    p_section->i_length = p - p_section->p_data - 3 + 4;
+    dvbpsi_BuildPSISection(p_dvbpsi, p_section);
+}
+
+/* i_declared channels are announced, the loop holds the first i_channels of
+ * them starting at channel i_first */
+static dvbpsi_psi_section_t *NewVCTSection(dvbpsi_t *p_dvbpsi, uint8_t i_number,
+                                           int i_first, int i_channels, int i_declared,
+                                           bool b_additional)
+{
+    uint8_t *p;
+    dvbpsi_psi_section_t *p_section = NewSection(0xc9, TS_ID, i_number, &p);
+
+    *p++ = 0;                           /* protocol_version */
+    *p++ = i_declared;
+    for (int c = i_first; c < i_first + i_channels; c++)
+    {
+        uint16_t i_major = 10 + c, i_minor = c + 1, i_source = 0x100 + c;
+
+        ChannelName(c, p);
+        p[14] = 0xf0 | (i_major >> 6);
+        p[15] = ((i_major & 0x3f) << 2) | (i_minor >> 8);
+        p[16] = i_minor & 0xff;
+        p[17] = 0x04;                   /* modulation_mode */
+        p[18] = p[19] = p[20] = p[21] = 0;
+        p[22] = TS_ID >> 8;
+        p[23] = TS_ID & 0xff;
+        p[24] = 0;
+        p[25] = c + 1;                  /* program_number */
+        p[26] = (c == 2 ? 0x20 : 0) | (c == 3 ? 0x12 : 0) | 0x01;
+        p[27] = 0xc0 | 0x02;            /* service_type */
+        p[28] = i_source >> 8;
+        p[29] = i_source & 0xff;
+        p[30] = 0xfc;
+        p[31] = ChannelDescriptor(c) ? 4 : 0;
+        p += 32;
+        if (ChannelDescriptor(c))
+            p = WriteDescriptor(p, 0x80 + c, c);
+    }
+    p[0] = 0xfc;
+    p[1] = b_additional ? 4 : 0;
+    p += 2;
+    if (b_additional)
+        p = WriteDescriptor(p, 0xad, 0x5a);
+
+    BuildSection(p_dvbpsi, p_section, p);
+    return p_section;
+}
+
+static dvbpsi_psi_section_t *NewEITSection(dvbpsi_t *p_dvbpsi, uint8_t i_number,
+                                           int i_first, int i_events)
+{
+    uint8_t *p;
+    dvbpsi_psi_section_t *p_section = NewSection(0xcb, SOURCE_ID, i_number, &p);
+
+    *p++ = 0;                           /* protocol_version */
+    *p++ = i_events;
+    for (int e = i_first; e < i_first + i_events; e++)
+    {
+        uint16_t i_event_id = 0x10 + e;
+        uint32_t i_start = 1000000 + 3600 * e;
+
+        p[0] = 0xc0 | (i_event_id >> 8);
+        p[1] = i_event_id & 0xff;
+        p[2] = i_start >> 24;
+        p[3] = (i_start >> 16) & 0xff;
+        p[4] = (i_start >> 8) & 0xff;
+        p[5] = i_start & 0xff;
+        p[6] = 0xc0 | (e == 5 ? 0x10 : 0);  /* ETM_location, length_in_seconds */
+        p[7] = 3600 >> 8;
+        p[8] = 3600 & 0xff;
+        p[9] = 3 * e;                   /* title_length */
+        for (int i = 0; i < 3 * e; i++)
+            p[10 + i] = 'a' + i;
+        p += 10 + 3 * e;
+        p[0] = 0xf0;
+        p[1] = EventDescriptor(e) ? 4 : 0;
+        p += 2;
+        if (EventDescriptor(e))
+            p = WriteDescriptor(p, 0x86, e);
+    }
+
+    BuildSection(p_dvbpsi, p_section, p);
+    return p_section;
+}
+
+/* the 3 sections of each table, chained */
+static dvbpsi_psi_section_t *NewVCT(dvbpsi_t *p_dvbpsi)
+{
+    dvbpsi_psi_section_t *p_first = NULL, **pp_last = &p_first;
+
+    for (int s = 0, c = 0; s < SECTIONS; c += pi_channels[s], s++)
+    {
+        *pp_last = NewVCTSection(p_dvbpsi, s, c, pi_channels[s], pi_channels[s],
+                                 s == SECTIONS - 1);
+        pp_last = &(*pp_last)->p_next;
+    }
+    return p_first;
+}
+
+static dvbpsi_psi_section_t *NewEIT(dvbpsi_t *p_dvbpsi)
+{
+    dvbpsi_psi_section_t *p_first = NULL, **pp_last = &p_first;
+
+    for (int s = 0, e = 0; s < SECTIONS; e += pi_events[s], s++)
+    {
+        *pp_last = NewEITSection(p_dvbpsi, s, e, pi_events[s]);
+        pp_last = &(*pp_last)->p_next;
+    }
+    return p_first;
+}
+
+/*****************************************************************************
+ * Cursor walks: compare a section with the channels or events from i_first
+ *****************************************************************************/
+static int WalkVCTSection(const uint8_t *p_data, size_t i_size, int i_first,
+                          int i_channels, bool b_additional)
+{
+    dvbpsi_atsc_vct_channel_iter_t iter;
+    int i_err = 0, c = i_first;
+
+    if (!dvbpsi_atsc_vct_channel_iter_init(&iter, p_data, i_size))
+    {
+        fprintf(stderr, "  VCT section not recognized\n");
+        return 1;
+    }
+    if (iter.i_ts_id != TS_ID || !iter.b_cable_vct || iter.i_protocol != 0)
+    {
+        fprintf(stderr, "  wrong VCT section header\n");
+        i_err++;
+    }
+
+    while (dvbpsi_atsc_vct_channel_iter_next(&iter))
+    {
+        uint8_t p_name[14];
+
+        ChannelName(c, p_name);
+        if (c >= i_first + i_channels ||
+            memcmp(iter.p_short_name, p_name, 14) ||
+            iter.i_major_number != 10 + c || iter.i_minor_number != c + 1 ||
+            iter.i_modulation != 0x04 || iter.i_channel_tsid != TS_ID ||
+            iter.i_program_number != c + 1 || iter.i_etm_location != 0 ||
+            iter.b_access_controlled != (c == 2) || iter.b_hidden != (c == 3) ||
+            iter.b_hide_guide != (c == 3) || iter.b_path_select || iter.b_out_of_band ||
+            iter.i_service_type != 0x02 || iter.i_source_id != 0x100 + c)
+        {
+            fprintf(stderr, "  channel %d: wrong fields\n", c);
+            i_err++;
+        }
+        else
+            i_err += CheckDescriptors("channel", c, &iter.descriptors,
+                                      ChannelDescriptor(c), 0x80 + c, c);
+        c++;
+    }
+    if (c != i_first + i_channels)
+    {
+        fprintf(stderr, "  %d channels instead of %d\n", c - i_first, i_channels);
+        i_err++;
+    }
+    i_err += CheckDescriptors("VCT section from channel", i_first, &iter.additional,
+                              b_additional, 0xad, 0x5a);
+    return i_err;
+}
+
+static int WalkEITSection(const uint8_t *p_data, size_t i_size, int i_first, int i_events)
+{
+    dvbpsi_atsc_eit_event_iter_t iter;
+    int i_err = 0, e = i_first;
+
+    if (!dvbpsi_atsc_eit_event_iter_init(&iter, p_data, i_size))
+    {
+        fprintf(stderr, "  EIT section not recognized\n");
+        return 1;
+    }
+    if (iter.i_source_id != SOURCE_ID || iter.i_protocol != 0 ||
+        iter.i_events != i_events)
+    {
+        fprintf(stderr, "  wrong EIT section header\n");
+        i_err++;
+    }
+
+    while (dvbpsi_atsc_eit_event_iter_next(&iter))
+    {
+        bool b_title = iter.i_title_length == 3 * e;
+
+        for (int i = 0; b_title && i < 3 * e; i++)
+            b_title = iter.p_title[i] == 'a' + i;
+        if (e >= i_first + i_events || !b_title ||
+            iter.i_event_id != 0x10 + e || iter.i_start_time != 1000000u + 3600 * e ||
+            iter.i_etm_location != (e == 5 ? 1 : 0) || iter.i_length_seconds != 3600)
+        {
+            fprintf(stderr, "  event %d: wrong fields\n", e);
+            i_err++;
+        }
+        else
+            i_err += CheckDescriptors("event", e, &iter.descriptors,
+                                      EventDescriptor(e), 0x86, e);
+        e++;
+    }
+    if (e != i_first + i_events)
+    {
+        fprintf(stderr, "  %d events instead of %d\n", e - i_first, i_events);
+        i_err++;
+    }
+    return i_err;
+}
+
+static int Result(const char *psz_name, int i_err)
+{
+    if (i_err)
+        fprintf(stderr, "\"%s\" cursor check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks on stored sections
+ *****************************************************************************/
+static int CheckStored(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"stored sections\" cursor check:\n");
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (p_dvbpsi == NULL)
+        return Result("stored sections", 1);
+    dvbpsi_psi_section_t *p_vct = NewVCT(p_dvbpsi);
+    dvbpsi_psi_section_t *p_eit = NewEIT(p_dvbpsi);
+
+    int s = 0, c = 0;
+    for (const dvbpsi_psi_section_t *p = p_vct; p; p = p->p_next, c += pi_channels[s++])
+        i_err += WalkVCTSection(p->p_data, TestSectionSize(p), c, pi_channels[s],
+                                s == SECTIONS - 1);
+    s = 0;
+    int e = 0;
+    for (const dvbpsi_psi_section_t *p = p_eit; p; p = p->p_next, e += pi_events[s++])
+        i_err += WalkEITSection(p->p_data, TestSectionSize(p), e, pi_events[s]);
+
+    /* neither cursor takes a section of the other table */
+    dvbpsi_atsc_vct_channel_iter_t vct_iter;
+    dvbpsi_atsc_eit_event_iter_t eit_iter;
+    if (dvbpsi_atsc_vct_channel_iter_init(&vct_iter, p_eit->p_data, TestSectionSize(p_eit)) ||
+        dvbpsi_atsc_eit_event_iter_init(&eit_iter, p_vct->p_data, TestSectionSize(p_vct)))
+    {
+        fprintf(stderr, "  section of the other table accepted\n");
+        i_err++;
+    }
+
+    dvbpsi_DeletePSISections(p_vct);
+    dvbpsi_DeletePSISections(p_eit);
+    dvbpsi_delete(p_dvbpsi);
+    return Result("stored sections", i_err);
+}
+
+static int CheckTruncated(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"truncated sections\" cursor check:\n");
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (p_dvbpsi == NULL)
+        return Result("truncated sections", 1);
+
+    /* 3 channels announced, 2 in the loop: the cursor stops after the
+     * second one and finds the additional descriptors */
+    dvbpsi_psi_section_t *p_section = NewVCTSection(p_dvbpsi, 0, 0, 2, 3, true);
+    i_err += WalkVCTSection(p_section->p_data, TestSectionSize(p_section), 0, 2, true);
+
+    /* a section that does not fit in the buffer is refused */
+    dvbpsi_atsc_vct_channel_iter_t iter;
+    if (dvbpsi_atsc_vct_channel_iter_init(&iter, p_section->p_data,
+                                          TestSectionSize(p_section) - 1))
+    {
+        fprintf(stderr, "  section larger than the buffer accepted\n");
+        i_err++;
+    }
+
+    dvbpsi_DeletePSISections(p_section);
+    dvbpsi_delete(p_dvbpsi);
+    return Result("truncated sections", i_err);
+}
+
+/*****************************************************************************
+ * Checks on the sections given to a decoder
+ *****************************************************************************/
+typedef struct reception_s
+{
+    int             i_vct_sections; /* walked in the section callback */
+    int             i_vct_channels;
+    int             i_eit_sections;
+    int             i_eit_events;
+    int             i_err;
+
+    dvbpsi_atsc_vct_t *p_vct;
+    dvbpsi_atsc_eit_t *p_eit;
+} reception_t;
+
+static void SectionCb(dvbpsi_t *p_dvbpsi, const dvbpsi_psi_section_t *p_section,
+                      const bool b_valid)
+{
+    reception_t *p_rcv = (reception_t *)p_dvbpsi->p_sys;
+    size_t i_size = p_section->p_payload_end - p_section->p_data + 4;
+    int s = p_section->i_number;
+
+    if (!b_valid || s >= SECTIONS)
+    {
+        p_rcv->i_err++;
+        return;
+    }
+    if (p_section->i_table_id == 0xc9)
+    {
+        int c = 0;
+        for (int i = 0; i < s; i++)
+            c += pi_channels[i];
+        p_rcv->i_err += WalkVCTSection(p_section->p_data, i_size, c, pi_channels[s],
+                                       s == SECTIONS - 1);
+        p_rcv->i_vct_sections++;
+        p_rcv->i_vct_channels += pi_channels[s];
+    }
+    else
+    {
+        int e = 0;
+        for (int i = 0; i < s; i++)
+            e += pi_events[i];
+        p_rcv->i_err += WalkEITSection(p_section->p_data, i_size, e, pi_events[s]);
+        p_rcv->i_eit_sections++;
+        p_rcv->i_eit_events += pi_events[s];
+    }
+}
+
+static void VCTCb(void *p_cb_data, dvbpsi_atsc_vct_t *p_vct)
+{
+    reception_t *p_rcv = (reception_t *)p_cb_data;
+
+    if (p_rcv->p_vct)
+        dvbpsi_atsc_DeleteVCT(p_rcv->p_vct);
+    p_rcv->p_vct = p_vct;
+}
+
+static void EITCb(void *p_cb_data, dvbpsi_atsc_eit_t *p_eit)
+{
+    reception_t *p_rcv = (reception_t *)p_cb_data;
+
+    if (p_rcv->p_eit)
+        dvbpsi_atsc_DeleteEIT(p_rcv->p_eit);
+    p_rcv->p_eit = p_eit;
+}
+
+static void NewSubtable(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                        void *p_cb_data)
+{
+    if (i_table_id == 0xc9)
+        dvbpsi_atsc_AttachVCT(p_dvbpsi, i_table_id, i_extension, VCTCb, p_cb_data);
+    else if (i_table_id == 0xcb)
+        dvbpsi_atsc_AttachEIT(p_dvbpsi, i_table_id, i_extension, EITCb, p_cb_data);
+}
+
+/* the ATSC decoders only attach to the subtable demultiplexer */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+static dvbpsi_t *NewDemux(reception_t *p_rcv)
+{
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (p_dvbpsi == NULL)
+        return NULL;
+    if (!dvbpsi_AttachDemux(p_dvbpsi, NewSubtable, p_rcv))
+    {
+        dvbpsi_delete(p_dvbpsi);
+        return NULL;
+    }
+    p_dvbpsi->p_sys = p_rcv;
+    p_dvbpsi->pf_section = SectionCb;
+    return p_dvbpsi;
+}
+
+static void DeleteDemux(dvbpsi_t *p_dvbpsi)
+{
+    dvbpsi_atsc_DetachVCT(p_dvbpsi, 0xc9, TS_ID);
+    dvbpsi_atsc_DetachEIT(p_dvbpsi, 0xcb, SOURCE_ID);
+    dvbpsi_DetachDemux(p_dvbpsi);
+    dvbpsi_delete(p_dvbpsi);
+}
+#pragma GCC diagnostic pop
+
+static int CheckDecodedVCT(const dvbpsi_atsc_vct_t *p_vct)
+{
+    int i_err = 0, c = 0;
+
+    if (p_vct == NULL)
+    {
+        fprintf(stderr, "  VCT not decoded\n");
+        return 1;
+    }
+    for (const dvbpsi_atsc_vct_channel_t *p = p_vct->p_first_channel; p; p = p->p_next, c++)
+    {
+        uint8_t p_name[14];
+
+        ChannelName(c, p_name);
+        if (memcmp(p->i_short_name, p_name, 14) ||
+            p->i_major_number != 10 + c || p->i_minor_number != c + 1 ||
+            p->i_program_number != c + 1 || p->i_source_id != 0x100 + c ||
+            p->b_access_controlled != (c == 2) || p->b_hidden != (c == 3))
+        {
+            fprintf(stderr, "  decoded channel %d: wrong fields\n", c);
+            i_err++;
+        }
+        i_err += CheckDecodedDescriptors("channel", c, p->p_first_descriptor,
+                                         ChannelDescriptor(c), 0x80 + c, c);
+    }
+    if (c != CHANNELS)
+    {
+        fprintf(stderr, "  %d decoded channels instead of %d\n", c, CHANNELS);
+        i_err++;
+    }
+    i_err += CheckDecodedDescriptors("VCT", 0, p_vct->p_first_descriptor, true, 0xad, 0x5a);
+    return i_err;
+}
+
+static int CheckDecodedEIT(const dvbpsi_atsc_eit_t *p_eit)
+{
+    int i_err = 0, e = 0;
+
+    if (p_eit == NULL)
+    {
+        fprintf(stderr, "  EIT not decoded\n");
+        return 1;
+    }
+    for (const dvbpsi_atsc_eit_event_t *p = p_eit->p_first_event; p; p = p->p_next, e++)
+    {
+        if (p->i_event_id != 0x10 + e || p->i_start_time != 1000000u + 3600 * e ||
+            p->i_title_length != 3 * e || p->i_length_seconds != 3600)
+        {
+            fprintf(stderr, "  decoded event %d: wrong fields\n", e);
+            i_err++;
+        }
+        i_err += CheckDecodedDescriptors("event", e, p->p_first_descriptor,
+                                         EventDescriptor(e), 0x86, e);
+    }
+    if (e != EVENTS)
+    {
+        fprintf(stderr, "  %d decoded events instead of %d\n", e, EVENTS);
+        i_err++;
+    }
+    return i_err;
+}
+
+static int CheckCallback(void)
+{
+    int i_err = 0;
+    reception_t rcv;
+
+    fprintf(stdout, "\"section callback\" cursor check:\n");
+    memset(&rcv, 0, sizeof(reception_t));
+    dvbpsi_t *p_dvbpsi = NewDemux(&rcv);
+    if (p_dvbpsi == NULL)
+        return Result("section callback", 1);
+    dvbpsi_psi_section_t *p_vct = NewVCT(p_dvbpsi);
+    dvbpsi_psi_section_t *p_eit = NewEIT(p_dvbpsi);
+
+    /* the sections of both tables interleaved, the last ones first */
+    const dvbpsi_psi_section_t *pp_vct[SECTIONS], *pp_eit[SECTIONS];
+    int s = 0;
+    for (const dvbpsi_psi_section_t *p = p_vct; p; p = p->p_next)
+        pp_vct[s++] = p;
+    s = 0;
+    for (const dvbpsi_psi_section_t *p = p_eit; p; p = p->p_next)
+        pp_eit[s++] = p;
+    for (s = SECTIONS - 1; s >= 0; s--)
+    {
+        if (!dvbpsi_section_push(p_dvbpsi, pp_vct[s]->p_data, TestSectionSize(pp_vct[s]),
+                                 true, 0) ||
+            !dvbpsi_section_push(p_dvbpsi, pp_eit[s]->p_data, TestSectionSize(pp_eit[s]),
+                                 true, 0))
+        {
+            fprintf(stderr, "  section %d rejected\n", s);
+            i_err++;
+        }
+    }
+
+    i_err += rcv.i_err;
+    if (rcv.i_vct_sections != SECTIONS || rcv.i_vct_channels != CHANNELS ||
+        rcv.i_eit_sections != SECTIONS || rcv.i_eit_events != EVENTS)
+    {
+        fprintf(stderr, "  %d VCT and %d EIT sections walked\n",
+                rcv.i_vct_sections, rcv.i_eit_sections);
+        i_err++;
+    }
+    i_err += CheckDecodedVCT(rcv.p_vct);
+    i_err += CheckDecodedEIT(rcv.p_eit);
+
+    if (rcv.p_vct)
+        dvbpsi_atsc_DeleteVCT(rcv.p_vct);
+    if (rcv.p_eit)
+        dvbpsi_atsc_DeleteEIT(rcv.p_eit);
+    dvbpsi_DeletePSISections(p_vct);
+    dvbpsi_DeletePSISections(p_eit);
+    DeleteDemux(p_dvbpsi);
+    return Result("section callback", i_err);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckStored();
+    i_err += CheckTruncated();
+    i_err += CheckCallback();
+
+    if (i_err)
+        fprintf(stderr, "%d cursor checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
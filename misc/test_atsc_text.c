@@ -0,0 +1,253 @@
+/*****************************************************************************
+ * test_atsc_text.c: ATSC multiple_string_structure decoder checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * The compressed strings are encoded by hand with small decode trees in the
+ * layout of A/65 tables C.5 and C.7: an order-1 model with a tree for the
+ * beginning of a string and for the prior symbols 'A' and 'B'. The tree of
+ * 'B' is a chain of 10 nodes, so that its escape code crosses the 8 bits
+ * lookup tables of the decoder.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/atsc_text.h"
+#else
+#include <dvbpsi/atsc_text.h>
+#endif
+
+#define LEAF(c)         (0x80 | (c))
+#define END             0x00
+#define ESCAPE          0x1b
+
+/*****************************************************************************
+ * Decode trees: 128 offsets followed by the trees of the prior symbols 0,
+ * 'A' and 'B', the other prior symbols have no tree
+ *****************************************************************************/
+static size_t BuildTrees(uint8_t *p_tree)
+{
+    static const uint8_t p_start[] =
+    {
+        LEAF('A'), 1,                   /* A 0, B 10, escape 11 */
+        LEAF('B'), LEAF(ESCAPE),
+    };
+    static const uint8_t p_a[] =
+    {
+        LEAF('B'), 1,                   /* B 0, end 10, A 11 */
+        LEAF(END), LEAF('A'),
+    };
+    static const uint8_t p_b[] =
+    {
+        LEAF('A'), 1,                   /* A 0, end 10, C 110, ... */
+        LEAF(END), 2,
+        LEAF('C'), 3,
+        LEAF('D'), 4,
+        LEAF('E'), 5,
+        LEAF('F'), 6,
+        LEAF('G'), 7,
+        LEAF('H'), 8,
+        LEAF('I'), 9,
+        LEAF('J'), LEAF(ESCAPE),        /* escape 1111111111 */
+    };
+    size_t i_size = 256;
+
+    memset(p_tree, 0, 256);
+#define ADD_TREE(context, tree)                     \
+    p_tree[2 * (context)] = i_size >> 8;            \
+    p_tree[2 * (context) + 1] = i_size & 0xff;      \
+    memcpy(p_tree + i_size, tree, sizeof(tree));    \
+    i_size += sizeof(tree);
+    ADD_TREE(0, p_start);
+    ADD_TREE('A', p_a);
+    ADD_TREE('B', p_b);
+#undef ADD_TREE
+    return i_size;
+}
+
+/*****************************************************************************
+ * Check: decode a multiple_string_structure and compare the strings
+ *****************************************************************************/
+typedef struct expected_s
+{
+    const char     *psz_language;
+    const char     *psz_text;
+    bool            b_complete;
+} expected_t;
+
+static int Check(const char *psz_name, const dvbpsi_atsc_text_t *p_text,
+                 const uint8_t *p_data, size_t i_length,
+                 const expected_t *p_expected, int i_expected)
+{
+    dvbpsi_atsc_string_t strings[4];
+    char p_buffer[256];
+    int i_err = 0;
+
+    fprintf(stdout, "\"%s\" multiple_string_structure check:\n", psz_name);
+
+    int i_strings = dvbpsi_atsc_text_decode(p_text, p_data, i_length, strings, 4,
+                                            p_buffer, sizeof(p_buffer));
+    if (i_strings != i_expected)
+    {
+        fprintf(stderr, "  %d strings instead of %d\n", i_strings, i_expected);
+        i_err++;
+    }
+    for (int i = 0; i < i_strings && i < i_expected; i++)
+    {
+        if (memcmp(strings[i].i_iso_639_code, p_expected[i].psz_language, 3) ||
+            strcmp(strings[i].psz_text, p_expected[i].psz_text) ||
+            strings[i].i_length != strlen(p_expected[i].psz_text) ||
+            strings[i].b_complete != p_expected[i].b_complete)
+        {
+            fprintf(stderr, "  string %d: \"%s\"%s instead of \"%s\"%s\n", i,
+                    strings[i].psz_text, strings[i].b_complete ? "" : " (incomplete)",
+                    p_expected[i].psz_text, p_expected[i].b_complete ? "" : " (incomplete)");
+            i_err++;
+        }
+    }
+
+    if (i_err)
+        fprintf(stderr, "\"%s\" multiple_string_structure check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckUncompressed(const dvbpsi_atsc_text_t *p_text)
+{
+    /* "Le " in the Latin page and a euro sign in UTF-16 */
+    static const uint8_t p_data[] =
+    {
+        0x02,
+        'e', 'n', 'g', 0x01,
+            0x00, 0x00, 0x04, 'N', 'e', 'w', 's',
+        'f', 'r', 'a', 0x02,
+            0x00, 0x00, 0x03, 'L', 'e', ' ',
+            0x00, 0x3f, 0x02, 0x20, 0xac,
+    };
+    static const expected_t expected[] =
+    {
+        { "eng", "News", true },
+        { "fra", "Le \xe2\x82\xac", true },
+    };
+    return Check("uncompressed", p_text, p_data, sizeof(p_data), expected, 2);
+}
+
+static int CheckCompressed(const dvbpsi_atsc_text_t *p_text)
+{
+    /* "AB" "A" "A" "B" escape 0xe9 "A" end:
+     * 0 0 0 11 0 1111111111 11101001 0 10, padded with 0 */
+    static const uint8_t p_data[] =
+    {
+        0x01,
+        'e', 'n', 'g', 0x01,
+            0x01, 0xff, 0x04, 0x1b, 0xff, 0xe9, 0x40,
+    };
+    static const expected_t expected[] =
+    {
+        { "eng", "ABAAB\xc3\xa9" "A", true },
+    };
+    return Check("compressed title", p_text, p_data, sizeof(p_data), expected, 1);
+}
+
+static int CheckMissingTrees(const dvbpsi_atsc_text_t *p_text)
+{
+    /* description trees are not loaded, the segment is skipped */
+    static const uint8_t p_data[] =
+    {
+        0x01,
+        'e', 'n', 'g', 0x02,
+            0x00, 0x00, 0x02, 'O', 'K',
+            0x02, 0xff, 0x04, 0x1b, 0xff, 0xe9, 0x40,
+    };
+    static const expected_t expected[] =
+    {
+        { "eng", "OK", false },
+    };
+    return Check("compressed description without trees", p_text, p_data,
+                 sizeof(p_data), expected, 1);
+}
+
+static int CheckTruncated(const dvbpsi_atsc_text_t *p_text)
+{
+    static const uint8_t p_data[] =
+    {
+        0x01,
+        'e', 'n', 'g', 0x01,
+            0x01, 0xff, 0x04, 0x1b, 0xff,
+    };
+    return Check("truncated segment", p_text, p_data, sizeof(p_data), NULL, -1);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    uint8_t p_tree[512];
+    int i_err = 0;
+
+    dvbpsi_atsc_text_t *p_text = dvbpsi_atsc_text_new();
+    if (p_text == NULL)
+        return 1;
+
+    size_t i_size = BuildTrees(p_tree);
+    if (!dvbpsi_atsc_text_set_huffman(p_text, DVBPSI_ATSC_TEXT_HUFFMAN_TITLE, p_tree, i_size))
+    {
+        fprintf(stderr, "title trees rejected\n");
+        i_err++;
+    }
+    /* the tree of the beginning of a string is mandatory */
+    p_tree[0] = p_tree[1] = 0;
+    if (dvbpsi_atsc_text_set_huffman(p_text, DVBPSI_ATSC_TEXT_HUFFMAN_DESCRIPTION,
+                                     p_tree, i_size))
+    {
+        fprintf(stderr, "description trees without a first tree accepted\n");
+        i_err++;
+    }
+
+    i_err += CheckUncompressed(p_text);
+    i_err += CheckCompressed(p_text);
+    i_err += CheckMissingTrees(p_text);
+    i_err += CheckTruncated(p_text);
+
+    dvbpsi_atsc_text_delete(p_text);
+
+    if (i_err)
+        fprintf(stderr, "%d multiple_string_structure checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
@@ -0,0 +1,187 @@
+/*****************************************************************************
+ * test_dr_range.c: out of range fields of the fixed layout descriptors
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * The encoders of the descriptors generated from dr.xml mask every field to
+ * its bit count. Each field narrower than its C type is given a value with
+ * bits above the field, the other fields being 0. The descriptor must be
+ * the one of the masked value, so that the extra bits neither reach the
+ * neighbouring fields nor the reserved bits, and must decode to the masked
+ * value.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/descriptors/dr.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/dr.h>
+#endif
+
+/*****************************************************************************
+ * SameDescriptor: compare the descriptors of the input and masked values
+ *****************************************************************************/
+static bool SameDescriptor(const dvbpsi_descriptor_t *p_in,
+                           const dvbpsi_descriptor_t *p_masked)
+{
+    return p_in && p_masked && p_in->i_tag == p_masked->i_tag &&
+           p_in->i_length == p_masked->i_length &&
+           !memcmp(p_in->p_data, p_masked->p_data, p_in->i_length);
+}
+
+/* encode a value of one field with bits above i_bits, the other fields
+ * being 0, and compare with the masked value */
+#define CHECK_FIELD(sname, field, i_bits, i_value)                            \
+    do {                                                                      \
+        dvbpsi_mpeg_##sname##_dr_t in, masked, *p_decoded = NULL;             \
+        memset(&in, 0, sizeof(in));                                           \
+        memset(&masked, 0, sizeof(masked));                                   \
+        in.field = (i_value);                                                 \
+        masked.field = (i_value) & ((UINT64_C(1) << (i_bits)) - 1);           \
+        dvbpsi_descriptor_t *p_in = dvbpsi_gen_mpeg_##sname##_dr(&in, false); \
+        dvbpsi_descriptor_t *p_masked =                                       \
+                                 dvbpsi_gen_mpeg_##sname##_dr(&masked, false);\
+        if (p_in)                                                             \
+            p_decoded = dvbpsi_decode_mpeg_##sname##_dr(p_in);                \
+        if (!SameDescriptor(p_in, p_masked) || !p_decoded ||                  \
+            p_decoded->field != masked.field)                                 \
+        {                                                                     \
+            fprintf(stderr, "  " #field " 0x%"PRIx64" not masked to %d bits\n",\
+                    (uint64_t)(i_value), (i_bits));                           \
+            i_err++;                                                          \
+        }                                                                     \
+        dvbpsi_DeleteDescriptors(p_in);                                       \
+        dvbpsi_DeleteDescriptors(p_masked);                                   \
+    } while (0)
+
+static int Result(const char *psz_name, int i_err)
+{
+    if (i_err)
+        fprintf(stderr, "\"%s\" range check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckHierarchy(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"hierarchy\" range check:\n");
+    CHECK_FIELD(hierarchy, i_h_type, 4, 0x1a);
+    CHECK_FIELD(hierarchy, i_h_layer_index, 6, 0xc5);
+    CHECK_FIELD(hierarchy, i_h_embedded_layer, 6, 0x45);
+    CHECK_FIELD(hierarchy, i_h_priority, 6, 0xff);
+    return Result("hierarchy", i_err);
+}
+
+static int CheckTargetBgGrid(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"target background grid\" range check:\n");
+    CHECK_FIELD(target_bg_grid, i_horizontal_size, 14, 0x4123);
+    CHECK_FIELD(target_bg_grid, i_vertical_size, 14, 0xc321);
+    CHECK_FIELD(target_bg_grid, i_pel_aspect_ratio, 4, 0x35);
+    return Result("target background grid", i_err);
+}
+
+static int CheckVWindow(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"video window\" range check:\n");
+    CHECK_FIELD(vwindow, i_horizontal_offset, 14, 0x8001);
+    CHECK_FIELD(vwindow, i_vertical_offset, 14, 0x7ffe);
+    CHECK_FIELD(vwindow, i_window_priority, 4, 0xf0);
+    return Result("video window", i_err);
+}
+
+static int CheckSystemClock(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"system clock\" range check:\n");
+    CHECK_FIELD(system_clock, i_clock_accuracy_integer, 6, 0xd2);
+    CHECK_FIELD(system_clock, i_clock_accuracy_exponent, 3, 0x0d);
+    return Result("system clock", i_err);
+}
+
+static int CheckMxBuffUtilization(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"multiplex buffer utilization\" range check:\n");
+    CHECK_FIELD(mx_buff_utilization, i_mx_delay_variation, 15, 0x8765);
+    CHECK_FIELD(mx_buff_utilization, i_mx_strategy, 3, 0xfa);
+    return Result("multiplex buffer utilization", i_err);
+}
+
+static int CheckMaxBitrate(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"maximum bitrate\" range check:\n");
+    CHECK_FIELD(max_bitrate, i_max_bitrate, 22, 0x00c12345);
+    CHECK_FIELD(max_bitrate, i_max_bitrate, 22, 0xffffffff);
+    return Result("maximum bitrate", i_err);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckHierarchy();
+    i_err += CheckTargetBgGrid();
+    i_err += CheckVWindow();
+    i_err += CheckSystemClock();
+    i_err += CheckMxBuffUtilization();
+    i_err += CheckMaxBitrate();
+
+    if (i_err)
+        fprintf(stderr, "%d range checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
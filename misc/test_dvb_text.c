@@ -0,0 +1,222 @@
+/*****************************************************************************
+ * test_dvb_text.c: EN 300 468 Annex A text conversion checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Each check converts DVB strings of one character table and compares the
+ * UTF-8 text and the return value with the expected ones.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvb_text.h"
+#else
+#include <dvbpsi/dvb_text.h>
+#endif
+
+/*****************************************************************************
+ * Conversion: one DVB string and its expected text
+ *****************************************************************************/
+typedef struct conversion_s
+{
+    const char     *p_data;         /* DVB string, may contain NUL bytes */
+    size_t          i_length;
+    const char     *psz_text;       /* expected UTF-8 text */
+    bool            b_ok;           /* expected return value */
+} conversion_t;
+
+#define CONVERSION(data, text, ok) { data, sizeof(data) - 1, text, ok }
+
+static int Check(const char *psz_name, const conversion_t *p_conv, size_t i_conv)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"%s\" text conversion check:\n", psz_name);
+
+    for (size_t i = 0; i < i_conv; i++)
+    {
+        char p_buffer[DVBPSI_DVB_TEXT_MAX_UTF8(64)];
+        size_t i_length = SIZE_MAX;
+
+        bool b_ok = dvbpsi_dvb_text_to_utf8((const uint8_t *)p_conv[i].p_data,
+                                            p_conv[i].i_length, p_buffer,
+                                            sizeof(p_buffer), &i_length);
+        if (b_ok != p_conv[i].b_ok || strcmp(p_buffer, p_conv[i].psz_text) ||
+            i_length != strlen(p_conv[i].psz_text))
+        {
+            fprintf(stderr, "  string %zu: \"%s\" (%s) instead of \"%s\" (%s)\n", i,
+                    p_buffer, b_ok ? "ok" : "failed", p_conv[i].psz_text,
+                    p_conv[i].b_ok ? "ok" : "failed");
+            i_err++;
+        }
+    }
+
+    if (i_err)
+        fprintf(stderr, "\"%s\" text conversion check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckDefaultTable(void)
+{
+    static const conversion_t conv[] =
+    {
+        CONVERSION("", "", true),
+        CONVERSION("Plain ASCII text, copied 8 bytes at a time",
+                   "Plain ASCII text, copied 8 bytes at a time", true),
+        /* diacritical mark before the letter, euro sign at 0xa4 */
+        CONVERSION("Caf\xc2" "e 5\xa4", "Caf\xc3\xa9 5\xe2\x82\xac", true),
+        /* no precomposed letter: letter followed by the combining mark */
+        CONVERSION("\xc8q", "q\xcc\x88", true),
+        CONVERSION("\xf8t\xe0", "\xc5\x82t\xe2\x84\xa6", true),
+    };
+    return Check("ISO/IEC 6937 default table", conv, sizeof(conv) / sizeof(conv[0]));
+}
+
+static int CheckIso8859(void)
+{
+    static const conversion_t conv[] =
+    {
+        /* 0x10 0x00 n selects ISO/IEC 8859-n */
+        CONVERSION("\x10\x00\x02" "\xb1l", "\xc4\x85l", true),
+        CONVERSION("\x10\x00\x05" "\xd0\xef", "\xd0\xb0\xd1\x8f", true),
+        CONVERSION("\x10\x00\x0f" "\xa4", "\xe2\x82\xac", true),
+        /* 0x01 to 0x0b select ISO/IEC 8859-5 to 8859-15 directly */
+        CONVERSION("\x01" "\xd0", "\xd0\xb0", true),
+        CONVERSION("\x05" "\xfd", "\xc4\xb1", true),
+    };
+    return Check("ISO/IEC 8859 selector", conv, sizeof(conv) / sizeof(conv[0]));
+}
+
+static int CheckUcs2(void)
+{
+    static const conversion_t conv[] =
+    {
+        CONVERSION("\x11" "\x00" "A" "\x20\xac" "\x04\x30", "A\xe2\x82\xac\xd0\xb0", true),
+        /* surrogate pair */
+        CONVERSION("\x11" "\xd8\x3d\xde\x00", "\xf0\x9f\x98\x80", true),
+    };
+    return Check("ISO/IEC 10646 UCS-2", conv, sizeof(conv) / sizeof(conv[0]));
+}
+
+static int CheckUtf8(void)
+{
+    static const conversion_t conv[] =
+    {
+        CONVERSION("\x15" "\xc3\xa9t\xc3\xa9 \xe2\x82\xac", "\xc3\xa9t\xc3\xa9 \xe2\x82\xac",
+                   true),
+        CONVERSION("\x15" "\xf0\x9f\x98\x80", "\xf0\x9f\x98\x80", true),
+    };
+    return Check("UTF-8", conv, sizeof(conv) / sizeof(conv[0]));
+}
+
+static int CheckControls(void)
+{
+    static const conversion_t conv[] =
+    {
+        /* emphasis on and off are dropped, CR/LF becomes a line feed */
+        CONVERSION("\x86" "Big" "\x87" " news" "\x8a" "Next", "Big news\nNext", true),
+        CONVERSION("\x10\x00\x01" "\x86" "A" "\x87\x8a" "B", "A\nB", true),
+        CONVERSION("\x11" "\xe0\x86\x00" "A" "\xe0\x87\xe0\x8a\x00" "B", "A\nB", true),
+        CONVERSION("\x15" "\xee\x82\x86" "A" "\xee\x82\x87\xee\x82\x8a" "B", "A\nB", true),
+    };
+    return Check("emphasis and CR/LF controls", conv, sizeof(conv) / sizeof(conv[0]));
+}
+
+static int CheckTruncatedSelector(void)
+{
+    static const conversion_t conv[] =
+    {
+        /* 0x10 needs two more bytes */
+        CONVERSION("\x10", "", false),
+        CONVERSION("\x10\x00", "", false),
+        /* ISO/IEC 8859-12 does not exist */
+        CONVERSION("\x10\x00\x0c" "A", "", false),
+        /* encoding_type_id is not supported */
+        CONVERSION("\x1f\x01" "A", "", false),
+        /* a selector alone is an empty string, an odd UCS-2 byte is dropped */
+        CONVERSION("\x15", "", true),
+        CONVERSION("\x11" "\x00", "", true),
+    };
+    return Check("truncated or unsupported selector", conv, sizeof(conv) / sizeof(conv[0]));
+}
+
+static int CheckSmallBuffer(void)
+{
+    static const uint8_t p_data[] = { 0x15, 'a', 0xc3, 0xa9, 'b' };
+    char p_buffer[3];
+    size_t i_length;
+    int i_err = 0;
+
+    fprintf(stdout, "\"small buffer\" text conversion check:\n");
+
+    /* the text is cut before the character that does not fit */
+    if (dvbpsi_dvb_text_to_utf8(p_data, sizeof(p_data), p_buffer, sizeof(p_buffer),
+                                &i_length) ||
+        strcmp(p_buffer, "a") || i_length != 1)
+    {
+        fprintf(stderr, "  \"%s\" instead of \"a\"\n", p_buffer);
+        i_err++;
+    }
+
+    if (i_err)
+        fprintf(stderr, "\"small buffer\" text conversion check FAILED !!!\n\n");
+    else
+        fprintf(stdout, "  \"small buffer\" OK\n\n");
+    return i_err;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckDefaultTable();
+    i_err += CheckIso8859();
+    i_err += CheckUcs2();
+    i_err += CheckUtf8();
+    i_err += CheckControls();
+    i_err += CheckTruncatedSelector();
+    i_err += CheckSmallBuffer();
+
+    if (i_err)
+        fprintf(stderr, "%d text conversion checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
@@ -0,0 +1,303 @@
+/*****************************************************************************
+ * test_eventtracker.c: present/following event tracker checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * EIT present/following and RST sections are built by hand and sent as TS
+ * packets on PIDs 0x12 and 0x13. Each step of the schedule of one service
+ * is followed by the callback it must raise, if any, and by the expected
+ * present and following events.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/tables/rst.h"
+#include "../src/eventtracker.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/rst.h>
+#include <dvbpsi/eventtracker.h>
+#endif
+
+#include "test_ts.h"
+
+#define ONID            0x20
+#define TSID            0x01
+#define SERVICE_ID      0x0101
+
+#define NOT_RUNNING     1
+#define PAUSING         3
+#define RUNNING         4
+
+#define PRESENT_EVENT       DVBPSI_EVENT_TRACKER_PRESENT_EVENT
+#define PRESENT_STATUS      DVBPSI_EVENT_TRACKER_PRESENT_STATUS
+#define FOLLOWING_EVENT     DVBPSI_EVENT_TRACKER_FOLLOWING_EVENT
+#define FOLLOWING_STATUS    DVBPSI_EVENT_TRACKER_FOLLOWING_STATUS
+
+/*****************************************************************************
+ * Stream: the tracker and the state of the generated packets
+ *****************************************************************************/
+typedef struct stream_s
+{
+    dvbpsi_event_tracker_t *p_tracker;
+    dvbpsi_t           *p_dvbpsi;       /* for dvbpsi_BuildPSISection() */
+    int64_t             i_date;
+    uint8_t             i_eit_cc;
+    uint8_t             i_rst_cc;
+
+    int                 i_callbacks;
+    unsigned int        i_changes;      /* of the last callback */
+    int64_t             i_callback_date;
+} stream_t;
+
+static void Callback(void *p_cb_data, const dvbpsi_event_tracker_service_t *p_service,
+                     unsigned int i_changes)
+{
+    stream_t *p_stream = (stream_t *)p_cb_data;
+
+    p_stream->i_callbacks++;
+    p_stream->i_changes = i_changes;
+    p_stream->i_callback_date = p_service->i_date;
+}
+
+static void PushSection(stream_t *p_stream, uint16_t i_pid, uint8_t *pi_cc,
+                        const dvbpsi_psi_section_t *p_section)
+{
+    uint8_t p_packets[4 * TEST_TS_SIZE];
+
+    p_stream->i_date += 100000;
+    size_t i_packets = TestPacketizeSections(p_packets, 4, i_pid, pi_cc, p_section);
+    for (size_t i = 0; i < i_packets; i++)
+        dvbpsi_event_tracker_packet_push(p_stream->p_tracker, p_packets + i * TEST_TS_SIZE,
+                                         p_stream->i_date);
+}
+
+/* EIT present/following section 0 (present) or 1 (following), i_event_id 0
+ * for an empty section */
+static void SendEIT(stream_t *p_stream, uint8_t i_version, bool b_current_next,
+                    uint8_t i_number, uint16_t i_event_id, uint8_t i_running_status)
+{
+    dvbpsi_psi_section_t *p_section = dvbpsi_NewPSISection(1024);
+    uint8_t *p = p_section->p_data + 8;
+
+    p_section->i_table_id = 0x4e;
+    p_section->b_syntax_indicator = true;
+    p_section->b_private_indicator = true;
+    p_section->i_extension = SERVICE_ID;
+    p_section->i_version = i_version;
+    p_section->b_current_next = b_current_next;
+    p_section->i_number = i_number;
+    p_section->i_last_number = 1;
+    p_section->p_payload_start = p;
+
+    p[0] = TSID >> 8;
+    p[1] = TSID & 0xff;
+    p[2] = ONID >> 8;
+    p[3] = ONID & 0xff;
+    p[4] = 1;                           /* segment_last_section_number */
+    p[5] = 0x4e;                        /* last_table_id */
+    p += 6;
+    if (i_event_id)
+    {
+        /* 1993-10-13 12:45:00 plus one hour per event, lasting one hour */
+        p[0] = i_event_id >> 8;
+        p[1] = i_event_id & 0xff;
+        p[2] = 0xc0;
+        p[3] = 0x79;
+        p[4] = 0x12 + (i_event_id & 0x07);
+        p[5] = 0x45;
+        p[6] = 0x00;
+        p[7] = 0x01;
+        p[8] = 0x00;
+        p[9] = 0x00;
+        p[10] = i_running_status << 5;
+        p[11] = 0;
+        p += 12;
+    }
+    p_section->p_payload_end = p;
+    p_section->i_length = p - p_section->p_data - 3 + 4;
+    dvbpsi_BuildPSISection(p_stream->p_dvbpsi, p_section);
+
+    PushSection(p_stream, 0x12, &p_stream->i_eit_cc, p_section);
+    dvbpsi_DeletePSISections(p_section);
+}
+
+/* RST section of one event, built by hand */
+static void SendRST(stream_t *p_stream, uint16_t i_event_id, uint8_t i_running_status)
+{
+    dvbpsi_psi_section_t *p_section = dvbpsi_NewPSISection(1024);
+    uint8_t *p = p_section->p_data + 3;
+
+    p_section->i_table_id = 0x71;
+    p_section->b_syntax_indicator = false;
+    p_section->b_private_indicator = false;
+    p_section->p_payload_start = p;
+
+    p[0] = TSID >> 8;
+    p[1] = TSID & 0xff;
+    p[2] = ONID >> 8;
+    p[3] = ONID & 0xff;
+    p[4] = SERVICE_ID >> 8;
+    p[5] = SERVICE_ID & 0xff;
+    p[6] = i_event_id >> 8;
+    p[7] = i_event_id & 0xff;
+    p[8] = 0xf8 | i_running_status;
+    p_section->p_payload_end = p + 9;
+    p_section->i_length = 9;
+    dvbpsi_BuildPSISection(p_stream->p_dvbpsi, p_section);
+
+    PushSection(p_stream, 0x13, &p_stream->i_rst_cc, p_section);
+    dvbpsi_DeletePSISections(p_section);
+}
+
+/*****************************************************************************
+ * Step: compare the callback and the state after a step
+ *****************************************************************************/
+static int Step(stream_t *p_stream, const char *psz_step, unsigned int i_changes,
+                uint16_t i_present, uint8_t i_present_status, uint16_t i_following)
+{
+    const dvbpsi_event_tracker_service_t *p_service =
+        dvbpsi_event_tracker_find(p_stream->p_tracker, ONID, TSID, SERVICE_ID);
+    int i_err = 0;
+
+    if (p_stream->i_callbacks != (i_changes ? 1 : 0) ||
+        (i_changes && (p_stream->i_changes != i_changes ||
+                       p_stream->i_callback_date != p_stream->i_date)))
+    {
+        fprintf(stderr, "  %s: %d callbacks, changes 0x%x instead of 0x%x\n", psz_step,
+                p_stream->i_callbacks, p_stream->i_changes, i_changes);
+        i_err++;
+    }
+    p_stream->i_callbacks = 0;
+    p_stream->i_changes = 0;
+
+    if (p_service == NULL ||
+        p_service->present.b_valid != (i_present != 0) ||
+        (i_present && (p_service->present.i_event_id != i_present ||
+                       p_service->present.i_running_status != i_present_status)) ||
+        p_service->following.b_valid != (i_following != 0) ||
+        (i_following && p_service->following.i_event_id != i_following))
+    {
+        fprintf(stderr, "  %s: present %u (status %u) following %u instead of "
+                "%u (status %u) %u\n", psz_step,
+                p_service && p_service->present.b_valid ? p_service->present.i_event_id : 0,
+                p_service ? p_service->present.i_running_status : 0,
+                p_service && p_service->following.b_valid ? p_service->following.i_event_id : 0,
+                i_present, i_present_status, i_following);
+        i_err++;
+    }
+    return i_err;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckTransitions(void)
+{
+    stream_t stream;
+    int i_err = 0;
+
+    fprintf(stdout, "\"present/following transitions\" event tracker check:\n");
+    memset(&stream, 0, sizeof(stream));
+    stream.p_tracker = dvbpsi_event_tracker_new(Callback, &stream, NULL, DVBPSI_MSG_NONE);
+    stream.p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (stream.p_tracker == NULL || stream.p_dvbpsi == NULL)
+        return 1;
+
+    SendEIT(&stream, 0, true, 0, 100, RUNNING);
+    i_err += Step(&stream, "first present", PRESENT_EVENT | PRESENT_STATUS, 100, RUNNING, 0);
+    SendEIT(&stream, 0, true, 1, 101, NOT_RUNNING);
+    i_err += Step(&stream, "first following", FOLLOWING_EVENT | FOLLOWING_STATUS,
+                  100, RUNNING, 101);
+
+    /* repetitions of the same version change nothing */
+    SendEIT(&stream, 0, true, 0, 100, RUNNING);
+    SendEIT(&stream, 0, true, 1, 101, NOT_RUNNING);
+    i_err += Step(&stream, "repetition", 0, 100, RUNNING, 101);
+
+    /* the RST starts the following event before the EIT does */
+    SendRST(&stream, 101, RUNNING);
+    i_err += Step(&stream, "RST start", PRESENT_EVENT | FOLLOWING_EVENT, 101, RUNNING, 0);
+
+    /* the new version of the EIT confirms it and announces the next one */
+    SendEIT(&stream, 1, true, 0, 101, RUNNING);
+    i_err += Step(&stream, "EIT confirmation", 0, 101, RUNNING, 0);
+    SendEIT(&stream, 1, true, 1, 102, NOT_RUNNING);
+    i_err += Step(&stream, "next following", FOLLOWING_EVENT | FOLLOWING_STATUS,
+                  101, RUNNING, 102);
+
+    /* a version only changing the running status */
+    SendEIT(&stream, 2, true, 0, 101, PAUSING);
+    i_err += Step(&stream, "pause", PRESENT_STATUS, 101, PAUSING, 102);
+
+    /* the next version of the table is not applied before it is current */
+    SendEIT(&stream, 3, false, 0, 102, RUNNING);
+    i_err += Step(&stream, "next version", 0, 101, PAUSING, 102);
+
+    /* the following event is withdrawn */
+    SendEIT(&stream, 3, true, 1, 0, 0);
+    i_err += Step(&stream, "no following", FOLLOWING_EVENT, 101, PAUSING, 0);
+
+    /* an event unknown to the EIT starts */
+    SendRST(&stream, 200, RUNNING);
+    i_err += Step(&stream, "unknown event", PRESENT_EVENT | PRESENT_STATUS, 200, RUNNING, 0);
+
+    dvbpsi_event_tracker_delete(stream.p_tracker);
+    dvbpsi_delete(stream.p_dvbpsi);
+
+    if (i_err)
+        fprintf(stderr, "\"present/following transitions\" event tracker check FAILED !!!\n\n");
+    else
+        fprintf(stdout, "  \"present/following transitions\" OK\n\n");
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckTransitions();
+
+    if (i_err)
+        fprintf(stderr, "%d event tracker checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
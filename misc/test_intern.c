@@ -0,0 +1,188 @@
+/*****************************************************************************
+ * test_intern.c: descriptor interning check
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Two descriptor loops carrying the same short event descriptor are
+ * interned in one table. The second copy must get the decoded form of the
+ * first one as soon as the first one is decoded, both by the decoder and
+ * through a descriptor registry. The loops are released in both orders
+ * with respect to the table.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/descriptor.h"
+#include "../src/descriptor_registry.h"
+#include "../src/descriptors/dr.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/descriptor_registry.h>
+#include <dvbpsi/dr.h>
+#endif
+
+/* short_event_descriptor: "eng", "News", "Headlines" */
+static const uint8_t p_short_event[] =
+{
+    'e', 'n', 'g', 4, 'N', 'e', 'w', 's',
+    9, 'H', 'e', 'a', 'd', 'l', 'i', 'n', 'e', 's'
+};
+
+/*****************************************************************************
+ * NewLoop: a loop of the short event descriptor followed by a private one
+ *****************************************************************************/
+static dvbpsi_descriptor_t *NewLoop(uint8_t i_private)
+{
+    dvbpsi_descriptor_t *p_first = dvbpsi_NewDescriptor(0x4d, sizeof(p_short_event),
+                                                        p_short_event);
+    dvbpsi_descriptor_t *p_private = dvbpsi_NewDescriptor(0x80, 1, &i_private);
+    if (p_first == NULL || p_private == NULL)
+    {
+        dvbpsi_DeleteDescriptors(p_first);
+        dvbpsi_DeleteDescriptors(p_private);
+        return NULL;
+    }
+    return dvbpsi_AddDescriptor(p_first, p_private);
+}
+
+/*****************************************************************************
+ * Check: intern two loops, decode the first one, look at the second one
+ *****************************************************************************/
+static int Check(const char *psz_name, bool b_registry, bool b_intern_first)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"%s\" interning check:\n", psz_name);
+
+    dvbpsi_descriptor_intern_t *p_intern = dvbpsi_descriptor_intern_new();
+    dvbpsi_descriptor_t *p_loop1 = NewLoop(1);
+    dvbpsi_descriptor_t *p_loop2 = NewLoop(2);
+    if (p_intern == NULL || p_loop1 == NULL || p_loop2 == NULL)
+    {
+        fprintf(stderr, "  allocation error\n");
+        dvbpsi_DeleteDescriptors(p_loop1);
+        dvbpsi_DeleteDescriptors(p_loop2);
+        dvbpsi_descriptor_intern_delete(p_intern);
+        return 1;
+    }
+
+    if (dvbpsi_descriptor_intern_list(p_intern, p_loop1) != 0 ||
+        dvbpsi_descriptor_intern_list(p_intern, p_loop2) != 1 ||
+        p_loop1->p_data != p_loop2->p_data)
+    {
+        fprintf(stderr, "  payload not shared\n");
+        i_err++;
+    }
+
+    if (b_registry)
+    {
+        dvbpsi_descriptor_registry_t *p_registry = dvbpsi_descriptor_registry_new();
+        if (p_registry == NULL ||
+            dvbpsi_descriptors_decode(p_registry, DVBPSI_DESCRIPTOR_DVB, p_loop1) != 1)
+        {
+            fprintf(stderr, "  first loop not decoded\n");
+            i_err++;
+        }
+        dvbpsi_descriptor_registry_delete(p_registry);
+    }
+    else if (dvbpsi_decode_dvb_short_event_dr(p_loop1) == NULL)
+    {
+        fprintf(stderr, "  first copy not decoded\n");
+        i_err++;
+    }
+
+    /* the second copy is decoded without decoding it again */
+    if (p_loop1->p_decoded == NULL || !dvbpsi_IsDescriptorDecoded(p_loop2) ||
+        p_loop2->p_decoded != p_loop1->p_decoded)
+    {
+        fprintf(stderr, "  decoded form not shared\n");
+        i_err++;
+    }
+    else if (dvbpsi_decode_dvb_short_event_dr(p_loop2) != p_loop1->p_decoded)
+    {
+        fprintf(stderr, "  second copy decoded again\n");
+        i_err++;
+    }
+    else
+    {
+        const dvbpsi_dvb_short_event_dr_t *p_decoded = p_loop2->p_decoded;
+        if (p_decoded->i_event_name_length != 4 ||
+            memcmp(p_decoded->i_event_name, "News", 4) ||
+            p_decoded->i_text_length != 9 ||
+            memcmp(p_decoded->i_text, "Headlines", 9))
+        {
+            fprintf(stderr, "  wrong decoded form\n");
+            i_err++;
+        }
+    }
+
+    unsigned int i_references;
+    if (dvbpsi_descriptor_intern_count(p_intern, &i_references) != 3 ||
+        i_references != 4)
+    {
+        fprintf(stderr, "  wrong table count\n");
+        i_err++;
+    }
+
+    if (b_intern_first)
+        dvbpsi_descriptor_intern_delete(p_intern);
+    dvbpsi_DeleteDescriptors(p_loop1);
+    dvbpsi_DeleteDescriptors(p_loop2);
+    if (!b_intern_first)
+        dvbpsi_descriptor_intern_delete(p_intern);
+
+    if (i_err)
+        fprintf(stderr, "\"%s\" FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += Check("decoder", false, false);
+    i_err += Check("registry", true, false);
+    i_err += Check("table deleted first", false, true);
+
+    if (i_err)
+        fprintf(stderr, "%d interning checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
@@ -0,0 +1,370 @@
+/*****************************************************************************
+ * test_lcn.c: logical channel number engine checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * The transport stream loops of the NITs and BATs are given as raw
+ * descriptor bytes. Each check applies a few tables and settings and
+ * compares the number, origin and conflict state of the services with the
+ * expected ones.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/descriptor.h"
+#include "../src/tables/nit.h"
+#include "../src/tables/bat.h"
+#include "../src/lcn.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/nit.h>
+#include <dvbpsi/bat.h>
+#include <dvbpsi/lcn.h>
+#endif
+
+#define ONID            0x01
+
+/* private_data_specifier_descriptor */
+#define PDS(pds)        0x5f, 4, (pds) >> 24, ((pds) >> 16) & 0xff, ((pds) >> 8) & 0xff, \
+                        (pds) & 0xff
+/* one service of a logical channel descriptor, visible or not */
+#define ENTRY(sid, lcn, visible) \
+                        (sid) >> 8, (sid) & 0xff, ((visible) ? 0x80 : 0x00) | ((lcn) >> 8), \
+                        (lcn) & 0xff
+
+/*****************************************************************************
+ * Tables: one transport stream loop of raw descriptors
+ *****************************************************************************/
+static bool UpdateNit(dvbpsi_lcn_t *p_lcn, uint8_t i_table_id, uint16_t i_network_id,
+                      uint16_t i_tsid, const uint8_t *p_loop, size_t i_loop)
+{
+    dvbpsi_nit_t nit;
+
+    dvbpsi_nit_init(&nit, i_table_id, i_network_id, i_network_id, 0, true);
+    dvbpsi_nit_ts_t *p_ts = dvbpsi_nit_ts_add(&nit, i_tsid, ONID);
+    for (size_t i = 0; i + 2 <= i_loop; i += 2 + p_loop[i + 1])
+        dvbpsi_nit_ts_descriptor_add(p_ts, p_loop[i], p_loop[i + 1], p_loop + i + 2);
+
+    bool b_ok = dvbpsi_lcn_update_nit(p_lcn, &nit);
+    dvbpsi_nit_empty(&nit);
+    return b_ok;
+}
+
+static bool UpdateBat(dvbpsi_lcn_t *p_lcn, uint16_t i_bouquet_id, uint16_t i_tsid,
+                      const uint8_t *p_loop, size_t i_loop)
+{
+    dvbpsi_bat_t bat;
+
+    dvbpsi_bat_init(&bat, 0x4a, i_bouquet_id, 0, true);
+    dvbpsi_bat_ts_t *p_ts = dvbpsi_bat_ts_add(&bat, i_tsid, ONID);
+    for (size_t i = 0; i + 2 <= i_loop; i += 2 + p_loop[i + 1])
+        dvbpsi_bat_ts_descriptor_add(p_ts, p_loop[i], p_loop[i + 1], p_loop + i + 2);
+
+    bool b_ok = dvbpsi_lcn_update_bat(p_lcn, &bat);
+    dvbpsi_bat_empty(&bat);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * CheckService: compare the number of a service, i_lcn 0 when it has none
+ *****************************************************************************/
+static int CheckService(const dvbpsi_lcn_t *p_lcn, uint16_t i_tsid, uint16_t i_service_id,
+                        uint16_t i_lcn, uint8_t i_origin, bool b_conflict)
+{
+    const dvbpsi_lcn_service_t *p_service = dvbpsi_lcn_find(p_lcn, ONID, i_tsid,
+                                                            i_service_id);
+    if (p_service == NULL || i_lcn == 0)
+    {
+        if (p_service == NULL && i_lcn == 0)
+            return 0;
+        fprintf(stderr, "  service %u: LCN %u instead of %u\n", i_service_id,
+                p_service ? p_service->i_lcn : 0, i_lcn);
+        return 1;
+    }
+    if (p_service->i_lcn != i_lcn || p_service->i_origin != i_origin ||
+        p_service->b_conflict != b_conflict)
+    {
+        fprintf(stderr, "  service %u: LCN %u origin %u%s instead of LCN %u origin %u%s\n",
+                i_service_id, p_service->i_lcn, p_service->i_origin,
+                p_service->b_conflict ? " in conflict" : "", i_lcn, i_origin,
+                b_conflict ? " in conflict" : "");
+        return 1;
+    }
+    return 0;
+}
+
+static int Result(const char *psz_name, int i_err)
+{
+    if (i_err)
+        fprintf(stderr, "\"%s\" LCN check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+/* the same bytes give a 10 bit EACEM number or a 14 bit NorDig version 1
+ * number, descriptors under an unknown specifier are ignored */
+static int CheckSpecifiers(void)
+{
+    static const uint8_t p_eacem[] =
+    {
+        0x83, 4, ENTRY(1, 0x0405, true),
+    };
+    static const uint8_t p_nordig[] =
+    {
+        PDS(DVBPSI_LCN_PDS_NORDIG),
+        0x83, 4, ENTRY(2, 0x0405, true),
+    };
+    static const uint8_t p_unknown[] =
+    {
+        PDS(0x12345678),
+        0x83, 4, ENTRY(3, 0x0405, true),
+    };
+    int i_err = 0;
+
+    fprintf(stdout, "\"private_data_specifier\" LCN check:\n");
+    dvbpsi_lcn_t *p_lcn = dvbpsi_lcn_new(NULL, NULL);
+    if (p_lcn == NULL)
+        return 1;
+
+    i_err += !UpdateNit(p_lcn, 0x40, 1, 1, p_eacem, sizeof(p_eacem));
+    i_err += !UpdateNit(p_lcn, 0x41, 2, 2, p_nordig, sizeof(p_nordig));
+    i_err += !UpdateNit(p_lcn, 0x41, 3, 3, p_unknown, sizeof(p_unknown));
+    i_err += CheckService(p_lcn, 1, 1, 5, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 2, 2, 0x405, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 3, 3, 0, 0, false);
+
+    /* with NorDig as default specifier, the first loop is read as NorDig and
+     * the NIT actual wins the number */
+    dvbpsi_lcn_set_default_pds(p_lcn, DVBPSI_LCN_PDS_NORDIG);
+    i_err += !UpdateNit(p_lcn, 0x40, 1, 1, p_eacem, sizeof(p_eacem));
+    i_err += CheckService(p_lcn, 1, 1, 0x405, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 2, 2, 0x405, DVBPSI_LCN_ORIGIN_V1, true);
+    if (dvbpsi_lcn_count(p_lcn) != 2 || dvbpsi_lcn_lookup(p_lcn, 5) != NULL)
+    {
+        fprintf(stderr, "  %u services numbered\n", dvbpsi_lcn_count(p_lcn));
+        i_err++;
+    }
+
+    dvbpsi_lcn_delete(p_lcn);
+    return Result("private_data_specifier", i_err);
+}
+
+/* a NorDig version 2 number beats a version 1 number, the channel list of
+ * the region is selected */
+static int CheckNorDigV2(void)
+{
+    static const uint8_t p_loop[] =
+    {
+        PDS(DVBPSI_LCN_PDS_NORDIG),
+        0x83, 4, ENTRY(1, 10, true),
+        0x87, 2 * 11,
+            /* channel list 2 "B", Norway */
+            2, 1, 'B', 'N', 'O', 'R', 4, ENTRY(1, 20, true),
+            /* channel list 1 "A", Sweden */
+            1, 1, 'A', 'S', 'W', 'E', 4, ENTRY(1, 30, true),
+    };
+    int i_err = 0;
+
+    fprintf(stdout, "\"NorDig version 2\" LCN check:\n");
+    dvbpsi_lcn_t *p_lcn = dvbpsi_lcn_new(NULL, NULL);
+    if (p_lcn == NULL)
+        return 1;
+
+    i_err += !UpdateNit(p_lcn, 0x40, 1, 1, p_loop, sizeof(p_loop));
+    /* the lowest channel_list_id by default */
+    i_err += CheckService(p_lcn, 1, 1, 30, DVBPSI_LCN_ORIGIN_V2, false);
+    dvbpsi_lcn_set_channel_list(p_lcn, 2);
+    i_err += CheckService(p_lcn, 1, 1, 20, DVBPSI_LCN_ORIGIN_V2, false);
+    /* no number in the selected list: back to version 1 */
+    dvbpsi_lcn_set_channel_list(p_lcn, 3);
+    i_err += CheckService(p_lcn, 1, 1, 10, DVBPSI_LCN_ORIGIN_V1, false);
+    if (dvbpsi_lcn_lookup(p_lcn, 20) != NULL || dvbpsi_lcn_lookup(p_lcn, 30) != NULL)
+    {
+        fprintf(stderr, "  numbers of the unselected lists still assigned\n");
+        i_err++;
+    }
+
+    dvbpsi_lcn_delete(p_lcn);
+    return Result("NorDig version 2", i_err);
+}
+
+/* the HD service takes the number of its SD simulcast when enabled, the SD
+ * service then conflicts with it */
+static int CheckHDSimulcast(void)
+{
+    static const uint8_t p_loop[] =
+    {
+        0x83, 8, ENTRY(1, 1, true), ENTRY(2, 50, true),
+        0x88, 4, ENTRY(2, 1, true),
+    };
+    int i_err = 0;
+
+    fprintf(stdout, "\"HD simulcast\" LCN check:\n");
+    dvbpsi_lcn_t *p_lcn = dvbpsi_lcn_new(NULL, NULL);
+    if (p_lcn == NULL)
+        return 1;
+
+    i_err += !UpdateNit(p_lcn, 0x40, 1, 1, p_loop, sizeof(p_loop));
+    i_err += CheckService(p_lcn, 1, 1, 1, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 1, 2, 50, DVBPSI_LCN_ORIGIN_V1, false);
+
+    dvbpsi_lcn_set_hd_simulcast(p_lcn, true);
+    i_err += CheckService(p_lcn, 1, 1, 1, DVBPSI_LCN_ORIGIN_V1, true);
+    i_err += CheckService(p_lcn, 1, 2, 1, DVBPSI_LCN_ORIGIN_HD_SIMULCAST, false);
+    const dvbpsi_lcn_service_t *p_owner = dvbpsi_lcn_lookup(p_lcn, 1);
+    if (p_owner == NULL || p_owner->i_service_id != 2 || dvbpsi_lcn_lookup(p_lcn, 50))
+    {
+        fprintf(stderr, "  LCN 1 not owned by the HD service\n");
+        i_err++;
+    }
+
+    dvbpsi_lcn_set_hd_simulcast(p_lcn, false);
+    i_err += CheckService(p_lcn, 1, 1, 1, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 1, 2, 50, DVBPSI_LCN_ORIGIN_V1, false);
+
+    dvbpsi_lcn_delete(p_lcn);
+    return Result("HD simulcast", i_err);
+}
+
+/* services of several tables claiming the same number */
+typedef struct log_s
+{
+    int             i_callbacks;
+    dvbpsi_lcn_service_t last[4];       /* last callback of each service */
+} log_t;
+
+static void Callback(void *p_cb_data, const dvbpsi_lcn_service_t *p_service)
+{
+    log_t *p_log = (log_t *)p_cb_data;
+
+    p_log->i_callbacks++;
+    if (p_service->i_service_id < 4)
+        p_log->last[p_service->i_service_id] = *p_service;
+}
+
+static int CheckConflicts(void)
+{
+    static const uint8_t p_actual[] =
+    {
+        0x83, 8, ENTRY(1, 3, true), ENTRY(2, 3, false),
+    };
+    static const uint8_t p_actual_v2[] =
+    {
+        0x83, 4, ENTRY(2, 3, false),
+    };
+    static const uint8_t p_other[] =
+    {
+        0x83, 4, ENTRY(3, 4, true),
+    };
+    static const uint8_t p_other_1[] =
+    {
+        0x83, 4, ENTRY(1, 8, true),
+    };
+    static const uint8_t p_bouquet[] =
+    {
+        0x83, 4, ENTRY(3, 3, true),
+    };
+    log_t log;
+    int i_err = 0;
+
+    fprintf(stdout, "\"conflicts\" LCN check:\n");
+    memset(&log, 0, sizeof(log));
+    dvbpsi_lcn_t *p_lcn = dvbpsi_lcn_new(Callback, &log);
+    if (p_lcn == NULL)
+        return 1;
+
+    /* the visible service owns the number */
+    i_err += !UpdateNit(p_lcn, 0x40, 1, 1, p_actual, sizeof(p_actual));
+    i_err += CheckService(p_lcn, 1, 1, 3, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 1, 2, 3, DVBPSI_LCN_ORIGIN_V1, true);
+
+    /* the NIT actual beats the NIT other, a BAT beats the NIT other */
+    i_err += !UpdateNit(p_lcn, 0x41, 2, 2, p_other, sizeof(p_other));
+    i_err += !UpdateNit(p_lcn, 0x41, 3, 1, p_other_1, sizeof(p_other_1));
+    i_err += CheckService(p_lcn, 1, 1, 3, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 2, 3, 4, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += !UpdateBat(p_lcn, 0x10, 2, p_bouquet, sizeof(p_bouquet));
+    i_err += CheckService(p_lcn, 1, 1, 3, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 2, 3, 3, DVBPSI_LCN_ORIGIN_V1, true);
+
+    /* the preferred bouquet beats the NIT actual */
+    log.i_callbacks = 0;
+    dvbpsi_lcn_set_bouquet(p_lcn, 0x10);
+    i_err += CheckService(p_lcn, 1, 1, 3, DVBPSI_LCN_ORIGIN_V1, true);
+    i_err += CheckService(p_lcn, 2, 3, 3, DVBPSI_LCN_ORIGIN_V1, false);
+    if (log.i_callbacks == 0 || !log.last[1].b_conflict || log.last[3].b_conflict ||
+        !log.last[3].b_bat || log.last[3].i_source_id != 0x10)
+    {
+        fprintf(stderr, "  change of owner not reported\n");
+        i_err++;
+    }
+
+    /* a new NIT actual drops service 1, which falls back to the NIT other */
+    i_err += !UpdateNit(p_lcn, 0x40, 1, 1, p_actual_v2, sizeof(p_actual_v2));
+    i_err += CheckService(p_lcn, 1, 1, 8, DVBPSI_LCN_ORIGIN_V1, false);
+    i_err += CheckService(p_lcn, 1, 2, 3, DVBPSI_LCN_ORIGIN_V1, true);
+    const dvbpsi_lcn_service_t *p_list[4];
+    if (dvbpsi_lcn_list(p_lcn, 0, p_list, 4) != 3 || p_list[0]->i_service_id != 3 ||
+        p_list[1]->i_service_id != 2 || p_list[2]->i_service_id != 1)
+    {
+        fprintf(stderr, "  channel list not sorted by number then rank\n");
+        i_err++;
+    }
+
+    dvbpsi_lcn_delete(p_lcn);
+    return Result("conflicts", i_err);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckSpecifiers();
+    i_err += CheckNorDigV2();
+    i_err += CheckHDSimulcast();
+    i_err += CheckConflicts();
+
+    if (i_err)
+        fprintf(stderr, "%d LCN checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
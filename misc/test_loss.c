@@ -0,0 +1,208 @@
+/*****************************************************************************
+ * test_loss.c: section acquisition checks on a lossy transport stream
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * A PAT of 5 sections of 3 packets each is repeated, and every repetition
+ * loses or reorders some packets. The checks compare whether the table
+ * is acquired with and without dvbpsi_set_loss_tolerant(), and compare the
+ * recovered programs with the generated ones.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/tables/pat.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/pat.h>
+#endif
+
+#include "test_ts.h"
+
+#define PROGRAMS        500
+#define PROGRAMS_PER_SECTION 100
+#define SECTIONS        (PROGRAMS / PROGRAMS_PER_SECTION)
+#define PACKETS_PER_SECTION 3
+#define PACKETS         (SECTIONS * PACKETS_PER_SECTION)
+#define CYCLES          10
+
+/*****************************************************************************
+ * Acquisition: the decoded PATs
+ *****************************************************************************/
+typedef struct acquisition_s
+{
+    int             i_tables;
+    int             i_errors;       /* programs differing from the generated ones */
+} acquisition_t;
+
+static void DumpPAT(void *p_cb_data, dvbpsi_pat_t *p_pat)
+{
+    acquisition_t *p_acq = (acquisition_t *)p_cb_data;
+    int i = 0;
+
+    for (const dvbpsi_pat_program_t *p = p_pat->p_first_program; p; p = p->p_next, i++)
+        if (p->i_number != i + 1 || p->i_pid != 0x100 + i)
+            p_acq->i_errors++;
+    if (i != PROGRAMS)
+        p_acq->i_errors++;
+
+    p_acq->i_tables++;
+    dvbpsi_pat_delete(p_pat);
+}
+
+/*****************************************************************************
+ * Damage: what happens to the packets of a repetition
+ *****************************************************************************/
+typedef void (*damage_t)(int i_cycle, int *pi_order, int *pi_packets);
+
+/* each repetition loses the middle packet of two sections, never more than
+ * three sections go through between two losses */
+static void Drop(int i_cycle, int *pi_order, int *pi_packets)
+{
+    int i_lost1 = (i_cycle % SECTIONS) * PACKETS_PER_SECTION + 1;
+    int i_lost2 = ((i_cycle + 2) % SECTIONS) * PACKETS_PER_SECTION + 1;
+    int j = 0;
+
+    for (int i = 0; i < PACKETS; i++)
+        if (i != i_lost1 && i != i_lost2)
+            pi_order[j++] = i;
+    *pi_packets = j;
+}
+
+/* each repetition swaps two packets: two consecutive packets of a section,
+ * or the last packet of a section and the first of the next one */
+static void Reorder(int i_cycle, int *pi_order, int *pi_packets)
+{
+    int i_swap = (i_cycle * 4 + 1) % (PACKETS - 1);
+
+    for (int i = 0; i < PACKETS; i++)
+        pi_order[i] = i;
+    pi_order[i_swap] = i_swap + 1;
+    pi_order[i_swap + 1] = i_swap;
+    *pi_packets = PACKETS;
+}
+
+/*****************************************************************************
+ * Acquire: send CYCLES damaged repetitions of the PAT
+ *****************************************************************************/
+static void Acquire(acquisition_t *p_acq, bool b_tolerant, damage_t pf_damage)
+{
+    uint8_t p_packets[PACKETS * TEST_TS_SIZE];
+    uint8_t i_cc = 0;
+    dvbpsi_pat_t pat;
+
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    memset(p_acq, 0, sizeof(acquisition_t));
+    if (p_dvbpsi == NULL || !dvbpsi_pat_attach(p_dvbpsi, DumpPAT, p_acq))
+    {
+        p_acq->i_errors++;
+        dvbpsi_delete(p_dvbpsi);
+        return;
+    }
+    dvbpsi_set_loss_tolerant(p_dvbpsi, b_tolerant);
+
+    dvbpsi_pat_init(&pat, 1, 0, true);
+    for (int i = 0; i < PROGRAMS; i++)
+        dvbpsi_pat_program_add(&pat, i + 1, 0x100 + i);
+    dvbpsi_psi_section_t *p_sections = dvbpsi_pat_sections_generate(p_dvbpsi, &pat,
+                                                                    PROGRAMS_PER_SECTION);
+    dvbpsi_pat_empty(&pat);
+
+    for (int i_cycle = 0; i_cycle < CYCLES; i_cycle++)
+    {
+        int pi_order[PACKETS], i_packets;
+
+        /* the packets of a repetition have consecutive counters */
+        if (TestPacketizeSections(p_packets, PACKETS, 0x00, &i_cc, p_sections) != PACKETS)
+            p_acq->i_errors++;
+        pf_damage(i_cycle, pi_order, &i_packets);
+        for (int i = 0; i < i_packets; i++)
+            dvbpsi_packet_push(p_dvbpsi, p_packets + pi_order[i] * TEST_TS_SIZE);
+    }
+
+    dvbpsi_DeletePSISections(p_sections);
+    dvbpsi_pat_detach(p_dvbpsi);
+    dvbpsi_delete(p_dvbpsi);
+}
+
+/*****************************************************************************
+ * Check: compare an acquisition with the expected one
+ *****************************************************************************/
+static int Check(const char *psz_name, bool b_tolerant, damage_t pf_damage,
+                 bool b_acquired)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"%s\" acquisition check:\n", psz_name);
+
+    acquisition_t acq;
+    Acquire(&acq, b_tolerant, pf_damage);
+    if ((acq.i_tables > 0) != b_acquired || acq.i_tables > 1)
+    {
+        fprintf(stderr, "  %d tables instead of %d\n", acq.i_tables, b_acquired ? 1 : 0);
+        i_err++;
+    }
+    if (acq.i_errors)
+    {
+        fprintf(stderr, "  %d errors in the recovered programs\n", acq.i_errors);
+        i_err++;
+    }
+
+    if (i_err)
+        fprintf(stderr, "\"%s\" acquisition check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    /* a discontinuity drops the gathered sections: the table never
+     * completes */
+    i_err += Check("lost packets", false, Drop, false);
+    i_err += Check("lost packets, loss tolerant", true, Drop, true);
+    i_err += Check("reordered packets, loss tolerant", true, Reorder, true);
+
+    if (i_err)
+        fprintf(stderr, "%d acquisition checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
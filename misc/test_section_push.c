@@ -0,0 +1,363 @@
+/*****************************************************************************
+ * test_section_push.c: checks of sections pushed without TS packets
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * The sections of a generated PAT are handed to dvbpsi_section_push() as a
+ * kernel demultiplexer delivers them. The checks compare the decoded table
+ * and the pf_section callbacks with the expected ones, for valid, corrupted
+ * and malformed sections, and for sections mixed with TS packets.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/tables/pat.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/pat.h>
+#endif
+
+#include "test_ts.h"
+
+#define PROGRAMS        300
+#define PROGRAMS_PER_SECTION 100
+#define SECTIONS        (PROGRAMS / PROGRAMS_PER_SECTION)
+#define PACKETS_PER_SECTION 3
+#define SECTION_MAX     1024
+
+/*****************************************************************************
+ * Reception: what the decoder and the section callback got
+ *****************************************************************************/
+typedef struct reception_s
+{
+    int             i_tables;
+    int             i_errors;       /* programs differing from the generated ones */
+    int             i_valid;        /* sections seen by pf_section */
+    int             i_invalid;
+    int64_t         i_date;         /* date of the last valid section */
+} reception_t;
+
+static void DumpPAT(void *p_cb_data, dvbpsi_pat_t *p_pat)
+{
+    reception_t *p_rcv = (reception_t *)p_cb_data;
+    int i = 0;
+
+    for (const dvbpsi_pat_program_t *p = p_pat->p_first_program; p; p = p->p_next, i++)
+        if (p->i_number != i + 1 || p->i_pid != 0x100 + i)
+            p_rcv->i_errors++;
+    if (i != PROGRAMS)
+        p_rcv->i_errors++;
+
+    p_rcv->i_tables++;
+    dvbpsi_pat_delete(p_pat);
+}
+
+static void SectionCb(dvbpsi_t *p_dvbpsi, const dvbpsi_psi_section_t *p_section,
+                      const bool b_valid)
+{
+    reception_t *p_rcv = (reception_t *)p_dvbpsi->p_sys;
+
+    if (b_valid)
+    {
+        p_rcv->i_valid++;
+        p_rcv->i_date = p_section->i_complete_date;
+    }
+    else
+        p_rcv->i_invalid++;
+}
+
+/*****************************************************************************
+ * Helpers
+ *****************************************************************************/
+static dvbpsi_t *NewDecoder(reception_t *p_rcv)
+{
+    memset(p_rcv, 0, sizeof(reception_t));
+
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (p_dvbpsi == NULL)
+        return NULL;
+    if (!dvbpsi_pat_attach(p_dvbpsi, DumpPAT, p_rcv))
+    {
+        dvbpsi_delete(p_dvbpsi);
+        return NULL;
+    }
+    p_dvbpsi->p_sys = p_rcv;
+    p_dvbpsi->pf_section = SectionCb;
+    return p_dvbpsi;
+}
+
+static void DeleteDecoder(dvbpsi_t *p_dvbpsi)
+{
+    dvbpsi_pat_detach(p_dvbpsi);
+    dvbpsi_delete(p_dvbpsi);
+}
+
+static dvbpsi_psi_section_t *NewSections(dvbpsi_t *p_dvbpsi)
+{
+    dvbpsi_pat_t pat;
+
+    dvbpsi_pat_init(&pat, 1, 0, true);
+    for (int i = 0; i < PROGRAMS; i++)
+        dvbpsi_pat_program_add(&pat, i + 1, 0x100 + i);
+    dvbpsi_psi_section_t *p_sections = dvbpsi_pat_sections_generate(p_dvbpsi, &pat,
+                                                                    PROGRAMS_PER_SECTION);
+    dvbpsi_pat_empty(&pat);
+    return p_sections;
+}
+
+/* copy the n-th generated section in p_buffer, returns its size */
+static size_t CopySection(uint8_t *p_buffer, const dvbpsi_psi_section_t *p_sections,
+                          int i_number)
+{
+    const dvbpsi_psi_section_t *p_section = p_sections;
+
+    for (int i = 0; i < i_number && p_section; i++)
+        p_section = p_section->p_next;
+    if (p_section == NULL)
+        return 0;
+
+    size_t i_size = TestSectionSize(p_section);
+    memcpy(p_buffer, p_section->p_data, i_size);
+    return i_size;
+}
+
+static int Result(const char *psz_name, int i_err)
+{
+    if (i_err)
+        fprintf(stderr, "\"%s\" section push check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+static int CheckReception(const reception_t *p_rcv, int i_tables, int i_valid,
+                          int i_invalid)
+{
+    if (p_rcv->i_tables != i_tables || p_rcv->i_errors ||
+        p_rcv->i_valid != i_valid || p_rcv->i_invalid != i_invalid)
+    {
+        fprintf(stderr, "  %d tables (%d errors), %d valid and %d invalid sections"
+                        " instead of %d tables, %d valid and %d invalid sections\n",
+                p_rcv->i_tables, p_rcv->i_errors, p_rcv->i_valid, p_rcv->i_invalid,
+                i_tables, i_valid, i_invalid);
+        return 1;
+    }
+    return 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckValid(void)
+{
+    int i_err = 0;
+    uint8_t p_buffer[SECTION_MAX + 16];
+    reception_t rcv;
+
+    fprintf(stdout, "\"valid sections\" section push check:\n");
+    dvbpsi_t *p_dvbpsi = NewDecoder(&rcv);
+    if (p_dvbpsi == NULL)
+        return Result("valid sections", 1);
+    dvbpsi_psi_section_t *p_sections = NewSections(p_dvbpsi);
+
+    for (int i = 0; i < SECTIONS; i++)
+    {
+        size_t i_size = CopySection(p_buffer, p_sections, i);
+        /* bytes after the end given by section_length are ignored */
+        memset(p_buffer + i_size, 0xff, 16);
+        if (!dvbpsi_section_push(p_dvbpsi, p_buffer, i_size + (i % 2) * 16,
+                                 true, 1000 * (i + 1)))
+        {
+            fprintf(stderr, "  section %d rejected\n", i);
+            i_err++;
+        }
+    }
+    i_err += CheckReception(&rcv, 1, SECTIONS, 0);
+    if (rcv.i_date != 1000 * SECTIONS)
+    {
+        fprintf(stderr, "  section date %"PRId64" instead of %d\n",
+                rcv.i_date, 1000 * SECTIONS);
+        i_err++;
+    }
+
+    dvbpsi_DeletePSISections(p_sections);
+    DeleteDecoder(p_dvbpsi);
+    return Result("valid sections", i_err);
+}
+
+static int CheckCRC(bool b_check_crc)
+{
+    const char *psz_name = b_check_crc ? "bad CRC_32 checked" : "bad CRC_32 trusted";
+    int i_err = 0;
+    uint8_t p_buffer[SECTION_MAX];
+    reception_t rcv;
+
+    fprintf(stdout, "\"%s\" section push check:\n", psz_name);
+    dvbpsi_t *p_dvbpsi = NewDecoder(&rcv);
+    if (p_dvbpsi == NULL)
+        return Result(psz_name, 1);
+    dvbpsi_psi_section_t *p_sections = NewSections(p_dvbpsi);
+
+    /* the CRC_32 of the second section is corrupted */
+    for (int i = 0; i < SECTIONS; i++)
+    {
+        size_t i_size = CopySection(p_buffer, p_sections, i);
+        if (i == 1)
+            p_buffer[i_size - 1] ^= 0x01;
+        bool b_pushed = dvbpsi_section_push(p_dvbpsi, p_buffer, i_size, b_check_crc, 0);
+        if (b_pushed != (i != 1 || !b_check_crc))
+        {
+            fprintf(stderr, "  section %d %s\n", i, b_pushed ? "accepted" : "rejected");
+            i_err++;
+        }
+    }
+    /* a source checking the CRC_32 itself never delivers such a section,
+     * it is trusted when the check is skipped */
+    if (b_check_crc)
+        i_err += CheckReception(&rcv, 0, SECTIONS - 1, 1);
+    else
+        i_err += CheckReception(&rcv, 1, SECTIONS, 0);
+
+    dvbpsi_DeletePSISections(p_sections);
+    DeleteDecoder(p_dvbpsi);
+    return Result(psz_name, i_err);
+}
+
+static int CheckMalformed(void)
+{
+    int i_err = 0;
+    uint8_t p_buffer[SECTION_MAX + 8];
+    reception_t rcv;
+
+    fprintf(stdout, "\"malformed sections\" section push check:\n");
+    dvbpsi_t *p_dvbpsi = NewDecoder(&rcv);
+    if (p_dvbpsi == NULL)
+        return Result("malformed sections", 1);
+    dvbpsi_psi_section_t *p_sections = NewSections(p_dvbpsi);
+    size_t i_size = CopySection(p_buffer, p_sections, 0);
+
+    /* shorter than the section header */
+    if (dvbpsi_section_push(p_dvbpsi, p_buffer, 2, true, 0))
+    {
+        fprintf(stderr, "  2 byte section accepted\n");
+        i_err++;
+    }
+    /* shorter than section_length */
+    if (dvbpsi_section_push(p_dvbpsi, p_buffer, i_size - 1, false, 0))
+    {
+        fprintf(stderr, "  truncated section accepted\n");
+        i_err++;
+    }
+    /* section_length beyond the maximum size of a PSI section */
+    uint8_t p_long[SECTION_MAX + 8];
+    memcpy(p_long, p_buffer, i_size);
+    p_long[1] = (p_long[1] & 0xf0) | ((SECTION_MAX + 2) >> 8);
+    p_long[2] = (SECTION_MAX + 2) & 0xff;
+    if (dvbpsi_section_push(p_dvbpsi, p_long, sizeof(p_long), false, 0))
+    {
+        fprintf(stderr, "  long section accepted\n");
+        i_err++;
+    }
+    /* section_syntax_indicator set without room for the header and CRC_32 */
+    uint8_t p_short[] = { 0x00, 0xb0, 0x05, 0x00, 0x01, 0xc1, 0x00, 0x00 };
+    if (dvbpsi_section_push(p_dvbpsi, p_short, sizeof(p_short), false, 0))
+    {
+        fprintf(stderr, "  section without extended header accepted\n");
+        i_err++;
+    }
+    /* none of them reaches the decoder */
+    i_err += CheckReception(&rcv, 0, 0, 0);
+
+    dvbpsi_DeletePSISections(p_sections);
+    DeleteDecoder(p_dvbpsi);
+    return Result("malformed sections", i_err);
+}
+
+static int CheckMixed(void)
+{
+    int i_err = 0;
+    uint8_t p_packets[SECTIONS * PACKETS_PER_SECTION * TEST_TS_SIZE];
+    uint8_t p_buffer[SECTION_MAX];
+    uint8_t i_cc = 0;
+    reception_t rcv;
+
+    fprintf(stdout, "\"sections and packets\" section push check:\n");
+    dvbpsi_t *p_dvbpsi = NewDecoder(&rcv);
+    if (p_dvbpsi == NULL)
+        return Result("sections and packets", 1);
+    dvbpsi_psi_section_t *p_sections = NewSections(p_dvbpsi);
+
+    if (TestPacketizeSections(p_packets, SECTIONS * PACKETS_PER_SECTION, 0x00,
+                              &i_cc, p_sections) != SECTIONS * PACKETS_PER_SECTION)
+        i_err++;
+
+    /* the first section from packets, the third one pushed while the second
+     * one is being gathered from packets */
+    for (int i = 0; i < PACKETS_PER_SECTION + 1; i++)
+        dvbpsi_packet_push(p_dvbpsi, p_packets + i * TEST_TS_SIZE);
+    size_t i_size = CopySection(p_buffer, p_sections, 2);
+    if (!dvbpsi_section_push(p_dvbpsi, p_buffer, i_size, true, 0))
+    {
+        fprintf(stderr, "  section rejected\n");
+        i_err++;
+    }
+    for (int i = PACKETS_PER_SECTION + 1; i < 2 * PACKETS_PER_SECTION; i++)
+        dvbpsi_packet_push(p_dvbpsi, p_packets + i * TEST_TS_SIZE);
+    i_err += CheckReception(&rcv, 1, SECTIONS, 0);
+
+    dvbpsi_DeletePSISections(p_sections);
+    DeleteDecoder(p_dvbpsi);
+    return Result("sections and packets", i_err);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckValid();
+    i_err += CheckCRC(true);
+    i_err += CheckCRC(false);
+    i_err += CheckMalformed();
+    i_err += CheckMixed();
+
+    if (i_err)
+        fprintf(stderr, "%d section push checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
@@ -0,0 +1,362 @@
+/*****************************************************************************
+ * test_servicedb.c: service database checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * One transport stream is described by successive versions of its SDT and
+ * of the NIT of its network. After each update the callbacks raised by the
+ * database and the merged services are compared with the expected ones.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/descriptor.h"
+#include "../src/tables/pat.h"
+#include "../src/tables/pmt.h"
+#include "../src/tables/sdt.h"
+#include "../src/tables/nit.h"
+#include "../src/tables/bat.h"
+#include "../src/tables/atsc_vct.h"
+#include "../src/servicedb.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/pat.h>
+#include <dvbpsi/pmt.h>
+#include <dvbpsi/sdt.h>
+#include <dvbpsi/nit.h>
+#include <dvbpsi/bat.h>
+#include <dvbpsi/atsc_vct.h>
+#include <dvbpsi/servicedb.h>
+#endif
+
+#define ONID            0x20
+#define TSID            0x01
+#define NETWORK_ID      0x3001
+#define MAX_EVENTS      8
+
+/*****************************************************************************
+ * Callback log
+ *****************************************************************************/
+typedef struct event_s
+{
+    dvbpsi_servicedb_event_t i_event;
+    uint16_t        i_service_id;
+} event_t;
+
+typedef struct log_s
+{
+    int             i_events;
+    event_t         events[MAX_EVENTS];
+} log_t;
+
+static void Callback(void *p_cb_data, dvbpsi_servicedb_event_t i_event,
+                     const dvbpsi_servicedb_service_t *p_service)
+{
+    log_t *p_log = (log_t *)p_cb_data;
+
+    if (p_log->i_events < MAX_EVENTS)
+    {
+        p_log->events[p_log->i_events].i_event = i_event;
+        p_log->events[p_log->i_events].i_service_id = p_service->i_service_id;
+    }
+    p_log->i_events++;
+}
+
+/* compare the callbacks raised since the last call, in any order */
+static int CheckEvents(log_t *p_log, const event_t *p_expected, int i_expected)
+{
+    static const char *ppsz_events[] = { "ADDED", "CHANGED", "REMOVED" };
+    int i_err = 0;
+
+    if (p_log->i_events != i_expected)
+    {
+        fprintf(stderr, "  %d callbacks instead of %d\n", p_log->i_events, i_expected);
+        i_err++;
+    }
+    for (int i = 0; i < i_expected; i++)
+    {
+        int j;
+        for (j = 0; j < p_log->i_events && j < MAX_EVENTS; j++)
+            if (p_log->events[j].i_event == p_expected[i].i_event &&
+                p_log->events[j].i_service_id == p_expected[i].i_service_id)
+                break;
+        if (j == p_log->i_events || j == MAX_EVENTS)
+        {
+            fprintf(stderr, "  no %s callback for service %u\n",
+                    ppsz_events[p_expected[i].i_event], p_expected[i].i_service_id);
+            i_err++;
+        }
+    }
+    p_log->i_events = 0;
+    return i_err;
+}
+
+/* compare a service with its expected sources, name and LCN */
+static int CheckService(const dvbpsi_servicedb_t *p_db, uint16_t i_service_id,
+                        unsigned int i_sources, const char *psz_name, int i_lcn)
+{
+    const dvbpsi_servicedb_service_t *p_service = dvbpsi_servicedb_find(p_db, ONID, TSID,
+                                                                        i_service_id);
+    if (p_service == NULL)
+    {
+        if (i_sources == 0)
+            return 0;
+        fprintf(stderr, "  service %u not found\n", i_service_id);
+        return 1;
+    }
+    if (i_sources == 0)
+    {
+        fprintf(stderr, "  service %u not removed\n", i_service_id);
+        return 1;
+    }
+
+    int i_err = 0;
+    if (p_service->i_sources != i_sources)
+    {
+        fprintf(stderr, "  service %u: sources 0x%02x instead of 0x%02x\n", i_service_id,
+                p_service->i_sources, i_sources);
+        i_err++;
+    }
+    if (p_service->i_name_length != strlen(psz_name) ||
+        memcmp(p_service->i_name, psz_name, p_service->i_name_length))
+    {
+        fprintf(stderr, "  service %u: name \"%.*s\" instead of \"%s\"\n", i_service_id,
+                (int)p_service->i_name_length, (const char *)p_service->i_name, psz_name);
+        i_err++;
+    }
+    if (p_service->b_lcn != (i_lcn >= 0) || (i_lcn >= 0 && p_service->i_lcn != i_lcn))
+    {
+        fprintf(stderr, "  service %u: LCN %d instead of %d\n", i_service_id,
+                p_service->b_lcn ? p_service->i_lcn : -1, i_lcn);
+        i_err++;
+    }
+    return i_err;
+}
+
+/*****************************************************************************
+ * Tables
+ *****************************************************************************/
+static void AddSdtService(dvbpsi_sdt_t *p_sdt, uint16_t i_service_id, const char *psz_name)
+{
+    uint8_t p_data[64];
+    size_t i_name = strlen(psz_name);
+
+    dvbpsi_sdt_service_t *p_service = dvbpsi_sdt_service_add(p_sdt, i_service_id, false,
+                                                             true, 4, false);
+    /* service_descriptor: digital television, no provider name */
+    p_data[0] = 0x01;
+    p_data[1] = 0;
+    p_data[2] = i_name;
+    memcpy(p_data + 3, psz_name, i_name);
+    dvbpsi_sdt_service_descriptor_add(p_service, 0x48, 3 + i_name, p_data);
+}
+
+static bool UpdateNit(dvbpsi_servicedb_t *p_db, uint8_t i_version,
+                      const uint16_t *pi_services, int i_services,
+                      const uint16_t *pi_lcns)
+{
+    /* cable_delivery_system_descriptor, 474 MHz */
+    static const uint8_t p_cable[] =
+    {
+        0x04, 0x74, 0x00, 0x00, 0xff, 0xf0, 0x05, 0x00, 0x68, 0x75, 0x00
+    };
+    uint8_t p_list[3 * 4], p_lcn[4 * 4];
+    int i_lcns = 0;
+    dvbpsi_nit_t nit;
+
+    dvbpsi_nit_init(&nit, 0x40, NETWORK_ID, NETWORK_ID, i_version, true);
+    dvbpsi_nit_ts_t *p_ts = dvbpsi_nit_ts_add(&nit, TSID, ONID);
+    dvbpsi_nit_ts_descriptor_add(p_ts, 0x44, sizeof(p_cable), p_cable);
+    for (int i = 0; i < i_services; i++)
+    {
+        p_list[3 * i] = pi_services[i] >> 8;
+        p_list[3 * i + 1] = pi_services[i] & 0xff;
+        p_list[3 * i + 2] = 0x01;
+        if (pi_lcns[i] == 0)
+            continue;
+        /* visible_service_flag set */
+        p_lcn[4 * i_lcns] = pi_services[i] >> 8;
+        p_lcn[4 * i_lcns + 1] = pi_services[i] & 0xff;
+        p_lcn[4 * i_lcns + 2] = 0xfc | (pi_lcns[i] >> 8);
+        p_lcn[4 * i_lcns + 3] = pi_lcns[i] & 0xff;
+        i_lcns++;
+    }
+    dvbpsi_nit_ts_descriptor_add(p_ts, 0x41, 3 * i_services, p_list);
+    if (i_lcns)
+        dvbpsi_nit_ts_descriptor_add(p_ts, 0x83, 4 * i_lcns, p_lcn);
+
+    bool b_ok = dvbpsi_servicedb_update_nit(p_db, &nit);
+    dvbpsi_nit_empty(&nit);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckMerge(void)
+{
+    log_t log = { 0 };
+    dvbpsi_sdt_t sdt;
+    int i_err = 0;
+
+    fprintf(stdout, "\"SDT and NIT merge\" service database check:\n");
+
+    dvbpsi_servicedb_t *p_db = dvbpsi_servicedb_new(Callback, &log);
+    if (p_db == NULL)
+        return 1;
+
+    /* SDT: services 1 and 2 */
+    dvbpsi_sdt_init(&sdt, 0x42, TSID, 0, true, ONID);
+    AddSdtService(&sdt, 1, "One");
+    AddSdtService(&sdt, 2, "Two");
+    if (!dvbpsi_servicedb_update_sdt(p_db, &sdt))
+        i_err++;
+    dvbpsi_sdt_empty(&sdt);
+    {
+        static const event_t expected[] =
+        {
+            { DVBPSI_SERVICEDB_ADDED, 1 }, { DVBPSI_SERVICEDB_ADDED, 2 },
+        };
+        i_err += CheckEvents(&log, expected, 2);
+    }
+    i_err += CheckService(p_db, 1, DVBPSI_SERVICEDB_SDT, "One", -1);
+    i_err += CheckService(p_db, 2, DVBPSI_SERVICEDB_SDT, "Two", -1);
+
+    /* NIT: services 1, 2 and 3, LCN 5 for service 1 and 7 for service 3 */
+    {
+        static const uint16_t pi_services[] = { 1, 2, 3 };
+        static const uint16_t pi_lcns[] = { 5, 0, 7 };
+        static const event_t expected[] =
+        {
+            { DVBPSI_SERVICEDB_CHANGED, 1 }, { DVBPSI_SERVICEDB_CHANGED, 2 },
+            { DVBPSI_SERVICEDB_ADDED, 3 },
+        };
+        if (!UpdateNit(p_db, 0, pi_services, 3, pi_lcns))
+            i_err++;
+        i_err += CheckEvents(&log, expected, 3);
+    }
+    i_err += CheckService(p_db, 1, DVBPSI_SERVICEDB_SDT | DVBPSI_SERVICEDB_NIT, "One", 5);
+    i_err += CheckService(p_db, 2, DVBPSI_SERVICEDB_SDT | DVBPSI_SERVICEDB_NIT, "Two", -1);
+    i_err += CheckService(p_db, 3, DVBPSI_SERVICEDB_NIT, "", 7);
+    if (dvbpsi_servicedb_count(p_db) != 3 ||
+        dvbpsi_servicedb_find_lcn(p_db, 7) != dvbpsi_servicedb_find(p_db, ONID, TSID, 3))
+    {
+        fprintf(stderr, "  LCN 7 does not give service 3\n");
+        i_err++;
+    }
+    const dvbpsi_servicedb_transport_t *p_ts = dvbpsi_servicedb_find_transport(p_db, ONID,
+                                                                              TSID);
+    if (p_ts == NULL || !p_ts->b_nit || p_ts->i_network_id != NETWORK_ID ||
+        p_ts->i_delivery_tag != 0x44)
+    {
+        fprintf(stderr, "  transport stream not described by the NIT\n");
+        i_err++;
+    }
+
+    /* SDT version 1: service 1 is renamed, service 2 is no longer described
+     * but stays listed by the NIT, service 3 gets its name */
+    dvbpsi_sdt_init(&sdt, 0x42, TSID, 1, true, ONID);
+    AddSdtService(&sdt, 1, "Uno");
+    AddSdtService(&sdt, 3, "Tres");
+    if (!dvbpsi_servicedb_update_sdt(p_db, &sdt))
+        i_err++;
+    dvbpsi_sdt_empty(&sdt);
+    {
+        static const event_t expected[] =
+        {
+            { DVBPSI_SERVICEDB_CHANGED, 1 }, { DVBPSI_SERVICEDB_CHANGED, 2 },
+            { DVBPSI_SERVICEDB_CHANGED, 3 },
+        };
+        i_err += CheckEvents(&log, expected, 3);
+    }
+    i_err += CheckService(p_db, 1, DVBPSI_SERVICEDB_SDT | DVBPSI_SERVICEDB_NIT, "Uno", 5);
+    i_err += CheckService(p_db, 2, DVBPSI_SERVICEDB_NIT, "", -1);
+    i_err += CheckService(p_db, 3, DVBPSI_SERVICEDB_SDT | DVBPSI_SERVICEDB_NIT, "Tres", 7);
+
+    /* NIT version 1: service 2 is dropped, no table announces it any more,
+     * service 3 loses its LCN but keeps its SDT description */
+    {
+        static const uint16_t pi_services[] = { 1 };
+        static const uint16_t pi_lcns[] = { 5 };
+        static const event_t expected[] =
+        {
+            { DVBPSI_SERVICEDB_REMOVED, 2 }, { DVBPSI_SERVICEDB_CHANGED, 3 },
+        };
+        if (!UpdateNit(p_db, 1, pi_services, 1, pi_lcns))
+            i_err++;
+        i_err += CheckEvents(&log, expected, 2);
+    }
+    i_err += CheckService(p_db, 1, DVBPSI_SERVICEDB_SDT | DVBPSI_SERVICEDB_NIT, "Uno", 5);
+    i_err += CheckService(p_db, 2, 0, "", -1);
+    i_err += CheckService(p_db, 3, DVBPSI_SERVICEDB_SDT, "Tres", -1);
+    if (dvbpsi_servicedb_count(p_db) != 2 || dvbpsi_servicedb_find_lcn(p_db, 7) != NULL)
+    {
+        fprintf(stderr, "  %u services, LCN 7 still assigned\n",
+                dvbpsi_servicedb_count(p_db));
+        i_err++;
+    }
+
+    /* the same SDT again changes nothing */
+    dvbpsi_sdt_init(&sdt, 0x42, TSID, 1, true, ONID);
+    AddSdtService(&sdt, 1, "Uno");
+    AddSdtService(&sdt, 3, "Tres");
+    if (!dvbpsi_servicedb_update_sdt(p_db, &sdt))
+        i_err++;
+    dvbpsi_sdt_empty(&sdt);
+    i_err += CheckEvents(&log, NULL, 0);
+
+    dvbpsi_servicedb_delete(p_db);
+
+    if (i_err)
+        fprintf(stderr, "\"SDT and NIT merge\" service database check FAILED !!!\n\n");
+    else
+        fprintf(stdout, "  \"SDT and NIT merge\" OK\n\n");
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckMerge();
+
+    if (i_err)
+        fprintf(stderr, "%d service database checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
@@ -0,0 +1,500 @@
+/*****************************************************************************
+ * test_sis.c: SCTE 35 splice_info_section generate/decode round trip
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Every splice command, segmentation descriptors and encrypted sections are
+ * encoded, decoded by a SIS decoder and encoded again. Both encodings must
+ * be identical, and identical to the section of the SIS generator. The
+ * encrypted sections are also decoded with a wrong control word and
+ * without decryption callback, their splice command must then be rejected.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/demux.h"
+#include "../src/tables/sis.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/demux.h>
+#include <dvbpsi/sis.h>
+#endif
+
+#define SECTION_SIZE    4096
+
+/*****************************************************************************
+ * Cipher: a keystream XOR selected by cw_index, decryption is encryption
+ *****************************************************************************/
+static bool Crypt(void *p_cb_data, const dvbpsi_sis_t *p_sis, uint8_t *p_data,
+                  size_t i_length)
+{
+    uint8_t i_key = *(const uint8_t *)p_cb_data + p_sis->cw_index;
+
+    for (size_t i = 0; i < i_length; i++)
+        p_data[i] ^= (uint8_t)(i_key + 31 * i);
+    return true;
+}
+
+/*****************************************************************************
+ * Decoder side
+ *****************************************************************************/
+typedef struct check_s
+{
+    const char     *psz_name;
+    const uint8_t  *p_section;      /* expected encoding */
+    size_t          i_section;
+    uint8_t         i_key;          /* control word of the decoder */
+    bool            b_expect_valid; /* splice command must be decoded */
+    unsigned int    i_decoded;
+    int             i_err;
+    dvbpsi_sis_t   *p_storage;      /* decode into a caller provided SIS */
+} check_t;
+
+/* rebuild the descriptor list a caller provided SIS does not get */
+static dvbpsi_descriptor_t *RawDescriptors(const dvbpsi_sis_t *p_sis)
+{
+    dvbpsi_descriptor_t *p_first = NULL;
+    const uint8_t *p = p_sis->p_descriptors;
+    const uint8_t *p_end = p + p_sis->i_descriptors_length;
+
+    while (p && p + 2 <= p_end && p + 2 + p[1] <= p_end)
+    {
+        uint8_t p_data[255];
+        memcpy(p_data, p + 2, p[1]);
+        p_first = dvbpsi_AddDescriptor(p_first, dvbpsi_NewDescriptor(p[0], p[1], p_data));
+        p += 2 + p[1];
+    }
+    return p_first;
+}
+
+static void SISCallback(void *p_cb_data, dvbpsi_sis_t *p_sis)
+{
+    check_t *p_check = (check_t *)p_cb_data;
+    uint8_t p_buf[SECTION_SIZE];
+    size_t i_length = 0;
+
+    p_check->i_decoded++;
+    if (p_check->p_storage)
+    {
+        if (p_sis != p_check->p_storage || p_sis->p_first_descriptor)
+        {
+            fprintf(stderr, "  caller provided SIS not used\n");
+            p_check->i_err++;
+            return;
+        }
+        p_sis->p_first_descriptor = RawDescriptors(p_sis);
+    }
+
+    if (p_sis->b_splice_command_valid != p_check->b_expect_valid)
+    {
+        fprintf(stderr, "  splice command %s\n",
+                p_sis->b_splice_command_valid ? "decoded" : "not decoded");
+        p_check->i_err++;
+    }
+    else if (p_check->b_expect_valid)
+    {
+        /* encode the decoded section back, with the same control word */
+        uint8_t i_key = p_check->i_key;
+        if (!dvbpsi_sis_section_encode(p_sis, Crypt, &i_key, p_buf, sizeof(p_buf),
+                                       &i_length))
+        {
+            fprintf(stderr, "  decoded section cannot be encoded\n");
+            p_check->i_err++;
+        }
+        else if (i_length != p_check->i_section ||
+                 memcmp(p_buf, p_check->p_section, i_length))
+        {
+            fprintf(stderr, "  encoding of the decoded section differs\n");
+            p_check->i_err++;
+        }
+    }
+
+    if (p_check->p_storage)
+    {
+        dvbpsi_DeleteDescriptors(p_sis->p_first_descriptor);
+        p_sis->p_first_descriptor = NULL;
+    }
+    else
+        dvbpsi_sis_delete(p_sis);
+}
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+static void NewSubtable(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                        void *p_cb_data)
+{
+    check_t *p_check = (check_t *)p_cb_data;
+
+    if (i_table_id != 0xfc)
+        return;
+    bool b_attached = p_check->p_storage ?
+        dvbpsi_sis_attach_storage(p_dvbpsi, i_table_id, i_extension, p_check->p_storage,
+                                  SISCallback, p_check) :
+        dvbpsi_sis_attach(p_dvbpsi, i_table_id, i_extension, SISCallback, p_check);
+    if (b_attached && p_check->i_key)
+        dvbpsi_sis_set_decrypt(p_dvbpsi, i_table_id, i_extension, Crypt, &p_check->i_key);
+}
+
+static bool Decode(check_t *p_check)
+{
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (p_dvbpsi == NULL)
+        return false;
+
+    bool b_ok = dvbpsi_AttachDemux(p_dvbpsi, NewSubtable, p_check);
+    if (b_ok)
+    {
+        b_ok = dvbpsi_section_push(p_dvbpsi, p_check->p_section, p_check->i_section,
+                                   true, 0);
+        dvbpsi_DetachDemux(p_dvbpsi);
+    }
+    dvbpsi_delete(p_dvbpsi);
+    return b_ok;
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/*****************************************************************************
+ * Check: encode, compare with the generator, decode and encode again
+ *****************************************************************************/
+static int Check(const char *psz_name, dvbpsi_sis_t *p_sis)
+{
+    uint8_t p_section[SECTION_SIZE];
+    size_t i_section = 0;
+    uint8_t i_key = 0x5a;
+    int i_err = 0;
+
+    fprintf(stdout, "\"%s\" splice_info_section check:\n", psz_name);
+
+    if (!dvbpsi_sis_section_encode(p_sis, Crypt, &i_key, p_section, sizeof(p_section),
+                                   &i_section))
+    {
+        fprintf(stderr, "\"%s\" cannot be encoded FAILED !!!\n\n", psz_name);
+        return 1;
+    }
+
+    /* the generator produces the same section */
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if (p_dvbpsi == NULL)
+        return 1;
+    dvbpsi_psi_section_t *p_generated =
+        p_sis->b_encrypted_packet ?
+            dvbpsi_sis_sections_generate_encrypted(p_dvbpsi, p_sis, Crypt, &i_key) :
+            dvbpsi_sis_sections_generate(p_dvbpsi, p_sis);
+    if (p_generated == NULL || p_generated->p_next ||
+        (size_t)(p_generated->p_payload_end + 4 - p_generated->p_data) != i_section ||
+        memcmp(p_generated->p_data, p_section, i_section))
+    {
+        fprintf(stderr, "  generated section differs\n");
+        i_err++;
+    }
+    dvbpsi_DeletePSISections(p_generated);
+    dvbpsi_delete(p_dvbpsi);
+
+    /* round trip through the decoder */
+    check_t check = { psz_name, p_section, i_section, i_key, true, 0, 0 };
+    if (!Decode(&check) || check.i_decoded != 1)
+    {
+        fprintf(stderr, "  section not decoded\n");
+        i_err++;
+    }
+    i_err += check.i_err;
+
+    /* the same without allocation, into a caller provided SIS */
+    dvbpsi_sis_t *p_storage = malloc(sizeof(dvbpsi_sis_t));
+    check_t storage = { psz_name, p_section, i_section, i_key, true, 0, 0, p_storage };
+    if (p_storage == NULL || !Decode(&storage) || storage.i_decoded != 1)
+    {
+        fprintf(stderr, "  section not decoded into a caller provided SIS\n");
+        i_err++;
+    }
+    i_err += storage.i_err;
+    free(p_storage);
+
+    if (p_sis->b_encrypted_packet)
+    {
+        /* a wrong control word fails the E_CRC_32, no callback rejects it */
+        check_t wrong = { psz_name, p_section, i_section, i_key + 1, false, 0, 0 };
+        check_t none = { psz_name, p_section, i_section, 0, false, 0, 0 };
+        if (!Decode(&wrong) || !Decode(&none) ||
+            wrong.i_decoded != 1 || none.i_decoded != 1)
+        {
+            fprintf(stderr, "  encrypted section not delivered\n");
+            i_err++;
+        }
+        i_err += wrong.i_err + none.i_err;
+    }
+
+    if (i_err)
+        fprintf(stderr, "\"%s\" splice_info_section check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "\"%s\" splice_info_section check succeeded\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Sections
+ *****************************************************************************/
+static void InitSIS(dvbpsi_sis_t *p_sis, uint8_t i_command_type, void *p_command)
+{
+    dvbpsi_sis_init(p_sis, 0xfc, 0, 0, true, 0);
+    p_sis->i_pts_adjustment = UINT64_C(0x123456789);
+    p_sis->i_tier = 0xabc;
+    p_sis->i_splice_command_type = i_command_type;
+    p_sis->p_splice_command = p_command;
+}
+
+static int CheckSpliceNull(void)
+{
+    dvbpsi_sis_t sis;
+    InitSIS(&sis, 0x00, NULL);
+    return Check("splice_null", &sis);
+}
+
+static int CheckSpliceSchedule(void)
+{
+    dvbpsi_sis_t sis;
+    dvbpsi_sis_break_duration_t duration = { true, UINT64_C(0x1fffffffe) };
+    dvbpsi_sis_component_utc_splice_time_t components[2] =
+    {
+        { 0x11, 1000000000, &components[1] },
+        { 0x12, 1000000090, NULL },
+    };
+    dvbpsi_sis_splice_event_t events[3];
+
+    memset(events, 0, sizeof(events));
+    events[0].i_splice_event_id = 1;
+    events[0].b_out_of_network_indicator = true;
+    events[0].b_program_splice_flag = true;
+    events[0].b_duration_flag = true;
+    events[0].i_utc_splice_time = 999999999;
+    events[0].p_break_duration = &duration;
+    events[0].i_unique_program_id = 0x1234;
+    events[0].i_avail_num = 1;
+    events[0].i_avails_expected = 2;
+    events[0].p_next = &events[1];
+    events[1].i_splice_event_id = 2;
+    events[1].i_component_count = 2;
+    events[1].p_data = components;
+    events[1].p_next = &events[2];
+    events[2].i_splice_event_id = 3;
+    events[2].b_splice_event_cancel_indicator = true;
+
+    dvbpsi_sis_cmd_splice_schedule_t schedule = { 3, events };
+    InitSIS(&sis, 0x04, &schedule);
+    return Check("splice_schedule", &sis);
+}
+
+static void InitSpliceInsert(dvbpsi_sis_cmd_splice_insert_t *p_insert,
+                             dvbpsi_sis_splice_time_t *p_time,
+                             dvbpsi_sis_break_duration_t *p_duration)
+{
+    memset(p_insert, 0, sizeof(*p_insert));
+    p_time->b_time_specified_flag = true;
+    p_time->i_pts_time = UINT64_C(0x1ffffffff);
+    p_time->p_next = NULL;
+    p_duration->b_auto_return = true;
+    p_duration->i_duration = 30 * 90000;
+
+    p_insert->i_splice_event_id = 0x89abcdef;
+    p_insert->b_out_of_network_indicator = true;
+    p_insert->b_program_splice_flag = true;
+    p_insert->b_duration_flag = true;
+    p_insert->p_splice_time = p_time;
+    p_insert->p_break_duration = p_duration;
+    p_insert->i_unique_program_id = 0xfedc;
+    p_insert->i_avail_num = 3;
+    p_insert->i_avails_expected = 4;
+}
+
+static int CheckSpliceInsert(void)
+{
+    dvbpsi_sis_t sis;
+    dvbpsi_sis_cmd_splice_insert_t insert;
+    dvbpsi_sis_splice_time_t splice_time;
+    dvbpsi_sis_break_duration_t duration;
+    int i_err = 0;
+
+    InitSpliceInsert(&insert, &splice_time, &duration);
+    InitSIS(&sis, 0x05, &insert);
+    i_err += Check("splice_insert program", &sis);
+
+    /* component splice */
+    dvbpsi_sis_splice_time_t times[2] =
+    {
+        { true, 900000, NULL },
+        { false, 0, NULL },
+    };
+    dvbpsi_sis_component_splice_time_t components[2] =
+    {
+        { 0x21, &times[0], &components[1] },
+        { 0x22, &times[1], NULL },
+    };
+    insert.b_program_splice_flag = false;
+    insert.b_duration_flag = false;
+    insert.p_splice_time = NULL;
+    insert.p_break_duration = NULL;
+    insert.i_component_count = 2;
+    insert.p_data = components;
+    i_err += Check("splice_insert component", &sis);
+
+    /* immediate */
+    InitSpliceInsert(&insert, &splice_time, &duration);
+    insert.b_splice_immediate_flag = true;
+    insert.p_splice_time = NULL;
+    i_err += Check("splice_insert immediate", &sis);
+
+    /* cancel */
+    memset(&insert, 0, sizeof(insert));
+    insert.i_splice_event_id = 7;
+    insert.b_splice_event_cancel_indicator = true;
+    i_err += Check("splice_insert cancel", &sis);
+    return i_err;
+}
+
+static int CheckTimeSignal(void)
+{
+    dvbpsi_sis_t sis;
+    dvbpsi_sis_splice_time_t splice_time = { true, 123456789, NULL };
+    dvbpsi_sis_cmd_time_signal_t signal = { &splice_time };
+    dvbpsi_sis_segmentation_component_t components[2] =
+    {
+        { 0x31, 0 },
+        { 0x32, UINT64_C(0x1ffffffff) },
+    };
+    int i_err;
+
+    InitSIS(&sis, 0x06, &signal);
+
+    /* avail_descriptor before the segmentation descriptors */
+    uint8_t p_avail[8] = { 'C', 'U', 'E', 'I', 0x01, 0x02, 0x03, 0x04 };
+    dvbpsi_sis_descriptor_add(&sis, 0x00, sizeof(p_avail), p_avail);
+
+    dvbpsi_sis_segmentation_t *p_seg = &sis.segmentation[0];
+    p_seg->i_segmentation_event_id = 0x4800008e;
+    p_seg->b_program_segmentation_flag = false;
+    p_seg->b_segmentation_duration_flag = true;
+    p_seg->b_delivery_not_restricted_flag = false;
+    p_seg->b_web_delivery_allowed_flag = true;
+    p_seg->b_archive_allowed_flag = true;
+    p_seg->i_device_restrictions = 2;
+    p_seg->i_component_count = 2;
+    p_seg->p_components = components;
+    p_seg->i_segmentation_duration = UINT64_C(0xffffffffff);
+    p_seg->i_segmentation_upid_type = 0x09;
+    p_seg->i_segmentation_upid_length = 12;
+    memcpy(p_seg->p_segmentation_upid, "SIGNAL:12345", 12);
+    p_seg->i_segmentation_type_id = 0x34;
+    p_seg->i_segment_num = 1;
+    p_seg->i_segments_expected = 2;
+    p_seg->b_sub_segment = true;
+    p_seg->i_sub_segment_num = 3;
+    p_seg->i_sub_segments_expected = 4;
+
+    p_seg = &sis.segmentation[1];
+    p_seg->i_segmentation_event_id = 0x4800008f;
+    p_seg->b_segmentation_event_cancel_indicator = true;
+    sis.i_segmentation_count = 2;
+
+    i_err = Check("time_signal segmentation", &sis);
+    dvbpsi_sis_empty(&sis);
+    return i_err;
+}
+
+static int CheckOtherCommands(void)
+{
+    dvbpsi_sis_t sis;
+    int i_err = 0;
+
+    InitSIS(&sis, 0x07, NULL);
+    i_err += Check("bandwidth_reservation", &sis);
+
+    dvbpsi_sis_cmd_private_t private_command;
+    private_command.i_identifier = 0x54455354;
+    private_command.i_length = 5;
+    memcpy(private_command.p_private_byte, "\x01\x02\x03\x04\x05", 5);
+    InitSIS(&sis, 0xff, &private_command);
+    i_err += Check("private_command", &sis);
+    return i_err;
+}
+
+static int CheckEncrypted(void)
+{
+    dvbpsi_sis_t sis;
+    dvbpsi_sis_cmd_splice_insert_t insert;
+    dvbpsi_sis_splice_time_t splice_time;
+    dvbpsi_sis_break_duration_t duration;
+    int i_err = 0;
+
+    InitSpliceInsert(&insert, &splice_time, &duration);
+    InitSIS(&sis, 0x05, &insert);
+    sis.b_encrypted_packet = true;
+    sis.cw_index = 0x17;
+
+    /* DES based algorithm, with alignment stuffing */
+    sis.i_encryption_algorithm = 1;
+    i_err += Check("encrypted splice_insert, algorithm 1", &sis);
+
+    /* user private algorithm */
+    sis.i_encryption_algorithm = 0x20;
+    i_err += Check("encrypted splice_insert, algorithm 32", &sis);
+    return i_err;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckSpliceNull();
+    i_err += CheckSpliceSchedule();
+    i_err += CheckSpliceInsert();
+    i_err += CheckTimeSignal();
+    i_err += CheckOtherCommands();
+    i_err += CheckEncrypted();
+
+    if (i_err)
+        fprintf(stderr, "%d splice_info_section checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
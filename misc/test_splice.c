@@ -0,0 +1,389 @@
+/*****************************************************************************
+ * test_splice.c: splice scheduler checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Splice commands are pushed to a scheduler whose clock is driven by a PCR
+ * every 10 ms. Each check compares the callbacks with the expected ones, in
+ * order: preroll and splice point ordering, auto return, cancellation, a
+ * new splice time for a queued event and time_signal() events that must
+ * not replace each other.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/tables/sis.h"
+#include "../src/splice.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/sis.h>
+#include <dvbpsi/splice.h>
+#endif
+
+#define TICK            10000           /* 10 ms */
+#define PREROLL         1000000         /* 1 s */
+#define MAX_EVENTS      16
+
+/* 90 kHz splice time of a date in microseconds */
+#define PTS(date)       ((uint64_t)(date) * 9 / 100)
+
+/*****************************************************************************
+ * Scheduler side
+ *****************************************************************************/
+typedef struct fired_s
+{
+    dvbpsi_splice_action_t  i_action;
+    uint32_t                i_event_id;
+    uint8_t                 i_segmentation_type_id;
+    uint64_t                i_pts;
+} fired_t;
+
+typedef struct check_s
+{
+    dvbpsi_splice_scheduler_t  *p_sched;
+    int64_t                     i_date;
+    fired_t                     fired[MAX_EVENTS];
+    unsigned int                i_fired;
+} check_t;
+
+static void SpliceCallback(void *p_cb_data, const dvbpsi_splice_event_t *p_event)
+{
+    check_t *p_check = (check_t *)p_cb_data;
+
+    if (p_check->i_fired < MAX_EVENTS)
+    {
+        fired_t *p_fired = &p_check->fired[p_check->i_fired];
+        p_fired->i_action = p_event->i_action;
+        p_fired->i_event_id = p_event->i_event_id;
+        p_fired->i_segmentation_type_id = p_event->i_segmentation_type_id;
+        p_fired->i_pts = p_event->i_pts;
+    }
+    p_check->i_fired++;
+}
+
+static bool Open(check_t *p_check)
+{
+    dvbpsi_splice_config_t config;
+
+    memset(p_check, 0, sizeof(check_t));
+    dvbpsi_splice_config_default(&config);
+    config.i_pcr_pid = 0x1fff;
+    config.i_preroll = PREROLL;
+
+    p_check->p_sched = dvbpsi_splice_scheduler_new(&config, SpliceCallback, p_check);
+    if (p_check->p_sched == NULL)
+        return false;
+    dvbpsi_splice_scheduler_pcr_push(p_check->p_sched, 0, false, 0);
+    return true;
+}
+
+/* advance the clock by i_duration microseconds */
+static void Run(check_t *p_check, int64_t i_duration)
+{
+    for (int64_t i_end = p_check->i_date + i_duration; p_check->i_date < i_end; )
+    {
+        p_check->i_date += TICK;
+        dvbpsi_splice_scheduler_pcr_push(p_check->p_sched,
+                                         (uint64_t)p_check->i_date * 27, false,
+                                         p_check->i_date);
+    }
+}
+
+/*****************************************************************************
+ * Commands
+ *****************************************************************************/
+static bool SpliceInsert(check_t *p_check, uint32_t i_event_id, bool b_cancel,
+                         int64_t i_date, int64_t i_duration)
+{
+    dvbpsi_sis_t *p_sis = malloc(sizeof(dvbpsi_sis_t));
+    dvbpsi_sis_splice_time_t time = { true, PTS(i_date), NULL };
+    dvbpsi_sis_break_duration_t duration = { true, PTS(i_duration) };
+
+    if (p_sis == NULL)
+        return false;
+    dvbpsi_sis_init(p_sis, 0xfc, 0, 0, true, 0);
+    p_sis->b_splice_command_valid = true;
+    p_sis->i_splice_command_type = 0x05;
+    p_sis->p_splice_command = &p_sis->cmd.splice_insert;
+
+    dvbpsi_sis_cmd_splice_insert_t *p_insert = &p_sis->cmd.splice_insert;
+    p_insert->i_splice_event_id = i_event_id;
+    p_insert->b_splice_event_cancel_indicator = b_cancel;
+    p_insert->b_out_of_network_indicator = true;
+    p_insert->b_program_splice_flag = true;
+    p_insert->p_splice_time = &time;
+    if (i_duration > 0)
+    {
+        p_insert->b_duration_flag = true;
+        p_insert->p_break_duration = &duration;
+    }
+
+    bool b_queued = dvbpsi_splice_scheduler_sis_push(p_check->p_sched, p_sis);
+    free(p_sis);
+    return b_queued;
+}
+
+/* time_signal(), with a segmentation descriptor when i_segmentation_type_id
+ * is not 0 */
+static bool TimeSignal(check_t *p_check, uint32_t i_event_id, uint8_t i_segmentation_type_id,
+                       bool b_cancel, int64_t i_date)
+{
+    dvbpsi_sis_t *p_sis = malloc(sizeof(dvbpsi_sis_t));
+    dvbpsi_sis_splice_time_t time = { true, PTS(i_date), NULL };
+
+    if (p_sis == NULL)
+        return false;
+    dvbpsi_sis_init(p_sis, 0xfc, 0, 0, true, 0);
+    p_sis->b_splice_command_valid = true;
+    p_sis->i_splice_command_type = 0x06;
+    p_sis->p_splice_command = &p_sis->cmd.time_signal;
+    p_sis->cmd.time_signal.p_splice_time = &time;
+
+    if (i_segmentation_type_id != 0)
+    {
+        dvbpsi_sis_segmentation_t *p_seg = &p_sis->segmentation[0];
+        p_seg->i_segmentation_event_id = i_event_id;
+        p_seg->b_segmentation_event_cancel_indicator = b_cancel;
+        p_seg->b_program_segmentation_flag = true;
+        p_seg->i_segmentation_type_id = i_segmentation_type_id;
+        p_sis->i_segmentation_count = 1;
+    }
+
+    bool b_queued = dvbpsi_splice_scheduler_sis_push(p_check->p_sched, p_sis);
+    free(p_sis);
+    return b_queued;
+}
+
+/*****************************************************************************
+ * Close: compare the callbacks with the expected ones
+ *****************************************************************************/
+static const char *ppsz_actions[] = { "preroll", "splice point", "return", "cancel" };
+
+static int Close(check_t *p_check, const char *psz_name, int i_err,
+                 const fired_t *p_expected, unsigned int i_expected)
+{
+    fprintf(stdout, "\"%s\" splice scheduler check:\n", psz_name);
+
+    if (p_check->i_fired != i_expected)
+    {
+        fprintf(stderr, "  %u callbacks instead of %u\n", p_check->i_fired, i_expected);
+        i_err++;
+    }
+    for (unsigned int i = 0; i < i_expected && i < p_check->i_fired && i < MAX_EVENTS; i++)
+    {
+        const fired_t *p_fired = &p_check->fired[i];
+        if (p_fired->i_action != p_expected[i].i_action ||
+            p_fired->i_event_id != p_expected[i].i_event_id ||
+            p_fired->i_segmentation_type_id != p_expected[i].i_segmentation_type_id ||
+            p_fired->i_pts != p_expected[i].i_pts)
+        {
+            fprintf(stderr, "  callback %u: %s of event %u (type 0x%02x) at %llu,"
+                    " expected %s of event %u (type 0x%02x) at %llu\n", i,
+                    ppsz_actions[p_fired->i_action], p_fired->i_event_id,
+                    p_fired->i_segmentation_type_id, (unsigned long long)p_fired->i_pts,
+                    ppsz_actions[p_expected[i].i_action], p_expected[i].i_event_id,
+                    p_expected[i].i_segmentation_type_id,
+                    (unsigned long long)p_expected[i].i_pts);
+            i_err++;
+        }
+    }
+    if (dvbpsi_splice_scheduler_pending(p_check->p_sched) != 0)
+    {
+        fprintf(stderr, "  %u callbacks still pending\n",
+                dvbpsi_splice_scheduler_pending(p_check->p_sched));
+        i_err++;
+    }
+    dvbpsi_splice_scheduler_delete(p_check->p_sched);
+
+    if (i_err)
+        fprintf(stderr, "\"%s\" splice scheduler check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckBreak(void)
+{
+    const fired_t expected[] =
+    {
+        { DVBPSI_SPLICE_PREROLL, 1, 0, PTS(2000000) },
+        { DVBPSI_SPLICE_POINT,   1, 0, PTS(2000000) },
+        { DVBPSI_SPLICE_RETURN,  1, 0, PTS(3500000) },
+    };
+    check_t check;
+    int i_err = 0;
+
+    if (!Open(&check))
+        return 1;
+    if (!SpliceInsert(&check, 1, false, 2000000, 1500000))
+        i_err++;
+    /* a repetition is ignored */
+    Run(&check, 500000);
+    if (SpliceInsert(&check, 1, false, 2000000, 1500000))
+        i_err++;
+    Run(&check, 4000000);
+    return Close(&check, "preroll, splice point and auto return", i_err,
+                 expected, sizeof(expected) / sizeof(expected[0]));
+}
+
+static int CheckCancel(void)
+{
+    const fired_t expected[] =
+    {
+        { DVBPSI_SPLICE_CANCEL,  2, 0, PTS(3000000) },
+        { DVBPSI_SPLICE_PREROLL, 3, 0, PTS(4000000) },
+        { DVBPSI_SPLICE_POINT,   3, 0, PTS(4000000) },
+    };
+    check_t check;
+    int i_err = 0;
+
+    if (!Open(&check))
+        return 1;
+    if (!SpliceInsert(&check, 2, false, 3000000, 0) ||
+        !SpliceInsert(&check, 3, false, 4000000, 0))
+        i_err++;
+    Run(&check, 1000000);
+    if (!SpliceInsert(&check, 2, true, 0, 0))
+        i_err++;
+    /* nothing left to cancel */
+    if (SpliceInsert(&check, 2, true, 0, 0))
+        i_err++;
+    Run(&check, 4000000);
+    return Close(&check, "cancel", i_err, expected, sizeof(expected) / sizeof(expected[0]));
+}
+
+static int CheckOverride(void)
+{
+    const fired_t expected[] =
+    {
+        { DVBPSI_SPLICE_PREROLL, 4, 0, PTS(2500000) },
+        { DVBPSI_SPLICE_POINT,   4, 0, PTS(2500000) },
+    };
+    check_t check;
+    int i_err = 0;
+
+    if (!Open(&check))
+        return 1;
+    if (!SpliceInsert(&check, 4, false, 5000000, 0))
+        i_err++;
+    Run(&check, 500000);
+    /* new splice time for the same splice_event_id */
+    if (!SpliceInsert(&check, 4, false, 2500000, 0))
+        i_err++;
+    Run(&check, 6000000);
+    return Close(&check, "new splice time", i_err,
+                 expected, sizeof(expected) / sizeof(expected[0]));
+}
+
+static int CheckTimeSignal(void)
+{
+    const fired_t expected[] =
+    {
+        { DVBPSI_SPLICE_PREROLL, 0, 0, PTS(2000000) },
+        { DVBPSI_SPLICE_PREROLL, 0, 0, PTS(2500000) },
+        { DVBPSI_SPLICE_POINT,   0, 0, PTS(2000000) },
+        { DVBPSI_SPLICE_POINT,   0, 0, PTS(2500000) },
+    };
+    check_t check;
+    int i_err = 0;
+
+    if (!Open(&check))
+        return 1;
+    /* without segmentation, time_signal() events only differ by their time */
+    if (!TimeSignal(&check, 0, 0, false, 2000000) ||
+        !TimeSignal(&check, 0, 0, false, 2500000))
+        i_err++;
+    if (TimeSignal(&check, 0, 0, false, 2000000))
+        i_err++;
+    Run(&check, 3000000);
+    return Close(&check, "time_signal without segmentation", i_err,
+                 expected, sizeof(expected) / sizeof(expected[0]));
+}
+
+static int CheckSegmentation(void)
+{
+    const fired_t expected[] =
+    {
+        { DVBPSI_SPLICE_PREROLL, 5, 0x34, PTS(2000000) },
+        { DVBPSI_SPLICE_POINT,   5, 0x34, PTS(2000000) },
+        { DVBPSI_SPLICE_PREROLL, 5, 0x35, PTS(4000000) },
+        { DVBPSI_SPLICE_POINT,   5, 0x35, PTS(4000000) },
+        { DVBPSI_SPLICE_PREROLL, 6, 0x34, PTS(6000000) },
+        { DVBPSI_SPLICE_CANCEL,  6, 0x34, PTS(6000000) },
+    };
+    check_t check;
+    int i_err = 0;
+
+    if (!Open(&check))
+        return 1;
+    /* the start and the end of a segment share the segmentation_event_id */
+    if (!TimeSignal(&check, 5, 0x34, false, 2000000) ||
+        !TimeSignal(&check, 5, 0x35, false, 4000000) ||
+        !TimeSignal(&check, 6, 0x34, false, 6000000) ||
+        !TimeSignal(&check, 6, 0x35, false, 8000000))
+        i_err++;
+    Run(&check, 5500000);
+    /* cancels both the start and the end of segment 6 */
+    if (!TimeSignal(&check, 6, 0x34, true, 0))
+        i_err++;
+    Run(&check, 4000000);
+    return Close(&check, "segmentation start and end", i_err,
+                 expected, sizeof(expected) / sizeof(expected[0]));
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckBreak();
+    i_err += CheckCancel();
+    i_err += CheckOverride();
+    i_err += CheckTimeSignal();
+    i_err += CheckSegmentation();
+
+    if (i_err)
+        fprintf(stderr, "%d splice scheduler checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+/*****************************************************************************
+ * test_streamclock.c: time conversion and stream clock checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * The stream clock is driven by TDTs and by dates derived from a PCR, as an
+ * application reading a live stream does. The checks make the PCR wrap and
+ * jump back, and compare the stream time and the state of an event with
+ * the expected ones.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/descriptor.h"
+#include "../src/tables/tot.h"
+#include "../src/tables/atsc_stt.h"
+#include "../src/streamclock.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/tot.h>
+#include <dvbpsi/atsc_stt.h>
+#include <dvbpsi/streamclock.h>
+#endif
+
+/* 1993-10-13 12:45:00, the example of EN 300 468 annex C */
+#define DVB_TIME        UINT64_C(0xc079124500)
+#define UNIX_TIME       INT64_C(750516300)
+
+/* date in microseconds of a 27 MHz PCR */
+#define PCR_DATE(pcr)   ((int64_t)((pcr) / 27))
+/* PCR of the last second before the 33 bit base wraps */
+#define PCR_END         ((UINT64_C(1) << 33) * 300 - UINT64_C(27000000))
+
+static void SendTDT(dvbpsi_stream_clock_t *p_clock, int64_t i_time, int64_t i_date)
+{
+    dvbpsi_tot_t tdt;
+
+    dvbpsi_tot_init(&tdt, 0x70, 0, 0, true, dvbpsi_time_unix_to_dvb(i_time));
+    dvbpsi_stream_clock_update_tot(p_clock, &tdt, i_date);
+    dvbpsi_tot_empty(&tdt);
+}
+
+/* compare the stream time at a date */
+static int CheckTime(const dvbpsi_stream_clock_t *p_clock, int64_t i_date,
+                     int64_t i_expected)
+{
+    int64_t i_time = 0;
+
+    if (!dvbpsi_stream_clock_utc(p_clock, i_date, &i_time) || i_time != i_expected)
+    {
+        fprintf(stderr, "  date %"PRId64": time %+"PRId64" instead of %+"PRId64"\n",
+                i_date, i_time - UNIX_TIME, i_expected - UNIX_TIME);
+        return 1;
+    }
+    return 0;
+}
+
+static int Result(const char *psz_name, int i_err)
+{
+    if (i_err)
+        fprintf(stderr, "\"%s\" stream clock check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckConversions(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"conversions\" stream clock check:\n");
+    if (dvbpsi_time_dvb_to_unix(DVB_TIME) != UNIX_TIME ||
+        dvbpsi_time_unix_to_dvb(UNIX_TIME) != DVB_TIME)
+    {
+        fprintf(stderr, "  MJD/BCD time not converted\n");
+        i_err++;
+    }
+    if (dvbpsi_time_bcd_to_seconds(0x014530) != 6330 ||
+        dvbpsi_time_seconds_to_bcd(6330) != 0x014530 ||
+        dvbpsi_time_seconds_to_bcd(100 * 3600) != 0x995959)
+    {
+        fprintf(stderr, "  BCD duration not converted\n");
+        i_err++;
+    }
+    if (dvbpsi_time_gps_to_unix(0, 0) != DVBPSI_TIME_GPS_EPOCH ||
+        dvbpsi_time_unix_to_gps(UNIX_TIME, 18) != UNIX_TIME - DVBPSI_TIME_GPS_EPOCH + 18)
+    {
+        fprintf(stderr, "  GPS time not converted\n");
+        i_err++;
+    }
+    return Result("conversions", i_err);
+}
+
+static int CheckPCRWrap(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"PCR wrap\" stream clock check:\n");
+    dvbpsi_stream_clock_t *p_clock = dvbpsi_stream_clock_new();
+    if (p_clock == NULL)
+        return 1;
+
+    int64_t i_date;
+    if (dvbpsi_stream_clock_utc(p_clock, 0, &i_date))
+    {
+        fprintf(stderr, "  time known before the first table\n");
+        i_err++;
+    }
+
+    /* TDT one second before the wrap, then dates after it */
+    SendTDT(p_clock, UNIX_TIME, PCR_DATE(PCR_END));
+    i_err += CheckTime(p_clock, PCR_DATE(PCR_END + 13500000), UNIX_TIME);
+    i_err += CheckTime(p_clock, PCR_DATE(UINT64_C(27000000)), UNIX_TIME + 2);
+    i_err += CheckTime(p_clock, PCR_DATE(UINT64_C(27000000) * 60), UNIX_TIME + 61);
+    if (dvbpsi_stream_clock_event(p_clock, PCR_DATE(UINT64_C(27000000) * 60),
+                                  UNIX_TIME + 30, 60) != DVBPSI_STREAM_CLOCK_RUNNING)
+    {
+        fprintf(stderr, "  event not running after the wrap\n");
+        i_err++;
+    }
+
+    /* the next TDT anchors the clock after the wrap */
+    SendTDT(p_clock, UNIX_TIME + 100, PCR_DATE(UINT64_C(27000000) * 99));
+    i_err += CheckTime(p_clock, PCR_DATE(UINT64_C(27000000) * 104), UNIX_TIME + 105);
+
+    dvbpsi_stream_clock_delete(p_clock);
+    return Result("PCR wrap", i_err);
+}
+
+static int CheckDiscontinuity(void)
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"PCR discontinuity\" stream clock check:\n");
+    dvbpsi_stream_clock_t *p_clock = dvbpsi_stream_clock_new();
+    if (p_clock == NULL)
+        return 1;
+
+    SendTDT(p_clock, UNIX_TIME, PCR_DATE(UINT64_C(27000000) * 600));
+    i_err += CheckTime(p_clock, PCR_DATE(UINT64_C(27000000) * 605), UNIX_TIME + 5);
+
+    /* the PCR jumps back by 500 s: the time stays at the last TDT and an
+     * event that has started does not go back to pending */
+    i_err += CheckTime(p_clock, PCR_DATE(UINT64_C(27000000) * 106), UNIX_TIME);
+    if (dvbpsi_stream_clock_event(p_clock, PCR_DATE(UINT64_C(27000000) * 106),
+                                  UNIX_TIME, 60) != DVBPSI_STREAM_CLOCK_RUNNING)
+    {
+        fprintf(stderr, "  event no longer running after the discontinuity\n");
+        i_err++;
+    }
+
+    /* the next TDT gives the time on the new timebase */
+    SendTDT(p_clock, UNIX_TIME + 10, PCR_DATE(UINT64_C(27000000) * 110));
+    i_err += CheckTime(p_clock, PCR_DATE(UINT64_C(27000000) * 170), UNIX_TIME + 70);
+    if (dvbpsi_stream_clock_event(p_clock, PCR_DATE(UINT64_C(27000000) * 170),
+                                  UNIX_TIME, 60) != DVBPSI_STREAM_CLOCK_ENDED)
+    {
+        fprintf(stderr, "  event not ended on the new timebase\n");
+        i_err++;
+    }
+
+    dvbpsi_stream_clock_delete(p_clock);
+    return Result("PCR discontinuity", i_err);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckConversions();
+    i_err += CheckPCRWrap();
+    i_err += CheckDiscontinuity();
+
+    if (i_err)
+        fprintf(stderr, "%d stream clock checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
@@ -0,0 +1,330 @@
+/*****************************************************************************
+ * test_tr101290.c: TR 101 290 monitor checks on crafted transport streams
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * A transport stream of one program is generated tick by tick: a PCR every
+ * 20 ms, the PAT and the PMT every 100 ms. Each check breaks the stream in
+ * one way and compares the indicators counted by the monitor with the
+ * expected ones.
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* the libdvbpsi distribution defines DVBPSI_DIST */
+#ifdef DVBPSI_DIST
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/descriptor.h"
+#include "../src/tables/pat.h"
+#include "../src/tables/pmt.h"
+#include "../src/tr101290.h"
+#else
+#include <dvbpsi/dvbpsi.h>
+#include <dvbpsi/psi.h>
+#include <dvbpsi/descriptor.h>
+#include <dvbpsi/pat.h>
+#include <dvbpsi/pmt.h>
+#include <dvbpsi/tr101290.h>
+#endif
+
+#include "test_ts.h"
+
+#define PMT_PID         0x100
+#define TICK            10000           /* 10 ms */
+
+/*****************************************************************************
+ * Stream: state of the generated transport stream
+ *****************************************************************************/
+typedef struct stream_s
+{
+    dvbpsi_tr101290_t  *p_mon;
+    dvbpsi_t           *p_dvbpsi;       /* for the section generators */
+    int64_t             i_date;
+    uint8_t             pi_cc[0x2000];
+
+    uint16_t            i_program;
+    uint16_t            i_pcr_pid;
+    uint8_t             i_version;
+
+    bool                b_pat;          /* send the PAT */
+    bool                b_pmt;          /* send the PMT */
+    bool                b_skip_cc;      /* skip a continuity_counter once */
+    bool                b_bad_crc;      /* corrupt the next PAT once */
+} stream_t;
+
+static void Push(stream_t *p_stream, const uint8_t *p_packets, size_t i_packets)
+{
+    dvbpsi_tr101290_packets_push(p_stream->p_mon, p_packets, i_packets,
+                                 p_stream->i_date);
+}
+
+static void SendPAT(stream_t *p_stream)
+{
+    uint8_t p_packets[4 * TEST_TS_SIZE];
+    dvbpsi_pat_t pat;
+
+    dvbpsi_pat_init(&pat, 1, p_stream->i_version, true);
+    dvbpsi_pat_program_add(&pat, p_stream->i_program, PMT_PID);
+    dvbpsi_psi_section_t *p_section = dvbpsi_pat_sections_generate(p_stream->p_dvbpsi,
+                                                                   &pat, 253);
+    if (p_stream->b_bad_crc)
+    {
+        p_section->p_payload_end[3] ^= 0xff;
+        p_stream->b_bad_crc = false;
+    }
+    size_t i_packets = TestPacketizeSections(p_packets, 4, 0x00, &p_stream->pi_cc[0x00],
+                                             p_section);
+    dvbpsi_DeletePSISections(p_section);
+    dvbpsi_pat_empty(&pat);
+    Push(p_stream, p_packets, i_packets);
+}
+
+static void SendPMT(stream_t *p_stream)
+{
+    uint8_t p_packets[4 * TEST_TS_SIZE];
+    dvbpsi_pmt_t pmt;
+
+    dvbpsi_pmt_init(&pmt, p_stream->i_program, p_stream->i_version, true,
+                    p_stream->i_pcr_pid);
+    dvbpsi_pmt_es_add(&pmt, 0x1b, p_stream->i_pcr_pid);
+    dvbpsi_psi_section_t *p_section = dvbpsi_pmt_sections_generate(p_stream->p_dvbpsi,
+                                                                   &pmt);
+    size_t i_packets = TestPacketizeSections(p_packets, 4, PMT_PID,
+                                             &p_stream->pi_cc[PMT_PID], p_section);
+    dvbpsi_DeletePSISections(p_section);
+    dvbpsi_pmt_empty(&pmt);
+    Push(p_stream, p_packets, i_packets);
+}
+
+static void SendPCR(stream_t *p_stream)
+{
+    uint8_t p_packet[TEST_TS_SIZE];
+    uint8_t *pi_cc = &p_stream->pi_cc[p_stream->i_pcr_pid];
+
+    if (p_stream->b_skip_cc)
+    {
+        *pi_cc = (*pi_cc + 1) & 0x0f;
+        p_stream->b_skip_cc = false;
+    }
+    /* adaptation field only packets do not increment the counter */
+    TestPCRPacket(p_packet, p_stream->i_pcr_pid, *pi_cc,
+                  (uint64_t)p_stream->i_date * 27, false);
+    Push(p_stream, p_packet, 1);
+}
+
+/* generate the stream for i_duration microseconds */
+static void Run(stream_t *p_stream, int64_t i_duration)
+{
+    for (int64_t i_end = p_stream->i_date + i_duration; p_stream->i_date < i_end;
+         p_stream->i_date += TICK)
+    {
+        if (p_stream->i_date % 20000 == 0)
+            SendPCR(p_stream);
+        if (p_stream->i_date % 100000 == 0)
+        {
+            if (p_stream->b_pat)
+                SendPAT(p_stream);
+            if (p_stream->b_pmt)
+                SendPMT(p_stream);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Check: compare the counted indicators with the expected ones
+ *****************************************************************************/
+static const char *ppsz_names[DVBPSI_TR101290_ERROR_MAX] =
+{
+    "TS_sync_loss", "Sync_byte_error", "PAT_error_2", "Continuity_count_error",
+    "PMT_error_2", "PID_error", "Transport_error", "CRC_error",
+    "PCR_repetition_error", "PCR_discontinuity_indicator_error",
+    "PCR_accuracy_error", "PTS_error", "CAT_error"
+};
+
+static bool Open(stream_t *p_stream)
+{
+    dvbpsi_tr101290_config_t config;
+
+    memset(p_stream, 0, sizeof(stream_t));
+    dvbpsi_tr101290_config_default(&config);
+    /* the generated stream is not constant bitrate */
+    config.i_pcr_accuracy_ns = INT64_MAX;
+
+    p_stream->p_mon = dvbpsi_tr101290_new(&config, NULL, NULL, NULL, DVBPSI_MSG_NONE);
+    p_stream->p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    p_stream->i_program = 1;
+    p_stream->i_pcr_pid = 0x101;
+    p_stream->b_pat = p_stream->b_pmt = true;
+    return p_stream->p_mon && p_stream->p_dvbpsi;
+}
+
+static int Close(stream_t *p_stream, const char *psz_name,
+                 const uint64_t pi_expected[DVBPSI_TR101290_ERROR_MAX])
+{
+    int i_err = 0;
+
+    fprintf(stdout, "\"%s\" TR 101 290 check:\n", psz_name);
+    for (int i = 0; i < DVBPSI_TR101290_ERROR_MAX; i++)
+    {
+        uint64_t i_count = dvbpsi_tr101290_count(p_stream->p_mon, i);
+        if (i_count != pi_expected[i])
+        {
+            fprintf(stderr, "  %s: %llu instead of %llu\n", ppsz_names[i],
+                    (unsigned long long)i_count, (unsigned long long)pi_expected[i]);
+            i_err++;
+        }
+    }
+    dvbpsi_tr101290_delete(p_stream->p_mon);
+    dvbpsi_delete(p_stream->p_dvbpsi);
+
+    if (i_err)
+        fprintf(stderr, "\"%s\" TR 101 290 check FAILED !!!\n\n", psz_name);
+    else
+        fprintf(stdout, "  \"%s\" OK\n\n", psz_name);
+    return i_err ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+static int CheckClean(void)
+{
+    uint64_t pi_expected[DVBPSI_TR101290_ERROR_MAX] = { 0 };
+    stream_t stream;
+
+    if (!Open(&stream))
+        return 1;
+    Run(&stream, 2000000);
+    return Close(&stream, "clean stream", pi_expected);
+}
+
+static int CheckContinuity(void)
+{
+    uint64_t pi_expected[DVBPSI_TR101290_ERROR_MAX] = { 0 };
+    stream_t stream;
+
+    if (!Open(&stream))
+        return 1;
+    Run(&stream, 500000);
+    stream.b_skip_cc = true;
+    Run(&stream, 500000);
+
+    pi_expected[DVBPSI_TR101290_CC_ERROR] = 1;
+    return Close(&stream, "continuity_counter", pi_expected);
+}
+
+static int CheckPATRepetition(void)
+{
+    uint64_t pi_expected[DVBPSI_TR101290_ERROR_MAX] = { 0 };
+    stream_t stream;
+
+    if (!Open(&stream))
+        return 1;
+    Run(&stream, 500000);
+    stream.b_pat = false;
+    Run(&stream, 1000000);
+    stream.b_pat = true;
+    Run(&stream, 500000);
+
+    pi_expected[DVBPSI_TR101290_PAT_ERROR] = 1;
+    return Close(&stream, "PAT repetition", pi_expected);
+}
+
+static int CheckPMTRepetition(void)
+{
+    uint64_t pi_expected[DVBPSI_TR101290_ERROR_MAX] = { 0 };
+    stream_t stream;
+
+    if (!Open(&stream))
+        return 1;
+    Run(&stream, 500000);
+    stream.b_pmt = false;
+    Run(&stream, 1000000);
+    stream.b_pmt = true;
+    Run(&stream, 500000);
+
+    pi_expected[DVBPSI_TR101290_PMT_ERROR] = 1;
+    return Close(&stream, "PMT repetition", pi_expected);
+}
+
+static int CheckCRC(void)
+{
+    uint64_t pi_expected[DVBPSI_TR101290_ERROR_MAX] = { 0 };
+    stream_t stream;
+
+    if (!Open(&stream))
+        return 1;
+    Run(&stream, 500000);
+    stream.b_bad_crc = true;
+    Run(&stream, 500000);
+
+    pi_expected[DVBPSI_TR101290_CRC_ERROR] = 1;
+    return Close(&stream, "CRC_32", pi_expected);
+}
+
+/* a new PAT gives the PMT PID to another program with another PCR PID: the
+ * PCR PID of the previous program must no longer be expected */
+static int CheckProgramChange(void)
+{
+    uint64_t pi_expected[DVBPSI_TR101290_ERROR_MAX] = { 0 };
+    stream_t stream;
+
+    if (!Open(&stream))
+        return 1;
+    Run(&stream, 1000000);
+    stream.i_program = 2;
+    stream.i_pcr_pid = 0x201;
+    stream.i_version = 1;
+    Run(&stream, 7000000);
+
+    return Close(&stream, "program change on a PMT PID", pi_expected);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+    int i_err = 0;
+
+    i_err += CheckClean();
+    i_err += CheckContinuity();
+    i_err += CheckPATRepetition();
+    i_err += CheckPMTRepetition();
+    i_err += CheckCRC();
+    i_err += CheckProgramChange();
+
+    if (i_err)
+        fprintf(stderr, "%d TR 101 290 checks FAILED\n", i_err);
+    return i_err ? 1 : 0;
+}
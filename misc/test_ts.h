@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * test_ts.h: TS packets and sections for the misc/ checks
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ * Helpers shared by the checks that feed crafted transport streams to the
+ * library. dvbpsi.h and psi.h must be included before this file.
+ *
+ *****************************************************************************/
+
+#ifndef _TEST_TS_H_
+#define _TEST_TS_H_
+
+#define TEST_TS_SIZE    188
+
+/*****************************************************************************
+ * TestSectionSize: size of a generated section, CRC_32 included
+ *****************************************************************************/
+static inline size_t TestSectionSize(const dvbpsi_psi_section_t *p_section)
+{
+    return (size_t)(p_section->p_payload_end - p_section->p_data) +
+           (p_section->b_syntax_indicator ? 4 : 0);
+}
+
+/*****************************************************************************
+ * TestPacketize: cut a section into TS packets of a PID
+ *****************************************************************************
+ * The section starts in the first packet with a pointer_field of 0, the last
+ * packet is stuffed with 0xff. *pi_cc is the continuity_counter of the
+ * first packet and is updated. Returns the number of packets written in
+ * p_packets, at most i_max.
+ *****************************************************************************/
+static inline size_t TestPacketize(uint8_t *p_packets, size_t i_max, uint16_t i_pid,
+                                   uint8_t *pi_cc, const uint8_t *p_section,
+                                   size_t i_size)
+{
+    size_t i_packets = 0;
+    bool b_first = true;
+
+    while (i_size > 0 && i_packets < i_max)
+    {
+        uint8_t *p = p_packets + i_packets * TEST_TS_SIZE;
+        size_t i_header = b_first ? 5 : 4;
+        size_t i_copy = i_size < TEST_TS_SIZE - i_header ? i_size : TEST_TS_SIZE - i_header;
+
+        memset(p, 0xff, TEST_TS_SIZE);
+        p[0] = 0x47;
+        p[1] = (b_first ? 0x40 : 0x00) | (i_pid >> 8);
+        p[2] = i_pid & 0xff;
+        p[3] = 0x10 | (*pi_cc & 0x0f);
+        if (b_first)
+            p[4] = 0x00;
+        memcpy(p + i_header, p_section, i_copy);
+
+        *pi_cc = (*pi_cc + 1) & 0x0f;
+        p_section += i_copy;
+        i_size -= i_copy;
+        b_first = false;
+        i_packets++;
+    }
+    return i_packets;
+}
+
+/*****************************************************************************
+ * TestPacketizeSections: cut a list of generated sections into TS packets
+ *****************************************************************************/
+static inline size_t TestPacketizeSections(uint8_t *p_packets, size_t i_max,
+                                           uint16_t i_pid, uint8_t *pi_cc,
+                                           const dvbpsi_psi_section_t *p_section)
+{
+    size_t i_packets = 0;
+
+    for (; p_section; p_section = p_section->p_next)
+        i_packets += TestPacketize(p_packets + i_packets * TEST_TS_SIZE,
+                                   i_max - i_packets, i_pid, pi_cc,
+                                   p_section->p_data, TestSectionSize(p_section));
+    return i_packets;
+}
+
+/*****************************************************************************
+ * TestPCRPacket: adaptation field only packet carrying a PCR
+ *****************************************************************************/
+static inline void TestPCRPacket(uint8_t *p, uint16_t i_pid, uint8_t i_cc,
+                                 uint64_t i_pcr, bool b_discontinuity)
+{
+    uint64_t i_base = i_pcr / 300;
+    uint16_t i_ext = i_pcr % 300;
+
+    memset(p, 0xff, TEST_TS_SIZE);
+    p[0] = 0x47;
+    p[1] = i_pid >> 8;
+    p[2] = i_pid & 0xff;
+    p[3] = 0x20 | (i_cc & 0x0f);
+    p[4] = 183;
+    p[5] = 0x10 | (b_discontinuity ? 0x80 : 0x00);
+    p[6] = i_base >> 25;
+    p[7] = i_base >> 17;
+    p[8] = i_base >> 9;
+    p[9] = i_base >> 1;
+    p[10] = ((i_base & 1) << 7) | 0x7e | (i_ext >> 8);
+    p[11] = i_ext & 0xff;
+}
+
+#endif
@@ -0,0 +1,515 @@
+/*****************************************************************************
+ * acquire.hpp
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <acquire.hpp>
+ * \brief C++20 coroutine interface for table acquisition.
+ *
+ * An acquirer decodes the PAT, the PMT of the programs being waited for and
+ * the SDT of the actual transport stream from the TS packets given to
+ * dvbpsi::acquirer::push(). Coroutines wait for the tables with
+ * co_await next_pat(), next_pmt(program) and next_sdt():
+ *
+ * \code
+ * dvbpsi::task<void> zap(dvbpsi::acquirer &a, uint16_t i_program)
+ * {
+ *     dvbpsi::pmt pmt = co_await a.next_pmt(i_program, 500000);
+ *     if (!pmt)
+ *         co_return;  // timed out or cancelled
+ *     ...
+ * }
+ * \endcode
+ *
+ * Each table is received by one waiter: a table that arrives while nobody
+ * waits is kept until the next wait, a newer one replaces it. The PAT and
+ * SDT decoders run all the time and only complete a table on a new
+ * version, waiting twice for the PAT thus waits for the next version. The
+ * PMT decoder of a program only runs while the program is waited for, each
+ * wait receives a complete PMT.
+ *
+ * Everything runs in push(): the waiting coroutines are resumed after the
+ * packet is decoded, in the order they started to wait, and those whose
+ * timeout expired at the date of the packet are resumed with an empty
+ * table. A timeout runs from the date of the first packet pushed after the
+ * wait started. No thread is involved and waiting does not allocate memory.
+ *
+ * dvbpsi.hpp and the headers it requires must be included before this
+ * file.
+ */
+
+#ifndef _DVBPSI_ACQUIRE_HPP_
+#define _DVBPSI_ACQUIRE_HPP_
+
+#if !defined(__cplusplus) || __cplusplus < 202002L
+#error "acquire.hpp requires C++20"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dvbpsi
+{
+
+/*****************************************************************************
+ * task
+ *****************************************************************************/
+template <typename T = void>
+class task;
+
+namespace detail
+{
+
+struct promise_base
+{
+    std::coroutine_handle<> continuation;
+    std::exception_ptr      exception;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    /* resumes the awaiting task, if any */
+    struct final_awaiter
+    {
+        bool await_ready() noexcept { return false; }
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+        {
+            std::coroutine_handle<> next = h.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+    final_awaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+    void rethrow() const
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+};
+
+template <typename T>
+struct promise : promise_base
+{
+    std::optional<T> value;
+
+    task<T> get_return_object() noexcept;
+    template <typename U>
+    void return_value(U &&u) { value.emplace(std::forward<U>(u)); }
+    T take()
+    {
+        rethrow();
+        return std::move(*value);
+    }
+};
+
+template <>
+struct promise<void> : promise_base
+{
+    task<void> get_return_object() noexcept;
+    void return_void() noexcept {}
+    void take() const { rethrow(); }
+};
+
+} /* namespace detail */
+
+/*!
+ * \class task
+ * \brief Move only coroutine returning T.
+ *
+ * A task starts when it is awaited by another task, which resumes when it
+ * returns, or with start() for the outermost task of a control logic.
+ * Destroying a task destroys its coroutine and stops its waits.
+ */
+template <typename T>
+class task
+{
+public:
+    typedef detail::promise<T> promise_type;    /*!< coroutine promise */
+
+    task() noexcept = default;
+    explicit task(std::coroutine_handle<promise_type> h) noexcept : coro(h) {}
+    task(task &&o) noexcept : coro(std::exchange(o.coro, nullptr)) {}
+    task &operator=(task &&o) noexcept
+    {
+        if (this != &o)
+        {
+            if (coro)
+                coro.destroy();
+            coro = std::exchange(o.coro, nullptr);
+        }
+        return *this;
+    }
+    ~task()
+    {
+        if (coro)
+            coro.destroy();
+    }
+
+    /*! \brief run the task until it waits for a table or returns */
+    void start()
+    {
+        if (coro && !coro.done())
+            coro.resume();
+    }
+    /*! \brief true when the task has returned */
+    bool done() const noexcept { return !coro || coro.done(); }
+    /*! \brief the value returned by a done task, rethrows its exception */
+    T result() { return coro.promise().take(); }
+
+    /*! \brief awaiting a task starts it and resumes with its value */
+    auto operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            std::coroutine_handle<promise_type> h;
+            bool await_ready() const noexcept { return !h || h.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+            {
+                h.promise().continuation = caller;
+                return h;
+            }
+            T await_resume() { return h.promise().take(); }
+        };
+        return awaiter{ coro };
+    }
+
+private:
+    std::coroutine_handle<promise_type> coro;
+};
+
+namespace detail
+{
+
+template <typename T>
+inline task<T> promise<T>::get_return_object() noexcept
+{
+    return task<T>(std::coroutine_handle<promise<T>>::from_promise(*this));
+}
+
+inline task<void> promise<void>::get_return_object() noexcept
+{
+    return task<void>(std::coroutine_handle<promise<void>>::from_promise(*this));
+}
+
+} /* namespace detail */
+
+/*****************************************************************************
+ * acquirer
+ *****************************************************************************/
+/*!
+ * \class acquirer
+ * \brief Acquires the tables of a transport stream for the coroutines
+ * waiting for them. Not copyable nor movable, the waits refer to it.
+ */
+class acquirer
+{
+    struct waiter;
+
+public:
+    /*! \brief no timeout */
+    static constexpr int64_t forever = -1;
+
+    /*!
+     * \class wait
+     * \brief Awaitable returned by the next_*() functions, resumes with the
+     * table, or with an empty table on timeout or cancellation.
+     */
+    template <typename Table>
+    class wait;
+
+    explicit acquirer(dvbpsi_msg_level_t level = DVBPSI_MSG_NONE)
+        : msg_level(level), pat_decoder(level), sdt_decoder(level)
+    {
+        pat_decoder.attach_pat([this](dvbpsi::pat t) { on_pat(std::move(t)); });
+        sdt_decoder.attach_demux([this](dvbpsi::demux &d, uint8_t i_table_id, uint16_t i_extension) {
+            if (i_table_id == 0x42)
+                d.attach_sdt(i_table_id, i_extension,
+                             [this](dvbpsi::sdt t) { sdt_slot = std::move(t); });
+        });
+    }
+    acquirer(const acquirer &) = delete;
+    acquirer &operator=(const acquirer &) = delete;
+
+    /*!
+     * \brief wait for the next PAT, timeout in the unit of the dates from
+     * the next pushed packet
+     */
+    wait<pat> next_pat(int64_t i_timeout = forever);
+    /*! \brief wait for the next PMT of a program of the PAT */
+    wait<pmt> next_pmt(uint16_t i_program, int64_t i_timeout = forever);
+    /*! \brief wait for the next SDT of the actual transport stream */
+    wait<sdt> next_sdt(int64_t i_timeout = forever);
+
+    /*!
+     * \brief decode a dated TS packet, then resume the coroutines whose
+     * table arrived or whose timeout expired
+     */
+    void push(const uint8_t *p_packet, int64_t i_date)
+    {
+        uint16_t i_pid = ((p_packet[1] & 0x1f) << 8) | p_packet[2];
+        i_now = i_date;
+        arm();
+        if (i_pid == 0x00)
+            pat_decoder.push(p_packet, i_date);
+        else if (i_pid == 0x11)
+            sdt_decoder.push(p_packet, i_date);
+        else
+            for (pmt_slot &s : pmt_slots)
+                if (s.i_pid == i_pid && s.decoder)
+                    s.decoder->push(p_packet, i_date);
+        resume();
+    }
+
+    /*! \brief resume every waiting coroutine with an empty table, and all
+     * following waits immediately */
+    void cancel()
+    {
+        b_cancelled = true;
+        resume();
+    }
+    /*! \brief true after cancel() */
+    bool cancelled() const noexcept { return b_cancelled; }
+    /*! \brief date of the last pushed packet */
+    int64_t now() const noexcept { return i_now; }
+
+private:
+    struct waiter
+    {
+        waiter  *p_next = nullptr;
+        int64_t  i_timeout;
+        int64_t  i_deadline;
+        bool     b_armed = false;      /* i_deadline is set */
+        uint16_t i_program;
+        std::coroutine_handle<> coro;
+
+        /* takes the table from its slot, false if there is none */
+        virtual bool take() = 0;
+    };
+
+    struct pmt_slot
+    {
+        uint16_t i_program;
+        uint16_t i_pid = 0x1fff;        /* unknown until the PAT lists it */
+        unsigned i_waiters = 0;
+        std::optional<handle> decoder;
+        pmt table;
+    };
+
+    dvbpsi_msg_level_t msg_level;
+    handle pat_decoder;
+    handle sdt_decoder;
+    std::vector<pmt_slot> pmt_slots;
+    std::vector<std::pair<uint16_t, uint16_t>> programs;  /* of the last PAT */
+    pat pat_slot;
+    sdt sdt_slot;
+    waiter *p_first = nullptr;
+    int64_t i_now = 0;
+    bool b_cancelled = false;
+
+    uint16_t pmt_pid(uint16_t i_program) const
+    {
+        for (const auto &program : programs)
+            if (program.first == i_program)
+                return program.second;
+        return 0x1fff;
+    }
+
+    void on_pat(pat t)
+    {
+        programs.clear();
+        for (const dvbpsi_pat_program_t &program : t.programs())
+            programs.emplace_back(program.i_number, program.i_pid);
+        for (pmt_slot &s : pmt_slots)
+        {
+            uint16_t i_pid = pmt_pid(s.i_program);
+            if (i_pid != s.i_pid)
+            {
+                s.i_pid = i_pid;
+                s.decoder.reset();
+                attach_pmt(s);
+            }
+        }
+        pat_slot = std::move(t);
+    }
+
+    pmt_slot &find_pmt(uint16_t i_program)
+    {
+        for (pmt_slot &s : pmt_slots)
+            if (s.i_program == i_program)
+                return s;
+        pmt_slot &s = pmt_slots.emplace_back();
+        s.i_program = i_program;
+        s.i_pid = pmt_pid(i_program);
+        return s;
+    }
+
+    /* the PMT decoder of a program only runs while it is waited for */
+    void attach_pmt(pmt_slot &s)
+    {
+        if (s.decoder || !s.i_waiters || s.i_pid == 0x1fff)
+            return;
+        uint16_t i_program = s.i_program;
+        s.decoder.emplace(msg_level);
+        s.decoder->attach_pmt(i_program, [this, i_program](dvbpsi::pmt t) {
+            find_pmt(i_program).table = std::move(t);
+        });
+    }
+
+    void link(waiter *w)
+    {
+        waiter **pp = &p_first;
+        while (*pp)
+            pp = &(*pp)->p_next;
+        *pp = w;
+    }
+
+    bool unlink(waiter *w)
+    {
+        for (waiter **pp = &p_first; *pp; pp = &(*pp)->p_next)
+            if (*pp == w)
+            {
+                *pp = w->p_next;
+                w->p_next = nullptr;
+                return true;
+            }
+        return false;
+    }
+
+    /* the deadlines of the new waits are taken from the first date pushed
+     * after them, the date of the last packet may be long gone */
+    void arm()
+    {
+        for (waiter *w = p_first; w; w = w->p_next)
+            if (!w->b_armed)
+            {
+                w->i_deadline = i_now + w->i_timeout;
+                w->b_armed = true;
+            }
+    }
+
+    static bool expired(const waiter *w, int64_t i_date)
+    {
+        return w->i_timeout >= 0 && w->b_armed && w->i_deadline <= i_date;
+    }
+
+    /* a resumed coroutine may wait again or destroy other ones, the
+     * list is walked again from its start after each resumption */
+    void resume()
+    {
+        for (;;)
+        {
+            waiter *w = p_first;
+            while (w && !w->take() && !b_cancelled && !expired(w, i_now))
+                w = w->p_next;
+            if (!w)
+                return;
+            unlink(w);
+            w->coro.resume();
+        }
+    }
+
+};
+
+template <typename Table>
+class acquirer::wait : private acquirer::waiter
+{
+public:
+    wait(acquirer &acq, uint16_t i_prog, int64_t i_delay) : a(acq)
+    {
+        i_program = i_prog;
+        i_timeout = i_delay;
+        if constexpr (std::is_same_v<Table, pmt>)
+        {
+            pmt_slot &s = a.find_pmt(i_program);
+            s.i_waiters++;
+            a.attach_pmt(s);
+        }
+    }
+    wait(const wait &) = delete;
+    wait &operator=(const wait &) = delete;
+    ~wait()
+    {
+        a.unlink(this);
+        if constexpr (std::is_same_v<Table, pmt>)
+        {
+            pmt_slot &s = a.find_pmt(i_program);
+            if (--s.i_waiters == 0)
+                s.decoder.reset();
+        }
+    }
+
+    bool await_ready() { return a.b_cancelled || take(); }
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        coro = h;
+        a.link(this);
+    }
+    Table await_resume() { return std::move(table); }
+
+private:
+    acquirer &a;
+    Table table;
+
+    Table &slot()
+    {
+        if constexpr (std::is_same_v<Table, pmt>)
+            return a.find_pmt(i_program).table;
+        else if constexpr (std::is_same_v<Table, pat>)
+            return a.pat_slot;
+        else
+            return a.sdt_slot;
+    }
+
+    bool take() override
+    {
+        Table &t = slot();
+        if (!t)
+            return false;
+        table = std::move(t);
+        return true;
+    }
+};
+
+inline acquirer::wait<pat> acquirer::next_pat(int64_t i_timeout)
+{
+    return wait<pat>(*this, 0, i_timeout);
+}
+
+inline acquirer::wait<pmt> acquirer::next_pmt(uint16_t i_program, int64_t i_timeout)
+{
+    return wait<pmt>(*this, i_program, i_timeout);
+}
+
+inline acquirer::wait<sdt> acquirer::next_sdt(int64_t i_timeout)
+{
+    return wait<sdt>(*this, 0, i_timeout);
+}
+
+} /* namespace dvbpsi */
+
+#else
+#error "Multiple inclusions of acquire.hpp"
+#endif
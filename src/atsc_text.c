@@ -0,0 +1,552 @@
+/*****************************************************************************
+ * atsc_text.c: ATSC multiple_string_structure decoder
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "atsc_text.h"
+
+#define TEXT_CONTEXTS       128     /* prior symbols of the order-1 model */
+#define TEXT_OFFSETS_SIZE   (2 * TEXT_CONTEXTS)
+#define TEXT_MAX_NODES      128     /* node indexes are 7 bit */
+#define TEXT_NO_TABLE       UINT16_MAX
+
+#define TEXT_END            0x00    /* end of string symbol */
+#define TEXT_ESCAPE         0x1b    /* next 8 bits are an uncompressed character */
+
+#define TEXT_LOOKUP_BITS    8
+#define TEXT_LOOKUP_SIZE    (1 << TEXT_LOOKUP_BITS)
+
+/* Lookup table entries: either a leaf holding the symbol and the number of
+ * bits of its code, or the index of the table of the node reached after
+ * TEXT_LOOKUP_BITS bits. A leaf of 0 bits marks a path leaving the tree. */
+#define TEXT_LEAF           0x8000
+#define TEXT_LEAF_BITS(e)   (((e) >> 8) & 0x0f)
+#define TEXT_LEAF_SYMBOL(e) ((e) & 0x7f)
+#define TEXT_INVALID        TEXT_LEAF
+
+/*****************************************************************************
+ * text_huffman_t
+ *****************************************************************************
+ * Lookup tables of one set of Annex C trees.
+ *****************************************************************************/
+typedef struct text_huffman_s
+{
+    uint16_t        pi_root[TEXT_CONTEXTS];     /* table of each tree root */
+    uint16_t        i_tables;
+    uint16_t      (*p_tables)[TEXT_LOOKUP_SIZE];
+} text_huffman_t;
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_s
+ *****************************************************************************/
+struct dvbpsi_atsc_text_s
+{
+    text_huffman_t *pp_huffman[2];  /* title and description trees */
+};
+
+/*****************************************************************************
+ * text_huffman_builder_t
+ *****************************************************************************
+ * State used while building the lookup tables of one tree.
+ *****************************************************************************/
+typedef struct text_huffman_builder_s
+{
+    text_huffman_t *p_huffman;
+    uint16_t        i_allocated;
+    const uint8_t  *p_tree;         /* first node of the tree */
+    size_t          i_size;         /* bytes available from p_tree */
+    uint16_t        pi_node_table[TEXT_MAX_NODES];
+} text_huffman_builder_t;
+
+/*****************************************************************************
+ * huffman_Delete
+ *****************************************************************************/
+static void huffman_Delete(text_huffman_t *p_huffman)
+{
+    if (p_huffman == NULL)
+        return;
+    free(p_huffman->p_tables);
+    free(p_huffman);
+}
+
+/*****************************************************************************
+ * huffman_Table
+ *****************************************************************************
+ * Return the lookup table starting at a node, build it if needed.
+ *****************************************************************************/
+static uint16_t huffman_Table(text_huffman_builder_t *p_builder, uint8_t i_node)
+{
+    text_huffman_t *p_huffman = p_builder->p_huffman;
+
+    if (p_builder->pi_node_table[i_node] != TEXT_NO_TABLE)
+        return p_builder->pi_node_table[i_node];
+
+    if (p_huffman->i_tables == p_builder->i_allocated)
+    {
+        /* At most 128 trees of 127 nodes */
+        uint16_t i_allocated = p_builder->i_allocated ? 2 * p_builder->i_allocated : 256;
+        if (i_allocated > TEXT_CONTEXTS * TEXT_MAX_NODES)
+            i_allocated = TEXT_CONTEXTS * TEXT_MAX_NODES;
+        uint16_t (*p_tables)[TEXT_LOOKUP_SIZE] = realloc(p_huffman->p_tables,
+                                                         i_allocated * sizeof(*p_tables));
+        if (p_tables == NULL)
+            return TEXT_NO_TABLE;
+        p_huffman->p_tables = p_tables;
+        p_builder->i_allocated = i_allocated;
+    }
+
+    /* Register the table before filling it, a node reached again through a
+     * malformed tree then links to it instead of recursing forever. */
+    uint16_t i_table = p_huffman->i_tables++;
+    p_builder->pi_node_table[i_node] = i_table;
+
+    for (unsigned int i_bits = 0; i_bits < TEXT_LOOKUP_SIZE; i_bits++)
+    {
+        uint16_t i_entry = TEXT_INVALID;
+        uint8_t i_current = i_node;
+        unsigned int i_depth;
+
+        for (i_depth = 0; i_depth < TEXT_LOOKUP_BITS; i_depth++)
+        {
+            size_t i_offset = 2 * (size_t)i_current +
+                              ((i_bits >> (TEXT_LOOKUP_BITS - 1 - i_depth)) & 0x01);
+            if (i_offset >= p_builder->i_size)
+                break;
+
+            uint8_t i_child = p_builder->p_tree[i_offset];
+            if (i_child & 0x80)
+            {
+                i_entry = TEXT_LEAF | ((i_depth + 1) << 8) | (i_child & 0x7f);
+                break;
+            }
+            i_current = i_child;
+        }
+
+        if (i_depth == TEXT_LOOKUP_BITS)
+        {
+            i_entry = huffman_Table(p_builder, i_current);
+            if (i_entry == TEXT_NO_TABLE)
+                return TEXT_NO_TABLE;
+        }
+
+        p_huffman->p_tables[i_table][i_bits] = i_entry;
+    }
+
+    return i_table;
+}
+
+/*****************************************************************************
+ * huffman_New
+ *****************************************************************************
+ * Build the lookup tables of the 128 trees of an Annex C table. Prior
+ * symbols whose offset is out of range get no tree, the one of the
+ * beginning of a string (prior symbol 0) is mandatory.
+ *****************************************************************************/
+static text_huffman_t *huffman_New(const uint8_t *p_tree, size_t i_size)
+{
+    if (i_size < TEXT_OFFSETS_SIZE)
+        return NULL;
+
+    text_huffman_t *p_huffman = (text_huffman_t *)calloc(1, sizeof(text_huffman_t));
+    if (p_huffman == NULL)
+        return NULL;
+
+    text_huffman_builder_t builder;
+    builder.p_huffman = p_huffman;
+    builder.i_allocated = 0;
+
+    for (unsigned int i_context = 0; i_context < TEXT_CONTEXTS; i_context++)
+    {
+        size_t i_offset = ((size_t)p_tree[2 * i_context] << 8) | p_tree[2 * i_context + 1];
+
+        p_huffman->pi_root[i_context] = TEXT_NO_TABLE;
+        if (i_offset < TEXT_OFFSETS_SIZE || i_offset >= i_size)
+        {
+            if (i_context == 0)
+                goto error;
+            continue;
+        }
+
+        builder.p_tree = p_tree + i_offset;
+        builder.i_size = i_size - i_offset;
+        for (unsigned int i = 0; i < TEXT_MAX_NODES; i++)
+            builder.pi_node_table[i] = TEXT_NO_TABLE;
+
+        p_huffman->pi_root[i_context] = huffman_Table(&builder, 0);
+        if (p_huffman->pi_root[i_context] == TEXT_NO_TABLE)
+            goto error;
+    }
+
+    return p_huffman;
+
+error:
+    huffman_Delete(p_huffman);
+    return NULL;
+}
+
+/*****************************************************************************
+ * text_writer_t
+ *****************************************************************************
+ * UTF-8 output of one string, always NUL terminated.
+ *****************************************************************************/
+typedef struct text_writer_s
+{
+    char       *p_buffer;
+    size_t      i_size;     /* bytes available, NUL included */
+    size_t      i_length;
+    bool        b_full;
+} text_writer_t;
+
+static void text_PutMultiByte(text_writer_t *p_writer, uint32_t i_code)
+{
+    uint8_t p_utf8[4];
+    size_t i_bytes;
+
+    if (i_code < 0x800)
+    {
+        p_utf8[0] = 0xc0 | (i_code >> 6);
+        p_utf8[1] = 0x80 | (i_code & 0x3f);
+        i_bytes = 2;
+    }
+    else if (i_code < 0x10000)
+    {
+        p_utf8[0] = 0xe0 | (i_code >> 12);
+        p_utf8[1] = 0x80 | ((i_code >> 6) & 0x3f);
+        p_utf8[2] = 0x80 | (i_code & 0x3f);
+        i_bytes = 3;
+    }
+    else
+    {
+        p_utf8[0] = 0xf0 | (i_code >> 18);
+        p_utf8[1] = 0x80 | ((i_code >> 12) & 0x3f);
+        p_utf8[2] = 0x80 | ((i_code >> 6) & 0x3f);
+        p_utf8[3] = 0x80 | (i_code & 0x3f);
+        i_bytes = 4;
+    }
+
+    if (p_writer->i_length + i_bytes >= p_writer->i_size)
+    {
+        p_writer->b_full = true;
+        return;
+    }
+
+    memcpy(p_writer->p_buffer + p_writer->i_length, p_utf8, i_bytes);
+    p_writer->i_length += i_bytes;
+}
+
+static inline void text_Put(text_writer_t *p_writer, uint32_t i_code)
+{
+    if (i_code == 0 || p_writer->b_full)
+        return;
+
+    if (i_code >= 0x80)
+        text_PutMultiByte(p_writer, i_code);
+    else if (p_writer->i_length + 1 < p_writer->i_size)
+        p_writer->p_buffer[p_writer->i_length++] = i_code;
+    else
+        p_writer->b_full = true;
+}
+
+/*****************************************************************************
+ * text_bits_t
+ *****************************************************************************
+ * MSB first bit reader, i_cache holds i_cached bits left aligned.
+ *****************************************************************************/
+typedef struct text_bits_s
+{
+    const uint8_t  *p_data;
+    const uint8_t  *p_end;
+    uint64_t        i_cache;
+    unsigned int    i_cached;
+    size_t          i_left;     /* bits not consumed, cache included */
+} text_bits_t;
+
+static inline void text_Refill(text_bits_t *p_bits)
+{
+    while (p_bits->i_cached <= 56 && p_bits->p_data < p_bits->p_end)
+    {
+        p_bits->i_cache |= (uint64_t)*p_bits->p_data++ << (56 - p_bits->i_cached);
+        p_bits->i_cached += 8;
+    }
+}
+
+static inline unsigned int text_Peek(text_bits_t *p_bits, unsigned int i_count)
+{
+    if (p_bits->i_cached < i_count)
+        text_Refill(p_bits);
+    return p_bits->i_cache >> (64 - i_count);
+}
+
+static inline void text_Skip(text_bits_t *p_bits, unsigned int i_count)
+{
+    p_bits->i_cache <<= i_count;
+    p_bits->i_cached = p_bits->i_cached > i_count ? p_bits->i_cached - i_count : 0;
+    p_bits->i_left -= i_count;
+}
+
+/*****************************************************************************
+ * text_DecodeHuffman
+ *****************************************************************************
+ * Decompress an Annex C segment, the characters are code points of the
+ * given Unicode page. Return false if the data leaves the tree.
+ *****************************************************************************/
+static bool text_DecodeHuffman(const text_huffman_t *p_huffman, const uint8_t *p_data,
+                               size_t i_length, uint32_t i_page, text_writer_t *p_writer)
+{
+    text_bits_t bits = { p_data, p_data + i_length, 0, 0, 8 * i_length };
+    uint8_t i_context = 0;
+
+    while (bits.i_left > 0 && !p_writer->b_full)
+    {
+        uint16_t i_entry = p_huffman->pi_root[i_context];
+
+        if (i_entry == TEXT_NO_TABLE)
+            return false;
+
+        do
+        {
+            i_entry = p_huffman->p_tables[i_entry][text_Peek(&bits, TEXT_LOOKUP_BITS)];
+
+            unsigned int i_count = i_entry & TEXT_LEAF ? TEXT_LEAF_BITS(i_entry) : TEXT_LOOKUP_BITS;
+            if (i_count == 0)
+                return false;
+            /* Padding bits at the end of the segment */
+            if (i_count > bits.i_left)
+                return true;
+            text_Skip(&bits, i_count);
+        } while (!(i_entry & TEXT_LEAF));
+
+        uint32_t i_char = TEXT_LEAF_SYMBOL(i_entry);
+        if (i_char == TEXT_END)
+            return true;
+
+        if (i_char == TEXT_ESCAPE)
+        {
+            if (bits.i_left < 8)
+                return true;
+            i_char = text_Peek(&bits, 8);
+            text_Skip(&bits, 8);
+        }
+
+        text_Put(p_writer, i_page | i_char);
+
+        /* Escaped characters above 0x7f have no tree of their own, the
+         * next character is decoded as at the beginning of a string. */
+        i_context = i_char < TEXT_CONTEXTS ? i_char : 0;
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+ * text_DecodeSegment
+ *****************************************************************************
+ * Decode one segment, return false if it is not supported.
+ *****************************************************************************/
+static bool text_DecodeSegment(const dvbpsi_atsc_text_t *p_text, uint8_t i_compression,
+                               uint8_t i_mode, const uint8_t *p_data, size_t i_length,
+                               text_writer_t *p_writer)
+{
+    /* Unicode page modes of A/65 table 6.42, mode 0xff ("not applicable")
+     * is used with the Annex C compression and means ISO 8859-1. */
+    bool b_page = i_mode <= 0x33 || i_mode == 0xff;
+    uint32_t i_page = i_mode <= 0x33 ? (uint32_t)i_mode << 8 : 0;
+
+    switch (i_compression)
+    {
+    case DVBPSI_ATSC_TEXT_UNCOMPRESSED:
+        if (b_page)
+        {
+            for (size_t i = 0; i < i_length && !p_writer->b_full; i++)
+                text_Put(p_writer, i_page | p_data[i]);
+            return true;
+        }
+        if (i_mode == 0x3f)
+        {
+            /* UTF-16, big endian */
+            for (size_t i = 0; i + 1 < i_length && !p_writer->b_full; i += 2)
+            {
+                uint32_t i_code = ((uint32_t)p_data[i] << 8) | p_data[i + 1];
+                if (i_code >= 0xd800 && i_code < 0xdc00 && i + 3 < i_length)
+                {
+                    uint32_t i_low = ((uint32_t)p_data[i + 2] << 8) | p_data[i + 3];
+                    if (i_low >= 0xdc00 && i_low < 0xe000)
+                    {
+                        i_code = 0x10000 + ((i_code - 0xd800) << 10) + (i_low - 0xdc00);
+                        i += 2;
+                    }
+                }
+                text_Put(p_writer, i_code);
+            }
+            return (i_length & 1) == 0;
+        }
+        return false;
+
+    case DVBPSI_ATSC_TEXT_HUFFMAN_TITLE:
+    case DVBPSI_ATSC_TEXT_HUFFMAN_DESCRIPTION:
+    {
+        const text_huffman_t *p_huffman = p_text->pp_huffman[i_compression - 1];
+        if (p_huffman == NULL || !b_page)
+            return false;
+        return text_DecodeHuffman(p_huffman, p_data, i_length, i_page, p_writer);
+    }
+
+    default:
+        return false;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_new
+ *****************************************************************************/
+dvbpsi_atsc_text_t *dvbpsi_atsc_text_new(void)
+{
+    return (dvbpsi_atsc_text_t *)calloc(1, sizeof(dvbpsi_atsc_text_t));
+}
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_delete
+ *****************************************************************************/
+void dvbpsi_atsc_text_delete(dvbpsi_atsc_text_t *p_text)
+{
+    if (p_text == NULL)
+        return;
+
+    huffman_Delete(p_text->pp_huffman[0]);
+    huffman_Delete(p_text->pp_huffman[1]);
+    free(p_text);
+}
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_set_huffman
+ *****************************************************************************/
+bool dvbpsi_atsc_text_set_huffman(dvbpsi_atsc_text_t *p_text, uint8_t i_compression_type,
+                                  const uint8_t *p_tree, size_t i_size)
+{
+    assert(p_text);
+
+    if (i_compression_type != DVBPSI_ATSC_TEXT_HUFFMAN_TITLE &&
+        i_compression_type != DVBPSI_ATSC_TEXT_HUFFMAN_DESCRIPTION)
+        return false;
+
+    text_huffman_t *p_huffman = NULL;
+    if (p_tree)
+    {
+        p_huffman = huffman_New(p_tree, i_size);
+        if (p_huffman == NULL)
+            return false;
+    }
+
+    huffman_Delete(p_text->pp_huffman[i_compression_type - 1]);
+    p_text->pp_huffman[i_compression_type - 1] = p_huffman;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_decode
+ *****************************************************************************/
+int dvbpsi_atsc_text_decode(const dvbpsi_atsc_text_t *p_text,
+                            const uint8_t *p_data, size_t i_length,
+                            dvbpsi_atsc_string_t *p_strings, unsigned int i_max_strings,
+                            char *p_buffer, size_t i_size)
+{
+    assert(p_text);
+
+    if (i_length < 1)
+        return -1;
+
+    const uint8_t *p_end = p_data + i_length;
+    unsigned int i_number_strings = *p_data++;
+    unsigned int i_decoded = 0;
+    size_t i_used = 0;
+
+    for (unsigned int i_string = 0; i_string < i_number_strings; i_string++)
+    {
+        if (p_end - p_data < 4)
+            return -1;
+
+        dvbpsi_atsc_string_t *p_string = NULL;
+        text_writer_t writer = { NULL, 0, 0, true };
+
+        if (i_decoded < i_max_strings)
+        {
+            p_string = &p_strings[i_decoded++];
+            memcpy(p_string->i_iso_639_code, p_data, 3);
+            p_string->b_complete = true;
+
+            writer.p_buffer = p_buffer + i_used;
+            writer.i_size = i_size - i_used;
+            writer.b_full = false;
+        }
+
+        unsigned int i_number_segments = p_data[3];
+        p_data += 4;
+
+        for (unsigned int i_segment = 0; i_segment < i_number_segments; i_segment++)
+        {
+            if (p_end - p_data < 3 || p_end - p_data - 3 < p_data[2])
+                return -1;
+
+            uint8_t i_compression = p_data[0];
+            uint8_t i_mode = p_data[1];
+            uint8_t i_bytes = p_data[2];
+            p_data += 3;
+
+            if (p_string &&
+                !text_DecodeSegment(p_text, i_compression, i_mode, p_data, i_bytes, &writer))
+                p_string->b_complete = false;
+
+            p_data += i_bytes;
+        }
+
+        if (p_string)
+        {
+            if (writer.i_size > 0)
+            {
+                writer.p_buffer[writer.i_length] = '\0';
+                p_string->psz_text = writer.p_buffer;
+                i_used += writer.i_length + 1;
+            }
+            else
+                p_string->psz_text = "";
+            p_string->i_length = writer.i_length;
+            if (writer.b_full)
+                p_string->b_complete = false;
+        }
+    }
+
+    return i_decoded;
+}
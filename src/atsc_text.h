@@ -0,0 +1,169 @@
+/*****************************************************************************
+ * atsc_text.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <atsc_text.h>
+ * \brief Application interface for the ATSC multiple_string_structure decoder.
+ *
+ * EIT titles, ETT messages and the extended channel name descriptor carry
+ * their text as a multiple_string_structure (ATSC document A/65, section
+ * 6.10). The decoder converts each string of the structure to UTF-8.
+ * Uncompressed segments are supported in the Unicode page modes (0x00 to
+ * 0x33) and in the UTF-16 mode (0x3F). Segments compressed with the Huffman
+ * codes of A/65 Annex C are decompressed with precomputed lookup tables that
+ * decode up to 8 bits per step.
+ *
+ * The Annex C decode trees are not part of the library, no copy checked
+ * against the published A/65 tables is available to the project and trees
+ * that differ by a single node would silently garble every compressed
+ * string. Until such a copy is imported, compressed segments are skipped
+ * unless the application loads the trees with
+ * dvbpsi_atsc_text_set_huffman(), in the layout of A/65
+ * tables C.5 (titles) and C.7 (descriptions), that is 128 big-endian 16 bit
+ * offsets to the tree of each prior symbol followed by the trees, each node
+ * being a pair of bytes for the bits 0 and 1 that hold either the index of
+ * the child node or 0x80 | character for a leaf.
+ */
+
+#ifndef _DVBPSI_ATSC_TEXT_H_
+#define _DVBPSI_ATSC_TEXT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Uncompressed segment */
+#define DVBPSI_ATSC_TEXT_UNCOMPRESSED   0x00
+/*! Segment compressed with the A/65 Annex C title tables */
+#define DVBPSI_ATSC_TEXT_HUFFMAN_TITLE  0x01
+/*! Segment compressed with the A/65 Annex C description tables */
+#define DVBPSI_ATSC_TEXT_HUFFMAN_DESCRIPTION 0x02
+
+/*****************************************************************************
+ * dvbpsi_atsc_string_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_atsc_string_s
+ * \brief One decoded string of a multiple_string_structure.
+ */
+/*!
+ * \typedef struct dvbpsi_atsc_string_s dvbpsi_atsc_string_t
+ * \brief dvbpsi_atsc_string_t type definition.
+ */
+typedef struct dvbpsi_atsc_string_s
+{
+    uint8_t     i_iso_639_code[3];  /*!< ISO 639 language code */
+    const char *psz_text;           /*!< NUL terminated UTF-8 text, stored in
+                                         the buffer given to the decoder */
+    size_t      i_length;           /*!< length of psz_text in bytes */
+    bool        b_complete;         /*!< false if a segment could not be
+                                         decoded or the buffer was too small */
+} dvbpsi_atsc_string_t;
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_atsc_text_s dvbpsi_atsc_text_t
+ * \brief Opaque multiple_string_structure decoder handle.
+ */
+typedef struct dvbpsi_atsc_text_s dvbpsi_atsc_text_t;
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_atsc_text_t *dvbpsi_atsc_text_new(void)
+ * \brief Create a multiple_string_structure decoder without Huffman tables.
+ * \return pointer to the decoder, NULL on error.
+ */
+dvbpsi_atsc_text_t *dvbpsi_atsc_text_new(void);
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_atsc_text_delete(dvbpsi_atsc_text_t *p_text)
+ * \brief Destroy a multiple_string_structure decoder.
+ * \param p_text pointer to the decoder
+ * \return nothing.
+ */
+void dvbpsi_atsc_text_delete(dvbpsi_atsc_text_t *p_text);
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_set_huffman
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_atsc_text_set_huffman(dvbpsi_atsc_text_t *p_text,
+                        uint8_t i_compression_type, const uint8_t *p_tree,
+                        size_t i_size)
+ * \brief Load the Annex C decode trees of a compression type.
+ * \param p_text pointer to the decoder
+ * \param i_compression_type DVBPSI_ATSC_TEXT_HUFFMAN_TITLE or
+ * DVBPSI_ATSC_TEXT_HUFFMAN_DESCRIPTION
+ * \param p_tree offset table followed by the decode trees, NULL to unload
+ * \param i_size size of p_tree in bytes
+ * \return true on success, false if the trees are malformed or on
+ * allocation error, in which case the previous trees are kept.
+ *
+ * The lookup tables are built once here, p_tree is not referenced
+ * afterwards.
+ */
+bool dvbpsi_atsc_text_set_huffman(dvbpsi_atsc_text_t *p_text, uint8_t i_compression_type,
+                                  const uint8_t *p_tree, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_atsc_text_decode
+ *****************************************************************************/
+/*!
+ * \fn int dvbpsi_atsc_text_decode(const dvbpsi_atsc_text_t *p_text,
+                        const uint8_t *p_data, size_t i_length,
+                        dvbpsi_atsc_string_t *p_strings, unsigned int i_max_strings,
+                        char *p_buffer, size_t i_size)
+ * \brief Decode a multiple_string_structure to UTF-8.
+ * \param p_text pointer to the decoder
+ * \param p_data multiple_string_structure, for example the i_title field of
+ * an EIT event, the p_etm_data field of an ETT or the i_long_channel_name
+ * field of an extended channel name descriptor
+ * \param i_length length of p_data
+ * \param p_strings array receiving the strings
+ * \param i_max_strings size of p_strings, further strings are ignored
+ * \param p_buffer buffer receiving the text of all strings
+ * \param i_size size of p_buffer
+ * \return number of strings stored in p_strings, -1 if the structure is
+ * truncated or malformed.
+ *
+ * Segments with an unknown compression type or mode, or compressed with
+ * trees that were not loaded, are skipped and clear b_complete. Text not
+ * fitting in p_buffer is cut on a character boundary.
+ */
+int dvbpsi_atsc_text_decode(const dvbpsi_atsc_text_t *p_text,
+                            const uint8_t *p_data, size_t i_length,
+                            dvbpsi_atsc_string_t *p_strings, unsigned int i_max_strings,
+                            char *p_buffer, size_t i_size);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of atsc_text.h"
+#endif
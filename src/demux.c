@@ -119,10 +119,15 @@ void dvbpsi_Demux(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section)
                                          p_section->i_extension);
     }
 
+    DVBPSI_TRACE3(demux__dispatch, p_dvbpsi, p_section->i_table_id,
+                  p_section->i_extension);
+
     if (p_subdec)
         p_subdec->pf_gather(p_dvbpsi, p_subdec->p_decoder, p_section);
     else
         dvbpsi_DeletePSISections(p_section);
+
+    DVBPSI_TRACE2(demux__return, p_dvbpsi, p_subdec != NULL);
 }
 
 /*****************************************************************************
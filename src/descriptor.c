@@ -41,6 +41,40 @@
 #include "dvbpsi.h"
 #include "descriptor.h"
 
+#define INTERN_MIN_BUCKETS  256     /* power of 2 */
+
+/*****************************************************************************
+ * dvbpsi_interned_descriptor_s
+ *****************************************************************************
+ * Shared payload and decoded form of identical descriptors.
+ *****************************************************************************/
+struct dvbpsi_interned_descriptor_s
+{
+    struct dvbpsi_interned_descriptor_s    *p_next_hash;
+    dvbpsi_descriptor_intern_t             *p_intern;   /* NULL once the table
+                                                           is deleted */
+    uint32_t                                i_hash;
+    unsigned int                            i_refcount;
+    void                                   *p_decoded;
+
+    uint8_t                                 i_tag;
+    uint8_t                                 i_length;
+    uint8_t                                 p_data[];
+};
+
+typedef struct dvbpsi_interned_descriptor_s interned_descriptor_t;
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_s
+ *****************************************************************************/
+struct dvbpsi_descriptor_intern_s
+{
+    unsigned int            i_entries;
+    unsigned int            i_references;
+    unsigned int            i_buckets;      /* power of 2 */
+    interned_descriptor_t **pp_buckets;
+};
+
 /*****************************************************************************
  * dvbpsi_IsDescriptor
  *****************************************************************************
@@ -58,9 +92,36 @@ static inline bool dvbpsi_IsDescriptor(dvbpsi_descriptor_t *p_descriptor, const
  *****************************************************************************/
 bool dvbpsi_IsDescriptorDecoded(dvbpsi_descriptor_t *p_descriptor)
 {
+    interned_descriptor_t *p_interned = p_descriptor->p_interned;
+
+    /* Share the decoded form of interned descriptors, a decoded form stored
+     * without dvbpsi_SetDescriptorDecoded() is published here */
+    if (p_interned)
+    {
+        if (p_descriptor->p_decoded == NULL)
+            p_descriptor->p_decoded = p_interned->p_decoded;
+        else if (p_interned->p_decoded == NULL)
+            p_interned->p_decoded = p_descriptor->p_decoded;
+    }
+
     return (p_descriptor->p_decoded != NULL);
 }
 
+/*****************************************************************************
+ * dvbpsi_SetDescriptorDecoded
+ *****************************************************************************
+ * Store the decoded form, interned descriptors publish it at once to the
+ * other copies of their payload.
+ *****************************************************************************/
+void dvbpsi_SetDescriptorDecoded(dvbpsi_descriptor_t *p_descriptor, void *p_decoded)
+{
+    interned_descriptor_t *p_interned = p_descriptor->p_interned;
+
+    p_descriptor->p_decoded = p_decoded;
+    if (p_interned && p_interned->p_decoded == NULL)
+        p_interned->p_decoded = p_decoded;
+}
+
 /*****************************************************************************
  * dvbpsi_CanDescodeAsDescriptor
  *****************************************************************************
@@ -83,7 +144,7 @@ bool dvbpsi_CanDecodeAsDescriptor(dvbpsi_descriptor_t *p_descriptor, const uint8
  * Creation of a new dvbpsi_descriptor_t structure.
  *****************************************************************************/
 dvbpsi_descriptor_t* dvbpsi_NewDescriptor(uint8_t i_tag, uint8_t i_length,
-                                          uint8_t* p_data)
+                                          const uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor
                 = (dvbpsi_descriptor_t*)malloc(sizeof(dvbpsi_descriptor_t));
@@ -100,6 +161,7 @@ dvbpsi_descriptor_t* dvbpsi_NewDescriptor(uint8_t i_tag, uint8_t i_length,
             memcpy(p_descriptor->p_data, p_data, i_length);
         p_descriptor->p_decoded = NULL;
         p_descriptor->p_next = NULL;
+        p_descriptor->p_interned = NULL;
     }
     else
     {
@@ -132,6 +194,223 @@ dvbpsi_descriptor_t *dvbpsi_AddDescriptor(dvbpsi_descriptor_t *p_list,
     return p_list;
 }
 
+/*****************************************************************************
+ * intern_Hash
+ *****************************************************************************
+ * FNV-1a of the tag, length and payload.
+ *****************************************************************************/
+static uint32_t intern_Hash(uint8_t i_tag, uint8_t i_length, const uint8_t *p_data)
+{
+    uint32_t i_hash = UINT32_C(2166136261);
+    i_hash = (i_hash ^ i_tag) * UINT32_C(16777619);
+    i_hash = (i_hash ^ i_length) * UINT32_C(16777619);
+    for (unsigned int i = 0; i < i_length; i++)
+        i_hash = (i_hash ^ p_data[i]) * UINT32_C(16777619);
+    return i_hash;
+}
+
+/*****************************************************************************
+ * intern_Unlink
+ *****************************************************************************
+ * Remove an entry from the hash table of its interning table.
+ *****************************************************************************/
+static void intern_Unlink(interned_descriptor_t *p_interned)
+{
+    dvbpsi_descriptor_intern_t *p_intern = p_interned->p_intern;
+    interned_descriptor_t **pp = &p_intern->pp_buckets[p_interned->i_hash &
+                                                       (p_intern->i_buckets - 1)];
+    while (*pp != p_interned)
+        pp = &(*pp)->p_next_hash;
+    *pp = p_interned->p_next_hash;
+    p_intern->i_entries--;
+}
+
+/*****************************************************************************
+ * intern_Release
+ *****************************************************************************
+ * Drop the reference of an interned descriptor to its shared storage.
+ *****************************************************************************/
+static void intern_Release(dvbpsi_descriptor_t *p_descriptor)
+{
+    interned_descriptor_t *p_interned = p_descriptor->p_interned;
+
+    /* Decoded after interning, without being checked again */
+    if (p_descriptor->p_decoded && p_descriptor->p_decoded != p_interned->p_decoded)
+    {
+        if (p_interned->p_decoded == NULL && p_interned->i_refcount > 1)
+            p_interned->p_decoded = p_descriptor->p_decoded;
+        else
+            free(p_descriptor->p_decoded);
+    }
+
+    if (p_interned->p_intern)
+        p_interned->p_intern->i_references--;
+
+    if (--p_interned->i_refcount > 0)
+        return;
+
+    if (p_interned->p_intern)
+        intern_Unlink(p_interned);
+    free(p_interned->p_decoded);
+    free(p_interned);
+}
+
+/*****************************************************************************
+ * intern_Grow
+ *****************************************************************************
+ * Double the number of buckets, keep the table as is on allocation error.
+ *****************************************************************************/
+static void intern_Grow(dvbpsi_descriptor_intern_t *p_intern)
+{
+    unsigned int i_buckets = 2 * p_intern->i_buckets;
+    interned_descriptor_t **pp_buckets = (interned_descriptor_t **)
+                                         calloc(i_buckets, sizeof(interned_descriptor_t *));
+    if (pp_buckets == NULL)
+        return;
+
+    for (unsigned int i = 0; i < p_intern->i_buckets; i++)
+    {
+        interned_descriptor_t *p_interned = p_intern->pp_buckets[i];
+        while (p_interned)
+        {
+            interned_descriptor_t *p_next = p_interned->p_next_hash;
+            interned_descriptor_t **pp = &pp_buckets[p_interned->i_hash & (i_buckets - 1)];
+            p_interned->p_next_hash = *pp;
+            *pp = p_interned;
+            p_interned = p_next;
+        }
+    }
+
+    free(p_intern->pp_buckets);
+    p_intern->pp_buckets = pp_buckets;
+    p_intern->i_buckets = i_buckets;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_new
+ *****************************************************************************/
+dvbpsi_descriptor_intern_t *dvbpsi_descriptor_intern_new(void)
+{
+    dvbpsi_descriptor_intern_t *p_intern = (dvbpsi_descriptor_intern_t *)
+                                           calloc(1, sizeof(dvbpsi_descriptor_intern_t));
+    if (p_intern == NULL)
+        return NULL;
+
+    p_intern->i_buckets = INTERN_MIN_BUCKETS;
+    p_intern->pp_buckets = (interned_descriptor_t **)
+                           calloc(p_intern->i_buckets, sizeof(interned_descriptor_t *));
+    if (p_intern->pp_buckets == NULL)
+    {
+        free(p_intern);
+        return NULL;
+    }
+    return p_intern;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_delete
+ *****************************************************************************/
+void dvbpsi_descriptor_intern_delete(dvbpsi_descriptor_intern_t *p_intern)
+{
+    if (p_intern == NULL)
+        return;
+
+    /* The entries belong to their descriptors from now on */
+    for (unsigned int i = 0; i < p_intern->i_buckets; i++)
+    {
+        for (interned_descriptor_t *p_interned = p_intern->pp_buckets[i];
+             p_interned != NULL; p_interned = p_interned->p_next_hash)
+            p_interned->p_intern = NULL;
+    }
+
+    free(p_intern->pp_buckets);
+    free(p_intern);
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_list
+ *****************************************************************************/
+unsigned int dvbpsi_descriptor_intern_list(dvbpsi_descriptor_intern_t *p_intern,
+                                           dvbpsi_descriptor_t *p_list)
+{
+    unsigned int i_shared = 0;
+
+    assert(p_intern);
+
+    for (dvbpsi_descriptor_t *p_descriptor = p_list; p_descriptor != NULL;
+         p_descriptor = p_descriptor->p_next)
+    {
+        if (p_descriptor->p_interned || p_descriptor->p_data == NULL)
+            continue;
+
+        uint32_t i_hash = intern_Hash(p_descriptor->i_tag, p_descriptor->i_length,
+                                      p_descriptor->p_data);
+        interned_descriptor_t **pp_bucket = &p_intern->pp_buckets[i_hash &
+                                                                   (p_intern->i_buckets - 1)];
+        interned_descriptor_t *p_interned = *pp_bucket;
+        while (p_interned &&
+               (p_interned->i_hash != i_hash || p_interned->i_tag != p_descriptor->i_tag ||
+                p_interned->i_length != p_descriptor->i_length ||
+                memcmp(p_interned->p_data, p_descriptor->p_data, p_descriptor->i_length)))
+            p_interned = p_interned->p_next_hash;
+
+        if (p_interned)
+            i_shared++;
+        else
+        {
+            p_interned = (interned_descriptor_t *)malloc(sizeof(interned_descriptor_t) +
+                                                         p_descriptor->i_length);
+            if (p_interned == NULL)
+                continue;
+
+            p_interned->p_intern = p_intern;
+            p_interned->i_hash = i_hash;
+            p_interned->i_refcount = 0;
+            p_interned->p_decoded = NULL;
+            p_interned->i_tag = p_descriptor->i_tag;
+            p_interned->i_length = p_descriptor->i_length;
+            memcpy(p_interned->p_data, p_descriptor->p_data, p_descriptor->i_length);
+            p_interned->p_next_hash = *pp_bucket;
+            *pp_bucket = p_interned;
+
+            if (++p_intern->i_entries > p_intern->i_buckets)
+                intern_Grow(p_intern);
+        }
+
+        free(p_descriptor->p_data);
+        p_descriptor->p_data = p_interned->p_data;
+
+        if (p_descriptor->p_decoded == NULL)
+            p_descriptor->p_decoded = p_interned->p_decoded;
+        else if (p_interned->p_decoded == NULL)
+            p_interned->p_decoded = p_descriptor->p_decoded;
+        else if (p_descriptor->p_decoded != p_interned->p_decoded)
+        {
+            free(p_descriptor->p_decoded);
+            p_descriptor->p_decoded = p_interned->p_decoded;
+        }
+
+        p_interned->i_refcount++;
+        p_intern->i_references++;
+        p_descriptor->p_interned = p_interned;
+    }
+
+    return i_shared;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_count
+ *****************************************************************************/
+unsigned int dvbpsi_descriptor_intern_count(const dvbpsi_descriptor_intern_t *p_intern,
+                                            unsigned int *pi_references)
+{
+    assert(p_intern);
+
+    if (pi_references)
+        *pi_references = p_intern->i_references;
+    return p_intern->i_entries;
+}
+
 /*****************************************************************************
  * dvbpsi_DeleteDescriptors
  *****************************************************************************
@@ -143,11 +422,16 @@ void dvbpsi_DeleteDescriptors(dvbpsi_descriptor_t* p_descriptor)
     {
         dvbpsi_descriptor_t* p_next = p_descriptor->p_next;
 
-        if (p_descriptor->p_data != NULL)
-            free(p_descriptor->p_data);
+        if (p_descriptor->p_interned != NULL)
+            intern_Release(p_descriptor);
+        else
+        {
+            if (p_descriptor->p_data != NULL)
+                free(p_descriptor->p_data);
 
-        if (p_descriptor->p_decoded != NULL)
-            free(p_descriptor->p_decoded);
+            if (p_descriptor->p_decoded != NULL)
+                free(p_descriptor->p_decoded);
+        }
 
         free(p_descriptor);
         p_descriptor = p_next;
@@ -169,3 +453,43 @@ void *dvbpsi_DuplicateDecodedDescriptor(void *p_decoded, ssize_t i_size)
         memcpy(p_duplicate, p_decoded, i_size);
     return p_duplicate;
 }
+
+/*****************************************************************************
+ * dvbpsi_descriptor_iter_init
+ *****************************************************************************/
+void dvbpsi_descriptor_iter_init(dvbpsi_descriptor_iter_t *p_iter,
+                                 const uint8_t *p_start, const uint8_t *p_end)
+{
+    p_iter->i_tag = 0;
+    p_iter->i_length = 0;
+    p_iter->p_data = NULL;
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end > p_start ? p_end : p_start;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_iter_next
+ *****************************************************************************
+ * A descriptor exceeding the loop ends it, the cursor stays on it.
+ *****************************************************************************/
+bool dvbpsi_descriptor_iter_next(dvbpsi_descriptor_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+
+    if (p_iter->p_end - p_byte < 2 || p_iter->p_end - p_byte < 2 + p_byte[1])
+        return false;
+
+    p_iter->i_tag = p_byte[0];
+    p_iter->i_length = p_byte[1];
+    p_iter->p_data = p_byte + 2;
+    p_iter->p_next = p_byte + 2 + p_byte[1];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_iter_truncated
+ *****************************************************************************/
+bool dvbpsi_descriptor_iter_truncated(const dvbpsi_descriptor_iter_t *p_iter)
+{
+    return p_iter->p_next != p_iter->p_end;
+}
@@ -78,6 +78,10 @@ typedef uint8_t iso_639_language_code_t[3];
  * NOTE: It is mandatory to add a decoded descriptor to the 'p_decoded' member
  * of this struct. Failing to do so will result in memory leakage when
  * deleting descriptor with @see dvbpsi_DeleteDescriptor.
+ *
+ * The p_interned member was appended in libdvbpsi 2.0.0, which changed the
+ * size of the structure and the soname of the library. Descriptors that are
+ * not created by dvbpsi_NewDescriptor() must set it to NULL.
  */
 typedef struct dvbpsi_descriptor_s
 {
@@ -91,6 +95,11 @@ typedef struct dvbpsi_descriptor_s
 
   void *                        p_decoded;      /*!< decoded descriptor */
 
+  struct dvbpsi_interned_descriptor_s *p_interned; /*!< shared storage of an
+                                                     interned descriptor,
+                                                     private, NULL for a
+                                                     descriptor that is not
+                                                     interned */
 } dvbpsi_descriptor_t;
 
 /*****************************************************************************
@@ -99,7 +108,7 @@ typedef struct dvbpsi_descriptor_s
 /*!
  * \fn dvbpsi_descriptor_t* dvbpsi_NewDescriptor(uint8_t i_tag,
                                                  uint8_t i_length,
-                                                 uint8_t* p_data)
+                                                 const uint8_t* p_data)
  * \brief Creation of a new dvbpsi_descriptor_t structure.
  * \param i_tag descriptor's tag
  * \param i_length descriptor's length
@@ -107,7 +116,7 @@ typedef struct dvbpsi_descriptor_s
  * \return a pointer to the descriptor.
  */
 dvbpsi_descriptor_t* dvbpsi_NewDescriptor(uint8_t i_tag, uint8_t i_length,
-                                          uint8_t* p_data);
+                                          const uint8_t* p_data);
 
 
 /*****************************************************************************
@@ -159,6 +168,20 @@ bool dvbpsi_CanDecodeAsDescriptor(dvbpsi_descriptor_t *p_descriptor, const uint8
  */
 bool dvbpsi_IsDescriptorDecoded(dvbpsi_descriptor_t *p_descriptor);
 
+/*****************************************************************************
+ * dvbpsi_SetDescriptorDecoded
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_SetDescriptorDecoded(dvbpsi_descriptor_t *p_descriptor, void *p_decoded);
+ * \brief Store the decoded form of a descriptor. Decoders call it once the
+ * descriptor is decoded so that the decoded form of an interned descriptor
+ * is shared at once with the other descriptors of the same payload.
+ * \param p_descriptor pointer to descriptor allocated with @see dvbpsi_NewDescriptor
+ * \param p_decoded decoded form, owned by the descriptor afterwards
+ * \return nothing.
+ */
+void dvbpsi_SetDescriptorDecoded(dvbpsi_descriptor_t *p_descriptor, void *p_decoded);
+
 /*****************************************************************************
  * dvbpsi_DuplicateDecodedDescriptor
  *****************************************************************************/
@@ -171,6 +194,144 @@ bool dvbpsi_IsDescriptorDecoded(dvbpsi_descriptor_t *p_descriptor);
  */
 void *dvbpsi_DuplicateDecodedDescriptor(void *p_decoded, ssize_t i_size);
 
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_descriptor_intern_s dvbpsi_descriptor_intern_t
+ * \brief Opaque descriptor interning table handle.
+ *
+ * Identical descriptors (same tag, length and payload) interned in the same
+ * table share a single reference counted copy of their payload and of their
+ * decoded form. The payload of an interned descriptor must not be modified.
+ * Interned descriptors are deleted with dvbpsi_DeleteDescriptors() as usual,
+ * the shared copy is freed with its last reference, even after the table is
+ * deleted.
+ */
+typedef struct dvbpsi_descriptor_intern_s dvbpsi_descriptor_intern_t;
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_descriptor_intern_t *dvbpsi_descriptor_intern_new(void)
+ * \brief Create a descriptor interning table.
+ * \return pointer to the table, NULL on error.
+ */
+dvbpsi_descriptor_intern_t *dvbpsi_descriptor_intern_new(void);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_descriptor_intern_delete(dvbpsi_descriptor_intern_t *p_intern)
+ * \brief Delete a descriptor interning table. Descriptors interned in the
+ * table stay valid.
+ * \param p_intern pointer to the table
+ * \return nothing.
+ */
+void dvbpsi_descriptor_intern_delete(dvbpsi_descriptor_intern_t *p_intern);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_list
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_descriptor_intern_list(dvbpsi_descriptor_intern_t *p_intern,
+                                                  dvbpsi_descriptor_t *p_list)
+ * \brief Intern all descriptors of a list.
+ * \param p_intern pointer to the table
+ * \param p_list first descriptor of the list, for example the descriptors of
+ * an EIT event or an SDT service
+ * \return number of descriptors of the list that share their payload with
+ * a previously interned descriptor.
+ *
+ * The private payload of each descriptor is freed and replaced by the
+ * shared one. A descriptor already decoded gives its decoded form to the
+ * table if the table has none yet, otherwise it is replaced by the shared
+ * one. Descriptors are left untouched on allocation error.
+ */
+unsigned int dvbpsi_descriptor_intern_list(dvbpsi_descriptor_intern_t *p_intern,
+                                           dvbpsi_descriptor_t *p_list);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_intern_count
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_descriptor_intern_count(const dvbpsi_descriptor_intern_t *p_intern,
+                                                   unsigned int *pi_references)
+ * \brief Get the number of distinct descriptors of a table.
+ * \param p_intern pointer to the table
+ * \param pi_references if not NULL, set to the number of descriptors
+ * sharing them
+ * \return number of distinct descriptors.
+ */
+unsigned int dvbpsi_descriptor_intern_count(const dvbpsi_descriptor_intern_t *p_intern,
+                                            unsigned int *pi_references);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_descriptor_iter_s
+ * \brief Cursor over a descriptor loop of a raw section.
+ *
+ * The cursors of the tables, such as dvbpsi_pmt_es_iter_t, give the
+ * descriptor loops of their entries as descriptor cursors. Nothing is
+ * allocated nor copied, the cursor points into the section.
+ */
+/*!
+ * \typedef struct dvbpsi_descriptor_iter_s dvbpsi_descriptor_iter_t
+ * \brief dvbpsi_descriptor_iter_t type definition.
+ */
+typedef struct dvbpsi_descriptor_iter_s
+{
+  uint8_t                       i_tag;          /*!< descriptor_tag */
+  uint8_t                       i_length;       /*!< descriptor_length */
+  const uint8_t *               p_data;         /*!< content */
+
+  const uint8_t *               p_next;         /*!< next descriptor, private */
+  const uint8_t *               p_end;          /*!< end of the loop, private */
+} dvbpsi_descriptor_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_descriptor_iter_init
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_descriptor_iter_init(dvbpsi_descriptor_iter_t *p_iter,
+                                        const uint8_t *p_start, const uint8_t *p_end)
+ * \brief Start a cursor over the descriptor loop from p_start to p_end.
+ * \param p_iter pointer to the cursor
+ * \param p_start first byte of the loop
+ * \param p_end first byte after the loop
+ * \return nothing.
+ */
+void dvbpsi_descriptor_iter_init(dvbpsi_descriptor_iter_t *p_iter,
+                                 const uint8_t *p_start, const uint8_t *p_end);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_descriptor_iter_next(dvbpsi_descriptor_iter_t *p_iter)
+ * \brief Move the cursor to the next descriptor of the loop.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on a descriptor, false at the end of the
+ * loop or on a descriptor exceeding the loop.
+ */
+bool dvbpsi_descriptor_iter_next(dvbpsi_descriptor_iter_t *p_iter);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_iter_truncated
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_descriptor_iter_truncated(const dvbpsi_descriptor_iter_t *p_iter)
+ * \brief Tell whether the loop ended on a descriptor exceeding it.
+ * \param p_iter pointer to a cursor whose last dvbpsi_descriptor_iter_next()
+ * returned false
+ * \return true if the loop is truncated.
+ */
+bool dvbpsi_descriptor_iter_truncated(const dvbpsi_descriptor_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
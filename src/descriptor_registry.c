@@ -0,0 +1,363 @@
+/*****************************************************************************
+ * descriptor_registry.c: tag dispatched descriptor decoding
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "descriptor.h"
+#include "descriptors/dr.h"
+#include "descriptor_registry.h"
+
+#define REGISTRY_PDS_EACEM          UINT32_C(0x00000028)
+#define REGISTRY_PDS_DTG            UINT32_C(0x0000233a)
+
+/*****************************************************************************
+ * registry_pds_t
+ *****************************************************************************
+ * Decoders registered for one private_data_specifier (DVB mode only).
+ *****************************************************************************/
+typedef struct registry_pds_s
+{
+    uint32_t                        i_pds;
+    dvbpsi_descriptor_decode_cb     pf_decode[256];
+    struct registry_pds_s          *p_next;
+} registry_pds_t;
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_s
+ *****************************************************************************/
+struct dvbpsi_descriptor_registry_s
+{
+    dvbpsi_descriptor_decode_cb     pf_any[2][256];     /* by mode, for any
+                                                           specifier */
+    registry_pds_t                 *p_first_pds;
+};
+
+/*****************************************************************************
+ * Built-in decoders
+ *****************************************************************************
+ * The dvbpsi_decode_*_dr() functions return typed pointers, they are called
+ * through wrappers of the registry decoder type.
+ *****************************************************************************/
+#define REGISTRY_DECODER(name)                                                  \
+static void *registry_Decode_##name(dvbpsi_descriptor_t *p_descriptor)          \
+{                                                                               \
+    return dvbpsi_decode_##name##_dr(p_descriptor);                             \
+}
+
+REGISTRY_DECODER(mpeg_vstream)
+REGISTRY_DECODER(mpeg_astream)
+REGISTRY_DECODER(mpeg_hierarchy)
+REGISTRY_DECODER(mpeg_registration)
+REGISTRY_DECODER(mpeg_ds_alignment)
+REGISTRY_DECODER(mpeg_target_bg_grid)
+REGISTRY_DECODER(mpeg_vwindow)
+REGISTRY_DECODER(mpeg_ca)
+REGISTRY_DECODER(mpeg_iso639)
+REGISTRY_DECODER(mpeg_system_clock)
+REGISTRY_DECODER(mpeg_mx_buff_utilization)
+REGISTRY_DECODER(mpeg_copyright)
+REGISTRY_DECODER(mpeg_max_bitrate)
+REGISTRY_DECODER(mpeg_private_data)
+REGISTRY_DECODER(mpeg_smoothing_buffer)
+REGISTRY_DECODER(mpeg_std)
+REGISTRY_DECODER(mpeg_ibp)
+REGISTRY_DECODER(mpeg_carousel_id)
+REGISTRY_DECODER(mpeg_association_tag)
+REGISTRY_DECODER(mpeg_mpeg4_video)
+REGISTRY_DECODER(mpeg_mpeg4_audio)
+REGISTRY_DECODER(mpeg_content_labelling)
+REGISTRY_DECODER(dvb_network_name)
+REGISTRY_DECODER(dvb_service_list)
+REGISTRY_DECODER(dvb_stuffing)
+REGISTRY_DECODER(dvb_sat_deliv_sys)
+REGISTRY_DECODER(dvb_cable_deliv_sys)
+REGISTRY_DECODER(dvb_vbi)
+REGISTRY_DECODER(dvb_bouquet_name)
+REGISTRY_DECODER(dvb_service)
+REGISTRY_DECODER(dvb_country_availability)
+REGISTRY_DECODER(dvb_linkage)
+REGISTRY_DECODER(dvb_nvod_ref)
+REGISTRY_DECODER(dvb_tshifted_service)
+REGISTRY_DECODER(dvb_short_event)
+REGISTRY_DECODER(dvb_extended_event)
+REGISTRY_DECODER(dvb_tshifted_ev)
+REGISTRY_DECODER(dvb_component)
+REGISTRY_DECODER(dvb_stream_identifier)
+REGISTRY_DECODER(dvb_ca_identifier)
+REGISTRY_DECODER(dvb_content)
+REGISTRY_DECODER(dvb_parental_rating)
+REGISTRY_DECODER(dvb_teletext)
+REGISTRY_DECODER(dvb_local_time_offset)
+REGISTRY_DECODER(dvb_subtitling)
+REGISTRY_DECODER(dvb_terr_deliv_sys)
+REGISTRY_DECODER(dvb_frequency_list)
+REGISTRY_DECODER(dvb_data_broadcast_id)
+REGISTRY_DECODER(dvb_PDC)
+REGISTRY_DECODER(dvb_default_authority)
+REGISTRY_DECODER(dvb_content_id)
+REGISTRY_DECODER(dvb_aac)
+REGISTRY_DECODER(atsc_ac3_audio)
+REGISTRY_DECODER(atsc_caption_service)
+REGISTRY_DECODER(atsc_extended_channel_name)
+REGISTRY_DECODER(atsc_service_location)
+REGISTRY_DECODER(eacem_lcn)
+REGISTRY_DECODER(scte_cuei)
+
+#undef REGISTRY_DECODER
+
+static const struct
+{
+    uint8_t                         i_tag;
+    dvbpsi_descriptor_decode_cb     pf_decode;
+} registry_mpeg[] =
+{
+    { 0x02, registry_Decode_mpeg_vstream },
+    { 0x03, registry_Decode_mpeg_astream },
+    { 0x04, registry_Decode_mpeg_hierarchy },
+    { 0x05, registry_Decode_mpeg_registration },
+    { 0x06, registry_Decode_mpeg_ds_alignment },
+    { 0x07, registry_Decode_mpeg_target_bg_grid },
+    { 0x08, registry_Decode_mpeg_vwindow },
+    { 0x09, registry_Decode_mpeg_ca },
+    { 0x0a, registry_Decode_mpeg_iso639 },
+    { 0x0b, registry_Decode_mpeg_system_clock },
+    { 0x0c, registry_Decode_mpeg_mx_buff_utilization },
+    { 0x0d, registry_Decode_mpeg_copyright },
+    { 0x0e, registry_Decode_mpeg_max_bitrate },
+    { 0x0f, registry_Decode_mpeg_private_data },
+    { 0x10, registry_Decode_mpeg_smoothing_buffer },
+    { 0x11, registry_Decode_mpeg_std },
+    { 0x12, registry_Decode_mpeg_ibp },
+    { 0x13, registry_Decode_mpeg_carousel_id },
+    { 0x14, registry_Decode_mpeg_association_tag },
+    { 0x1b, registry_Decode_mpeg_mpeg4_video },
+    { 0x1c, registry_Decode_mpeg_mpeg4_audio },
+    { 0x24, registry_Decode_mpeg_content_labelling },
+}, registry_dvb[] =
+{
+    { 0x40, registry_Decode_dvb_network_name },
+    { 0x41, registry_Decode_dvb_service_list },
+    { 0x42, registry_Decode_dvb_stuffing },
+    { 0x43, registry_Decode_dvb_sat_deliv_sys },
+    { 0x44, registry_Decode_dvb_cable_deliv_sys },
+    { 0x45, registry_Decode_dvb_vbi },
+    { 0x47, registry_Decode_dvb_bouquet_name },
+    { 0x48, registry_Decode_dvb_service },
+    { 0x49, registry_Decode_dvb_country_availability },
+    { 0x4a, registry_Decode_dvb_linkage },
+    { 0x4b, registry_Decode_dvb_nvod_ref },
+    { 0x4c, registry_Decode_dvb_tshifted_service },
+    { 0x4d, registry_Decode_dvb_short_event },
+    { 0x4e, registry_Decode_dvb_extended_event },
+    { 0x4f, registry_Decode_dvb_tshifted_ev },
+    { 0x50, registry_Decode_dvb_component },
+    { 0x52, registry_Decode_dvb_stream_identifier },
+    { 0x53, registry_Decode_dvb_ca_identifier },
+    { 0x54, registry_Decode_dvb_content },
+    { 0x55, registry_Decode_dvb_parental_rating },
+    { 0x56, registry_Decode_dvb_teletext },
+    { 0x58, registry_Decode_dvb_local_time_offset },
+    { 0x59, registry_Decode_dvb_subtitling },
+    { 0x5a, registry_Decode_dvb_terr_deliv_sys },
+    { 0x62, registry_Decode_dvb_frequency_list },
+    { 0x66, registry_Decode_dvb_data_broadcast_id },
+    { 0x69, registry_Decode_dvb_PDC },
+    { 0x73, registry_Decode_dvb_default_authority },
+    { 0x76, registry_Decode_dvb_content_id },
+    { 0x7c, registry_Decode_dvb_aac },
+}, registry_atsc[] =
+{
+    { 0x81, registry_Decode_atsc_ac3_audio },
+    { 0x86, registry_Decode_atsc_caption_service },
+    { 0x8a, registry_Decode_scte_cuei },
+    { 0xa0, registry_Decode_atsc_extended_channel_name },
+    { 0xa1, registry_Decode_atsc_service_location },
+};
+
+/*****************************************************************************
+ * registry_FindPds
+ *****************************************************************************/
+static registry_pds_t *registry_FindPds(const dvbpsi_descriptor_registry_t *p_registry,
+                                        uint32_t i_pds)
+{
+    registry_pds_t *p = p_registry->p_first_pds;
+    while (p && p->i_pds != i_pds)
+        p = p->p_next;
+    return p;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_new
+ *****************************************************************************/
+dvbpsi_descriptor_registry_t *dvbpsi_descriptor_registry_new(void)
+{
+    dvbpsi_descriptor_registry_t *p_registry = calloc(1, sizeof(dvbpsi_descriptor_registry_t));
+    if (!p_registry)
+        return NULL;
+
+    for (size_t i = 0; i < sizeof(registry_mpeg) / sizeof(registry_mpeg[0]); i++)
+    {
+        p_registry->pf_any[DVBPSI_DESCRIPTOR_DVB][registry_mpeg[i].i_tag] = registry_mpeg[i].pf_decode;
+        p_registry->pf_any[DVBPSI_DESCRIPTOR_ATSC][registry_mpeg[i].i_tag] = registry_mpeg[i].pf_decode;
+    }
+    for (size_t i = 0; i < sizeof(registry_dvb) / sizeof(registry_dvb[0]); i++)
+        p_registry->pf_any[DVBPSI_DESCRIPTOR_DVB][registry_dvb[i].i_tag] = registry_dvb[i].pf_decode;
+    for (size_t i = 0; i < sizeof(registry_atsc) / sizeof(registry_atsc[0]); i++)
+        p_registry->pf_any[DVBPSI_DESCRIPTOR_ATSC][registry_atsc[i].i_tag] = registry_atsc[i].pf_decode;
+
+    /* User defined DVB tags: the EACEM logical_channel_descriptor is shared
+     * by the EACEM and DTG specifiers, NorDig uses another layout for 0x83.
+     * The SCTE 35 cue_identifier_descriptor is found without specifier. */
+    if (!dvbpsi_descriptor_registry_add(p_registry, DVBPSI_DESCRIPTOR_DVB, REGISTRY_PDS_EACEM,
+                                        0x83, registry_Decode_eacem_lcn)
+     || !dvbpsi_descriptor_registry_add(p_registry, DVBPSI_DESCRIPTOR_DVB, REGISTRY_PDS_DTG,
+                                        0x83, registry_Decode_eacem_lcn)
+     || !dvbpsi_descriptor_registry_add(p_registry, DVBPSI_DESCRIPTOR_DVB, DVBPSI_PDS_NONE,
+                                        0x8a, registry_Decode_scte_cuei))
+    {
+        dvbpsi_descriptor_registry_delete(p_registry);
+        return NULL;
+    }
+    return p_registry;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_delete
+ *****************************************************************************/
+void dvbpsi_descriptor_registry_delete(dvbpsi_descriptor_registry_t *p_registry)
+{
+    if (!p_registry)
+        return;
+
+    registry_pds_t *p = p_registry->p_first_pds;
+    while (p)
+    {
+        registry_pds_t *p_next = p->p_next;
+        free(p);
+        p = p_next;
+    }
+    free(p_registry);
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_add
+ *****************************************************************************/
+bool dvbpsi_descriptor_registry_add(dvbpsi_descriptor_registry_t *p_registry,
+                                    dvbpsi_descriptor_mode_t mode, uint32_t i_pds,
+                                    uint8_t i_tag, dvbpsi_descriptor_decode_cb pf_decode)
+{
+    assert(p_registry);
+    assert(mode == DVBPSI_DESCRIPTOR_DVB || mode == DVBPSI_DESCRIPTOR_ATSC);
+
+    if (mode == DVBPSI_DESCRIPTOR_ATSC || i_pds == DVBPSI_PDS_ANY)
+    {
+        p_registry->pf_any[mode][i_tag] = pf_decode;
+        return true;
+    }
+
+    registry_pds_t *p_pds = registry_FindPds(p_registry, i_pds);
+    if (!p_pds)
+    {
+        if (!pf_decode)
+            return true;
+        p_pds = calloc(1, sizeof(registry_pds_t));
+        if (!p_pds)
+            return false;
+        p_pds->i_pds = i_pds;
+        p_pds->p_next = p_registry->p_first_pds;
+        p_registry->p_first_pds = p_pds;
+    }
+    p_pds->pf_decode[i_tag] = pf_decode;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_get
+ *****************************************************************************/
+dvbpsi_descriptor_decode_cb dvbpsi_descriptor_registry_get(
+                                        const dvbpsi_descriptor_registry_t *p_registry,
+                                        dvbpsi_descriptor_mode_t mode, uint32_t i_pds,
+                                        uint8_t i_tag)
+{
+    assert(p_registry);
+
+    if (mode == DVBPSI_DESCRIPTOR_DVB)
+    {
+        const registry_pds_t *p_pds = registry_FindPds(p_registry, i_pds);
+        if (p_pds && p_pds->pf_decode[i_tag])
+            return p_pds->pf_decode[i_tag];
+    }
+    return p_registry->pf_any[mode][i_tag];
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptors_decode
+ *****************************************************************************/
+unsigned int dvbpsi_descriptors_decode(const dvbpsi_descriptor_registry_t *p_registry,
+                                       dvbpsi_descriptor_mode_t mode,
+                                       dvbpsi_descriptor_t *p_first)
+{
+    assert(p_registry);
+
+    dvbpsi_descriptor_decode_cb const *pf_any = p_registry->pf_any[mode];
+    const registry_pds_t *p_pds = (mode == DVBPSI_DESCRIPTOR_DVB)
+                                ? registry_FindPds(p_registry, DVBPSI_PDS_NONE) : NULL;
+    unsigned int i_decoded = 0;
+
+    for (dvbpsi_descriptor_t *p = p_first; p; p = p->p_next)
+    {
+        /* private_data_specifier_descriptor, valid up to the end of the loop */
+        if (p->i_tag == 0x5f && mode == DVBPSI_DESCRIPTOR_DVB && p->i_length >= 4)
+        {
+            uint32_t i_pds = (uint32_t)p->p_data[0] << 24 | (uint32_t)p->p_data[1] << 16
+                           | (uint32_t)p->p_data[2] << 8 | p->p_data[3];
+            p_pds = registry_FindPds(p_registry, i_pds);
+        }
+
+        dvbpsi_descriptor_decode_cb pf_decode = (p_pds && p_pds->pf_decode[p->i_tag])
+                                              ? p_pds->pf_decode[p->i_tag] : pf_any[p->i_tag];
+        if (pf_decode && pf_decode(p))
+        {
+            /* Decoders registered by the application may store p_decoded
+             * directly */
+            if (p->p_interned)
+                dvbpsi_IsDescriptorDecoded(p);
+            i_decoded++;
+        }
+    }
+    return i_decoded;
+}
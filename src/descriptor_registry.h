@@ -0,0 +1,190 @@
+/*****************************************************************************
+ * descriptor_registry.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <descriptor_registry.h>
+ * \brief Application interface for tag dispatched descriptor decoding.
+ *
+ * A registry maps descriptor tags to decoder functions, so that a whole
+ * descriptor loop is decoded in one call instead of a switch statement on
+ * the tags. A new registry knows every decoder of libdvbpsi, applications
+ * add decoders for their private descriptors or replace the built-in ones.
+ *
+ * The meaning of a tag depends on the context of the loop:
+ * - in DVB mode, tags 0x80 to 0xfe are interpreted according to the last
+ *   private_data_specifier_descriptor (0x5f) seen in the loop, for
+ *   instance 0x83 is the EACEM logical_channel_descriptor under the EACEM
+ *   and DTG specifiers only,
+ * - in ATSC mode, tags 0x80 to 0xfe are the ATSC descriptors (A/65) and
+ *   the DVB range 0x40 to 0x7f is not decoded.
+ *
+ * dvbpsi.h and descriptor.h must be included before this file.
+ */
+
+#ifndef _DVBPSI_DESCRIPTOR_REGISTRY_H_
+#define _DVBPSI_DESCRIPTOR_REGISTRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def DVBPSI_PDS_ANY
+ * \brief Registers a decoder whatever the private_data_specifier.
+ */
+#define DVBPSI_PDS_ANY      UINT32_C(0xffffffff)
+
+/*!
+ * \def DVBPSI_PDS_NONE
+ * \brief private_data_specifier of the descriptors preceding any
+ * private_data_specifier_descriptor in their loop.
+ */
+#define DVBPSI_PDS_NONE     UINT32_C(0x00000000)
+
+/*****************************************************************************
+ * dvbpsi_descriptor_mode_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_descriptor_mode
+ * \brief Standard defining the user private descriptor tags.
+ */
+/*!
+ * \typedef enum dvbpsi_descriptor_mode dvbpsi_descriptor_mode_t
+ * \brief dvbpsi_descriptor_mode_t type definition.
+ */
+typedef enum dvbpsi_descriptor_mode
+{
+    DVBPSI_DESCRIPTOR_DVB = 0,  /*!< ETSI EN 300 468 */
+    DVBPSI_DESCRIPTOR_ATSC,     /*!< ATSC A/65 */
+} dvbpsi_descriptor_mode_t;
+
+/*****************************************************************************
+ * dvbpsi_descriptor_decode_cb
+ *****************************************************************************/
+/*!
+ * \typedef void *(* dvbpsi_descriptor_decode_cb)(dvbpsi_descriptor_t *p_descriptor)
+ * \brief Descriptor decoder type definition.
+ *
+ * Like the dvbpsi_decode_*_dr() functions, a decoder stores the decoded
+ * descriptor in p_descriptor->p_decoded and returns it, or returns NULL
+ * when the descriptor is invalid.
+ */
+typedef void *(* dvbpsi_descriptor_decode_cb)(dvbpsi_descriptor_t *p_descriptor);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_descriptor_registry_s dvbpsi_descriptor_registry_t
+ * \brief Opaque descriptor registry handle.
+ */
+typedef struct dvbpsi_descriptor_registry_s dvbpsi_descriptor_registry_t;
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_descriptor_registry_t *dvbpsi_descriptor_registry_new(void)
+ * \brief Create a registry holding the decoders of libdvbpsi.
+ * \return pointer to the registry, NULL on error.
+ */
+dvbpsi_descriptor_registry_t *dvbpsi_descriptor_registry_new(void);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_descriptor_registry_delete(dvbpsi_descriptor_registry_t *p_registry)
+ * \brief Destroy a registry.
+ * \param p_registry pointer to the registry
+ * \return nothing.
+ */
+void dvbpsi_descriptor_registry_delete(dvbpsi_descriptor_registry_t *p_registry);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_add
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_descriptor_registry_add(dvbpsi_descriptor_registry_t *p_registry,
+                        dvbpsi_descriptor_mode_t mode, uint32_t i_pds, uint8_t i_tag,
+                        dvbpsi_descriptor_decode_cb pf_decode)
+ * \brief Register the decoder of a tag, replacing the previous one.
+ * \param p_registry pointer to the registry
+ * \param mode standard of the loops the decoder applies to
+ * \param i_pds private_data_specifier under which the decoder applies,
+ * DVBPSI_PDS_NONE before any specifier, DVBPSI_PDS_ANY for all of them.
+ * A decoder registered for a specifier takes precedence over the one
+ * registered for DVBPSI_PDS_ANY. Ignored in ATSC mode.
+ * \param i_tag descriptor_tag
+ * \param pf_decode decoder, NULL removes the registration
+ * \return false on memory allocation error.
+ */
+bool dvbpsi_descriptor_registry_add(dvbpsi_descriptor_registry_t *p_registry,
+                                    dvbpsi_descriptor_mode_t mode, uint32_t i_pds,
+                                    uint8_t i_tag, dvbpsi_descriptor_decode_cb pf_decode);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_registry_get
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_descriptor_decode_cb dvbpsi_descriptor_registry_get(
+                        const dvbpsi_descriptor_registry_t *p_registry,
+                        dvbpsi_descriptor_mode_t mode, uint32_t i_pds, uint8_t i_tag)
+ * \brief Get the decoder of a tag in a given context.
+ * \param p_registry pointer to the registry
+ * \param mode standard of the loop
+ * \param i_pds current private_data_specifier of the loop
+ * \param i_tag descriptor_tag
+ * \return the decoder, NULL if the tag has none in this context.
+ */
+dvbpsi_descriptor_decode_cb dvbpsi_descriptor_registry_get(
+                                        const dvbpsi_descriptor_registry_t *p_registry,
+                                        dvbpsi_descriptor_mode_t mode, uint32_t i_pds,
+                                        uint8_t i_tag);
+
+/*****************************************************************************
+ * dvbpsi_descriptors_decode
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_descriptors_decode(
+                        const dvbpsi_descriptor_registry_t *p_registry,
+                        dvbpsi_descriptor_mode_t mode, dvbpsi_descriptor_t *p_first)
+ * \brief Decode all descriptors of a loop.
+ * \param p_registry pointer to the registry
+ * \param mode standard of the table carrying the loop
+ * \param p_first first descriptor of the loop
+ * \return the number of decoded descriptors, including those that were
+ * already decoded.
+ *
+ * The decoded descriptors are found in their p_decoded member and are
+ * released with the loop by dvbpsi_DeleteDescriptors().
+ */
+unsigned int dvbpsi_descriptors_decode(const dvbpsi_descriptor_registry_t *p_registry,
+                                       dvbpsi_descriptor_mode_t mode,
+                                       dvbpsi_descriptor_t *p_first);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of descriptor_registry.h"
+#endif
@@ -63,7 +63,7 @@ dvbpsi_atsc_ac3_audio_dr_t *dvbpsi_decode_atsc_ac3_audio_dr(dvbpsi_descriptor_t
     if (!p_decoded)
         return NULL;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     p_decoded->i_sample_rate_code = 0x07 & (buf[0] >> 5);
     p_decoded->i_bsid             = 0x1f & buf[0];
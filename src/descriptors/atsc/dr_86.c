@@ -63,7 +63,7 @@ dvbpsi_atsc_caption_service_dr_t *dvbpsi_decode_atsc_caption_service_dr(dvbpsi_d
     if (!p_decoded)
         return NULL;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     p_decoded->i_number_of_services = 0x1f & buf[0];
     buf++;
@@ -51,7 +51,7 @@ dvbpsi_atsc_extended_channel_name_dr_t *dvbpsi_decode_atsc_extended_channel_name
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check length */
@@ -62,7 +62,7 @@ dvbpsi_atsc_extended_channel_name_dr_t *dvbpsi_decode_atsc_extended_channel_name
     if (!p_decoded)
         return NULL;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     p_decoded->i_long_channel_name_length = p_descriptor->i_length;
     memcpy(p_decoded->i_long_channel_name, p_descriptor->p_data, p_descriptor->i_length);
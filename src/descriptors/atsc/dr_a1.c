@@ -70,7 +70,7 @@ dvbpsi_decode_atsc_service_location_dr (dvbpsi_descriptor_t * p_descriptor)
 
     memset (p_decoded, 0, sizeof (dvbpsi_atsc_service_location_dr_t));
 
-    p_descriptor->p_decoded = (void *) p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     p_decoded->i_pcr_pid = ((uint16_t) (buf[0] & 0x1f) << 8) | buf[1];
     p_decoded->i_number_elements = buf[2];
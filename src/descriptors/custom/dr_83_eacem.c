@@ -52,7 +52,7 @@ dvbpsi_eacem_lcn_dr_t *dvbpsi_decode_eacem_lcn_dr(dvbpsi_descriptor_t *p_descrip
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check length */
@@ -79,7 +79,7 @@ dvbpsi_eacem_lcn_dr_t *dvbpsi_decode_eacem_lcn_dr(dvbpsi_descriptor_t *p_descrip
 
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -74,7 +74,7 @@ dvbpsi_scte_cuei_dr_t * dvbpsi_decode_scte_cuei_dr(dvbpsi_descriptor_t * p_descr
      */
     p_decoded->i_cue_stream_type = p_descriptor->p_data[0];
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -80,7 +80,7 @@ dvbpsi_dvb_sat_deliv_sys_dr_t * dvbpsi_decode_dvb_sat_deliv_sys_dr(
                                      | (uint32_t)((p_descriptor->p_data[10] >> 4) & 0x0f);
     p_decoded->i_fec_inner         =    p_descriptor->p_data[10] & 0x0f;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
   return p_decoded;
 }
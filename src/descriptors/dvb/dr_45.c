@@ -95,7 +95,7 @@ dvbpsi_dvb_vbi_dr_t * dvbpsi_decode_dvb_vbi_dr(
         }
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -71,7 +71,7 @@ dvbpsi_dvb_bouquet_name_dr_t * dvbpsi_decode_dvb_bouquet_name_dr(
                p_descriptor->p_data,
                p_decoded->i_name_length);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -65,7 +65,7 @@ dvbpsi_dvb_service_dr_t * dvbpsi_decode_dvb_service_dr(
     if (!p_decoded)
         return NULL;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     p_decoded->i_service_type = p_descriptor->p_data[0];
     p_decoded->i_service_provider_name_length = p_descriptor->p_data[1];
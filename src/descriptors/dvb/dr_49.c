@@ -52,7 +52,7 @@ dvbpsi_dvb_country_availability_dr_t* dvbpsi_decode_dvb_country_availability_dr(
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check the length */
@@ -78,7 +78,7 @@ dvbpsi_dvb_country_availability_dr_t* dvbpsi_decode_dvb_country_availability_dr(
     	p_decoded->code[i].iso_639_code[2] = p_descriptor->p_data[3+i*3];
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -53,7 +53,7 @@ dvbpsi_dvb_linkage_dr_t* dvbpsi_decode_dvb_linkage_dr(dvbpsi_descriptor_t * p_de
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check the length */
@@ -134,7 +134,7 @@ dvbpsi_dvb_linkage_dr_t* dvbpsi_decode_dvb_linkage_dr(dvbpsi_descriptor_t * p_de
         p_decoded->i_private_data_length = 246;
     memcpy(p_decoded->i_private_data, &p_descriptor->p_data[i], p_decoded->i_private_data_length);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -49,7 +49,7 @@ dvbpsi_dvb_nvod_ref_dr_t* dvbpsi_decode_dvb_nvod_ref_dr(dvbpsi_descriptor_t * p_
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check the length */
@@ -80,7 +80,7 @@ dvbpsi_dvb_nvod_ref_dr_t* dvbpsi_decode_dvb_nvod_ref_dr(dvbpsi_descriptor_t * p_
                                                       | p_descriptor->p_data[pos+5];
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -65,7 +65,7 @@ dvbpsi_dvb_tshifted_service_dr_t* dvbpsi_decode_dvb_tshifted_service_dr(dvbpsi_d
     p_decoded->i_ref_service_id = p_descriptor->p_data[0] << 8
                                 | p_descriptor->p_data[1];
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
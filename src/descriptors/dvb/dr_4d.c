@@ -66,7 +66,7 @@ dvbpsi_dvb_short_event_dr_t * dvbpsi_decode_dvb_short_event_dr(dvbpsi_descriptor
     return NULL;
 
   /* Don't decode twice */
-  if (p_descriptor->p_decoded)
+  if (dvbpsi_IsDescriptorDecoded(p_descriptor))
     return p_descriptor->p_decoded;
 
   /* Allocate memory */
@@ -83,7 +83,7 @@ dvbpsi_dvb_short_event_dr_t * dvbpsi_decode_dvb_short_event_dr(dvbpsi_descriptor
   if (i_len2 > 0)
       memcpy( p_decoded->i_text, &p_descriptor->p_data[4+i_len1+1], i_len2 );
 
-  p_descriptor->p_decoded = (void*)p_decoded;
+  dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
   return p_decoded;
 }
@@ -96,7 +96,7 @@ dvbpsi_dvb_extended_event_dr_t * dvbpsi_decode_dvb_extended_event_dr(dvbpsi_desc
                 &p_descriptor->p_data[5+i_len+1], p_decoded->i_text_length );
     p_decoded->i_text = &p_decoded->i_buffer[i_pos];
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -156,3 +156,196 @@ dvbpsi_descriptor_t * dvbpsi_gen_dvb_extended_event_dr(dvbpsi_dvb_extended_event
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * ExtendedEventSelection
+ *****************************************************************************
+ * Length of the character table selection starting an Annex A string.
+ *****************************************************************************/
+static size_t ExtendedEventSelection(const uint8_t *p_string, size_t i_length)
+{
+    if (i_length == 0 || p_string[0] >= 0x20)
+        return 0;
+    if (p_string[0] == 0x10)
+        return i_length < 3 ? i_length : 3;
+    if (p_string[0] == 0x1f)
+        return i_length < 2 ? i_length : 2;
+    return 1;
+}
+
+/*****************************************************************************
+ * ExtendedEventAppend
+ *****************************************************************************
+ * Copy the continuation of a string after its first i_string bytes, without
+ * its character table selection if it repeats the one of the string.
+ *****************************************************************************/
+static size_t ExtendedEventAppend(uint8_t *p_dst, const uint8_t *p_string, size_t i_string,
+                                  const uint8_t *p_src, size_t i_src)
+{
+    size_t i_selection = ExtendedEventSelection(p_string, i_string);
+
+    if (i_selection && i_src >= i_selection && !memcmp(p_src, p_string, i_selection))
+    {
+        p_src += i_selection;
+        i_src -= i_selection;
+    }
+
+    memcpy(p_dst, p_src, i_src);
+    return i_src;
+}
+
+/*****************************************************************************
+ * ExtendedEventCheck
+ *****************************************************************************
+ * Check the item loop and the text of a raw descriptor, return the number of
+ * items or -1 if the descriptor is malformed.
+ *****************************************************************************/
+static int ExtendedEventCheck(const dvbpsi_descriptor_t *p_descriptor)
+{
+    const uint8_t *p_data = p_descriptor->p_data;
+    const uint8_t *p_end = p_data + p_descriptor->i_length;
+    const uint8_t *p_items_end = p_data + 5 + p_data[4];
+    int i_items = 0;
+
+    if (p_items_end + 1 > p_end || p_items_end + 1 + p_items_end[0] > p_end)
+        return -1;
+
+    for (const uint8_t *p = p_data + 5; p < p_items_end; i_items++)
+    {
+        if (p + 1 + p[0] + 1 > p_items_end)
+            return -1;
+        p += 1 + p[0];
+        if (p + 1 + p[0] > p_items_end)
+            return -1;
+        p += 1 + p[0];
+    }
+
+    return i_items;
+}
+
+/*****************************************************************************
+ * dvbpsi_assemble_dvb_extended_event
+ *****************************************************************************/
+dvbpsi_dvb_extended_event_text_t *dvbpsi_assemble_dvb_extended_event(
+                                        dvbpsi_descriptor_t *p_first_descriptor,
+                                        const uint8_t *p_iso_639_code)
+{
+    const dvbpsi_descriptor_t *pp_fragments[16] = { NULL };
+    const uint8_t *p_language = p_iso_639_code;
+    uint8_t i_last_number = 0;
+    bool b_found = false;
+    int i_items = 0;
+    size_t i_items_size = 0, i_text_size = 0;
+
+    /* Pick the descriptors of the language, by descriptor_number */
+    for (const dvbpsi_descriptor_t *p_descriptor = p_first_descriptor;
+         p_descriptor != NULL; p_descriptor = p_descriptor->p_next)
+    {
+        if (p_descriptor->i_tag != 0x4e || p_descriptor->i_length < 6)
+            continue;
+        if (p_language && memcmp(&p_descriptor->p_data[1], p_language, 3))
+            continue;
+
+        uint8_t i_number = p_descriptor->p_data[0] >> 4;
+        if (pp_fragments[i_number])
+            continue;
+
+        int i_count = ExtendedEventCheck(p_descriptor);
+        if (i_count < 0)
+            continue;
+
+        if (p_language == NULL)
+            p_language = &p_descriptor->p_data[1];
+        if ((p_descriptor->p_data[0] & 0x0f) > i_last_number)
+            i_last_number = p_descriptor->p_data[0] & 0x0f;
+
+        b_found = true;
+        pp_fragments[i_number] = p_descriptor;
+        i_items += i_count;
+        i_items_size += p_descriptor->p_data[4];
+        i_text_size += p_descriptor->p_data[5 + p_descriptor->p_data[4]];
+    }
+
+    if (!b_found)
+        return NULL;
+
+    /* Structure, items, item strings and text in one block */
+    dvbpsi_dvb_extended_event_text_t *p_text = (dvbpsi_dvb_extended_event_text_t *)
+            malloc(sizeof(dvbpsi_dvb_extended_event_text_t) +
+                   i_items * sizeof(dvbpsi_dvb_extended_event_item_t) +
+                   i_items_size + i_text_size);
+    if (p_text == NULL)
+        return NULL;
+
+    memcpy(p_text->i_iso_639_code, p_language, 3);
+    p_text->b_complete = true;
+    p_text->i_item_count = 0;
+    p_text->p_items = (dvbpsi_dvb_extended_event_item_t *)(p_text + 1);
+    p_text->i_text_length = 0;
+
+    uint8_t *p_strings = (uint8_t *)(p_text->p_items + i_items);
+    p_text->p_text = p_strings + i_items_size;
+
+    for (int i_number = 0; i_number < 16; i_number++)
+    {
+        const dvbpsi_descriptor_t *p_descriptor = pp_fragments[i_number];
+        if (p_descriptor == NULL)
+        {
+            if (i_number <= i_last_number)
+                p_text->b_complete = false;
+            continue;
+        }
+
+        const uint8_t *p_data = p_descriptor->p_data;
+        const uint8_t *p_items_end = p_data + 5 + p_data[4];
+
+        for (const uint8_t *p = p_data + 5; p < p_items_end; )
+        {
+            const uint8_t *p_description = p + 1;
+            uint8_t i_description_length = p[0];
+            p += 1 + p[0];
+            const uint8_t *p_item = p + 1;
+            uint8_t i_item_length = p[0];
+            p += 1 + p[0];
+
+            if (i_description_length == 0 && p_text->i_item_count > 0)
+            {
+                /* Continuation of the previous item, whose item string is
+                 * the last one copied */
+                dvbpsi_dvb_extended_event_item_t *p_previous =
+                        &p_text->p_items[p_text->i_item_count - 1];
+                size_t i_copied = ExtendedEventAppend(p_strings, p_previous->p_item,
+                                                      p_previous->i_item_length,
+                                                      p_item, i_item_length);
+                p_previous->i_item_length += i_copied;
+                p_strings += i_copied;
+                continue;
+            }
+
+            dvbpsi_dvb_extended_event_item_t *p_new = &p_text->p_items[p_text->i_item_count++];
+            p_new->p_description = p_strings;
+            p_new->i_description_length = i_description_length;
+            memcpy(p_strings, p_description, i_description_length);
+            p_strings += i_description_length;
+            p_new->p_item = p_strings;
+            p_new->i_item_length = i_item_length;
+            memcpy(p_strings, p_item, i_item_length);
+            p_strings += i_item_length;
+        }
+
+        p_text->i_text_length +=
+                ExtendedEventAppend(p_text->p_text + p_text->i_text_length,
+                                    p_text->p_text, p_text->i_text_length,
+                                    p_items_end + 1, p_items_end[0]);
+    }
+
+    return p_text;
+}
+
+/*****************************************************************************
+ * dvbpsi_delete_dvb_extended_event_text
+ *****************************************************************************/
+void dvbpsi_delete_dvb_extended_event_text(dvbpsi_dvb_extended_event_text_t *p_text)
+{
+    free(p_text);
+}
@@ -102,6 +102,92 @@ dvbpsi_dvb_extended_event_dr_t* dvbpsi_decode_dvb_extended_event_dr(dvbpsi_descr
 dvbpsi_descriptor_t * dvbpsi_gen_dvb_extended_event_dr(dvbpsi_dvb_extended_event_dr_t * p_decoded,
                                                 bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_dvb_extended_event_item_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_dvb_extended_event_item_s
+ * \brief One item of an assembled extended event.
+ */
+/*!
+ * \typedef struct dvbpsi_dvb_extended_event_item_s dvbpsi_dvb_extended_event_item_t
+ * \brief dvbpsi_dvb_extended_event_item_t type definition.
+ */
+typedef struct dvbpsi_dvb_extended_event_item_s
+{
+  uint8_t *p_description;                   /*!< item description */
+  size_t   i_description_length;            /*!< length of p_description */
+  uint8_t *p_item;                          /*!< item */
+  size_t   i_item_length;                   /*!< length of p_item */
+} dvbpsi_dvb_extended_event_item_t;
+
+/*****************************************************************************
+ * dvbpsi_dvb_extended_event_text_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_dvb_extended_event_text_s
+ * \brief Extended event assembled from all its "extended event" descriptors.
+ *
+ * The structure, the items and the text are a single memory block. Texts
+ * are EN 300 468 Annex A strings: the character table selection of the
+ * first fragment is kept, the identical selections starting the following
+ * fragments are removed, so that each text can be given to
+ * dvbpsi_dvb_text_to_utf8() as a whole.
+ */
+/*!
+ * \typedef struct dvbpsi_dvb_extended_event_text_s dvbpsi_dvb_extended_event_text_t
+ * \brief dvbpsi_dvb_extended_event_text_t type definition.
+ */
+typedef struct dvbpsi_dvb_extended_event_text_s
+{
+  uint8_t i_iso_639_code[3];                /*!< 3 letter ISO 639 language code */
+  bool    b_complete;                       /*!< all descriptors from 0 to
+                                                 last_descriptor_number were
+                                                 found */
+
+  int     i_item_count;                     /*!< number of items */
+  dvbpsi_dvb_extended_event_item_t *p_items;/*!< items, in transmission order */
+
+  size_t  i_text_length;                    /*!< length of p_text */
+  uint8_t *p_text;                          /*!< concatenated text */
+} dvbpsi_dvb_extended_event_text_t;
+
+/*****************************************************************************
+ * dvbpsi_assemble_dvb_extended_event
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_dvb_extended_event_text_t * dvbpsi_assemble_dvb_extended_event(
+                        dvbpsi_descriptor_t *p_first_descriptor,
+                        const uint8_t *p_iso_639_code)
+ * \brief Assemble the "extended event" descriptors of an event.
+ * \param p_first_descriptor descriptor list of the event, descriptors with
+ * other tags are skipped
+ * \param p_iso_639_code 3 letter language code of the descriptors to
+ * assemble, NULL for the language of the first "extended event" descriptor
+ * \return a pointer to the assembled event, to delete with
+ * dvbpsi_delete_dvb_extended_event_text(), NULL if there is no descriptor
+ * of that language or on error.
+ *
+ * The descriptors are read in place, ordered by descriptor_number, and
+ * their items and texts copied once. An item whose description is empty
+ * continues the item of the previous descriptor.
+ */
+dvbpsi_dvb_extended_event_text_t *dvbpsi_assemble_dvb_extended_event(
+                                        dvbpsi_descriptor_t *p_first_descriptor,
+                                        const uint8_t *p_iso_639_code);
+
+/*****************************************************************************
+ * dvbpsi_delete_dvb_extended_event_text
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_delete_dvb_extended_event_text(
+                        dvbpsi_dvb_extended_event_text_t *p_text)
+ * \brief Delete an assembled extended event.
+ * \param p_text pointer to the assembled event
+ * \return nothing.
+ */
+void dvbpsi_delete_dvb_extended_event_text(dvbpsi_dvb_extended_event_text_t *p_text);
+
 #ifdef DVBPSI_USE_DEPRECATED_DR_API
 typedef dvbpsi_dvb_extended_event_dr_t dvbpsi_extended_event_dr_t ;
 
@@ -48,7 +48,7 @@ dvbpsi_dvb_tshifted_ev_dr_t* dvbpsi_decode_dvb_tshifted_ev_dr(dvbpsi_descriptor_
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check the length */
@@ -67,7 +67,7 @@ dvbpsi_dvb_tshifted_ev_dr_t* dvbpsi_decode_dvb_tshifted_ev_dr(dvbpsi_descriptor_
     p_decoded->i_ref_event_id = p_descriptor->p_data[2] << 8
                                 | p_descriptor->p_data[3];
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
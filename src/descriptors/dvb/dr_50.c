@@ -49,7 +49,7 @@ dvbpsi_dvb_component_dr_t* dvbpsi_decode_dvb_component_dr(dvbpsi_descriptor_t *
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check the length */
@@ -84,7 +84,7 @@ dvbpsi_dvb_component_dr_t* dvbpsi_decode_dvb_component_dr(dvbpsi_descriptor_t *
         p_decoded->i_text = NULL;
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -66,7 +66,7 @@ dvbpsi_dvb_stream_identifier_dr_t * dvbpsi_decode_dvb_stream_identifier_dr(
 
     p_decoded->i_component_tag = p_descriptor->p_data[0];
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
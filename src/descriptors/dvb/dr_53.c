@@ -74,7 +74,7 @@ dvbpsi_dvb_ca_identifier_dr_t * dvbpsi_decode_dvb_ca_identifier_dr(dvbpsi_descri
         p_decoded->p_system[i].i_ca_system_id |= p_descriptor->p_data[2 * i + 1];
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -74,7 +74,7 @@ dvbpsi_dvb_content_dr_t * dvbpsi_decode_dvb_content_dr(
         p_decoded->p_content[i].i_user_byte = p_descriptor->p_data[2 * i + 1];
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -80,7 +80,7 @@ dvbpsi_dvb_parental_rating_dr_t * dvbpsi_decode_dvb_parental_rating_dr(
         p_decoded->p_parental_rating[i].i_rating = p_descriptor->p_data[4 * i + 3];
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
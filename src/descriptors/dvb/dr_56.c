@@ -88,7 +88,7 @@ dvbpsi_dvb_teletext_dr_t * dvbpsi_decode_dvb_teletext_dr(
         p_decoded->p_pages[i].i_teletext_page_number = p_descriptor->p_data[5 * i + 4];
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -94,7 +94,7 @@ dvbpsi_dvb_local_time_offset_dr_t * dvbpsi_decode_dvb_local_time_offset_dr(
         p_current++;
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
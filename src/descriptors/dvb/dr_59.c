@@ -93,7 +93,7 @@ dvbpsi_dvb_subtitling_dr_t * dvbpsi_decode_dvb_subtitling_dr(
                 | p_descriptor->p_data[8 * i + 7];
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -78,7 +78,7 @@ dvbpsi_dvb_terr_deliv_sys_dr_t * dvbpsi_decode_dvb_terr_deliv_sys_dr(
     p_decoded->i_transmission_mode     =    (p_descriptor->p_data[6] >> 1) & 0x03;
     p_decoded->i_other_frequency_flag  =     p_descriptor->p_data[6]       & 0x01;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
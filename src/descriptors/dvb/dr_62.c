@@ -51,7 +51,7 @@ dvbpsi_dvb_frequency_list_dr_t *dvbpsi_decode_dvb_frequency_list_dr(dvbpsi_descr
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check length */
@@ -82,7 +82,7 @@ dvbpsi_dvb_frequency_list_dr_t *dvbpsi_decode_dvb_frequency_list_dr(dvbpsi_descr
 
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -68,7 +68,7 @@ dvbpsi_dvb_data_broadcast_id_dr_t *dvbpsi_decode_dvb_data_broadcast_id_dr(dvbpsi
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check length */
@@ -81,7 +81,7 @@ dvbpsi_dvb_data_broadcast_id_dr_t *dvbpsi_decode_dvb_data_broadcast_id_dr(dvbpsi
 
     p_decoded->i_data_broadcast_id = ((p_descriptor->p_data[0] & 0xff) << 8) | (p_descriptor->p_data[1] & 0xff);
     memcpy(p_decoded->p_id_selector, &p_descriptor->p_data[2], p_decoded->i_id_selector_len);
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
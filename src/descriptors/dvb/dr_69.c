@@ -72,7 +72,7 @@ dvbpsi_dvb_PDC_dr_t * dvbpsi_decode_dvb_PDC_dr(dvbpsi_descriptor_t * p_descripto
             (p_descriptor->p_data[2] >> 6);
     p_decoded->i_PDC[3] = p_descriptor->p_data[2] & 0x3f;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
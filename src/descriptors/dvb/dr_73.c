@@ -51,7 +51,7 @@ dvbpsi_dvb_default_authority_dr_t *dvbpsi_decode_dvb_default_authority_dr(dvbpsi
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     p_decoded = (dvbpsi_dvb_default_authority_dr_t*)malloc(sizeof(dvbpsi_dvb_default_authority_dr_t));
@@ -61,7 +61,7 @@ dvbpsi_dvb_default_authority_dr_t *dvbpsi_decode_dvb_default_authority_dr(dvbpsi
     memcpy(&p_decoded->authority, p_descriptor->p_data, p_descriptor->i_length);
     p_decoded->authority[p_descriptor->i_length] = 0;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
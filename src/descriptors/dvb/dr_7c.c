@@ -267,7 +267,7 @@ dvbpsi_dvb_aac_dr_t *dvbpsi_decode_dvb_aac_dr(dvbpsi_descriptor_t *p_descriptor)
         memcpy(p_decoded->p_additional_info, p, i_info_length);
     }
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
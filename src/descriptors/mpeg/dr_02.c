@@ -81,7 +81,7 @@ dvbpsi_mpeg_vstream_dr_t * dvbpsi_decode_mpeg_vstream_dr(dvbpsi_descriptor_t * p
                                 (p_descriptor->p_data[2] & 0x20) ? true : false;
   }
 
-  p_descriptor->p_decoded = (void*)p_decoded;
+  dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
   return p_decoded;
 }
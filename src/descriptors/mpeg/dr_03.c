@@ -72,7 +72,7 @@ dvbpsi_mpeg_astream_dr_t * dvbpsi_decode_mpeg_astream_dr(dvbpsi_descriptor_t * p
   p_decoded->i_layer = (p_descriptor->p_data[0] & 0x30) >> 4;
   p_decoded->b_variable_rate_audio_indicator = ((p_descriptor->p_data[0] & 0x08) >> 3) ? true : false;
 
-  p_descriptor->p_decoded = (void*)p_decoded;
+  dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
   return p_decoded;
 }
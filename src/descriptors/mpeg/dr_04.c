@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_04.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -68,12 +69,9 @@ dvbpsi_mpeg_hierarchy_dr_t * dvbpsi_decode_mpeg_hierarchy_dr(
     return NULL;
   }
 
-  p_decoded->i_h_type = p_descriptor->p_data[0] & 0x0f;
-  p_decoded->i_h_layer_index = p_descriptor->p_data[1] & 0x3f;
-  p_decoded->i_h_embedded_layer = p_descriptor->p_data[2] & 0x3f;
-  p_decoded->i_h_priority = p_descriptor->p_data[3] & 0x3f;
+  dr_layout_decode_mpeg_hierarchy(p_descriptor->p_data, p_decoded);
 
-  p_descriptor->p_decoded = (void*)p_decoded;
+  dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
   return p_decoded;
 }
@@ -91,10 +89,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_hierarchy_dr(dvbpsi_mpeg_hierarchy_dr_t *
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] = 0xf0 | p_decoded->i_h_type;
-    p_descriptor->p_data[1] = 0xc0 | p_decoded->i_h_layer_index;
-    p_descriptor->p_data[2] = 0xc0 | p_decoded->i_h_embedded_layer;
-    p_descriptor->p_data[3] = 0xc0 | p_decoded->i_h_priority;
+    dr_layout_encode_mpeg_hierarchy(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
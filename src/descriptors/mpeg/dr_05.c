@@ -82,7 +82,7 @@ dvbpsi_mpeg_registration_dr_t * dvbpsi_decode_mpeg_registration_dr(
            p_descriptor->p_data + 4,
            p_decoded->i_additional_length);
 
-  p_descriptor->p_decoded = (void*)p_decoded;
+  dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
   return p_decoded;
 }
@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_06.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -64,9 +65,9 @@ dvbpsi_mpeg_ds_alignment_dr_t * dvbpsi_decode_mpeg_ds_alignment_dr(
     p_decoded = (dvbpsi_mpeg_ds_alignment_dr_t*) malloc(sizeof(dvbpsi_mpeg_ds_alignment_dr_t));
     if(!p_decoded) return NULL;
 
-    p_decoded->i_alignment_type = p_descriptor->p_data[0];
+    dr_layout_decode_mpeg_ds_alignment(p_descriptor->p_data, p_decoded);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -85,7 +86,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_ds_alignment_dr(
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] = p_decoded->i_alignment_type;
+    dr_layout_encode_mpeg_ds_alignment(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_07.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -65,15 +66,9 @@ dvbpsi_mpeg_target_bg_grid_dr_t * dvbpsi_decode_mpeg_target_bg_grid_dr(
     if (!p_decoded)
         return NULL;
 
-    p_decoded->i_horizontal_size =   ((uint16_t)(p_descriptor->p_data[0]) << 6)
-            | ((p_descriptor->p_data[1] & 0xfc) >> 2);
-    p_decoded->i_vertical_size =
-            ((uint16_t)(p_descriptor->p_data[1] & 0x03) << 12)
-            | ((uint16_t)(p_descriptor->p_data[2]) << 4)
-            | ((p_descriptor->p_data[3] & 0xf0) >> 4);
-    p_decoded->i_pel_aspect_ratio = p_descriptor->p_data[3] & 0x0f;
+    dr_layout_decode_mpeg_target_bg_grid(p_descriptor->p_data, p_decoded);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -91,12 +86,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_target_bg_grid_dr(dvbpsi_mpeg_target_bg_gr
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] = p_decoded->i_horizontal_size >> 6;
-    p_descriptor->p_data[1] =   (((uint8_t)p_decoded->i_horizontal_size) << 2)
-            | (p_decoded->i_vertical_size >> 12);
-    p_descriptor->p_data[2] = p_decoded->i_vertical_size >> 4;
-    p_descriptor->p_data[3] =   (((uint8_t)p_decoded->i_vertical_size) << 4)
-            | (p_decoded->i_pel_aspect_ratio & 0x0f);
+    dr_layout_encode_mpeg_target_bg_grid(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
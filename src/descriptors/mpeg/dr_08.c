@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_08.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -64,15 +65,9 @@ dvbpsi_mpeg_vwindow_dr_t * dvbpsi_decode_mpeg_vwindow_dr(dvbpsi_descriptor_t * p
     if (!p_decoded)
         return NULL;
 
-    p_decoded->i_horizontal_offset =   ((uint16_t)(p_descriptor->p_data[0]) << 6)
-            | ((p_descriptor->p_data[1] & 0xfc) >> 2);
-    p_decoded->i_vertical_offset =
-            ((uint16_t)(p_descriptor->p_data[1] & 0x03) << 12)
-            | ((uint16_t)(p_descriptor->p_data[2]) << 4)
-            | ((p_descriptor->p_data[3] & 0xf0) >> 4);
-    p_decoded->i_window_priority = p_descriptor->p_data[3] & 0x0f;
+    dr_layout_decode_mpeg_vwindow(p_descriptor->p_data, p_decoded);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -91,12 +86,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_vwindow_dr(dvbpsi_mpeg_vwindow_dr_t * p_de
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] = p_decoded->i_horizontal_offset >> 6;
-    p_descriptor->p_data[1] =   (((uint8_t)p_decoded->i_horizontal_offset) << 2)
-            | (p_decoded->i_vertical_offset >> 12);
-    p_descriptor->p_data[2] = p_decoded->i_vertical_offset >> 4;
-    p_descriptor->p_data[3] =   (((uint8_t)p_decoded->i_vertical_offset) << 4)
-            | (p_decoded->i_window_priority & 0x0f);
+    dr_layout_encode_mpeg_vwindow(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
@@ -77,7 +77,7 @@ dvbpsi_mpeg_ca_dr_t * dvbpsi_decode_mpeg_ca_dr(dvbpsi_descriptor_t * p_descripto
                p_descriptor->p_data + 4,
                p_decoded->i_private_length);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -78,7 +78,7 @@ dvbpsi_mpeg_iso639_dr_t * dvbpsi_decode_mpeg_iso639_dr(dvbpsi_descriptor_t * p_d
         p_decoded->code[i].i_audio_type = p_descriptor->p_data[i*4+3];
         i++;
     }
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_0b.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -67,11 +68,9 @@ dvbpsi_mpeg_system_clock_dr_t * dvbpsi_decode_mpeg_system_clock_dr(
     if (!p_decoded)
         return NULL;
 
-    p_decoded->b_external_clock_ref = (p_descriptor->p_data[0] & 0x80) ? true : false;
-    p_decoded->i_clock_accuracy_integer = p_descriptor->p_data[0] & 0x3f;
-    p_decoded->i_clock_accuracy_exponent = (p_descriptor->p_data[1] & 0xe0) >> 5;
+    dr_layout_decode_mpeg_system_clock(p_descriptor->p_data, p_decoded);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -89,11 +88,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_system_clock_dr(dvbpsi_mpeg_system_clock_d
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] =
-            0x40 | (p_decoded->i_clock_accuracy_integer & 0x3f);
-    if (p_decoded->b_external_clock_ref)
-        p_descriptor->p_data[0] |= 0x80;
-    p_descriptor->p_data[1] = 0x1f | p_decoded->i_clock_accuracy_exponent << 5;
+    dr_layout_encode_mpeg_system_clock(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
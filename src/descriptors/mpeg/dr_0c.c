@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_0c.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -66,13 +67,9 @@ dvbpsi_mpeg_mx_buff_utilization_dr_t * dvbpsi_decode_mpeg_mx_buff_utilization_dr
     if (!p_decoded)
         return NULL;
 
-    p_decoded->b_mdv_valid = (p_descriptor->p_data[0] & 0x80) ? true : false;
-    p_decoded->i_mx_delay_variation =
-            ((uint16_t)(p_descriptor->p_data[0] & 0x7f) << 8)
-            | p_descriptor->p_data[1];
-    p_decoded->i_mx_strategy = (p_descriptor->p_data[2] & 0xe0) >> 5;
+    dr_layout_decode_mpeg_mx_buff_utilization(p_descriptor->p_data, p_decoded);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -91,11 +88,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_mx_buff_utilization_dr(
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] = (p_decoded->i_mx_delay_variation >> 8) & 0x7f;
-    if(p_decoded->b_mdv_valid)
-        p_descriptor->p_data[0] |= 0x80;
-    p_descriptor->p_data[1] = p_decoded->i_mx_delay_variation;
-    p_descriptor->p_data[2] = 0x1f | p_decoded->i_mx_strategy << 5;
+    dr_layout_encode_mpeg_mx_buff_utilization(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_0e.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -65,12 +66,9 @@ dvbpsi_mpeg_max_bitrate_dr_t * dvbpsi_decode_mpeg_max_bitrate_dr(
     if (!p_decoded)
         return NULL;
 
-    p_decoded->i_max_bitrate =
-            ((uint32_t)(p_descriptor->p_data[0] & 0x3f) << 16)
-            | ((uint32_t)(p_descriptor->p_data[1]) << 8)
-            | p_descriptor->p_data[2];
+    dr_layout_decode_mpeg_max_bitrate(p_descriptor->p_data, p_decoded);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -87,9 +85,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_max_bitrate_dr(dvbpsi_mpeg_max_bitrate_dr_
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] = 0xc0 | ((p_decoded->i_max_bitrate >> 16) & 0x3f);
-    p_descriptor->p_data[1] = p_decoded->i_max_bitrate >> 8;
-    p_descriptor->p_data[2] = p_decoded->i_max_bitrate;
+    dr_layout_encode_mpeg_max_bitrate(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
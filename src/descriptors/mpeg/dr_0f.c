@@ -39,6 +39,7 @@
 #include "../../descriptor.h"
 
 #include "dr_0f.h"
+#include "dr_layout.h"
 
 
 /*****************************************************************************
@@ -65,12 +66,9 @@ dvbpsi_mpeg_private_data_dr_t * dvbpsi_decode_mpeg_private_data_dr(
     if (!p_decoded)
         return NULL;
 
-    p_decoded->i_private_data =   ((uint32_t)(p_descriptor->p_data[0]) << 24)
-            | ((uint32_t)(p_descriptor->p_data[1]) << 16)
-            | ((uint32_t)(p_descriptor->p_data[2]) << 8)
-            | p_descriptor->p_data[3];
+    dr_layout_decode_mpeg_private_data(p_descriptor->p_data, p_decoded);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -89,10 +87,7 @@ dvbpsi_descriptor_t * dvbpsi_gen_mpeg_private_data_dr(
         return NULL;
 
     /* Encode data */
-    p_descriptor->p_data[0] = p_decoded->i_private_data >> 24;
-    p_descriptor->p_data[1] = p_decoded->i_private_data >> 16;
-    p_descriptor->p_data[2] = p_decoded->i_private_data >> 8;
-    p_descriptor->p_data[3] = p_decoded->i_private_data;
+    dr_layout_encode_mpeg_private_data(p_decoded, p_descriptor->p_data);
 
     if (b_duplicate)
     {
@@ -64,7 +64,7 @@ dvbpsi_mpeg_smoothing_buffer_dr_t* dvbpsi_decode_mpeg_smoothing_buffer_dr(
         | ((uint32_t)p_descriptor->p_data[4] << 8)
         | p_descriptor->p_data[5];
     
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
     
     return p_decoded;
 }
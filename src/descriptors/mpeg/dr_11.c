@@ -55,7 +55,7 @@ dvbpsi_mpeg_std_dr_t* dvbpsi_decode_mpeg_std_dr(dvbpsi_descriptor_t * p_descript
 
     p_decoded->b_leak_valid_flag = p_descriptor->p_data[0] & 0x01;
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
@@ -66,7 +66,7 @@ dvbpsi_mpeg_ibp_dr_t* dvbpsi_decode_mpeg_ibp_dr(dvbpsi_descriptor_t * p_descript
         return NULL;
     }
     
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
     
     return p_decoded;
 }
@@ -66,7 +66,7 @@ dvbpsi_mpeg_carousel_id_dr_t *dvbpsi_decode_mpeg_carousel_id_dr(dvbpsi_descripto
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check length */
@@ -81,7 +81,7 @@ dvbpsi_mpeg_carousel_id_dr_t *dvbpsi_decode_mpeg_carousel_id_dr(dvbpsi_descripto
                                ((p_descriptor->p_data[2] & 0xff) <<  8) |  (p_descriptor->p_data[3] & 0xff);
 
     memcpy(p_decoded->p_private_data, &p_descriptor->p_data[4], p_decoded->i_private_data_len);
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
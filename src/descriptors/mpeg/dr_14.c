@@ -73,7 +73,7 @@ dvbpsi_mpeg_association_tag_dr_t *dvbpsi_decode_mpeg_association_tag_dr(dvbpsi_d
         return NULL;
 
     /* Don't decode twice */
-    if (p_descriptor->p_decoded)
+    if (dvbpsi_IsDescriptorDecoded(p_descriptor))
         return p_descriptor->p_decoded;
 
     /* Check length */
@@ -97,7 +97,7 @@ dvbpsi_mpeg_association_tag_dr_t *dvbpsi_decode_mpeg_association_tag_dr(dvbpsi_d
     memcpy(p_decoded->p_selector, &p_descriptor->p_data[5], selector_len);
     memcpy(p_decoded->p_private_data, &p_descriptor->p_data[5 + selector_len], private_data_len);
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
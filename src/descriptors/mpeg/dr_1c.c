@@ -56,7 +56,7 @@ dvbpsi_mpeg_mpeg4_audio_dr_t* dvbpsi_decode_mpeg_mpeg4_audio_dr(
 
     p_decoded->i_mpeg4_audio_profile_and_level = p_descriptor->p_data[0];
 
-    p_descriptor->p_decoded = (void*)p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
 
     return p_decoded;
 }
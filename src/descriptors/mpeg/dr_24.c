@@ -214,7 +214,7 @@ dvbpsi_mpeg_content_labelling_dr_t* dvbpsi_decode_mpeg_content_labelling_dr(
         memcpy(p_decoded->p_private_data, p_data, p_decoded->i_private_data_len);
     }
 
-    p_descriptor->p_decoded = p_decoded;
+    dvbpsi_SetDescriptorDecoded(p_descriptor, p_decoded);
     return p_decoded;
 
 err:
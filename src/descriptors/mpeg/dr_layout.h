@@ -0,0 +1,258 @@
+/* This file is generated by applying the dr_layout.xsl stylesheet to the
+ * dr.xml description file. DO NOT EDIT !!! */
+
+#ifndef _DVBPSI_DR_LAYOUT_H_
+#define _DVBPSI_DR_LAYOUT_H_
+
+#ifndef _DVBPSI_DR_04_H_
+#include "dr_04.h"
+#endif
+#ifndef _DVBPSI_DR_06_H_
+#include "dr_06.h"
+#endif
+#ifndef _DVBPSI_DR_07_H_
+#include "dr_07.h"
+#endif
+#ifndef _DVBPSI_DR_08_H_
+#include "dr_08.h"
+#endif
+#ifndef _DVBPSI_DR_0B_H_
+#include "dr_0b.h"
+#endif
+#ifndef _DVBPSI_DR_0C_H_
+#include "dr_0c.h"
+#endif
+#ifndef _DVBPSI_DR_0E_H_
+#include "dr_0e.h"
+#endif
+#ifndef _DVBPSI_DR_0F_H_
+#include "dr_0f.h"
+#endif
+
+/* hierarchy */
+static inline void dr_layout_decode_mpeg_hierarchy(const uint8_t *p,
+    dvbpsi_mpeg_hierarchy_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_h_type = (v >> 24) & ((UINT64_C(1) << 4) - 1);
+  p_decoded->i_h_layer_index = (v >> 16) & ((UINT64_C(1) << 6) - 1);
+  p_decoded->i_h_embedded_layer = (v >> 8) & ((UINT64_C(1) << 6) - 1);
+  p_decoded->i_h_priority = (v >> 0) & ((UINT64_C(1) << 6) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_hierarchy(const dvbpsi_mpeg_hierarchy_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((UINT64_C(1) << 4) - 1) << 28;
+  v |= ((uint64_t)p_decoded->i_h_type & ((UINT64_C(1) << 4) - 1)) << 24;
+  v |= ((UINT64_C(1) << 2) - 1) << 22;
+  v |= ((uint64_t)p_decoded->i_h_layer_index & ((UINT64_C(1) << 6) - 1)) << 16;
+  v |= ((UINT64_C(1) << 2) - 1) << 14;
+  v |= ((uint64_t)p_decoded->i_h_embedded_layer & ((UINT64_C(1) << 6) - 1)) << 8;
+  v |= ((UINT64_C(1) << 2) - 1) << 6;
+  v |= ((uint64_t)p_decoded->i_h_priority & ((UINT64_C(1) << 6) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+}
+
+/* data stream alignment */
+static inline void dr_layout_decode_mpeg_ds_alignment(const uint8_t *p,
+    dvbpsi_mpeg_ds_alignment_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = p[0];
+
+  p_decoded->i_alignment_type = (v >> 0) & ((UINT64_C(1) << 8) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_ds_alignment(const dvbpsi_mpeg_ds_alignment_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_alignment_type & ((UINT64_C(1) << 8) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 0);
+}
+
+/* target background grid */
+static inline void dr_layout_decode_mpeg_target_bg_grid(const uint8_t *p,
+    dvbpsi_mpeg_target_bg_grid_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_horizontal_size = (v >> 18) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_vertical_size = (v >> 4) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_pel_aspect_ratio = (v >> 0) & ((UINT64_C(1) << 4) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_target_bg_grid(const dvbpsi_mpeg_target_bg_grid_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_horizontal_size & ((UINT64_C(1) << 14) - 1)) << 18;
+  v |= ((uint64_t)p_decoded->i_vertical_size & ((UINT64_C(1) << 14) - 1)) << 4;
+  v |= ((uint64_t)p_decoded->i_pel_aspect_ratio & ((UINT64_C(1) << 4) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+}
+
+/* video window */
+static inline void dr_layout_decode_mpeg_vwindow(const uint8_t *p,
+    dvbpsi_mpeg_vwindow_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_horizontal_offset = (v >> 18) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_vertical_offset = (v >> 4) & ((UINT64_C(1) << 14) - 1);
+  p_decoded->i_window_priority = (v >> 0) & ((UINT64_C(1) << 4) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_vwindow(const dvbpsi_mpeg_vwindow_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_horizontal_offset & ((UINT64_C(1) << 14) - 1)) << 18;
+  v |= ((uint64_t)p_decoded->i_vertical_offset & ((UINT64_C(1) << 14) - 1)) << 4;
+  v |= ((uint64_t)p_decoded->i_window_priority & ((UINT64_C(1) << 4) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+}
+
+/* system clock */
+static inline void dr_layout_decode_mpeg_system_clock(const uint8_t *p,
+    dvbpsi_mpeg_system_clock_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = ((uint64_t)p[0] << 8)
+      | p[1];
+
+  p_decoded->b_external_clock_ref = (v >> 15) & 1;
+  p_decoded->i_clock_accuracy_integer = (v >> 8) & ((UINT64_C(1) << 6) - 1);
+  p_decoded->i_clock_accuracy_exponent = (v >> 5) & ((UINT64_C(1) << 3) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_system_clock(const dvbpsi_mpeg_system_clock_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  if(p_decoded->b_external_clock_ref)
+    v |= UINT64_C(1) << 15;
+  v |= ((UINT64_C(1) << 1) - 1) << 14;
+  v |= ((uint64_t)p_decoded->i_clock_accuracy_integer & ((UINT64_C(1) << 6) - 1)) << 8;
+  v |= ((uint64_t)p_decoded->i_clock_accuracy_exponent & ((UINT64_C(1) << 3) - 1)) << 5;
+  v |= ((UINT64_C(1) << 5) - 1) << 0;
+  p_data[0] = (uint8_t)(v >> 8);
+  p_data[1] = (uint8_t)(v >> 0);
+}
+
+/* multiplex buffer utilization */
+static inline void dr_layout_decode_mpeg_mx_buff_utilization(const uint8_t *p,
+    dvbpsi_mpeg_mx_buff_utilization_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = ((uint64_t)p[0] << 16)
+      | ((uint64_t)p[1] << 8)
+      | p[2];
+
+  p_decoded->b_mdv_valid = (v >> 23) & 1;
+  p_decoded->i_mx_delay_variation = (v >> 8) & ((UINT64_C(1) << 15) - 1);
+  p_decoded->i_mx_strategy = (v >> 5) & ((UINT64_C(1) << 3) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_mx_buff_utilization(const dvbpsi_mpeg_mx_buff_utilization_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  if(p_decoded->b_mdv_valid)
+    v |= UINT64_C(1) << 23;
+  v |= ((uint64_t)p_decoded->i_mx_delay_variation & ((UINT64_C(1) << 15) - 1)) << 8;
+  v |= ((uint64_t)p_decoded->i_mx_strategy & ((UINT64_C(1) << 3) - 1)) << 5;
+  v |= ((UINT64_C(1) << 5) - 1) << 0;
+  p_data[0] = (uint8_t)(v >> 16);
+  p_data[1] = (uint8_t)(v >> 8);
+  p_data[2] = (uint8_t)(v >> 0);
+}
+
+/* maximum bitrate */
+static inline void dr_layout_decode_mpeg_max_bitrate(const uint8_t *p,
+    dvbpsi_mpeg_max_bitrate_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = ((uint64_t)p[0] << 16)
+      | ((uint64_t)p[1] << 8)
+      | p[2];
+
+  p_decoded->i_max_bitrate = (v >> 0) & ((UINT64_C(1) << 22) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_max_bitrate(const dvbpsi_mpeg_max_bitrate_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((UINT64_C(1) << 2) - 1) << 22;
+  v |= ((uint64_t)p_decoded->i_max_bitrate & ((UINT64_C(1) << 22) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 16);
+  p_data[1] = (uint8_t)(v >> 8);
+  p_data[2] = (uint8_t)(v >> 0);
+}
+
+/* private data indicator */
+static inline void dr_layout_decode_mpeg_private_data(const uint8_t *p,
+    dvbpsi_mpeg_private_data_dr_t *p_decoded)
+{
+  uint64_t v;
+
+  v = ((uint64_t)p[0] << 24)
+      | ((uint64_t)p[1] << 16)
+      | ((uint64_t)p[2] << 8)
+      | p[3];
+
+  p_decoded->i_private_data = (v >> 0) & ((UINT64_C(1) << 32) - 1);
+}
+
+static inline void dr_layout_encode_mpeg_private_data(const dvbpsi_mpeg_private_data_dr_t *p_decoded,
+    uint8_t *p_data)
+{
+  uint64_t v = 0;
+
+  v |= ((uint64_t)p_decoded->i_private_data & ((UINT64_C(1) << 32) - 1)) << 0;
+  p_data[0] = (uint8_t)(v >> 24);
+  p_data[1] = (uint8_t)(v >> 16);
+  p_data[2] = (uint8_t)(v >> 8);
+  p_data[3] = (uint8_t)(v >> 0);
+}
+
+#endif
@@ -0,0 +1,1006 @@
+/*****************************************************************************
+ * discovery.c: PAT/PMT/SDT/NIT service discovery engine
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "psi.h"
+#include "descriptor.h"
+#include "demux.h"
+#include "ts.h"
+#include "snapshot.h"
+#include "tables/pat.h"
+#include "tables/pmt.h"
+#include "tables/sdt.h"
+#include "tables/nit.h"
+#include "discovery.h"
+
+#define DISCOVERY_PID_COUNT     8192
+#define DISCOVERY_PAT_PID       0x00
+#define DISCOVERY_NIT_PID       0x10
+#define DISCOVERY_SDT_PID       0x11
+
+/* State of a table decoded from the snapshot */
+#define DISCOVERY_TABLE_LIVE        0   /* decoded from live sections */
+#define DISCOVERY_TABLE_CACHED      1   /* decoded from the snapshot */
+#define DISCOVERY_TABLE_SUPERSEDED  2   /* live sections differ, waiting
+                                           for the live table */
+
+/*****************************************************************************
+ * discovery_table_t
+ *****************************************************************************
+ * Check of a table decoded from the snapshot against the live sections.
+ *****************************************************************************/
+typedef struct discovery_table_s
+{
+    uint8_t     i_state;            /* DISCOVERY_TABLE_* */
+    uint8_t     pi_confirmed[32];   /* section_numbers found identical */
+} discovery_table_t;
+
+/*****************************************************************************
+ * discovery_program_t
+ *****************************************************************************
+ * Per program state. Programs sharing a PMT PID are chained on that PID.
+ *****************************************************************************/
+typedef struct discovery_program_s
+{
+    dvbpsi_discovery_service_t      service;        /* must be first */
+
+    dvbpsi_discovery_t             *p_disc;         /* engine owning the program */
+    dvbpsi_t                       *p_dvbpsi;       /* PMT decoder */
+    dvbpsi_pmt_t                   *p_pmt;          /* owned copy of service.p_pmt */
+    bool                            b_seen;         /* still in the PAT */
+    bool                            b_added;        /* not announced yet */
+    discovery_table_t               pmt_table;      /* snapshot check */
+
+    struct discovery_program_s     *p_next_pid;     /* next program on the PID */
+} discovery_program_t;
+
+/*****************************************************************************
+ * dvbpsi_discovery_s
+ *****************************************************************************/
+struct dvbpsi_discovery_s
+{
+    dvbpsi_discovery_callback   pf_callback;
+    void                       *p_cb_data;
+    dvbpsi_message_cb           pf_message;
+    enum dvbpsi_msg_level       i_msg_level;
+
+    int64_t                     i_date;         /* date of the current packet */
+
+    dvbpsi_t                   *p_pat_dvbpsi;
+    dvbpsi_t                   *p_sdt_dvbpsi;
+    dvbpsi_t                   *p_nit_dvbpsi;
+    uint16_t                    i_nit_pid;
+
+    dvbpsi_pat_t               *p_pat;
+    dvbpsi_sdt_t               *p_sdt;
+    dvbpsi_nit_t               *p_nit;
+
+    /* Programs of the current PAT in PAT order */
+    discovery_program_t       **pp_programs;
+    unsigned int                i_programs;
+    unsigned int                i_pmt_missing;  /* programs without PMT */
+    bool                        b_complete;
+
+    /* Snapshot cache */
+    dvbpsi_snapshot_t          *p_snap;
+    uint16_t                    i_onid;
+    uint16_t                    i_tsid;
+    bool                        b_seeding;      /* decoding cached sections */
+    discovery_table_t           pat_table;      /* snapshot checks */
+    discovery_table_t           sdt_table;
+    unsigned int                i_cached;       /* tables in CACHED or
+                                                   SUPERSEDED state */
+
+    /* PMT PID routing */
+    discovery_program_t        *pp_pids[DISCOVERY_PID_COUNT];
+};
+
+/*****************************************************************************
+ * Local prototypes
+ *****************************************************************************/
+static void discovery_PATCallback(void *p_cb_data, dvbpsi_pat_t *p_pat);
+static void discovery_PMTCallback(void *p_cb_data, dvbpsi_pmt_t *p_pmt);
+static void discovery_SDTCallback(void *p_cb_data, dvbpsi_sdt_t *p_sdt);
+static void discovery_NITCallback(void *p_cb_data, dvbpsi_nit_t *p_nit);
+
+/*****************************************************************************
+ * discovery_Raise
+ *****************************************************************************
+ * Report an event to the application.
+ *****************************************************************************/
+static void discovery_Raise(dvbpsi_discovery_t *p_disc, dvbpsi_discovery_event_t i_event,
+                            const discovery_program_t *p_program)
+{
+    if (p_disc->pf_callback)
+        p_disc->pf_callback(p_disc->p_cb_data, p_disc, i_event,
+                            p_program ? &p_program->service : NULL);
+}
+
+/*****************************************************************************
+ * discovery_CheckComplete
+ *****************************************************************************
+ * Announce once per PAT that the PMTs of all its programs are known.
+ *****************************************************************************/
+static void discovery_CheckComplete(dvbpsi_discovery_t *p_disc)
+{
+    if (p_disc->b_complete || p_disc->p_pat == NULL || p_disc->i_pmt_missing)
+        return;
+
+    p_disc->b_complete = true;
+    discovery_Raise(p_disc, DVBPSI_DISCOVERY_COMPLETE, NULL);
+}
+
+/*****************************************************************************
+ * discovery_SetCached / discovery_SetLive
+ *****************************************************************************
+ * Account the tables decoded from the snapshot and announce when all of
+ * them have been checked against live sections.
+ *****************************************************************************/
+static void discovery_SetCached(dvbpsi_discovery_t *p_disc, discovery_table_t *p_table)
+{
+    if (p_table->i_state == DISCOVERY_TABLE_LIVE)
+        p_disc->i_cached++;
+    p_table->i_state = DISCOVERY_TABLE_CACHED;
+    memset(p_table->pi_confirmed, 0, sizeof(p_table->pi_confirmed));
+}
+
+static void discovery_SetLive(dvbpsi_discovery_t *p_disc, discovery_table_t *p_table,
+                              bool b_raise)
+{
+    if (p_table->i_state == DISCOVERY_TABLE_LIVE)
+        return;
+
+    p_table->i_state = DISCOVERY_TABLE_LIVE;
+    assert(p_disc->i_cached);
+    if (--p_disc->i_cached == 0 && b_raise)
+        discovery_Raise(p_disc, DVBPSI_DISCOVERY_LIVE, NULL);
+}
+
+/*****************************************************************************
+ * discovery_LiveSection
+ *****************************************************************************
+ * Compare a live section with the snapshot and store it. A table decoded
+ * from the snapshot is confirmed once all its sections, up to
+ * last_section_number, have been found identical. A differing section
+ * resets its decoder so that the live table is delivered even if the
+ * version_number did not change.
+ *****************************************************************************/
+static void discovery_LiveSection(dvbpsi_discovery_t *p_disc, dvbpsi_decoder_t *p_decoder,
+                                  uint16_t i_pid, const dvbpsi_psi_section_t *p_section,
+                                  discovery_table_t *p_table)
+{
+    if (p_disc->p_snap == NULL || !p_section->b_current_next)
+        return;
+
+    const size_t i_length = p_section->p_payload_end + 4 - p_section->p_data;
+    if (p_table->i_state == DISCOVERY_TABLE_CACHED)
+    {
+        const uint8_t *p_cached;
+        size_t i_cached;
+        if (dvbpsi_snapshot_lookup(p_disc->p_snap, p_disc->i_onid, p_disc->i_tsid,
+                                   i_pid, p_section->i_table_id, p_section->i_extension,
+                                   p_section->i_number, &p_cached, &i_cached) &&
+            i_cached == i_length && memcmp(p_cached, p_section->p_data, i_length) == 0)
+        {
+            p_table->pi_confirmed[p_section->i_number >> 3] |= 1 << (p_section->i_number & 7);
+
+            bool b_all = true;
+            for (unsigned int i = 0; i <= p_section->i_last_number && b_all; i++)
+                b_all = (p_table->pi_confirmed[i >> 3] >> (i & 7)) & 1;
+            if (b_all)
+                discovery_SetLive(p_disc, p_table, true);
+        }
+        else
+        {
+            if (p_decoder)
+                dvbpsi_decoder_reset(p_decoder, true);
+            p_table->i_state = DISCOVERY_TABLE_SUPERSEDED;
+        }
+    }
+
+    dvbpsi_snapshot_store(p_disc->p_snap, p_disc->i_onid, p_disc->i_tsid,
+                          i_pid, p_section->p_data, i_length);
+}
+
+/*****************************************************************************
+ * discovery_PATSection / discovery_PMTSection / discovery_SDTSection
+ *****************************************************************************
+ * Section callbacks of the live decoders.
+ *****************************************************************************/
+static void discovery_PATSection(dvbpsi_t *p_dvbpsi, const dvbpsi_psi_section_t *p_section,
+                                 const bool b_valid)
+{
+    dvbpsi_discovery_t *p_disc = (dvbpsi_discovery_t *)p_dvbpsi->p_sys;
+    if (b_valid && p_section->i_table_id == 0x00)
+        discovery_LiveSection(p_disc, p_dvbpsi->p_decoder, DISCOVERY_PAT_PID,
+                              p_section, &p_disc->pat_table);
+}
+
+static void discovery_PMTSection(dvbpsi_t *p_dvbpsi, const dvbpsi_psi_section_t *p_section,
+                                 const bool b_valid)
+{
+    discovery_program_t *p_program = (discovery_program_t *)p_dvbpsi->p_sys;
+    if (!b_valid || p_section->i_table_id != 0x02 ||
+        p_section->i_extension != p_program->service.i_program_number)
+        return;
+
+    discovery_LiveSection(p_program->p_disc, p_dvbpsi->p_decoder,
+                          p_program->service.i_pmt_pid, p_section,
+                          &p_program->pmt_table);
+    p_program->service.b_pmt_cached = (p_program->pmt_table.i_state != DISCOVERY_TABLE_LIVE);
+}
+
+/*****************************************************************************
+ * Demux helpers
+ *****************************************************************************
+ * The demux API is deprecated for applications, the library still builds
+ * its subtable decoders on it.
+ *****************************************************************************/
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+static dvbpsi_decoder_t *discovery_SubDecoder(dvbpsi_t *p_dvbpsi,
+                                              const dvbpsi_psi_section_t *p_section)
+{
+    dvbpsi_demux_t *p_demux = (dvbpsi_demux_t *)p_dvbpsi->p_decoder;
+    dvbpsi_demux_subdec_t *p_subdec = dvbpsi_demuxGetSubDec(p_demux, p_section->i_table_id,
+                                                            p_section->i_extension);
+    return p_subdec ? p_subdec->p_decoder : NULL;
+}
+
+static dvbpsi_t *discovery_AttachDemux(dvbpsi_discovery_t *p_disc,
+                                       dvbpsi_demux_new_cb_t pf_new)
+{
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(p_disc->pf_message, p_disc->i_msg_level);
+    if (p_dvbpsi == NULL)
+        return NULL;
+
+    if (!dvbpsi_AttachDemux(p_dvbpsi, pf_new, p_disc))
+    {
+        dvbpsi_delete(p_dvbpsi);
+        return NULL;
+    }
+    return p_dvbpsi;
+}
+
+static void discovery_DetachDemux(dvbpsi_t *p_dvbpsi)
+{
+    if (p_dvbpsi == NULL)
+        return;
+
+    dvbpsi_DetachDemux(p_dvbpsi);
+    dvbpsi_delete(p_dvbpsi);
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+static void discovery_SDTSection(dvbpsi_t *p_dvbpsi, const dvbpsi_psi_section_t *p_section,
+                                 const bool b_valid)
+{
+    dvbpsi_discovery_t *p_disc = (dvbpsi_discovery_t *)p_dvbpsi->p_sys;
+    if (!b_valid || p_section->i_table_id != 0x42)
+        return;
+
+    discovery_LiveSection(p_disc, discovery_SubDecoder(p_dvbpsi, p_section),
+                          DISCOVERY_SDT_PID, p_section, &p_disc->sdt_table);
+}
+
+/*****************************************************************************
+ * discovery_FindSDTService
+ *****************************************************************************
+ * Look up the description of a program in the last SDT.
+ *****************************************************************************/
+static const dvbpsi_sdt_service_t *discovery_FindSDTService(const dvbpsi_sdt_t *p_sdt,
+                                                            uint16_t i_program_number)
+{
+    if (p_sdt == NULL)
+        return NULL;
+
+    for (const dvbpsi_sdt_service_t *p_service = p_sdt->p_first_service;
+         p_service; p_service = p_service->p_next)
+    {
+        if (p_service->i_service_id == i_program_number)
+            return p_service;
+    }
+    return NULL;
+}
+
+/*****************************************************************************
+ * discovery_NewSDT / discovery_NewNIT
+ *****************************************************************************
+ * Demux callbacks, only the tables describing the actual transport stream
+ * are decoded.
+ *****************************************************************************/
+static void discovery_NewSDT(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                             uint16_t i_extension, void *p_cb_data)
+{
+    if (i_table_id != 0x42)
+        return;
+
+    if (!dvbpsi_sdt_attach(p_dvbpsi, i_table_id, i_extension,
+                           discovery_SDTCallback, p_cb_data))
+        dvbpsi_error(p_dvbpsi, "discovery", "unable to attach SDT decoder");
+}
+
+static void discovery_NewNIT(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                             uint16_t i_extension, void *p_cb_data)
+{
+    if (i_table_id != 0x40)
+        return;
+
+    if (!dvbpsi_nit_attach(p_dvbpsi, i_table_id, i_extension,
+                           discovery_NITCallback, p_cb_data))
+        dvbpsi_error(p_dvbpsi, "discovery", "unable to attach NIT decoder");
+}
+
+/*****************************************************************************
+ * discovery_SetNITPID
+ *****************************************************************************
+ * Move the NIT decoder to the network_PID announced by the PAT.
+ *****************************************************************************/
+static void discovery_SetNITPID(dvbpsi_discovery_t *p_disc, uint16_t i_pid)
+{
+    if (p_disc->p_nit_dvbpsi && p_disc->i_nit_pid == i_pid)
+        return;
+
+    discovery_DetachDemux(p_disc->p_nit_dvbpsi);
+    p_disc->i_nit_pid = i_pid;
+    p_disc->p_nit_dvbpsi = discovery_AttachDemux(p_disc, discovery_NewNIT);
+    if (p_disc->p_nit_dvbpsi == NULL)
+        dvbpsi_error(p_disc->p_pat_dvbpsi, "discovery",
+                     "unable to decode NIT on PID %d", i_pid);
+}
+
+/*****************************************************************************
+ * discovery_AddProgram
+ *****************************************************************************
+ * Attach the PMT decoder of a program and route its PID.
+ *****************************************************************************/
+static discovery_program_t *discovery_AddProgram(dvbpsi_discovery_t *p_disc,
+                                                 uint16_t i_program_number,
+                                                 uint16_t i_pmt_pid)
+{
+    discovery_program_t *p_program = (discovery_program_t *)calloc(1, sizeof(discovery_program_t));
+    if (p_program == NULL)
+        return NULL;
+
+    p_program->p_disc = p_disc;
+    p_program->b_added = true;
+    p_program->service.i_program_number = i_program_number;
+    p_program->service.i_pmt_pid = i_pmt_pid;
+    p_program->service.i_added_date = p_disc->i_date;
+    p_program->service.p_sdt_service = discovery_FindSDTService(p_disc->p_sdt,
+                                                                i_program_number);
+
+    p_program->p_dvbpsi = dvbpsi_new(p_disc->pf_message, p_disc->i_msg_level);
+    if (p_program->p_dvbpsi == NULL)
+        goto error;
+    if (!dvbpsi_pmt_attach(p_program->p_dvbpsi, i_program_number,
+                           discovery_PMTCallback, p_program))
+    {
+        dvbpsi_delete(p_program->p_dvbpsi);
+        goto error;
+    }
+
+    p_program->p_dvbpsi->pf_section = discovery_PMTSection;
+    p_program->p_dvbpsi->p_sys = p_program;
+
+    p_program->p_next_pid = p_disc->pp_pids[i_pmt_pid];
+    p_disc->pp_pids[i_pmt_pid] = p_program;
+    return p_program;
+
+error:
+    free(p_program);
+    return NULL;
+}
+
+/*****************************************************************************
+ * discovery_DeleteProgram
+ *****************************************************************************
+ * Unroute a program, detach its PMT decoder and free it.
+ *****************************************************************************/
+static void discovery_DeleteProgram(dvbpsi_discovery_t *p_disc,
+                                    discovery_program_t *p_program)
+{
+    discovery_program_t **pp = &p_disc->pp_pids[p_program->service.i_pmt_pid];
+    while (*pp && *pp != p_program)
+        pp = &(*pp)->p_next_pid;
+    if (*pp)
+        *pp = p_program->p_next_pid;
+
+    dvbpsi_pmt_detach(p_program->p_dvbpsi);
+    dvbpsi_delete(p_program->p_dvbpsi);
+    if (p_program->p_pmt)
+        dvbpsi_pmt_delete(p_program->p_pmt);
+    free(p_program);
+}
+
+/*****************************************************************************
+ * discovery_FindProgram
+ *****************************************************************************
+ * Find a program of the current PAT through the PID routing table.
+ *****************************************************************************/
+static discovery_program_t *discovery_FindProgram(const dvbpsi_discovery_t *p_disc,
+                                                  uint16_t i_program_number,
+                                                  uint16_t i_pmt_pid)
+{
+    for (discovery_program_t *p_program = p_disc->pp_pids[i_pmt_pid];
+         p_program; p_program = p_program->p_next_pid)
+    {
+        if (p_program->service.i_program_number == i_program_number)
+            return p_program;
+    }
+    return NULL;
+}
+
+/*****************************************************************************
+ * discovery_PATCallback
+ *****************************************************************************
+ * Synchronize the PMT decoders with a new PAT. Decoders of unchanged
+ * programs are kept, new ones are attached before the next packet is
+ * processed so that no PMT section is missed.
+ *****************************************************************************/
+static void discovery_PATCallback(void *p_cb_data, dvbpsi_pat_t *p_pat)
+{
+    dvbpsi_discovery_t *p_disc = (dvbpsi_discovery_t *)p_cb_data;
+
+    if (!p_pat->b_current_next)
+    {
+        dvbpsi_pat_delete(p_pat);
+        return;
+    }
+
+    unsigned int i_count = 0;
+    for (dvbpsi_pat_program_t *p = p_pat->p_first_program; p; p = p->p_next)
+        i_count++;
+
+    discovery_program_t **pp_old = p_disc->pp_programs;
+    const unsigned int i_old = p_disc->i_programs;
+    discovery_program_t **pp_new = NULL;
+    if (i_count)
+    {
+        pp_new = (discovery_program_t **)calloc(i_count, sizeof(discovery_program_t *));
+        if (pp_new == NULL)
+        {
+            dvbpsi_error(p_disc->p_pat_dvbpsi, "discovery", "out of memory");
+            dvbpsi_pat_delete(p_pat);
+            return;
+        }
+    }
+
+    for (unsigned int i = 0; i < i_old; i++)
+        pp_old[i]->b_seen = false;
+
+    /* Mark the programs that did not move */
+    uint16_t i_nit_pid = DISCOVERY_NIT_PID;
+    for (dvbpsi_pat_program_t *p = p_pat->p_first_program; p; p = p->p_next)
+    {
+        if (p->i_number == 0)
+        {
+            i_nit_pid = p->i_pid;
+            continue;
+        }
+
+        discovery_program_t *p_program = discovery_FindProgram(p_disc, p->i_number, p->i_pid);
+        if (p_program)
+            p_program->b_seen = true;
+    }
+
+    /* Remove the programs that left the PAT or changed PMT PID, the list
+     * stays consistent for the callback */
+    for (unsigned int i = 0; i < p_disc->i_programs; )
+    {
+        discovery_program_t *p_program = pp_old[i];
+        if (p_program->b_seen)
+        {
+            i++;
+            continue;
+        }
+
+        discovery_Raise(p_disc, DVBPSI_DISCOVERY_SERVICE_REMOVED, p_program);
+        if (p_disc->p_snap && !p_disc->b_seeding)
+            dvbpsi_snapshot_remove(p_disc->p_snap, p_disc->i_onid, p_disc->i_tsid,
+                                   p_program->service.i_pmt_pid, 0x02,
+                                   p_program->service.i_program_number);
+        discovery_SetLive(p_disc, &p_program->pmt_table, false);
+        p_disc->i_programs--;
+        memmove(&pp_old[i], &pp_old[i + 1],
+                (p_disc->i_programs - i) * sizeof(discovery_program_t *));
+        discovery_DeleteProgram(p_disc, p_program);
+    }
+    free(pp_old);
+    p_disc->pp_programs = NULL;
+    p_disc->i_programs = 0;
+
+    /* List the programs in PAT order and attach the new ones, b_seen is
+     * cleared once a program is listed so duplicate entries are skipped */
+    unsigned int i_new = 0;
+    for (dvbpsi_pat_program_t *p = p_pat->p_first_program; p; p = p->p_next)
+    {
+        if (p->i_number == 0)
+            continue;
+
+        discovery_program_t *p_program = discovery_FindProgram(p_disc, p->i_number, p->i_pid);
+        if (p_program == NULL)
+        {
+            p_program = discovery_AddProgram(p_disc, p->i_number, p->i_pid);
+            if (p_program == NULL)
+            {
+                dvbpsi_error(p_disc->p_pat_dvbpsi, "discovery",
+                             "unable to decode PMT of program %d on PID %d",
+                             p->i_number, p->i_pid);
+                continue;
+            }
+        }
+        else if (!p_program->b_seen)
+            continue;
+
+        p_program->b_seen = false;
+        pp_new[i_new++] = p_program;
+    }
+
+    p_disc->pp_programs = pp_new;
+    p_disc->i_programs = i_new;
+    p_disc->i_pmt_missing = 0;
+    for (unsigned int i = 0; i < i_new; i++)
+    {
+        if (pp_new[i]->p_pmt == NULL)
+            p_disc->i_pmt_missing++;
+    }
+
+    discovery_SetNITPID(p_disc, i_nit_pid);
+
+    if (p_disc->b_seeding)
+        discovery_SetCached(p_disc, &p_disc->pat_table);
+
+    dvbpsi_pat_t *p_old_pat = p_disc->p_pat;
+    p_disc->p_pat = p_pat;
+    p_disc->b_complete = false;
+    discovery_Raise(p_disc, DVBPSI_DISCOVERY_PAT, NULL);
+    if (p_old_pat)
+        dvbpsi_pat_delete(p_old_pat);
+
+    for (unsigned int i = 0; i < p_disc->i_programs; i++)
+    {
+        discovery_program_t *p_program = p_disc->pp_programs[i];
+        if (!p_program->b_added)
+            continue;
+        p_program->b_added = false;
+        discovery_Raise(p_disc, DVBPSI_DISCOVERY_SERVICE_ADDED, p_program);
+    }
+
+    discovery_CheckComplete(p_disc);
+    if (!p_disc->b_seeding)
+        discovery_SetLive(p_disc, &p_disc->pat_table, true);
+}
+
+/*****************************************************************************
+ * discovery_PMTCallback
+ *****************************************************************************
+ * Store the new PMT of a program.
+ *****************************************************************************/
+static void discovery_PMTCallback(void *p_cb_data, dvbpsi_pmt_t *p_pmt)
+{
+    discovery_program_t *p_program = (discovery_program_t *)p_cb_data;
+    dvbpsi_discovery_t *p_disc = p_program->p_disc;
+
+    if (!p_pmt->b_current_next)
+    {
+        dvbpsi_pmt_delete(p_pmt);
+        return;
+    }
+
+    dvbpsi_pmt_t *p_old = p_program->p_pmt;
+    if (p_old == NULL && p_disc->i_pmt_missing)
+        p_disc->i_pmt_missing--;
+
+    if (p_disc->b_seeding)
+        discovery_SetCached(p_disc, &p_program->pmt_table);
+
+    p_program->p_pmt = p_pmt;
+    p_program->service.p_pmt = p_pmt;
+    p_program->service.i_pmt_date = p_disc->i_date;
+    p_program->service.b_pmt_cached = p_disc->b_seeding;
+    discovery_Raise(p_disc, DVBPSI_DISCOVERY_PMT, p_program);
+    if (p_old)
+        dvbpsi_pmt_delete(p_old);
+
+    discovery_CheckComplete(p_disc);
+    if (!p_disc->b_seeding)
+        discovery_SetLive(p_disc, &p_program->pmt_table, true);
+}
+
+/*****************************************************************************
+ * discovery_SDTCallback
+ *****************************************************************************
+ * Store the new SDT and link its service descriptions to the programs.
+ *****************************************************************************/
+static void discovery_SDTCallback(void *p_cb_data, dvbpsi_sdt_t *p_sdt)
+{
+    dvbpsi_discovery_t *p_disc = (dvbpsi_discovery_t *)p_cb_data;
+
+    if (!p_sdt->b_current_next)
+    {
+        dvbpsi_sdt_delete(p_sdt);
+        return;
+    }
+
+    if (p_disc->b_seeding)
+        discovery_SetCached(p_disc, &p_disc->sdt_table);
+
+    dvbpsi_sdt_t *p_old = p_disc->p_sdt;
+    p_disc->p_sdt = p_sdt;
+    for (unsigned int i = 0; i < p_disc->i_programs; i++)
+    {
+        discovery_program_t *p_program = p_disc->pp_programs[i];
+        p_program->service.p_sdt_service =
+                discovery_FindSDTService(p_sdt, p_program->service.i_program_number);
+    }
+
+    discovery_Raise(p_disc, DVBPSI_DISCOVERY_SDT, NULL);
+    if (p_old)
+        dvbpsi_sdt_delete(p_old);
+
+    if (!p_disc->b_seeding)
+        discovery_SetLive(p_disc, &p_disc->sdt_table, true);
+}
+
+/*****************************************************************************
+ * discovery_NITCallback
+ *****************************************************************************
+ * Store the new NIT.
+ *****************************************************************************/
+static void discovery_NITCallback(void *p_cb_data, dvbpsi_nit_t *p_nit)
+{
+    dvbpsi_discovery_t *p_disc = (dvbpsi_discovery_t *)p_cb_data;
+
+    if (!p_nit->b_current_next)
+    {
+        dvbpsi_nit_delete(p_nit);
+        return;
+    }
+
+    dvbpsi_nit_t *p_old = p_disc->p_nit;
+    p_disc->p_nit = p_nit;
+    discovery_Raise(p_disc, DVBPSI_DISCOVERY_NIT, NULL);
+    if (p_old)
+        dvbpsi_nit_delete(p_old);
+}
+
+/*****************************************************************************
+ * dvbpsi_discovery_new
+ *****************************************************************************/
+dvbpsi_discovery_t *dvbpsi_discovery_new(dvbpsi_discovery_callback pf_callback,
+                                         void *p_cb_data, dvbpsi_message_cb pf_message,
+                                         enum dvbpsi_msg_level level)
+{
+    dvbpsi_discovery_t *p_disc = (dvbpsi_discovery_t *)calloc(1, sizeof(dvbpsi_discovery_t));
+    if (p_disc == NULL)
+        return NULL;
+
+    p_disc->pf_callback = pf_callback;
+    p_disc->p_cb_data = p_cb_data;
+    p_disc->pf_message = pf_message;
+    p_disc->i_msg_level = level;
+
+    p_disc->p_pat_dvbpsi = dvbpsi_new(pf_message, level);
+    if (p_disc->p_pat_dvbpsi == NULL)
+        goto error;
+    if (!dvbpsi_pat_attach(p_disc->p_pat_dvbpsi, discovery_PATCallback, p_disc))
+    {
+        dvbpsi_delete(p_disc->p_pat_dvbpsi);
+        p_disc->p_pat_dvbpsi = NULL;
+        goto error;
+    }
+    p_disc->p_pat_dvbpsi->pf_section = discovery_PATSection;
+    p_disc->p_pat_dvbpsi->p_sys = p_disc;
+
+    p_disc->p_sdt_dvbpsi = discovery_AttachDemux(p_disc, discovery_NewSDT);
+    if (p_disc->p_sdt_dvbpsi == NULL)
+        goto error;
+    p_disc->p_sdt_dvbpsi->pf_section = discovery_SDTSection;
+    p_disc->p_sdt_dvbpsi->p_sys = p_disc;
+
+    /* The NIT moves if the PAT announces another network_PID */
+    p_disc->i_nit_pid = DISCOVERY_NIT_PID;
+    p_disc->p_nit_dvbpsi = discovery_AttachDemux(p_disc, discovery_NewNIT);
+    if (p_disc->p_nit_dvbpsi == NULL)
+        goto error;
+
+    return p_disc;
+
+error:
+    dvbpsi_discovery_delete(p_disc);
+    return NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_discovery_delete
+ *****************************************************************************/
+void dvbpsi_discovery_delete(dvbpsi_discovery_t *p_disc)
+{
+    if (p_disc == NULL)
+        return;
+
+    for (unsigned int i = 0; i < p_disc->i_programs; i++)
+        discovery_DeleteProgram(p_disc, p_disc->pp_programs[i]);
+    free(p_disc->pp_programs);
+
+    if (p_disc->p_pat_dvbpsi)
+    {
+        dvbpsi_pat_detach(p_disc->p_pat_dvbpsi);
+        dvbpsi_delete(p_disc->p_pat_dvbpsi);
+    }
+    discovery_DetachDemux(p_disc->p_sdt_dvbpsi);
+    discovery_DetachDemux(p_disc->p_nit_dvbpsi);
+
+    if (p_disc->p_pat)
+        dvbpsi_pat_delete(p_disc->p_pat);
+    if (p_disc->p_sdt)
+        dvbpsi_sdt_delete(p_disc->p_sdt);
+    if (p_disc->p_nit)
+        dvbpsi_nit_delete(p_disc->p_nit);
+    free(p_disc);
+}
+
+/*****************************************************************************
+ * dvbpsi_discovery_packet_push
+ *****************************************************************************/
+void dvbpsi_discovery_packet_push(dvbpsi_discovery_t *p_disc,
+                                  const uint8_t *p_data, int64_t i_date)
+{
+    assert(p_disc);
+    assert(p_data);
+
+    const uint16_t i_pid = dvbpsi_ts_pid(p_data);
+    p_disc->i_date = i_date;
+
+    if (i_pid == DISCOVERY_PAT_PID)
+        dvbpsi_packet_push_date(p_disc->p_pat_dvbpsi, p_data, i_date);
+    else if (i_pid == DISCOVERY_SDT_PID)
+        dvbpsi_packet_push_date(p_disc->p_sdt_dvbpsi, p_data, i_date);
+
+    if (i_pid == p_disc->i_nit_pid && p_disc->p_nit_dvbpsi)
+        dvbpsi_packet_push_date(p_disc->p_nit_dvbpsi, p_data, i_date);
+
+    for (discovery_program_t *p_program = p_disc->pp_pids[i_pid];
+         p_program; p_program = p_program->p_next_pid)
+        dvbpsi_packet_push_date(p_program->p_dvbpsi, p_data, i_date);
+}
+
+/*****************************************************************************
+ * dvbpsi_discovery_packets_push
+ *****************************************************************************/
+void dvbpsi_discovery_packets_push(dvbpsi_discovery_t *p_disc, const uint8_t *p_data,
+                                   size_t i_packets, int64_t i_date)
+{
+    assert(p_disc);
+    assert(p_data);
+
+    for (size_t i = 0; i < i_packets; i++)
+    {
+        dvbpsi_discovery_packet_push(p_disc, p_data, i_date);
+        p_data += DVBPSI_TS_PACKET_SIZE;
+    }
+}
+
+/*****************************************************************************
+ * discovery_InjectSection
+ *****************************************************************************
+ * Feed a cached section to a decoder as if it had just been received.
+ *****************************************************************************/
+static bool discovery_InjectSection(dvbpsi_discovery_t *p_disc, dvbpsi_t *p_dvbpsi,
+                                    const uint8_t *p_data, size_t i_length)
+{
+    dvbpsi_psi_section_t *p_section = dvbpsi_NewPSISection(i_length);
+    if (p_section == NULL)
+        return false;
+
+    memcpy(p_section->p_data, p_data, i_length);
+    p_section->p_payload_end = p_section->p_data + i_length;
+    if (!dvbpsi_ValidPSISection(p_section))
+    {
+        dvbpsi_error(p_dvbpsi, "discovery", "bad CRC_32 in cached section");
+        dvbpsi_DeletePSISections(p_section);
+        return false;
+    }
+
+    p_section->i_first_date = p_disc->i_date;
+    p_section->i_complete_date = p_disc->i_date;
+    p_section->i_table_id = p_data[0];
+    p_section->b_syntax_indicator = p_data[1] & 0x80;
+    p_section->b_private_indicator = p_data[1] & 0x40;
+    p_section->i_extension = (p_data[3] << 8) | p_data[4];
+    p_section->i_version = (p_data[5] & 0x3e) >> 1;
+    p_section->b_current_next = p_data[5] & 0x1;
+    p_section->i_number = p_data[6];
+    p_section->i_last_number = p_data[7];
+    p_section->p_payload_start = p_section->p_data + 8;
+    p_section->p_payload_end -= 4;
+
+    p_dvbpsi->p_decoder->pf_gather(p_dvbpsi, p_section);
+    return true;
+}
+
+/*****************************************************************************
+ * discovery_SeedSection
+ *****************************************************************************
+ * dvbpsi_snapshot_foreach() callback, the PAT is decoded in a first pass so
+ * that the PMT decoders exist in the second one.
+ *****************************************************************************/
+typedef struct
+{
+    dvbpsi_discovery_t *p_disc;
+    bool                b_pat;
+    bool                b_sdt;      /* no live SDT yet */
+    unsigned int        i_count;
+} discovery_seed_t;
+
+static void discovery_SeedSection(void *p_cb_data, uint16_t i_pid,
+                                  const uint8_t *p_data, size_t i_length)
+{
+    discovery_seed_t *p_seed = (discovery_seed_t *)p_cb_data;
+    dvbpsi_discovery_t *p_disc = p_seed->p_disc;
+
+    if (p_seed->b_pat)
+    {
+        if (i_pid == DISCOVERY_PAT_PID && p_data[0] == 0x00 &&
+            discovery_InjectSection(p_disc, p_disc->p_pat_dvbpsi, p_data, i_length))
+            p_seed->i_count++;
+        return;
+    }
+
+    if (i_pid == DISCOVERY_SDT_PID && p_data[0] == 0x42)
+    {
+        if (p_seed->b_sdt &&
+            discovery_InjectSection(p_disc, p_disc->p_sdt_dvbpsi, p_data, i_length))
+            p_seed->i_count++;
+        return;
+    }
+
+    if (p_data[0] != 0x02)
+        return;
+
+    const uint16_t i_program_number = (p_data[3] << 8) | p_data[4];
+    discovery_program_t *p_program = discovery_FindProgram(p_disc, i_program_number, i_pid);
+    if (p_program && p_program->p_pmt == NULL &&
+        discovery_InjectSection(p_disc, p_program->p_dvbpsi, p_data, i_length))
+        p_seed->i_count++;
+}
+
+/*****************************************************************************
+ * dvbpsi_discovery_seed
+ *****************************************************************************/
+unsigned int dvbpsi_discovery_seed(dvbpsi_discovery_t *p_disc, dvbpsi_snapshot_t *p_snap,
+                                   uint16_t i_onid, uint16_t i_tsid)
+{
+    assert(p_disc);
+
+    /* Tables of the previous snapshot are no longer checked */
+    p_disc->pat_table.i_state = DISCOVERY_TABLE_LIVE;
+    p_disc->sdt_table.i_state = DISCOVERY_TABLE_LIVE;
+    for (unsigned int i = 0; i < p_disc->i_programs; i++)
+    {
+        p_disc->pp_programs[i]->pmt_table.i_state = DISCOVERY_TABLE_LIVE;
+        p_disc->pp_programs[i]->service.b_pmt_cached = false;
+    }
+    p_disc->i_cached = 0;
+
+    p_disc->p_snap = p_snap;
+    p_disc->i_onid = i_onid;
+    p_disc->i_tsid = i_tsid;
+    if (p_snap == NULL)
+        return 0;
+
+    discovery_seed_t seed;
+    seed.p_disc = p_disc;
+    seed.b_sdt = (p_disc->p_sdt == NULL);
+    seed.i_count = 0;
+
+    p_disc->b_seeding = true;
+    if (p_disc->p_pat == NULL)
+    {
+        seed.b_pat = true;
+        dvbpsi_snapshot_foreach(p_snap, i_onid, i_tsid, discovery_SeedSection, &seed);
+    }
+    seed.b_pat = false;
+    dvbpsi_snapshot_foreach(p_snap, i_onid, i_tsid, discovery_SeedSection, &seed);
+    p_disc->b_seeding = false;
+
+    return seed.i_count;
+}
+
+/*****************************************************************************
+ * dvbpsi_discovery_is_cached
+ *****************************************************************************/
+bool dvbpsi_discovery_is_cached(const dvbpsi_discovery_t *p_disc)
+{
+    assert(p_disc);
+    return p_disc->i_cached != 0;
+}
+
+/*****************************************************************************
+ * Service model accessors
+ *****************************************************************************/
+const dvbpsi_pat_t *dvbpsi_discovery_pat(const dvbpsi_discovery_t *p_disc)
+{
+    assert(p_disc);
+    return p_disc->p_pat;
+}
+
+const dvbpsi_sdt_t *dvbpsi_discovery_sdt(const dvbpsi_discovery_t *p_disc)
+{
+    assert(p_disc);
+    return p_disc->p_sdt;
+}
+
+const dvbpsi_nit_t *dvbpsi_discovery_nit(const dvbpsi_discovery_t *p_disc)
+{
+    assert(p_disc);
+    return p_disc->p_nit;
+}
+
+unsigned int dvbpsi_discovery_service_count(const dvbpsi_discovery_t *p_disc)
+{
+    assert(p_disc);
+    return p_disc->i_programs;
+}
+
+const dvbpsi_discovery_service_t *dvbpsi_discovery_service_get(const dvbpsi_discovery_t *p_disc,
+                                                               unsigned int i_index)
+{
+    assert(p_disc);
+    if (i_index >= p_disc->i_programs)
+        return NULL;
+    return &p_disc->pp_programs[i_index]->service;
+}
+
+const dvbpsi_discovery_service_t *dvbpsi_discovery_service_find(const dvbpsi_discovery_t *p_disc,
+                                                                uint16_t i_program_number)
+{
+    assert(p_disc);
+    for (unsigned int i = 0; i < p_disc->i_programs; i++)
+    {
+        if (p_disc->pp_programs[i]->service.i_program_number == i_program_number)
+            return &p_disc->pp_programs[i]->service;
+    }
+    return NULL;
+}
@@ -0,0 +1,296 @@
+/*****************************************************************************
+ * discovery.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <discovery.h>
+ * \brief Application interface for the service discovery engine.
+ *
+ * The service discovery engine owns the PAT, PMT, SDT and NIT decoders of a
+ * transport stream. It attaches a PMT decoder for each program announced in
+ * the PAT as soon as the PAT is decoded, detaches it when the program
+ * disappears from the PAT, routes TS packets to the decoders by PID and
+ * publishes the resulting list of services.
+ *
+ * On a channel change the engine can be seeded from a PSI snapshot cache
+ * (snapshot.h): the cached PAT, PMTs and SDT are decoded immediately, then
+ * confirmed or superseded by the live sections.
+ *
+ * dvbpsi.h, descriptor.h, snapshot.h, tables/pat.h, tables/pmt.h,
+ * tables/sdt.h and tables/nit.h must be included before this file. All dates
+ * are expressed in microseconds.
+ */
+
+#ifndef _DVBPSI_DISCOVERY_H_
+#define _DVBPSI_DISCOVERY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * dvbpsi_discovery_event_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_discovery_event_e
+ * \brief Reason of a service discovery callback.
+ */
+/*!
+ * \typedef enum dvbpsi_discovery_event_e dvbpsi_discovery_event_t
+ * \brief dvbpsi_discovery_event_t type definition.
+ */
+typedef enum dvbpsi_discovery_event_e
+{
+    DVBPSI_DISCOVERY_PAT = 0,           /*!< a new PAT has been decoded */
+    DVBPSI_DISCOVERY_SERVICE_ADDED,     /*!< a program appeared in the PAT */
+    DVBPSI_DISCOVERY_SERVICE_REMOVED,   /*!< a program disappeared from the PAT,
+                                             this is the last callback for it */
+    DVBPSI_DISCOVERY_PMT,               /*!< a new PMT has been decoded */
+    DVBPSI_DISCOVERY_SDT,               /*!< a new SDT actual has been decoded */
+    DVBPSI_DISCOVERY_NIT,               /*!< a new NIT actual has been decoded */
+    DVBPSI_DISCOVERY_COMPLETE,          /*!< the PMTs of all programs of the
+                                             current PAT are known */
+    DVBPSI_DISCOVERY_LIVE,              /*!< all tables decoded from the
+                                             snapshot have been confirmed or
+                                             superseded by live sections */
+} dvbpsi_discovery_event_t;
+
+/*****************************************************************************
+ * dvbpsi_discovery_service_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_discovery_service_s
+ * \brief Service of the transport stream.
+ *
+ * The tables are owned by the engine. A table pointer stays valid until the
+ * callback announcing its replacement has returned.
+ */
+/*!
+ * \typedef struct dvbpsi_discovery_service_s dvbpsi_discovery_service_t
+ * \brief dvbpsi_discovery_service_t type definition.
+ */
+typedef struct dvbpsi_discovery_service_s
+{
+    uint16_t                    i_program_number;   /*!< program_number */
+    uint16_t                    i_pmt_pid;          /*!< PID of the PMT */
+
+    const dvbpsi_pmt_t         *p_pmt;              /*!< last PMT, NULL until
+                                                         it is received */
+    const dvbpsi_sdt_service_t *p_sdt_service;      /*!< description in the last
+                                                         SDT, NULL if none */
+
+    int64_t                     i_added_date;       /*!< date of the PAT that
+                                                         announced the program */
+    int64_t                     i_pmt_date;         /*!< date of the last PMT */
+    bool                        b_pmt_cached;       /*!< p_pmt comes from the
+                                                         snapshot and has not
+                                                         been confirmed yet */
+} dvbpsi_discovery_service_t;
+
+/*****************************************************************************
+ * dvbpsi_discovery_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_discovery_s dvbpsi_discovery_t
+ * \brief Opaque service discovery engine handle.
+ */
+typedef struct dvbpsi_discovery_s dvbpsi_discovery_t;
+
+/*****************************************************************************
+ * dvbpsi_discovery_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_discovery_callback)(void *p_cb_data,
+                            dvbpsi_discovery_t *p_disc, dvbpsi_discovery_event_t i_event,
+                            const dvbpsi_discovery_service_t *p_service)
+ * \brief Callback type definition.
+ *
+ * p_service is NULL for DVBPSI_DISCOVERY_PAT, DVBPSI_DISCOVERY_SDT,
+ * DVBPSI_DISCOVERY_NIT, DVBPSI_DISCOVERY_COMPLETE and DVBPSI_DISCOVERY_LIVE.
+ * The callback must not delete the engine.
+ */
+typedef void (* dvbpsi_discovery_callback)(void *p_cb_data, dvbpsi_discovery_t *p_disc,
+                                           dvbpsi_discovery_event_t i_event,
+                                           const dvbpsi_discovery_service_t *p_service);
+
+/*****************************************************************************
+ * dvbpsi_discovery_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_discovery_t *dvbpsi_discovery_new(dvbpsi_discovery_callback pf_callback,
+                        void *p_cb_data, dvbpsi_message_cb pf_message,
+                        enum dvbpsi_msg_level level)
+ * \brief Create a service discovery engine for one transport stream.
+ * \param pf_callback function to call back on each event
+ * \param p_cb_data private data given in argument to the callback
+ * \param pf_message message callback handler for the decoders, may be NULL
+ * \param level enum dvbpsi_msg_level for filtering logging messages
+ * \return pointer to the engine, NULL on error.
+ */
+dvbpsi_discovery_t *dvbpsi_discovery_new(dvbpsi_discovery_callback pf_callback,
+                                         void *p_cb_data, dvbpsi_message_cb pf_message,
+                                         enum dvbpsi_msg_level level);
+
+/*****************************************************************************
+ * dvbpsi_discovery_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_discovery_delete(dvbpsi_discovery_t *p_disc)
+ * \brief Destroy a service discovery engine and all its decoders.
+ * \param p_disc pointer to the engine
+ * \return nothing.
+ */
+void dvbpsi_discovery_delete(dvbpsi_discovery_t *p_disc);
+
+/*****************************************************************************
+ * dvbpsi_discovery_packet_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_discovery_packet_push(dvbpsi_discovery_t *p_disc,
+                                         const uint8_t *p_data, int64_t i_date)
+ * \brief Inject one TS packet into the engine.
+ * \param p_disc pointer to the engine
+ * \param p_data pointer to a 188 bytes TS packet
+ * \param i_date arrival date of the packet, 0 if unknown
+ * \return nothing.
+ *
+ * Packets of PIDs without a decoder are dropped after a single table
+ * lookup, so the whole transport stream can be pushed.
+ */
+void dvbpsi_discovery_packet_push(dvbpsi_discovery_t *p_disc,
+                                  const uint8_t *p_data, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_discovery_packets_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_discovery_packets_push(dvbpsi_discovery_t *p_disc,
+                      const uint8_t *p_data, size_t i_packets, int64_t i_date)
+ * \brief Inject a buffer of TS packets received at the same time.
+ * \param p_disc pointer to the engine
+ * \param p_data pointer to i_packets * 188 bytes of TS packets
+ * \param i_packets number of TS packets in p_data
+ * \param i_date arrival date of the buffer, 0 if unknown
+ * \return nothing.
+ */
+void dvbpsi_discovery_packets_push(dvbpsi_discovery_t *p_disc, const uint8_t *p_data,
+                                   size_t i_packets, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_discovery_seed
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_discovery_seed(dvbpsi_discovery_t *p_disc,
+                        dvbpsi_snapshot_t *p_snap, uint16_t i_onid, uint16_t i_tsid)
+ * \brief Bind a snapshot cache and decode the cached tables.
+ * \param p_disc pointer to the engine
+ * \param p_snap pointer to the snapshot cache, NULL to unbind it
+ * \param i_onid original_network_id of the tuned transport stream
+ * \param i_tsid transport_stream_id of the tuned transport stream
+ * \return number of cached sections decoded.
+ *
+ * The cached PAT, PMTs and SDT of (i_onid, i_tsid) are decoded before this
+ * function returns and the usual callbacks are called, tables that were
+ * already received live are not overridden. Each live section of a cached
+ * table is compared with the cached one: an identical section confirms the
+ * table, a different one forces the live table to be decoded and delivered
+ * even if its version_number did not change. Live PAT, PMT and SDT actual
+ * sections are stored in the cache under (i_onid, i_tsid) while it is bound.
+ * The cache must outlive the engine or be unbound first.
+ */
+unsigned int dvbpsi_discovery_seed(dvbpsi_discovery_t *p_disc, dvbpsi_snapshot_t *p_snap,
+                                   uint16_t i_onid, uint16_t i_tsid);
+
+/*****************************************************************************
+ * dvbpsi_discovery_is_cached
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_discovery_is_cached(const dvbpsi_discovery_t *p_disc)
+ * \brief Tell if some tables still come from the snapshot.
+ * \param p_disc pointer to the engine
+ * \return true until all tables decoded from the snapshot have been
+ * confirmed or superseded by live sections.
+ */
+bool dvbpsi_discovery_is_cached(const dvbpsi_discovery_t *p_disc);
+
+/*****************************************************************************
+ * Service model accessors
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_pat_t *dvbpsi_discovery_pat(const dvbpsi_discovery_t *p_disc)
+ * \brief Last decoded PAT.
+ * \param p_disc pointer to the engine
+ * \return the PAT, NULL if none has been received yet.
+ */
+const dvbpsi_pat_t *dvbpsi_discovery_pat(const dvbpsi_discovery_t *p_disc);
+
+/*!
+ * \fn const dvbpsi_sdt_t *dvbpsi_discovery_sdt(const dvbpsi_discovery_t *p_disc)
+ * \brief Last decoded SDT actual.
+ * \param p_disc pointer to the engine
+ * \return the SDT, NULL if none has been received yet.
+ */
+const dvbpsi_sdt_t *dvbpsi_discovery_sdt(const dvbpsi_discovery_t *p_disc);
+
+/*!
+ * \fn const dvbpsi_nit_t *dvbpsi_discovery_nit(const dvbpsi_discovery_t *p_disc)
+ * \brief Last decoded NIT actual.
+ * \param p_disc pointer to the engine
+ * \return the NIT, NULL if none has been received yet.
+ */
+const dvbpsi_nit_t *dvbpsi_discovery_nit(const dvbpsi_discovery_t *p_disc);
+
+/*!
+ * \fn unsigned int dvbpsi_discovery_service_count(const dvbpsi_discovery_t *p_disc)
+ * \brief Number of services of the current PAT.
+ * \param p_disc pointer to the engine
+ * \return number of services.
+ */
+unsigned int dvbpsi_discovery_service_count(const dvbpsi_discovery_t *p_disc);
+
+/*!
+ * \fn const dvbpsi_discovery_service_t *dvbpsi_discovery_service_get(
+                        const dvbpsi_discovery_t *p_disc, unsigned int i_index)
+ * \brief Get a service by index, in PAT order.
+ * \param p_disc pointer to the engine
+ * \param i_index index of the service
+ * \return the service, NULL if i_index is out of range.
+ */
+const dvbpsi_discovery_service_t *dvbpsi_discovery_service_get(const dvbpsi_discovery_t *p_disc,
+                                                               unsigned int i_index);
+
+/*!
+ * \fn const dvbpsi_discovery_service_t *dvbpsi_discovery_service_find(
+                        const dvbpsi_discovery_t *p_disc, uint16_t i_program_number)
+ * \brief Get a service by program_number.
+ * \param p_disc pointer to the engine
+ * \param i_program_number program_number (service_id)
+ * \return the service, NULL if it is not in the current PAT.
+ */
+const dvbpsi_discovery_service_t *dvbpsi_discovery_service_find(const dvbpsi_discovery_t *p_disc,
+                                                                uint16_t i_program_number);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of discovery.h"
+#endif
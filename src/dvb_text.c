@@ -0,0 +1,1008 @@
+/*****************************************************************************
+ * dvb_text.c: DVB text to UTF-8 converter
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvb_text.h"
+#include "dvb_text_gb2312.h"
+
+#define TEXT_REPLACEMENT    0xfffd
+
+#define TEXT_ASCII_HIGH     UINT64_C(0x8080808080808080)
+#define TEXT_ASCII_BIAS     UINT64_C(0x6060606060606060)   /* 0x20 + 0x60 = 0x80 */
+#define TEXT_ASCII_DEL      UINT64_C(0x0101010101010101)   /* 0x7f + 0x01 = 0x80 */
+
+#define TEXT_CACHE_MIN_BUCKETS  64
+
+/*****************************************************************************
+ * Character tables
+ *****************************************************************************/
+/* ISO/IEC 6937 as in EN 300 468 figure A.1, code points of 0xa0 to 0xff,
+ * 0 if unmapped. 0xc1 to 0xcf are non-spacing diacritical marks that
+ * precede the letter they apply to. */
+static const uint16_t pi_iso6937[96] =
+{
+    0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x20ac, 0x00a5, 0x0023, 0x00a7,
+    0x00a4, 0x2018, 0x201c, 0x00ab, 0x2190, 0x2191, 0x2192, 0x2193,
+    0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00d7, 0x00b5, 0x00b6, 0x00b7,
+    0x00f7, 0x2019, 0x201d, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x2015, 0x00b9, 0x00ae, 0x00a9, 0x2122, 0x266a, 0x00ac, 0x00a6,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x215b, 0x215c, 0x215d, 0x215e,
+    0x2126, 0x00c6, 0x0110, 0x00aa, 0x0126, 0x0000, 0x0132, 0x013f,
+    0x0141, 0x00d8, 0x0152, 0x00ba, 0x00de, 0x0166, 0x014a, 0x0149,
+    0x0138, 0x00e6, 0x0111, 0x00f0, 0x0127, 0x0131, 0x0133, 0x0140,
+    0x0142, 0x00f8, 0x0153, 0x00df, 0x00fe, 0x0167, 0x014b, 0x00ad
+};
+
+/* Combining character of each diacritical mark 0xc1 to 0xcf */
+static const uint16_t pi_iso6937_mark[15] =
+{
+    0x0300, 0x0301, 0x0302, 0x0303, 0x0304, 0x0306, 0x0307, 0x0308,
+    0x0000, 0x030a, 0x0327, 0x0000, 0x030b, 0x0328, 0x030c
+};
+
+/* Precomposed letter of each diacritical mark and letter A-Z a-z, 0 if
+ * there is none */
+static const uint16_t pi_iso6937_composed[15][52] =
+{
+    /* 0xc1 */
+    {
+        0x00c0, 0x0000, 0x0000, 0x0000, 0x00c8, 0x0000, 0x0000, 0x0000,
+        0x00cc, 0x0000, 0x0000, 0x0000, 0x0000, 0x01f8, 0x00d2, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x00d9, 0x0000, 0x1e80, 0x0000,
+        0x1ef2, 0x0000, 0x00e0, 0x0000, 0x0000, 0x0000, 0x00e8, 0x0000,
+        0x0000, 0x0000, 0x00ec, 0x0000, 0x0000, 0x0000, 0x0000, 0x01f9,
+        0x00f2, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00f9, 0x0000,
+        0x1e81, 0x0000, 0x1ef3, 0x0000
+    },
+    /* 0xc2 */
+    {
+        0x00c1, 0x0000, 0x0106, 0x0000, 0x00c9, 0x0000, 0x01f4, 0x0000,
+        0x00cd, 0x0000, 0x1e30, 0x0139, 0x1e3e, 0x0143, 0x00d3, 0x1e54,
+        0x0000, 0x0154, 0x015a, 0x0000, 0x00da, 0x0000, 0x1e82, 0x0000,
+        0x00dd, 0x0179, 0x00e1, 0x0000, 0x0107, 0x0000, 0x00e9, 0x0000,
+        0x01f5, 0x0000, 0x00ed, 0x0000, 0x1e31, 0x013a, 0x1e3f, 0x0144,
+        0x00f3, 0x1e55, 0x0000, 0x0155, 0x015b, 0x0000, 0x00fa, 0x0000,
+        0x1e83, 0x0000, 0x00fd, 0x017a
+    },
+    /* 0xc3 */
+    {
+        0x00c2, 0x0000, 0x0108, 0x0000, 0x00ca, 0x0000, 0x011c, 0x0124,
+        0x00ce, 0x0134, 0x0000, 0x0000, 0x0000, 0x0000, 0x00d4, 0x0000,
+        0x0000, 0x0000, 0x015c, 0x0000, 0x00db, 0x0000, 0x0174, 0x0000,
+        0x0176, 0x1e90, 0x00e2, 0x0000, 0x0109, 0x0000, 0x00ea, 0x0000,
+        0x011d, 0x0125, 0x00ee, 0x0135, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x00f4, 0x0000, 0x0000, 0x0000, 0x015d, 0x0000, 0x00fb, 0x0000,
+        0x0175, 0x0000, 0x0177, 0x1e91
+    },
+    /* 0xc4 */
+    {
+        0x00c3, 0x0000, 0x0000, 0x0000, 0x1ebc, 0x0000, 0x0000, 0x0000,
+        0x0128, 0x0000, 0x0000, 0x0000, 0x0000, 0x00d1, 0x00d5, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0168, 0x1e7c, 0x0000, 0x0000,
+        0x1ef8, 0x0000, 0x00e3, 0x0000, 0x0000, 0x0000, 0x1ebd, 0x0000,
+        0x0000, 0x0000, 0x0129, 0x0000, 0x0000, 0x0000, 0x0000, 0x00f1,
+        0x00f5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0169, 0x1e7d,
+        0x0000, 0x0000, 0x1ef9, 0x0000
+    },
+    /* 0xc5 */
+    {
+        0x0100, 0x0000, 0x0000, 0x0000, 0x0112, 0x0000, 0x1e20, 0x0000,
+        0x012a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x014c, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x016a, 0x0000, 0x0000, 0x0000,
+        0x0232, 0x0000, 0x0101, 0x0000, 0x0000, 0x0000, 0x0113, 0x0000,
+        0x1e21, 0x0000, 0x012b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x014d, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x016b, 0x0000,
+        0x0000, 0x0000, 0x0233, 0x0000
+    },
+    /* 0xc6 */
+    {
+        0x0102, 0x0000, 0x0000, 0x0000, 0x0114, 0x0000, 0x011e, 0x0000,
+        0x012c, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x014e, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x016c, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0103, 0x0000, 0x0000, 0x0000, 0x0115, 0x0000,
+        0x011f, 0x0000, 0x012d, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x014f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x016d, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 0xc7 */
+    {
+        0x0226, 0x1e02, 0x010a, 0x1e0a, 0x0116, 0x1e1e, 0x0120, 0x1e22,
+        0x0130, 0x0000, 0x0000, 0x0000, 0x1e40, 0x1e44, 0x022e, 0x1e56,
+        0x0000, 0x1e58, 0x1e60, 0x1e6a, 0x0000, 0x0000, 0x1e86, 0x1e8a,
+        0x1e8e, 0x017b, 0x0227, 0x1e03, 0x010b, 0x1e0b, 0x0117, 0x1e1f,
+        0x0121, 0x1e23, 0x0000, 0x0000, 0x0000, 0x0000, 0x1e41, 0x1e45,
+        0x022f, 0x1e57, 0x0000, 0x1e59, 0x1e61, 0x1e6b, 0x0000, 0x0000,
+        0x1e87, 0x1e8b, 0x1e8f, 0x017c
+    },
+    /* 0xc8 */
+    {
+        0x00c4, 0x0000, 0x0000, 0x0000, 0x00cb, 0x0000, 0x0000, 0x1e26,
+        0x00cf, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00d6, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x00dc, 0x0000, 0x1e84, 0x1e8c,
+        0x0178, 0x0000, 0x00e4, 0x0000, 0x0000, 0x0000, 0x00eb, 0x0000,
+        0x0000, 0x1e27, 0x00ef, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x00f6, 0x0000, 0x0000, 0x0000, 0x0000, 0x1e97, 0x00fc, 0x0000,
+        0x1e85, 0x1e8d, 0x00ff, 0x0000
+    },
+    /* 0xc9 */
+    {
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 0xca */
+    {
+        0x00c5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x016e, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x00e5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x016f, 0x0000,
+        0x1e98, 0x0000, 0x1e99, 0x0000
+    },
+    /* 0xcb */
+    {
+        0x0000, 0x0000, 0x00c7, 0x1e10, 0x0228, 0x0000, 0x0122, 0x1e28,
+        0x0000, 0x0000, 0x0136, 0x013b, 0x0000, 0x0145, 0x0000, 0x0000,
+        0x0000, 0x0156, 0x015e, 0x0162, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x00e7, 0x1e11, 0x0229, 0x0000,
+        0x0123, 0x1e29, 0x0000, 0x0000, 0x0137, 0x013c, 0x0000, 0x0146,
+        0x0000, 0x0000, 0x0000, 0x0157, 0x015f, 0x0163, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 0xcc */
+    {
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 0xcd */
+    {
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0150, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0170, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0151, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0171, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 0xce */
+    {
+        0x0104, 0x0000, 0x0000, 0x0000, 0x0118, 0x0000, 0x0000, 0x0000,
+        0x012e, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01ea, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0172, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0105, 0x0000, 0x0000, 0x0000, 0x0119, 0x0000,
+        0x0000, 0x0000, 0x012f, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x01eb, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0173, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 0xcf */
+    {
+        0x01cd, 0x0000, 0x010c, 0x010e, 0x011a, 0x0000, 0x01e6, 0x021e,
+        0x01cf, 0x0000, 0x01e8, 0x013d, 0x0000, 0x0147, 0x01d1, 0x0000,
+        0x0000, 0x0158, 0x0160, 0x0164, 0x01d3, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x017d, 0x01ce, 0x0000, 0x010d, 0x010f, 0x011b, 0x0000,
+        0x01e7, 0x021f, 0x01d0, 0x01f0, 0x01e9, 0x013e, 0x0000, 0x0148,
+        0x01d2, 0x0000, 0x0000, 0x0159, 0x0161, 0x0165, 0x01d4, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x017e
+    }
+};
+
+/* ISO/IEC 8859-1 to 8859-15, code points of 0xa0 to 0xff, 0 if unmapped */
+static const uint16_t pi_iso8859[15][96] =
+{
+    /* 8859-1 */
+    {
+        0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+        0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+        0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+        0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+        0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+        0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+        0x00d0, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+        0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x00de, 0x00df,
+        0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+        0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+        0x00f0, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+        0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0x00ff
+    },
+    /* 8859-2 */
+    {
+        0x00a0, 0x0104, 0x02d8, 0x0141, 0x00a4, 0x013d, 0x015a, 0x00a7,
+        0x00a8, 0x0160, 0x015e, 0x0164, 0x0179, 0x00ad, 0x017d, 0x017b,
+        0x00b0, 0x0105, 0x02db, 0x0142, 0x00b4, 0x013e, 0x015b, 0x02c7,
+        0x00b8, 0x0161, 0x015f, 0x0165, 0x017a, 0x02dd, 0x017e, 0x017c,
+        0x0154, 0x00c1, 0x00c2, 0x0102, 0x00c4, 0x0139, 0x0106, 0x00c7,
+        0x010c, 0x00c9, 0x0118, 0x00cb, 0x011a, 0x00cd, 0x00ce, 0x010e,
+        0x0110, 0x0143, 0x0147, 0x00d3, 0x00d4, 0x0150, 0x00d6, 0x00d7,
+        0x0158, 0x016e, 0x00da, 0x0170, 0x00dc, 0x00dd, 0x0162, 0x00df,
+        0x0155, 0x00e1, 0x00e2, 0x0103, 0x00e4, 0x013a, 0x0107, 0x00e7,
+        0x010d, 0x00e9, 0x0119, 0x00eb, 0x011b, 0x00ed, 0x00ee, 0x010f,
+        0x0111, 0x0144, 0x0148, 0x00f3, 0x00f4, 0x0151, 0x00f6, 0x00f7,
+        0x0159, 0x016f, 0x00fa, 0x0171, 0x00fc, 0x00fd, 0x0163, 0x02d9
+    },
+    /* 8859-3 */
+    {
+        0x00a0, 0x0126, 0x02d8, 0x00a3, 0x00a4, 0x0000, 0x0124, 0x00a7,
+        0x00a8, 0x0130, 0x015e, 0x011e, 0x0134, 0x00ad, 0x0000, 0x017b,
+        0x00b0, 0x0127, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x0125, 0x00b7,
+        0x00b8, 0x0131, 0x015f, 0x011f, 0x0135, 0x00bd, 0x0000, 0x017c,
+        0x00c0, 0x00c1, 0x00c2, 0x0000, 0x00c4, 0x010a, 0x0108, 0x00c7,
+        0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+        0x0000, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x0120, 0x00d6, 0x00d7,
+        0x011c, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x016c, 0x015c, 0x00df,
+        0x00e0, 0x00e1, 0x00e2, 0x0000, 0x00e4, 0x010b, 0x0109, 0x00e7,
+        0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+        0x0000, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x0121, 0x00f6, 0x00f7,
+        0x011d, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x016d, 0x015d, 0x02d9
+    },
+    /* 8859-4 */
+    {
+        0x00a0, 0x0104, 0x0138, 0x0156, 0x00a4, 0x0128, 0x013b, 0x00a7,
+        0x00a8, 0x0160, 0x0112, 0x0122, 0x0166, 0x00ad, 0x017d, 0x00af,
+        0x00b0, 0x0105, 0x02db, 0x0157, 0x00b4, 0x0129, 0x013c, 0x02c7,
+        0x00b8, 0x0161, 0x0113, 0x0123, 0x0167, 0x014a, 0x017e, 0x014b,
+        0x0100, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x012e,
+        0x010c, 0x00c9, 0x0118, 0x00cb, 0x0116, 0x00cd, 0x00ce, 0x012a,
+        0x0110, 0x0145, 0x014c, 0x0136, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+        0x00d8, 0x0172, 0x00da, 0x00db, 0x00dc, 0x0168, 0x016a, 0x00df,
+        0x0101, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x012f,
+        0x010d, 0x00e9, 0x0119, 0x00eb, 0x0117, 0x00ed, 0x00ee, 0x012b,
+        0x0111, 0x0146, 0x014d, 0x0137, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+        0x00f8, 0x0173, 0x00fa, 0x00fb, 0x00fc, 0x0169, 0x016b, 0x02d9
+    },
+    /* 8859-5 */
+    {
+        0x00a0, 0x0401, 0x0402, 0x0403, 0x0404, 0x0405, 0x0406, 0x0407,
+        0x0408, 0x0409, 0x040a, 0x040b, 0x040c, 0x00ad, 0x040e, 0x040f,
+        0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+        0x0418, 0x0419, 0x041a, 0x041b, 0x041c, 0x041d, 0x041e, 0x041f,
+        0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+        0x0428, 0x0429, 0x042a, 0x042b, 0x042c, 0x042d, 0x042e, 0x042f,
+        0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+        0x0438, 0x0439, 0x043a, 0x043b, 0x043c, 0x043d, 0x043e, 0x043f,
+        0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+        0x0448, 0x0449, 0x044a, 0x044b, 0x044c, 0x044d, 0x044e, 0x044f,
+        0x2116, 0x0451, 0x0452, 0x0453, 0x0454, 0x0455, 0x0456, 0x0457,
+        0x0458, 0x0459, 0x045a, 0x045b, 0x045c, 0x00a7, 0x045e, 0x045f
+    },
+    /* 8859-6 */
+    {
+        0x00a0, 0x0000, 0x0000, 0x0000, 0x00a4, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x060c, 0x00ad, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x061b, 0x0000, 0x0000, 0x0000, 0x061f,
+        0x0000, 0x0621, 0x0622, 0x0623, 0x0624, 0x0625, 0x0626, 0x0627,
+        0x0628, 0x0629, 0x062a, 0x062b, 0x062c, 0x062d, 0x062e, 0x062f,
+        0x0630, 0x0631, 0x0632, 0x0633, 0x0634, 0x0635, 0x0636, 0x0637,
+        0x0638, 0x0639, 0x063a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0640, 0x0641, 0x0642, 0x0643, 0x0644, 0x0645, 0x0646, 0x0647,
+        0x0648, 0x0649, 0x064a, 0x064b, 0x064c, 0x064d, 0x064e, 0x064f,
+        0x0650, 0x0651, 0x0652, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 8859-7 */
+    {
+        0x00a0, 0x2018, 0x2019, 0x00a3, 0x20ac, 0x20af, 0x00a6, 0x00a7,
+        0x00a8, 0x00a9, 0x037a, 0x00ab, 0x00ac, 0x00ad, 0x0000, 0x2015,
+        0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x0384, 0x0385, 0x0386, 0x00b7,
+        0x0388, 0x0389, 0x038a, 0x00bb, 0x038c, 0x00bd, 0x038e, 0x038f,
+        0x0390, 0x0391, 0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397,
+        0x0398, 0x0399, 0x039a, 0x039b, 0x039c, 0x039d, 0x039e, 0x039f,
+        0x03a0, 0x03a1, 0x0000, 0x03a3, 0x03a4, 0x03a5, 0x03a6, 0x03a7,
+        0x03a8, 0x03a9, 0x03aa, 0x03ab, 0x03ac, 0x03ad, 0x03ae, 0x03af,
+        0x03b0, 0x03b1, 0x03b2, 0x03b3, 0x03b4, 0x03b5, 0x03b6, 0x03b7,
+        0x03b8, 0x03b9, 0x03ba, 0x03bb, 0x03bc, 0x03bd, 0x03be, 0x03bf,
+        0x03c0, 0x03c1, 0x03c2, 0x03c3, 0x03c4, 0x03c5, 0x03c6, 0x03c7,
+        0x03c8, 0x03c9, 0x03ca, 0x03cb, 0x03cc, 0x03cd, 0x03ce, 0x0000
+    },
+    /* 8859-8 */
+    {
+        0x00a0, 0x0000, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+        0x00a8, 0x00a9, 0x00d7, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+        0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+        0x00b8, 0x00b9, 0x00f7, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x2017,
+        0x05d0, 0x05d1, 0x05d2, 0x05d3, 0x05d4, 0x05d5, 0x05d6, 0x05d7,
+        0x05d8, 0x05d9, 0x05da, 0x05db, 0x05dc, 0x05dd, 0x05de, 0x05df,
+        0x05e0, 0x05e1, 0x05e2, 0x05e3, 0x05e4, 0x05e5, 0x05e6, 0x05e7,
+        0x05e8, 0x05e9, 0x05ea, 0x0000, 0x0000, 0x200e, 0x200f, 0x0000
+    },
+    /* 8859-9 */
+    {
+        0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+        0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+        0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+        0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+        0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+        0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+        0x011e, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+        0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x0130, 0x015e, 0x00df,
+        0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+        0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+        0x011f, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+        0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x0131, 0x015f, 0x00ff
+    },
+    /* 8859-10 */
+    {
+        0x00a0, 0x0104, 0x0112, 0x0122, 0x012a, 0x0128, 0x0136, 0x00a7,
+        0x013b, 0x0110, 0x0160, 0x0166, 0x017d, 0x00ad, 0x016a, 0x014a,
+        0x00b0, 0x0105, 0x0113, 0x0123, 0x012b, 0x0129, 0x0137, 0x00b7,
+        0x013c, 0x0111, 0x0161, 0x0167, 0x017e, 0x2015, 0x016b, 0x014b,
+        0x0100, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x012e,
+        0x010c, 0x00c9, 0x0118, 0x00cb, 0x0116, 0x00cd, 0x00ce, 0x00cf,
+        0x00d0, 0x0145, 0x014c, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x0168,
+        0x00d8, 0x0172, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x00de, 0x00df,
+        0x0101, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x012f,
+        0x010d, 0x00e9, 0x0119, 0x00eb, 0x0117, 0x00ed, 0x00ee, 0x00ef,
+        0x00f0, 0x0146, 0x014d, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x0169,
+        0x00f8, 0x0173, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0x0138
+    },
+    /* 8859-11 */
+    {
+        0x00a0, 0x0e01, 0x0e02, 0x0e03, 0x0e04, 0x0e05, 0x0e06, 0x0e07,
+        0x0e08, 0x0e09, 0x0e0a, 0x0e0b, 0x0e0c, 0x0e0d, 0x0e0e, 0x0e0f,
+        0x0e10, 0x0e11, 0x0e12, 0x0e13, 0x0e14, 0x0e15, 0x0e16, 0x0e17,
+        0x0e18, 0x0e19, 0x0e1a, 0x0e1b, 0x0e1c, 0x0e1d, 0x0e1e, 0x0e1f,
+        0x0e20, 0x0e21, 0x0e22, 0x0e23, 0x0e24, 0x0e25, 0x0e26, 0x0e27,
+        0x0e28, 0x0e29, 0x0e2a, 0x0e2b, 0x0e2c, 0x0e2d, 0x0e2e, 0x0e2f,
+        0x0e30, 0x0e31, 0x0e32, 0x0e33, 0x0e34, 0x0e35, 0x0e36, 0x0e37,
+        0x0e38, 0x0e39, 0x0e3a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0e3f,
+        0x0e40, 0x0e41, 0x0e42, 0x0e43, 0x0e44, 0x0e45, 0x0e46, 0x0e47,
+        0x0e48, 0x0e49, 0x0e4a, 0x0e4b, 0x0e4c, 0x0e4d, 0x0e4e, 0x0e4f,
+        0x0e50, 0x0e51, 0x0e52, 0x0e53, 0x0e54, 0x0e55, 0x0e56, 0x0e57,
+        0x0e58, 0x0e59, 0x0e5a, 0x0e5b, 0x0000, 0x0000, 0x0000, 0x0000
+    },
+    /* 8859-12 does not exist */
+    { 0 },
+    /* 8859-13 */
+    {
+        0x00a0, 0x201d, 0x00a2, 0x00a3, 0x00a4, 0x201e, 0x00a6, 0x00a7,
+        0x00d8, 0x00a9, 0x0156, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00c6,
+        0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x201c, 0x00b5, 0x00b6, 0x00b7,
+        0x00f8, 0x00b9, 0x0157, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00e6,
+        0x0104, 0x012e, 0x0100, 0x0106, 0x00c4, 0x00c5, 0x0118, 0x0112,
+        0x010c, 0x00c9, 0x0179, 0x0116, 0x0122, 0x0136, 0x012a, 0x013b,
+        0x0160, 0x0143, 0x0145, 0x00d3, 0x014c, 0x00d5, 0x00d6, 0x00d7,
+        0x0172, 0x0141, 0x015a, 0x016a, 0x00dc, 0x017b, 0x017d, 0x00df,
+        0x0105, 0x012f, 0x0101, 0x0107, 0x00e4, 0x00e5, 0x0119, 0x0113,
+        0x010d, 0x00e9, 0x017a, 0x0117, 0x0123, 0x0137, 0x012b, 0x013c,
+        0x0161, 0x0144, 0x0146, 0x00f3, 0x014d, 0x00f5, 0x00f6, 0x00f7,
+        0x0173, 0x0142, 0x015b, 0x016b, 0x00fc, 0x017c, 0x017e, 0x2019
+    },
+    /* 8859-14 */
+    {
+        0x00a0, 0x1e02, 0x1e03, 0x00a3, 0x010a, 0x010b, 0x1e0a, 0x00a7,
+        0x1e80, 0x00a9, 0x1e82, 0x1e0b, 0x1ef2, 0x00ad, 0x00ae, 0x0178,
+        0x1e1e, 0x1e1f, 0x0120, 0x0121, 0x1e40, 0x1e41, 0x00b6, 0x1e56,
+        0x1e81, 0x1e57, 0x1e83, 0x1e60, 0x1ef3, 0x1e84, 0x1e85, 0x1e61,
+        0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+        0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+        0x0174, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x1e6a,
+        0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x0176, 0x00df,
+        0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+        0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+        0x0175, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x1e6b,
+        0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x0177, 0x00ff
+    },
+    /* 8859-15 */
+    {
+        0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x20ac, 0x00a5, 0x0160, 0x00a7,
+        0x0161, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+        0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x017d, 0x00b5, 0x00b6, 0x00b7,
+        0x017e, 0x00b9, 0x00ba, 0x00bb, 0x0152, 0x0153, 0x0178, 0x00bf,
+        0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+        0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+        0x00d0, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+        0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x00de, 0x00df,
+        0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+        0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+        0x00f0, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+        0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0x00ff
+    }
+};
+
+/*****************************************************************************
+ * text_output_t
+ *****************************************************************************
+ * UTF-8 output, i_size includes the NUL.
+ *****************************************************************************/
+typedef struct text_output_s
+{
+    char       *p_buffer;
+    size_t      i_size;
+    size_t      i_length;
+    bool        b_full;
+} text_output_t;
+
+static void text_PutMultiByte(text_output_t *p_out, uint32_t i_code)
+{
+    uint8_t p_utf8[4];
+    size_t i_bytes;
+
+    if (i_code < 0x800)
+    {
+        p_utf8[0] = 0xc0 | (i_code >> 6);
+        p_utf8[1] = 0x80 | (i_code & 0x3f);
+        i_bytes = 2;
+    }
+    else if (i_code < 0x10000)
+    {
+        p_utf8[0] = 0xe0 | (i_code >> 12);
+        p_utf8[1] = 0x80 | ((i_code >> 6) & 0x3f);
+        p_utf8[2] = 0x80 | (i_code & 0x3f);
+        i_bytes = 3;
+    }
+    else
+    {
+        p_utf8[0] = 0xf0 | (i_code >> 18);
+        p_utf8[1] = 0x80 | ((i_code >> 12) & 0x3f);
+        p_utf8[2] = 0x80 | ((i_code >> 6) & 0x3f);
+        p_utf8[3] = 0x80 | (i_code & 0x3f);
+        i_bytes = 4;
+    }
+
+    if (p_out->i_length + i_bytes >= p_out->i_size)
+    {
+        p_out->b_full = true;
+        return;
+    }
+
+    memcpy(p_out->p_buffer + p_out->i_length, p_utf8, i_bytes);
+    p_out->i_length += i_bytes;
+}
+
+static inline void text_Put(text_output_t *p_out, uint32_t i_code)
+{
+    if (p_out->b_full)
+        return;
+
+    if (i_code >= 0x80)
+        text_PutMultiByte(p_out, i_code);
+    else if (p_out->i_length + 1 < p_out->i_size)
+        p_out->p_buffer[p_out->i_length++] = i_code;
+    else
+        p_out->b_full = true;
+}
+
+/*****************************************************************************
+ * text_PutUnicode
+ *****************************************************************************
+ * Output a character of the multi-byte tables: C0 controls, DEL and the
+ * emphasis controls (U+E086, U+E087) are dropped, CR/LF (U+E08A) becomes a
+ * line feed.
+ *****************************************************************************/
+static void text_PutUnicode(text_output_t *p_out, uint32_t i_code)
+{
+    if (i_code < 0x20 || i_code == 0x7f || (i_code >= 0xe080 && i_code <= 0xe09f))
+    {
+        if (i_code == 0xe08a)
+            text_Put(p_out, '\n');
+        return;
+    }
+    text_Put(p_out, i_code);
+}
+
+/*****************************************************************************
+ * text_CopyAscii
+ *****************************************************************************
+ * Copy a run of printable ASCII characters (0x20 to 0x7e), 8 bytes at a
+ * time while both the input and the output have room.
+ *****************************************************************************/
+static const uint8_t *text_CopyAscii(text_output_t *p_out, const uint8_t *p_data,
+                                     const uint8_t *p_end)
+{
+    while (p_end - p_data >= 8 && p_out->i_length + 8 < p_out->i_size)
+    {
+        uint64_t i_word;
+        memcpy(&i_word, p_data, 8);
+        if ((i_word & TEXT_ASCII_HIGH) ||
+            ((i_word + TEXT_ASCII_BIAS) & TEXT_ASCII_HIGH) != TEXT_ASCII_HIGH ||
+            ((i_word + TEXT_ASCII_DEL) & TEXT_ASCII_HIGH))
+            break;
+        memcpy(p_out->p_buffer + p_out->i_length, p_data, 8);
+        p_out->i_length += 8;
+        p_data += 8;
+    }
+
+    while (p_data < p_end && *p_data >= 0x20 && *p_data < 0x7f)
+    {
+        if (p_out->i_length + 1 >= p_out->i_size)
+        {
+            p_out->b_full = true;
+            return p_end;
+        }
+        p_out->p_buffer[p_out->i_length++] = *p_data++;
+    }
+
+    return p_data;
+}
+
+/*****************************************************************************
+ * text_SingleByte
+ *****************************************************************************
+ * ISO/IEC 6937 and ISO/IEC 8859 tables.
+ *****************************************************************************/
+static void text_SingleByte(text_output_t *p_out, const uint8_t *p_data,
+                            const uint8_t *p_end, const uint16_t *pi_table, bool b_iso6937)
+{
+    while (p_data < p_end && !p_out->b_full)
+    {
+        p_data = text_CopyAscii(p_out, p_data, p_end);
+        if (p_data == p_end)
+            break;
+
+        uint8_t i_byte = *p_data++;
+        if (i_byte < 0xa0)
+        {
+            /* C0 and C1 controls, only CR/LF is kept */
+            if (i_byte == 0x8a)
+                text_Put(p_out, '\n');
+            continue;
+        }
+
+        if (b_iso6937 && i_byte >= 0xc1 && i_byte <= 0xcf)
+        {
+            uint16_t i_mark = pi_iso6937_mark[i_byte - 0xc1];
+            if (p_data < p_end)
+            {
+                uint8_t i_letter = *p_data;
+                int i_index = -1;
+                if (i_letter >= 'A' && i_letter <= 'Z')
+                    i_index = i_letter - 'A';
+                else if (i_letter >= 'a' && i_letter <= 'z')
+                    i_index = 26 + i_letter - 'a';
+
+                if (i_index >= 0)
+                {
+                    uint16_t i_composed = pi_iso6937_composed[i_byte - 0xc1][i_index];
+                    p_data++;
+                    if (i_composed)
+                        text_Put(p_out, i_composed);
+                    else
+                    {
+                        text_Put(p_out, i_letter);
+                        if (i_mark)
+                            text_Put(p_out, i_mark);
+                    }
+                    continue;
+                }
+            }
+            if (i_mark)
+                text_Put(p_out, i_mark);
+            continue;
+        }
+
+        uint16_t i_code = pi_table[i_byte - 0xa0];
+        text_Put(p_out, i_code ? i_code : TEXT_REPLACEMENT);
+    }
+}
+
+/*****************************************************************************
+ * text_Utf16
+ *****************************************************************************
+ * ISO/IEC 10646, big endian.
+ *****************************************************************************/
+static void text_Utf16(text_output_t *p_out, const uint8_t *p_data, const uint8_t *p_end)
+{
+    while (p_end - p_data >= 2 && !p_out->b_full)
+    {
+        uint32_t i_code = ((uint32_t)p_data[0] << 8) | p_data[1];
+        p_data += 2;
+
+        if (i_code >= 0xd800 && i_code < 0xe000)
+        {
+            uint32_t i_low = p_end - p_data >= 2 ?
+                             ((uint32_t)p_data[0] << 8) | p_data[1] : 0;
+            if (i_code < 0xdc00 && i_low >= 0xdc00 && i_low < 0xe000)
+            {
+                i_code = 0x10000 + ((i_code - 0xd800) << 10) + (i_low - 0xdc00);
+                p_data += 2;
+            }
+            else
+                i_code = TEXT_REPLACEMENT;
+        }
+        text_PutUnicode(p_out, i_code);
+    }
+}
+
+/*****************************************************************************
+ * text_Utf8
+ *****************************************************************************
+ * UTF-8, invalid sequences are replaced byte by byte.
+ *****************************************************************************/
+static void text_Utf8(text_output_t *p_out, const uint8_t *p_data, const uint8_t *p_end)
+{
+    while (p_data < p_end && !p_out->b_full)
+    {
+        p_data = text_CopyAscii(p_out, p_data, p_end);
+        if (p_data == p_end)
+            break;
+
+        uint8_t i_byte = *p_data++;
+        uint32_t i_code, i_min;
+        unsigned int i_follow;
+
+        if (i_byte < 0x80)
+        {
+            text_PutUnicode(p_out, i_byte);
+            continue;
+        }
+        else if (i_byte >= 0xc2 && i_byte < 0xe0)
+        {
+            i_code = i_byte & 0x1f;
+            i_follow = 1;
+            i_min = 0x80;
+        }
+        else if (i_byte >= 0xe0 && i_byte < 0xf0)
+        {
+            i_code = i_byte & 0x0f;
+            i_follow = 2;
+            i_min = 0x800;
+        }
+        else if (i_byte >= 0xf0 && i_byte < 0xf5)
+        {
+            i_code = i_byte & 0x07;
+            i_follow = 3;
+            i_min = 0x10000;
+        }
+        else
+        {
+            text_Put(p_out, TEXT_REPLACEMENT);
+            continue;
+        }
+
+        if ((size_t)(p_end - p_data) < i_follow)
+        {
+            text_Put(p_out, TEXT_REPLACEMENT);
+            break;
+        }
+
+        unsigned int i;
+        for (i = 0; i < i_follow && (p_data[i] & 0xc0) == 0x80; i++)
+            i_code = (i_code << 6) | (p_data[i] & 0x3f);
+
+        if (i < i_follow || i_code < i_min || i_code > 0x10ffff ||
+            (i_code >= 0xd800 && i_code < 0xe000))
+        {
+            text_Put(p_out, TEXT_REPLACEMENT);
+            continue;
+        }
+
+        p_data += i_follow;
+        text_PutUnicode(p_out, i_code);
+    }
+}
+
+/*****************************************************************************
+ * text_Gb2312
+ *****************************************************************************
+ * GB-2312, EUC-CN encoded.
+ *****************************************************************************/
+static void text_Gb2312(text_output_t *p_out, const uint8_t *p_data, const uint8_t *p_end)
+{
+    while (p_data < p_end && !p_out->b_full)
+    {
+        p_data = text_CopyAscii(p_out, p_data, p_end);
+        if (p_data == p_end)
+            break;
+
+        uint8_t i_row = *p_data++;
+        if (i_row < 0x80)
+            continue;   /* C0 controls */
+
+        if (p_data == p_end)
+        {
+            text_Put(p_out, TEXT_REPLACEMENT);
+            break;
+        }
+
+        uint8_t i_cell = *p_data;
+        uint16_t i_code = 0;
+        if (i_row >= GB2312_FIRST_ROW && i_row <= GB2312_LAST_ROW &&
+            i_cell >= GB2312_FIRST_CELL && i_cell <= GB2312_LAST_CELL)
+        {
+            i_code = pi_gb2312[(i_row - GB2312_FIRST_ROW) * GB2312_CELLS +
+                               i_cell - GB2312_FIRST_CELL];
+            p_data++;
+        }
+        text_Put(p_out, i_code ? i_code : TEXT_REPLACEMENT);
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_to_utf8
+ *****************************************************************************/
+bool dvbpsi_dvb_text_to_utf8(const uint8_t *p_data, size_t i_length,
+                             char *p_buffer, size_t i_size, size_t *pi_length)
+{
+    text_output_t out = { p_buffer, i_size, 0, false };
+    const uint8_t *p_end = p_data + i_length;
+    bool b_supported = true;
+
+    if (i_size == 0)
+    {
+        if (pi_length)
+            *pi_length = 0;
+        return i_length == 0;
+    }
+
+    if (i_length > 0)
+    {
+        uint8_t i_table = p_data[0];
+
+        if (i_table >= 0x20)
+            text_SingleByte(&out, p_data, p_end, pi_iso6937, true);
+        else if (i_table >= 0x01 && i_table <= 0x0b && i_table != 0x08)
+            text_SingleByte(&out, p_data + 1, p_end, pi_iso8859[i_table + 3], false);
+        else if (i_table == 0x10 && i_length >= 3 && p_data[1] == 0x00 &&
+                 p_data[2] >= 1 && p_data[2] <= 15 && p_data[2] != 12)
+            text_SingleByte(&out, p_data + 3, p_end, pi_iso8859[p_data[2] - 1], false);
+        else if (i_table == 0x11)
+            text_Utf16(&out, p_data + 1, p_end);
+        else if (i_table == 0x13)
+            text_Gb2312(&out, p_data + 1, p_end);
+        else if (i_table == 0x15)
+            text_Utf8(&out, p_data + 1, p_end);
+        else
+            b_supported = false;    /* KS X 1001, Big5, encoding_type_id */
+    }
+
+    p_buffer[out.i_length] = '\0';
+    if (pi_length)
+        *pi_length = out.i_length;
+    return b_supported && !out.b_full;
+}
+
+/*****************************************************************************
+ * text_cache_entry_t
+ *****************************************************************************
+ * Converted string, followed in memory by the raw string it comes from.
+ *****************************************************************************/
+typedef struct text_cache_entry_s
+{
+    struct text_cache_entry_s  *p_next_hash;
+    struct text_cache_entry_s  *p_prev_lru;     /* more recently released */
+    struct text_cache_entry_s  *p_next_lru;     /* less recently released */
+
+    uint32_t                    i_hash;
+    unsigned int                i_refcount;
+    const uint8_t              *p_raw;
+    size_t                      i_raw;
+    char                        psz_text[];
+} text_cache_entry_t;
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_s
+ *****************************************************************************/
+struct dvbpsi_dvb_text_cache_s
+{
+    unsigned int            i_max_strings;
+    unsigned int            i_unreferenced;
+
+    unsigned int            i_buckets;      /* power of 2 */
+    text_cache_entry_t    **pp_buckets;
+    text_cache_entry_t     *p_lru_first;    /* most recently released */
+    text_cache_entry_t     *p_lru_last;     /* least recently released */
+};
+
+/*****************************************************************************
+ * cache_Hash
+ *****************************************************************************
+ * FNV-1a of the raw string.
+ *****************************************************************************/
+static uint32_t cache_Hash(const uint8_t *p_data, size_t i_length)
+{
+    uint32_t i_hash = UINT32_C(2166136261);
+    for (size_t i = 0; i < i_length; i++)
+        i_hash = (i_hash ^ p_data[i]) * UINT32_C(16777619);
+    return i_hash;
+}
+
+/*****************************************************************************
+ * cache_Unlink
+ *****************************************************************************
+ * Remove an unreferenced entry from the LRU list.
+ *****************************************************************************/
+static void cache_Unlink(dvbpsi_dvb_text_cache_t *p_cache, text_cache_entry_t *p_entry)
+{
+    if (p_entry->p_prev_lru)
+        p_entry->p_prev_lru->p_next_lru = p_entry->p_next_lru;
+    else
+        p_cache->p_lru_first = p_entry->p_next_lru;
+    if (p_entry->p_next_lru)
+        p_entry->p_next_lru->p_prev_lru = p_entry->p_prev_lru;
+    else
+        p_cache->p_lru_last = p_entry->p_prev_lru;
+    p_entry->p_prev_lru = p_entry->p_next_lru = NULL;
+    p_cache->i_unreferenced--;
+}
+
+/*****************************************************************************
+ * cache_Delete
+ *****************************************************************************
+ * Remove an unreferenced entry from the cache and free it.
+ *****************************************************************************/
+static void cache_Delete(dvbpsi_dvb_text_cache_t *p_cache, text_cache_entry_t *p_entry)
+{
+    text_cache_entry_t **pp = &p_cache->pp_buckets[p_entry->i_hash & (p_cache->i_buckets - 1)];
+    while (*pp != p_entry)
+        pp = &(*pp)->p_next_hash;
+    *pp = p_entry->p_next_hash;
+
+    cache_Unlink(p_cache, p_entry);
+    free(p_entry);
+}
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_new
+ *****************************************************************************/
+dvbpsi_dvb_text_cache_t *dvbpsi_dvb_text_cache_new(unsigned int i_max_strings)
+{
+    dvbpsi_dvb_text_cache_t *p_cache = (dvbpsi_dvb_text_cache_t *)
+                                       calloc(1, sizeof(dvbpsi_dvb_text_cache_t));
+    if (p_cache == NULL)
+        return NULL;
+
+    p_cache->i_max_strings = i_max_strings;
+    p_cache->i_buckets = TEXT_CACHE_MIN_BUCKETS;
+    while (p_cache->i_buckets < i_max_strings && p_cache->i_buckets < (1u << 20))
+        p_cache->i_buckets <<= 1;
+
+    p_cache->pp_buckets = (text_cache_entry_t **)calloc(p_cache->i_buckets,
+                                                        sizeof(text_cache_entry_t *));
+    if (p_cache->pp_buckets == NULL)
+    {
+        free(p_cache);
+        return NULL;
+    }
+    return p_cache;
+}
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_delete
+ *****************************************************************************/
+void dvbpsi_dvb_text_cache_delete(dvbpsi_dvb_text_cache_t *p_cache)
+{
+    if (p_cache == NULL)
+        return;
+
+    for (unsigned int i = 0; i < p_cache->i_buckets; i++)
+    {
+        text_cache_entry_t *p_entry = p_cache->pp_buckets[i];
+        while (p_entry)
+        {
+            text_cache_entry_t *p_next = p_entry->p_next_hash;
+            free(p_entry);
+            p_entry = p_next;
+        }
+    }
+    free(p_cache->pp_buckets);
+    free(p_cache);
+}
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_get
+ *****************************************************************************/
+const char *dvbpsi_dvb_text_cache_get(dvbpsi_dvb_text_cache_t *p_cache,
+                                      const uint8_t *p_data, size_t i_length)
+{
+    assert(p_cache);
+
+    uint32_t i_hash = cache_Hash(p_data, i_length);
+    text_cache_entry_t **pp_bucket = &p_cache->pp_buckets[i_hash & (p_cache->i_buckets - 1)];
+
+    for (text_cache_entry_t *p_entry = *pp_bucket; p_entry; p_entry = p_entry->p_next_hash)
+    {
+        if (p_entry->i_hash != i_hash || p_entry->i_raw != i_length ||
+            memcmp(p_entry->p_raw, p_data, i_length))
+            continue;
+
+        if (p_entry->i_refcount++ == 0)
+            cache_Unlink(p_cache, p_entry);
+        return p_entry->psz_text;
+    }
+
+    /* Convert in place, then shrink to the text and the raw string */
+    size_t i_max = DVBPSI_DVB_TEXT_MAX_UTF8(i_length);
+    text_cache_entry_t *p_entry = (text_cache_entry_t *)
+                                  malloc(sizeof(text_cache_entry_t) + i_max + i_length);
+    if (p_entry == NULL)
+        return NULL;
+
+    size_t i_text;
+    dvbpsi_dvb_text_to_utf8(p_data, i_length, p_entry->psz_text, i_max, &i_text);
+    memcpy(p_entry->psz_text + i_text + 1, p_data, i_length);
+
+    text_cache_entry_t *p_shrunk = (text_cache_entry_t *)
+            realloc(p_entry, sizeof(text_cache_entry_t) + i_text + 1 + i_length);
+    if (p_shrunk)
+        p_entry = p_shrunk;
+
+    p_entry->p_prev_lru = p_entry->p_next_lru = NULL;
+    p_entry->i_hash = i_hash;
+    p_entry->i_refcount = 1;
+    p_entry->p_raw = (const uint8_t *)p_entry->psz_text + i_text + 1;
+    p_entry->i_raw = i_length;
+    p_entry->p_next_hash = *pp_bucket;
+    *pp_bucket = p_entry;
+
+    return p_entry->psz_text;
+}
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_release
+ *****************************************************************************/
+void dvbpsi_dvb_text_cache_release(dvbpsi_dvb_text_cache_t *p_cache, const char *psz_text)
+{
+    assert(p_cache);
+
+    if (psz_text == NULL)
+        return;
+
+    text_cache_entry_t *p_entry = (text_cache_entry_t *)
+            ((uintptr_t)psz_text - offsetof(text_cache_entry_t, psz_text));
+    assert(p_entry->i_refcount > 0);
+
+    if (--p_entry->i_refcount > 0)
+        return;
+
+    p_entry->p_next_lru = p_cache->p_lru_first;
+    if (p_cache->p_lru_first)
+        p_cache->p_lru_first->p_prev_lru = p_entry;
+    p_cache->p_lru_first = p_entry;
+    if (p_cache->p_lru_last == NULL)
+        p_cache->p_lru_last = p_entry;
+    p_cache->i_unreferenced++;
+
+    while (p_cache->i_unreferenced > p_cache->i_max_strings)
+        cache_Delete(p_cache, p_cache->p_lru_last);
+}
@@ -0,0 +1,140 @@
+/*****************************************************************************
+ * dvb_text.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <dvb_text.h>
+ * \brief Application interface for the DVB text to UTF-8 converter.
+ *
+ * Names and texts of the DVB descriptors (network name, bouquet name,
+ * service, short and extended event descriptors) are coded as described in
+ * ETSI EN 300 468 Annex A: the first byte selects the character table,
+ * ISO/IEC 6937 being the default. The converter supports ISO/IEC 6937
+ * (with the euro sign at 0xa4), ISO/IEC 8859-1 to 8859-15, ISO/IEC 10646
+ * (UTF-16), GB-2312 and UTF-8. The emphasis control codes are dropped and
+ * the CR/LF control code becomes a line feed.
+ *
+ * Runs of printable ASCII are copied 8 bytes at a time. The optional cache
+ * keeps the converted text of the strings seen recently, so that the names
+ * repeated in every SDT and EIT are converted once.
+ */
+
+#ifndef _DVBPSI_DVB_TEXT_H_
+#define _DVBPSI_DVB_TEXT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Size of a buffer large enough for the conversion of i_length bytes */
+#define DVBPSI_DVB_TEXT_MAX_UTF8(i_length) (3 * (size_t)(i_length) + 1)
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_to_utf8
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_dvb_text_to_utf8(const uint8_t *p_data, size_t i_length,
+                                    char *p_buffer, size_t i_size, size_t *pi_length)
+ * \brief Convert an EN 300 468 Annex A string to UTF-8.
+ * \param p_data string, character table selection included
+ * \param i_length length of p_data
+ * \param p_buffer buffer receiving the NUL terminated UTF-8 text
+ * \param i_size size of p_buffer, DVBPSI_DVB_TEXT_MAX_UTF8(i_length) is
+ * always enough
+ * \param pi_length set to the length of the text without the NUL, may be
+ * NULL
+ * \return true on success, false if the character table is not supported
+ * (the text is then empty) or if the text was cut on a character boundary
+ * to fit in p_buffer.
+ */
+bool dvbpsi_dvb_text_to_utf8(const uint8_t *p_data, size_t i_length,
+                             char *p_buffer, size_t i_size, size_t *pi_length);
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_dvb_text_cache_s dvbpsi_dvb_text_cache_t
+ * \brief Opaque conversion cache handle.
+ */
+typedef struct dvbpsi_dvb_text_cache_s dvbpsi_dvb_text_cache_t;
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_dvb_text_cache_t *dvbpsi_dvb_text_cache_new(unsigned int i_max_strings)
+ * \brief Create a conversion cache.
+ * \param i_max_strings number of unreferenced strings kept, the least
+ * recently used one is dropped when the limit is reached
+ * \return pointer to the cache, NULL on error.
+ */
+dvbpsi_dvb_text_cache_t *dvbpsi_dvb_text_cache_new(unsigned int i_max_strings);
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_dvb_text_cache_delete(dvbpsi_dvb_text_cache_t *p_cache)
+ * \brief Destroy a conversion cache and all its strings, referenced or not.
+ * \param p_cache pointer to the cache
+ * \return nothing.
+ */
+void dvbpsi_dvb_text_cache_delete(dvbpsi_dvb_text_cache_t *p_cache);
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_get
+ *****************************************************************************/
+/*!
+ * \fn const char *dvbpsi_dvb_text_cache_get(dvbpsi_dvb_text_cache_t *p_cache,
+                                             const uint8_t *p_data, size_t i_length)
+ * \brief Get the UTF-8 text of an EN 300 468 Annex A string.
+ * \param p_cache pointer to the cache
+ * \param p_data string, character table selection included
+ * \param i_length length of p_data
+ * \return a reference to the NUL terminated text, shared by all identical
+ * strings, NULL on allocation error. The text of an unsupported character
+ * table is empty.
+ *
+ * Each reference must be given back with dvbpsi_dvb_text_cache_release().
+ */
+const char *dvbpsi_dvb_text_cache_get(dvbpsi_dvb_text_cache_t *p_cache,
+                                      const uint8_t *p_data, size_t i_length);
+
+/*****************************************************************************
+ * dvbpsi_dvb_text_cache_release
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_dvb_text_cache_release(dvbpsi_dvb_text_cache_t *p_cache,
+                                          const char *psz_text)
+ * \brief Give back a reference obtained with dvbpsi_dvb_text_cache_get().
+ * \param p_cache pointer to the cache
+ * \param psz_text text to release, may be NULL
+ * \return nothing.
+ */
+void dvbpsi_dvb_text_cache_release(dvbpsi_dvb_text_cache_t *p_cache, const char *psz_text);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of dvb_text.h"
+#endif
@@ -68,6 +68,7 @@ void dvbpsi_delete(dvbpsi_t *p_dvbpsi)
     if (p_dvbpsi) {
         assert(p_dvbpsi->p_decoder == NULL);
         p_dvbpsi->pf_message = NULL;
+        free(p_dvbpsi->p_latency);
     }
     free(p_dvbpsi);
 }
@@ -236,6 +237,102 @@ void dvbpsi_decoder_delete(dvbpsi_decoder_t *p_decoder)
     free(p_decoder);
 }
 
+/*****************************************************************************
+ * dvbpsi_decoder_table_complete
+ *****************************************************************************/
+void dvbpsi_decoder_table_complete(dvbpsi_t *p_dvbpsi,
+                                   const dvbpsi_psi_section_t *p_sections)
+{
+    assert(p_dvbpsi);
+    assert(p_sections);
+
+    dvbpsi_table_timing_t *p_timing = &p_dvbpsi->last_table;
+    p_timing->i_table_id = p_sections->i_table_id;
+    p_timing->i_extension = p_sections->i_extension;
+    p_timing->i_first_date = p_sections->i_first_date;
+    p_timing->i_complete_date = p_sections->i_complete_date;
+
+    for (const dvbpsi_psi_section_t *p = p_sections->p_next; p; p = p->p_next)
+    {
+        if (p->i_first_date < p_timing->i_first_date)
+            p_timing->i_first_date = p->i_first_date;
+        if (p->i_complete_date > p_timing->i_complete_date)
+            p_timing->i_complete_date = p->i_complete_date;
+    }
+
+    if (p_dvbpsi->p_latency == NULL)
+        return;
+
+    dvbpsi_latency_histogram_t *p_histo = &p_dvbpsi->p_latency[p_timing->i_table_id];
+    int64_t i_latency = p_timing->i_complete_date - p_timing->i_first_date;
+    if (i_latency < 0)
+        i_latency = 0;
+
+    if (p_histo->i_count == 0 || i_latency < p_histo->i_min)
+        p_histo->i_min = i_latency;
+    if (p_histo->i_count == 0 || i_latency > p_histo->i_max)
+        p_histo->i_max = i_latency;
+    p_histo->i_count++;
+    p_histo->i_total += i_latency;
+
+    /* Bucket 0 is below 1 ms, bucket n covers [2^(n-1), 2^n[ ms */
+    unsigned int i_bucket = 0;
+    for (int64_t i_ms = i_latency / 1000; i_ms > 0; i_ms >>= 1)
+        i_bucket++;
+    if (i_bucket >= DVBPSI_LATENCY_BUCKETS)
+        i_bucket = DVBPSI_LATENCY_BUCKETS - 1;
+    p_histo->pi_buckets[i_bucket]++;
+}
+
+/*****************************************************************************
+ * dvbpsi_set_loss_tolerant
+ *****************************************************************************/
+void dvbpsi_set_loss_tolerant(dvbpsi_t *p_dvbpsi, bool b_tolerant)
+{
+    assert(p_dvbpsi);
+
+    p_dvbpsi->b_loss_tolerant = b_tolerant;
+}
+
+/*****************************************************************************
+ * dvbpsi_latency_enable
+ *****************************************************************************/
+bool dvbpsi_latency_enable(dvbpsi_t *p_dvbpsi)
+{
+    assert(p_dvbpsi);
+
+    if (p_dvbpsi->p_latency)
+        return true;
+
+    p_dvbpsi->p_latency = (dvbpsi_latency_histogram_t *)
+                    calloc(256, sizeof(dvbpsi_latency_histogram_t));
+    return (p_dvbpsi->p_latency != NULL);
+}
+
+/*****************************************************************************
+ * dvbpsi_latency_disable
+ *****************************************************************************/
+void dvbpsi_latency_disable(dvbpsi_t *p_dvbpsi)
+{
+    assert(p_dvbpsi);
+
+    free(p_dvbpsi->p_latency);
+    p_dvbpsi->p_latency = NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_latency_get
+ *****************************************************************************/
+const dvbpsi_latency_histogram_t *dvbpsi_latency_get(const dvbpsi_t *p_dvbpsi,
+                                                     uint8_t i_table_id)
+{
+    assert(p_dvbpsi);
+
+    if (p_dvbpsi->p_latency == NULL)
+        return NULL;
+    return &p_dvbpsi->p_latency[i_table_id];
+}
+
 /*****************************************************************************
  * dvbpsi_decoder_present
  *****************************************************************************/
@@ -248,11 +345,85 @@ bool dvbpsi_decoder_present(dvbpsi_t *p_dvbpsi)
 }
 
 /*****************************************************************************
- * dvbpsi_packet_push
+ * dvbpsi_CompleteSection
+ *****************************************************************************
+ * Parse the header of a complete section, check its CRC_32 if b_check_crc
+ * and hand it over to the decoder. The section is trashed when invalid.
+ *****************************************************************************/
+static bool dvbpsi_CompleteSection(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section,
+                                   bool b_check_crc)
+{
+    dvbpsi_decoder_t *p_decoder = p_dvbpsi->p_decoder;
+    bool b_valid_crc32 = false;
+    bool has_crc32;
+
+    p_section->i_table_id = p_section->p_data[0];
+    p_section->b_syntax_indicator = p_section->p_data[1] & 0x80;
+    p_section->b_private_indicator = p_section->p_data[1] & 0x40;
+
+    /* Update the end of the payload if CRC_32 is present */
+    has_crc32 = dvbpsi_has_CRC32(p_section);
+    if (p_section->b_syntax_indicator || has_crc32)
+        p_section->p_payload_end -= 4;
+
+    DVBPSI_TRACE3(section__complete, p_dvbpsi, p_section->i_table_id,
+                  p_section->p_payload_end - p_section->p_data);
+
+    /* Check CRC32 if present */
+    if (has_crc32 && b_check_crc)
+    {
+        b_valid_crc32 = dvbpsi_ValidPSISection(p_section);
+        DVBPSI_TRACE3(section__crc, p_dvbpsi, p_section->i_table_id,
+                      b_valid_crc32);
+    }
+
+    if (!has_crc32 || !b_check_crc || b_valid_crc32)
+    {
+        /* PSI section is valid */
+        if (p_section->b_syntax_indicator)
+        {
+            p_section->i_extension =  (p_section->p_data[3] << 8)
+                                     | p_section->p_data[4];
+            p_section->i_version = (p_section->p_data[5] & 0x3e) >> 1;
+            p_section->b_current_next = p_section->p_data[5] & 0x1;
+            p_section->i_number = p_section->p_data[6];
+            p_section->i_last_number = p_section->p_data[7];
+            p_section->p_payload_start = p_section->p_data + 8;
+        }
+        else
+        {
+            p_section->i_extension = 0;
+            p_section->i_version = 0;
+            p_section->b_current_next = true;
+            p_section->i_number = 0;
+            p_section->i_last_number = 0;
+            p_section->p_payload_start = p_section->p_data + 3;
+        }
+        if (p_dvbpsi->pf_section)
+            p_dvbpsi->pf_section(p_dvbpsi, p_section, true);
+        if (p_decoder->pf_gather)
+            p_decoder->pf_gather(p_dvbpsi, p_section);
+        else
+            dvbpsi_DeletePSISections(p_section);
+        return true;
+    }
+
+    dvbpsi_error(p_dvbpsi, "misc PSI", "Bad CRC_32 table 0x%x !!!",
+                           p_section->p_data[0]);
+    if (p_dvbpsi->pf_section)
+        p_dvbpsi->pf_section(p_dvbpsi, p_section, false);
+
+    /* PSI section isn't valid => trash it */
+    dvbpsi_DeletePSISections(p_section);
+    return false;
+}
+
+/*****************************************************************************
+ * dvbpsi_PushPacket
  *****************************************************************************
  * Injection of a TS packet into a PSI decoder.
  *****************************************************************************/
-bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
+static bool dvbpsi_PushPacket(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
 {
     uint8_t i_expected_counter;           /* Expected continuity counter */
     dvbpsi_psi_section_t* p_section;      /* Current section */
@@ -298,7 +469,11 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
                      "TS discontinuity (received %d, expected %d) for PID %d",
                      p_decoder->i_continuity_counter, i_expected_counter,
                      ((uint16_t)(p_data[1] & 0x1f) << 8) | p_data[2]);
-            p_decoder->b_discontinuity = true;
+            /* In loss tolerant mode the gathered sections survive, they are
+             * protected by their CRC_32 and only the section in progress
+             * is corrupt */
+            if (!p_dvbpsi->b_loss_tolerant)
+                p_decoder->b_discontinuity = true;
             if (p_decoder->p_current_section)
             {
                 dvbpsi_DeletePSISections(p_decoder->p_current_section);
@@ -311,9 +486,18 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
     if (!(p_data[3] & 0x10))
         return false;
 
-    /* Skip the adaptation_field if present */
+    /* Skip the adaptation_field if present, it leaves at least one byte
+       of payload */
     if (p_data[3] & 0x20)
+    {
+        if (p_data[4] > 182)
+        {
+            dvbpsi_error(p_dvbpsi, "PSI decoder",
+                         "invalid adaptation_field_length %d", p_data[4]);
+            return false;
+        }
         p_payload_pos = p_data + 5 + p_data[4];
+    }
     else
         p_payload_pos = p_data + 4;
 
@@ -338,6 +522,7 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
                         = dvbpsi_NewPSISection(p_decoder->i_section_max_size);
             if (!p_section)
                 return false;
+            p_section->i_first_date = p_dvbpsi->i_date;
             /* Update the position in the packet */
             p_payload_pos = p_new_pos;
             /* New section is being handled */
@@ -390,6 +575,7 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
                                     = dvbpsi_NewPSISection(p_decoder->i_section_max_size);
                         if (!p_section)
                             return false;
+                        p_section->i_first_date = p_dvbpsi->i_date;
                         p_payload_pos = p_new_pos;
                         p_new_pos = NULL;
                         p_decoder->i_need = 3;
@@ -404,61 +590,11 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
             }
             else
             {
-                bool b_valid_crc32 = false;
-                bool has_crc32;
-
-                /* PSI section is complete */
-                p_section->i_table_id = p_section->p_data[0];
-                p_section->b_syntax_indicator = p_section->p_data[1] & 0x80;
-                p_section->b_private_indicator = p_section->p_data[1] & 0x40;
-
-                /* Update the end of the payload if CRC_32 is present */
-                has_crc32 = dvbpsi_has_CRC32(p_section);
-                if (p_section->b_syntax_indicator || has_crc32)
-                    p_section->p_payload_end -= 4;
-
-                /* Check CRC32 if present */
-                if (has_crc32)
-                    b_valid_crc32 = dvbpsi_ValidPSISection(p_section);
-
-                if (!has_crc32 || b_valid_crc32)
-                {
-                    /* PSI section is valid */
-                    if (p_section->b_syntax_indicator)
-                    {
-                        p_section->i_extension =  (p_section->p_data[3] << 8)
-                                                 | p_section->p_data[4];
-                        p_section->i_version = (p_section->p_data[5] & 0x3e) >> 1;
-                        p_section->b_current_next = p_section->p_data[5] & 0x1;
-                        p_section->i_number = p_section->p_data[6];
-                        p_section->i_last_number = p_section->p_data[7];
-                        p_section->p_payload_start = p_section->p_data + 8;
-                    }
-                    else
-                    {
-                        p_section->i_extension = 0;
-                        p_section->i_version = 0;
-                        p_section->b_current_next = true;
-                        p_section->i_number = 0;
-                        p_section->i_last_number = 0;
-                        p_section->p_payload_start = p_section->p_data + 3;
-                    }
-                    if (p_decoder->pf_gather)
-                        p_decoder->pf_gather(p_dvbpsi, p_section);
-                    p_decoder->p_current_section = NULL;
-                }
-                else
-                {
-                    if (has_crc32 && !dvbpsi_ValidPSISection(p_section))
-                        dvbpsi_error(p_dvbpsi, "misc PSI", "Bad CRC_32 table 0x%x !!!",
-                                               p_section->p_data[0]);
-                    else
-                        dvbpsi_error(p_dvbpsi, "misc PSI", "table 0x%x", p_section->p_data[0]);
-
-                    /* PSI section isn't valid => trash it */
-                    dvbpsi_DeletePSISections(p_section);
-                    p_decoder->p_current_section = NULL;
-                }
+                /* PSI section is complete, it is handed over to the decoder
+                   or trashed */
+                p_section->i_complete_date = p_dvbpsi->i_date;
+                p_decoder->p_current_section = NULL;
+                dvbpsi_CompleteSection(p_dvbpsi, p_section, true);
 
                 /* A TS packet may contain any number of sections, only the first
                  * new one is flagged by the pointer_field. If the next payload
@@ -475,6 +611,7 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
                               = dvbpsi_NewPSISection(p_decoder->i_section_max_size);
                     if (!p_section)
                         return false;
+                    p_section->i_first_date = p_dvbpsi->i_date;
                     p_payload_pos = p_new_pos;
                     p_new_pos = NULL;
                     p_decoder->i_need = 3;
@@ -501,6 +638,111 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
 }
 #undef DVBPSI_INVALID_CC
 
+/*****************************************************************************
+ * dvbpsi_packet_push
+ *****************************************************************************
+ * Injection of a TS packet into a PSI decoder.
+ *****************************************************************************/
+bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data)
+{
+    DVBPSI_TRACE2(packet__push__entry, p_dvbpsi,
+                  ((uint16_t)(p_data[1] & 0x1f) << 8) | p_data[2]);
+    bool b_ret = dvbpsi_PushPacket(p_dvbpsi, p_data);
+    DVBPSI_TRACE2(packet__push__return, p_dvbpsi, b_ret);
+    return b_ret;
+}
+
+/*****************************************************************************
+ * dvbpsi_packet_push_date
+ *****************************************************************************
+ * Injection of a TS packet with its arrival date into a PSI decoder.
+ *****************************************************************************/
+bool dvbpsi_packet_push_date(dvbpsi_t *p_dvbpsi, const uint8_t* p_data,
+                             int64_t i_date)
+{
+    assert(p_dvbpsi);
+
+    p_dvbpsi->i_date = i_date;
+    return dvbpsi_packet_push(p_dvbpsi, p_data);
+}
+
+/*****************************************************************************
+ * dvbpsi_packets_push
+ *****************************************************************************
+ * Injection of a buffer of TS packets into a PSI decoder.
+ *****************************************************************************/
+bool dvbpsi_packets_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data,
+                         size_t i_packets, int64_t i_date)
+{
+    assert(p_dvbpsi);
+    assert(p_data);
+
+    bool b_ok = true;
+    p_dvbpsi->i_date = i_date;
+    for (size_t i = 0; i < i_packets; i++)
+    {
+        if (!dvbpsi_packet_push(p_dvbpsi, p_data))
+            b_ok = false;
+        p_data += 188;
+    }
+    return b_ok;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_push
+ *****************************************************************************
+ * Injection of a complete PSI section into a PSI decoder.
+ *****************************************************************************/
+bool dvbpsi_section_push(dvbpsi_t *p_dvbpsi, const uint8_t *p_data, size_t i_size,
+                         bool b_check_crc, int64_t i_date)
+{
+    assert(p_dvbpsi);
+    assert(p_data);
+
+    dvbpsi_decoder_t *p_decoder = p_dvbpsi->p_decoder;
+    assert(p_decoder);
+
+    if (i_size < 3)
+    {
+        dvbpsi_error(p_dvbpsi, "PSI decoder", "PSI section too short");
+        return false;
+    }
+
+    size_t i_length = 3 + ((size_t)(p_data[1] & 0xf) << 8 | p_data[2]);
+    if (i_length > i_size)
+    {
+        dvbpsi_error(p_dvbpsi, "PSI decoder",
+                     "truncated PSI section (%d bytes, %d expected)",
+                     (int)i_size, (int)i_length);
+        return false;
+    }
+    if (i_length > (size_t)p_decoder->i_section_max_size)
+    {
+        dvbpsi_error(p_dvbpsi, "PSI decoder", "PSI section too long");
+        return false;
+    }
+    /* The section syntax requires at least the extended header and CRC_32 */
+    if ((p_data[1] & 0x80) && i_length < 12)
+    {
+        dvbpsi_error(p_dvbpsi, "PSI decoder", "PSI section too short");
+        return false;
+    }
+
+    dvbpsi_psi_section_t *p_section = dvbpsi_NewPSISection(p_decoder->i_section_max_size);
+    if (!p_section)
+        return false;
+
+    memcpy(p_section->p_data, p_data, i_length);
+    p_section->p_payload_end = p_section->p_data + i_length;
+    p_section->i_length = (uint16_t)(i_length - 3);
+
+    p_dvbpsi->i_date = i_date;
+    p_section->i_first_date = i_date;
+    p_section->i_complete_date = i_date;
+
+    return dvbpsi_CompleteSection(p_dvbpsi, p_section, b_check_crc);
+}
+
 /*****************************************************************************
  * Message error level:
  * -1 is disabled,
@@ -125,6 +125,83 @@ typedef struct dvbpsi_decoder_s dvbpsi_decoder_t;
 # define DVBPSI_DECODER(x) ((dvbpsi_decoder_t *)(x))
 #endif
 
+/*****************************************************************************
+ * dvbpsi_psi_section_t
+ *****************************************************************************/
+
+/*!
+ * \typedef struct dvbpsi_psi_section_s dvbpsi_psi_section_t
+ * \brief dvbpsi_psi_section_t type definition.
+ */
+typedef struct dvbpsi_psi_section_s dvbpsi_psi_section_t;
+
+/*****************************************************************************
+ * dvbpsi_section_cb
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_section_cb)(dvbpsi_t *p_dvbpsi,
+                                       const dvbpsi_psi_section_t *p_section,
+                                       const bool b_valid)
+ * \brief Callback type definition for observing completed PSI sections.
+ */
+typedef void (* dvbpsi_section_cb)(dvbpsi_t *p_dvbpsi,  /*!< pointer to dvbpsi handle */
+                  const dvbpsi_psi_section_t *p_section,  /*!< completed section */
+                  const bool b_valid);                    /*!< false on CRC_32 error */
+
+/*****************************************************************************
+ * dvbpsi_table_timing_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_table_timing_s
+ * \brief Acquisition timing of a table.
+ *
+ * Dates are the arrival dates given to dvbpsi_packet_push_date() or
+ * dvbpsi_packets_push(), usually in microseconds.
+ */
+/*!
+ * \typedef struct dvbpsi_table_timing_s dvbpsi_table_timing_t
+ * \brief dvbpsi_table_timing_t type definition.
+ */
+typedef struct dvbpsi_table_timing_s
+{
+    uint8_t     i_table_id;         /*!< table_id of the table */
+    uint16_t    i_extension;        /*!< table_id_extension of the table */
+    int64_t     i_first_date;       /*!< arrival of the first byte of the
+                                         earliest received section */
+    int64_t     i_complete_date;    /*!< completion of the last section */
+} dvbpsi_table_timing_t;
+
+/*!
+ * \def DVBPSI_LATENCY_BUCKETS
+ * \brief Number of buckets of a latency histogram.
+ */
+#define DVBPSI_LATENCY_BUCKETS  20
+
+/*****************************************************************************
+ * dvbpsi_latency_histogram_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_latency_histogram_s
+ * \brief Table acquisition latency histogram.
+ *
+ * Latency is the time between the first byte of the first section and the
+ * completion of the last section of a table. Bucket 0 counts latencies below
+ * 1 ms, bucket n counts latencies from 2^(n-1) ms up to 2^n ms. The last
+ * bucket also counts all longer latencies.
+ */
+/*!
+ * \typedef struct dvbpsi_latency_histogram_s dvbpsi_latency_histogram_t
+ * \brief dvbpsi_latency_histogram_t type definition.
+ */
+typedef struct dvbpsi_latency_histogram_s
+{
+    uint32_t    i_count;            /*!< number of tables */
+    int64_t     i_min;              /*!< smallest latency */
+    int64_t     i_max;              /*!< largest latency */
+    int64_t     i_total;            /*!< sum of all latencies */
+    uint32_t    pi_buckets[DVBPSI_LATENCY_BUCKETS]; /*!< histogram */
+} dvbpsi_latency_histogram_t;
+
 /*****************************************************************************
  * dvbpsi_t
  *****************************************************************************/
@@ -152,6 +229,30 @@ struct dvbpsi_s
                                                           from caller. Do not use
                                                           from inside libdvbpsi. It
                                                           will crash any application. */
+
+    /* New members are appended below, the offsets above are part of the ABI */
+
+    /* Section callback */
+    dvbpsi_section_cb             pf_section;           /*!< Called for each
+                                                          completed section
+                                                          before it is handed
+                                                          to the decoder, may
+                                                          be NULL. The section
+                                                          must not be kept. */
+
+    /* Timing */
+    int64_t                       i_date;               /*!< arrival date of the
+                                                          packet being decoded */
+    dvbpsi_table_timing_t         last_table;           /*!< timing of the last
+                                                          completed table, valid
+                                                          in table callbacks */
+    dvbpsi_latency_histogram_t   *p_latency;            /*!< 256 histograms
+                                                          indexed by table_id,
+                                                          NULL when disabled */
+
+    /* Acquisition */
+    bool                          b_loss_tolerant;      /*!< set with
+                                                          dvbpsi_set_loss_tolerant() */
 };
 
 /*****************************************************************************
@@ -199,14 +300,115 @@ void dvbpsi_delete(dvbpsi_t *p_dvbpsi);
 bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data);
 
 /*****************************************************************************
- * dvbpsi_psi_section_t
+ * dvbpsi_packet_push_date
  *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_packet_push_date(dvbpsi_t *p_dvbpsi, const uint8_t* p_data,
+                                    int64_t i_date)
+ * \brief Injection of a TS packet with its arrival date into a PSI decoder.
+ * \param p_dvbpsi handle to dvbpsi with attached decoder
+ * \param p_data pointer to a 188 bytes playload of a TS packet
+ * \param i_date arrival date of the packet, usually in microseconds
+ * \return true when packet has been handled, false on error.
+ *
+ * Sections record the date of the packet that carries their first byte and
+ * of the packet that completes them. dvbpsi_packet_push() keeps using the
+ * date of the last dated packet.
+ */
+bool dvbpsi_packet_push_date(dvbpsi_t *p_dvbpsi, const uint8_t* p_data,
+                             int64_t i_date);
 
+/*****************************************************************************
+ * dvbpsi_packets_push
+ *****************************************************************************/
 /*!
- * \typedef struct dvbpsi_psi_section_s dvbpsi_psi_section_t
- * \brief dvbpsi_psi_section_t type definition.
+ * \fn bool dvbpsi_packets_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data,
+                                size_t i_packets, int64_t i_date)
+ * \brief Injection of a buffer of TS packets received at the same date.
+ * \param p_dvbpsi handle to dvbpsi with attached decoder
+ * \param p_data pointer to i_packets * 188 bytes of TS packets
+ * \param i_packets number of TS packets in p_data
+ * \param i_date arrival date of the buffer, usually in microseconds
+ * \return true when all packets have been handled, false on error.
  */
-typedef struct dvbpsi_psi_section_s dvbpsi_psi_section_t;
+bool dvbpsi_packets_push(dvbpsi_t *p_dvbpsi, const uint8_t* p_data,
+                         size_t i_packets, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_section_push
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_section_push(dvbpsi_t *p_dvbpsi, const uint8_t *p_data,
+                                size_t i_size, bool b_check_crc, int64_t i_date)
+ * \brief Injection of a complete PSI section into a PSI decoder.
+ * \param p_dvbpsi handle to dvbpsi with attached decoder
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes in p_data, bytes after the end given by
+ *        section_length are ignored
+ * \param b_check_crc false when the source already checked the CRC_32, as
+ *        Linux DVB section filters do unless DMX_CHECK_CRC is cleared
+ * \param i_date arrival date of the section, usually in microseconds
+ * \return true when the section has been handed to the decoder, false when
+ * it is malformed or has a bad CRC_32.
+ *
+ * For sections delivered by a kernel or hardware demultiplexer. The section
+ * takes the same path as one gathered from TS packets, including the
+ * pf_section callback, and the packet state of the decoder is not touched.
+ */
+bool dvbpsi_section_push(dvbpsi_t *p_dvbpsi, const uint8_t *p_data, size_t i_size,
+                         bool b_check_crc, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_set_loss_tolerant
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_set_loss_tolerant(dvbpsi_t *p_dvbpsi, bool b_tolerant)
+ * \brief Keep the sections of a table across TS discontinuities.
+ * \param p_dvbpsi handle to dvbpsi
+ * \param b_tolerant false, the default, drops every section gathered for
+ *        the table on a TS discontinuity. true only drops the section being
+ *        received and keeps the sections already validated by their CRC_32.
+ * \return nothing.
+ */
+void dvbpsi_set_loss_tolerant(dvbpsi_t *p_dvbpsi, bool b_tolerant);
+
+/*****************************************************************************
+ * dvbpsi_latency_enable
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_latency_enable(dvbpsi_t *p_dvbpsi)
+ * \brief Start collecting table acquisition latency histograms.
+ * \param p_dvbpsi handle to dvbpsi
+ * \return true on success, false on error.
+ *
+ * The histograms are released by dvbpsi_latency_disable() or dvbpsi_delete().
+ */
+bool dvbpsi_latency_enable(dvbpsi_t *p_dvbpsi);
+
+/*****************************************************************************
+ * dvbpsi_latency_disable
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_latency_disable(dvbpsi_t *p_dvbpsi)
+ * \brief Stop collecting latency histograms and release them.
+ * \param p_dvbpsi handle to dvbpsi
+ * \return nothing.
+ */
+void dvbpsi_latency_disable(dvbpsi_t *p_dvbpsi);
+
+/*****************************************************************************
+ * dvbpsi_latency_get
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_latency_histogram_t *dvbpsi_latency_get(const dvbpsi_t *p_dvbpsi,
+                                                            uint8_t i_table_id)
+ * \brief Get the latency histogram of a table type.
+ * \param p_dvbpsi handle to dvbpsi
+ * \param i_table_id table_id
+ * \return pointer to the histogram, NULL if collection is disabled.
+ */
+const dvbpsi_latency_histogram_t *dvbpsi_latency_get(const dvbpsi_t *p_dvbpsi,
+                                                     uint8_t i_table_id);
 
 /*****************************************************************************
  * dvbpsi_callback_gather_t
@@ -300,6 +502,24 @@ void *dvbpsi_decoder_new(dvbpsi_callback_gather_t pf_gather,
  */
 void dvbpsi_decoder_delete(dvbpsi_decoder_t *p_decoder);
 
+/*****************************************************************************
+ * dvbpsi_decoder_table_complete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_decoder_table_complete(dvbpsi_t *p_dvbpsi,
+                                          const dvbpsi_psi_section_t *p_sections)
+ * \brief Account the acquisition of a table.
+ * \param p_dvbpsi handle to dvbpsi
+ * \param p_sections list of sections of the table
+ * \return nothing.
+ *
+ * Decoders call this function when all sections of a table have been
+ * received, before the table callback. It fills in dvbpsi_t::last_table and
+ * updates the latency histogram of the table type.
+ */
+void dvbpsi_decoder_table_complete(dvbpsi_t *p_dvbpsi,
+                                   const dvbpsi_psi_section_t *p_sections);
+
 /*****************************************************************************
  * dvbpsi_decoder_reset
  *****************************************************************************/
@@ -0,0 +1,593 @@
+/*****************************************************************************
+ * dvbpsi.hpp
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <dvbpsi.hpp>
+ * \brief C++17 interface of libdvbpsi.
+ *
+ * A header only layer over the C API:
+ * - dvbpsi::handle owns a dvbpsi_t handle and the decoder attached to it,
+ * - dvbpsi::pat, pmt, sdt, eit, nit and bat are move only owners of the
+ *   decoded tables, released with the matching dvbpsi_*_delete() function,
+ * - the callbacks are any callable, stored without std::function and called
+ *   directly from the C callback,
+ * - dvbpsi::list and dvbpsi::bytes are views over the linked lists and the
+ *   byte arrays of the tables, nothing is copied.
+ *
+ * The handle uses the p_sys member of dvbpsi_t, which is no longer available
+ * to the application.
+ *
+ * The callbacks are called from the C library and must not throw: an
+ * exception cannot unwind through its frames. The C callbacks of this layer
+ * are noexcept, an exception leaving a callback calls std::terminate().
+ *
+ * dvbpsi.h, psi.h, descriptor.h, demux.h, pat.h, pmt.h, sdt.h, eit.h, nit.h
+ * and bat.h must be included before this file.
+ */
+
+#ifndef _DVBPSI_DVBPSI_HPP_
+#define _DVBPSI_DVBPSI_HPP_
+
+#if !defined(__cplusplus) || __cplusplus < 201703L
+#error "dvbpsi.hpp requires C++17"
+#endif
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+namespace dvbpsi
+{
+
+/*****************************************************************************
+ * bytes
+ *****************************************************************************/
+#if defined(__cpp_lib_span)
+/*!
+ * \typedef std::span<const uint8_t> bytes
+ * \brief View over a byte array of a table.
+ */
+typedef std::span<const uint8_t> bytes;
+#else
+/*!
+ * \class bytes
+ * \brief View over a byte array of a table, the subset of std::span used
+ * by this interface.
+ */
+class bytes
+{
+public:
+    typedef const uint8_t *iterator;    /*!< iterator type */
+
+    constexpr bytes() noexcept : p_data(nullptr), i_size(0) {}
+    constexpr bytes(const uint8_t *p, std::size_t i) noexcept : p_data(p), i_size(i) {}
+
+    constexpr const uint8_t *data() const noexcept { return p_data; }
+    constexpr std::size_t size() const noexcept { return i_size; }
+    constexpr bool empty() const noexcept { return i_size == 0; }
+    constexpr const uint8_t &operator[](std::size_t i) const { return p_data[i]; }
+    constexpr iterator begin() const noexcept { return p_data; }
+    constexpr iterator end() const noexcept { return p_data + i_size; }
+    constexpr bytes subspan(std::size_t i_offset) const
+    {
+        return bytes(p_data + i_offset, i_size - i_offset);
+    }
+    constexpr bytes subspan(std::size_t i_offset, std::size_t i_count) const
+    {
+        return bytes(p_data + i_offset, i_count);
+    }
+
+private:
+    const uint8_t *p_data;
+    std::size_t    i_size;
+};
+#endif
+
+/*****************************************************************************
+ * list
+ *****************************************************************************/
+/*!
+ * \class list
+ * \brief Forward range over a list of the C API linked by p_next, such as
+ * the programs of a PAT, the ES of a PMT or a descriptor loop.
+ */
+template <typename T>
+class list
+{
+public:
+    /*! forward iterator */
+    class iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category; /*!< category */
+        typedef T                         value_type;        /*!< element */
+        typedef std::ptrdiff_t            difference_type;   /*!< distance */
+        typedef T *                       pointer;           /*!< pointer */
+        typedef T &                       reference;         /*!< reference */
+
+        constexpr iterator(T *p = nullptr) noexcept : p_cur(p) {}
+
+        T &operator*() const noexcept { return *p_cur; }
+        T *operator->() const noexcept { return p_cur; }
+        iterator &operator++() noexcept { p_cur = p_cur->p_next; return *this; }
+        iterator operator++(int) noexcept { iterator it = *this; ++*this; return it; }
+        bool operator==(const iterator &o) const noexcept { return p_cur == o.p_cur; }
+        bool operator!=(const iterator &o) const noexcept { return p_cur != o.p_cur; }
+
+    private:
+        T *p_cur;
+    };
+
+    constexpr list(T *p = nullptr) noexcept : p_first(p) {}
+
+    iterator begin() const noexcept { return iterator(p_first); }
+    iterator end() const noexcept { return iterator(); }
+    bool empty() const noexcept { return p_first == nullptr; }
+    std::size_t size() const noexcept
+    {
+        std::size_t i = 0;
+        for (T *p = p_first; p; p = p->p_next)
+            i++;
+        return i;
+    }
+
+private:
+    T *p_first;
+};
+
+/*! \brief Descriptor loop view. */
+typedef list<const dvbpsi_descriptor_t> descriptor_list;
+
+/*! \brief Descriptors of a loop starting at p_first. */
+inline descriptor_list descriptors(const dvbpsi_descriptor_t *p_first) noexcept
+{
+    return descriptor_list(p_first);
+}
+
+/*! \brief Descriptors of any table or loop entry with a p_first_descriptor member. */
+template <typename T>
+inline auto descriptors(const T &entry) noexcept
+    -> decltype(entry.p_first_descriptor, descriptor_list())
+{
+    return descriptor_list(entry.p_first_descriptor);
+}
+
+/*! \brief descriptor payload, without the tag and length bytes */
+inline bytes payload(const dvbpsi_descriptor_t &descriptor) noexcept
+{
+    return bytes(descriptor.p_data, descriptor.i_length);
+}
+
+/*! \brief Section list view. */
+typedef list<const dvbpsi_psi_section_t> section_list;
+
+/*! \brief Sections of a list starting at p_first. */
+inline section_list sections(const dvbpsi_psi_section_t *p_first) noexcept
+{
+    return section_list(p_first);
+}
+
+/*! \brief complete section, from the table_id to the CRC_32 */
+inline bytes data(const dvbpsi_psi_section_t &section) noexcept
+{
+    return bytes(section.p_data, std::size_t(section.i_length) + 3);
+}
+
+/*! \brief section payload, from p_payload_start to p_payload_end */
+inline bytes payload(const dvbpsi_psi_section_t &section) noexcept
+{
+    return bytes(section.p_payload_start,
+                 std::size_t(section.p_payload_end - section.p_payload_start));
+}
+
+/*****************************************************************************
+ * table
+ *****************************************************************************/
+/*!
+ * \class table
+ * \brief Move only owner of a decoded table, the base of pat, pmt, sdt,
+ * eit, nit and bat.
+ */
+template <typename T, void (*Delete)(T *)>
+class table
+{
+public:
+    typedef T c_type;   /*!< table type of the C API */
+
+    table() noexcept = default;
+    explicit table(T *p) noexcept : p_table(p) {}
+
+    /*! \brief the owned table, nullptr if none */
+    T *get() const noexcept { return p_table.get(); }
+    /*! \brief give up the ownership, the table must be deleted by the caller */
+    T *release() noexcept { return p_table.release(); }
+    explicit operator bool() const noexcept { return p_table != nullptr; }
+    T &operator*() const noexcept { return *p_table; }
+    T *operator->() const noexcept { return p_table.get(); }
+
+    /*! \brief descriptors of the first loop of the table, if it has one */
+    template <typename U = T>
+    auto descriptors() const noexcept -> decltype(dvbpsi::descriptors(std::declval<const U &>()))
+    {
+        return dvbpsi::descriptors(*p_table);
+    }
+
+private:
+    struct deleter
+    {
+        void operator()(T *p) const noexcept { Delete(p); }
+    };
+    std::unique_ptr<T, deleter> p_table;
+};
+
+/*! \brief Program Association Table */
+class pat : public table<dvbpsi_pat_t, dvbpsi_pat_delete>
+{
+public:
+    using table::table;
+    /*! \brief programs of the PAT */
+    list<const dvbpsi_pat_program_t> programs() const noexcept { return get()->p_first_program; }
+};
+
+/*! \brief Program Map Table */
+class pmt : public table<dvbpsi_pmt_t, dvbpsi_pmt_delete>
+{
+public:
+    using table::table;
+    /*! \brief elementary streams of the PMT */
+    list<const dvbpsi_pmt_es_t> es() const noexcept { return get()->p_first_es; }
+};
+
+/*! \brief Service Description Table */
+class sdt : public table<dvbpsi_sdt_t, dvbpsi_sdt_delete>
+{
+public:
+    using table::table;
+    /*! \brief services of the SDT */
+    list<const dvbpsi_sdt_service_t> services() const noexcept { return get()->p_first_service; }
+};
+
+/*! \brief Event Information Table */
+class eit : public table<dvbpsi_eit_t, dvbpsi_eit_delete>
+{
+public:
+    using table::table;
+    /*! \brief events of the EIT */
+    list<const dvbpsi_eit_event_t> events() const noexcept { return get()->p_first_event; }
+};
+
+/*! \brief Network Information Table */
+class nit : public table<dvbpsi_nit_t, dvbpsi_nit_delete>
+{
+public:
+    using table::table;
+    /*! \brief transport streams of the NIT */
+    list<const dvbpsi_nit_ts_t> ts() const noexcept { return get()->p_first_ts; }
+};
+
+/*! \brief Bouquet Association Table */
+class bat : public table<dvbpsi_bat_t, dvbpsi_bat_delete>
+{
+public:
+    using table::table;
+    /*! \brief transport streams of the BAT */
+    list<const dvbpsi_bat_ts_t> ts() const noexcept { return get()->p_first_ts; }
+};
+
+namespace detail
+{
+
+/* callbacks are kept by the handle until the decoder is detached */
+struct callback
+{
+    virtual ~callback() {}
+};
+
+template <typename F>
+struct callback_of : callback
+{
+    F f;
+    template <typename G>
+    explicit callback_of(G &&g) : f(std::forward<G>(g)) {}
+};
+
+/* C callback of a table decoder, wraps the table in its owner */
+template <typename Table, typename F>
+struct table_callback : callback_of<F>
+{
+    using callback_of<F>::callback_of;
+    static void call(void *p_cb_data, typename Table::c_type *p_table) noexcept
+    {
+        static_cast<table_callback *>(p_cb_data)->f(Table(p_table));
+    }
+};
+
+struct state
+{
+    dvbpsi_t *p_dvbpsi = nullptr;
+    void (*pf_detach)(dvbpsi_t *) = nullptr;
+    std::unique_ptr<callback> p_message;
+    std::vector<std::unique_ptr<callback>> callbacks;
+
+    ~state()
+    {
+        detach();
+        dvbpsi_delete(p_dvbpsi);
+    }
+
+    void detach()
+    {
+        if (pf_detach)
+            pf_detach(p_dvbpsi);
+        pf_detach = nullptr;
+        callbacks.clear();
+    }
+
+    /* keeps a callback, removed again by drop() when the attach fails */
+    template <typename C, typename F>
+    C *keep(F &&f)
+    {
+        callbacks.emplace_back(new C(std::forward<F>(f)));
+        return static_cast<C *>(callbacks.back().get());
+    }
+
+    bool drop(bool b_attached)
+    {
+        if (!b_attached)
+            callbacks.pop_back();
+        return b_attached;
+    }
+};
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+inline void detach_demux(dvbpsi_t *p_dvbpsi) { dvbpsi_DetachDemux(p_dvbpsi); }
+inline bool attach_demux(dvbpsi_t *p_dvbpsi, dvbpsi_demux_new_cb_t pf_new, void *p_cb_data)
+{
+    return dvbpsi_AttachDemux(p_dvbpsi, pf_new, p_cb_data);
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+} /* namespace detail */
+
+/*****************************************************************************
+ * demux
+ *****************************************************************************/
+/*!
+ * \class demux
+ * \brief Subtable decoders of a handle with an attached demux, given to the
+ * new subtable callback of dvbpsi::handle::attach_demux().
+ *
+ * The callbacks are called with the table wrapped in its owner type, for
+ * instance F(dvbpsi::sdt), and must not throw. The attach functions fail
+ * when the handle has no demux attached.
+ */
+class demux
+{
+public:
+    explicit demux(detail::state *p) noexcept : p_state(p) {}
+
+    /*! \brief attach an SDT decoder, see dvbpsi_sdt_attach() */
+    template <typename F>
+    bool attach_sdt(uint8_t i_table_id, uint16_t i_extension, F &&f)
+    {
+        typedef detail::table_callback<sdt, std::decay_t<F>> cb;
+        if (!has_demux())
+            return false;
+        return p_state->drop(dvbpsi_sdt_attach(p_state->p_dvbpsi, i_table_id, i_extension,
+                                               &cb::call, p_state->keep<cb>(std::forward<F>(f))));
+    }
+    /*! \brief attach an EIT decoder, see dvbpsi_eit_attach() */
+    template <typename F>
+    bool attach_eit(uint8_t i_table_id, uint16_t i_extension, F &&f)
+    {
+        typedef detail::table_callback<eit, std::decay_t<F>> cb;
+        if (!has_demux())
+            return false;
+        return p_state->drop(dvbpsi_eit_attach(p_state->p_dvbpsi, i_table_id, i_extension,
+                                               &cb::call, p_state->keep<cb>(std::forward<F>(f))));
+    }
+    /*! \brief attach a NIT decoder, see dvbpsi_nit_attach() */
+    template <typename F>
+    bool attach_nit(uint8_t i_table_id, uint16_t i_extension, F &&f)
+    {
+        typedef detail::table_callback<nit, std::decay_t<F>> cb;
+        if (!has_demux())
+            return false;
+        return p_state->drop(dvbpsi_nit_attach(p_state->p_dvbpsi, i_table_id, i_extension,
+                                               &cb::call, p_state->keep<cb>(std::forward<F>(f))));
+    }
+    /*! \brief attach a BAT decoder, see dvbpsi_bat_attach() */
+    template <typename F>
+    bool attach_bat(uint8_t i_table_id, uint16_t i_extension, F &&f)
+    {
+        typedef detail::table_callback<bat, std::decay_t<F>> cb;
+        if (!has_demux())
+            return false;
+        return p_state->drop(dvbpsi_bat_attach(p_state->p_dvbpsi, i_table_id, i_extension,
+                                               &cb::call, p_state->keep<cb>(std::forward<F>(f))));
+    }
+
+private:
+    detail::state *p_state;
+
+    bool has_demux() const noexcept
+    {
+        return p_state->pf_detach == detail::detach_demux;
+    }
+};
+
+/*****************************************************************************
+ * handle
+ *****************************************************************************/
+/*!
+ * \class handle
+ * \brief Move only owner of a dvbpsi_t handle and of its decoder.
+ *
+ * A handle has at most one decoder: a PAT or PMT decoder, or a demux with
+ * its subtable decoders. The decoder and the callbacks are released by
+ * detach() or with the handle. The constructors throw std::bad_alloc when
+ * the handle cannot be created, the other functions report errors like the
+ * C API.
+ */
+class handle
+{
+public:
+    /*! \brief handle without message callback */
+    explicit handle(dvbpsi_msg_level_t level = DVBPSI_MSG_NONE)
+        : p_state(new detail::state)
+    {
+        create(nullptr, level);
+    }
+
+    /*! \brief handle calling F(dvbpsi_msg_level_t, const char *) for its messages */
+    template <typename F>
+    handle(dvbpsi_msg_level_t level, F &&on_message)
+        : p_state(new detail::state)
+    {
+        p_state->p_message.reset(new detail::callback_of<std::decay_t<F>>(std::forward<F>(on_message)));
+        create(&message<std::decay_t<F>>, level);
+    }
+
+    handle(handle &&) noexcept = default;
+    handle &operator=(handle &&) noexcept = default;
+
+    /*! \brief the dvbpsi_t handle */
+    dvbpsi_t *get() const noexcept { return p_state->p_dvbpsi; }
+
+    /*! \brief push a TS packet, see dvbpsi_packet_push() */
+    bool push(const uint8_t *p_packet) noexcept
+    {
+        return dvbpsi_packet_push(p_state->p_dvbpsi, p_packet);
+    }
+    /*! \brief push a dated TS packet, see dvbpsi_packet_push_date() */
+    bool push(const uint8_t *p_packet, int64_t i_date) noexcept
+    {
+        return dvbpsi_packet_push_date(p_state->p_dvbpsi, p_packet, i_date);
+    }
+    /*! \brief push a buffer of TS packets, see dvbpsi_packets_push() */
+    bool push(bytes packets, int64_t i_date) noexcept
+    {
+        return dvbpsi_packets_push(p_state->p_dvbpsi, packets.data(),
+                                   packets.size() / 188, i_date);
+    }
+    /*! \brief push a complete section, see dvbpsi_section_push() */
+    bool push_section(bytes section, bool b_check_crc, int64_t i_date) noexcept
+    {
+        return dvbpsi_section_push(p_state->p_dvbpsi, section.data(), section.size(),
+                                   b_check_crc, i_date);
+    }
+
+    /*! \brief attach a PAT decoder calling F(dvbpsi::pat), see dvbpsi_pat_attach() */
+    template <typename F>
+    bool attach_pat(F &&f)
+    {
+        typedef detail::table_callback<pat, std::decay_t<F>> cb;
+        if (p_state->pf_detach)
+            return false;
+        if (!p_state->drop(dvbpsi_pat_attach(p_state->p_dvbpsi, &cb::call,
+                                             p_state->keep<cb>(std::forward<F>(f)))))
+            return false;
+        p_state->pf_detach = dvbpsi_pat_detach;
+        return true;
+    }
+
+    /*! \brief attach a PMT decoder calling F(dvbpsi::pmt), see dvbpsi_pmt_attach() */
+    template <typename F>
+    bool attach_pmt(uint16_t i_program_number, F &&f)
+    {
+        typedef detail::table_callback<pmt, std::decay_t<F>> cb;
+        if (p_state->pf_detach)
+            return false;
+        if (!p_state->drop(dvbpsi_pmt_attach(p_state->p_dvbpsi, i_program_number, &cb::call,
+                                             p_state->keep<cb>(std::forward<F>(f)))))
+            return false;
+        p_state->pf_detach = dvbpsi_pmt_detach;
+        return true;
+    }
+
+    /*!
+     * \brief attach a demux calling F(dvbpsi::demux &, uint8_t i_table_id,
+     * uint16_t i_extension) for each new subtable, see dvbpsi_AttachDemux()
+     */
+    template <typename F>
+    bool attach_demux(F &&f)
+    {
+        typedef detail::callback_of<std::decay_t<F>> cb;
+        if (p_state->pf_detach)
+            return false;
+        if (!p_state->drop(detail::attach_demux(p_state->p_dvbpsi, &new_subtable<std::decay_t<F>>,
+                                                p_state->keep<cb>(std::forward<F>(f)))))
+            return false;
+        p_state->pf_detach = detail::detach_demux;
+        return true;
+    }
+
+    /*! \brief subtable decoders, when a demux is attached */
+    demux subtables() const noexcept { return demux(p_state.get()); }
+
+    /*! \brief detach the decoder and release the callbacks */
+    void detach() { p_state->detach(); }
+
+private:
+    std::unique_ptr<detail::state> p_state;
+
+    void create(dvbpsi_message_cb pf_message, dvbpsi_msg_level_t level)
+    {
+        p_state->p_dvbpsi = dvbpsi_new(pf_message, level);
+        if (!p_state->p_dvbpsi)
+            throw std::bad_alloc();
+        p_state->p_dvbpsi->p_sys = p_state.get();
+    }
+
+    template <typename F>
+    static void message(dvbpsi_t *p_dvbpsi, const dvbpsi_msg_level_t level,
+                        const char *msg) noexcept
+    {
+        detail::state *p = static_cast<detail::state *>(p_dvbpsi->p_sys);
+        static_cast<detail::callback_of<F> *>(p->p_message.get())->f(level, msg);
+    }
+
+    template <typename F>
+    static void new_subtable(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                             void *p_cb_data) noexcept
+    {
+        demux d(static_cast<detail::state *>(p_dvbpsi->p_sys));
+        static_cast<detail::callback_of<F> *>(p_cb_data)->f(d, i_table_id, i_extension);
+    }
+};
+
+} /* namespace dvbpsi */
+
+#else
+#error "Multiple inclusions of dvbpsi.hpp"
+#endif
@@ -54,6 +54,29 @@ void dvbpsi_warning(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...);
 void dvbpsi_debug(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...);
 #endif
 
+/*****************************************************************************
+ * Static tracepoints
+ *****************************************************************************
+ * USDT probes of the "libdvbpsi" provider for perf, SystemTap or bpftrace.
+ * They compile to nothing without <sys/sdt.h> or with --disable-tracepoints.
+ *****************************************************************************/
+#if defined(ENABLE_TRACEPOINTS) && defined(HAVE_SYS_SDT_H)
+#  include <sys/sdt.h>
+#  define DVBPSI_TRACE1(name, a)        DTRACE_PROBE1(libdvbpsi, name, a)
+#  define DVBPSI_TRACE2(name, a, b)     DTRACE_PROBE2(libdvbpsi, name, a, b)
+#  define DVBPSI_TRACE3(name, a, b, c)  DTRACE_PROBE3(libdvbpsi, name, a, b, c)
+#else
+#  define DVBPSI_TRACE1(name, a)        do {} while(0)
+#  define DVBPSI_TRACE2(name, a, b)     do {} while(0)
+#  define DVBPSI_TRACE3(name, a, b, c)  do {} while(0)
+#endif
+
+/* Table decoding and table callback probes, called from the gather functions
+ * once dvbpsi_decoder_table_complete() filled in dvbpsi_t::last_table */
+#define DVBPSI_TRACE_TABLE(name, p_dvbpsi)                      \
+        DVBPSI_TRACE3(name, p_dvbpsi, (p_dvbpsi)->last_table.i_table_id, \
+                      (p_dvbpsi)->last_table.i_extension)
+
 #else
 #error "Multiple inclusions of dvbpsi_private.h"
 #endif
@@ -0,0 +1,469 @@
+/*****************************************************************************
+ * eventtracker.c: EIT present/following and RST event tracker
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "psi.h"
+#include "descriptor.h"
+#include "tables/rst.h"
+#include "eventtracker.h"
+
+#define TRACKER_PID_EIT             0x12
+#define TRACKER_PID_RST             0x13
+#define TRACKER_MIN_BUCKETS         64
+
+#define TRACKER_RUNNING             4   /* running_status "running" */
+
+/*****************************************************************************
+ * tracker_decoder_t
+ *****************************************************************************
+ * Section decoder handing every section to the tracker.
+ *****************************************************************************/
+typedef struct tracker_decoder_s
+{
+    DVBPSI_DECODER_COMMON
+
+    dvbpsi_event_tracker_t         *p_tracker;
+} tracker_decoder_t;
+
+/*****************************************************************************
+ * tracker_service_t
+ *****************************************************************************/
+typedef struct tracker_service_s
+{
+    dvbpsi_event_tracker_service_t  service;        /* must be first */
+    struct tracker_service_s       *p_next;         /* hash chain */
+} tracker_service_t;
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_s
+ *****************************************************************************/
+struct dvbpsi_event_tracker_s
+{
+    dvbpsi_event_tracker_callback   pf_callback;
+    void                           *p_cb_data;
+
+    dvbpsi_t                       *p_eit_dvbpsi;
+    dvbpsi_t                       *p_rst_dvbpsi;
+
+    tracker_service_t             **pp_buckets;
+    unsigned int                    i_buckets;      /* power of 2 */
+    unsigned int                    i_services;
+};
+
+/*****************************************************************************
+ * tracker_Hash
+ *****************************************************************************/
+static inline unsigned int tracker_Hash(uint16_t i_onid, uint16_t i_tsid, uint16_t i_service_id,
+                                        unsigned int i_buckets)
+{
+    uint64_t i_key = ((uint64_t)i_onid << 32) | ((uint64_t)i_tsid << 16) | i_service_id;
+    return (unsigned int)((i_key * UINT64_C(0x9e3779b97f4a7c15)) >> 32) & (i_buckets - 1);
+}
+
+/*****************************************************************************
+ * tracker_Find
+ *****************************************************************************/
+static tracker_service_t *tracker_Find(const dvbpsi_event_tracker_t *p_tracker,
+                                       uint16_t i_onid, uint16_t i_tsid, uint16_t i_service_id)
+{
+    tracker_service_t *p = p_tracker->pp_buckets[tracker_Hash(i_onid, i_tsid, i_service_id,
+                                                              p_tracker->i_buckets)];
+    while (p && (p->service.i_onid != i_onid || p->service.i_tsid != i_tsid
+              || p->service.i_service_id != i_service_id))
+        p = p->p_next;
+    return p;
+}
+
+/*****************************************************************************
+ * tracker_Get
+ *****************************************************************************
+ * Find or create the state of a service. The hash doubles when it holds as
+ * many services as buckets; if that fails the chains just get longer.
+ *****************************************************************************/
+static tracker_service_t *tracker_Get(dvbpsi_event_tracker_t *p_tracker,
+                                      uint16_t i_onid, uint16_t i_tsid, uint16_t i_service_id)
+{
+    tracker_service_t *p_service = tracker_Find(p_tracker, i_onid, i_tsid, i_service_id);
+    if (p_service)
+        return p_service;
+
+    if (p_tracker->i_services >= p_tracker->i_buckets)
+    {
+        unsigned int i_buckets = p_tracker->i_buckets * 2;
+        tracker_service_t **pp_buckets = calloc(i_buckets, sizeof(tracker_service_t *));
+        if (pp_buckets)
+        {
+            for (unsigned int i = 0; i < p_tracker->i_buckets; i++)
+            {
+                tracker_service_t *p = p_tracker->pp_buckets[i];
+                while (p)
+                {
+                    tracker_service_t *p_next = p->p_next;
+                    unsigned int i_hash = tracker_Hash(p->service.i_onid, p->service.i_tsid,
+                                                       p->service.i_service_id, i_buckets);
+                    p->p_next = pp_buckets[i_hash];
+                    pp_buckets[i_hash] = p;
+                    p = p_next;
+                }
+            }
+            free(p_tracker->pp_buckets);
+            p_tracker->pp_buckets = pp_buckets;
+            p_tracker->i_buckets = i_buckets;
+        }
+    }
+
+    p_service = calloc(1, sizeof(tracker_service_t));
+    if (!p_service)
+        return NULL;
+    p_service->service.i_onid = i_onid;
+    p_service->service.i_tsid = i_tsid;
+    p_service->service.i_service_id = i_service_id;
+
+    unsigned int i_hash = tracker_Hash(i_onid, i_tsid, i_service_id, p_tracker->i_buckets);
+    p_service->p_next = p_tracker->pp_buckets[i_hash];
+    p_tracker->pp_buckets[i_hash] = p_service;
+    p_tracker->i_services++;
+    return p_service;
+}
+
+/*****************************************************************************
+ * tracker_SetEvent
+ *****************************************************************************
+ * Replace the present or following event, returning the changes.
+ *****************************************************************************/
+static unsigned int tracker_SetEvent(dvbpsi_event_tracker_event_t *p_event,
+                                     const dvbpsi_event_tracker_event_t *p_new,
+                                     unsigned int i_event_flag, unsigned int i_status_flag)
+{
+    unsigned int i_changes = 0;
+
+    if (p_event->b_valid != p_new->b_valid
+     || (p_new->b_valid && p_event->i_event_id != p_new->i_event_id))
+        i_changes |= i_event_flag;
+    if (p_new->b_valid && p_event->i_running_status != p_new->i_running_status)
+        i_changes |= i_status_flag;
+
+    *p_event = *p_new;
+    return i_changes;
+}
+
+/*****************************************************************************
+ * tracker_Raise
+ *****************************************************************************/
+static void tracker_Raise(dvbpsi_event_tracker_t *p_tracker, tracker_service_t *p_service,
+                          unsigned int i_changes, int64_t i_date)
+{
+    if (!i_changes)
+        return;
+    p_service->service.i_date = i_date;
+    if (p_tracker->pf_callback)
+        p_tracker->pf_callback(p_tracker->p_cb_data, &p_service->service, i_changes);
+}
+
+/*****************************************************************************
+ * tracker_RunningStatus
+ *****************************************************************************
+ * Apply one entry of an RST.
+ *****************************************************************************/
+static void tracker_RunningStatus(dvbpsi_event_tracker_t *p_tracker,
+                                  uint16_t i_onid, uint16_t i_tsid, uint16_t i_service_id,
+                                  uint16_t i_event_id, uint8_t i_running_status, int64_t i_date)
+{
+    tracker_service_t *p_service = tracker_Get(p_tracker, i_onid, i_tsid, i_service_id);
+    if (!p_service)
+        return;
+
+    dvbpsi_event_tracker_event_t *p_present = &p_service->service.present;
+    dvbpsi_event_tracker_event_t *p_following = &p_service->service.following;
+    unsigned int i_changes = 0;
+
+    if (p_present->b_valid && p_present->i_event_id == i_event_id)
+    {
+        if (p_present->i_running_status != i_running_status)
+        {
+            p_present->i_running_status = i_running_status;
+            i_changes = DVBPSI_EVENT_TRACKER_PRESENT_STATUS;
+        }
+    }
+    else if (p_following->b_valid && p_following->i_event_id == i_event_id)
+    {
+        if (i_running_status == TRACKER_RUNNING)
+        {
+            /* The following event has started */
+            dvbpsi_event_tracker_event_t started = *p_following;
+            dvbpsi_event_tracker_event_t none = { false, 0, 0, 0, 0 };
+            started.i_running_status = i_running_status;
+            i_changes = tracker_SetEvent(p_present, &started,
+                                         DVBPSI_EVENT_TRACKER_PRESENT_EVENT,
+                                         DVBPSI_EVENT_TRACKER_PRESENT_STATUS)
+                      | tracker_SetEvent(p_following, &none,
+                                         DVBPSI_EVENT_TRACKER_FOLLOWING_EVENT,
+                                         DVBPSI_EVENT_TRACKER_FOLLOWING_STATUS);
+        }
+        else if (p_following->i_running_status != i_running_status)
+        {
+            p_following->i_running_status = i_running_status;
+            i_changes = DVBPSI_EVENT_TRACKER_FOLLOWING_STATUS;
+        }
+    }
+    else if (i_running_status == TRACKER_RUNNING)
+    {
+        /* An event unknown to the EIT p/f has started, its times are not
+         * known until the next EIT present section */
+        dvbpsi_event_tracker_event_t started = { true, i_event_id, UINT64_C(0xffffffffff),
+                                                 0xffffff, i_running_status };
+        i_changes = tracker_SetEvent(p_present, &started, DVBPSI_EVENT_TRACKER_PRESENT_EVENT,
+                                     DVBPSI_EVENT_TRACKER_PRESENT_STATUS);
+    }
+
+    tracker_Raise(p_tracker, p_service, i_changes, i_date);
+}
+
+/*****************************************************************************
+ * tracker_EIT
+ *****************************************************************************
+ * Apply an EIT present/following section: section 0 holds the present
+ * event and section 1 the following one, an empty section means none.
+ *****************************************************************************/
+static void tracker_EIT(dvbpsi_event_tracker_t *p_tracker, const dvbpsi_psi_section_t *p_section)
+{
+    if (!p_section->b_syntax_indicator || !p_section->b_current_next || p_section->i_number > 1)
+        return;
+
+    const uint8_t *p = p_section->p_payload_start;
+    const uint8_t *p_end = p_section->p_payload_end;
+    if (p_end - p < 6)
+        return;
+
+    uint16_t i_tsid = (uint16_t)(p[0] << 8 | p[1]);
+    uint16_t i_onid = (uint16_t)(p[2] << 8 | p[3]);
+    p += 6;
+
+    dvbpsi_event_tracker_event_t event = { false, 0, 0, 0, 0 };
+    if (p_end - p >= 12)
+    {
+        event.b_valid = true;
+        event.i_event_id = (uint16_t)(p[0] << 8 | p[1]);
+        event.i_start_time = (uint64_t)p[2] << 32 | (uint64_t)p[3] << 24
+                           | (uint64_t)p[4] << 16 | (uint64_t)p[5] << 8 | p[6];
+        event.i_duration = (uint32_t)p[7] << 16 | (uint32_t)p[8] << 8 | p[9];
+        event.i_running_status = p[10] >> 5;
+    }
+
+    tracker_service_t *p_service = tracker_Get(p_tracker, i_onid, i_tsid, p_section->i_extension);
+    if (!p_service)
+        return;
+
+    unsigned int i_changes;
+    if (p_section->i_number == 0)
+        i_changes = tracker_SetEvent(&p_service->service.present, &event,
+                                     DVBPSI_EVENT_TRACKER_PRESENT_EVENT,
+                                     DVBPSI_EVENT_TRACKER_PRESENT_STATUS);
+    else
+        i_changes = tracker_SetEvent(&p_service->service.following, &event,
+                                     DVBPSI_EVENT_TRACKER_FOLLOWING_EVENT,
+                                     DVBPSI_EVENT_TRACKER_FOLLOWING_STATUS);
+
+    tracker_Raise(p_tracker, p_service, i_changes, p_section->i_complete_date);
+}
+
+/*****************************************************************************
+ * tracker_RST
+ *****************************************************************************
+ * Apply an RST section, 9 bytes per entry.
+ *****************************************************************************/
+static void tracker_RST(dvbpsi_event_tracker_t *p_tracker, const dvbpsi_psi_section_t *p_section)
+{
+    for (const uint8_t *p = p_section->p_payload_start; p + 9 <= p_section->p_payload_end; p += 9)
+        tracker_RunningStatus(p_tracker, (uint16_t)(p[2] << 8 | p[3]), (uint16_t)(p[0] << 8 | p[1]),
+                              (uint16_t)(p[4] << 8 | p[5]), (uint16_t)(p[6] << 8 | p[7]),
+                              p[8] & 0x07, p_section->i_complete_date);
+}
+
+/*****************************************************************************
+ * tracker_Gather
+ *****************************************************************************/
+static void tracker_Gather(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section)
+{
+    tracker_decoder_t *p_decoder = (tracker_decoder_t *)p_dvbpsi->p_decoder;
+    dvbpsi_event_tracker_section_push(p_decoder->p_tracker, p_section);
+    dvbpsi_DeletePSISections(p_section);
+}
+
+/*****************************************************************************
+ * tracker_NewDecoder / tracker_DeleteDecoder
+ *****************************************************************************/
+static dvbpsi_t *tracker_NewDecoder(dvbpsi_event_tracker_t *p_tracker,
+                                    dvbpsi_message_cb pf_message, enum dvbpsi_msg_level level)
+{
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(pf_message, level);
+    if (!p_dvbpsi)
+        return NULL;
+
+    tracker_decoder_t *p_decoder = (tracker_decoder_t *)dvbpsi_decoder_new(&tracker_Gather,
+                                                4096, true, sizeof(tracker_decoder_t));
+    if (!p_decoder)
+    {
+        dvbpsi_delete(p_dvbpsi);
+        return NULL;
+    }
+    p_decoder->p_tracker = p_tracker;
+    p_dvbpsi->p_decoder = DVBPSI_DECODER(p_decoder);
+    return p_dvbpsi;
+}
+
+static void tracker_DeleteDecoder(dvbpsi_t *p_dvbpsi)
+{
+    if (!p_dvbpsi)
+        return;
+    dvbpsi_decoder_delete(p_dvbpsi->p_decoder);
+    p_dvbpsi->p_decoder = NULL;
+    dvbpsi_delete(p_dvbpsi);
+}
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_new
+ *****************************************************************************/
+dvbpsi_event_tracker_t *dvbpsi_event_tracker_new(dvbpsi_event_tracker_callback pf_callback,
+                                                 void *p_cb_data,
+                                                 dvbpsi_message_cb pf_message,
+                                                 enum dvbpsi_msg_level level)
+{
+    dvbpsi_event_tracker_t *p_tracker = calloc(1, sizeof(dvbpsi_event_tracker_t));
+    if (!p_tracker)
+        return NULL;
+
+    p_tracker->pf_callback = pf_callback;
+    p_tracker->p_cb_data = p_cb_data;
+    p_tracker->pp_buckets = calloc(TRACKER_MIN_BUCKETS, sizeof(tracker_service_t *));
+    p_tracker->i_buckets = TRACKER_MIN_BUCKETS;
+    p_tracker->p_eit_dvbpsi = tracker_NewDecoder(p_tracker, pf_message, level);
+    p_tracker->p_rst_dvbpsi = tracker_NewDecoder(p_tracker, pf_message, level);
+    if (!p_tracker->pp_buckets || !p_tracker->p_eit_dvbpsi || !p_tracker->p_rst_dvbpsi)
+    {
+        dvbpsi_event_tracker_delete(p_tracker);
+        return NULL;
+    }
+    return p_tracker;
+}
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_delete
+ *****************************************************************************/
+void dvbpsi_event_tracker_delete(dvbpsi_event_tracker_t *p_tracker)
+{
+    if (!p_tracker)
+        return;
+
+    tracker_DeleteDecoder(p_tracker->p_eit_dvbpsi);
+    tracker_DeleteDecoder(p_tracker->p_rst_dvbpsi);
+
+    for (unsigned int i = 0; p_tracker->pp_buckets && i < p_tracker->i_buckets; i++)
+    {
+        tracker_service_t *p = p_tracker->pp_buckets[i];
+        while (p)
+        {
+            tracker_service_t *p_next = p->p_next;
+            free(p);
+            p = p_next;
+        }
+    }
+    free(p_tracker->pp_buckets);
+    free(p_tracker);
+}
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_packet_push
+ *****************************************************************************/
+bool dvbpsi_event_tracker_packet_push(dvbpsi_event_tracker_t *p_tracker,
+                                      const uint8_t *p_data, int64_t i_date)
+{
+    uint16_t i_pid = (uint16_t)((p_data[1] & 0x1f) << 8 | p_data[2]);
+
+    if (i_pid == TRACKER_PID_EIT)
+        return dvbpsi_packet_push_date(p_tracker->p_eit_dvbpsi, p_data, i_date);
+    if (i_pid == TRACKER_PID_RST)
+        return dvbpsi_packet_push_date(p_tracker->p_rst_dvbpsi, p_data, i_date);
+    return false;
+}
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_section_push
+ *****************************************************************************/
+void dvbpsi_event_tracker_section_push(dvbpsi_event_tracker_t *p_tracker,
+                                       const dvbpsi_psi_section_t *p_section)
+{
+    switch (p_section->i_table_id)
+    {
+        case 0x4e: /* EIT actual present/following */
+        case 0x4f: /* EIT other present/following */
+            tracker_EIT(p_tracker, p_section);
+            break;
+        case 0x71:
+            tracker_RST(p_tracker, p_section);
+            break;
+        default:
+            break;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_update_rst
+ *****************************************************************************/
+void dvbpsi_event_tracker_update_rst(dvbpsi_event_tracker_t *p_tracker,
+                                     const dvbpsi_rst_t *p_rst, int64_t i_date)
+{
+    for (const dvbpsi_rst_event_t *p_event = p_rst->p_first_event; p_event;
+         p_event = p_event->p_next)
+        tracker_RunningStatus(p_tracker, p_event->i_orig_network_id, p_event->i_ts_id,
+                              p_event->i_service_id, p_event->i_event_id,
+                              p_event->i_running_status, i_date);
+}
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_find
+ *****************************************************************************/
+const dvbpsi_event_tracker_service_t *dvbpsi_event_tracker_find(
+                                              const dvbpsi_event_tracker_t *p_tracker,
+                                              uint16_t i_onid, uint16_t i_tsid,
+                                              uint16_t i_service_id)
+{
+    const tracker_service_t *p_service = tracker_Find(p_tracker, i_onid, i_tsid, i_service_id);
+    return p_service ? &p_service->service : NULL;
+}
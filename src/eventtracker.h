@@ -0,0 +1,229 @@
+/*****************************************************************************
+ * eventtracker.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <eventtracker.h>
+ * \brief Application interface for the present/following event tracker.
+ *
+ * The tracker follows the present and following events of each service
+ * from the EIT present/following sections (table_id 0x4e and 0x4f, PID
+ * 0x12) and the running status sections (RST, PID 0x13). Each section is
+ * handled as soon as it is received, without waiting for the other
+ * sections of its table, and the callback is only called when the
+ * event_id or the running_status of the present or following event
+ * changes, which suits recording triggers.
+ *
+ * When the RST reports that the following event is running, it becomes
+ * the present event right away; the next EIT present/following section
+ * confirms it.
+ *
+ * dvbpsi.h, psi.h and tables/rst.h must be included before this file.
+ */
+
+#ifndef _DVBPSI_EVENTTRACKER_H_
+#define _DVBPSI_EVENTTRACKER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! The present event is another one */
+#define DVBPSI_EVENT_TRACKER_PRESENT_EVENT      0x01
+/*! The running_status of the present event changed */
+#define DVBPSI_EVENT_TRACKER_PRESENT_STATUS     0x02
+/*! The following event is another one */
+#define DVBPSI_EVENT_TRACKER_FOLLOWING_EVENT    0x04
+/*! The running_status of the following event changed */
+#define DVBPSI_EVENT_TRACKER_FOLLOWING_STATUS   0x08
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_event_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_event_tracker_event_s
+ * \brief Present or following event.
+ */
+/*!
+ * \typedef struct dvbpsi_event_tracker_event_s dvbpsi_event_tracker_event_t
+ * \brief dvbpsi_event_tracker_event_t type definition.
+ */
+typedef struct dvbpsi_event_tracker_event_s
+{
+    bool        b_valid;            /*!< an event is announced */
+    uint16_t    i_event_id;         /*!< event_id */
+    uint64_t    i_start_time;       /*!< start_time, MJD + BCD, see
+                                         streamclock.h */
+    uint32_t    i_duration;         /*!< duration, BCD */
+    uint8_t     i_running_status;   /*!< running_status */
+} dvbpsi_event_tracker_event_t;
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_service_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_event_tracker_service_s
+ * \brief Present/following state of a service.
+ */
+/*!
+ * \typedef struct dvbpsi_event_tracker_service_s dvbpsi_event_tracker_service_t
+ * \brief dvbpsi_event_tracker_service_t type definition.
+ */
+typedef struct dvbpsi_event_tracker_service_s
+{
+    uint16_t    i_onid;             /*!< original_network_id */
+    uint16_t    i_tsid;             /*!< transport_stream_id */
+    uint16_t    i_service_id;       /*!< service_id */
+
+    dvbpsi_event_tracker_event_t present;   /*!< present event */
+    dvbpsi_event_tracker_event_t following; /*!< following event */
+
+    int64_t     i_date;             /*!< completion date of the section that
+                                         caused the last change */
+} dvbpsi_event_tracker_service_t;
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_event_tracker_s dvbpsi_event_tracker_t
+ * \brief Opaque event tracker handle.
+ */
+typedef struct dvbpsi_event_tracker_s dvbpsi_event_tracker_t;
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_event_tracker_callback)(void *p_cb_data,
+                        const dvbpsi_event_tracker_service_t *p_service,
+                        unsigned int i_changes)
+ * \brief Callback type definition.
+ *
+ * i_changes is a combination of DVBPSI_EVENT_TRACKER_* flags. p_service
+ * stays valid as long as the tracker.
+ */
+typedef void (* dvbpsi_event_tracker_callback)(void *p_cb_data,
+                                               const dvbpsi_event_tracker_service_t *p_service,
+                                               unsigned int i_changes);
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_event_tracker_t *dvbpsi_event_tracker_new(
+                        dvbpsi_event_tracker_callback pf_callback, void *p_cb_data,
+                        dvbpsi_message_cb pf_message, enum dvbpsi_msg_level level)
+ * \brief Create an event tracker.
+ * \param pf_callback function called on event or running status changes
+ * \param p_cb_data private data given to pf_callback
+ * \param pf_message message callback of the section decoders, may be NULL
+ * \param level message level
+ * \return pointer to the tracker, NULL on error.
+ */
+dvbpsi_event_tracker_t *dvbpsi_event_tracker_new(dvbpsi_event_tracker_callback pf_callback,
+                                                 void *p_cb_data,
+                                                 dvbpsi_message_cb pf_message,
+                                                 enum dvbpsi_msg_level level);
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_event_tracker_delete(dvbpsi_event_tracker_t *p_tracker)
+ * \brief Destroy an event tracker.
+ * \param p_tracker pointer to the tracker
+ * \return nothing.
+ */
+void dvbpsi_event_tracker_delete(dvbpsi_event_tracker_t *p_tracker);
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_packet_push
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_event_tracker_packet_push(dvbpsi_event_tracker_t *p_tracker,
+                        const uint8_t *p_data, int64_t i_date)
+ * \brief Inject a TS packet.
+ * \param p_tracker pointer to the tracker
+ * \param p_data TS packet, the packets of other PIDs than 0x12 and 0x13 are
+ * ignored
+ * \param i_date arrival date of the packet, usually in microseconds
+ * \return false if the packet is not a valid EIT or RST packet.
+ */
+bool dvbpsi_event_tracker_packet_push(dvbpsi_event_tracker_t *p_tracker,
+                                      const uint8_t *p_data, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_section_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_event_tracker_section_push(dvbpsi_event_tracker_t *p_tracker,
+                        const dvbpsi_psi_section_t *p_section)
+ * \brief Inject a complete section, for example from the pf_section hook
+ * of the handle already decoding the EIT PID.
+ * \param p_tracker pointer to the tracker
+ * \param p_section section with a valid CRC, the sections other than EIT
+ * present/following and RST are ignored
+ * \return nothing.
+ */
+void dvbpsi_event_tracker_section_push(dvbpsi_event_tracker_t *p_tracker,
+                                       const dvbpsi_psi_section_t *p_section);
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_update_rst
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_event_tracker_update_rst(dvbpsi_event_tracker_t *p_tracker,
+                        const dvbpsi_rst_t *p_rst, int64_t i_date)
+ * \brief Apply an RST decoded by the RST decoder.
+ * \param p_tracker pointer to the tracker
+ * \param p_rst RST, owned by the caller
+ * \param i_date date at which the RST was received
+ * \return nothing.
+ */
+void dvbpsi_event_tracker_update_rst(dvbpsi_event_tracker_t *p_tracker,
+                                     const dvbpsi_rst_t *p_rst, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_event_tracker_find
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_event_tracker_service_t *dvbpsi_event_tracker_find(
+                        const dvbpsi_event_tracker_t *p_tracker, uint16_t i_onid,
+                        uint16_t i_tsid, uint16_t i_service_id)
+ * \brief Get the present/following state of a service.
+ * \param p_tracker pointer to the tracker
+ * \param i_onid original_network_id
+ * \param i_tsid transport_stream_id
+ * \param i_service_id service_id
+ * \return the state, NULL if no section concerned the service yet.
+ */
+const dvbpsi_event_tracker_service_t *dvbpsi_event_tracker_find(
+                                              const dvbpsi_event_tracker_t *p_tracker,
+                                              uint16_t i_onid, uint16_t i_tsid,
+                                              uint16_t i_service_id);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of eventtracker.h"
+#endif
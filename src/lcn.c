@@ -0,0 +1,873 @@
+/*****************************************************************************
+ * lcn.c: logical channel number engine
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "descriptor.h"
+#include "tables/nit.h"
+#include "tables/bat.h"
+#include "lcn.h"
+
+#define LCN_SLOTS                   (DVBPSI_LCN_MAX + 1)
+#define LCN_MIN_BUCKETS             256
+
+/* Kinds of source, the value is not the rank */
+#define LCN_SOURCE_NIT_ACTUAL       0
+#define LCN_SOURCE_NIT_OTHER        1
+#define LCN_SOURCE_BAT              2
+
+struct lcn_entry_s;
+struct lcn_source_s;
+
+/*****************************************************************************
+ * lcn_candidate_t
+ *****************************************************************************
+ * Number given to a service by one descriptor entry. The candidates are
+ * owned by their source and chained on their service.
+ *****************************************************************************/
+typedef struct lcn_candidate_s
+{
+    struct lcn_source_s        *p_source;
+    struct lcn_entry_s         *p_entry;
+    uint16_t                    i_onid;
+    uint16_t                    i_tsid;
+    uint16_t                    i_service_id;
+    uint16_t                    i_lcn;
+    bool                        b_visible;
+    uint8_t                     i_origin;       /* DVBPSI_LCN_ORIGIN_* */
+    uint8_t                     i_list_id;      /* channel_list_id of V2 */
+
+    struct lcn_candidate_s     *p_next;         /* next candidate of the service */
+} lcn_candidate_t;
+
+/*****************************************************************************
+ * lcn_source_t
+ *****************************************************************************
+ * Last version of a NIT or BAT.
+ *****************************************************************************/
+typedef struct lcn_source_s
+{
+    uint8_t                     i_kind;         /* LCN_SOURCE_* */
+    uint16_t                    i_id;           /* network_id or bouquet_id */
+    lcn_candidate_t            *p_candidates;
+    unsigned int                i_candidates;
+
+    struct lcn_source_s        *p_next;
+} lcn_source_t;
+
+/*****************************************************************************
+ * lcn_entry_t
+ *****************************************************************************/
+typedef struct lcn_entry_s
+{
+    dvbpsi_lcn_service_t        service;        /* must be first */
+    dvbpsi_lcn_service_t        published;      /* as last reported */
+    int                         i_rank;         /* rank of the source */
+
+    lcn_candidate_t            *p_first_candidate;
+
+    struct lcn_entry_s         *p_next_hash;
+    struct lcn_entry_s         *p_next_slot;    /* services with the same
+                                                   number, in rank order */
+    bool                        b_dirty;        /* to be resolved */
+    struct lcn_entry_s         *p_next_dirty;
+    bool                        b_notify;       /* to be reported */
+    struct lcn_entry_s         *p_next_notify;
+} lcn_entry_t;
+
+/*****************************************************************************
+ * lcn_builder_t
+ *****************************************************************************
+ * Candidates of the table being parsed.
+ *****************************************************************************/
+typedef struct lcn_builder_s
+{
+    lcn_candidate_t            *p_candidates;
+    unsigned int                i_candidates;
+    unsigned int                i_size;
+    bool                        b_error;
+} lcn_builder_t;
+
+/*****************************************************************************
+ * dvbpsi_lcn_s
+ *****************************************************************************/
+struct dvbpsi_lcn_s
+{
+    dvbpsi_lcn_callback         pf_callback;
+    void                       *p_cb_data;
+
+    /* Settings */
+    uint32_t                    i_default_pds;
+    bool                        b_hd_simulcast;
+    int                         i_channel_list;
+    int                         i_bouquet;
+
+    lcn_source_t               *p_first_source;
+
+    /* Services by (onid, tsid, service_id) */
+    lcn_entry_t               **pp_buckets;
+    unsigned int                i_buckets;      /* power of 2 */
+    unsigned int                i_entries;
+    unsigned int                i_assigned;
+
+    /* Services by number */
+    lcn_entry_t                *pp_slots[LCN_SLOTS];
+    uint64_t                    p_used[LCN_SLOTS / 64];
+
+    lcn_entry_t                *p_dirty;
+    lcn_entry_t                *p_notify;
+};
+
+/*****************************************************************************
+ * lcn_Hash
+ *****************************************************************************/
+static inline unsigned int lcn_Hash(uint16_t i_onid, uint16_t i_tsid, uint16_t i_service_id,
+                                    unsigned int i_buckets)
+{
+    uint64_t i_key = ((uint64_t)i_onid << 32) | ((uint64_t)i_tsid << 16) | i_service_id;
+    return (unsigned int)((i_key * UINT64_C(0x9e3779b97f4a7c15)) >> 32) & (i_buckets - 1);
+}
+
+/*****************************************************************************
+ * lcn_Find
+ *****************************************************************************/
+static lcn_entry_t *lcn_Find(const dvbpsi_lcn_t *p_lcn, uint16_t i_onid, uint16_t i_tsid,
+                             uint16_t i_service_id)
+{
+    lcn_entry_t *p = p_lcn->pp_buckets[lcn_Hash(i_onid, i_tsid, i_service_id, p_lcn->i_buckets)];
+    while (p && (p->service.i_onid != i_onid || p->service.i_tsid != i_tsid
+              || p->service.i_service_id != i_service_id))
+        p = p->p_next_hash;
+    return p;
+}
+
+/*****************************************************************************
+ * lcn_Get
+ *****************************************************************************
+ * Find or create the entry of a service. The hash doubles when it holds as
+ * many entries as buckets; if that fails the chains just get longer.
+ *****************************************************************************/
+static lcn_entry_t *lcn_Get(dvbpsi_lcn_t *p_lcn, uint16_t i_onid, uint16_t i_tsid,
+                            uint16_t i_service_id)
+{
+    lcn_entry_t *p_entry = lcn_Find(p_lcn, i_onid, i_tsid, i_service_id);
+    if (p_entry)
+        return p_entry;
+
+    if (p_lcn->i_entries >= p_lcn->i_buckets)
+    {
+        unsigned int i_buckets = p_lcn->i_buckets * 2;
+        lcn_entry_t **pp_buckets = calloc(i_buckets, sizeof(lcn_entry_t *));
+        if (pp_buckets)
+        {
+            for (unsigned int i = 0; i < p_lcn->i_buckets; i++)
+            {
+                lcn_entry_t *p = p_lcn->pp_buckets[i];
+                while (p)
+                {
+                    lcn_entry_t *p_next = p->p_next_hash;
+                    unsigned int i_hash = lcn_Hash(p->service.i_onid, p->service.i_tsid,
+                                                   p->service.i_service_id, i_buckets);
+                    p->p_next_hash = pp_buckets[i_hash];
+                    pp_buckets[i_hash] = p;
+                    p = p_next;
+                }
+            }
+            free(p_lcn->pp_buckets);
+            p_lcn->pp_buckets = pp_buckets;
+            p_lcn->i_buckets = i_buckets;
+        }
+    }
+
+    p_entry = calloc(1, sizeof(lcn_entry_t));
+    if (!p_entry)
+        return NULL;
+    p_entry->service.i_onid = i_onid;
+    p_entry->service.i_tsid = i_tsid;
+    p_entry->service.i_service_id = i_service_id;
+    p_entry->published = p_entry->service;
+
+    unsigned int i_hash = lcn_Hash(i_onid, i_tsid, i_service_id, p_lcn->i_buckets);
+    p_entry->p_next_hash = p_lcn->pp_buckets[i_hash];
+    p_lcn->pp_buckets[i_hash] = p_entry;
+    p_lcn->i_entries++;
+    return p_entry;
+}
+
+/*****************************************************************************
+ * lcn_Free
+ *****************************************************************************/
+static void lcn_Free(dvbpsi_lcn_t *p_lcn, lcn_entry_t *p_entry)
+{
+    unsigned int i_hash = lcn_Hash(p_entry->service.i_onid, p_entry->service.i_tsid,
+                                   p_entry->service.i_service_id, p_lcn->i_buckets);
+    lcn_entry_t **pp = &p_lcn->pp_buckets[i_hash];
+    while (*pp != p_entry)
+        pp = &(*pp)->p_next_hash;
+    *pp = p_entry->p_next_hash;
+    p_lcn->i_entries--;
+    free(p_entry);
+}
+
+/*****************************************************************************
+ * lcn_MarkDirty / lcn_MarkNotify
+ *****************************************************************************/
+static void lcn_MarkDirty(dvbpsi_lcn_t *p_lcn, lcn_entry_t *p_entry)
+{
+    if (p_entry->b_dirty)
+        return;
+    p_entry->b_dirty = true;
+    p_entry->p_next_dirty = p_lcn->p_dirty;
+    p_lcn->p_dirty = p_entry;
+}
+
+static void lcn_MarkNotify(dvbpsi_lcn_t *p_lcn, lcn_entry_t *p_entry)
+{
+    if (p_entry->b_notify)
+        return;
+    p_entry->b_notify = true;
+    p_entry->p_next_notify = p_lcn->p_notify;
+    p_lcn->p_notify = p_entry;
+}
+
+/*****************************************************************************
+ * lcn_Rank
+ *****************************************************************************
+ * Rank of a candidate, lower is better, -1 if the settings exclude it.
+ *****************************************************************************/
+static int lcn_Rank(const dvbpsi_lcn_t *p_lcn, const lcn_candidate_t *p_cand)
+{
+    int i_origin, i_source;
+
+    switch (p_cand->i_origin)
+    {
+        case DVBPSI_LCN_ORIGIN_HD_SIMULCAST:
+            if (!p_lcn->b_hd_simulcast)
+                return -1;
+            i_origin = 0;
+            break;
+        case DVBPSI_LCN_ORIGIN_V2:
+            if (p_lcn->i_channel_list >= 0 && p_cand->i_list_id != p_lcn->i_channel_list)
+                return -1;
+            i_origin = 1;
+            break;
+        default:
+            i_origin = 2;
+            break;
+    }
+
+    switch (p_cand->p_source->i_kind)
+    {
+        case LCN_SOURCE_BAT:
+            if (p_lcn->i_bouquet < 0)
+                i_source = 2;
+            else if (p_cand->p_source->i_id == p_lcn->i_bouquet)
+                i_source = 0;
+            else
+                return -1;
+            break;
+        case LCN_SOURCE_NIT_ACTUAL:
+            i_source = 1;
+            break;
+        default:
+            i_source = 3;
+            break;
+    }
+
+    return i_source * 3 + i_origin;
+}
+
+/*****************************************************************************
+ * lcn_Before
+ *****************************************************************************
+ * Order of the services sharing a number.
+ *****************************************************************************/
+static bool lcn_Before(const lcn_entry_t *a, const lcn_entry_t *b)
+{
+    if (a->service.b_visible != b->service.b_visible)
+        return a->service.b_visible;
+    if (a->i_rank != b->i_rank)
+        return a->i_rank < b->i_rank;
+    if (a->service.i_onid != b->service.i_onid)
+        return a->service.i_onid < b->service.i_onid;
+    if (a->service.i_tsid != b->service.i_tsid)
+        return a->service.i_tsid < b->service.i_tsid;
+    return a->service.i_service_id < b->service.i_service_id;
+}
+
+/*****************************************************************************
+ * lcn_SlotRemove / lcn_SlotInsert
+ *****************************************************************************
+ * The services of the slot are reported since their conflict state may
+ * change.
+ *****************************************************************************/
+static void lcn_SlotRemove(dvbpsi_lcn_t *p_lcn, lcn_entry_t *p_entry)
+{
+    uint16_t i_lcn = p_entry->service.i_lcn;
+    lcn_entry_t **pp = &p_lcn->pp_slots[i_lcn];
+    while (*pp != p_entry)
+    {
+        assert(*pp);
+        pp = &(*pp)->p_next_slot;
+    }
+    *pp = p_entry->p_next_slot;
+    p_entry->p_next_slot = NULL;
+
+    for (lcn_entry_t *p = p_lcn->pp_slots[i_lcn]; p; p = p->p_next_slot)
+        lcn_MarkNotify(p_lcn, p);
+    if (!p_lcn->pp_slots[i_lcn])
+        p_lcn->p_used[i_lcn / 64] &= ~(UINT64_C(1) << (i_lcn % 64));
+    p_lcn->i_assigned--;
+}
+
+static void lcn_SlotInsert(dvbpsi_lcn_t *p_lcn, lcn_entry_t *p_entry)
+{
+    uint16_t i_lcn = p_entry->service.i_lcn;
+    lcn_entry_t **pp = &p_lcn->pp_slots[i_lcn];
+    while (*pp && !lcn_Before(p_entry, *pp))
+        pp = &(*pp)->p_next_slot;
+    p_entry->p_next_slot = *pp;
+    *pp = p_entry;
+
+    for (lcn_entry_t *p = p_lcn->pp_slots[i_lcn]; p; p = p->p_next_slot)
+        lcn_MarkNotify(p_lcn, p);
+    p_lcn->p_used[i_lcn / 64] |= UINT64_C(1) << (i_lcn % 64);
+    p_lcn->i_assigned++;
+}
+
+/*****************************************************************************
+ * lcn_Resolve
+ *****************************************************************************
+ * Choose the number of a service among its candidates.
+ *****************************************************************************/
+static void lcn_Resolve(dvbpsi_lcn_t *p_lcn, lcn_entry_t *p_entry)
+{
+    const lcn_candidate_t *p_best = NULL;
+    int i_best = -1;
+
+    for (const lcn_candidate_t *p = p_entry->p_first_candidate; p; p = p->p_next)
+    {
+        int i_rank = lcn_Rank(p_lcn, p);
+        if (i_rank < 0)
+            continue;
+        if (p_best)
+        {
+            if (i_rank != i_best)
+            {
+                if (i_rank > i_best)
+                    continue;
+            }
+            else if (p->p_source->i_id != p_best->p_source->i_id)
+            {
+                if (p->p_source->i_id > p_best->p_source->i_id)
+                    continue;
+            }
+            else if (p->i_list_id != p_best->i_list_id)
+            {
+                if (p->i_list_id > p_best->i_list_id)
+                    continue;
+            }
+            else if (p->i_lcn >= p_best->i_lcn)
+                continue;
+        }
+        p_best = p;
+        i_best = i_rank;
+    }
+
+    dvbpsi_lcn_service_t *p_service = &p_entry->service;
+    if (p_best && p_service->b_assigned && p_service->i_lcn == p_best->i_lcn
+     && p_service->b_visible == p_best->b_visible && p_entry->i_rank == i_best
+     && p_service->i_origin == p_best->i_origin
+     && p_service->i_source_id == p_best->p_source->i_id
+     && p_service->b_bat == (p_best->p_source->i_kind == LCN_SOURCE_BAT)
+     && p_service->i_channel_list_id == p_best->i_list_id)
+        return;
+    if (!p_best && !p_service->b_assigned)
+        return;
+
+    if (p_service->b_assigned)
+        lcn_SlotRemove(p_lcn, p_entry);
+
+    if (p_best)
+    {
+        p_service->b_assigned = true;
+        p_service->i_lcn = p_best->i_lcn;
+        p_service->b_visible = p_best->b_visible;
+        p_service->i_origin = p_best->i_origin;
+        p_service->b_bat = p_best->p_source->i_kind == LCN_SOURCE_BAT;
+        p_service->i_source_id = p_best->p_source->i_id;
+        p_service->i_channel_list_id = p_best->i_list_id;
+        p_entry->i_rank = i_best;
+        lcn_SlotInsert(p_lcn, p_entry);
+    }
+    else
+    {
+        p_service->b_assigned = false;
+        p_service->i_lcn = 0;
+        p_service->b_visible = false;
+        p_service->i_origin = 0;
+        p_service->b_bat = false;
+        p_service->i_source_id = 0;
+        p_service->i_channel_list_id = 0;
+        p_entry->i_rank = -1;
+    }
+    lcn_MarkNotify(p_lcn, p_entry);
+}
+
+/*****************************************************************************
+ * lcn_Same
+ *****************************************************************************/
+static bool lcn_Same(const dvbpsi_lcn_service_t *a, const dvbpsi_lcn_service_t *b)
+{
+    return a->b_assigned == b->b_assigned && a->i_lcn == b->i_lcn
+        && a->b_visible == b->b_visible && a->b_conflict == b->b_conflict
+        && a->i_origin == b->i_origin && a->b_bat == b->b_bat
+        && a->i_source_id == b->i_source_id
+        && a->i_channel_list_id == b->i_channel_list_id;
+}
+
+/*****************************************************************************
+ * lcn_Process
+ *****************************************************************************
+ * Resolve the services whose candidates changed and report the services
+ * whose state changed. Services without number nor candidate are freed.
+ *****************************************************************************/
+static void lcn_Process(dvbpsi_lcn_t *p_lcn)
+{
+    lcn_entry_t *p_entry;
+
+    while ((p_entry = p_lcn->p_dirty) != NULL)
+    {
+        p_lcn->p_dirty = p_entry->p_next_dirty;
+        p_entry->b_dirty = false;
+        lcn_Resolve(p_lcn, p_entry);
+        if (!p_entry->service.b_assigned && !p_entry->p_first_candidate)
+            lcn_MarkNotify(p_lcn, p_entry);
+    }
+
+    while ((p_entry = p_lcn->p_notify) != NULL)
+    {
+        p_lcn->p_notify = p_entry->p_next_notify;
+        p_entry->b_notify = false;
+
+        dvbpsi_lcn_service_t *p_service = &p_entry->service;
+        p_service->b_conflict = p_service->b_assigned
+                             && p_lcn->pp_slots[p_service->i_lcn] != p_entry;
+
+        if ((p_service->b_assigned || p_entry->published.b_assigned)
+         && !lcn_Same(p_service, &p_entry->published))
+        {
+            p_entry->published = *p_service;
+            if (p_lcn->pf_callback)
+                p_lcn->pf_callback(p_lcn->p_cb_data, p_service);
+        }
+
+        if (!p_service->b_assigned && !p_entry->p_first_candidate)
+            lcn_Free(p_lcn, p_entry);
+    }
+}
+
+/*****************************************************************************
+ * lcn_Add
+ *****************************************************************************/
+static void lcn_Add(lcn_builder_t *p_builder, uint16_t i_onid, uint16_t i_tsid,
+                    uint16_t i_service_id, uint16_t i_lcn, bool b_visible,
+                    uint8_t i_origin, uint8_t i_list_id)
+{
+    if (i_lcn == 0 || p_builder->b_error)
+        return; /* 0 is no number */
+
+    if (p_builder->i_candidates == p_builder->i_size)
+    {
+        unsigned int i_size = p_builder->i_size ? 2 * p_builder->i_size : 64;
+        lcn_candidate_t *p = realloc(p_builder->p_candidates, i_size * sizeof(lcn_candidate_t));
+        if (!p)
+        {
+            p_builder->b_error = true;
+            return;
+        }
+        p_builder->p_candidates = p;
+        p_builder->i_size = i_size;
+    }
+
+    lcn_candidate_t *p_cand = &p_builder->p_candidates[p_builder->i_candidates++];
+    memset(p_cand, 0, sizeof(lcn_candidate_t));
+    p_cand->i_onid = i_onid;
+    p_cand->i_tsid = i_tsid;
+    p_cand->i_service_id = i_service_id;
+    p_cand->i_lcn = i_lcn;
+    p_cand->b_visible = b_visible;
+    p_cand->i_origin = i_origin;
+    p_cand->i_list_id = i_list_id;
+}
+
+/*****************************************************************************
+ * lcn_ParseLoop
+ *****************************************************************************
+ * Collect the numbers of a transport stream loop.
+ *****************************************************************************/
+static void lcn_ParseLoop(const dvbpsi_lcn_t *p_lcn, lcn_builder_t *p_builder,
+                          uint16_t i_onid, uint16_t i_tsid, const dvbpsi_descriptor_t *p_dr)
+{
+    uint32_t i_pds = p_lcn->i_default_pds;
+
+    for (; p_dr; p_dr = p_dr->p_next)
+    {
+        const uint8_t *p_data = p_dr->p_data;
+
+        if (p_dr->i_tag == 0x5f)
+        {
+            if (p_dr->i_length >= 4)
+                i_pds = (uint32_t)p_data[0] << 24 | (uint32_t)p_data[1] << 16
+                      | (uint32_t)p_data[2] << 8 | p_data[3];
+            continue;
+        }
+        if (i_pds != DVBPSI_LCN_PDS_EACEM && i_pds != DVBPSI_LCN_PDS_NORDIG
+         && i_pds != DVBPSI_LCN_PDS_DTG && i_pds != p_lcn->i_default_pds)
+            continue;
+
+        switch (p_dr->i_tag)
+        {
+            case 0x83: /* logical_channel_descriptor */
+            case 0x88: /* HD_simulcast_logical_channel_descriptor */
+            {
+                bool b_hd = p_dr->i_tag == 0x88;
+                if (b_hd && i_pds == DVBPSI_LCN_PDS_NORDIG)
+                    break;
+                uint16_t i_mask = (i_pds == DVBPSI_LCN_PDS_NORDIG) ? 0x3fff : 0x03ff;
+                for (unsigned int i = 0; i + 4 <= p_dr->i_length; i += 4)
+                    lcn_Add(p_builder, i_onid, i_tsid,
+                            (uint16_t)(p_data[i] << 8 | p_data[i + 1]),
+                            (uint16_t)(p_data[i + 2] << 8 | p_data[i + 3]) & i_mask,
+                            (p_data[i + 2] & 0x80) != 0,
+                            b_hd ? DVBPSI_LCN_ORIGIN_HD_SIMULCAST : DVBPSI_LCN_ORIGIN_V1, 0);
+                break;
+            }
+            case 0x87: /* NorDig logical_channel_descriptor version 2 */
+            {
+                if (i_pds != DVBPSI_LCN_PDS_NORDIG)
+                    break;
+                unsigned int i = 0;
+                while (i + 2 <= p_dr->i_length)
+                {
+                    uint8_t i_list_id = p_data[i];
+                    i += 2 + p_data[i + 1];         /* channel_list_name */
+                    if (i + 4 > p_dr->i_length)
+                        break;
+                    i += 3;                         /* country_code */
+                    unsigned int i_end = i + 1 + p_data[i];
+                    if (i_end > p_dr->i_length)
+                        break;
+                    for (i++; i + 4 <= i_end; i += 4)
+                        lcn_Add(p_builder, i_onid, i_tsid,
+                                (uint16_t)(p_data[i] << 8 | p_data[i + 1]),
+                                (uint16_t)(p_data[i + 2] << 8 | p_data[i + 3]) & 0x03ff,
+                                (p_data[i + 2] & 0x80) != 0,
+                                DVBPSI_LCN_ORIGIN_V2, i_list_id);
+                    i = i_end;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+/*****************************************************************************
+ * lcn_Apply
+ *****************************************************************************
+ * Replace the candidates of a source with those of the builder.
+ *****************************************************************************/
+static bool lcn_Apply(dvbpsi_lcn_t *p_lcn, uint8_t i_kind, uint16_t i_id,
+                      lcn_builder_t *p_builder)
+{
+    lcn_source_t *p_source = p_lcn->p_first_source;
+    while (p_source && (p_source->i_kind != i_kind || p_source->i_id != i_id))
+        p_source = p_source->p_next;
+
+    if (!p_builder->b_error && !p_source)
+    {
+        p_source = calloc(1, sizeof(lcn_source_t));
+        if (p_source)
+        {
+            p_source->i_kind = i_kind;
+            p_source->i_id = i_id;
+            p_source->p_next = p_lcn->p_first_source;
+            p_lcn->p_first_source = p_source;
+        }
+    }
+
+    /* Create the services first so that nothing changes on error */
+    for (unsigned int i = 0; p_source && !p_builder->b_error && i < p_builder->i_candidates; i++)
+    {
+        lcn_candidate_t *p_cand = &p_builder->p_candidates[i];
+        p_cand->p_source = p_source;
+        p_cand->p_entry = lcn_Get(p_lcn, p_cand->i_onid, p_cand->i_tsid, p_cand->i_service_id);
+        if (!p_cand->p_entry)
+            p_builder->b_error = true;
+        else
+            lcn_MarkDirty(p_lcn, p_cand->p_entry);
+    }
+    if (!p_source || p_builder->b_error)
+    {
+        free(p_builder->p_candidates);
+        lcn_Process(p_lcn); /* frees the services created for nothing */
+        return false;
+    }
+
+    for (unsigned int i = 0; i < p_source->i_candidates; i++)
+    {
+        lcn_candidate_t *p_cand = &p_source->p_candidates[i];
+        lcn_candidate_t **pp = &p_cand->p_entry->p_first_candidate;
+        while (*pp != p_cand)
+            pp = &(*pp)->p_next;
+        *pp = p_cand->p_next;
+        lcn_MarkDirty(p_lcn, p_cand->p_entry);
+    }
+    free(p_source->p_candidates);
+
+    p_source->p_candidates = p_builder->p_candidates;
+    p_source->i_candidates = p_builder->i_candidates;
+    for (unsigned int i = 0; i < p_source->i_candidates; i++)
+    {
+        lcn_candidate_t *p_cand = &p_source->p_candidates[i];
+        p_cand->p_next = p_cand->p_entry->p_first_candidate;
+        p_cand->p_entry->p_first_candidate = p_cand;
+    }
+
+    lcn_Process(p_lcn);
+    return true;
+}
+
+/*****************************************************************************
+ * lcn_ResolveAll
+ *****************************************************************************
+ * Called when a setting changes the ranks.
+ *****************************************************************************/
+static void lcn_ResolveAll(dvbpsi_lcn_t *p_lcn)
+{
+    for (unsigned int i = 0; i < p_lcn->i_buckets; i++)
+        for (lcn_entry_t *p = p_lcn->pp_buckets[i]; p; p = p->p_next_hash)
+            lcn_MarkDirty(p_lcn, p);
+    lcn_Process(p_lcn);
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_new
+ *****************************************************************************/
+dvbpsi_lcn_t *dvbpsi_lcn_new(dvbpsi_lcn_callback pf_callback, void *p_cb_data)
+{
+    dvbpsi_lcn_t *p_lcn = calloc(1, sizeof(dvbpsi_lcn_t));
+    if (!p_lcn)
+        return NULL;
+
+    p_lcn->pp_buckets = calloc(LCN_MIN_BUCKETS, sizeof(lcn_entry_t *));
+    if (!p_lcn->pp_buckets)
+    {
+        free(p_lcn);
+        return NULL;
+    }
+    p_lcn->i_buckets = LCN_MIN_BUCKETS;
+
+    p_lcn->pf_callback = pf_callback;
+    p_lcn->p_cb_data = p_cb_data;
+    p_lcn->i_default_pds = DVBPSI_LCN_PDS_EACEM;
+    p_lcn->i_channel_list = -1;
+    p_lcn->i_bouquet = -1;
+    return p_lcn;
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_delete
+ *****************************************************************************/
+void dvbpsi_lcn_delete(dvbpsi_lcn_t *p_lcn)
+{
+    if (!p_lcn)
+        return;
+
+    for (unsigned int i = 0; i < p_lcn->i_buckets; i++)
+    {
+        lcn_entry_t *p = p_lcn->pp_buckets[i];
+        while (p)
+        {
+            lcn_entry_t *p_next = p->p_next_hash;
+            free(p);
+            p = p_next;
+        }
+    }
+    free(p_lcn->pp_buckets);
+
+    lcn_source_t *p_source = p_lcn->p_first_source;
+    while (p_source)
+    {
+        lcn_source_t *p_next = p_source->p_next;
+        free(p_source->p_candidates);
+        free(p_source);
+        p_source = p_next;
+    }
+    free(p_lcn);
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_set_*
+ *****************************************************************************/
+void dvbpsi_lcn_set_default_pds(dvbpsi_lcn_t *p_lcn, uint32_t i_pds)
+{
+    p_lcn->i_default_pds = i_pds;
+}
+
+void dvbpsi_lcn_set_hd_simulcast(dvbpsi_lcn_t *p_lcn, bool b_enable)
+{
+    if (p_lcn->b_hd_simulcast == b_enable)
+        return;
+    p_lcn->b_hd_simulcast = b_enable;
+    lcn_ResolveAll(p_lcn);
+}
+
+void dvbpsi_lcn_set_channel_list(dvbpsi_lcn_t *p_lcn, int i_channel_list_id)
+{
+    if (i_channel_list_id < 0)
+        i_channel_list_id = -1;
+    if (p_lcn->i_channel_list == i_channel_list_id)
+        return;
+    p_lcn->i_channel_list = i_channel_list_id;
+    lcn_ResolveAll(p_lcn);
+}
+
+void dvbpsi_lcn_set_bouquet(dvbpsi_lcn_t *p_lcn, int i_bouquet_id)
+{
+    if (i_bouquet_id < 0)
+        i_bouquet_id = -1;
+    if (p_lcn->i_bouquet == i_bouquet_id)
+        return;
+    p_lcn->i_bouquet = i_bouquet_id;
+    lcn_ResolveAll(p_lcn);
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_update_nit
+ *****************************************************************************/
+bool dvbpsi_lcn_update_nit(dvbpsi_lcn_t *p_lcn, const dvbpsi_nit_t *p_nit)
+{
+    lcn_builder_t builder = { NULL, 0, 0, false };
+
+    for (const dvbpsi_nit_ts_t *p_ts = p_nit->p_first_ts; p_ts; p_ts = p_ts->p_next)
+        lcn_ParseLoop(p_lcn, &builder, p_ts->i_orig_network_id, p_ts->i_ts_id,
+                      p_ts->p_first_descriptor);
+
+    return lcn_Apply(p_lcn, p_nit->i_table_id == 0x40 ? LCN_SOURCE_NIT_ACTUAL
+                                                      : LCN_SOURCE_NIT_OTHER,
+                     p_nit->i_network_id, &builder);
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_update_bat
+ *****************************************************************************/
+bool dvbpsi_lcn_update_bat(dvbpsi_lcn_t *p_lcn, const dvbpsi_bat_t *p_bat)
+{
+    lcn_builder_t builder = { NULL, 0, 0, false };
+
+    for (const dvbpsi_bat_ts_t *p_ts = p_bat->p_first_ts; p_ts; p_ts = p_ts->p_next)
+        lcn_ParseLoop(p_lcn, &builder, p_ts->i_orig_network_id, p_ts->i_ts_id,
+                      p_ts->p_first_descriptor);
+
+    return lcn_Apply(p_lcn, LCN_SOURCE_BAT, p_bat->i_extension, &builder);
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_find
+ *****************************************************************************/
+const dvbpsi_lcn_service_t *dvbpsi_lcn_find(const dvbpsi_lcn_t *p_lcn, uint16_t i_onid,
+                                            uint16_t i_tsid, uint16_t i_service_id)
+{
+    const lcn_entry_t *p_entry = lcn_Find(p_lcn, i_onid, i_tsid, i_service_id);
+    return (p_entry && p_entry->service.b_assigned) ? &p_entry->service : NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_lookup
+ *****************************************************************************/
+const dvbpsi_lcn_service_t *dvbpsi_lcn_lookup(const dvbpsi_lcn_t *p_lcn, uint16_t i_lcn)
+{
+    if (i_lcn > DVBPSI_LCN_MAX || !p_lcn->pp_slots[i_lcn])
+        return NULL;
+    return &p_lcn->pp_slots[i_lcn]->service;
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_list
+ *****************************************************************************/
+unsigned int dvbpsi_lcn_list(const dvbpsi_lcn_t *p_lcn, uint16_t i_first_lcn,
+                             const dvbpsi_lcn_service_t **pp_services,
+                             unsigned int i_max_services)
+{
+    unsigned int i_count = 0;
+
+    for (unsigned int i_word = i_first_lcn / 64; i_word < LCN_SLOTS / 64; i_word++)
+    {
+        uint64_t i_bits = p_lcn->p_used[i_word];
+        if (i_word == i_first_lcn / 64U)
+            i_bits &= ~UINT64_C(0) << (i_first_lcn % 64);
+
+        while (i_bits)
+        {
+            unsigned int i_bit = 0;
+            while (!(i_bits & (UINT64_C(1) << i_bit)))
+                i_bit++;
+            i_bits &= i_bits - 1;
+
+            unsigned int i_slot_count = 0;
+            const lcn_entry_t *p_first = p_lcn->pp_slots[i_word * 64 + i_bit];
+            for (const lcn_entry_t *p = p_first; p; p = p->p_next_slot)
+                i_slot_count++;
+            if (i_count + i_slot_count > i_max_services)
+                return i_count;
+            for (const lcn_entry_t *p = p_first; p; p = p->p_next_slot)
+                pp_services[i_count++] = &p->service;
+        }
+    }
+    return i_count;
+}
+
+/*****************************************************************************
+ * dvbpsi_lcn_count
+ *****************************************************************************/
+unsigned int dvbpsi_lcn_count(const dvbpsi_lcn_t *p_lcn)
+{
+    return p_lcn->i_assigned;
+}
@@ -0,0 +1,301 @@
+/*****************************************************************************
+ * lcn.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <lcn.h>
+ * \brief Application interface for the logical channel number engine.
+ *
+ * The engine reads the logical channel numbers of the transport stream
+ * loops of the NITs and BATs applied to it:
+ * - the EACEM logical_channel_descriptor (0x83), with the 14 bit numbers of
+ *   NorDig version 1 when the private_data_specifier is NorDig,
+ * - the NorDig logical_channel_descriptor version 2 (0x87), which holds one
+ *   channel list per region,
+ * - the HD_simulcast_logical_channel_descriptor (0x88).
+ * Private descriptors are interpreted according to the last
+ * private_data_specifier_descriptor (0x5f) of their loop, the descriptors
+ * under an unknown specifier are ignored. The number 0 means that the
+ * service has no number.
+ *
+ * Each table replaces the numbers it gave before, so applying a new version
+ * only costs the size of that table. A service numbered by several tables
+ * keeps the number of the best source: the HD simulcast number (if enabled)
+ * beats the version 2 number, which beats the version 1 number, and the
+ * preferred bouquet beats the NIT actual, the other BATs and the NIT other,
+ * in that order. Ties go to the lowest network or bouquet id then to the
+ * lowest number. Services claiming the same number are ranked: visible
+ * services first, then by source, then by (onid, tsid, service_id). The
+ * first one owns the number, the others are marked as conflicting.
+ *
+ * tables/nit.h and tables/bat.h must be included before this file.
+ */
+
+#ifndef _DVBPSI_LCN_H_
+#define _DVBPSI_LCN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Highest logical channel number */
+#define DVBPSI_LCN_MAX                      0x3fff
+
+/*! Number given by a logical_channel_descriptor (0x83) */
+#define DVBPSI_LCN_ORIGIN_V1                0
+/*! Number given by a NorDig logical_channel_descriptor version 2 (0x87) */
+#define DVBPSI_LCN_ORIGIN_V2                1
+/*! Number given by an HD_simulcast_logical_channel_descriptor (0x88) */
+#define DVBPSI_LCN_ORIGIN_HD_SIMULCAST      2
+
+/*! private_data_specifier of EACEM */
+#define DVBPSI_LCN_PDS_EACEM                0x00000028
+/*! private_data_specifier of NorDig */
+#define DVBPSI_LCN_PDS_NORDIG               0x00000029
+/*! private_data_specifier of the UK DTG */
+#define DVBPSI_LCN_PDS_DTG                  0x0000233a
+
+/*****************************************************************************
+ * dvbpsi_lcn_service_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_lcn_service_s
+ * \brief Logical channel number of a service.
+ */
+/*!
+ * \typedef struct dvbpsi_lcn_service_s dvbpsi_lcn_service_t
+ * \brief dvbpsi_lcn_service_t type definition.
+ */
+typedef struct dvbpsi_lcn_service_s
+{
+    uint16_t    i_onid;             /*!< original_network_id */
+    uint16_t    i_tsid;             /*!< transport_stream_id */
+    uint16_t    i_service_id;       /*!< service_id */
+
+    bool        b_assigned;         /*!< the fields below are valid */
+    uint16_t    i_lcn;              /*!< logical_channel_number */
+    bool        b_visible;          /*!< visible_service_flag */
+    bool        b_conflict;         /*!< a better ranked service has the same
+                                         number */
+    uint8_t     i_origin;           /*!< DVBPSI_LCN_ORIGIN_* */
+    bool        b_bat;              /*!< the number comes from a BAT */
+    uint16_t    i_source_id;        /*!< network_id or bouquet_id of the
+                                         table giving the number */
+    uint8_t     i_channel_list_id;  /*!< channel_list_id of a version 2
+                                         number */
+} dvbpsi_lcn_service_t;
+
+/*****************************************************************************
+ * dvbpsi_lcn_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_lcn_s dvbpsi_lcn_t
+ * \brief Opaque logical channel number engine handle.
+ */
+typedef struct dvbpsi_lcn_s dvbpsi_lcn_t;
+
+/*****************************************************************************
+ * dvbpsi_lcn_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_lcn_callback)(void *p_cb_data,
+                                         const dvbpsi_lcn_service_t *p_service)
+ * \brief Callback type definition, called when the number, visibility or
+ * conflict state of a service changes. When b_assigned is false the
+ * service has lost its number and p_service is no longer valid after the
+ * callback. The engine must not be updated from the callback.
+ */
+typedef void (* dvbpsi_lcn_callback)(void *p_cb_data, const dvbpsi_lcn_service_t *p_service);
+
+/*****************************************************************************
+ * dvbpsi_lcn_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_lcn_t *dvbpsi_lcn_new(dvbpsi_lcn_callback pf_callback, void *p_cb_data)
+ * \brief Create a logical channel number engine.
+ * \param pf_callback function called when a number changes, may be NULL
+ * \param p_cb_data private data given to pf_callback
+ * \return pointer to the engine, NULL on error.
+ *
+ * By default descriptors without private_data_specifier are read as EACEM
+ * ones, HD simulcast numbers are ignored, the version 2 number of the lowest
+ * channel_list_id is used and every BAT is a source.
+ */
+dvbpsi_lcn_t *dvbpsi_lcn_new(dvbpsi_lcn_callback pf_callback, void *p_cb_data);
+
+/*****************************************************************************
+ * dvbpsi_lcn_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_lcn_delete(dvbpsi_lcn_t *p_lcn)
+ * \brief Destroy a logical channel number engine. No callback is raised.
+ * \param p_lcn pointer to the engine
+ * \return nothing.
+ */
+void dvbpsi_lcn_delete(dvbpsi_lcn_t *p_lcn);
+
+/*****************************************************************************
+ * dvbpsi_lcn_set_default_pds
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_lcn_set_default_pds(dvbpsi_lcn_t *p_lcn, uint32_t i_pds)
+ * \brief Set the private_data_specifier assumed for the descriptors that
+ * are not preceded by a private_data_specifier_descriptor. It is also
+ * accepted in addition to the EACEM, NorDig and DTG ones.
+ * \param p_lcn pointer to the engine
+ * \param i_pds private_data_specifier, DVBPSI_LCN_PDS_EACEM by default
+ * \return nothing.
+ *
+ * The setting applies to the tables applied afterwards.
+ */
+void dvbpsi_lcn_set_default_pds(dvbpsi_lcn_t *p_lcn, uint32_t i_pds);
+
+/*****************************************************************************
+ * dvbpsi_lcn_set_hd_simulcast
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_lcn_set_hd_simulcast(dvbpsi_lcn_t *p_lcn, bool b_enable)
+ * \brief Use the HD simulcast numbers, as an HD capable receiver should.
+ * \param p_lcn pointer to the engine
+ * \param b_enable true to use them
+ * \return nothing.
+ */
+void dvbpsi_lcn_set_hd_simulcast(dvbpsi_lcn_t *p_lcn, bool b_enable);
+
+/*****************************************************************************
+ * dvbpsi_lcn_set_channel_list
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_lcn_set_channel_list(dvbpsi_lcn_t *p_lcn, int i_channel_list_id)
+ * \brief Select the NorDig version 2 channel list of the receiver region.
+ * \param p_lcn pointer to the engine
+ * \param i_channel_list_id channel_list_id, -1 for the lowest one of each
+ * service
+ * \return nothing.
+ */
+void dvbpsi_lcn_set_channel_list(dvbpsi_lcn_t *p_lcn, int i_channel_list_id);
+
+/*****************************************************************************
+ * dvbpsi_lcn_set_bouquet
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_lcn_set_bouquet(dvbpsi_lcn_t *p_lcn, int i_bouquet_id)
+ * \brief Select the bouquet of the receiver.
+ * \param p_lcn pointer to the engine
+ * \param i_bouquet_id bouquet_id whose numbers beat those of the NIT, the
+ * other BATs being then ignored, -1 to use all BATs after the NIT actual
+ * \return nothing.
+ */
+void dvbpsi_lcn_set_bouquet(dvbpsi_lcn_t *p_lcn, int i_bouquet_id);
+
+/*****************************************************************************
+ * dvbpsi_lcn_update_nit
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_lcn_update_nit(dvbpsi_lcn_t *p_lcn, const dvbpsi_nit_t *p_nit)
+ * \brief Apply a NIT actual or other.
+ * \param p_lcn pointer to the engine
+ * \param p_nit NIT, owned by the caller
+ * \return false on allocation error, in which case the numbers of the
+ * previous version are kept.
+ */
+bool dvbpsi_lcn_update_nit(dvbpsi_lcn_t *p_lcn, const dvbpsi_nit_t *p_nit);
+
+/*****************************************************************************
+ * dvbpsi_lcn_update_bat
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_lcn_update_bat(dvbpsi_lcn_t *p_lcn, const dvbpsi_bat_t *p_bat)
+ * \brief Apply a BAT.
+ * \param p_lcn pointer to the engine
+ * \param p_bat BAT, owned by the caller
+ * \return false on allocation error, in which case the numbers of the
+ * previous version are kept.
+ */
+bool dvbpsi_lcn_update_bat(dvbpsi_lcn_t *p_lcn, const dvbpsi_bat_t *p_bat);
+
+/*****************************************************************************
+ * dvbpsi_lcn_find
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_lcn_service_t *dvbpsi_lcn_find(const dvbpsi_lcn_t *p_lcn,
+                        uint16_t i_onid, uint16_t i_tsid, uint16_t i_service_id)
+ * \brief Get the number of a service.
+ * \param p_lcn pointer to the engine
+ * \param i_onid original_network_id
+ * \param i_tsid transport_stream_id
+ * \param i_service_id service_id
+ * \return the service, NULL if it has no number.
+ */
+const dvbpsi_lcn_service_t *dvbpsi_lcn_find(const dvbpsi_lcn_t *p_lcn, uint16_t i_onid,
+                                            uint16_t i_tsid, uint16_t i_service_id);
+
+/*****************************************************************************
+ * dvbpsi_lcn_lookup
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_lcn_service_t *dvbpsi_lcn_lookup(const dvbpsi_lcn_t *p_lcn,
+                                                    uint16_t i_lcn)
+ * \brief Get the service owning a number.
+ * \param p_lcn pointer to the engine
+ * \param i_lcn logical channel number
+ * \return the best ranked service with that number, NULL if none.
+ */
+const dvbpsi_lcn_service_t *dvbpsi_lcn_lookup(const dvbpsi_lcn_t *p_lcn, uint16_t i_lcn);
+
+/*****************************************************************************
+ * dvbpsi_lcn_list
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_lcn_list(const dvbpsi_lcn_t *p_lcn, uint16_t i_first_lcn,
+                        const dvbpsi_lcn_service_t **pp_services,
+                        unsigned int i_max_services)
+ * \brief Get the channel list sorted by number.
+ * \param p_lcn pointer to the engine
+ * \param i_first_lcn lowest number to return
+ * \param pp_services array receiving the services, in number order then in
+ * rank order
+ * \param i_max_services size of pp_services
+ * \return the number of services stored. The services of a number are not
+ * split: the list stops before a number whose services do not all fit, so
+ * the next page starts at the number following the last one returned.
+ */
+unsigned int dvbpsi_lcn_list(const dvbpsi_lcn_t *p_lcn, uint16_t i_first_lcn,
+                             const dvbpsi_lcn_service_t **pp_services,
+                             unsigned int i_max_services);
+
+/*****************************************************************************
+ * dvbpsi_lcn_count
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_lcn_count(const dvbpsi_lcn_t *p_lcn)
+ * \brief Number of services having a number.
+ * \param p_lcn pointer to the engine
+ * \return the number of services.
+ */
+unsigned int dvbpsi_lcn_count(const dvbpsi_lcn_t *p_lcn);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of lcn.h"
+#endif
@@ -206,7 +206,8 @@ bool dvbpsi_CheckPSISection(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section,
     }
 
     if (!p_section->b_syntax_indicator &&
-        (table_id != 0x70 && table_id != 0x73)) /* TDT/TOT has b_syntax_indicator set to '0' */
+        (table_id != 0x70 && table_id != 0x73 && /* TDT/TOT has b_syntax_indicator set to '0' */
+         table_id != 0xFC))                      /* so has the SCTE 35 SIS */
     {
         /* Invalid section_syntax_indicator */
         dvbpsi_error(p_dvbpsi, psz_table_name,
@@ -230,19 +231,8 @@ bool dvbpsi_CheckPSISection(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section,
  *****************************************************************************/
 bool dvbpsi_ValidPSISection(dvbpsi_psi_section_t* p_section)
 {
-    uint32_t i_crc = 0xffffffff;
-    uint8_t* p_byte = p_section->p_data;
-
-    while(p_byte < p_section->p_payload_end + 4)
-    {
-        i_crc = (i_crc << 8) ^ dvbpsi_crc32_table[(i_crc >> 24) ^ (*p_byte)];
-        p_byte++;
-    }
-
-    if (i_crc == 0)
-        return true;
-    else
-        return false;
+    return dvbpsi_crc32(p_section->p_data,
+                        p_section->p_payload_end + 4 - p_section->p_data) == 0;
 }
 
 /*****************************************************************************
@@ -252,15 +242,8 @@ bool dvbpsi_ValidPSISection(dvbpsi_psi_section_t* p_section)
  *****************************************************************************/
 void dvbpsi_CalculateCRC32(dvbpsi_psi_section_t *p_section)
 {
-    uint8_t* p_byte = p_section->p_data;
-    p_section->i_crc = 0xffffffff;
-
-    while (p_byte < p_section->p_payload_end)
-    {
-        p_section->i_crc =   (p_section->i_crc << 8)
-                           ^ dvbpsi_crc32_table[(p_section->i_crc >> 24) ^ (*p_byte)];
-        p_byte++;
-    }
+    p_section->i_crc = dvbpsi_crc32(p_section->p_data,
+                                    p_section->p_payload_end - p_section->p_data);
 
     p_section->p_payload_end[0] = (p_section->i_crc >> 24) & 0xff;
     p_section->p_payload_end[1] = (p_section->i_crc >> 16) & 0xff;
@@ -268,6 +251,52 @@ void dvbpsi_CalculateCRC32(dvbpsi_psi_section_t *p_section)
     p_section->p_payload_end[3] = p_section->i_crc & 0xff;
 }
 
+/*****************************************************************************
+ * dvbpsi_crc32
+ *****************************************************************************
+ * Calculate the CRC32 of a buffer
+ *****************************************************************************/
+uint32_t dvbpsi_crc32(const uint8_t *p_data, size_t i_length)
+{
+    uint32_t i_crc = 0xffffffff;
+
+    for (size_t i = 0; i < i_length; i++)
+        i_crc = (i_crc << 8) ^ dvbpsi_crc32_table[(i_crc >> 24) ^ p_data[i]];
+
+    return i_crc;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_payload
+ *****************************************************************************
+ * Locate the payload of a raw section
+ *****************************************************************************/
+bool dvbpsi_section_payload(const uint8_t *p_data, size_t i_size,
+                            const uint8_t **pp_start, const uint8_t **pp_end)
+{
+    if (i_size < 3)
+        return false;
+
+    size_t i_length = ((size_t)(p_data[1] & 0x0f) << 8) | p_data[2];
+    if (i_length + 3 > i_size)
+        return false;
+
+    if (p_data[1] & 0x80)
+    {
+        /* table_id_extension to last_section_number, CRC_32 */
+        if (i_length < 5 + 4)
+            return false;
+        *pp_start = p_data + 8;
+        *pp_end = p_data + 3 + i_length - 4;
+    }
+    else
+    {
+        *pp_start = p_data + 3;
+        *pp_end = p_data + 3 + i_length;
+    }
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_BuildPSISection
  *****************************************************************************
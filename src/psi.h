@@ -94,6 +94,12 @@ struct dvbpsi_psi_section_s
   /* list handling */
   struct dvbpsi_psi_section_s *         p_next;         /*!< next element of
                                                              the list */
+
+  /* arrival dates, see dvbpsi_packet_push_date() */
+  int64_t       i_first_date;           /*!< date of the packet carrying
+                                             the first byte */
+  int64_t       i_complete_date;        /*!< date of the packet completing
+                                             the section */
 };
 
 /*****************************************************************************
@@ -174,6 +180,39 @@ void dvbpsi_BuildPSISection(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t* p_section)
  */
 void dvbpsi_CalculateCRC32(dvbpsi_psi_section_t *p_section);
 
+/*****************************************************************************
+ * dvbpsi_crc32
+ *****************************************************************************/
+/*!
+ * \fn uint32_t dvbpsi_crc32(const uint8_t *p_data, size_t i_length)
+ * \brief Calculate the MPEG-2 CRC32 (ISO/IEC 13818-1 annex A) of a buffer.
+ * \param p_data pointer to the data
+ * \param i_length number of bytes in p_data
+ * \return the CRC32, 0 if the buffer ends with a valid CRC32 of the
+ * preceding bytes.
+ */
+uint32_t dvbpsi_crc32(const uint8_t *p_data, size_t i_length);
+
+/*****************************************************************************
+ * dvbpsi_section_payload
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_section_payload(const uint8_t *p_data, size_t i_size,
+                                   const uint8_t **pp_start, const uint8_t **pp_end)
+ * \brief Locate the payload of a raw section, like p_payload_start and
+ * p_payload_end of dvbpsi_psi_section_t.
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data, at least the size of
+ * the section
+ * \param pp_start set to the first byte of the payload
+ * \param pp_end set to the first byte after the payload, the CRC_32 of a
+ * section with the section_syntax_indicator
+ * \return false if the section does not fit in i_size bytes or is too short
+ * for its header. The CRC_32 is not checked, see dvbpsi_crc32().
+ */
+bool dvbpsi_section_payload(const uint8_t *p_data, size_t i_size,
+                            const uint8_t **pp_start, const uint8_t **pp_end);
+
 /*****************************************************************************
  * dvbpsi_has_CRC32
  *****************************************************************************/
@@ -193,7 +232,9 @@ static inline bool dvbpsi_has_CRC32(dvbpsi_psi_section_t *p_section)
         (p_section->i_table_id == (uint8_t) 0x7E))/* DIT (has no CRC 32) */
         return false;
 
-    return (p_section->b_syntax_indicator || (p_section->i_table_id == 0x73));
+    return (p_section->b_syntax_indicator ||
+            (p_section->i_table_id == 0x73) ||   /* TOT */
+            (p_section->i_table_id == 0xFC));    /* SCTE 35 SIS */
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,689 @@
+/*****************************************************************************
+ * psip.c: ATSC PSIP MGT driven table acquisition
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "psi.h"
+#include "descriptor.h"
+#include "demux.h"
+#include "ts.h"
+#include "tables/atsc_mgt.h"
+#include "tables/atsc_vct.h"
+#include "tables/atsc_stt.h"
+#include "tables/atsc_eit.h"
+#include "tables/atsc_ett.h"
+#include "psip.h"
+
+#define PSIP_PID_COUNT      8192
+
+/*****************************************************************************
+ * psip_table_t
+ *****************************************************************************
+ * EIT-k or ETT-k announced in the MGT. Tables sharing a PID are chained on
+ * that PID.
+ *****************************************************************************/
+typedef struct psip_table_s
+{
+    dvbpsi_psip_t          *p_psip;         /* engine owning the table */
+    uint16_t                i_type;         /* MGT table_type */
+    uint16_t                i_pid;          /* MGT table_type_PID */
+    uint8_t                 i_version;      /* MGT table_type_version */
+    bool                    b_priority;     /* acquired first */
+    bool                    b_seen;         /* still in the MGT */
+
+    dvbpsi_t               *p_dvbpsi;       /* NULL while deferred */
+
+    /* source_id of the EITs received, priority tables only */
+    uint16_t               *pi_sources;
+    unsigned int            i_sources;
+    unsigned int            i_sources_max;
+
+    struct psip_table_s    *p_next;
+    struct psip_table_s    *p_next_pid;
+} psip_table_t;
+
+/*****************************************************************************
+ * dvbpsi_psip_s
+ *****************************************************************************/
+struct dvbpsi_psip_s
+{
+    dvbpsi_psip_config_t    config;
+    dvbpsi_psip_callback    pf_callback;
+    void                   *p_cb_data;
+    dvbpsi_message_cb       pf_message;
+    enum dvbpsi_msg_level   i_msg_level;
+
+    int64_t                 i_date;         /* date of the current packet */
+
+    dvbpsi_t               *p_base;         /* PSIP base PID decoder */
+
+    bool                    b_mgt;          /* an MGT has been received */
+    int64_t                 i_mgt_date;     /* date of the first MGT */
+
+    /* source_id of the channels of the last VCT */
+    uint16_t               *pi_sources;
+    unsigned int            i_sources;
+    bool                    b_vct;
+
+    bool                    b_priority_complete;
+
+    psip_table_t           *p_first_table;
+    psip_table_t           *pp_pids[PSIP_PID_COUNT];
+};
+
+/*****************************************************************************
+ * Local prototypes
+ *****************************************************************************/
+static void psip_CheckPriority(dvbpsi_psip_t *p_psip);
+
+/*****************************************************************************
+ * psip_Deliver
+ *****************************************************************************
+ * Hand a decoded table over to the application, or drop it.
+ *****************************************************************************/
+static void psip_Deliver(dvbpsi_psip_t *p_psip, dvbpsi_psip_table_t *p_table)
+{
+    p_table->i_date = p_psip->i_date;
+    if (p_psip->pf_callback)
+    {
+        p_psip->pf_callback(p_psip->p_cb_data, p_psip, p_table);
+        return;
+    }
+
+    if (p_table->p_mgt)
+        dvbpsi_atsc_DeleteMGT(p_table->p_mgt);
+    if (p_table->p_vct)
+        dvbpsi_atsc_DeleteVCT(p_table->p_vct);
+    if (p_table->p_stt)
+        dvbpsi_atsc_DeleteSTT(p_table->p_stt);
+    if (p_table->p_eit)
+        dvbpsi_atsc_DeleteEIT(p_table->p_eit);
+    if (p_table->p_ett)
+        dvbpsi_atsc_DeleteETT(p_table->p_ett);
+}
+
+/*****************************************************************************
+ * psip_Wanted
+ *****************************************************************************
+ * Tell if a table_type announced in the MGT has to be acquired.
+ *****************************************************************************/
+static bool psip_Wanted(const dvbpsi_psip_config_t *p_cfg, uint16_t i_type)
+{
+    if (i_type >= DVBPSI_PSIP_EIT && i_type < DVBPSI_PSIP_EIT + DVBPSI_PSIP_MAX_K)
+        return (unsigned int)(i_type - DVBPSI_PSIP_EIT) < p_cfg->i_eit_count;
+    if (i_type >= DVBPSI_PSIP_ETT && i_type < DVBPSI_PSIP_ETT + DVBPSI_PSIP_MAX_K)
+        return (unsigned int)(i_type - DVBPSI_PSIP_ETT) < p_cfg->i_ett_count;
+    return false;
+}
+
+/*****************************************************************************
+ * psip_EITCallback / psip_ETTCallback
+ *****************************************************************************
+ * Tables of the PIDs announced in the MGT.
+ *****************************************************************************/
+static void psip_EITCallback(void *p_cb_data, dvbpsi_atsc_eit_t *p_eit)
+{
+    psip_table_t *p_table = (psip_table_t *)p_cb_data;
+    dvbpsi_psip_t *p_psip = p_table->p_psip;
+
+    bool b_new_source = false;
+    if (p_table->b_priority && !p_psip->b_priority_complete)
+    {
+        unsigned int i;
+        for (i = 0; i < p_table->i_sources; i++)
+            if (p_table->pi_sources[i] == p_eit->i_source_id)
+                break;
+        if (i == p_table->i_sources)
+        {
+            if (p_table->i_sources == p_table->i_sources_max)
+            {
+                unsigned int i_max = p_table->i_sources_max ? 2 * p_table->i_sources_max : 16;
+                uint16_t *pi = (uint16_t *)realloc(p_table->pi_sources, i_max * sizeof(uint16_t));
+                if (pi)
+                {
+                    p_table->pi_sources = pi;
+                    p_table->i_sources_max = i_max;
+                }
+            }
+            if (p_table->i_sources < p_table->i_sources_max)
+            {
+                p_table->pi_sources[p_table->i_sources++] = p_eit->i_source_id;
+                b_new_source = true;
+            }
+        }
+    }
+
+    dvbpsi_psip_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.i_event = DVBPSI_PSIP_EIT_TABLE;
+    table.i_table_type = p_table->i_type;
+    table.i_pid = p_table->i_pid;
+    table.p_eit = p_eit;
+    psip_Deliver(p_psip, &table);
+
+    if (b_new_source)
+        psip_CheckPriority(p_psip);
+}
+
+static void psip_ETTCallback(void *p_cb_data, dvbpsi_atsc_ett_t *p_ett)
+{
+    psip_table_t *p_table = (psip_table_t *)p_cb_data;
+
+    dvbpsi_psip_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.i_event = DVBPSI_PSIP_ETT_TABLE;
+    table.i_table_type = p_table->i_type;
+    table.i_pid = p_table->i_pid;
+    table.p_ett = p_ett;
+    psip_Deliver(p_table->p_psip, &table);
+}
+
+/*****************************************************************************
+ * Demux helpers
+ *****************************************************************************
+ * The demux API is deprecated for applications, the library still builds
+ * its subtable decoders on it.
+ *****************************************************************************/
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+static dvbpsi_t *psip_AttachDemux(dvbpsi_psip_t *p_psip, dvbpsi_demux_new_cb_t pf_new,
+                                  void *p_cb_data)
+{
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(p_psip->pf_message, p_psip->i_msg_level);
+    if (p_dvbpsi == NULL)
+        return NULL;
+
+    if (!dvbpsi_AttachDemux(p_dvbpsi, pf_new, p_cb_data))
+    {
+        dvbpsi_delete(p_dvbpsi);
+        return NULL;
+    }
+    return p_dvbpsi;
+}
+
+static void psip_DetachDemux(dvbpsi_t *p_dvbpsi)
+{
+    if (p_dvbpsi == NULL)
+        return;
+
+    dvbpsi_DetachDemux(p_dvbpsi);
+    dvbpsi_delete(p_dvbpsi);
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/*****************************************************************************
+ * psip_NewTableSubtable
+ *****************************************************************************
+ * Demux callback of the PIDs announced in the MGT.
+ *****************************************************************************/
+static void psip_NewTableSubtable(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                  uint16_t i_extension, void *p_cb_data)
+{
+    psip_table_t *p_table = (psip_table_t *)p_cb_data;
+    bool b_ok = true;
+
+    if (i_table_id == 0xcb && p_table->i_type < DVBPSI_PSIP_ETT)
+        b_ok = dvbpsi_atsc_AttachEIT(p_dvbpsi, i_table_id, i_extension,
+                                     psip_EITCallback, p_table);
+    else if (i_table_id == 0xcc && p_table->i_type >= DVBPSI_PSIP_ETT)
+        b_ok = dvbpsi_atsc_AttachETT(p_dvbpsi, i_table_id, i_extension,
+                                     psip_ETTCallback, p_table);
+
+    if (!b_ok)
+        dvbpsi_error(p_dvbpsi, "PSIP", "unable to attach decoder for table 0x%x on PID %d",
+                     i_table_id, p_table->i_pid);
+}
+
+/*****************************************************************************
+ * psip_AttachTable / psip_DetachTable
+ *****************************************************************************
+ * Start or stop the acquisition of an EIT-k or ETT-k.
+ *****************************************************************************/
+static bool psip_AttachTable(dvbpsi_psip_t *p_psip, psip_table_t *p_table)
+{
+    if (p_table->p_dvbpsi)
+        return true;
+
+    dvbpsi_t *p_dvbpsi = psip_AttachDemux(p_psip, psip_NewTableSubtable, p_table);
+    if (p_dvbpsi == NULL)
+        return false;
+
+    p_table->p_dvbpsi = p_dvbpsi;
+    p_table->p_next_pid = p_psip->pp_pids[p_table->i_pid];
+    p_psip->pp_pids[p_table->i_pid] = p_table;
+    return true;
+}
+
+static void psip_DetachTable(dvbpsi_psip_t *p_psip, psip_table_t *p_table)
+{
+    if (p_table->p_dvbpsi == NULL)
+        return;
+
+    psip_table_t **pp = &p_psip->pp_pids[p_table->i_pid];
+    while (*pp && *pp != p_table)
+        pp = &(*pp)->p_next_pid;
+    if (*pp)
+        *pp = p_table->p_next_pid;
+    p_table->p_next_pid = NULL;
+
+    psip_DetachDemux(p_table->p_dvbpsi);
+    p_table->p_dvbpsi = NULL;
+    p_table->i_sources = 0;
+}
+
+/*****************************************************************************
+ * psip_CheckPriority
+ *****************************************************************************
+ * The priority EITs are complete once every channel of the VCT has been
+ * received on each of them, or when the timeout expires. The other tables
+ * are attached then.
+ *****************************************************************************/
+static void psip_CheckPriority(dvbpsi_psip_t *p_psip)
+{
+    if (p_psip->b_priority_complete || !p_psip->b_mgt)
+        return;
+
+    bool b_priority = false;
+    for (psip_table_t *p_table = p_psip->p_first_table; p_table; p_table = p_table->p_next)
+        b_priority |= p_table->b_priority;
+
+    bool b_complete = !b_priority ||
+                      (p_psip->config.i_priority_timeout > 0 &&
+                       p_psip->i_date - p_psip->i_mgt_date >= p_psip->config.i_priority_timeout);
+    if (!b_complete && p_psip->b_vct)
+    {
+        b_complete = true;
+        for (psip_table_t *p_table = p_psip->p_first_table;
+             p_table && b_complete; p_table = p_table->p_next)
+        {
+            if (!p_table->b_priority)
+                continue;
+            for (unsigned int i = 0; i < p_psip->i_sources && b_complete; i++)
+            {
+                unsigned int j;
+                for (j = 0; j < p_table->i_sources; j++)
+                    if (p_table->pi_sources[j] == p_psip->pi_sources[i])
+                        break;
+                b_complete = (j < p_table->i_sources);
+            }
+        }
+    }
+    if (!b_complete)
+        return;
+
+    p_psip->b_priority_complete = true;
+    for (psip_table_t *p_table = p_psip->p_first_table; p_table; p_table = p_table->p_next)
+    {
+        free(p_table->pi_sources);
+        p_table->pi_sources = NULL;
+        p_table->i_sources = p_table->i_sources_max = 0;
+        if (!psip_AttachTable(p_psip, p_table))
+            dvbpsi_error(p_psip->p_base, "PSIP", "unable to decode table type 0x%x on PID %d",
+                         p_table->i_type, p_table->i_pid);
+    }
+
+    dvbpsi_psip_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.i_event = DVBPSI_PSIP_PRIORITY_COMPLETE;
+    psip_Deliver(p_psip, &table);
+}
+
+/*****************************************************************************
+ * psip_MGTCallback
+ *****************************************************************************
+ * Follow the tables announced in a new MGT.
+ *****************************************************************************/
+static void psip_MGTCallback(void *p_cb_data, dvbpsi_atsc_mgt_t *p_mgt)
+{
+    dvbpsi_psip_t *p_psip = (dvbpsi_psip_t *)p_cb_data;
+
+    if (!p_mgt->b_current_next)
+    {
+        dvbpsi_atsc_DeleteMGT(p_mgt);
+        return;
+    }
+
+    if (!p_psip->b_mgt)
+    {
+        p_psip->b_mgt = true;
+        p_psip->i_mgt_date = p_psip->i_date;
+    }
+
+    for (psip_table_t *p_table = p_psip->p_first_table; p_table; p_table = p_table->p_next)
+        p_table->b_seen = false;
+
+    for (dvbpsi_atsc_mgt_table_t *p_entry = p_mgt->p_first_table;
+         p_entry; p_entry = p_entry->p_next)
+    {
+        if (!psip_Wanted(&p_psip->config, p_entry->i_table_type) ||
+            p_entry->i_table_type_pid >= PSIP_PID_COUNT ||
+            p_entry->i_table_type_pid == DVBPSI_PSIP_BASE_PID)
+            continue;
+
+        psip_table_t *p_table = p_psip->p_first_table;
+        while (p_table && p_table->i_type != p_entry->i_table_type)
+            p_table = p_table->p_next;
+
+        if (p_table == NULL)
+        {
+            p_table = (psip_table_t *)calloc(1, sizeof(psip_table_t));
+            if (p_table == NULL)
+                continue;
+            p_table->p_psip = p_psip;
+            p_table->i_type = p_entry->i_table_type;
+            p_table->b_priority = p_entry->i_table_type < DVBPSI_PSIP_EIT +
+                                  p_psip->config.i_priority_eit;
+            p_table->p_next = p_psip->p_first_table;
+            p_psip->p_first_table = p_table;
+        }
+        else if (p_table->b_seen)
+            continue;   /* duplicate entry */
+        else if (p_table->i_pid == p_entry->i_table_type_pid &&
+                 p_table->i_version == p_entry->i_table_type_version)
+        {
+            /* Unchanged, keep acquiring it */
+            p_table->b_seen = true;
+            continue;
+        }
+        else
+            psip_DetachTable(p_psip, p_table);
+
+        p_table->i_pid = p_entry->i_table_type_pid;
+        p_table->i_version = p_entry->i_table_type_version;
+        p_table->b_seen = true;
+
+        if ((p_table->b_priority || p_psip->b_priority_complete) &&
+            !psip_AttachTable(p_psip, p_table))
+            dvbpsi_error(p_psip->p_base, "PSIP", "unable to decode table type 0x%x on PID %d",
+                         p_table->i_type, p_table->i_pid);
+    }
+
+    /* Tables no longer announced */
+    psip_table_t **pp = &p_psip->p_first_table;
+    while (*pp)
+    {
+        psip_table_t *p_table = *pp;
+        if (p_table->b_seen)
+        {
+            pp = &p_table->p_next;
+            continue;
+        }
+        *pp = p_table->p_next;
+        psip_DetachTable(p_psip, p_table);
+        free(p_table->pi_sources);
+        free(p_table);
+    }
+
+    dvbpsi_psip_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.i_event = DVBPSI_PSIP_MGT_TABLE;
+    table.i_pid = DVBPSI_PSIP_BASE_PID;
+    table.p_mgt = p_mgt;
+    psip_Deliver(p_psip, &table);
+
+    psip_CheckPriority(p_psip);
+}
+
+/*****************************************************************************
+ * psip_VCTCallback
+ *****************************************************************************
+ * Remember the channels whose EITs are expected.
+ *****************************************************************************/
+static void psip_VCTCallback(void *p_cb_data, dvbpsi_atsc_vct_t *p_vct)
+{
+    dvbpsi_psip_t *p_psip = (dvbpsi_psip_t *)p_cb_data;
+
+    if (p_vct->b_current_next)
+    {
+        unsigned int i_count = 0;
+        for (dvbpsi_atsc_vct_channel_t *p = p_vct->p_first_channel; p; p = p->p_next)
+            i_count++;
+
+        uint16_t *pi_sources = NULL;
+        if (i_count)
+            pi_sources = (uint16_t *)malloc(i_count * sizeof(uint16_t));
+        if (pi_sources || i_count == 0)
+        {
+            unsigned int i_sources = 0;
+            for (dvbpsi_atsc_vct_channel_t *p = p_vct->p_first_channel; p; p = p->p_next)
+            {
+                /* Hidden channels have no guide */
+                if (!p->b_hidden)
+                    pi_sources[i_sources++] = p->i_source_id;
+            }
+            free(p_psip->pi_sources);
+            p_psip->pi_sources = pi_sources;
+            p_psip->i_sources = i_sources;
+            p_psip->b_vct = true;
+        }
+    }
+
+    dvbpsi_psip_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.i_event = DVBPSI_PSIP_VCT_TABLE;
+    table.i_pid = DVBPSI_PSIP_BASE_PID;
+    table.p_vct = p_vct;
+    psip_Deliver(p_psip, &table);
+
+    psip_CheckPriority(p_psip);
+}
+
+/*****************************************************************************
+ * psip_STTCallback / psip_ChannelETTCallback
+ *****************************************************************************/
+static void psip_STTCallback(void *p_cb_data, dvbpsi_atsc_stt_t *p_stt)
+{
+    dvbpsi_psip_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.i_event = DVBPSI_PSIP_STT_TABLE;
+    table.i_pid = DVBPSI_PSIP_BASE_PID;
+    table.p_stt = p_stt;
+    psip_Deliver((dvbpsi_psip_t *)p_cb_data, &table);
+}
+
+static void psip_ChannelETTCallback(void *p_cb_data, dvbpsi_atsc_ett_t *p_ett)
+{
+    dvbpsi_psip_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.i_event = DVBPSI_PSIP_ETT_TABLE;
+    table.i_table_type = DVBPSI_PSIP_CHANNEL_ETT;
+    table.i_pid = DVBPSI_PSIP_BASE_PID;
+    table.p_ett = p_ett;
+    psip_Deliver((dvbpsi_psip_t *)p_cb_data, &table);
+}
+
+/*****************************************************************************
+ * psip_NewBaseSubtable
+ *****************************************************************************
+ * Demux callback of the PSIP base PID.
+ *****************************************************************************/
+static void psip_NewBaseSubtable(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                 uint16_t i_extension, void *p_cb_data)
+{
+    dvbpsi_psip_t *p_psip = (dvbpsi_psip_t *)p_cb_data;
+    bool b_ok = true;
+
+    switch (i_table_id)
+    {
+        case 0xc7: /* MGT */
+            b_ok = dvbpsi_atsc_AttachMGT(p_dvbpsi, i_table_id, i_extension,
+                                         psip_MGTCallback, p_psip);
+            break;
+        case 0xc8: /* TVCT */
+        case 0xc9: /* CVCT */
+            b_ok = dvbpsi_atsc_AttachVCT(p_dvbpsi, i_table_id, i_extension,
+                                         psip_VCTCallback, p_psip);
+            break;
+        case 0xcc: /* channel ETT */
+            if (p_psip->config.b_channel_ett)
+                b_ok = dvbpsi_atsc_AttachETT(p_dvbpsi, i_table_id, i_extension,
+                                             psip_ChannelETTCallback, p_psip);
+            break;
+        case 0xcd: /* STT */
+            b_ok = dvbpsi_atsc_AttachSTT(p_dvbpsi, i_table_id, i_extension,
+                                         psip_STTCallback, p_psip);
+            break;
+        default:
+            break;
+    }
+
+    if (!b_ok)
+        dvbpsi_error(p_dvbpsi, "PSIP", "unable to attach decoder for table 0x%x", i_table_id);
+}
+
+/*****************************************************************************
+ * dvbpsi_psip_config_default
+ *****************************************************************************/
+void dvbpsi_psip_config_default(dvbpsi_psip_config_t *p_config)
+{
+    assert(p_config);
+
+    p_config->i_eit_count = DVBPSI_PSIP_MAX_K;
+    p_config->i_ett_count = DVBPSI_PSIP_MAX_K;
+    p_config->b_channel_ett = true;
+    p_config->i_priority_eit = 4;
+    p_config->i_priority_timeout = 5000000;
+}
+
+/*****************************************************************************
+ * dvbpsi_psip_new
+ *****************************************************************************/
+dvbpsi_psip_t *dvbpsi_psip_new(const dvbpsi_psip_config_t *p_config,
+                               dvbpsi_psip_callback pf_callback, void *p_cb_data,
+                               dvbpsi_message_cb pf_message, enum dvbpsi_msg_level level)
+{
+    dvbpsi_psip_t *p_psip = (dvbpsi_psip_t *)calloc(1, sizeof(dvbpsi_psip_t));
+    if (p_psip == NULL)
+        return NULL;
+
+    if (p_config)
+        p_psip->config = *p_config;
+    else
+        dvbpsi_psip_config_default(&p_psip->config);
+
+    p_psip->pf_callback = pf_callback;
+    p_psip->p_cb_data = p_cb_data;
+    p_psip->pf_message = pf_message;
+    p_psip->i_msg_level = level;
+
+    p_psip->p_base = psip_AttachDemux(p_psip, psip_NewBaseSubtable, p_psip);
+    if (p_psip->p_base == NULL)
+        goto error;
+
+    return p_psip;
+
+error:
+    dvbpsi_psip_delete(p_psip);
+    return NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_psip_delete
+ *****************************************************************************/
+void dvbpsi_psip_delete(dvbpsi_psip_t *p_psip)
+{
+    if (p_psip == NULL)
+        return;
+
+    psip_table_t *p_table = p_psip->p_first_table;
+    while (p_table)
+    {
+        psip_table_t *p_next = p_table->p_next;
+        psip_DetachTable(p_psip, p_table);
+        free(p_table->pi_sources);
+        free(p_table);
+        p_table = p_next;
+    }
+
+    psip_DetachDemux(p_psip->p_base);
+    free(p_psip->pi_sources);
+    free(p_psip);
+}
+
+/*****************************************************************************
+ * dvbpsi_psip_packet_push
+ *****************************************************************************/
+void dvbpsi_psip_packet_push(dvbpsi_psip_t *p_psip, const uint8_t *p_data, int64_t i_date)
+{
+    assert(p_psip);
+    assert(p_data);
+
+    const uint16_t i_pid = dvbpsi_ts_pid(p_data);
+    p_psip->i_date = i_date;
+
+    /* Deferred tables are attached before this packet is routed */
+    if (!p_psip->b_priority_complete && p_psip->b_mgt &&
+        p_psip->config.i_priority_timeout > 0 &&
+        i_date - p_psip->i_mgt_date >= p_psip->config.i_priority_timeout)
+        psip_CheckPriority(p_psip);
+
+    if (i_pid == DVBPSI_PSIP_BASE_PID)
+        dvbpsi_packet_push_date(p_psip->p_base, p_data, i_date);
+
+    for (psip_table_t *p_table = p_psip->pp_pids[i_pid]; p_table; p_table = p_table->p_next_pid)
+        dvbpsi_packet_push_date(p_table->p_dvbpsi, p_data, i_date);
+}
+
+/*****************************************************************************
+ * dvbpsi_psip_packets_push
+ *****************************************************************************/
+void dvbpsi_psip_packets_push(dvbpsi_psip_t *p_psip, const uint8_t *p_data,
+                              size_t i_packets, int64_t i_date)
+{
+    assert(p_psip);
+    assert(p_data);
+
+    for (size_t i = 0; i < i_packets; i++)
+    {
+        dvbpsi_psip_packet_push(p_psip, p_data, i_date);
+        p_data += DVBPSI_TS_PACKET_SIZE;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_psip_priority_complete
+ *****************************************************************************/
+bool dvbpsi_psip_priority_complete(const dvbpsi_psip_t *p_psip)
+{
+    assert(p_psip);
+    return p_psip->b_priority_complete;
+}
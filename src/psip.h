@@ -0,0 +1,250 @@
+/*****************************************************************************
+ * psip.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <psip.h>
+ * \brief Application interface for the ATSC PSIP acquisition engine.
+ *
+ * The PSIP acquisition engine decodes the MGT, VCT, STT and channel ETT on
+ * the PSIP base PID and follows the MGT to decode the EIT-k and ETT-k tables
+ * on the PIDs it announces. Decoders are attached when a table appears in
+ * the MGT, detached when it disappears and restarted when its
+ * table_type_version changes; tables whose version did not change are left
+ * untouched. EIT-0 to EIT-3 (the next 12 hours of the guide) are acquired
+ * first, the other tables are attached once they are complete.
+ * (ATSC document A/65, section 6.2.)
+ *
+ * dvbpsi.h, descriptor.h and the tables/atsc_*.h headers must be included
+ * before this file. All dates are expressed in microseconds.
+ */
+
+#ifndef _DVBPSI_PSIP_H_
+#define _DVBPSI_PSIP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! PSIP base PID */
+#define DVBPSI_PSIP_BASE_PID        0x1ffb
+
+/*! MGT table_type of the channel ETT */
+#define DVBPSI_PSIP_CHANNEL_ETT     0x0004
+/*! MGT table_type of EIT-0, EIT-k is DVBPSI_PSIP_EIT + k */
+#define DVBPSI_PSIP_EIT             0x0100
+/*! MGT table_type of ETT-0, ETT-k is DVBPSI_PSIP_ETT + k */
+#define DVBPSI_PSIP_ETT             0x0200
+/*! Number of EIT-k and ETT-k table types */
+#define DVBPSI_PSIP_MAX_K           128
+
+/*****************************************************************************
+ * dvbpsi_psip_config_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_psip_config_s
+ * \brief Acquisition settings.
+ */
+/*!
+ * \typedef struct dvbpsi_psip_config_s dvbpsi_psip_config_t
+ * \brief dvbpsi_psip_config_t type definition.
+ */
+typedef struct dvbpsi_psip_config_s
+{
+    unsigned int    i_eit_count;        /*!< EIT-0 to EIT-(i_eit_count-1) are
+                                             acquired, default 128 */
+    unsigned int    i_ett_count;        /*!< ETT-0 to ETT-(i_ett_count-1) are
+                                             acquired, default 128 */
+    bool            b_channel_ett;      /*!< acquire the channel ETT, default
+                                             true */
+    unsigned int    i_priority_eit;     /*!< EIT-0 to EIT-(i_priority_eit-1)
+                                             are acquired first, default 4 */
+    int64_t         i_priority_timeout; /*!< the other tables are attached at
+                                             the latest this long after the
+                                             first MGT, default 5 s */
+} dvbpsi_psip_config_t;
+
+/*****************************************************************************
+ * dvbpsi_psip_event_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_psip_event_e
+ * \brief Kind of a PSIP acquisition callback.
+ */
+/*!
+ * \typedef enum dvbpsi_psip_event_e dvbpsi_psip_event_t
+ * \brief dvbpsi_psip_event_t type definition.
+ */
+typedef enum dvbpsi_psip_event_e
+{
+    DVBPSI_PSIP_MGT_TABLE = 0,      /*!< p_mgt is set */
+    DVBPSI_PSIP_VCT_TABLE,          /*!< p_vct is set */
+    DVBPSI_PSIP_STT_TABLE,          /*!< p_stt is set */
+    DVBPSI_PSIP_EIT_TABLE,          /*!< p_eit is set */
+    DVBPSI_PSIP_ETT_TABLE,          /*!< p_ett is set */
+    DVBPSI_PSIP_PRIORITY_COMPLETE,  /*!< the priority EITs of all channels are
+                                         known or their timeout expired, no
+                                         table is set */
+} dvbpsi_psip_event_t;
+
+/*****************************************************************************
+ * dvbpsi_psip_table_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_psip_table_s
+ * \brief Table delivered by the engine.
+ *
+ * The table belongs to the callback, which must delete it with the
+ * matching dvbpsi_atsc_Delete*() function.
+ */
+/*!
+ * \typedef struct dvbpsi_psip_table_s dvbpsi_psip_table_t
+ * \brief dvbpsi_psip_table_t type definition.
+ */
+typedef struct dvbpsi_psip_table_s
+{
+    dvbpsi_psip_event_t     i_event;        /*!< kind of table */
+    uint16_t                i_table_type;   /*!< MGT table_type of EIT-k and
+                                                 ETT-k, 0 otherwise */
+    uint16_t                i_pid;          /*!< PID of the table */
+    int64_t                 i_date;         /*!< date of the packet completing
+                                                 the table */
+
+    dvbpsi_atsc_mgt_t      *p_mgt;          /*!< MGT */
+    dvbpsi_atsc_vct_t      *p_vct;          /*!< TVCT or CVCT */
+    dvbpsi_atsc_stt_t      *p_stt;          /*!< STT */
+    dvbpsi_atsc_eit_t      *p_eit;          /*!< EIT-k */
+    dvbpsi_atsc_ett_t      *p_ett;          /*!< channel ETT or ETT-k */
+} dvbpsi_psip_table_t;
+
+/*****************************************************************************
+ * dvbpsi_psip_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_psip_s dvbpsi_psip_t
+ * \brief Opaque PSIP acquisition engine handle.
+ */
+typedef struct dvbpsi_psip_s dvbpsi_psip_t;
+
+/*****************************************************************************
+ * dvbpsi_psip_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_psip_callback)(void *p_cb_data, dvbpsi_psip_t *p_psip,
+                                          const dvbpsi_psip_table_t *p_table)
+ * \brief Callback type definition. The callback must not delete the engine.
+ */
+typedef void (* dvbpsi_psip_callback)(void *p_cb_data, dvbpsi_psip_t *p_psip,
+                                      const dvbpsi_psip_table_t *p_table);
+
+/*****************************************************************************
+ * dvbpsi_psip_config_default
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_psip_config_default(dvbpsi_psip_config_t *p_config)
+ * \brief Fill a configuration with the default settings.
+ * \param p_config pointer to the configuration
+ * \return nothing.
+ */
+void dvbpsi_psip_config_default(dvbpsi_psip_config_t *p_config);
+
+/*****************************************************************************
+ * dvbpsi_psip_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_psip_t *dvbpsi_psip_new(const dvbpsi_psip_config_t *p_config,
+                        dvbpsi_psip_callback pf_callback, void *p_cb_data,
+                        dvbpsi_message_cb pf_message, enum dvbpsi_msg_level level)
+ * \brief Create a PSIP acquisition engine.
+ * \param p_config settings, NULL for the default ones
+ * \param pf_callback function to call back for each table, NULL to drop
+ * the tables
+ * \param p_cb_data private data given in argument to the callback
+ * \param pf_message message callback handler for the decoders, may be NULL
+ * \param level enum dvbpsi_msg_level for filtering logging messages
+ * \return pointer to the engine, NULL on error.
+ */
+dvbpsi_psip_t *dvbpsi_psip_new(const dvbpsi_psip_config_t *p_config,
+                               dvbpsi_psip_callback pf_callback, void *p_cb_data,
+                               dvbpsi_message_cb pf_message, enum dvbpsi_msg_level level);
+
+/*****************************************************************************
+ * dvbpsi_psip_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_psip_delete(dvbpsi_psip_t *p_psip)
+ * \brief Destroy a PSIP acquisition engine and all its decoders.
+ * \param p_psip pointer to the engine
+ * \return nothing.
+ */
+void dvbpsi_psip_delete(dvbpsi_psip_t *p_psip);
+
+/*****************************************************************************
+ * dvbpsi_psip_packet_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_psip_packet_push(dvbpsi_psip_t *p_psip, const uint8_t *p_data,
+                                    int64_t i_date)
+ * \brief Inject one TS packet into the engine.
+ * \param p_psip pointer to the engine
+ * \param p_data pointer to a 188 bytes TS packet
+ * \param i_date arrival date of the packet, 0 if unknown
+ * \return nothing.
+ *
+ * Packets of PIDs without a decoder are dropped after a single table
+ * lookup, so the whole transport stream can be pushed.
+ */
+void dvbpsi_psip_packet_push(dvbpsi_psip_t *p_psip, const uint8_t *p_data, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_psip_packets_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_psip_packets_push(dvbpsi_psip_t *p_psip, const uint8_t *p_data,
+                                     size_t i_packets, int64_t i_date)
+ * \brief Inject a buffer of TS packets received at the same time.
+ * \param p_psip pointer to the engine
+ * \param p_data pointer to i_packets * 188 bytes of TS packets
+ * \param i_packets number of TS packets in p_data
+ * \param i_date arrival date of the buffer, 0 if unknown
+ * \return nothing.
+ */
+void dvbpsi_psip_packets_push(dvbpsi_psip_t *p_psip, const uint8_t *p_data,
+                              size_t i_packets, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_psip_priority_complete
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_psip_priority_complete(const dvbpsi_psip_t *p_psip)
+ * \brief Tell if the priority EITs have been acquired.
+ * \param p_psip pointer to the engine
+ * \return true once DVBPSI_PSIP_PRIORITY_COMPLETE has been reported, all
+ * announced tables are acquired from then on.
+ */
+bool dvbpsi_psip_priority_complete(const dvbpsi_psip_t *p_psip);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of psip.h"
+#endif
@@ -0,0 +1,1094 @@
+/*****************************************************************************
+ * servicedb.c: service database joining the PSI/SI and VCT tables
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "descriptor.h"
+#include "tables/pat.h"
+#include "tables/pmt.h"
+#include "tables/sdt.h"
+#include "tables/nit.h"
+#include "tables/bat.h"
+#include "tables/atsc_vct.h"
+#include "servicedb.h"
+
+#define SERVICEDB_INDEX_KEY         0   /* (onid, tsid, service_id) */
+#define SERVICEDB_INDEX_CHANNEL     1   /* (major, minor) */
+#define SERVICEDB_INDEX_LCN         2   /* logical channel number */
+#define SERVICEDB_INDEX_COUNT       3
+
+#define SERVICEDB_MIN_BUCKETS       64
+#define SERVICEDB_TRANSPORT_BUCKETS 256
+
+struct servicedb_transport_s;
+
+/*****************************************************************************
+ * servicedb_entry_t
+ *****************************************************************************
+ * Per service state. An entry is chained in each index it belongs to and in
+ * the list of services of its transport stream.
+ *****************************************************************************/
+typedef struct servicedb_entry_s
+{
+    dvbpsi_servicedb_service_t      service;        /* must be first */
+
+    dvbpsi_servicedb_es_t          *p_es;           /* owned copy of service.p_es */
+    uint16_t                       *pi_bouquets;    /* owned copy of
+                                                       service.pi_bouquet_ids */
+    struct servicedb_transport_s   *p_ts;           /* transport stream */
+
+    uint16_t                        i_nit_network_id; /* NIT listing the service */
+    uint16_t                        i_vct_tsid;     /* VCT listing the service */
+    uint32_t                        i_seen;         /* generation of the last
+                                                       table listing it */
+
+    bool                            b_indexed[SERVICEDB_INDEX_COUNT];
+    struct servicedb_entry_s       *p_next[SERVICEDB_INDEX_COUNT];
+    struct servicedb_entry_s       *p_next_ts;      /* next service of the TS */
+
+    /* Pending notification */
+    bool                            b_touched;
+    bool                            b_new;
+    bool                            b_changed;
+    struct servicedb_entry_s       *p_next_touched;
+} servicedb_entry_t;
+
+/*****************************************************************************
+ * servicedb_transport_t
+ *****************************************************************************/
+typedef struct servicedb_transport_s
+{
+    dvbpsi_servicedb_transport_t    transport;      /* must be first */
+
+    uint32_t                        i_seen;         /* generation of the last
+                                                       NIT listing it */
+    servicedb_entry_t              *p_first_service;
+    struct servicedb_transport_s   *p_next;         /* hash chain */
+} servicedb_transport_t;
+
+/*****************************************************************************
+ * servicedb_index_t
+ *****************************************************************************/
+typedef struct servicedb_index_s
+{
+    servicedb_entry_t             **pp_buckets;
+    unsigned int                    i_buckets;      /* power of 2 */
+    unsigned int                    i_count;
+} servicedb_index_t;
+
+/*****************************************************************************
+ * dvbpsi_servicedb_s
+ *****************************************************************************/
+struct dvbpsi_servicedb_s
+{
+    dvbpsi_servicedb_callback       pf_callback;
+    void                           *p_cb_data;
+
+    servicedb_index_t               index[SERVICEDB_INDEX_COUNT];
+    servicedb_transport_t          *pp_transports[SERVICEDB_TRANSPORT_BUCKETS];
+
+    uint32_t                        i_generation;   /* incremented by updates */
+    servicedb_entry_t              *p_touched;      /* pending notifications */
+};
+
+/*****************************************************************************
+ * servicedb_Hash
+ *****************************************************************************/
+static inline unsigned int servicedb_Hash(uint64_t i_key, unsigned int i_buckets)
+{
+    return (unsigned int)((i_key * UINT64_C(0x9e3779b97f4a7c15)) >> 32) & (i_buckets - 1);
+}
+
+/*****************************************************************************
+ * servicedb_Key
+ *****************************************************************************/
+static uint64_t servicedb_Key(const servicedb_entry_t *p_entry, int i_index)
+{
+    const dvbpsi_servicedb_service_t *p_service = &p_entry->service;
+
+    switch (i_index)
+    {
+        case SERVICEDB_INDEX_KEY:
+            return ((uint64_t)p_service->i_onid << 32)
+                 | ((uint64_t)p_service->i_tsid << 16) | p_service->i_service_id;
+        case SERVICEDB_INDEX_CHANNEL:
+            return ((uint64_t)p_service->i_major_number << 16) | p_service->i_minor_number;
+        default:
+            return p_service->i_lcn;
+    }
+}
+
+/*****************************************************************************
+ * servicedb_IndexInsert
+ *****************************************************************************
+ * The index doubles when it holds as many entries as buckets. If that fails
+ * the chains just get longer.
+ *****************************************************************************/
+static void servicedb_IndexInsert(servicedb_index_t *p_index, int i_index,
+                                  servicedb_entry_t *p_entry)
+{
+    if (p_index->i_count >= p_index->i_buckets)
+    {
+        unsigned int i_buckets = p_index->i_buckets * 2;
+        servicedb_entry_t **pp_buckets = calloc(i_buckets, sizeof(servicedb_entry_t *));
+        if (pp_buckets)
+        {
+            for (unsigned int i = 0; i < p_index->i_buckets; i++)
+            {
+                servicedb_entry_t *p = p_index->pp_buckets[i];
+                while (p)
+                {
+                    servicedb_entry_t *p_next = p->p_next[i_index];
+                    unsigned int i_hash = servicedb_Hash(servicedb_Key(p, i_index), i_buckets);
+                    p->p_next[i_index] = pp_buckets[i_hash];
+                    pp_buckets[i_hash] = p;
+                    p = p_next;
+                }
+            }
+            free(p_index->pp_buckets);
+            p_index->pp_buckets = pp_buckets;
+            p_index->i_buckets = i_buckets;
+        }
+    }
+
+    unsigned int i_hash = servicedb_Hash(servicedb_Key(p_entry, i_index), p_index->i_buckets);
+    p_entry->p_next[i_index] = p_index->pp_buckets[i_hash];
+    p_index->pp_buckets[i_hash] = p_entry;
+    p_entry->b_indexed[i_index] = true;
+    p_index->i_count++;
+}
+
+/*****************************************************************************
+ * servicedb_IndexRemove
+ *****************************************************************************/
+static void servicedb_IndexRemove(servicedb_index_t *p_index, int i_index,
+                                  servicedb_entry_t *p_entry)
+{
+    if (!p_entry->b_indexed[i_index])
+        return;
+
+    unsigned int i_hash = servicedb_Hash(servicedb_Key(p_entry, i_index), p_index->i_buckets);
+    servicedb_entry_t **pp = &p_index->pp_buckets[i_hash];
+    while (*pp != p_entry)
+    {
+        assert(*pp);
+        pp = &(*pp)->p_next[i_index];
+    }
+    *pp = p_entry->p_next[i_index];
+    p_entry->p_next[i_index] = NULL;
+    p_entry->b_indexed[i_index] = false;
+    p_index->i_count--;
+}
+
+/*****************************************************************************
+ * servicedb_IndexFirst
+ *****************************************************************************/
+static servicedb_entry_t *servicedb_IndexFirst(const servicedb_index_t *p_index,
+                                               int i_index, uint64_t i_key)
+{
+    servicedb_entry_t *p = p_index->pp_buckets[servicedb_Hash(i_key, p_index->i_buckets)];
+    while (p && servicedb_Key(p, i_index) != i_key)
+        p = p->p_next[i_index];
+    return p;
+}
+
+/*****************************************************************************
+ * servicedb_Touch
+ *****************************************************************************/
+static void servicedb_Touch(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry)
+{
+    if (p_entry->b_touched)
+        return;
+    p_entry->b_touched = true;
+    p_entry->p_next_touched = p_db->p_touched;
+    p_db->p_touched = p_entry;
+}
+
+/* Assign a scalar field of the service, recording the change */
+#define SERVICEDB_SET(p_db, p_entry, field, value)                          \
+    do {                                                                    \
+        if ((p_entry)->service.field != (value))                            \
+        {                                                                   \
+            (p_entry)->service.field = (value);                             \
+            (p_entry)->b_changed = true;                                    \
+            servicedb_Touch(p_db, p_entry);                                 \
+        }                                                                   \
+    } while (0)
+
+/*****************************************************************************
+ * servicedb_SetBytes
+ *****************************************************************************/
+static void servicedb_SetBytes(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry,
+                               uint8_t *pi_length, uint8_t *p_field,
+                               const uint8_t *p_data, uint8_t i_length)
+{
+    /* p_data is NULL when the field is cleared */
+    if (*pi_length == i_length && (i_length == 0 || !memcmp(p_field, p_data, i_length)))
+        return;
+    if (i_length)
+        memcpy(p_field, p_data, i_length);
+    *pi_length = i_length;
+    p_entry->b_changed = true;
+    servicedb_Touch(p_db, p_entry);
+}
+
+/*****************************************************************************
+ * servicedb_SetLcn
+ *****************************************************************************/
+static void servicedb_SetLcn(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry,
+                             bool b_lcn, uint16_t i_lcn, bool b_visible)
+{
+    dvbpsi_servicedb_service_t *p_service = &p_entry->service;
+    if (!b_lcn)
+        i_lcn = 0, b_visible = false;
+
+    if (p_service->b_lcn == b_lcn && p_service->i_lcn == i_lcn
+     && p_service->b_lcn_visible == b_visible)
+        return;
+
+    servicedb_IndexRemove(&p_db->index[SERVICEDB_INDEX_LCN], SERVICEDB_INDEX_LCN, p_entry);
+    p_service->b_lcn = b_lcn;
+    p_service->i_lcn = i_lcn;
+    p_service->b_lcn_visible = b_visible;
+    if (b_lcn)
+        servicedb_IndexInsert(&p_db->index[SERVICEDB_INDEX_LCN], SERVICEDB_INDEX_LCN, p_entry);
+
+    p_entry->b_changed = true;
+    servicedb_Touch(p_db, p_entry);
+}
+
+/*****************************************************************************
+ * servicedb_SetChannel
+ *****************************************************************************/
+static void servicedb_SetChannel(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry,
+                                 bool b_channel, uint16_t i_major, uint16_t i_minor)
+{
+    dvbpsi_servicedb_service_t *p_service = &p_entry->service;
+    if (!b_channel)
+        i_major = i_minor = 0;
+
+    if (p_service->b_channel == b_channel && p_service->i_major_number == i_major
+     && p_service->i_minor_number == i_minor)
+        return;
+
+    servicedb_IndexRemove(&p_db->index[SERVICEDB_INDEX_CHANNEL], SERVICEDB_INDEX_CHANNEL, p_entry);
+    p_service->b_channel = b_channel;
+    p_service->i_major_number = i_major;
+    p_service->i_minor_number = i_minor;
+    if (b_channel)
+        servicedb_IndexInsert(&p_db->index[SERVICEDB_INDEX_CHANNEL], SERVICEDB_INDEX_CHANNEL, p_entry);
+
+    p_entry->b_changed = true;
+    servicedb_Touch(p_db, p_entry);
+}
+
+/*****************************************************************************
+ * servicedb_SetEs
+ *****************************************************************************/
+static bool servicedb_SetEs(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry,
+                            const dvbpsi_pmt_t *p_pmt)
+{
+    unsigned int i_count = 0;
+    bool b_same = true;
+    for (const dvbpsi_pmt_es_t *p_es = p_pmt ? p_pmt->p_first_es : NULL; p_es; p_es = p_es->p_next)
+    {
+        if (i_count >= p_entry->service.i_es_count
+         || p_entry->p_es[i_count].i_type != p_es->i_type
+         || p_entry->p_es[i_count].i_pid != p_es->i_pid)
+            b_same = false;
+        i_count++;
+    }
+    if (b_same && i_count == p_entry->service.i_es_count)
+        return true;
+
+    dvbpsi_servicedb_es_t *p_array = NULL;
+    if (i_count > 0)
+    {
+        p_array = malloc(i_count * sizeof(dvbpsi_servicedb_es_t));
+        if (!p_array)
+            return false;
+        i_count = 0;
+        for (const dvbpsi_pmt_es_t *p_es = p_pmt->p_first_es; p_es; p_es = p_es->p_next)
+        {
+            p_array[i_count].i_type = p_es->i_type;
+            p_array[i_count].i_pid = p_es->i_pid;
+            i_count++;
+        }
+    }
+
+    free(p_entry->p_es);
+    p_entry->p_es = p_array;
+    p_entry->service.p_es = p_array;
+    p_entry->service.i_es_count = i_count;
+    p_entry->b_changed = true;
+    servicedb_Touch(p_db, p_entry);
+    return true;
+}
+
+/*****************************************************************************
+ * servicedb_FindBouquet
+ *****************************************************************************
+ * Position of a bouquet_id in the sorted set of a service, or of the
+ * first greater one.
+ *****************************************************************************/
+static unsigned int servicedb_FindBouquet(const servicedb_entry_t *p_entry,
+                                          uint16_t i_bouquet_id)
+{
+    unsigned int i_low = 0, i_high = p_entry->service.i_bouquet_count;
+    while (i_low < i_high)
+    {
+        unsigned int i_mid = (i_low + i_high) / 2;
+        if (p_entry->pi_bouquets[i_mid] < i_bouquet_id)
+            i_low = i_mid + 1;
+        else
+            i_high = i_mid;
+    }
+    return i_low;
+}
+
+/*****************************************************************************
+ * servicedb_AddBouquet / servicedb_RemoveBouquet
+ *****************************************************************************/
+static bool servicedb_AddBouquet(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry,
+                                 uint16_t i_bouquet_id)
+{
+    unsigned int i_count = p_entry->service.i_bouquet_count;
+    unsigned int i_pos = servicedb_FindBouquet(p_entry, i_bouquet_id);
+    if (i_pos < i_count && p_entry->pi_bouquets[i_pos] == i_bouquet_id)
+        return true;
+
+    uint16_t *pi_bouquets = realloc(p_entry->pi_bouquets, (i_count + 1) * sizeof(uint16_t));
+    if (!pi_bouquets)
+        return false;
+    memmove(&pi_bouquets[i_pos + 1], &pi_bouquets[i_pos], (i_count - i_pos) * sizeof(uint16_t));
+    pi_bouquets[i_pos] = i_bouquet_id;
+
+    p_entry->pi_bouquets = pi_bouquets;
+    p_entry->service.pi_bouquet_ids = pi_bouquets;
+    p_entry->service.i_bouquet_count = i_count + 1;
+    p_entry->b_changed = true;
+    servicedb_Touch(p_db, p_entry);
+    return true;
+}
+
+static void servicedb_RemoveBouquet(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry,
+                                    uint16_t i_bouquet_id)
+{
+    unsigned int i_count = p_entry->service.i_bouquet_count;
+    unsigned int i_pos = servicedb_FindBouquet(p_entry, i_bouquet_id);
+    if (i_pos == i_count || p_entry->pi_bouquets[i_pos] != i_bouquet_id)
+        return;
+
+    memmove(&p_entry->pi_bouquets[i_pos], &p_entry->pi_bouquets[i_pos + 1],
+            (i_count - i_pos - 1) * sizeof(uint16_t));
+    p_entry->service.i_bouquet_count = i_count - 1;
+    p_entry->b_changed = true;
+    servicedb_Touch(p_db, p_entry);
+}
+
+/*****************************************************************************
+ * servicedb_GetTransport
+ *****************************************************************************/
+static servicedb_transport_t *servicedb_GetTransport(dvbpsi_servicedb_t *p_db,
+                                                     uint16_t i_onid, uint16_t i_tsid,
+                                                     bool b_create)
+{
+    unsigned int i_hash = servicedb_Hash(((uint32_t)i_onid << 16) | i_tsid,
+                                         SERVICEDB_TRANSPORT_BUCKETS);
+    servicedb_transport_t *p_ts = p_db->pp_transports[i_hash];
+    while (p_ts && (p_ts->transport.i_onid != i_onid || p_ts->transport.i_tsid != i_tsid))
+        p_ts = p_ts->p_next;
+    if (p_ts || !b_create)
+        return p_ts;
+
+    p_ts = calloc(1, sizeof(servicedb_transport_t));
+    if (!p_ts)
+        return NULL;
+    p_ts->transport.i_onid = i_onid;
+    p_ts->transport.i_tsid = i_tsid;
+    p_ts->p_next = p_db->pp_transports[i_hash];
+    p_db->pp_transports[i_hash] = p_ts;
+    return p_ts;
+}
+
+/*****************************************************************************
+ * servicedb_Get
+ *****************************************************************************
+ * Find a service, creating it if b_create is set. The entry returned is
+ * marked as seen by the current update.
+ *****************************************************************************/
+static servicedb_entry_t *servicedb_Get(dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                                        uint16_t i_tsid, uint16_t i_service_id,
+                                        bool b_create)
+{
+    uint64_t i_key = ((uint64_t)i_onid << 32) | ((uint64_t)i_tsid << 16) | i_service_id;
+    servicedb_entry_t *p_entry = servicedb_IndexFirst(&p_db->index[SERVICEDB_INDEX_KEY],
+                                                      SERVICEDB_INDEX_KEY, i_key);
+    if (!p_entry && b_create)
+    {
+        servicedb_transport_t *p_ts = servicedb_GetTransport(p_db, i_onid, i_tsid, true);
+        if (!p_ts)
+            return NULL;
+        p_entry = calloc(1, sizeof(servicedb_entry_t));
+        if (!p_entry)
+            return NULL;
+
+        p_entry->service.i_onid = i_onid;
+        p_entry->service.i_tsid = i_tsid;
+        p_entry->service.i_service_id = i_service_id;
+        p_entry->service.p_transport = &p_ts->transport;
+        p_entry->p_ts = p_ts;
+        p_entry->p_next_ts = p_ts->p_first_service;
+        p_ts->p_first_service = p_entry;
+        servicedb_IndexInsert(&p_db->index[SERVICEDB_INDEX_KEY], SERVICEDB_INDEX_KEY, p_entry);
+
+        p_entry->b_new = true;
+        servicedb_Touch(p_db, p_entry);
+    }
+
+    if (p_entry)
+        p_entry->i_seen = p_db->i_generation;
+    return p_entry;
+}
+
+/*****************************************************************************
+ * servicedb_Free
+ *****************************************************************************/
+static void servicedb_Free(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry)
+{
+    for (int i = 0; i < SERVICEDB_INDEX_COUNT; i++)
+        servicedb_IndexRemove(&p_db->index[i], i, p_entry);
+
+    servicedb_entry_t **pp = &p_entry->p_ts->p_first_service;
+    while (*pp != p_entry)
+        pp = &(*pp)->p_next_ts;
+    *pp = p_entry->p_next_ts;
+
+    free(p_entry->p_es);
+    free(p_entry->pi_bouquets);
+    free(p_entry);
+}
+
+/*****************************************************************************
+ * servicedb_Notify
+ *****************************************************************************
+ * Raise the callbacks of the current update and drop the services that no
+ * table announces any more. A service created and dropped by the same
+ * update is not reported.
+ *****************************************************************************/
+static void servicedb_Notify(dvbpsi_servicedb_t *p_db)
+{
+    servicedb_entry_t *p_entry;
+    while ((p_entry = p_db->p_touched) != NULL)
+    {
+        p_db->p_touched = p_entry->p_next_touched;
+        p_entry->b_touched = false;
+
+        if (p_entry->service.i_sources == 0)
+        {
+            for (int i = 0; i < SERVICEDB_INDEX_COUNT; i++)
+                servicedb_IndexRemove(&p_db->index[i], i, p_entry);
+            if (!p_entry->b_new && p_db->pf_callback)
+                p_db->pf_callback(p_db->p_cb_data, DVBPSI_SERVICEDB_REMOVED, &p_entry->service);
+            servicedb_Free(p_db, p_entry);
+            continue;
+        }
+
+        if (p_db->pf_callback && (p_entry->b_new || p_entry->b_changed))
+            p_db->pf_callback(p_db->p_cb_data,
+                              p_entry->b_new ? DVBPSI_SERVICEDB_ADDED : DVBPSI_SERVICEDB_CHANGED,
+                              &p_entry->service);
+        p_entry->b_new = p_entry->b_changed = false;
+    }
+}
+
+/*****************************************************************************
+ * servicedb_ClearSources
+ *****************************************************************************
+ * Forget what the given tables said about a service.
+ *****************************************************************************/
+static void servicedb_ClearSources(dvbpsi_servicedb_t *p_db, servicedb_entry_t *p_entry,
+                                   unsigned int i_sources)
+{
+    if (i_sources & DVBPSI_SERVICEDB_PAT)
+        SERVICEDB_SET(p_db, p_entry, i_pmt_pid, 0);
+    if (i_sources & DVBPSI_SERVICEDB_PMT)
+    {
+        SERVICEDB_SET(p_db, p_entry, i_pcr_pid, 0);
+        servicedb_SetEs(p_db, p_entry, NULL);
+    }
+    if (i_sources & DVBPSI_SERVICEDB_SDT)
+    {
+        SERVICEDB_SET(p_db, p_entry, i_running_status, 0);
+        SERVICEDB_SET(p_db, p_entry, b_free_ca, false);
+        SERVICEDB_SET(p_db, p_entry, b_eit_schedule, false);
+        SERVICEDB_SET(p_db, p_entry, b_eit_present, false);
+        servicedb_SetBytes(p_db, p_entry, &p_entry->service.i_provider_name_length,
+                           p_entry->service.i_provider_name, NULL, 0);
+        servicedb_SetBytes(p_db, p_entry, &p_entry->service.i_name_length,
+                           p_entry->service.i_name, NULL, 0);
+    }
+    if (i_sources & DVBPSI_SERVICEDB_NIT)
+        servicedb_SetLcn(p_db, p_entry, false, 0, false);
+    if (i_sources & DVBPSI_SERVICEDB_BAT)
+        SERVICEDB_SET(p_db, p_entry, i_bouquet_count, 0);
+    if (i_sources & DVBPSI_SERVICEDB_VCT)
+    {
+        servicedb_SetChannel(p_db, p_entry, false, 0, 0);
+        SERVICEDB_SET(p_db, p_entry, b_hidden, false);
+        SERVICEDB_SET(p_db, p_entry, i_source_id, 0);
+    }
+
+    SERVICEDB_SET(p_db, p_entry, i_sources, p_entry->service.i_sources & ~i_sources);
+}
+
+/*****************************************************************************
+ * servicedb_ClearUnseen
+ *****************************************************************************
+ * Walk all services and clear i_source from those not seen by the current
+ * update for which pf_scope returns true. Used by the tables that span
+ * several transport streams (NIT, BAT, VCT), which change rarely. A service
+ * only leaves the bouquet of a BAT, it keeps the BAT source while other
+ * bouquets list it.
+ *****************************************************************************/
+static void servicedb_ClearUnseen(dvbpsi_servicedb_t *p_db, unsigned int i_source,
+                                  bool (*pf_scope)(const servicedb_entry_t *, uint16_t),
+                                  uint16_t i_scope)
+{
+    const servicedb_index_t *p_index = &p_db->index[SERVICEDB_INDEX_KEY];
+    for (unsigned int i = 0; i < p_index->i_buckets; i++)
+    {
+        for (servicedb_entry_t *p = p_index->pp_buckets[i]; p; p = p->p_next[SERVICEDB_INDEX_KEY])
+        {
+            if (!(p->service.i_sources & i_source) || p->i_seen == p_db->i_generation
+             || !pf_scope(p, i_scope))
+                continue;
+            if (i_source == DVBPSI_SERVICEDB_BAT)
+                servicedb_RemoveBouquet(p_db, p, i_scope);
+            if (i_source != DVBPSI_SERVICEDB_BAT || p->service.i_bouquet_count == 0)
+                servicedb_ClearSources(p_db, p, i_source);
+        }
+    }
+}
+
+static bool servicedb_InNetwork(const servicedb_entry_t *p_entry, uint16_t i_network_id)
+{
+    return p_entry->i_nit_network_id == i_network_id;
+}
+
+static bool servicedb_InBouquet(const servicedb_entry_t *p_entry, uint16_t i_bouquet_id)
+{
+    unsigned int i_pos = servicedb_FindBouquet(p_entry, i_bouquet_id);
+    return i_pos < p_entry->service.i_bouquet_count
+        && p_entry->pi_bouquets[i_pos] == i_bouquet_id;
+}
+
+static bool servicedb_InVct(const servicedb_entry_t *p_entry, uint16_t i_tsid)
+{
+    return p_entry->i_vct_tsid == i_tsid;
+}
+
+/*****************************************************************************
+ * servicedb_ClearUnseenTs
+ *****************************************************************************
+ * Same as servicedb_ClearUnseen() for the tables of one transport stream.
+ *****************************************************************************/
+static void servicedb_ClearUnseenTs(dvbpsi_servicedb_t *p_db, servicedb_transport_t *p_ts,
+                                    unsigned int i_sources)
+{
+    if (!p_ts)
+        return;
+    for (servicedb_entry_t *p = p_ts->p_first_service; p; p = p->p_next_ts)
+    {
+        if ((p->service.i_sources & i_sources) && p->i_seen != p_db->i_generation)
+            servicedb_ClearSources(p_db, p, i_sources);
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_new
+ *****************************************************************************/
+dvbpsi_servicedb_t *dvbpsi_servicedb_new(dvbpsi_servicedb_callback pf_callback,
+                                         void *p_cb_data)
+{
+    dvbpsi_servicedb_t *p_db = calloc(1, sizeof(dvbpsi_servicedb_t));
+    if (!p_db)
+        return NULL;
+
+    for (int i = 0; i < SERVICEDB_INDEX_COUNT; i++)
+    {
+        p_db->index[i].pp_buckets = calloc(SERVICEDB_MIN_BUCKETS, sizeof(servicedb_entry_t *));
+        if (!p_db->index[i].pp_buckets)
+        {
+            dvbpsi_servicedb_delete(p_db);
+            return NULL;
+        }
+        p_db->index[i].i_buckets = SERVICEDB_MIN_BUCKETS;
+    }
+
+    p_db->pf_callback = pf_callback;
+    p_db->p_cb_data = p_cb_data;
+    return p_db;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_delete
+ *****************************************************************************/
+void dvbpsi_servicedb_delete(dvbpsi_servicedb_t *p_db)
+{
+    if (!p_db)
+        return;
+
+    for (unsigned int i = 0; i < SERVICEDB_TRANSPORT_BUCKETS; i++)
+    {
+        servicedb_transport_t *p_ts = p_db->pp_transports[i];
+        while (p_ts)
+        {
+            servicedb_transport_t *p_ts_next = p_ts->p_next;
+            servicedb_entry_t *p_entry = p_ts->p_first_service;
+            while (p_entry)
+            {
+                servicedb_entry_t *p_next = p_entry->p_next_ts;
+                free(p_entry->p_es);
+                free(p_entry->pi_bouquets);
+                free(p_entry);
+                p_entry = p_next;
+            }
+            free(p_ts);
+            p_ts = p_ts_next;
+        }
+    }
+
+    for (int i = 0; i < SERVICEDB_INDEX_COUNT; i++)
+        free(p_db->index[i].pp_buckets);
+    free(p_db);
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_pat
+ *****************************************************************************/
+bool dvbpsi_servicedb_update_pat(dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                                 const dvbpsi_pat_t *p_pat)
+{
+    bool b_ok = true;
+    p_db->i_generation++;
+
+    for (const dvbpsi_pat_program_t *p_program = p_pat->p_first_program;
+         p_program; p_program = p_program->p_next)
+    {
+        if (p_program->i_number == 0)
+            continue; /* network PID */
+
+        servicedb_entry_t *p_entry = servicedb_Get(p_db, i_onid, p_pat->i_ts_id,
+                                                   p_program->i_number, true);
+        if (!p_entry)
+        {
+            b_ok = false;
+            break;
+        }
+        SERVICEDB_SET(p_db, p_entry, i_pmt_pid, p_program->i_pid);
+        SERVICEDB_SET(p_db, p_entry, i_sources,
+                      p_entry->service.i_sources | DVBPSI_SERVICEDB_PAT);
+    }
+
+    if (b_ok)
+        servicedb_ClearUnseenTs(p_db, servicedb_GetTransport(p_db, i_onid, p_pat->i_ts_id, false),
+                                DVBPSI_SERVICEDB_PAT | DVBPSI_SERVICEDB_PMT);
+    servicedb_Notify(p_db);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_pmt
+ *****************************************************************************/
+bool dvbpsi_servicedb_update_pmt(dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                                 uint16_t i_tsid, const dvbpsi_pmt_t *p_pmt)
+{
+    bool b_ok = false;
+    p_db->i_generation++;
+
+    /* A new entry left without source is dropped by servicedb_Notify() */
+    servicedb_entry_t *p_entry = servicedb_Get(p_db, i_onid, i_tsid,
+                                               p_pmt->i_program_number, true);
+    if (p_entry && servicedb_SetEs(p_db, p_entry, p_pmt))
+    {
+        SERVICEDB_SET(p_db, p_entry, i_pcr_pid, p_pmt->i_pcr_pid);
+        SERVICEDB_SET(p_db, p_entry, i_sources,
+                      p_entry->service.i_sources | DVBPSI_SERVICEDB_PMT);
+        b_ok = true;
+    }
+
+    servicedb_Notify(p_db);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_sdt
+ *****************************************************************************/
+bool dvbpsi_servicedb_update_sdt(dvbpsi_servicedb_t *p_db, const dvbpsi_sdt_t *p_sdt)
+{
+    bool b_ok = true;
+    p_db->i_generation++;
+
+    for (const dvbpsi_sdt_service_t *p_service = p_sdt->p_first_service;
+         p_service; p_service = p_service->p_next)
+    {
+        servicedb_entry_t *p_entry = servicedb_Get(p_db, p_sdt->i_network_id, p_sdt->i_extension,
+                                                   p_service->i_service_id, true);
+        if (!p_entry)
+        {
+            b_ok = false;
+            break;
+        }
+
+        SERVICEDB_SET(p_db, p_entry, i_running_status, p_service->i_running_status);
+        SERVICEDB_SET(p_db, p_entry, b_free_ca, p_service->b_free_ca);
+        SERVICEDB_SET(p_db, p_entry, b_eit_schedule, p_service->b_eit_schedule);
+        SERVICEDB_SET(p_db, p_entry, b_eit_present, p_service->b_eit_present);
+
+        /* service_descriptor: type, provider and name */
+        const uint8_t *p_provider = NULL, *p_name = NULL;
+        uint8_t i_provider_length = 0, i_name_length = 0;
+        for (const dvbpsi_descriptor_t *p_dr = p_service->p_first_descriptor;
+             p_dr; p_dr = p_dr->p_next)
+        {
+            const uint8_t *p_data = p_dr->p_data;
+            if (p_dr->i_tag != 0x48 || p_dr->i_length < 3
+             || 3 + p_data[1] > p_dr->i_length
+             || 3 + p_data[1] + p_data[2 + p_data[1]] > p_dr->i_length)
+                continue;
+            SERVICEDB_SET(p_db, p_entry, i_service_type, p_data[0]);
+            i_provider_length = p_data[1];
+            p_provider = p_data + 2;
+            i_name_length = p_data[2 + i_provider_length];
+            p_name = p_data + 3 + i_provider_length;
+            break;
+        }
+        servicedb_SetBytes(p_db, p_entry, &p_entry->service.i_provider_name_length,
+                           p_entry->service.i_provider_name, p_provider, i_provider_length);
+        servicedb_SetBytes(p_db, p_entry, &p_entry->service.i_name_length,
+                           p_entry->service.i_name, p_name, i_name_length);
+
+        SERVICEDB_SET(p_db, p_entry, i_sources,
+                      p_entry->service.i_sources | DVBPSI_SERVICEDB_SDT);
+    }
+
+    if (b_ok)
+        servicedb_ClearUnseenTs(p_db, servicedb_GetTransport(p_db, p_sdt->i_network_id,
+                                                             p_sdt->i_extension, false),
+                                DVBPSI_SERVICEDB_SDT);
+    servicedb_Notify(p_db);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * servicedb_IsDelivery
+ *****************************************************************************/
+static bool servicedb_IsDelivery(const dvbpsi_descriptor_t *p_dr)
+{
+    switch (p_dr->i_tag)
+    {
+        case 0x43: /* satellite */
+        case 0x44: /* cable */
+        case 0x5a: /* terrestrial */
+        case 0x79: /* S2 satellite */
+            return true;
+        case 0x7f: /* T2 and C2 extensions */
+            return p_dr->i_length > 0 && (p_dr->p_data[0] == 0x04 || p_dr->p_data[0] == 0x0d);
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************
+ * servicedb_ServiceList
+ *****************************************************************************
+ * Apply the service list descriptors of a NIT or BAT transport stream loop.
+ * Returns false on allocation error.
+ *****************************************************************************/
+static bool servicedb_ServiceList(dvbpsi_servicedb_t *p_db, const dvbpsi_descriptor_t *p_dr,
+                                  uint16_t i_onid, uint16_t i_tsid, unsigned int i_source,
+                                  uint16_t i_scope)
+{
+    for (; p_dr; p_dr = p_dr->p_next)
+    {
+        if (p_dr->i_tag != 0x41)
+            continue;
+        for (unsigned int i = 0; i + 3 <= p_dr->i_length; i += 3)
+        {
+            const uint8_t *p_data = p_dr->p_data + i;
+            servicedb_entry_t *p_entry = servicedb_Get(p_db, i_onid, i_tsid,
+                                                       (uint16_t)(p_data[0] << 8 | p_data[1]),
+                                                       true);
+            if (!p_entry)
+                return false;
+            SERVICEDB_SET(p_db, p_entry, i_service_type, p_data[2]);
+            if (i_source == DVBPSI_SERVICEDB_NIT)
+                p_entry->i_nit_network_id = i_scope;
+            else if (!servicedb_AddBouquet(p_db, p_entry, i_scope))
+                return false;
+            SERVICEDB_SET(p_db, p_entry, i_sources, p_entry->service.i_sources | i_source);
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_nit
+ *****************************************************************************/
+bool dvbpsi_servicedb_update_nit(dvbpsi_servicedb_t *p_db, const dvbpsi_nit_t *p_nit)
+{
+    bool b_ok = true;
+    p_db->i_generation++;
+
+    for (const dvbpsi_nit_ts_t *p_ts = p_nit->p_first_ts; b_ok && p_ts; p_ts = p_ts->p_next)
+    {
+        servicedb_transport_t *p_transport = servicedb_GetTransport(p_db, p_ts->i_orig_network_id,
+                                                                    p_ts->i_ts_id, true);
+        if (!p_transport)
+        {
+            b_ok = false;
+            break;
+        }
+        p_transport->i_seen = p_db->i_generation;
+        p_transport->transport.i_network_id = p_nit->i_network_id;
+        p_transport->transport.b_nit = true;
+
+        for (const dvbpsi_descriptor_t *p_dr = p_ts->p_first_descriptor; p_dr; p_dr = p_dr->p_next)
+        {
+            if (!servicedb_IsDelivery(p_dr))
+                continue;
+            p_transport->transport.i_delivery_tag = p_dr->i_tag;
+            p_transport->transport.i_delivery_length = p_dr->i_length;
+            memcpy(p_transport->transport.p_delivery, p_dr->p_data, p_dr->i_length);
+            break;
+        }
+
+        b_ok = servicedb_ServiceList(p_db, p_ts->p_first_descriptor, p_ts->i_orig_network_id,
+                                     p_ts->i_ts_id, DVBPSI_SERVICEDB_NIT, p_nit->i_network_id);
+
+        /* logical_channel_descriptor of EACEM/NorDig: 4 bytes per service */
+        for (const dvbpsi_descriptor_t *p_dr = p_ts->p_first_descriptor;
+             b_ok && p_dr; p_dr = p_dr->p_next)
+        {
+            if (p_dr->i_tag != 0x83)
+                continue;
+            for (unsigned int i = 0; i + 4 <= p_dr->i_length; i += 4)
+            {
+                const uint8_t *p_data = p_dr->p_data + i;
+                servicedb_entry_t *p_entry = servicedb_Get(p_db, p_ts->i_orig_network_id,
+                                                           p_ts->i_ts_id,
+                                                           (uint16_t)(p_data[0] << 8 | p_data[1]),
+                                                           true);
+                if (!p_entry)
+                {
+                    b_ok = false;
+                    break;
+                }
+                p_entry->i_nit_network_id = p_nit->i_network_id;
+                servicedb_SetLcn(p_db, p_entry, true,
+                                 (uint16_t)((p_data[2] & 0x03) << 8 | p_data[3]),
+                                 (p_data[2] & 0x80) != 0);
+                SERVICEDB_SET(p_db, p_entry, i_sources,
+                              p_entry->service.i_sources | DVBPSI_SERVICEDB_NIT);
+            }
+        }
+    }
+
+    if (b_ok)
+    {
+        servicedb_ClearUnseen(p_db, DVBPSI_SERVICEDB_NIT, servicedb_InNetwork, p_nit->i_network_id);
+
+        for (unsigned int i = 0; i < SERVICEDB_TRANSPORT_BUCKETS; i++)
+            for (servicedb_transport_t *p_ts = p_db->pp_transports[i]; p_ts; p_ts = p_ts->p_next)
+            {
+                if (!p_ts->transport.b_nit || p_ts->i_seen == p_db->i_generation
+                 || p_ts->transport.i_network_id != p_nit->i_network_id)
+                    continue;
+                p_ts->transport.b_nit = false;
+                p_ts->transport.i_delivery_tag = 0;
+                p_ts->transport.i_delivery_length = 0;
+            }
+    }
+    servicedb_Notify(p_db);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_bat
+ *****************************************************************************/
+bool dvbpsi_servicedb_update_bat(dvbpsi_servicedb_t *p_db, const dvbpsi_bat_t *p_bat)
+{
+    bool b_ok = true;
+    p_db->i_generation++;
+
+    for (const dvbpsi_bat_ts_t *p_ts = p_bat->p_first_ts; b_ok && p_ts; p_ts = p_ts->p_next)
+        b_ok = servicedb_ServiceList(p_db, p_ts->p_first_descriptor, p_ts->i_orig_network_id,
+                                     p_ts->i_ts_id, DVBPSI_SERVICEDB_BAT, p_bat->i_extension);
+
+    if (b_ok)
+        servicedb_ClearUnseen(p_db, DVBPSI_SERVICEDB_BAT, servicedb_InBouquet, p_bat->i_extension);
+    servicedb_Notify(p_db);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_vct
+ *****************************************************************************/
+bool dvbpsi_servicedb_update_vct(dvbpsi_servicedb_t *p_db, const dvbpsi_atsc_vct_t *p_vct)
+{
+    bool b_ok = true;
+    p_db->i_generation++;
+
+    for (const dvbpsi_atsc_vct_channel_t *p_channel = p_vct->p_first_channel;
+         p_channel; p_channel = p_channel->p_next)
+    {
+        servicedb_entry_t *p_entry = servicedb_Get(p_db, 0, p_channel->i_channel_tsid,
+                                                   p_channel->i_program_number, true);
+        if (!p_entry)
+        {
+            b_ok = false;
+            break;
+        }
+        p_entry->i_vct_tsid = p_vct->i_extension;
+        p_entry->p_ts->transport.i_modulation = p_channel->i_modulation;
+
+        servicedb_SetChannel(p_db, p_entry, true, p_channel->i_major_number,
+                             p_channel->i_minor_number);
+        SERVICEDB_SET(p_db, p_entry, b_hidden, p_channel->b_hidden);
+        SERVICEDB_SET(p_db, p_entry, i_source_id, p_channel->i_source_id);
+        SERVICEDB_SET(p_db, p_entry, i_service_type, p_channel->i_service_type);
+        if (memcmp(p_entry->service.i_short_name, p_channel->i_short_name,
+                   sizeof(p_entry->service.i_short_name)))
+        {
+            memcpy(p_entry->service.i_short_name, p_channel->i_short_name,
+                   sizeof(p_entry->service.i_short_name));
+            p_entry->b_changed = true;
+            servicedb_Touch(p_db, p_entry);
+        }
+        SERVICEDB_SET(p_db, p_entry, i_sources,
+                      p_entry->service.i_sources | DVBPSI_SERVICEDB_VCT);
+    }
+
+    if (b_ok)
+        servicedb_ClearUnseen(p_db, DVBPSI_SERVICEDB_VCT, servicedb_InVct, p_vct->i_extension);
+    servicedb_Notify(p_db);
+    return b_ok;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find
+ *****************************************************************************/
+const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find(const dvbpsi_servicedb_t *p_db,
+                                                        uint16_t i_onid, uint16_t i_tsid,
+                                                        uint16_t i_service_id)
+{
+    uint64_t i_key = ((uint64_t)i_onid << 32) | ((uint64_t)i_tsid << 16) | i_service_id;
+    servicedb_entry_t *p_entry = servicedb_IndexFirst(&p_db->index[SERVICEDB_INDEX_KEY],
+                                                      SERVICEDB_INDEX_KEY, i_key);
+    return p_entry ? &p_entry->service : NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find_channel
+ *****************************************************************************/
+const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find_channel(const dvbpsi_servicedb_t *p_db,
+                                                                uint16_t i_major_number,
+                                                                uint16_t i_minor_number)
+{
+    uint64_t i_key = ((uint64_t)i_major_number << 16) | i_minor_number;
+    servicedb_entry_t *p_entry = servicedb_IndexFirst(&p_db->index[SERVICEDB_INDEX_CHANNEL],
+                                                      SERVICEDB_INDEX_CHANNEL, i_key);
+    return p_entry ? &p_entry->service : NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find_lcn
+ *****************************************************************************/
+const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find_lcn(const dvbpsi_servicedb_t *p_db,
+                                                            uint16_t i_lcn)
+{
+    servicedb_entry_t *p_first = servicedb_IndexFirst(&p_db->index[SERVICEDB_INDEX_LCN],
+                                                      SERVICEDB_INDEX_LCN, i_lcn);
+    for (servicedb_entry_t *p = p_first; p; p = p->p_next[SERVICEDB_INDEX_LCN])
+    {
+        if (p->service.i_lcn == i_lcn && p->service.b_lcn_visible)
+            return &p->service;
+    }
+    return p_first ? &p_first->service : NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find_transport
+ *****************************************************************************/
+const dvbpsi_servicedb_transport_t *dvbpsi_servicedb_find_transport(const dvbpsi_servicedb_t *p_db,
+                                                                    uint16_t i_onid,
+                                                                    uint16_t i_tsid)
+{
+    unsigned int i_hash = servicedb_Hash(((uint32_t)i_onid << 16) | i_tsid,
+                                         SERVICEDB_TRANSPORT_BUCKETS);
+    for (const servicedb_transport_t *p_ts = p_db->pp_transports[i_hash]; p_ts; p_ts = p_ts->p_next)
+    {
+        if (p_ts->transport.i_onid == i_onid && p_ts->transport.i_tsid == i_tsid)
+            return &p_ts->transport;
+    }
+    return NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_count
+ *****************************************************************************/
+unsigned int dvbpsi_servicedb_count(const dvbpsi_servicedb_t *p_db)
+{
+    return p_db->index[SERVICEDB_INDEX_KEY].i_count;
+}
+
+/*****************************************************************************
+ * dvbpsi_servicedb_foreach
+ *****************************************************************************/
+void dvbpsi_servicedb_foreach(const dvbpsi_servicedb_t *p_db,
+                              void (*pf_service)(void *p_data,
+                                                 const dvbpsi_servicedb_service_t *p_service),
+                              void *p_data)
+{
+    const servicedb_index_t *p_index = &p_db->index[SERVICEDB_INDEX_KEY];
+    for (unsigned int i = 0; i < p_index->i_buckets; i++)
+    {
+        for (const servicedb_entry_t *p = p_index->pp_buckets[i]; p; p = p->p_next[SERVICEDB_INDEX_KEY])
+            pf_service(p_data, &p->service);
+    }
+}
@@ -0,0 +1,447 @@
+/*****************************************************************************
+ * servicedb.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <servicedb.h>
+ * \brief Application interface for the service database.
+ *
+ * The service database joins the PAT, PMT, SDT, NIT, BAT and ATSC VCT of
+ * one or more networks into a single list of services. The application
+ * feeds it with the tables it decodes; each update replaces what the table
+ * said before, so that a service that is no longer announced by any table
+ * is removed. Services are indexed by (original_network_id,
+ * transport_stream_id, service_id), by ATSC major/minor channel number and
+ * by logical channel number, and each index is a hash table.
+ *
+ * The database does not keep the tables, which remain owned by the caller.
+ * ATSC services have an original_network_id of 0, their transport stream
+ * and service ids are the channel_TSID and program_number of the VCT.
+ *
+ * dvbpsi.h, descriptor.h, tables/pat.h, tables/pmt.h, tables/sdt.h,
+ * tables/nit.h, tables/bat.h and tables/atsc_vct.h must be included before
+ * this file.
+ */
+
+#ifndef _DVBPSI_SERVICEDB_H_
+#define _DVBPSI_SERVICEDB_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! The service is listed in a PAT */
+#define DVBPSI_SERVICEDB_PAT    0x01
+/*! The PMT of the service is known */
+#define DVBPSI_SERVICEDB_PMT    0x02
+/*! The service is described in an SDT */
+#define DVBPSI_SERVICEDB_SDT    0x04
+/*! The service is listed in a NIT */
+#define DVBPSI_SERVICEDB_NIT    0x08
+/*! The service is listed in a BAT */
+#define DVBPSI_SERVICEDB_BAT    0x10
+/*! The service is a virtual channel of a VCT */
+#define DVBPSI_SERVICEDB_VCT    0x20
+
+/*****************************************************************************
+ * dvbpsi_servicedb_event_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_servicedb_event_e
+ * \brief Reason of a service database callback.
+ */
+/*!
+ * \typedef enum dvbpsi_servicedb_event_e dvbpsi_servicedb_event_t
+ * \brief dvbpsi_servicedb_event_t type definition.
+ */
+typedef enum dvbpsi_servicedb_event_e
+{
+    DVBPSI_SERVICEDB_ADDED = 0,     /*!< the service has been created */
+    DVBPSI_SERVICEDB_CHANGED,       /*!< a field of the service has changed */
+    DVBPSI_SERVICEDB_REMOVED,       /*!< no table announces the service any
+                                         more, this is the last callback for
+                                         it */
+} dvbpsi_servicedb_event_t;
+
+/*****************************************************************************
+ * dvbpsi_servicedb_es_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_servicedb_es_s
+ * \brief Elementary stream of a service.
+ */
+/*!
+ * \typedef struct dvbpsi_servicedb_es_s dvbpsi_servicedb_es_t
+ * \brief dvbpsi_servicedb_es_t type definition.
+ */
+typedef struct dvbpsi_servicedb_es_s
+{
+    uint8_t     i_type;             /*!< stream_type */
+    uint16_t    i_pid;              /*!< elementary_PID */
+} dvbpsi_servicedb_es_t;
+
+/*****************************************************************************
+ * dvbpsi_servicedb_transport_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_servicedb_transport_s
+ * \brief Transport stream known to the database.
+ */
+/*!
+ * \typedef struct dvbpsi_servicedb_transport_s dvbpsi_servicedb_transport_t
+ * \brief dvbpsi_servicedb_transport_t type definition.
+ */
+typedef struct dvbpsi_servicedb_transport_s
+{
+    uint16_t    i_onid;             /*!< original_network_id */
+    uint16_t    i_tsid;             /*!< transport_stream_id */
+    uint16_t    i_network_id;       /*!< network_id of the NIT describing the
+                                         transport stream */
+    bool        b_nit;              /*!< the transport stream is listed in a
+                                         NIT */
+
+    uint8_t     i_delivery_tag;     /*!< tag of the delivery system
+                                         descriptor, 0 if unknown */
+    uint8_t     i_delivery_length;  /*!< length of p_delivery */
+    uint8_t     p_delivery[255];    /*!< payload of the delivery system
+                                         descriptor */
+
+    uint8_t     i_modulation;       /*!< VCT modulation_mode, 0 if unknown */
+} dvbpsi_servicedb_transport_t;
+
+/*****************************************************************************
+ * dvbpsi_servicedb_service_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_servicedb_service_s
+ * \brief Service of the database.
+ *
+ * Names are kept as broadcast, use dvbpsi_dvb_text_to_utf8() to convert
+ * them. A field that no table has given is 0.
+ */
+/*!
+ * \typedef struct dvbpsi_servicedb_service_s dvbpsi_servicedb_service_t
+ * \brief dvbpsi_servicedb_service_t type definition.
+ */
+typedef struct dvbpsi_servicedb_service_s
+{
+    uint16_t    i_onid;             /*!< original_network_id */
+    uint16_t    i_tsid;             /*!< transport_stream_id */
+    uint16_t    i_service_id;       /*!< service_id or program_number */
+    unsigned int i_sources;         /*!< DVBPSI_SERVICEDB_* tables announcing
+                                         the service */
+    const dvbpsi_servicedb_transport_t *p_transport; /*!< transport stream
+                                         carrying the service */
+
+    /* PAT and PMT */
+    uint16_t    i_pmt_pid;          /*!< PID of the PMT */
+    uint16_t    i_pcr_pid;          /*!< PCR_PID */
+    unsigned int i_es_count;        /*!< number of elementary streams */
+    const dvbpsi_servicedb_es_t *p_es; /*!< elementary streams */
+
+    /* SDT, NIT service list or VCT */
+    uint8_t     i_service_type;     /*!< service_type */
+
+    /* SDT */
+    uint8_t     i_running_status;   /*!< running_status */
+    bool        b_free_ca;          /*!< free_CA_mode */
+    bool        b_eit_schedule;     /*!< EIT_schedule_flag */
+    bool        b_eit_present;      /*!< EIT_present_following_flag */
+    uint8_t     i_provider_name_length; /*!< length of i_provider_name */
+    uint8_t     i_provider_name[252];   /*!< service_provider_name */
+    uint8_t     i_name_length;      /*!< length of i_name */
+    uint8_t     i_name[252];        /*!< service_name */
+
+    /* NIT logical channel number */
+    bool        b_lcn;              /*!< i_lcn is valid */
+    bool        b_lcn_visible;      /*!< visible_service_flag */
+    uint16_t    i_lcn;              /*!< logical_channel_number */
+
+    /* BAT */
+    unsigned int i_bouquet_count;   /*!< number of bouquets listing the service */
+    const uint16_t *pi_bouquet_ids; /*!< bouquet_ids, in increasing order */
+
+    /* ATSC VCT */
+    bool        b_channel;          /*!< the channel numbers are valid */
+    bool        b_hidden;           /*!< hidden */
+    uint16_t    i_major_number;     /*!< major_channel_number */
+    uint16_t    i_minor_number;     /*!< minor_channel_number */
+    uint16_t    i_source_id;        /*!< source_id */
+    uint8_t     i_short_name[14];   /*!< short_name, UTF-16 */
+} dvbpsi_servicedb_service_t;
+
+/*****************************************************************************
+ * dvbpsi_servicedb_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_servicedb_s dvbpsi_servicedb_t
+ * \brief Opaque service database handle.
+ */
+typedef struct dvbpsi_servicedb_s dvbpsi_servicedb_t;
+
+/*****************************************************************************
+ * dvbpsi_servicedb_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_servicedb_callback)(void *p_cb_data,
+                        dvbpsi_servicedb_event_t i_event,
+                        const dvbpsi_servicedb_service_t *p_service)
+ * \brief Callback type definition.
+ *
+ * The callbacks of an update are raised once the whole table has been
+ * applied, so the database is consistent. The database must not be updated
+ * from the callback.
+ */
+typedef void (* dvbpsi_servicedb_callback)(void *p_cb_data,
+                                           dvbpsi_servicedb_event_t i_event,
+                                           const dvbpsi_servicedb_service_t *p_service);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_servicedb_t *dvbpsi_servicedb_new(dvbpsi_servicedb_callback pf_callback,
+                                                void *p_cb_data)
+ * \brief Create an empty service database.
+ * \param pf_callback function called when a service is added, changed or
+ * removed, may be NULL
+ * \param p_cb_data private data given to pf_callback
+ * \return pointer to the database, NULL on error.
+ */
+dvbpsi_servicedb_t *dvbpsi_servicedb_new(dvbpsi_servicedb_callback pf_callback,
+                                         void *p_cb_data);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_servicedb_delete(dvbpsi_servicedb_t *p_db)
+ * \brief Destroy a service database. No callback is raised.
+ * \param p_db pointer to the database
+ * \return nothing.
+ */
+void dvbpsi_servicedb_delete(dvbpsi_servicedb_t *p_db);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_pat
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_servicedb_update_pat(dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                                        const dvbpsi_pat_t *p_pat)
+ * \brief Apply a PAT.
+ * \param p_db pointer to the database
+ * \param i_onid original_network_id of the transport stream, which the PAT
+ * does not carry
+ * \param p_pat PAT
+ * \return false on allocation error, the database is then partially
+ * updated.
+ *
+ * A program missing from the PAT loses its PAT and PMT information.
+ */
+bool dvbpsi_servicedb_update_pat(dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                                 const dvbpsi_pat_t *p_pat);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_pmt
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_servicedb_update_pmt(dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                                        uint16_t i_tsid, const dvbpsi_pmt_t *p_pmt)
+ * \brief Apply a PMT.
+ * \param p_db pointer to the database
+ * \param i_onid original_network_id of the transport stream
+ * \param i_tsid transport_stream_id of the transport stream
+ * \param p_pmt PMT
+ * \return false on allocation error.
+ */
+bool dvbpsi_servicedb_update_pmt(dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                                 uint16_t i_tsid, const dvbpsi_pmt_t *p_pmt);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_sdt
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_servicedb_update_sdt(dvbpsi_servicedb_t *p_db,
+                                        const dvbpsi_sdt_t *p_sdt)
+ * \brief Apply an SDT actual or other.
+ * \param p_db pointer to the database
+ * \param p_sdt SDT
+ * \return false on allocation error, the database is then partially
+ * updated.
+ */
+bool dvbpsi_servicedb_update_sdt(dvbpsi_servicedb_t *p_db, const dvbpsi_sdt_t *p_sdt);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_nit
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_servicedb_update_nit(dvbpsi_servicedb_t *p_db,
+                                        const dvbpsi_nit_t *p_nit)
+ * \brief Apply a NIT actual or other.
+ * \param p_db pointer to the database
+ * \param p_nit NIT
+ * \return false on allocation error, the database is then partially
+ * updated.
+ *
+ * The delivery system descriptors give the tuning parameters of the
+ * transport streams, the service list descriptors (0x41) list their
+ * services and the logical channel descriptors (0x83) number them.
+ */
+bool dvbpsi_servicedb_update_nit(dvbpsi_servicedb_t *p_db, const dvbpsi_nit_t *p_nit);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_bat
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_servicedb_update_bat(dvbpsi_servicedb_t *p_db,
+                                        const dvbpsi_bat_t *p_bat)
+ * \brief Apply a BAT.
+ * \param p_db pointer to the database
+ * \param p_bat BAT
+ * \return false on allocation error, the database is then partially
+ * updated.
+ *
+ * The services of the service list descriptors (0x41) are attached to the
+ * bouquet. A service belongs to all the bouquets listing it, and leaves a
+ * bouquet when the BAT of this bouquet no longer lists it.
+ */
+bool dvbpsi_servicedb_update_bat(dvbpsi_servicedb_t *p_db, const dvbpsi_bat_t *p_bat);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_update_vct
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_servicedb_update_vct(dvbpsi_servicedb_t *p_db,
+                                        const dvbpsi_atsc_vct_t *p_vct)
+ * \brief Apply an ATSC terrestrial or cable VCT.
+ * \param p_db pointer to the database
+ * \param p_vct VCT
+ * \return false on allocation error, the database is then partially
+ * updated.
+ */
+bool dvbpsi_servicedb_update_vct(dvbpsi_servicedb_t *p_db, const dvbpsi_atsc_vct_t *p_vct);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find(
+                        const dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                        uint16_t i_tsid, uint16_t i_service_id)
+ * \brief Look a service up by its DVB triplet.
+ * \param p_db pointer to the database
+ * \param i_onid original_network_id
+ * \param i_tsid transport_stream_id
+ * \param i_service_id service_id
+ * \return the service, NULL if unknown. The pointer stays valid until the
+ * REMOVED callback of the service has returned.
+ */
+const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find(const dvbpsi_servicedb_t *p_db,
+                                                        uint16_t i_onid, uint16_t i_tsid,
+                                                        uint16_t i_service_id);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find_channel
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find_channel(
+                        const dvbpsi_servicedb_t *p_db, uint16_t i_major_number,
+                        uint16_t i_minor_number)
+ * \brief Look a virtual channel up by its ATSC channel number.
+ * \param p_db pointer to the database
+ * \param i_major_number major_channel_number
+ * \param i_minor_number minor_channel_number
+ * \return the service, NULL if unknown. When several services share the
+ * number, any of them.
+ */
+const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find_channel(const dvbpsi_servicedb_t *p_db,
+                                                                uint16_t i_major_number,
+                                                                uint16_t i_minor_number);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find_lcn
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find_lcn(
+                        const dvbpsi_servicedb_t *p_db, uint16_t i_lcn)
+ * \brief Look a service up by its logical channel number.
+ * \param p_db pointer to the database
+ * \param i_lcn logical_channel_number
+ * \return the service, NULL if unknown. When several services share the
+ * number, a visible one is preferred.
+ */
+const dvbpsi_servicedb_service_t *dvbpsi_servicedb_find_lcn(const dvbpsi_servicedb_t *p_db,
+                                                            uint16_t i_lcn);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_find_transport
+ *****************************************************************************/
+/*!
+ * \fn const dvbpsi_servicedb_transport_t *dvbpsi_servicedb_find_transport(
+                        const dvbpsi_servicedb_t *p_db, uint16_t i_onid,
+                        uint16_t i_tsid)
+ * \brief Look a transport stream up.
+ * \param p_db pointer to the database
+ * \param i_onid original_network_id
+ * \param i_tsid transport_stream_id
+ * \return the transport stream, NULL if unknown. Transport streams live as
+ * long as the database.
+ */
+const dvbpsi_servicedb_transport_t *dvbpsi_servicedb_find_transport(const dvbpsi_servicedb_t *p_db,
+                                                                    uint16_t i_onid,
+                                                                    uint16_t i_tsid);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_count
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_servicedb_count(const dvbpsi_servicedb_t *p_db)
+ * \brief Number of services in the database.
+ * \param p_db pointer to the database
+ * \return the number of services.
+ */
+unsigned int dvbpsi_servicedb_count(const dvbpsi_servicedb_t *p_db);
+
+/*****************************************************************************
+ * dvbpsi_servicedb_foreach
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_servicedb_foreach(const dvbpsi_servicedb_t *p_db,
+                        void (*pf_service)(void *p_data,
+                                           const dvbpsi_servicedb_service_t *p_service),
+                        void *p_data)
+ * \brief Call a function for each service, in no particular order.
+ * \param p_db pointer to the database
+ * \param pf_service function to call, it must not update the database
+ * \param p_data private data given to pf_service
+ * \return nothing.
+ */
+void dvbpsi_servicedb_foreach(const dvbpsi_servicedb_t *p_db,
+                              void (*pf_service)(void *p_data,
+                                                 const dvbpsi_servicedb_service_t *p_service),
+                              void *p_data);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of servicedb.h"
+#endif
@@ -0,0 +1,415 @@
+/*****************************************************************************
+ * snapshot.c: per transport stream PSI snapshot cache
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "snapshot.h"
+
+#define SNAPSHOT_HASH_SIZE      64      /* power of 2 */
+#define SNAPSHOT_MIN_SECTION    12      /* long header and CRC_32 */
+#define SNAPSHOT_MAX_SECTION    4096
+
+/*****************************************************************************
+ * snapshot_section_t
+ *****************************************************************************
+ * Raw section and its decoded header.
+ *****************************************************************************/
+typedef struct snapshot_section_s
+{
+    struct snapshot_section_s  *p_next;
+
+    uint16_t                    i_pid;
+    uint8_t                     i_table_id;
+    uint16_t                    i_extension;
+    uint8_t                     i_version;
+    uint8_t                     i_number;
+    uint32_t                    i_crc;
+    size_t                      i_length;
+    uint8_t                     p_data[];
+} snapshot_section_t;
+
+/*****************************************************************************
+ * snapshot_transport_t
+ *****************************************************************************
+ * Cached sections of one transport stream.
+ *****************************************************************************/
+typedef struct snapshot_transport_s
+{
+    uint32_t                        i_key;          /* onid << 16 | tsid */
+    snapshot_section_t             *p_first_section;
+
+    struct snapshot_transport_s    *p_next_hash;
+    struct snapshot_transport_s    *p_prev_lru;     /* more recently used */
+    struct snapshot_transport_s    *p_next_lru;     /* less recently used */
+} snapshot_transport_t;
+
+/*****************************************************************************
+ * dvbpsi_snapshot_s
+ *****************************************************************************/
+struct dvbpsi_snapshot_s
+{
+    unsigned int            i_max_transports;
+    unsigned int            i_transports;
+
+    snapshot_transport_t   *pp_hash[SNAPSHOT_HASH_SIZE];
+    snapshot_transport_t   *p_lru_first;    /* most recently used */
+    snapshot_transport_t   *p_lru_last;     /* least recently used */
+};
+
+/*****************************************************************************
+ * snapshot_Key / snapshot_Hash
+ *****************************************************************************/
+static inline uint32_t snapshot_Key(uint16_t i_onid, uint16_t i_tsid)
+{
+    return ((uint32_t)i_onid << 16) | i_tsid;
+}
+
+static inline unsigned int snapshot_Hash(uint32_t i_key)
+{
+    return ((i_key * UINT32_C(0x9e3779b1)) >> 26) & (SNAPSHOT_HASH_SIZE - 1);
+}
+
+/*****************************************************************************
+ * snapshot_Find
+ *****************************************************************************
+ * Find the entry of a transport stream.
+ *****************************************************************************/
+static snapshot_transport_t *snapshot_Find(const dvbpsi_snapshot_t *p_snap, uint32_t i_key)
+{
+    snapshot_transport_t *p_ts = p_snap->pp_hash[snapshot_Hash(i_key)];
+    while (p_ts && p_ts->i_key != i_key)
+        p_ts = p_ts->p_next_hash;
+    return p_ts;
+}
+
+/*****************************************************************************
+ * snapshot_Unlink / snapshot_Touch
+ *****************************************************************************
+ * LRU list handling.
+ *****************************************************************************/
+static void snapshot_Unlink(dvbpsi_snapshot_t *p_snap, snapshot_transport_t *p_ts)
+{
+    if (p_ts->p_prev_lru)
+        p_ts->p_prev_lru->p_next_lru = p_ts->p_next_lru;
+    else
+        p_snap->p_lru_first = p_ts->p_next_lru;
+    if (p_ts->p_next_lru)
+        p_ts->p_next_lru->p_prev_lru = p_ts->p_prev_lru;
+    else
+        p_snap->p_lru_last = p_ts->p_prev_lru;
+    p_ts->p_prev_lru = p_ts->p_next_lru = NULL;
+}
+
+static void snapshot_Touch(dvbpsi_snapshot_t *p_snap, snapshot_transport_t *p_ts)
+{
+    if (p_snap->p_lru_first == p_ts)
+        return;
+
+    if (p_ts->p_prev_lru || p_ts->p_next_lru || p_snap->p_lru_last == p_ts)
+        snapshot_Unlink(p_snap, p_ts);
+
+    p_ts->p_next_lru = p_snap->p_lru_first;
+    if (p_snap->p_lru_first)
+        p_snap->p_lru_first->p_prev_lru = p_ts;
+    p_snap->p_lru_first = p_ts;
+    if (p_snap->p_lru_last == NULL)
+        p_snap->p_lru_last = p_ts;
+}
+
+/*****************************************************************************
+ * snapshot_DeleteSections
+ *****************************************************************************/
+static void snapshot_DeleteSections(snapshot_section_t *p_section)
+{
+    while (p_section)
+    {
+        snapshot_section_t *p_next = p_section->p_next;
+        free(p_section);
+        p_section = p_next;
+    }
+}
+
+/*****************************************************************************
+ * snapshot_DeleteTransport
+ *****************************************************************************
+ * Unlink a transport stream from the cache and free it.
+ *****************************************************************************/
+static void snapshot_DeleteTransport(dvbpsi_snapshot_t *p_snap, snapshot_transport_t *p_ts)
+{
+    snapshot_transport_t **pp = &p_snap->pp_hash[snapshot_Hash(p_ts->i_key)];
+    while (*pp != p_ts)
+        pp = &(*pp)->p_next_hash;
+    *pp = p_ts->p_next_hash;
+
+    snapshot_Unlink(p_snap, p_ts);
+    snapshot_DeleteSections(p_ts->p_first_section);
+    free(p_ts);
+    p_snap->i_transports--;
+}
+
+/*****************************************************************************
+ * snapshot_NewTransport
+ *****************************************************************************
+ * Create the entry of a transport stream, drop the least recently used one
+ * if the cache is full.
+ *****************************************************************************/
+static snapshot_transport_t *snapshot_NewTransport(dvbpsi_snapshot_t *p_snap, uint32_t i_key)
+{
+    if (p_snap->i_max_transports && p_snap->i_transports >= p_snap->i_max_transports)
+        snapshot_DeleteTransport(p_snap, p_snap->p_lru_last);
+
+    snapshot_transport_t *p_ts = (snapshot_transport_t *)calloc(1, sizeof(snapshot_transport_t));
+    if (p_ts == NULL)
+        return NULL;
+
+    const unsigned int i_hash = snapshot_Hash(i_key);
+    p_ts->i_key = i_key;
+    p_ts->p_next_hash = p_snap->pp_hash[i_hash];
+    p_snap->pp_hash[i_hash] = p_ts;
+    p_snap->i_transports++;
+    snapshot_Touch(p_snap, p_ts);
+    return p_ts;
+}
+
+/*****************************************************************************
+ * snapshot_RemoveTable
+ *****************************************************************************
+ * Drop the sections of a table, optionally keeping one version.
+ *****************************************************************************/
+static void snapshot_RemoveTable(snapshot_transport_t *p_ts, uint16_t i_pid,
+                                 uint8_t i_table_id, uint16_t i_extension,
+                                 int i_keep_version)
+{
+    snapshot_section_t **pp = &p_ts->p_first_section;
+    while (*pp)
+    {
+        snapshot_section_t *p = *pp;
+        if (p->i_pid == i_pid && p->i_table_id == i_table_id &&
+            p->i_extension == i_extension && p->i_version != i_keep_version)
+        {
+            *pp = p->p_next;
+            free(p);
+        }
+        else
+            pp = &p->p_next;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_snapshot_new
+ *****************************************************************************/
+dvbpsi_snapshot_t *dvbpsi_snapshot_new(unsigned int i_max_transports)
+{
+    dvbpsi_snapshot_t *p_snap = (dvbpsi_snapshot_t *)calloc(1, sizeof(dvbpsi_snapshot_t));
+    if (p_snap == NULL)
+        return NULL;
+
+    p_snap->i_max_transports = i_max_transports;
+    return p_snap;
+}
+
+/*****************************************************************************
+ * dvbpsi_snapshot_delete
+ *****************************************************************************/
+void dvbpsi_snapshot_delete(dvbpsi_snapshot_t *p_snap)
+{
+    if (p_snap == NULL)
+        return;
+
+    while (p_snap->p_lru_first)
+        snapshot_DeleteTransport(p_snap, p_snap->p_lru_first);
+    free(p_snap);
+}
+
+/*****************************************************************************
+ * dvbpsi_snapshot_store
+ *****************************************************************************/
+bool dvbpsi_snapshot_store(dvbpsi_snapshot_t *p_snap, uint16_t i_onid, uint16_t i_tsid,
+                           uint16_t i_pid, const uint8_t *p_section, size_t i_length)
+{
+    assert(p_snap);
+    assert(p_section);
+
+    /* Complete long sections only, current_next_indicator set */
+    if (i_length < SNAPSHOT_MIN_SECTION || i_length > SNAPSHOT_MAX_SECTION ||
+        !(p_section[1] & 0x80) || !(p_section[5] & 0x01) ||
+        (size_t)((((p_section[1] & 0x0f) << 8) | p_section[2]) + 3) != i_length)
+        return false;
+
+    const uint8_t i_table_id = p_section[0];
+    const uint16_t i_extension = (p_section[3] << 8) | p_section[4];
+    const uint8_t i_version = (p_section[5] & 0x3e) >> 1;
+    const uint8_t i_number = p_section[6];
+    const uint32_t i_crc = ((uint32_t)p_section[i_length - 4] << 24) |
+                           ((uint32_t)p_section[i_length - 3] << 16) |
+                           ((uint32_t)p_section[i_length - 2] << 8) |
+                            (uint32_t)p_section[i_length - 1];
+
+    const uint32_t i_key = snapshot_Key(i_onid, i_tsid);
+    snapshot_transport_t *p_ts = snapshot_Find(p_snap, i_key);
+    if (p_ts == NULL)
+    {
+        p_ts = snapshot_NewTransport(p_snap, i_key);
+        if (p_ts == NULL)
+            return false;
+    }
+    else
+        snapshot_Touch(p_snap, p_ts);
+
+    /* Sections of another version are obsolete */
+    snapshot_RemoveTable(p_ts, i_pid, i_table_id, i_extension, i_version);
+
+    snapshot_section_t **pp = &p_ts->p_first_section;
+    while (*pp)
+    {
+        snapshot_section_t *p = *pp;
+        if (p->i_pid == i_pid && p->i_table_id == i_table_id &&
+            p->i_extension == i_extension && p->i_number == i_number)
+        {
+            /* Repetition of the cached section */
+            if (p->i_crc == i_crc && p->i_length == i_length &&
+                memcmp(p->p_data, p_section, i_length) == 0)
+                return true;
+            break;
+        }
+        pp = &p->p_next;
+    }
+
+    snapshot_section_t *p_new = (snapshot_section_t *)malloc(sizeof(snapshot_section_t) + i_length);
+    if (p_new == NULL)
+        return false;
+
+    p_new->i_pid = i_pid;
+    p_new->i_table_id = i_table_id;
+    p_new->i_extension = i_extension;
+    p_new->i_version = i_version;
+    p_new->i_number = i_number;
+    p_new->i_crc = i_crc;
+    p_new->i_length = i_length;
+    memcpy(p_new->p_data, p_section, i_length);
+
+    /* Replace in place to keep the order of the sections */
+    if (*pp)
+    {
+        p_new->p_next = (*pp)->p_next;
+        free(*pp);
+    }
+    else
+        p_new->p_next = NULL;
+    *pp = p_new;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_snapshot_lookup
+ *****************************************************************************/
+bool dvbpsi_snapshot_lookup(const dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                            uint16_t i_tsid, uint16_t i_pid, uint8_t i_table_id,
+                            uint16_t i_extension, uint8_t i_number,
+                            const uint8_t **pp_section, size_t *pi_length)
+{
+    assert(p_snap);
+    assert(pp_section);
+    assert(pi_length);
+
+    const snapshot_transport_t *p_ts = snapshot_Find(p_snap, snapshot_Key(i_onid, i_tsid));
+    if (p_ts == NULL)
+        return false;
+
+    for (const snapshot_section_t *p = p_ts->p_first_section; p; p = p->p_next)
+    {
+        if (p->i_pid == i_pid && p->i_table_id == i_table_id &&
+            p->i_extension == i_extension && p->i_number == i_number)
+        {
+            *pp_section = p->p_data;
+            *pi_length = p->i_length;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*****************************************************************************
+ * dvbpsi_snapshot_remove
+ *****************************************************************************/
+void dvbpsi_snapshot_remove(dvbpsi_snapshot_t *p_snap, uint16_t i_onid, uint16_t i_tsid,
+                            uint16_t i_pid, uint8_t i_table_id, uint16_t i_extension)
+{
+    assert(p_snap);
+
+    snapshot_transport_t *p_ts = snapshot_Find(p_snap, snapshot_Key(i_onid, i_tsid));
+    if (p_ts)
+        snapshot_RemoveTable(p_ts, i_pid, i_table_id, i_extension, -1);
+}
+
+/*****************************************************************************
+ * dvbpsi_snapshot_forget
+ *****************************************************************************/
+void dvbpsi_snapshot_forget(dvbpsi_snapshot_t *p_snap, uint16_t i_onid, uint16_t i_tsid)
+{
+    assert(p_snap);
+
+    snapshot_transport_t *p_ts = snapshot_Find(p_snap, snapshot_Key(i_onid, i_tsid));
+    if (p_ts)
+        snapshot_DeleteTransport(p_snap, p_ts);
+}
+
+/*****************************************************************************
+ * dvbpsi_snapshot_foreach
+ *****************************************************************************/
+unsigned int dvbpsi_snapshot_foreach(dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                                     uint16_t i_tsid, dvbpsi_snapshot_callback pf_callback,
+                                     void *p_cb_data)
+{
+    assert(p_snap);
+    assert(pf_callback);
+
+    snapshot_transport_t *p_ts = snapshot_Find(p_snap, snapshot_Key(i_onid, i_tsid));
+    if (p_ts == NULL)
+        return 0;
+
+    snapshot_Touch(p_snap, p_ts);
+
+    unsigned int i_count = 0;
+    for (const snapshot_section_t *p = p_ts->p_first_section; p; p = p->p_next)
+    {
+        pf_callback(p_cb_data, p->i_pid, p->p_data, p->i_length);
+        i_count++;
+    }
+    return i_count;
+}
@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * snapshot.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <snapshot.h>
+ * \brief Application interface for the PSI snapshot cache.
+ *
+ * The snapshot cache keeps the last known raw PSI sections of each transport
+ * stream, keyed by (original_network_id, transport_stream_id). It is used by
+ * the service discovery engine (discovery.h) to decode the PAT, PMTs and SDT
+ * of a transport stream as soon as it is tuned, before their next
+ * repetition. Only complete sections with section_syntax_indicator set and
+ * current_next_indicator set are kept, CRC_32 included.
+ */
+
+#ifndef _DVBPSI_SNAPSHOT_H_
+#define _DVBPSI_SNAPSHOT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * dvbpsi_snapshot_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_snapshot_s dvbpsi_snapshot_t
+ * \brief Opaque PSI snapshot cache handle.
+ */
+typedef struct dvbpsi_snapshot_s dvbpsi_snapshot_t;
+
+/*****************************************************************************
+ * dvbpsi_snapshot_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_snapshot_callback)(void *p_cb_data, uint16_t i_pid,
+                                              const uint8_t *p_section, size_t i_length)
+ * \brief Callback type definition for dvbpsi_snapshot_foreach().
+ *
+ * The callback must not modify the cache.
+ */
+typedef void (* dvbpsi_snapshot_callback)(void *p_cb_data, uint16_t i_pid,
+                                          const uint8_t *p_section, size_t i_length);
+
+/*****************************************************************************
+ * dvbpsi_snapshot_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_snapshot_t *dvbpsi_snapshot_new(unsigned int i_max_transports)
+ * \brief Create a PSI snapshot cache.
+ * \param i_max_transports number of transport streams kept, the least
+ * recently used one is dropped when the limit is reached, 0 for no limit
+ * \return pointer to the cache, NULL on error.
+ */
+dvbpsi_snapshot_t *dvbpsi_snapshot_new(unsigned int i_max_transports);
+
+/*****************************************************************************
+ * dvbpsi_snapshot_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_snapshot_delete(dvbpsi_snapshot_t *p_snap)
+ * \brief Destroy a PSI snapshot cache and all its sections.
+ * \param p_snap pointer to the cache
+ * \return nothing.
+ */
+void dvbpsi_snapshot_delete(dvbpsi_snapshot_t *p_snap);
+
+/*****************************************************************************
+ * dvbpsi_snapshot_store
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_snapshot_store(dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                                  uint16_t i_tsid, uint16_t i_pid,
+                                  const uint8_t *p_section, size_t i_length)
+ * \brief Store a raw PSI section.
+ * \param p_snap pointer to the cache
+ * \param i_onid original_network_id of the transport stream
+ * \param i_tsid transport_stream_id of the transport stream
+ * \param i_pid PID the section was received on
+ * \param p_section complete section, from table_id to CRC_32
+ * \param i_length length of the section
+ * \return true if the section is in the cache, false if it is not a valid
+ * current section or on allocation error.
+ *
+ * The section replaces the one with the same PID, table_id,
+ * table_id_extension and section_number. Sections of another version of
+ * the same table are dropped. Storing a section identical to the cached one
+ * is cheap, so every received section can be stored.
+ */
+bool dvbpsi_snapshot_store(dvbpsi_snapshot_t *p_snap, uint16_t i_onid, uint16_t i_tsid,
+                           uint16_t i_pid, const uint8_t *p_section, size_t i_length);
+
+/*****************************************************************************
+ * dvbpsi_snapshot_lookup
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_snapshot_lookup(const dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                        uint16_t i_tsid, uint16_t i_pid, uint8_t i_table_id,
+                        uint16_t i_extension, uint8_t i_number,
+                        const uint8_t **pp_section, size_t *pi_length)
+ * \brief Find a cached section.
+ * \param p_snap pointer to the cache
+ * \param i_onid original_network_id of the transport stream
+ * \param i_tsid transport_stream_id of the transport stream
+ * \param i_pid PID of the section
+ * \param i_table_id table_id of the section
+ * \param i_extension table_id_extension of the section
+ * \param i_number section_number of the section
+ * \param pp_section set to the cached section, valid until the cache is
+ * modified
+ * \param pi_length set to the length of the section
+ * \return true if the section was found.
+ */
+bool dvbpsi_snapshot_lookup(const dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                            uint16_t i_tsid, uint16_t i_pid, uint8_t i_table_id,
+                            uint16_t i_extension, uint8_t i_number,
+                            const uint8_t **pp_section, size_t *pi_length);
+
+/*****************************************************************************
+ * dvbpsi_snapshot_remove
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_snapshot_remove(dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                        uint16_t i_tsid, uint16_t i_pid, uint8_t i_table_id,
+                        uint16_t i_extension)
+ * \brief Drop all cached sections of a table.
+ * \param p_snap pointer to the cache
+ * \param i_onid original_network_id of the transport stream
+ * \param i_tsid transport_stream_id of the transport stream
+ * \param i_pid PID of the table
+ * \param i_table_id table_id of the table
+ * \param i_extension table_id_extension of the table
+ * \return nothing.
+ */
+void dvbpsi_snapshot_remove(dvbpsi_snapshot_t *p_snap, uint16_t i_onid, uint16_t i_tsid,
+                            uint16_t i_pid, uint8_t i_table_id, uint16_t i_extension);
+
+/*****************************************************************************
+ * dvbpsi_snapshot_forget
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_snapshot_forget(dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                                   uint16_t i_tsid)
+ * \brief Drop all cached sections of a transport stream.
+ * \param p_snap pointer to the cache
+ * \param i_onid original_network_id of the transport stream
+ * \param i_tsid transport_stream_id of the transport stream
+ * \return nothing.
+ */
+void dvbpsi_snapshot_forget(dvbpsi_snapshot_t *p_snap, uint16_t i_onid, uint16_t i_tsid);
+
+/*****************************************************************************
+ * dvbpsi_snapshot_foreach
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_snapshot_foreach(dvbpsi_snapshot_t *p_snap,
+                        uint16_t i_onid, uint16_t i_tsid,
+                        dvbpsi_snapshot_callback pf_callback, void *p_cb_data)
+ * \brief Call back for each cached section of a transport stream.
+ * \param p_snap pointer to the cache
+ * \param i_onid original_network_id of the transport stream
+ * \param i_tsid transport_stream_id of the transport stream
+ * \param pf_callback function to call back for each section
+ * \param p_cb_data private data given in argument to the callback
+ * \return number of sections.
+ *
+ * The transport stream becomes the most recently used one. Sections of a
+ * table are given in the order they were first stored.
+ */
+unsigned int dvbpsi_snapshot_foreach(dvbpsi_snapshot_t *p_snap, uint16_t i_onid,
+                                     uint16_t i_tsid, dvbpsi_snapshot_callback pf_callback,
+                                     void *p_cb_data);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of snapshot.h"
+#endif
@@ -0,0 +1,728 @@
+/*****************************************************************************
+ * splice.c: SCTE 35 splice scheduler
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "descriptor.h"
+#include "ts.h"
+#include "tables/sis.h"
+#include "splice.h"
+
+#define SPLICE_NULL_PID         0x1fff
+
+/* PTS values are 33 bits, PCR values wrap around after 2^33 * 300 ticks */
+#define SPLICE_PTS_MASK         UINT64_C(0x1ffffffff)
+#define SPLICE_PCR_WRAP         (UINT64_C(0x200000000) * 300)
+
+/* 27 MHz ticks per microsecond */
+#define SPLICE_TICKS_PER_US     27
+
+/* Number of spliced events remembered to ignore their repetitions */
+#define SPLICE_RECENT           32
+
+/*****************************************************************************
+ * splice_key_t
+ *****************************************************************************
+ * Identity and splice time of an event. splice_insert() events are
+ * identified by their splice_event_id, time_signal() events with a
+ * segmentation descriptor by their segmentation_event_id and
+ * segmentation_type_id, so that the start and the end of a segment are
+ * distinct, and other time_signal() events by their splice time only.
+ *****************************************************************************/
+typedef struct splice_key_s
+{
+    uint8_t     i_command_type;
+    bool        b_segmentation;         /* time_signal() with segmentation */
+    uint32_t    i_event_id;
+    uint8_t     i_segmentation_type_id;
+    bool        b_immediate;
+    uint64_t    i_pts;
+} splice_key_t;
+
+/*****************************************************************************
+ * splice_entry_t
+ *****************************************************************************
+ * One pending callback in the queue.
+ *****************************************************************************/
+typedef struct splice_entry_s
+{
+    int64_t                 i_deadline; /* unwrapped PCR timeline, 27 MHz */
+    int64_t                 i_offset;   /* from the splice time, 27 MHz */
+    uint64_t                i_seq;      /* keeps equal deadlines in order */
+    bool                    b_fixed;    /* deadline does not follow i_pts */
+    bool                    b_dead;     /* cancelled or replaced */
+    splice_key_t            key;        /* event the entry belongs to */
+    dvbpsi_splice_event_t   event;
+} splice_entry_t;
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_t
+ *****************************************************************************/
+struct dvbpsi_splice_scheduler_s
+{
+    dvbpsi_splice_config_t  config;
+
+    dvbpsi_splice_callback  pf_callback;
+    void                   *p_cb_data;
+
+    /* Clock */
+    bool            b_clock;        /* a PCR has been received */
+    uint64_t        i_pcr;          /* last PCR value */
+    int64_t         i_pcr_clock;    /* unwrapped clock of the last PCR */
+    int64_t         i_pcr_date;     /* arrival date of the last PCR */
+    int64_t         i_clock;        /* current clock, extrapolated */
+
+    /* Priority queue ordered by deadline (binary min heap) */
+    splice_entry_t *p_heap;
+    unsigned int    i_size;
+    unsigned int    i_alloc;
+    unsigned int    i_live;         /* entries that are not dead */
+    uint64_t        i_seq;
+
+    splice_key_t    recent[SPLICE_RECENT];  /* spliced events */
+    unsigned int    i_recent;
+};
+
+/*****************************************************************************
+ * dvbpsi_splice_config_default
+ *****************************************************************************/
+void dvbpsi_splice_config_default(dvbpsi_splice_config_t *p_config)
+{
+    assert(p_config);
+
+    p_config->i_pcr_pid = SPLICE_NULL_PID;
+    p_config->i_preroll = 4000000;              /* 4 s */
+    p_config->i_pcr_discontinuity = 1000000;    /* 1 s */
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_new
+ *****************************************************************************/
+dvbpsi_splice_scheduler_t *dvbpsi_splice_scheduler_new(const dvbpsi_splice_config_t *p_config,
+                                                       dvbpsi_splice_callback pf_callback,
+                                                       void *p_cb_data)
+{
+    assert(pf_callback);
+
+    dvbpsi_splice_scheduler_t *p_sched = calloc(1, sizeof(dvbpsi_splice_scheduler_t));
+    if (p_sched == NULL)
+        return NULL;
+
+    if (p_config)
+        p_sched->config = *p_config;
+    else
+        dvbpsi_splice_config_default(&p_sched->config);
+
+    p_sched->pf_callback = pf_callback;
+    p_sched->p_cb_data = p_cb_data;
+    return p_sched;
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_delete
+ *****************************************************************************/
+void dvbpsi_splice_scheduler_delete(dvbpsi_splice_scheduler_t *p_sched)
+{
+    if (p_sched == NULL)
+        return;
+    free(p_sched->p_heap);
+    free(p_sched);
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_set_pcr_pid
+ *****************************************************************************/
+void dvbpsi_splice_scheduler_set_pcr_pid(dvbpsi_splice_scheduler_t *p_sched,
+                                         uint16_t i_pcr_pid)
+{
+    assert(p_sched);
+    p_sched->config.i_pcr_pid = i_pcr_pid;
+}
+
+/*****************************************************************************
+ * Priority queue
+ *****************************************************************************/
+static inline bool splice_Before(const splice_entry_t *a, const splice_entry_t *b)
+{
+    if (a->i_deadline != b->i_deadline)
+        return a->i_deadline < b->i_deadline;
+    return a->i_seq < b->i_seq;
+}
+
+static void splice_SiftUp(splice_entry_t *p_heap, unsigned int i)
+{
+    while (i > 0)
+    {
+        unsigned int i_parent = (i - 1) / 2;
+        if (!splice_Before(&p_heap[i], &p_heap[i_parent]))
+            break;
+        splice_entry_t tmp = p_heap[i];
+        p_heap[i] = p_heap[i_parent];
+        p_heap[i_parent] = tmp;
+        i = i_parent;
+    }
+}
+
+static void splice_SiftDown(splice_entry_t *p_heap, unsigned int i_size, unsigned int i)
+{
+    for (;;)
+    {
+        unsigned int i_min = i;
+        unsigned int i_left = 2 * i + 1;
+        unsigned int i_right = i_left + 1;
+        if (i_left < i_size && splice_Before(&p_heap[i_left], &p_heap[i_min]))
+            i_min = i_left;
+        if (i_right < i_size && splice_Before(&p_heap[i_right], &p_heap[i_min]))
+            i_min = i_right;
+        if (i_min == i)
+            break;
+        splice_entry_t tmp = p_heap[i];
+        p_heap[i] = p_heap[i_min];
+        p_heap[i_min] = tmp;
+        i = i_min;
+    }
+}
+
+static bool splice_Reserve(dvbpsi_splice_scheduler_t *p_sched, unsigned int i_count)
+{
+    if (p_sched->i_size + i_count > p_sched->i_alloc)
+    {
+        unsigned int i_alloc = p_sched->i_alloc ? 2 * p_sched->i_alloc : 16;
+        while (i_alloc < p_sched->i_size + i_count)
+            i_alloc *= 2;
+        splice_entry_t *p_heap = realloc(p_sched->p_heap, i_alloc * sizeof(splice_entry_t));
+        if (p_heap == NULL)
+            return false;
+        p_sched->p_heap = p_heap;
+        p_sched->i_alloc = i_alloc;
+    }
+    return true;
+}
+
+static bool splice_Push(dvbpsi_splice_scheduler_t *p_sched, const splice_entry_t *p_entry)
+{
+    if (!splice_Reserve(p_sched, 1))
+        return false;
+
+    p_sched->p_heap[p_sched->i_size] = *p_entry;
+    p_sched->p_heap[p_sched->i_size].i_seq = p_sched->i_seq++;
+    splice_SiftUp(p_sched->p_heap, p_sched->i_size);
+    p_sched->i_size++;
+    p_sched->i_live++;
+    return true;
+}
+
+static void splice_Pop(dvbpsi_splice_scheduler_t *p_sched, splice_entry_t *p_entry)
+{
+    assert(p_sched->i_size > 0);
+
+    *p_entry = p_sched->p_heap[0];
+    p_sched->i_size--;
+    if (p_sched->i_size > 0)
+    {
+        p_sched->p_heap[0] = p_sched->p_heap[p_sched->i_size];
+        splice_SiftDown(p_sched->p_heap, p_sched->i_size, 0);
+    }
+    if (!p_entry->b_dead)
+        p_sched->i_live--;
+}
+
+/*****************************************************************************
+ * splice_Deadline
+ *****************************************************************************
+ * Map a 33 bits PTS on the unwrapped PCR timeline. A splice time is never
+ * more than 2^32 ticks (13 hours) away, so the nearest wrap is taken.
+ *****************************************************************************/
+static int64_t splice_Deadline(const dvbpsi_splice_scheduler_t *p_sched, uint64_t i_pts)
+{
+    uint64_t i_base = (p_sched->i_pcr / 300) & SPLICE_PTS_MASK;
+    int64_t i_delta = (int64_t)((i_pts - i_base) & SPLICE_PTS_MASK);
+    if (i_delta >= INT64_C(0x100000000))
+        i_delta -= INT64_C(0x200000000);
+
+    return p_sched->i_pcr_clock - (int64_t)(p_sched->i_pcr % 300) + i_delta * 300;
+}
+
+/*****************************************************************************
+ * splice_Rebase
+ *****************************************************************************
+ * Recompute the deadlines after the PCR timebase changed.
+ *****************************************************************************/
+static void splice_Rebase(dvbpsi_splice_scheduler_t *p_sched)
+{
+    for (unsigned int i = 0; i < p_sched->i_size; i++)
+    {
+        splice_entry_t *p_entry = &p_sched->p_heap[i];
+        if (p_entry->b_fixed)
+        {
+            if (p_entry->i_deadline == INT64_MIN)
+                continue;
+        }
+        else
+            p_entry->i_deadline = splice_Deadline(p_sched, p_entry->event.i_pts)
+                                + p_entry->i_offset;
+    }
+
+    for (unsigned int i = p_sched->i_size / 2; i-- > 0; )
+        splice_SiftDown(p_sched->p_heap, p_sched->i_size, i);
+}
+
+/*****************************************************************************
+ * splice_Advance
+ *****************************************************************************
+ * Extrapolate the clock from the last PCR to the given date.
+ *****************************************************************************/
+static void splice_Advance(dvbpsi_splice_scheduler_t *p_sched, int64_t i_date)
+{
+    if (!p_sched->b_clock || i_date <= p_sched->i_pcr_date)
+        return;
+
+    int64_t i_clock = p_sched->i_pcr_clock +
+                      (i_date - p_sched->i_pcr_date) * SPLICE_TICKS_PER_US;
+    if (i_clock > p_sched->i_clock)
+        p_sched->i_clock = i_clock;
+}
+
+/*****************************************************************************
+ * splice_SameTime/splice_SameEvent
+ *****************************************************************************
+ * Compare the splice times or the identities of two events.
+ *****************************************************************************/
+static inline bool splice_SameTime(const splice_key_t *a, const splice_key_t *b)
+{
+    if (a->b_immediate || b->b_immediate)
+        return a->b_immediate && b->b_immediate;
+    return a->i_pts == b->i_pts;
+}
+
+static bool splice_SameEvent(const splice_key_t *a, const splice_key_t *b)
+{
+    if (a->i_command_type != b->i_command_type ||
+        a->b_segmentation != b->b_segmentation)
+        return false;
+    if (a->i_command_type == 0x06 && !a->b_segmentation)
+        return splice_SameTime(a, b);
+    return a->i_event_id == b->i_event_id &&
+           a->i_segmentation_type_id == b->i_segmentation_type_id;
+}
+
+/*****************************************************************************
+ * splice_Remember/splice_IsRecent
+ *****************************************************************************
+ * Small history of spliced events to ignore repeated commands.
+ *****************************************************************************/
+static void splice_Remember(dvbpsi_splice_scheduler_t *p_sched, const splice_key_t *p_key)
+{
+    p_sched->recent[p_sched->i_recent % SPLICE_RECENT] = *p_key;
+    p_sched->i_recent++;
+}
+
+static bool splice_IsRecent(const dvbpsi_splice_scheduler_t *p_sched,
+                            const splice_key_t *p_key)
+{
+    unsigned int i_count = p_sched->i_recent < SPLICE_RECENT ?
+                           p_sched->i_recent : SPLICE_RECENT;
+    for (unsigned int i = 0; i < i_count; i++)
+    {
+        const splice_key_t *p_recent = &p_sched->recent[i];
+        if (splice_SameEvent(p_recent, p_key) && splice_SameTime(p_recent, p_key))
+            return true;
+    }
+    return false;
+}
+
+/*****************************************************************************
+ * splice_Fire
+ *****************************************************************************
+ * Call the application back for one event.
+ *****************************************************************************/
+static void splice_Fire(dvbpsi_splice_scheduler_t *p_sched, dvbpsi_splice_event_t *p_event,
+                        int64_t i_deadline)
+{
+    if (i_deadline == INT64_MIN)
+        i_deadline = p_sched->i_clock;
+
+    p_event->i_deadline = i_deadline;
+    p_event->i_date = p_sched->i_pcr_date +
+                      (i_deadline - p_sched->i_pcr_clock) / SPLICE_TICKS_PER_US;
+    p_event->i_late = p_sched->i_clock - i_deadline;
+
+    p_sched->pf_callback(p_sched->p_cb_data, p_event);
+}
+
+/*****************************************************************************
+ * splice_Run
+ *****************************************************************************
+ * Fire all events that are due.
+ *****************************************************************************/
+static void splice_Run(dvbpsi_splice_scheduler_t *p_sched)
+{
+    if (!p_sched->b_clock)
+        return;
+
+    while (p_sched->i_size > 0)
+    {
+        const splice_entry_t *p_top = &p_sched->p_heap[0];
+        if (!p_top->b_dead && p_top->i_deadline > p_sched->i_clock)
+            break;
+
+        splice_entry_t entry;
+        splice_Pop(p_sched, &entry);
+        if (entry.b_dead)
+            continue;
+
+        /* Schedule the end of the break before the callback may push new
+         * commands */
+        if (entry.event.i_action == DVBPSI_SPLICE_POINT)
+        {
+            splice_Remember(p_sched, &entry.key);
+
+            if (entry.event.b_out_of_network && entry.event.b_auto_return &&
+                entry.event.i_duration > 0)
+            {
+                splice_entry_t ret = entry;
+                int64_t i_start = (entry.i_deadline == INT64_MIN) ?
+                                  p_sched->i_clock : entry.i_deadline;
+                ret.event.i_action = DVBPSI_SPLICE_RETURN;
+                ret.b_fixed = true;
+                ret.i_offset = 0;
+                ret.i_deadline = i_start + (int64_t)entry.event.i_duration * 300;
+                if (entry.event.b_immediate)
+                    ret.event.i_pts = ((p_sched->i_pcr / 300) +
+                                       (i_start - p_sched->i_pcr_clock) / 300 +
+                                       entry.event.i_duration) & SPLICE_PTS_MASK;
+                else
+                    ret.event.i_pts = (entry.event.i_pts + entry.event.i_duration)
+                                      & SPLICE_PTS_MASK;
+                splice_Push(p_sched, &ret);
+            }
+        }
+
+        splice_Fire(p_sched, &entry.event, entry.i_deadline);
+    }
+}
+
+/*****************************************************************************
+ * splice_Kill
+ *****************************************************************************
+ * Mark the queued entries of an event as dead, returns the number of
+ * entries found and a copy of one of them. With b_cancel, every segment of
+ * a segmentation_event_id is killed, whatever its segmentation_type_id.
+ *****************************************************************************/
+static unsigned int splice_Kill(dvbpsi_splice_scheduler_t *p_sched, const splice_key_t *p_key,
+                                bool b_cancel, splice_entry_t *p_found)
+{
+    unsigned int i_found = 0;
+    for (unsigned int i = 0; i < p_sched->i_size; i++)
+    {
+        splice_entry_t *p_entry = &p_sched->p_heap[i];
+        if (p_entry->b_dead)
+            continue;
+        if (b_cancel ? (p_entry->key.i_command_type != p_key->i_command_type ||
+                        p_entry->key.b_segmentation != p_key->b_segmentation ||
+                        p_entry->key.i_event_id != p_key->i_event_id)
+                     : !splice_SameEvent(&p_entry->key, p_key))
+            continue;
+
+        /* Prefer reporting the first splice point itself */
+        if (i_found == 0 ||
+            (p_entry->event.i_action == DVBPSI_SPLICE_POINT &&
+             (p_found->event.i_action != DVBPSI_SPLICE_POINT ||
+              splice_Before(p_entry, p_found))))
+            *p_found = *p_entry;
+        p_entry->b_dead = true;
+        p_sched->i_live--;
+        i_found++;
+    }
+    return i_found;
+}
+
+/*****************************************************************************
+ * splice_Find
+ *****************************************************************************
+ * Find the queued splice point of an event.
+ *****************************************************************************/
+static const splice_entry_t *splice_Find(const dvbpsi_splice_scheduler_t *p_sched,
+                                         const splice_key_t *p_key)
+{
+    for (unsigned int i = 0; i < p_sched->i_size; i++)
+    {
+        const splice_entry_t *p_entry = &p_sched->p_heap[i];
+        if (!p_entry->b_dead &&
+            p_entry->event.i_action == DVBPSI_SPLICE_POINT &&
+            splice_SameEvent(&p_entry->key, p_key))
+            return p_entry;
+    }
+    return NULL;
+}
+
+/*****************************************************************************
+ * splice_Cancel
+ *****************************************************************************/
+static bool splice_Cancel(dvbpsi_splice_scheduler_t *p_sched, const splice_key_t *p_key)
+{
+    splice_entry_t found;
+    if (splice_Kill(p_sched, p_key, true, &found) == 0)
+        return false;
+
+    found.event.i_action = DVBPSI_SPLICE_CANCEL;
+    splice_Fire(p_sched, &found.event, found.i_deadline);
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_pcr_push
+ *****************************************************************************/
+void dvbpsi_splice_scheduler_pcr_push(dvbpsi_splice_scheduler_t *p_sched,
+                                      uint64_t i_pcr, bool b_discontinuity,
+                                      int64_t i_date)
+{
+    assert(p_sched);
+
+    i_pcr %= SPLICE_PCR_WRAP;
+
+    if (!p_sched->b_clock)
+    {
+        p_sched->b_clock = true;
+        p_sched->i_pcr = i_pcr;
+        p_sched->i_pcr_clock = (int64_t)i_pcr;
+        p_sched->i_pcr_date = i_date;
+        p_sched->i_clock = p_sched->i_pcr_clock;
+        splice_Rebase(p_sched);
+        splice_Run(p_sched);
+        return;
+    }
+
+    int64_t i_delta = (int64_t)((i_pcr + SPLICE_PCR_WRAP - p_sched->i_pcr) % SPLICE_PCR_WRAP);
+    if (i_delta >= (int64_t)(SPLICE_PCR_WRAP / 2))
+        i_delta -= (int64_t)SPLICE_PCR_WRAP;
+
+    if (b_discontinuity || i_delta < 0 ||
+        i_delta > p_sched->config.i_pcr_discontinuity * SPLICE_TICKS_PER_US)
+    {
+        /* New timebase: keep the clock running and map the splice times
+         * of the queued events on the new PCR values */
+        splice_Advance(p_sched, i_date);
+        p_sched->i_pcr = i_pcr;
+        p_sched->i_pcr_clock = p_sched->i_clock;
+        p_sched->i_pcr_date = i_date;
+        splice_Rebase(p_sched);
+    }
+    else
+    {
+        p_sched->i_pcr = i_pcr;
+        p_sched->i_pcr_clock += i_delta;
+        p_sched->i_pcr_date = i_date;
+        if (p_sched->i_pcr_clock > p_sched->i_clock)
+            p_sched->i_clock = p_sched->i_pcr_clock;
+    }
+
+    splice_Run(p_sched);
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_packet_push
+ *****************************************************************************/
+void dvbpsi_splice_scheduler_packet_push(dvbpsi_splice_scheduler_t *p_sched,
+                                         const uint8_t *p_data, int64_t i_date)
+{
+    assert(p_sched);
+    assert(p_data);
+
+    if (dvbpsi_ts_pid(p_data) == p_sched->config.i_pcr_pid &&
+        dvbpsi_ts_has_adaptation_field(p_data))
+    {
+        dvbpsi_ts_adaptation_field_t af;
+        if (dvbpsi_ts_adaptation_field_decode(p_data, &af) && af.b_pcr)
+        {
+            dvbpsi_splice_scheduler_pcr_push(p_sched, af.i_pcr,
+                                             af.b_discontinuity, i_date);
+            return;
+        }
+    }
+
+    dvbpsi_splice_scheduler_check(p_sched, i_date);
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_check
+ *****************************************************************************/
+void dvbpsi_splice_scheduler_check(dvbpsi_splice_scheduler_t *p_sched, int64_t i_date)
+{
+    assert(p_sched);
+
+    splice_Advance(p_sched, i_date);
+    if (p_sched->i_size > 0 && p_sched->p_heap[0].i_deadline <= p_sched->i_clock)
+        splice_Run(p_sched);
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_sis_push
+ *****************************************************************************/
+bool dvbpsi_splice_scheduler_sis_push(dvbpsi_splice_scheduler_t *p_sched,
+                                      const dvbpsi_sis_t *p_sis)
+{
+    assert(p_sched);
+    assert(p_sis);
+
+    if (!p_sis->b_splice_command_valid || p_sis->p_splice_command == NULL)
+        return false;
+
+    splice_entry_t entry;
+    memset(&entry, 0, sizeof(splice_entry_t));
+    dvbpsi_splice_event_t *p_event = &entry.event;
+    splice_key_t *p_key = &entry.key;
+    const dvbpsi_sis_splice_time_t *p_time = NULL;
+
+    p_event->i_command_type = p_sis->i_splice_command_type;
+    p_key->i_command_type = p_sis->i_splice_command_type;
+    switch (p_sis->i_splice_command_type)
+    {
+        case 0x05: /* splice_insert */
+        {
+            const dvbpsi_sis_cmd_splice_insert_t *p_insert = p_sis->p_splice_command;
+
+            p_event->i_event_id = p_insert->i_splice_event_id;
+            p_key->i_event_id = p_insert->i_splice_event_id;
+            if (p_insert->b_splice_event_cancel_indicator)
+                return splice_Cancel(p_sched, p_key);
+
+            p_event->b_out_of_network = p_insert->b_out_of_network_indicator;
+            p_event->b_immediate = p_insert->b_splice_immediate_flag;
+            if (p_insert->b_program_splice_flag)
+                p_time = p_insert->p_splice_time;
+            else if (p_insert->p_data)
+                /* Component splice: the first component leads */
+                p_time = p_insert->p_data->p_splice_time;
+            if (p_insert->p_break_duration)
+            {
+                p_event->i_duration = p_insert->p_break_duration->i_duration;
+                p_event->b_auto_return = p_insert->p_break_duration->b_auto_return;
+            }
+            p_event->i_unique_program_id = p_insert->i_unique_program_id;
+            p_event->i_avail_num = p_insert->i_avail_num;
+            p_event->i_avails_expected = p_insert->i_avails_expected;
+            break;
+        }
+        case 0x06: /* time_signal */
+        {
+            const dvbpsi_sis_cmd_time_signal_t *p_signal = p_sis->p_splice_command;
+
+            p_time = p_signal->p_splice_time;
+            if (p_sis->i_segmentation_count > 0)
+            {
+                const dvbpsi_sis_segmentation_t *p_seg = &p_sis->segmentation[0];
+                p_event->i_event_id = p_seg->i_segmentation_event_id;
+                p_key->b_segmentation = true;
+                p_key->i_event_id = p_seg->i_segmentation_event_id;
+                if (p_seg->b_segmentation_event_cancel_indicator)
+                    return splice_Cancel(p_sched, p_key);
+                p_event->i_segmentation_type_id = p_seg->i_segmentation_type_id;
+                p_key->i_segmentation_type_id = p_seg->i_segmentation_type_id;
+                p_event->i_duration = p_seg->i_segmentation_duration;
+            }
+            /* time_signal() without a time is immediate */
+            p_event->b_immediate = (p_time == NULL || !p_time->b_time_specified_flag);
+            break;
+        }
+        default:
+            return false;
+    }
+
+    if (!p_event->b_immediate)
+    {
+        if (p_time == NULL || !p_time->b_time_specified_flag)
+            return false;
+        p_event->i_pts = (p_time->i_pts_time + p_sis->i_pts_adjustment) & SPLICE_PTS_MASK;
+    }
+    p_key->b_immediate = p_event->b_immediate;
+    p_key->i_pts = p_event->i_pts;
+
+    /* Repetitions */
+    if (splice_IsRecent(p_sched, p_key))
+        return false;
+    const splice_entry_t *p_queued = splice_Find(p_sched, p_key);
+    if (p_queued && splice_SameTime(&p_queued->key, p_key))
+        return false;
+
+    /* Room for the preroll and the splice point, so that the preroll is
+     * never queued alone */
+    if (!splice_Reserve(p_sched, 2))
+        return false;
+
+    if (p_queued)
+    {
+        /* New splice time for the same event */
+        splice_entry_t old;
+        splice_Kill(p_sched, p_key, false, &old);
+    }
+
+    if (p_event->b_immediate)
+    {
+        entry.b_fixed = true;
+        entry.i_deadline = p_sched->b_clock ? p_sched->i_clock : INT64_MIN;
+    }
+    else if (p_sched->config.i_preroll > 0)
+    {
+        entry.i_offset = -p_sched->config.i_preroll * SPLICE_TICKS_PER_US;
+        entry.i_deadline = p_sched->b_clock ? splice_Deadline(p_sched, p_event->i_pts)
+                                              + entry.i_offset : INT64_MAX;
+        p_event->i_action = DVBPSI_SPLICE_PREROLL;
+        splice_Push(p_sched, &entry);
+    }
+
+    p_event->i_action = DVBPSI_SPLICE_POINT;
+    if (!entry.b_fixed)
+    {
+        entry.i_offset = 0;
+        entry.i_deadline = p_sched->b_clock ? splice_Deadline(p_sched, p_event->i_pts)
+                                            : INT64_MAX;
+    }
+    splice_Push(p_sched, &entry);
+
+    splice_Run(p_sched);
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_pending
+ *****************************************************************************/
+unsigned int dvbpsi_splice_scheduler_pending(const dvbpsi_splice_scheduler_t *p_sched)
+{
+    assert(p_sched);
+    return p_sched->i_live;
+}
@@ -0,0 +1,301 @@
+/*****************************************************************************
+ * splice.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <splice.h>
+ * \brief Application interface for the SCTE 35 splice scheduler.
+ *
+ * The splice scheduler turns decoded SCTE 35 splice_insert() and
+ * time_signal() commands into deadlines on the PCR timeline of the program.
+ * It follows the PCR of the program, applies pts_adjustment and the 33 bits
+ * wrap around of PTS values and reports each splice point by callback, once
+ * a configurable preroll before the splice point and once at the splice
+ * point itself. Out of network breaks with auto_return set are ended by a
+ * return callback after their break_duration.
+ *
+ * splice_schedule() commands use UTC times and are not handled here.
+ *
+ * dvbpsi.h, descriptor.h and tables/sis.h must be included before this file.
+ * All dates are expressed in microseconds.
+ */
+
+#ifndef _DVBPSI_SPLICE_H_
+#define _DVBPSI_SPLICE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * dvbpsi_splice_action_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_splice_action_e
+ * \brief Reason of a splice scheduler callback.
+ */
+/*!
+ * \typedef enum dvbpsi_splice_action_e dvbpsi_splice_action_t
+ * \brief dvbpsi_splice_action_t type definition.
+ */
+typedef enum dvbpsi_splice_action_e
+{
+    DVBPSI_SPLICE_PREROLL = 0,  /*!< the splice point is one preroll away */
+    DVBPSI_SPLICE_POINT,        /*!< the splice point is reached */
+    DVBPSI_SPLICE_RETURN,       /*!< end of an auto_return break */
+    DVBPSI_SPLICE_CANCEL,       /*!< a queued splice event has been cancelled */
+} dvbpsi_splice_action_t;
+
+/*****************************************************************************
+ * dvbpsi_splice_event_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_splice_event_s
+ * \brief Scheduled splice event.
+ *
+ * This structure is given to the callback, it is only valid for the duration
+ * of the callback.
+ */
+/*!
+ * \typedef struct dvbpsi_splice_event_s dvbpsi_splice_event_t
+ * \brief dvbpsi_splice_event_t type definition.
+ */
+typedef struct dvbpsi_splice_event_s
+{
+    dvbpsi_splice_action_t i_action;        /*!< reason of the callback */
+    uint8_t     i_command_type;             /*!< splice_command_type, 0x05 or 0x06 */
+    uint32_t    i_event_id;                 /*!< splice_event_id, or the
+                                                 segmentation_event_id of the
+                                                 first segmentation descriptor
+                                                 of a time_signal() */
+    bool        b_out_of_network;           /*!< out_of_network_indicator */
+    bool        b_immediate;                /*!< splice_immediate_flag */
+    uint64_t    i_pts;                      /*!< splice time with pts_adjustment
+                                                 applied (33 bits, 90 kHz), the
+                                                 return time for
+                                                 DVBPSI_SPLICE_RETURN */
+    uint64_t    i_duration;                 /*!< break_duration or
+                                                 segmentation_duration (90 kHz),
+                                                 0 if absent */
+    bool        b_auto_return;              /*!< auto_return of break_duration */
+    uint8_t     i_segmentation_type_id;     /*!< segmentation_type_id of the first
+                                                 segmentation descriptor, 0 if none */
+    uint16_t    i_unique_program_id;        /*!< unique_program_id */
+    uint8_t     i_avail_num;                /*!< avail_num */
+    uint8_t     i_avails_expected;          /*!< avails_expected */
+
+    int64_t     i_deadline;                 /*!< deadline on the unwrapped PCR
+                                                 timeline (27 MHz) */
+    int64_t     i_date;                     /*!< estimated date of the deadline */
+    int64_t     i_late;                     /*!< clock at callback time minus
+                                                 deadline (27 MHz), measures
+                                                 the scheduling accuracy */
+} dvbpsi_splice_event_t;
+
+/*****************************************************************************
+ * dvbpsi_splice_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_splice_callback)(void *p_cb_data,
+                                            const dvbpsi_splice_event_t *p_event)
+ * \brief Callback type definition.
+ */
+typedef void (* dvbpsi_splice_callback)(void *p_cb_data,
+                                        const dvbpsi_splice_event_t *p_event);
+
+/*****************************************************************************
+ * dvbpsi_splice_config_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_splice_config_s
+ * \brief Splice scheduler configuration.
+ */
+/*!
+ * \typedef struct dvbpsi_splice_config_s dvbpsi_splice_config_t
+ * \brief dvbpsi_splice_config_t type definition.
+ */
+typedef struct dvbpsi_splice_config_s
+{
+    uint16_t    i_pcr_pid;          /*!< PCR_PID of the program, 0x1fff if
+                                         PCRs are given with
+                                         dvbpsi_splice_scheduler_pcr_push() */
+    int64_t     i_preroll;          /*!< preroll in microseconds (4 s), 0
+                                         disables DVBPSI_SPLICE_PREROLL */
+    int64_t     i_pcr_discontinuity;/*!< PCR jumps larger than this are handled
+                                         as a timebase discontinuity (1 s) */
+} dvbpsi_splice_config_t;
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_splice_scheduler_s dvbpsi_splice_scheduler_t
+ * \brief Opaque splice scheduler handle.
+ */
+typedef struct dvbpsi_splice_scheduler_s dvbpsi_splice_scheduler_t;
+
+/*****************************************************************************
+ * dvbpsi_splice_config_default
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_splice_config_default(dvbpsi_splice_config_t *p_config)
+ * \brief Fill in the default splice scheduler configuration.
+ * \param p_config pointer to the configuration to initialize
+ * \return nothing.
+ */
+void dvbpsi_splice_config_default(dvbpsi_splice_config_t *p_config);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_splice_scheduler_t *dvbpsi_splice_scheduler_new(
+                        const dvbpsi_splice_config_t *p_config,
+                        dvbpsi_splice_callback pf_callback, void *p_cb_data)
+ * \brief Create a splice scheduler for one program.
+ * \param p_config configuration to use, NULL for the defaults
+ * \param pf_callback function to call back on each splice event
+ * \param p_cb_data private data given in argument to the callback
+ * \return pointer to the scheduler, NULL on error.
+ */
+dvbpsi_splice_scheduler_t *dvbpsi_splice_scheduler_new(const dvbpsi_splice_config_t *p_config,
+                                                       dvbpsi_splice_callback pf_callback,
+                                                       void *p_cb_data);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_splice_scheduler_delete(dvbpsi_splice_scheduler_t *p_sched)
+ * \brief Destroy a splice scheduler, pending events are dropped silently.
+ * \param p_sched pointer to the scheduler
+ * \return nothing.
+ */
+void dvbpsi_splice_scheduler_delete(dvbpsi_splice_scheduler_t *p_sched);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_set_pcr_pid
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_splice_scheduler_set_pcr_pid(dvbpsi_splice_scheduler_t *p_sched,
+                                                uint16_t i_pcr_pid)
+ * \brief Change the PCR_PID followed by the scheduler, e.g. on a new PMT.
+ * \param p_sched pointer to the scheduler
+ * \param i_pcr_pid new PCR_PID
+ * \return nothing.
+ */
+void dvbpsi_splice_scheduler_set_pcr_pid(dvbpsi_splice_scheduler_t *p_sched,
+                                         uint16_t i_pcr_pid);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_packet_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_splice_scheduler_packet_push(dvbpsi_splice_scheduler_t *p_sched,
+                                                const uint8_t *p_data, int64_t i_date)
+ * \brief Inject one TS packet of the transport stream.
+ * \param p_sched pointer to the scheduler
+ * \param p_data pointer to a 188 bytes TS packet
+ * \param i_date arrival date of the packet
+ * \return nothing.
+ *
+ * PCRs are taken from the packets of the PCR_PID. Between two PCRs the clock
+ * is extrapolated from the arrival dates, so that deadlines are met with
+ * the accuracy of the dates rather than the PCR interval. Due events are
+ * fired from this function.
+ */
+void dvbpsi_splice_scheduler_packet_push(dvbpsi_splice_scheduler_t *p_sched,
+                                         const uint8_t *p_data, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_pcr_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_splice_scheduler_pcr_push(dvbpsi_splice_scheduler_t *p_sched,
+                           uint64_t i_pcr, bool b_discontinuity, int64_t i_date)
+ * \brief Inject a PCR value decoded by the application.
+ * \param p_sched pointer to the scheduler
+ * \param i_pcr program_clock_reference in 27 MHz units
+ * \param b_discontinuity discontinuity_indicator of the adaptation field
+ * \param i_date arrival date of the PCR
+ * \return nothing.
+ */
+void dvbpsi_splice_scheduler_pcr_push(dvbpsi_splice_scheduler_t *p_sched,
+                                      uint64_t i_pcr, bool b_discontinuity,
+                                      int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_sis_push
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_splice_scheduler_sis_push(dvbpsi_splice_scheduler_t *p_sched,
+                                             const dvbpsi_sis_t *p_sis)
+ * \brief Schedule the splice command of a decoded splice_info_section.
+ * \param p_sched pointer to the scheduler
+ * \param p_sis decoded SIS, it is not referenced after the call
+ * \return true if the command was queued or cancelled a queued event,
+ * false if it was ignored (unsupported, invalid or repeated command).
+ *
+ * splice_insert() events are identified by their splice_event_id and
+ * time_signal() events with a segmentation descriptor by their
+ * segmentation_event_id and segmentation_type_id; other time_signal()
+ * events are only identified by their splice time. Repetitions of a splice
+ * event that is already queued or has already been spliced are ignored. A
+ * repetition of an identified event with a different splice time replaces
+ * the queued event. A cancelled segmentation_event_id cancels all its
+ * segmentation types, with one DVBPSI_SPLICE_CANCEL callback.
+ */
+bool dvbpsi_splice_scheduler_sis_push(dvbpsi_splice_scheduler_t *p_sched,
+                                      const dvbpsi_sis_t *p_sis);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_check
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_splice_scheduler_check(dvbpsi_splice_scheduler_t *p_sched,
+                                          int64_t i_date)
+ * \brief Fire the events that are due at the given date.
+ * \param p_sched pointer to the scheduler
+ * \param i_date current date
+ * \return nothing.
+ *
+ * Events are fired when packets are pushed, an application that wants
+ * callbacks between packets should call this function from a timer.
+ */
+void dvbpsi_splice_scheduler_check(dvbpsi_splice_scheduler_t *p_sched, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_splice_scheduler_pending
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_splice_scheduler_pending(const dvbpsi_splice_scheduler_t *p_sched)
+ * \brief Number of queued callbacks.
+ * \param p_sched pointer to the scheduler
+ * \return number of callbacks that have not been fired yet.
+ */
+unsigned int dvbpsi_splice_scheduler_pending(const dvbpsi_splice_scheduler_t *p_sched);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of splice.h"
+#endif
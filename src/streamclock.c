@@ -0,0 +1,359 @@
+/*****************************************************************************
+ * streamclock.c: time conversions and stream clock
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "descriptor.h"
+#include "tables/tot.h"
+#include "tables/atsc_stt.h"
+#include "streamclock.h"
+
+#define MJD_UNIX_EPOCH      40587       /* MJD of 1970-01-01 */
+#define SECONDS_PER_DAY     86400
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_s
+ *****************************************************************************/
+struct dvbpsi_stream_clock_s
+{
+    bool        b_set;
+    int64_t     i_time;             /* unix time of the last table */
+    int64_t     i_date;             /* date at which it was received */
+    uint8_t     i_gps_utc_offset;
+
+    /* Selected entry of the local_time_offset_descriptor */
+    bool        b_country;
+    uint8_t     p_country[3];
+    int         i_region;
+
+    bool        b_offset;
+    int32_t     i_offset;           /* seconds */
+    int64_t     i_time_of_change;   /* unix time */
+    int32_t     i_next_offset;      /* seconds */
+};
+
+/*****************************************************************************
+ * time_Bcd
+ *****************************************************************************
+ * Convert a binary value below 100 to two BCD digits. (v * 205) >> 11 is
+ * v / 10 for v < 1029.
+ *****************************************************************************/
+static inline uint32_t time_Bcd(uint32_t i_value)
+{
+    return i_value + ((i_value * 205) >> 11) * 6;
+}
+
+/*****************************************************************************
+ * time_FloorDiv
+ *****************************************************************************/
+static inline int64_t time_FloorDiv(int64_t i_num, int64_t i_den)
+{
+    int64_t i_quot = i_num / i_den;
+    return i_quot - ((i_num % i_den) < 0);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_bcd_to_seconds
+ *****************************************************************************
+ * The three pairs of digits are converted at once: each byte of
+ * tens * 10 + units stays below 100.
+ *****************************************************************************/
+uint32_t dvbpsi_time_bcd_to_seconds(uint32_t i_bcd)
+{
+    uint32_t i_bin = ((i_bcd >> 4) & 0x0f0f0f) * 10 + (i_bcd & 0x0f0f0f);
+    return (i_bin >> 16) * 3600 + ((i_bin >> 8) & 0xff) * 60 + (i_bin & 0xff);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_seconds_to_bcd
+ *****************************************************************************
+ * Two BCD digits of hours go up to 99:59:59, longer durations are clamped.
+ *****************************************************************************/
+uint32_t dvbpsi_time_seconds_to_bcd(uint32_t i_seconds)
+{
+    if (i_seconds > 99 * 3600 + 59 * 60 + 59)
+        return 0x995959;
+
+    uint32_t i_hours = i_seconds / 3600;
+    uint32_t i_rest = i_seconds - i_hours * 3600;
+    uint32_t i_minutes = i_rest / 60;
+    return time_Bcd(i_hours) << 16 | time_Bcd(i_minutes) << 8
+         | time_Bcd(i_rest - i_minutes * 60);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_dvb_to_unix
+ *****************************************************************************/
+int64_t dvbpsi_time_dvb_to_unix(uint64_t i_dvb_time)
+{
+    int64_t i_days = (int64_t)((i_dvb_time >> 24) & 0xffff) - MJD_UNIX_EPOCH;
+    return i_days * SECONDS_PER_DAY + dvbpsi_time_bcd_to_seconds(i_dvb_time & 0xffffff);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_unix_to_dvb
+ *****************************************************************************/
+uint64_t dvbpsi_time_unix_to_dvb(int64_t i_time)
+{
+    int64_t i_days = time_FloorDiv(i_time, SECONDS_PER_DAY);
+    uint32_t i_seconds = (uint32_t)(i_time - i_days * SECONDS_PER_DAY);
+    return (uint64_t)((i_days + MJD_UNIX_EPOCH) & 0xffff) << 24
+         | dvbpsi_time_seconds_to_bcd(i_seconds);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_gps_to_unix
+ *****************************************************************************/
+int64_t dvbpsi_time_gps_to_unix(uint32_t i_gps_time, uint8_t i_gps_utc_offset)
+{
+    return DVBPSI_TIME_GPS_EPOCH + i_gps_time - i_gps_utc_offset;
+}
+
+/*****************************************************************************
+ * dvbpsi_time_unix_to_gps
+ *****************************************************************************/
+uint32_t dvbpsi_time_unix_to_gps(int64_t i_time, uint8_t i_gps_utc_offset)
+{
+    return (uint32_t)(i_time - DVBPSI_TIME_GPS_EPOCH + i_gps_utc_offset);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_mjd_to_date
+ *****************************************************************************
+ * Proleptic Gregorian calendar with years starting in March, so that the
+ * leap day is the last day of the year. MJD 0 is 1858-11-17, day 678881 of
+ * this calendar counted from 0000-03-01.
+ *****************************************************************************/
+void dvbpsi_time_mjd_to_date(uint16_t i_mjd, int *pi_year, int *pi_month, int *pi_day)
+{
+    uint32_t i_days = (uint32_t)i_mjd + 678881;
+    uint32_t i_era = i_days / 146097;
+    uint32_t i_doe = i_days - i_era * 146097;                       /* [0, 146096] */
+    uint32_t i_yoe = (i_doe - i_doe / 1460 + i_doe / 36524 - i_doe / 146096) / 365;
+    uint32_t i_doy = i_doe - (365 * i_yoe + i_yoe / 4 - i_yoe / 100); /* [0, 365] */
+    uint32_t i_mp = (5 * i_doy + 2) / 153;                          /* March = 0 */
+    int i_month = (int)i_mp + 3 - 12 * (i_mp >= 10);
+
+    *pi_day = (int)(i_doy - (153 * i_mp + 2) / 5 + 1);
+    *pi_month = i_month;
+    *pi_year = (int)(i_yoe + i_era * 400) + (i_month <= 2);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_date_to_mjd
+ *****************************************************************************/
+uint16_t dvbpsi_time_date_to_mjd(int i_year, int i_month, int i_day)
+{
+    uint32_t i_y = (uint32_t)(i_year - (i_month <= 2));
+    uint32_t i_era = i_y / 400;
+    uint32_t i_yoe = i_y - i_era * 400;
+    uint32_t i_mp = (uint32_t)(i_month + 9 - 12 * (i_month > 2));   /* March = 0 */
+    uint32_t i_doy = (153 * i_mp + 2) / 5 + (uint32_t)i_day - 1;
+    uint32_t i_doe = i_yoe * 365 + i_yoe / 4 - i_yoe / 100 + i_doy;
+    return (uint16_t)(i_era * 146097 + i_doe - 678881);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_dvb_to_unix_batch
+ *****************************************************************************/
+void dvbpsi_time_dvb_to_unix_batch(const uint64_t *p_dvb_times, int64_t *p_times,
+                                   size_t i_count)
+{
+    for (size_t i = 0; i < i_count; i++)
+        p_times[i] = dvbpsi_time_dvb_to_unix(p_dvb_times[i]);
+}
+
+/*****************************************************************************
+ * dvbpsi_time_bcd_to_seconds_batch
+ *****************************************************************************/
+void dvbpsi_time_bcd_to_seconds_batch(const uint32_t *p_bcd, uint32_t *p_seconds,
+                                      size_t i_count)
+{
+    for (size_t i = 0; i < i_count; i++)
+        p_seconds[i] = dvbpsi_time_bcd_to_seconds(p_bcd[i]);
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_new
+ *****************************************************************************/
+dvbpsi_stream_clock_t *dvbpsi_stream_clock_new(void)
+{
+    dvbpsi_stream_clock_t *p_clock = calloc(1, sizeof(dvbpsi_stream_clock_t));
+    if (!p_clock)
+        return NULL;
+    p_clock->i_region = -1;
+    return p_clock;
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_delete
+ *****************************************************************************/
+void dvbpsi_stream_clock_delete(dvbpsi_stream_clock_t *p_clock)
+{
+    free(p_clock);
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_set_region
+ *****************************************************************************/
+void dvbpsi_stream_clock_set_region(dvbpsi_stream_clock_t *p_clock,
+                                    const uint8_t *p_country_code, int i_region_id)
+{
+    p_clock->b_country = p_country_code != NULL;
+    if (p_country_code)
+        memcpy(p_clock->p_country, p_country_code, 3);
+    p_clock->i_region = i_region_id < 0 ? -1 : i_region_id;
+}
+
+/*****************************************************************************
+ * clock_LocalTimeOffset
+ *****************************************************************************
+ * Read the selected entry of the local_time_offset_descriptors (13 bytes
+ * per entry).
+ *****************************************************************************/
+static void clock_LocalTimeOffset(dvbpsi_stream_clock_t *p_clock,
+                                  const dvbpsi_descriptor_t *p_dr)
+{
+    for (; p_dr; p_dr = p_dr->p_next)
+    {
+        if (p_dr->i_tag != 0x58)
+            continue;
+        for (unsigned int i = 0; i + 13 <= p_dr->i_length; i += 13)
+        {
+            const uint8_t *p_data = p_dr->p_data + i;
+            int i_region = (p_data[3] >> 2) & 0x3f;
+            if (p_clock->b_country && (memcmp(p_data, p_clock->p_country, 3)
+             || (p_clock->i_region >= 0 && i_region != p_clock->i_region)))
+                continue;
+
+            /* polarity 1: west of Greenwich */
+            int32_t i_sign = (p_data[3] & 0x01) ? -1 : 1;
+            uint64_t i_change = (uint64_t)p_data[6] << 32 | (uint64_t)p_data[7] << 24
+                              | (uint64_t)p_data[8] << 16 | (uint64_t)p_data[9] << 8
+                              | p_data[10];
+            p_clock->i_offset = i_sign * (int32_t)dvbpsi_time_bcd_to_seconds(
+                                    (uint32_t)(p_data[4] << 16 | p_data[5] << 8));
+            p_clock->i_next_offset = i_sign * (int32_t)dvbpsi_time_bcd_to_seconds(
+                                    (uint32_t)(p_data[11] << 16 | p_data[12] << 8));
+            p_clock->i_time_of_change = dvbpsi_time_dvb_to_unix(i_change);
+            p_clock->b_offset = true;
+            return;
+        }
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_update_tot
+ *****************************************************************************/
+void dvbpsi_stream_clock_update_tot(dvbpsi_stream_clock_t *p_clock,
+                                    const dvbpsi_tot_t *p_tot, int64_t i_date)
+{
+    p_clock->i_time = dvbpsi_time_dvb_to_unix(p_tot->i_utc_time);
+    p_clock->i_date = i_date;
+    p_clock->b_set = true;
+
+    if (p_tot->i_table_id == 0x73)
+        clock_LocalTimeOffset(p_clock, p_tot->p_first_descriptor);
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_update_stt
+ *****************************************************************************/
+void dvbpsi_stream_clock_update_stt(dvbpsi_stream_clock_t *p_clock,
+                                    const dvbpsi_atsc_stt_t *p_stt, int64_t i_date)
+{
+    p_clock->i_gps_utc_offset = p_stt->i_gps_utc_offset;
+    p_clock->i_time = dvbpsi_time_gps_to_unix(p_stt->i_system_time, p_stt->i_gps_utc_offset);
+    p_clock->i_date = i_date;
+    p_clock->b_set = true;
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_utc
+ *****************************************************************************/
+bool dvbpsi_stream_clock_utc(const dvbpsi_stream_clock_t *p_clock, int64_t i_date,
+                             int64_t *pi_time)
+{
+    if (!p_clock->b_set)
+        return false;
+
+    int64_t i_elapsed = i_date - p_clock->i_date;
+    /* the PCR base wrapped since the last table */
+    if (i_elapsed < -DVBPSI_STREAM_CLOCK_PCR_WRAP / 2)
+        i_elapsed += DVBPSI_STREAM_CLOCK_PCR_WRAP;
+    /* discontinuity: wait for the next table rather than going back */
+    if (i_elapsed < 0)
+        i_elapsed = 0;
+    *pi_time = p_clock->i_time + time_FloorDiv(i_elapsed, 1000000);
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_local_offset
+ *****************************************************************************/
+int32_t dvbpsi_stream_clock_local_offset(const dvbpsi_stream_clock_t *p_clock, int64_t i_time)
+{
+    if (!p_clock->b_offset)
+        return 0;
+    return i_time < p_clock->i_time_of_change ? p_clock->i_offset : p_clock->i_next_offset;
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_gps_to_unix
+ *****************************************************************************/
+int64_t dvbpsi_stream_clock_gps_to_unix(const dvbpsi_stream_clock_t *p_clock,
+                                        uint32_t i_gps_time)
+{
+    return dvbpsi_time_gps_to_unix(i_gps_time, p_clock->i_gps_utc_offset);
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_event
+ *****************************************************************************/
+dvbpsi_stream_clock_event_t dvbpsi_stream_clock_event(const dvbpsi_stream_clock_t *p_clock,
+                                                      int64_t i_date, int64_t i_start,
+                                                      uint32_t i_duration)
+{
+    int64_t i_now;
+    if (!dvbpsi_stream_clock_utc(p_clock, i_date, &i_now))
+        return DVBPSI_STREAM_CLOCK_UNKNOWN;
+    if (i_now < i_start)
+        return DVBPSI_STREAM_CLOCK_PENDING;
+    if (i_now < i_start + i_duration)
+        return DVBPSI_STREAM_CLOCK_RUNNING;
+    return DVBPSI_STREAM_CLOCK_ENDED;
+}
@@ -0,0 +1,359 @@
+/*****************************************************************************
+ * streamclock.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <streamclock.h>
+ * \brief Time conversions and stream clock.
+ *
+ * DVB times are coded as a 16 bit Modified Julian Date followed by 6 BCD
+ * digits (hhmmss), as in the start_time of EIT events or the UTC_time of
+ * TDT and TOT, and durations as 6 BCD digits. ATSC times are GPS seconds.
+ * The conversions below go to and from seconds since 1970-01-01 00:00:00
+ * UTC (unix time) without branches nor calls to the C library, and have
+ * batch variants for whole event lists.
+ *
+ * The stream clock follows the TDT, TOT or STT of a stream. Between two
+ * tables it advances with the date of the application, a monotonic time in
+ * microseconds (for example derived from the PCR or the arrival time of
+ * the packets). A date derived from the 33 bit PCR base may wrap, it is
+ * unwrapped against the date of the last table. A date earlier than the
+ * date of the last table (a PCR discontinuity) gives the time of that
+ * table until the next one: the stream time does not go back.
+ *
+ * tables/tot.h and tables/atsc_stt.h must be included before this file.
+ */
+
+#ifndef _DVBPSI_STREAMCLOCK_H_
+#define _DVBPSI_STREAMCLOCK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Value of a DVB time or duration whose bits are all set: undefined */
+#define DVBPSI_TIME_UNDEFINED       UINT64_C(0xffffffffff)
+
+/*! GPS epoch (1980-01-06) in unix time */
+#define DVBPSI_TIME_GPS_EPOCH       INT64_C(315964800)
+
+/*! Period of the 33 bit PCR base in microseconds, rounded */
+#define DVBPSI_STREAM_CLOCK_PCR_WRAP INT64_C(95443717689)
+
+/*****************************************************************************
+ * dvbpsi_time_dvb_to_unix
+ *****************************************************************************/
+/*!
+ * \fn int64_t dvbpsi_time_dvb_to_unix(uint64_t i_dvb_time)
+ * \brief Convert a 40 bit MJD + BCD time to unix time.
+ * \param i_dvb_time MJD in bits 24 to 39, BCD hhmmss in bits 0 to 23
+ * \return the unix time. DVBPSI_TIME_UNDEFINED gives a meaningless value.
+ */
+int64_t dvbpsi_time_dvb_to_unix(uint64_t i_dvb_time);
+
+/*****************************************************************************
+ * dvbpsi_time_unix_to_dvb
+ *****************************************************************************/
+/*!
+ * \fn uint64_t dvbpsi_time_unix_to_dvb(int64_t i_time)
+ * \brief Convert a unix time to a 40 bit MJD + BCD time.
+ * \param i_time unix time, between 1858-11-17 and 2038-04-22
+ * \return the DVB time.
+ */
+uint64_t dvbpsi_time_unix_to_dvb(int64_t i_time);
+
+/*****************************************************************************
+ * dvbpsi_time_bcd_to_seconds
+ *****************************************************************************/
+/*!
+ * \fn uint32_t dvbpsi_time_bcd_to_seconds(uint32_t i_bcd)
+ * \brief Convert a 24 bit BCD hhmmss duration or time of day to seconds.
+ * \param i_bcd BCD hhmmss
+ * \return the number of seconds.
+ */
+uint32_t dvbpsi_time_bcd_to_seconds(uint32_t i_bcd);
+
+/*****************************************************************************
+ * dvbpsi_time_seconds_to_bcd
+ *****************************************************************************/
+/*!
+ * \fn uint32_t dvbpsi_time_seconds_to_bcd(uint32_t i_seconds)
+ * \brief Convert a number of seconds to a 24 bit BCD hhmmss duration.
+ * \param i_seconds number of seconds
+ * \return the BCD duration, 0x995959 (99:59:59) for 100 hours or more.
+ */
+uint32_t dvbpsi_time_seconds_to_bcd(uint32_t i_seconds);
+
+/*****************************************************************************
+ * dvbpsi_time_gps_to_unix
+ *****************************************************************************/
+/*!
+ * \fn int64_t dvbpsi_time_gps_to_unix(uint32_t i_gps_time, uint8_t i_gps_utc_offset)
+ * \brief Convert ATSC GPS seconds to unix time.
+ * \param i_gps_time seconds since 1980-01-06 00:00:00 GPS
+ * \param i_gps_utc_offset GPS_UTC_offset of the STT (leap seconds)
+ * \return the unix time.
+ */
+int64_t dvbpsi_time_gps_to_unix(uint32_t i_gps_time, uint8_t i_gps_utc_offset);
+
+/*****************************************************************************
+ * dvbpsi_time_unix_to_gps
+ *****************************************************************************/
+/*!
+ * \fn uint32_t dvbpsi_time_unix_to_gps(int64_t i_time, uint8_t i_gps_utc_offset)
+ * \brief Convert a unix time to ATSC GPS seconds.
+ * \param i_time unix time, after 1980-01-06
+ * \param i_gps_utc_offset GPS_UTC_offset of the STT (leap seconds)
+ * \return the GPS time.
+ */
+uint32_t dvbpsi_time_unix_to_gps(int64_t i_time, uint8_t i_gps_utc_offset);
+
+/*****************************************************************************
+ * dvbpsi_time_mjd_to_date
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_time_mjd_to_date(uint16_t i_mjd, int *pi_year, int *pi_month,
+                                    int *pi_day)
+ * \brief Convert a Modified Julian Date to a calendar date.
+ * \param i_mjd Modified Julian Date
+ * \param pi_year set to the year
+ * \param pi_month set to the month, 1 to 12
+ * \param pi_day set to the day of the month, 1 to 31
+ * \return nothing.
+ */
+void dvbpsi_time_mjd_to_date(uint16_t i_mjd, int *pi_year, int *pi_month, int *pi_day);
+
+/*****************************************************************************
+ * dvbpsi_time_date_to_mjd
+ *****************************************************************************/
+/*!
+ * \fn uint16_t dvbpsi_time_date_to_mjd(int i_year, int i_month, int i_day)
+ * \brief Convert a calendar date to a Modified Julian Date.
+ * \param i_year year, 1858 to 2038
+ * \param i_month month, 1 to 12
+ * \param i_day day of the month, 1 to 31
+ * \return the Modified Julian Date.
+ */
+uint16_t dvbpsi_time_date_to_mjd(int i_year, int i_month, int i_day);
+
+/*****************************************************************************
+ * dvbpsi_time_dvb_to_unix_batch
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_time_dvb_to_unix_batch(const uint64_t *p_dvb_times,
+                                          int64_t *p_times, size_t i_count)
+ * \brief Convert an array of 40 bit MJD + BCD times to unix times.
+ * \param p_dvb_times DVB times
+ * \param p_times array receiving the unix times
+ * \param i_count number of times
+ * \return nothing.
+ */
+void dvbpsi_time_dvb_to_unix_batch(const uint64_t *p_dvb_times, int64_t *p_times,
+                                   size_t i_count);
+
+/*****************************************************************************
+ * dvbpsi_time_bcd_to_seconds_batch
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_time_bcd_to_seconds_batch(const uint32_t *p_bcd,
+                                             uint32_t *p_seconds, size_t i_count)
+ * \brief Convert an array of 24 bit BCD durations to seconds.
+ * \param p_bcd BCD durations
+ * \param p_seconds array receiving the numbers of seconds
+ * \param i_count number of durations
+ * \return nothing.
+ */
+void dvbpsi_time_bcd_to_seconds_batch(const uint32_t *p_bcd, uint32_t *p_seconds,
+                                      size_t i_count);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_event_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_stream_clock_event_e
+ * \brief State of an event at the current stream time.
+ */
+/*!
+ * \typedef enum dvbpsi_stream_clock_event_e dvbpsi_stream_clock_event_t
+ * \brief dvbpsi_stream_clock_event_t type definition.
+ */
+typedef enum dvbpsi_stream_clock_event_e
+{
+    DVBPSI_STREAM_CLOCK_UNKNOWN = 0,    /*!< the clock is not set */
+    DVBPSI_STREAM_CLOCK_PENDING,        /*!< the event has not started */
+    DVBPSI_STREAM_CLOCK_RUNNING,        /*!< the event is on air */
+    DVBPSI_STREAM_CLOCK_ENDED,          /*!< the event is over */
+} dvbpsi_stream_clock_event_t;
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_stream_clock_s dvbpsi_stream_clock_t
+ * \brief Opaque stream clock handle.
+ */
+typedef struct dvbpsi_stream_clock_s dvbpsi_stream_clock_t;
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_stream_clock_t *dvbpsi_stream_clock_new(void)
+ * \brief Create a stream clock, not set until the first time table.
+ * \return pointer to the clock, NULL on error.
+ */
+dvbpsi_stream_clock_t *dvbpsi_stream_clock_new(void);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_stream_clock_delete(dvbpsi_stream_clock_t *p_clock)
+ * \brief Destroy a stream clock.
+ * \param p_clock pointer to the clock
+ * \return nothing.
+ */
+void dvbpsi_stream_clock_delete(dvbpsi_stream_clock_t *p_clock);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_set_region
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_stream_clock_set_region(dvbpsi_stream_clock_t *p_clock,
+                        const uint8_t *p_country_code, int i_region_id)
+ * \brief Select the entry of the local_time_offset_descriptor to follow.
+ * \param p_clock pointer to the clock
+ * \param p_country_code ISO 3166 country code (3 characters), NULL for the
+ * first entry of the descriptor
+ * \param i_region_id country_region_id, -1 for any region
+ * \return nothing.
+ *
+ * The setting applies from the next TOT.
+ */
+void dvbpsi_stream_clock_set_region(dvbpsi_stream_clock_t *p_clock,
+                                    const uint8_t *p_country_code, int i_region_id);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_update_tot
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_stream_clock_update_tot(dvbpsi_stream_clock_t *p_clock,
+                        const dvbpsi_tot_t *p_tot, int64_t i_date)
+ * \brief Set the clock from a TDT or TOT.
+ * \param p_clock pointer to the clock
+ * \param p_tot TDT or TOT, owned by the caller
+ * \param i_date date at which the table was received, in microseconds
+ * \return nothing.
+ *
+ * The local_time_offset_descriptor (0x58) of a TOT gives the local time
+ * offset.
+ */
+void dvbpsi_stream_clock_update_tot(dvbpsi_stream_clock_t *p_clock,
+                                    const dvbpsi_tot_t *p_tot, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_update_stt
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_stream_clock_update_stt(dvbpsi_stream_clock_t *p_clock,
+                        const dvbpsi_atsc_stt_t *p_stt, int64_t i_date)
+ * \brief Set the clock from an ATSC STT.
+ * \param p_clock pointer to the clock
+ * \param p_stt STT, owned by the caller
+ * \param i_date date at which the table was received, in microseconds
+ * \return nothing.
+ *
+ * The GPS_UTC_offset is kept for dvbpsi_stream_clock_gps_to_unix().
+ */
+void dvbpsi_stream_clock_update_stt(dvbpsi_stream_clock_t *p_clock,
+                                    const dvbpsi_atsc_stt_t *p_stt, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_utc
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_stream_clock_utc(const dvbpsi_stream_clock_t *p_clock,
+                                    int64_t i_date, int64_t *pi_time)
+ * \brief Get the stream time.
+ * \param p_clock pointer to the clock
+ * \param i_date current date in microseconds
+ * \param pi_time set to the unix time
+ * \return false if no time table has been received yet.
+ *
+ * A date more than half a PCR period before the date of the last table is
+ * taken as wrapped, a date slightly before it gives the time of the table.
+ */
+bool dvbpsi_stream_clock_utc(const dvbpsi_stream_clock_t *p_clock, int64_t i_date,
+                             int64_t *pi_time);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_local_offset
+ *****************************************************************************/
+/*!
+ * \fn int32_t dvbpsi_stream_clock_local_offset(const dvbpsi_stream_clock_t *p_clock,
+                                                int64_t i_time)
+ * \brief Get the local time offset at a given time.
+ * \param p_clock pointer to the clock
+ * \param i_time unix time
+ * \return the offset in seconds to add to UTC, 0 if no TOT gave it. The
+ * time_of_change of the descriptor is taken into account.
+ */
+int32_t dvbpsi_stream_clock_local_offset(const dvbpsi_stream_clock_t *p_clock, int64_t i_time);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_gps_to_unix
+ *****************************************************************************/
+/*!
+ * \fn int64_t dvbpsi_stream_clock_gps_to_unix(const dvbpsi_stream_clock_t *p_clock,
+                                               uint32_t i_gps_time)
+ * \brief Convert GPS seconds, such as the start_time of an ATSC EIT event,
+ * with the GPS_UTC_offset of the last STT.
+ * \param p_clock pointer to the clock
+ * \param i_gps_time GPS seconds
+ * \return the unix time.
+ */
+int64_t dvbpsi_stream_clock_gps_to_unix(const dvbpsi_stream_clock_t *p_clock,
+                                        uint32_t i_gps_time);
+
+/*****************************************************************************
+ * dvbpsi_stream_clock_event
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_stream_clock_event_t dvbpsi_stream_clock_event(
+                        const dvbpsi_stream_clock_t *p_clock, int64_t i_date,
+                        int64_t i_start, uint32_t i_duration)
+ * \brief Evaluate the state of an event at the current stream time.
+ * \param p_clock pointer to the clock
+ * \param i_date current date in microseconds
+ * \param i_start start of the event, in unix time
+ * \param i_duration duration of the event in seconds
+ * \return the state of the event.
+ */
+dvbpsi_stream_clock_event_t dvbpsi_stream_clock_event(const dvbpsi_stream_clock_t *p_clock,
+                                                      int64_t i_date, int64_t i_start,
+                                                      uint32_t i_duration);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of streamclock.h"
+#endif
@@ -62,12 +62,12 @@ static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit
                                             uint8_t  i_etm_location,
                                             uint32_t i_length_seconds,
                                             uint8_t i_title_length,
-                                            uint8_t *p_title);
+                                            const uint8_t *p_title);
 
 static dvbpsi_descriptor_t *dvbpsi_atsc_EITChannelAddDescriptor(
                                                dvbpsi_atsc_eit_event_t *p_table,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data);
+                                               const uint8_t *p_data);
 
 static void dvbpsi_atsc_GatherEITSections(dvbpsi_t* p_dvbpsi,
                       dvbpsi_decoder_t* p_decoder, dvbpsi_psi_section_t* p_section);
@@ -232,7 +232,7 @@ static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit
                                             uint8_t  i_etm_location,
                                             uint32_t i_length_seconds,
                                             uint8_t i_title_length,
-                                            uint8_t *p_title)
+                                            const uint8_t *p_title)
 {
   dvbpsi_atsc_eit_event_t * p_event
                 = (dvbpsi_atsc_eit_event_t*)malloc(sizeof(dvbpsi_atsc_eit_event_t));
@@ -273,7 +273,7 @@ static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit
 static dvbpsi_descriptor_t *dvbpsi_atsc_EITChannelAddDescriptor(
                                                dvbpsi_atsc_eit_event_t *p_event,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data)
+                                               const uint8_t *p_data)
 {
     dvbpsi_descriptor_t * p_descriptor
                             = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -470,21 +470,51 @@ static void dvbpsi_atsc_GatherEITSections(dvbpsi_t * p_dvbpsi,
     {
         assert(p_eit_decoder->pf_eit_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_eit_decoder->p_sections);
+
         /* Save the current information */
         p_eit_decoder->current_eit = *p_eit_decoder->p_building_eit;
         p_eit_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_atsc_DecodeEITSections(p_eit_decoder->p_building_eit,
                                       p_eit_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new EIT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_eit_decoder->pf_eit_callback(p_eit_decoder->p_cb_data,
                                        p_eit_decoder->p_building_eit);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitEIT(p_eit_decoder, false);
         assert(p_eit_decoder->p_sections == NULL);
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitEITEventIter
+ *****************************************************************************
+ * Start an event cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitEITEventIter(dvbpsi_atsc_eit_event_iter_t *p_iter,
+                                    const uint8_t *p_start, const uint8_t *p_end)
+{
+    memset(p_iter, 0, sizeof(dvbpsi_atsc_eit_event_iter_t));
+    if (p_end - p_start >= 2)
+    {
+        p_iter->i_protocol = p_start[0];
+        p_iter->i_events = p_start[1];
+        p_start += 2;
+    }
+    else
+        p_start = p_end;
+    p_iter->i_remaining = p_iter->i_events;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_start, p_start);
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_DecodeEITSection
  *****************************************************************************
@@ -493,51 +523,82 @@ static void dvbpsi_atsc_GatherEITSections(dvbpsi_t * p_dvbpsi,
 static void dvbpsi_atsc_DecodeEITSections(dvbpsi_atsc_eit_t* p_eit,
                               dvbpsi_psi_section_t* p_section)
 {
-  uint8_t *p_byte, *p_end;
-
   while(p_section)
   {
-    uint16_t i_number_events = p_section->p_payload_start[1];
-    uint16_t i_events_count = 0;
-    uint16_t i_length = 0;
+    dvbpsi_atsc_eit_event_iter_t iter;
+    dvbpsi_InitEITEventIter(&iter, p_section->p_payload_start,
+                            p_section->p_payload_end);
 
-    for(p_byte = p_section->p_payload_start + 2;
-        ((p_byte + 4) < p_section->p_payload_end) && (i_events_count < i_number_events);
-        i_events_count ++)
+    while(dvbpsi_atsc_eit_event_iter_next(&iter))
     {
         dvbpsi_atsc_eit_event_t* p_event;
-        uint16_t i_event_id          = ((uint16_t)(p_byte[0] & 0x3f) << 8) | ((uint16_t) p_byte[1]);
-        uint32_t i_start_time        = ((uint32_t)(p_byte[2] << 24)) |
-                                       ((uint32_t)(p_byte[3] << 16)) |
-                                       ((uint32_t)(p_byte[4] <<  8)) |
-                                       ((uint32_t)(p_byte[5]));
-        uint8_t  i_etm_location      = (uint8_t)((p_byte[6] & 0x30) >> 4);
-        uint32_t i_length_seconds    = ((uint32_t)((p_byte[6] & 0x0f) << 16)) |
-                                       ((uint32_t)(p_byte[7] << 8)) |
-                                       ((uint32_t)(p_byte[8]));
-        uint8_t  i_title_length      = p_byte[9];
-
-        p_byte += 10;
-        p_event = dvbpsi_atsc_EITAddEvent(p_eit, i_event_id, i_start_time,
-                                i_etm_location, i_length_seconds, i_title_length,
-                                p_byte);
-        p_byte += i_title_length;
-        i_length = ((uint16_t)(p_byte[0] & 0xf) <<8) | p_byte[1];
-        /* Table descriptors */
-        p_byte += 2;
-        p_end = p_byte + i_length;
-        if( p_end > p_section->p_payload_end ) break;
-
-        while(p_byte + 2 <= p_end)
-        {
-            uint8_t i_tag = p_byte[0];
-            uint8_t i_len = p_byte[1];
-            if(i_len + 2 <= p_end - p_byte)
-              dvbpsi_atsc_EITChannelAddDescriptor(p_event, i_tag, i_len, p_byte + 2);
-            p_byte += 2 + i_len;
-        }
+        p_event = dvbpsi_atsc_EITAddEvent(p_eit, iter.i_event_id, iter.i_start_time,
+                                iter.i_etm_location, iter.i_length_seconds,
+                                iter.i_title_length, iter.p_title);
+        if(!p_event)
+          break;
+
+        /* Event descriptors */
+        while(dvbpsi_descriptor_iter_next(&iter.descriptors))
+          dvbpsi_atsc_EITChannelAddDescriptor(p_event, iter.descriptors.i_tag,
+                                              iter.descriptors.i_length,
+                                              iter.descriptors.p_data);
     }
 
     p_section = p_section->p_next;
   }
 }
+
+/*****************************************************************************
+ * dvbpsi_atsc_eit_event_iter_init
+ *****************************************************************************/
+bool dvbpsi_atsc_eit_event_iter_init(dvbpsi_atsc_eit_event_iter_t *p_iter,
+                                     const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || p_data[0] != 0xcb || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitEITEventIter(p_iter, p_start, p_end);
+    p_iter->i_source_id = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_atsc_eit_event_iter_next
+ *****************************************************************************/
+bool dvbpsi_atsc_eit_event_iter_next(dvbpsi_atsc_eit_event_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+    const uint8_t *p_end;
+
+    /* the title and the descriptors_length must fit */
+    if (p_iter->i_remaining == 0 || p_iter->p_end - p_byte < 12
+        || p_iter->p_end - p_byte < 12 + p_byte[9])
+        return false;
+
+    p_iter->i_event_id = ((uint16_t)(p_byte[0] & 0x3f) << 8) | p_byte[1];
+    p_iter->i_start_time = ((uint32_t)(p_byte[2]) << 24) |
+                           ((uint32_t)(p_byte[3]) << 16) |
+                           ((uint32_t)(p_byte[4]) << 8)  |
+                                       p_byte[5];
+    p_iter->i_etm_location = (p_byte[6] & 0x30) >> 4;
+    p_iter->i_length_seconds = ((uint32_t)(p_byte[6] & 0x0f) << 16) |
+                               ((uint32_t)(p_byte[7]) << 8)  |
+                                           p_byte[8];
+    p_iter->i_title_length = p_byte[9];
+    p_iter->p_title = p_byte + 10;
+
+    p_byte += 10 + p_iter->i_title_length;
+    p_iter->i_descriptors_length = ((uint16_t)(p_byte[0] & 0xf) << 8) | p_byte[1];
+
+    p_byte += 2;
+    p_end = p_iter->i_descriptors_length < p_iter->p_end - p_byte ?
+                p_byte + p_iter->i_descriptors_length : p_iter->p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_end);
+    p_iter->i_remaining--;
+    p_iter->p_next = p_end;
+    return true;
+}
@@ -186,6 +186,70 @@ void dvbpsi_atsc_EmptyEIT(dvbpsi_atsc_eit_t *p_eit);
  */
 void dvbpsi_atsc_DeleteEIT(dvbpsi_atsc_eit_t *p_eit);
 
+/*****************************************************************************
+ * dvbpsi_atsc_eit_event_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_atsc_eit_event_iter_s
+ * \brief Cursor over the events of a raw ATSC EIT section.
+ *
+ * The cursor reads the section in place with the parsing of the EIT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections.
+ */
+/*!
+ * \typedef struct dvbpsi_atsc_eit_event_iter_s dvbpsi_atsc_eit_event_iter_t
+ * \brief dvbpsi_atsc_eit_event_iter_t type definition.
+ */
+typedef struct dvbpsi_atsc_eit_event_iter_s
+{
+    uint16_t   i_source_id;     /*!< source_id */
+    uint8_t    i_protocol;      /*!< PSIP Protocol version */
+    uint8_t    i_events;        /*!< num_events_in_section */
+
+    uint16_t   i_event_id;      /*!< Event ID */
+    uint32_t   i_start_time;    /*!< Start time in GPS seconds */
+    uint8_t    i_etm_location;  /*!< Extended Text Message location. */
+    uint32_t   i_length_seconds;/*!< Length of the event in seconds */
+    uint8_t    i_title_length;  /*!< Length of the title in bytes */
+    const uint8_t *p_title;     /*!< Title in multiple string structure format. */
+    uint16_t   i_descriptors_length; /*!< descriptors_length */
+    dvbpsi_descriptor_iter_t descriptors; /*!< event descriptors */
+
+    uint8_t        i_remaining; /*!< events left, private */
+    const uint8_t *p_next;      /*!< next event, private */
+    const uint8_t *p_end;       /*!< end of the loop, private */
+} dvbpsi_atsc_eit_event_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_atsc_eit_event_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_atsc_eit_event_iter_init(dvbpsi_atsc_eit_event_iter_t *p_iter,
+                                             const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw ATSC EIT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not an ATSC EIT section (table_id 0xCB) or
+ * does not fit in i_size bytes. The CRC_32 is not checked, see
+ * dvbpsi_crc32().
+ */
+bool dvbpsi_atsc_eit_event_iter_init(dvbpsi_atsc_eit_event_iter_t *p_iter,
+                                     const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_atsc_eit_event_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_atsc_eit_event_iter_next(dvbpsi_atsc_eit_event_iter_t *p_iter)
+ * \brief Move the cursor to the next event of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on an event, false at the end of the
+ * section.
+ */
+bool dvbpsi_atsc_eit_event_iter_next(dvbpsi_atsc_eit_event_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
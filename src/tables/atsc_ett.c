@@ -386,15 +386,22 @@ static void dvbpsi_atsc_GatherETTSections(dvbpsi_t* p_dvbpsi,
     {
         assert(p_ett_decoder->pf_ett_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_ett_decoder->p_sections);
+
         /* Save the current information */
         p_ett_decoder->current_ett = *p_ett_decoder->p_building_ett;
         p_ett_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_atsc_DecodeETTSections(p_ett_decoder->p_building_ett,
                                       p_ett_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new ETT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_ett_decoder->pf_ett_callback(p_ett_decoder->p_cb_data,
                                        p_ett_decoder->p_building_ett);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitETT(p_ett_decoder, false);
         assert(p_ett_decoder->p_sections == NULL);
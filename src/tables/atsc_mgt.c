@@ -493,15 +493,22 @@ static void dvbpsi_atsc_GatherMGTSections(dvbpsi_t * p_dvbpsi,
     {
         assert(p_mgt_decoder->pf_mgt_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_mgt_decoder->p_sections);
+
         /* Save the current information */
         p_mgt_decoder->current_mgt = *p_mgt_decoder->p_building_mgt;
         p_mgt_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_atsc_DecodeMGTSections(p_mgt_decoder->p_building_mgt,
                                       p_mgt_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new MGT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_mgt_decoder->pf_mgt_callback(p_mgt_decoder->p_cb_data,
                                        p_mgt_decoder->p_building_mgt);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitMGT(p_mgt_decoder, false);
         assert(p_mgt_decoder->p_sections == NULL);
@@ -398,15 +398,22 @@ static void dvbpsi_atsc_GatherSTTSections(dvbpsi_t *p_dvbpsi,
     {
         assert(p_stt_decoder->pf_stt_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_stt_decoder->p_sections);
+
         /* Save the current information */
         p_stt_decoder->current_stt = *p_stt_decoder->p_building_stt;
         p_stt_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_atsc_DecodeSTTSections(p_stt_decoder->p_building_stt,
                                       p_stt_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new STT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_stt_decoder->pf_stt_callback(p_stt_decoder->p_cb_data,
                                        p_stt_decoder->p_building_stt);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitSTT(p_stt_decoder, false);
         assert(p_stt_decoder->p_sections == NULL);
@@ -57,10 +57,10 @@ typedef struct dvbpsi_atsc_vct_decoder_s
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTAddDescriptor(
                                                dvbpsi_atsc_vct_t *p_vct,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data);
+                                               const uint8_t *p_data);
 
 static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p_vct,
-                                            uint8_t *p_short_name,
+                                            const uint8_t *p_short_name,
                                             uint16_t i_major_number,
                                             uint16_t i_minor_number,
                                             uint8_t  i_modulation,
@@ -79,7 +79,7 @@ static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTChannelAddDescriptor(
                                                dvbpsi_atsc_vct_channel_t *p_table,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data);
+                                               const uint8_t *p_data);
 
 static void dvbpsi_atsc_GatherVCTSections(dvbpsi_t * p_dvbpsi,
                 dvbpsi_decoder_t *p_decoder, dvbpsi_psi_section_t * p_section);
@@ -247,7 +247,7 @@ void dvbpsi_atsc_DeleteVCT(dvbpsi_atsc_vct_t *p_vct)
  *****************************************************************************/
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTAddDescriptor(dvbpsi_atsc_vct_t *p_vct,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data)
+                                               const uint8_t *p_data)
 {
     dvbpsi_descriptor_t * p_descriptor
             = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -269,7 +269,7 @@ static dvbpsi_descriptor_t *dvbpsi_atsc_VCTAddDescriptor(dvbpsi_atsc_vct_t *p_vc
  * Add a Channel description at the end of the VCT.
  *****************************************************************************/
 static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p_vct,
-                                            uint8_t *p_short_name,
+                                            const uint8_t *p_short_name,
                                             uint16_t i_major_number,
                                             uint16_t i_minor_number,
                                             uint8_t  i_modulation,
@@ -332,7 +332,7 @@ static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTChannelAddDescriptor(
                                                dvbpsi_atsc_vct_channel_t *p_channel,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data)
+                                               const uint8_t *p_data)
 {
     dvbpsi_descriptor_t * p_descriptor
             = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -531,21 +531,52 @@ static void dvbpsi_atsc_GatherVCTSections(dvbpsi_t *p_dvbpsi,
     {
         assert(p_vct_decoder->pf_vct_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_vct_decoder->p_sections);
+
         /* Save the current information */
         p_vct_decoder->current_vct = *p_vct_decoder->p_building_vct;
         p_vct_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_atsc_DecodeVCTSections(p_vct_decoder->p_building_vct,
                                       p_vct_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new VCT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_vct_decoder->pf_vct_callback(p_vct_decoder->p_cb_data,
                                        p_vct_decoder->p_building_vct);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitVCT(p_vct_decoder, false);
         assert(p_vct_decoder->p_sections == NULL);
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitVCTChannelIter
+ *****************************************************************************
+ * Start a channel cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitVCTChannelIter(dvbpsi_atsc_vct_channel_iter_t *p_iter,
+                                      const uint8_t *p_start, const uint8_t *p_end)
+{
+    memset(p_iter, 0, sizeof(dvbpsi_atsc_vct_channel_iter_t));
+    if (p_end - p_start >= 2)
+    {
+        p_iter->i_protocol = p_start[0];
+        p_iter->i_channels = p_start[1];
+        p_start += 2;
+    }
+    else
+        p_start = p_end;
+    p_iter->i_remaining = p_iter->i_channels;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_start, p_start);
+    dvbpsi_descriptor_iter_init(&p_iter->additional, p_start, p_start);
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_DecodeVCTSection
  *****************************************************************************
@@ -554,74 +585,114 @@ static void dvbpsi_atsc_GatherVCTSections(dvbpsi_t *p_dvbpsi,
 static void dvbpsi_atsc_DecodeVCTSections(dvbpsi_atsc_vct_t* p_vct,
                               dvbpsi_psi_section_t* p_section)
 {
-    uint8_t *p_byte, *p_end;
-
     while(p_section)
     {
-        uint16_t i_channels_defined = p_section->p_payload_start[1];
-        uint16_t i_channels_count = 0;
-        uint16_t i_length = 0;
+        dvbpsi_atsc_vct_channel_iter_t iter;
+        dvbpsi_InitVCTChannelIter(&iter, p_section->p_payload_start,
+                                  p_section->p_payload_end);
 
-        for(p_byte = p_section->p_payload_start + 2;
-            ((p_byte + 6) < p_section->p_payload_end) && (i_channels_count < i_channels_defined);
-            i_channels_count ++)
+        while(dvbpsi_atsc_vct_channel_iter_next(&iter))
         {
             dvbpsi_atsc_vct_channel_t* p_channel;
-            uint16_t i_major_number      = ((uint16_t)(p_byte[14] & 0xf) << 6) | ((uint16_t)(p_byte[15] & 0xfc) >> 2);
-            uint16_t i_minor_number      = ((uint16_t)(p_byte[15] & 0x3) << 8) | ((uint16_t) p_byte[16]);
-            uint8_t  i_modulation        = p_byte[17];
-            uint32_t i_carrier_freq      = ((uint32_t)(p_byte[18] << 24)) |
-                    ((uint32_t)(p_byte[19] << 16)) |
-                    ((uint32_t)(p_byte[20] <<  8)) |
-                    ((uint32_t)(p_byte[21]));
-            uint16_t i_channel_tsid      = ((uint16_t)(p_byte[22] << 8)) |  ((uint16_t)p_byte[23]);
-            uint16_t i_program_number    = ((uint16_t)(p_byte[24] << 8)) |  ((uint16_t)p_byte[25]);
-            uint8_t  i_etm_location      = (uint8_t)((p_byte[26] & 0xC0) >> 6);
-            int      b_access_controlled = (p_byte[26] & 0x20) >> 5;
-            int      b_hidden            = (p_byte[26] & 0x10) >> 4;
-            int      b_path_select       = (p_byte[26] & 0x08) >> 3;
-            int      b_out_of_band       = (p_byte[26] & 0x04) >> 2;
-            int      b_hide_guide        = (p_byte[26] & 0x02) >> 1;
-            uint8_t  i_service_type      = (uint8_t)(p_byte[27] & 0x3f);
-            uint16_t i_source_id         = ((uint16_t)(p_byte[28] << 8)) |  ((uint16_t)p_byte[29]);
-            i_length = ((uint16_t)(p_byte[30] & 0x3) <<8) | p_byte[31];
-
-            p_channel = dvbpsi_atsc_VCTAddChannel(p_vct, p_byte,
-                                                  i_major_number, i_minor_number,
-                                                  i_modulation, i_carrier_freq,
-                                                  i_channel_tsid, i_program_number,
-                                                  i_etm_location, b_access_controlled,
-                                                  b_hidden, b_path_select, b_out_of_band,
-                                                  b_hide_guide, i_service_type, i_source_id);
-
-            /* Table descriptors */
-            p_byte += 32;
-            p_end = p_byte + i_length;
-            if( p_end > p_section->p_payload_end ) break;
-
-            while(p_byte + 2 <= p_end)
-            {
-                uint8_t i_tag = p_byte[0];
-                uint8_t i_len = p_byte[1];
-                if(i_len + 2 <= p_end - p_byte)
-                    dvbpsi_atsc_VCTChannelAddDescriptor(p_channel, i_tag, i_len, p_byte + 2);
-                p_byte += 2 + i_len;
-            }
+            p_channel = dvbpsi_atsc_VCTAddChannel(p_vct, iter.p_short_name,
+                                                  iter.i_major_number, iter.i_minor_number,
+                                                  iter.i_modulation, iter.i_carrier_freq,
+                                                  iter.i_channel_tsid, iter.i_program_number,
+                                                  iter.i_etm_location, iter.b_access_controlled,
+                                                  iter.b_hidden, iter.b_path_select,
+                                                  iter.b_out_of_band, iter.b_hide_guide,
+                                                  iter.i_service_type, iter.i_source_id);
+            if(!p_channel)
+                break;
+
+            /* Channel descriptors */
+            while(dvbpsi_descriptor_iter_next(&iter.descriptors))
+                dvbpsi_atsc_VCTChannelAddDescriptor(p_channel, iter.descriptors.i_tag,
+                                                    iter.descriptors.i_length,
+                                                    iter.descriptors.p_data);
         }
 
         /* Table descriptors */
-        i_length = ((uint16_t)(p_byte[0] & 0x3) <<8) | p_byte[1];
-        p_byte += 2;
-        p_end = p_byte + i_length;
+        while(dvbpsi_descriptor_iter_next(&iter.additional))
+            dvbpsi_atsc_VCTAddDescriptor(p_vct, iter.additional.i_tag,
+                                         iter.additional.i_length,
+                                         iter.additional.p_data);
+
+        p_section = p_section->p_next;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_atsc_vct_channel_iter_init
+ *****************************************************************************/
+bool dvbpsi_atsc_vct_channel_iter_init(dvbpsi_atsc_vct_channel_iter_t *p_iter,
+                                       const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || (p_data[0] != 0xc8 && p_data[0] != 0xc9) || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitVCTChannelIter(p_iter, p_start, p_end);
+    p_iter->i_ts_id = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    p_iter->b_cable_vct = (p_data[0] == 0xc9);
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_atsc_vct_channel_iter_next
+ *****************************************************************************/
+bool dvbpsi_atsc_vct_channel_iter_next(dvbpsi_atsc_vct_channel_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+    const uint8_t *p_end;
 
-        while(p_byte + 2 <= p_end)
+    if (p_byte == p_iter->p_end)
+        return false;
+    if (p_iter->i_remaining == 0 || p_iter->p_end - p_byte < 32)
+    {
+        /* the additional descriptors follow the last channel */
+        p_iter->i_remaining = 0;
+        p_end = p_byte;
+        if (p_iter->p_end - p_byte >= 2)
         {
-            uint8_t i_tag = p_byte[0];
-            uint8_t i_len = p_byte[1];
-            if(i_len + 2 <= p_end - p_byte)
-                dvbpsi_atsc_VCTAddDescriptor(p_vct, i_tag, i_len, p_byte + 2);
-            p_byte += 2 + i_len;
+            uint16_t i_length = ((uint16_t)(p_byte[0] & 0x3) << 8) | p_byte[1];
+            p_byte += 2;
+            p_end = i_length < p_iter->p_end - p_byte ? p_byte + i_length : p_iter->p_end;
         }
-        p_section = p_section->p_next;
+        dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_byte);
+        dvbpsi_descriptor_iter_init(&p_iter->additional, p_byte, p_end);
+        p_iter->p_next = p_iter->p_end;
+        return false;
     }
+
+    p_iter->p_short_name = p_byte;
+    p_iter->i_major_number = ((uint16_t)(p_byte[14] & 0xf) << 6) |
+                             ((uint16_t)(p_byte[15] & 0xfc) >> 2);
+    p_iter->i_minor_number = ((uint16_t)(p_byte[15] & 0x3) << 8) | p_byte[16];
+    p_iter->i_modulation = p_byte[17];
+    p_iter->i_carrier_freq = ((uint32_t)(p_byte[18]) << 24) |
+                             ((uint32_t)(p_byte[19]) << 16) |
+                             ((uint32_t)(p_byte[20]) << 8)  |
+                                         p_byte[21];
+    p_iter->i_channel_tsid = ((uint16_t)(p_byte[22]) << 8) | p_byte[23];
+    p_iter->i_program_number = ((uint16_t)(p_byte[24]) << 8) | p_byte[25];
+    p_iter->i_etm_location = (p_byte[26] & 0xc0) >> 6;
+    p_iter->b_access_controlled = (p_byte[26] & 0x20) ? true : false;
+    p_iter->b_hidden = (p_byte[26] & 0x10) ? true : false;
+    p_iter->b_path_select = (p_byte[26] & 0x08) ? true : false;
+    p_iter->b_out_of_band = (p_byte[26] & 0x04) ? true : false;
+    p_iter->b_hide_guide = (p_byte[26] & 0x02) ? true : false;
+    p_iter->i_service_type = p_byte[27] & 0x3f;
+    p_iter->i_source_id = ((uint16_t)(p_byte[28]) << 8) | p_byte[29];
+    p_iter->i_descriptors_length = ((uint16_t)(p_byte[30] & 0x3) << 8) | p_byte[31];
+
+    p_byte += 32;
+    p_end = p_iter->i_descriptors_length < p_iter->p_end - p_byte ?
+                p_byte + p_iter->i_descriptors_length : p_iter->p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_end);
+    p_iter->i_remaining--;
+    p_iter->p_next = p_end;
+    return true;
 }
@@ -208,6 +208,85 @@ void dvbpsi_atsc_EmptyVCT(dvbpsi_atsc_vct_t *p_vct);
  */
 void dvbpsi_atsc_DeleteVCT(dvbpsi_atsc_vct_t *p_vct);
 
+/*****************************************************************************
+ * dvbpsi_atsc_vct_channel_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_atsc_vct_channel_iter_s
+ * \brief Cursor over the channels of a raw VCT section.
+ *
+ * The cursor reads the section in place with the parsing of the VCT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections. The additional
+ * descriptors follow the channel loop and are available once
+ * dvbpsi_atsc_vct_channel_iter_next() returned false.
+ */
+/*!
+ * \typedef struct dvbpsi_atsc_vct_channel_iter_s dvbpsi_atsc_vct_channel_iter_t
+ * \brief dvbpsi_atsc_vct_channel_iter_t type definition.
+ */
+typedef struct dvbpsi_atsc_vct_channel_iter_s
+{
+    uint16_t  i_ts_id;         /*!< transport_stream_id */
+    uint8_t   i_protocol;      /*!< PSIP Protocol version */
+    bool      b_cable_vct;     /*!< true for a CVCT (table_id 0xC9) */
+    uint8_t   i_channels;      /*!< num_channels_in_section */
+
+    const uint8_t *p_short_name; /*!< Channel name (7*UTF16-BE) */
+    uint16_t  i_major_number;  /*!< Channel major number */
+    uint16_t  i_minor_number;  /*!< Channel minor number */
+    uint8_t   i_modulation;    /*!< Modulation mode. */
+    uint32_t  i_carrier_freq;  /*!< Carrier center frequency. */
+    uint16_t  i_channel_tsid;  /*!< Channel Transport stream id. */
+    uint16_t  i_program_number;/*!< Channel MPEG program number. */
+    uint8_t   i_etm_location;  /*!< Extended Text Message location. */
+    bool      b_access_controlled; /*!< Whether the channel is scrambled. */
+    bool      b_hidden;        /*!< Not accessible directly by the user. */
+    bool      b_path_select;   /*!< Path selection, only used by CVCT. */
+    bool      b_out_of_band;   /*!< Out-of-band channel, only used by CVCT. */
+    bool      b_hide_guide;    /*!< Not displayed in the guide. */
+    uint8_t   i_service_type;  /*!< Channel type. */
+    uint16_t  i_source_id;     /*!< Programming source of the channel. */
+    uint16_t  i_descriptors_length; /*!< descriptors_length */
+    dvbpsi_descriptor_iter_t descriptors; /*!< channel descriptors */
+
+    dvbpsi_descriptor_iter_t additional;  /*!< additional descriptors, after
+                                               the last channel */
+
+    uint8_t        i_remaining;  /*!< channels left, private */
+    const uint8_t *p_next;       /*!< next channel, private */
+    const uint8_t *p_end;        /*!< end of the loop, private */
+} dvbpsi_atsc_vct_channel_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_atsc_vct_channel_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_atsc_vct_channel_iter_init(dvbpsi_atsc_vct_channel_iter_t *p_iter,
+                                               const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw VCT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not a VCT section (table_id 0xC8 or 0xC9)
+ * or does not fit in i_size bytes. The CRC_32 is not checked, see
+ * dvbpsi_crc32().
+ */
+bool dvbpsi_atsc_vct_channel_iter_init(dvbpsi_atsc_vct_channel_iter_t *p_iter,
+                                       const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_atsc_vct_channel_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_atsc_vct_channel_iter_next(dvbpsi_atsc_vct_channel_iter_t *p_iter)
+ * \brief Move the cursor to the next channel of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on a channel, false at the end of the
+ * section.
+ */
+bool dvbpsi_atsc_vct_channel_iter_next(dvbpsi_atsc_vct_channel_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
@@ -204,7 +204,7 @@ void dvbpsi_bat_delete(dvbpsi_bat_t *p_bat)
  *****************************************************************************/
 dvbpsi_descriptor_t* dvbpsi_bat_bouquet_descriptor_add(dvbpsi_bat_t* p_bat,
                                                        uint8_t i_tag, uint8_t i_length,
-                                                       uint8_t* p_data)
+                                                       const uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor
                         = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -259,7 +259,7 @@ dvbpsi_bat_ts_t *dvbpsi_bat_ts_add(dvbpsi_bat_t* p_bat,
  *****************************************************************************/
 dvbpsi_descriptor_t *dvbpsi_bat_ts_descriptor_add(dvbpsi_bat_ts_t *p_bat,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data)
+                                               const uint8_t *p_data)
 {
     dvbpsi_descriptor_t * p_descriptor
                         = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -441,21 +441,63 @@ void dvbpsi_bat_sections_gather(dvbpsi_t *p_dvbpsi,
     {
         assert(p_bat_decoder->pf_bat_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_bat_decoder->p_sections);
+
         /* Save the current information */
         p_bat_decoder->current_bat = *p_bat_decoder->p_building_bat;
         p_bat_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_bat_sections_decode(p_bat_decoder->p_building_bat,
                                    p_bat_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new BAT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_bat_decoder->pf_bat_callback(p_bat_decoder->p_cb_data,
                                        p_bat_decoder->p_building_bat);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitBAT(p_bat_decoder, false);
         assert(p_bat_decoder->p_sections == NULL);
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitBATTSIter
+ *****************************************************************************
+ * Start a TS cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitBATTSIter(dvbpsi_bat_ts_iter_t *p_iter,
+                                 const uint8_t *p_start, const uint8_t *p_end)
+{
+    const uint8_t *p_first_end = p_start;
+
+    memset(p_iter, 0, sizeof(dvbpsi_bat_ts_iter_t));
+    if (p_end - p_start >= 2)
+    {
+        uint16_t i_length = ((uint16_t)(p_start[0] & 0x0f) << 8) | p_start[1];
+        p_start += 2;
+        p_first_end = i_length < p_end - p_start ? p_start + i_length : p_end;
+    }
+    dvbpsi_descriptor_iter_init(&p_iter->bouquet_descriptors, p_start, p_first_end);
+
+    /* transport_stream_loop_length */
+    p_start = p_first_end;
+    if (p_end - p_start >= 2)
+    {
+        uint16_t i_length = ((uint16_t)(p_start[0] & 0x0f) << 8) | p_start[1];
+        p_start += 2;
+        if (i_length < p_end - p_start)
+            p_end = p_start + i_length;
+    }
+    else
+        p_end = p_start;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_start, p_start);
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_DecodeBATSection
  *****************************************************************************
@@ -467,63 +509,72 @@ void dvbpsi_bat_sections_gather(dvbpsi_t *p_dvbpsi,
 void dvbpsi_bat_sections_decode(dvbpsi_bat_t* p_bat,
                               dvbpsi_psi_section_t* p_section)
 {
-    uint8_t* p_byte, * p_end;
-
-    while(p_section)
+    while (p_section)
     {
-        /* - first loop descriptors */
-        p_byte = p_section->p_payload_start + 2;
-        p_end = p_byte + (((uint16_t)(p_section->p_payload_start[0] & 0x0f) << 8)
-                          | p_section->p_payload_start[1]);
-        if (p_end > p_section->p_payload_end)
-            p_end = p_section->p_payload_end;
+        dvbpsi_bat_ts_iter_t iter;
+        dvbpsi_InitBATTSIter(&iter, p_section->p_payload_start,
+                             p_section->p_payload_end);
 
-        while(p_byte + 2 <= p_end)
-        {
-            uint8_t i_tag = p_byte[0];
-            uint8_t i_length = p_byte[1];
-            if (i_length + 2 <= p_end - p_byte)
-                dvbpsi_bat_bouquet_descriptor_add(p_bat, i_tag, i_length, p_byte + 2);
-            p_byte += 2 + i_length;
-        }
-
-        p_end = 2 + p_byte + (((uint16_t)(p_byte[0] & 0x0f) << 8) | p_byte[1]);
-        if (p_end > p_section->p_payload_end)
-            p_end = p_section->p_payload_end;
+        /* - first loop descriptors */
+        while (dvbpsi_descriptor_iter_next(&iter.bouquet_descriptors))
+            dvbpsi_bat_bouquet_descriptor_add(p_bat, iter.bouquet_descriptors.i_tag,
+                                              iter.bouquet_descriptors.i_length, iter.bouquet_descriptors.p_data);
 
         /* - TSs */
-        p_byte += 2;
-        while(p_byte + 6 <= p_end)
+        while (dvbpsi_bat_ts_iter_next(&iter))
         {
-            uint8_t *p_end2;
-            uint16_t i_ts_id = ((uint16_t)p_byte[0] << 8) | p_byte[1];
-            uint16_t i_orig_network_id = ((uint16_t)p_byte[2] << 8) | p_byte[3];
-            uint16_t i_transport_descriptors_length = ((uint16_t)(p_byte[4] & 0x0f) << 8) | p_byte[5];
-
-            dvbpsi_bat_ts_t* p_ts = dvbpsi_bat_ts_add(p_bat, i_ts_id, i_orig_network_id);
+            dvbpsi_bat_ts_t* p_ts = dvbpsi_bat_ts_add(p_bat, iter.i_ts_id, iter.i_orig_network_id);
             if (!p_ts)
                 break;
 
             /* - TS descriptors */
-            p_byte += 6;
-            p_end2 = p_byte + i_transport_descriptors_length;
-            if (p_end2 > p_section->p_payload_end)
-                p_end2 = p_section->p_payload_end;
-
-            while (p_byte + 2 <= p_end2)
-            {
-                uint8_t i_tag = p_byte[0];
-                uint8_t i_length = p_byte[1];
-                if (i_length + 2 <= p_end2 - p_byte)
-                    dvbpsi_bat_ts_descriptor_add(p_ts, i_tag, i_length, p_byte + 2);
-                p_byte += 2 + i_length;
-            }
+            while (dvbpsi_descriptor_iter_next(&iter.descriptors))
+                dvbpsi_bat_ts_descriptor_add(p_ts, iter.descriptors.i_tag,
+                                             iter.descriptors.i_length, iter.descriptors.p_data);
         }
-
         p_section = p_section->p_next;
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_bat_ts_iter_init
+ *****************************************************************************/
+bool dvbpsi_bat_ts_iter_init(dvbpsi_bat_ts_iter_t *p_iter,
+                             const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || p_data[0] != 0x4a || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitBATTSIter(p_iter, p_start, p_end);
+    p_iter->i_bouquet_id = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_bat_ts_iter_next
+ *****************************************************************************/
+bool dvbpsi_bat_ts_iter_next(dvbpsi_bat_ts_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+    const uint8_t *p_end;
+
+    if (p_iter->p_end - p_byte < 6)
+        return false;
+
+    p_iter->i_ts_id = ((uint16_t)p_byte[0] << 8) | p_byte[1];
+    p_iter->i_orig_network_id = ((uint16_t)p_byte[2] << 8) | p_byte[3];
+    uint16_t i_ts_length = ((uint16_t)(p_byte[4] & 0x0f) << 8) | p_byte[5];
+
+    p_byte += 6;
+    p_end = i_ts_length < p_iter->p_end - p_byte ? p_byte + i_ts_length : p_iter->p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_end);
+    p_iter->p_next = p_end;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_bat_sections_generate
  *****************************************************************************
@@ -712,7 +763,7 @@ dvbpsi_psi_section_t* dvbpsi_bat_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_ba
             dvbpsi_error(p_dvbpsi, "BAT generator", "unable to carry all the TS descriptors");
 
         /* transport_descriptors_length */
-        i_transport_descriptors_length = p_current->p_payload_end - p_ts_start - 5;
+        i_transport_descriptors_length = p_current->p_payload_end - p_ts_start - 6;
         p_ts_start[4] = (i_transport_descriptors_length >> 8) | 0xf0;
         p_ts_start[5] = i_transport_descriptors_length;
 
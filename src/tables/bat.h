@@ -198,7 +198,7 @@ void dvbpsi_bat_delete(dvbpsi_bat_t *p_bat);
  * \fn dvbpsi_descriptor_t* dvbpsi_bat_bouquet_descriptor_add(dvbpsi_bat_t* p_bat,
                                                               uint8_t i_tag,
                                                               uint8_t i_length,
-                                                              uint8_t* p_data)
+                                                              const uint8_t* p_data)
  * \brief Add a descriptor in the BAT.
  * \param p_bat pointer to the BAT structure
  * \param i_tag descriptor's tag
@@ -208,7 +208,7 @@ void dvbpsi_bat_delete(dvbpsi_bat_t *p_bat);
  */
 dvbpsi_descriptor_t* dvbpsi_bat_bouquet_descriptor_add(dvbpsi_bat_t* p_bat,
                                                        uint8_t i_tag, uint8_t i_length,
-                                                       uint8_t* p_data);
+                                                       const uint8_t* p_data);
 
 /*****************************************************************************
  * dvbpsi_bat_ts_add
@@ -234,7 +234,7 @@ dvbpsi_bat_ts_t *dvbpsi_bat_ts_add(dvbpsi_bat_t* p_bat,
  * \fn dvbpsi_descriptor_t* dvbpsi_bat_ts_descriptor_add(dvbpsi_bat_ts_t *p_bat,
                                                          uint8_t i_tag,
                                                          uint8_t i_length,
-                                                         uint8_t *p_data)
+                                                         const uint8_t *p_data)
  * \brief Add a descriptor in the BAT TS descriptors.
  * \param p_bat pointer to the BAT structure
  * \param i_tag descriptor number
@@ -244,7 +244,7 @@ dvbpsi_bat_ts_t *dvbpsi_bat_ts_add(dvbpsi_bat_t* p_bat,
  */
 dvbpsi_descriptor_t *dvbpsi_bat_ts_descriptor_add(dvbpsi_bat_ts_t *p_bat,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data);
+                                               const uint8_t *p_data);
 
 /*****************************************************************************
  * dvbpsi_bat_sections_generate
@@ -260,6 +260,61 @@ dvbpsi_descriptor_t *dvbpsi_bat_ts_descriptor_add(dvbpsi_bat_ts_t *p_bat,
  *****************************************************************************/
 dvbpsi_psi_section_t *dvbpsi_bat_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_bat_t * p_bat);
 
+/*****************************************************************************
+ * dvbpsi_bat_ts_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_bat_ts_iter_s
+ * \brief Cursor over the transport streams of a raw BAT section.
+ *
+ * The cursor reads the section in place with the parsing of the BAT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections.
+ */
+/*!
+ * \typedef struct dvbpsi_bat_ts_iter_s dvbpsi_bat_ts_iter_t
+ * \brief dvbpsi_bat_ts_iter_t type definition.
+ */
+typedef struct dvbpsi_bat_ts_iter_s
+{
+  uint16_t                  i_bouquet_id;       /*!< bouquet_id */
+  dvbpsi_descriptor_iter_t  bouquet_descriptors; /*!< bouquet descriptors */
+
+  uint16_t                  i_ts_id;            /*!< transport_stream_id */
+  uint16_t                  i_orig_network_id;  /*!< original_network_id */
+  dvbpsi_descriptor_iter_t  descriptors;        /*!< TS descriptors */
+
+  const uint8_t *           p_next;             /*!< next TS, private */
+  const uint8_t *           p_end;              /*!< end of the loop, private */
+} dvbpsi_bat_ts_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_bat_ts_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_bat_ts_iter_init(dvbpsi_bat_ts_iter_t *p_iter,
+                                    const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw BAT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not a BAT section (table_id 0x4a) or does
+ * not fit in i_size bytes. The CRC_32 is not checked, see dvbpsi_crc32().
+ */
+bool dvbpsi_bat_ts_iter_init(dvbpsi_bat_ts_iter_t *p_iter,
+                             const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_bat_ts_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_bat_ts_iter_next(dvbpsi_bat_ts_iter_t *p_iter)
+ * \brief Move the cursor to the next TS of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on a transport stream, false at the end of the section.
+ */
+bool dvbpsi_bat_ts_iter_next(dvbpsi_bat_ts_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
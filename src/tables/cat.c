@@ -317,15 +317,22 @@ void dvbpsi_cat_sections_gather(dvbpsi_t *p_dvbpsi,
     {
         assert(p_cat_decoder->pf_cat_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_cat_decoder->p_sections);
+
         /* Save the current information */
         p_cat_decoder->current_cat = *p_cat_decoder->p_building_cat;
         p_cat_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_cat_sections_decode(p_cat_decoder->p_building_cat,
                                    p_cat_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new CAT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_cat_decoder->pf_cat_callback(p_cat_decoder->p_cb_data,
                                        p_cat_decoder->p_building_cat);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitCAT(p_cat_decoder, false);
         assert(p_cat_decoder->p_sections == NULL);
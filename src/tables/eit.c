@@ -259,7 +259,7 @@ dvbpsi_eit_event_t* dvbpsi_eit_nvod_event_add(dvbpsi_eit_t* p_eit,
  * Add a descriptor in the EIT event description.
  *****************************************************************************/
 dvbpsi_descriptor_t* dvbpsi_eit_event_descriptor_add(dvbpsi_eit_event_t* p_event,
-    uint8_t i_tag, uint8_t i_length, uint8_t* p_data)
+    uint8_t i_tag, uint8_t i_length, const uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor;
     p_descriptor = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -490,17 +490,24 @@ void dvbpsi_eit_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_private_
     {
         assert(p_eit_decoder->pf_eit_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_eit_decoder->p_sections);
+
         /* Save the current information */
         p_eit_decoder->current_eit = *p_eit_decoder->p_building_eit;
         p_eit_decoder->b_current_valid = true;
 
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_eit_sections_decode(p_dvbpsi,
                                    p_eit_decoder->p_building_eit,
                                    p_eit_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
 
         /* signal the new EIT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_eit_decoder->pf_eit_callback(p_eit_decoder->p_cb_data, p_eit_decoder->p_building_eit);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
 
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitEIT(p_eit_decoder, false);
@@ -508,6 +515,30 @@ void dvbpsi_eit_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_private_
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitEITEventIter
+ *****************************************************************************
+ * Start an event cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitEITEventIter(dvbpsi_eit_event_iter_t *p_iter,
+                                    const uint8_t *p_start, const uint8_t *p_end)
+{
+    memset(p_iter, 0, sizeof(dvbpsi_eit_event_iter_t));
+    if (p_end - p_start >= 6)
+    {
+        p_iter->i_ts_id = ((uint16_t)(p_start[0]) << 8) | p_start[1];
+        p_iter->i_network_id = ((uint16_t)(p_start[2]) << 8) | p_start[3];
+        p_iter->i_segment_last_section_number = p_start[4];
+        p_iter->i_last_table_id = p_start[5];
+        p_start += 6;
+    }
+    else
+        p_start = p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_start, p_start);
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_eit_sections_decode
  *****************************************************************************
@@ -517,62 +548,88 @@ void dvbpsi_eit_sections_decode(dvbpsi_t *p_dvbpsi,
                                 dvbpsi_eit_t* p_eit,
                                 dvbpsi_psi_section_t* p_section)
 {
-    uint8_t* p_byte, *p_end;
-
     while (p_section)
     {
         /* EIT Event Descriptions */
-        p_byte = p_section->p_payload_start + 6;
-        p_end  = p_section->p_payload_end;
-
-        while (p_byte < p_end)
+        dvbpsi_eit_event_iter_t iter;
+        dvbpsi_InitEITEventIter(&iter, p_section->p_payload_start,
+                                p_section->p_payload_end);
+        while (dvbpsi_eit_event_iter_next(&iter))
         {
-            uint16_t i_event_id = ((uint16_t)(p_byte[0]) << 8) | p_byte[1];
-            uint64_t i_start_time = ((uint64_t)(p_byte[2]) << 32) |
-                                    ((uint64_t)(p_byte[3]) << 24) |
-                                    ((uint64_t)(p_byte[4]) << 16) |
-                                    ((uint64_t)(p_byte[5]) << 8)  |
-                                    ((uint64_t)(p_byte[6]));
-            uint32_t i_duration = ((uint32_t)(p_byte[7]) << 16) |
-                                  ((uint32_t)(p_byte[8]) << 8)  |
-                                              p_byte[9];
-            uint8_t i_running_status = (uint8_t)(p_byte[10]) >> 5;
-            bool b_free_ca = ((p_byte[10] & 0x10) == 0x10) ? true : false;
-            uint16_t i_ev_length = ((uint16_t)(p_byte[10] & 0xf) << 8) |
-                                               p_byte[11];
             dvbpsi_eit_event_t *p_event = dvbpsi_eit_event_add(p_eit,
-                                                i_event_id, i_start_time, i_duration,
-                                                i_running_status, b_free_ca, i_ev_length);
+                                                iter.i_event_id, iter.i_start_time, iter.i_duration,
+                                                iter.i_running_status, iter.b_free_ca,
+                                                iter.i_descriptors_length);
             if (!p_event)
                 break;
 
             /* Event Descriptors */
-            p_byte += 12;
-            uint8_t *p_ev_end = p_byte + i_ev_length;
-            if (p_ev_end > p_section->p_payload_end)
-                p_ev_end = p_section->p_payload_end;
-            while (p_byte < p_ev_end)
+            while (dvbpsi_descriptor_iter_next(&iter.descriptors))
+                dvbpsi_eit_event_descriptor_add(p_event, iter.descriptors.i_tag,
+                                                iter.descriptors.i_length,
+                                                iter.descriptors.p_data);
+            if (dvbpsi_descriptor_iter_truncated(&iter.descriptors))
             {
-                uint8_t i_tag = p_byte[0];
-                uint8_t i_length = p_byte[1];
-                if (i_length + 2 <= p_ev_end - p_byte)
-                    dvbpsi_eit_event_descriptor_add(p_event, i_tag, i_length, p_byte + 2);
-                else
-                {
-                    dvbpsi_error(p_dvbpsi, "EIT decoder", "failed decoding "
-                        "section %d : descriptor size exceeds event size",
-                        p_section->i_number);
-                    goto next_section;
-                }
-
-                p_byte += 2 + i_length;
+                dvbpsi_error(p_dvbpsi, "EIT decoder", "failed decoding "
+                    "section %d : descriptor size exceeds event size",
+                    p_section->i_number);
+                break;
             }
         }
-    next_section:
         p_section = p_section->p_next;
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_eit_event_iter_init
+ *****************************************************************************/
+bool dvbpsi_eit_event_iter_init(dvbpsi_eit_event_iter_t *p_iter,
+                                const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || p_data[0] < 0x4e || p_data[0] > 0x6f || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitEITEventIter(p_iter, p_start, p_end);
+    p_iter->i_service_id = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_event_iter_next
+ *****************************************************************************/
+bool dvbpsi_eit_event_iter_next(dvbpsi_eit_event_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+    const uint8_t *p_end;
+
+    if (p_iter->p_end - p_byte < 12)
+        return false;
+
+    p_iter->i_event_id = ((uint16_t)(p_byte[0]) << 8) | p_byte[1];
+    p_iter->i_start_time = ((uint64_t)(p_byte[2]) << 32) |
+                           ((uint64_t)(p_byte[3]) << 24) |
+                           ((uint64_t)(p_byte[4]) << 16) |
+                           ((uint64_t)(p_byte[5]) << 8)  |
+                           ((uint64_t)(p_byte[6]));
+    p_iter->i_duration = ((uint32_t)(p_byte[7]) << 16) |
+                         ((uint32_t)(p_byte[8]) << 8)  |
+                                     p_byte[9];
+    p_iter->i_running_status = (uint8_t)(p_byte[10]) >> 5;
+    p_iter->b_free_ca = ((p_byte[10] & 0x10) == 0x10) ? true : false;
+    p_iter->i_descriptors_length = ((uint16_t)(p_byte[10] & 0xf) << 8) |
+                                               p_byte[11];
+
+    p_byte += 12;
+    p_end = p_iter->i_descriptors_length < p_iter->p_end - p_byte ?
+                p_byte + p_iter->i_descriptors_length : p_iter->p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_end);
+    p_iter->p_next = p_end;
+    return true;
+}
+
 /*****************************************************************************
  * NewEITSection
  *****************************************************************************
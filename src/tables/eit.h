@@ -266,7 +266,7 @@ dvbpsi_eit_event_t* dvbpsi_eit_nvod_event_add(dvbpsi_eit_t* p_eit,
  * \fn dvbpsi_descriptor_t* dvbpsi_eit_event_descriptor_add(
                                                dvbpsi_eit_event_t* p_event,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t* p_data)
+                                               const uint8_t* p_data)
  * \brief Add a descriptor to the EIT event.
  * \param p_event pointer to the EIT event structure
  * \param i_tag descriptor's tag
@@ -277,7 +277,7 @@ dvbpsi_eit_event_t* dvbpsi_eit_nvod_event_add(dvbpsi_eit_t* p_eit,
 dvbpsi_descriptor_t* dvbpsi_eit_event_descriptor_add(
                                                dvbpsi_eit_event_t* p_event,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t* p_data);
+                                               const uint8_t* p_data);
 
 /*****************************************************************************
  * dvbpsi_eit_sections_generate
@@ -296,6 +296,69 @@ dvbpsi_descriptor_t* dvbpsi_eit_event_descriptor_add(
 dvbpsi_psi_section_t *dvbpsi_eit_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_eit_t *p_eit,
                                             uint8_t i_table_id);
 
+/*****************************************************************************
+ * dvbpsi_eit_event_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_eit_event_iter_s
+ * \brief Cursor over the events of a raw EIT section.
+ *
+ * The cursor reads the section in place with the parsing of the EIT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections.
+ */
+/*!
+ * \typedef struct dvbpsi_eit_event_iter_s dvbpsi_eit_event_iter_t
+ * \brief dvbpsi_eit_event_iter_t type definition.
+ */
+typedef struct dvbpsi_eit_event_iter_s
+{
+  uint16_t                  i_service_id;       /*!< service_id */
+  uint16_t                  i_ts_id;            /*!< transport_stream_id */
+  uint16_t                  i_network_id;       /*!< original_network_id */
+  uint8_t                   i_segment_last_section_number; /*!< segment last
+                                                     section number */
+  uint8_t                   i_last_table_id;    /*!< last table id */
+
+  uint16_t                  i_event_id;         /*!< event_id */
+  uint64_t                  i_start_time;       /*!< start_time */
+  uint32_t                  i_duration;         /*!< duration */
+  uint8_t                   i_running_status;   /*!< Running status */
+  bool                      b_free_ca;          /*!< Free CA mode flag */
+  uint16_t                  i_descriptors_length; /*!< descriptors_loop_length */
+  dvbpsi_descriptor_iter_t  descriptors;        /*!< event descriptors */
+
+  const uint8_t *           p_next;             /*!< next event, private */
+  const uint8_t *           p_end;              /*!< end of the loop, private */
+} dvbpsi_eit_event_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_eit_event_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_eit_event_iter_init(dvbpsi_eit_event_iter_t *p_iter,
+                                       const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw EIT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not a EIT section (table_id 0x4e to 0x6f) or does
+ * not fit in i_size bytes. The CRC_32 is not checked, see dvbpsi_crc32().
+ */
+bool dvbpsi_eit_event_iter_init(dvbpsi_eit_event_iter_t *p_iter,
+                                const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_eit_event_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_eit_event_iter_next(dvbpsi_eit_event_iter_t *p_iter)
+ * \brief Move the cursor to the next event of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on an event, false at the end of the section.
+ */
+bool dvbpsi_eit_event_iter_next(dvbpsi_eit_event_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
@@ -208,7 +208,7 @@ void dvbpsi_nit_delete(dvbpsi_nit_t *p_nit)
  *****************************************************************************/
 dvbpsi_descriptor_t* dvbpsi_nit_descriptor_add(dvbpsi_nit_t* p_nit,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t* p_data)
+                                               const uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor
                         = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -263,7 +263,7 @@ dvbpsi_nit_ts_t* dvbpsi_nit_ts_add(dvbpsi_nit_t* p_nit,
  *****************************************************************************/
 dvbpsi_descriptor_t* dvbpsi_nit_ts_descriptor_add(dvbpsi_nit_ts_t* p_ts,
                                                   uint8_t i_tag, uint8_t i_length,
-                                                  uint8_t* p_data)
+                                                  const uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor
                         = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -429,22 +429,64 @@ void dvbpsi_nit_sections_gather(dvbpsi_t *p_dvbpsi,
     {
         assert(p_nit_decoder->pf_nit_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_nit_decoder->p_sections);
+
         /* Save the current information */
         p_nit_decoder->current_nit = *p_nit_decoder->p_building_nit;
         p_nit_decoder->b_current_valid = true;
 
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_nit_sections_decode(p_nit_decoder->p_building_nit,
                                    p_nit_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new NIT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_nit_decoder->pf_nit_callback(p_nit_decoder->p_cb_data,
                                        p_nit_decoder->p_building_nit);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitNIT(p_nit_decoder, false);
         assert(p_nit_decoder->p_sections == NULL);
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitNITTSIter
+ *****************************************************************************
+ * Start a TS cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitNITTSIter(dvbpsi_nit_ts_iter_t *p_iter,
+                                 const uint8_t *p_start, const uint8_t *p_end)
+{
+    const uint8_t *p_first_end = p_start;
+
+    memset(p_iter, 0, sizeof(dvbpsi_nit_ts_iter_t));
+    if (p_end - p_start >= 2)
+    {
+        uint16_t i_length = ((uint16_t)(p_start[0] & 0x0f) << 8) | p_start[1];
+        p_start += 2;
+        p_first_end = i_length < p_end - p_start ? p_start + i_length : p_end;
+    }
+    dvbpsi_descriptor_iter_init(&p_iter->network_descriptors, p_start, p_first_end);
+
+    /* transport_stream_loop_length */
+    p_start = p_first_end;
+    if (p_end - p_start >= 2)
+    {
+        uint16_t i_length = ((uint16_t)(p_start[0] & 0x0f) << 8) | p_start[1];
+        p_start += 2;
+        if (i_length < p_end - p_start)
+            p_end = p_start + i_length;
+    }
+    else
+        p_end = p_start;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_start, p_start);
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_nit_sections_decode
  *****************************************************************************
@@ -453,63 +495,72 @@ void dvbpsi_nit_sections_gather(dvbpsi_t *p_dvbpsi,
 void dvbpsi_nit_sections_decode(dvbpsi_nit_t* p_nit,
                                 dvbpsi_psi_section_t* p_section)
 {
-    uint8_t* p_byte, * p_end;
-
     while (p_section)
     {
-        /* - NIT descriptors */
-        p_byte = p_section->p_payload_start + 2;
-        p_end = p_byte + (((uint16_t)(p_section->p_payload_start[0] & 0x0f) << 8)
-                          | p_section->p_payload_start[1]);
+        dvbpsi_nit_ts_iter_t iter;
+        dvbpsi_InitNITTSIter(&iter, p_section->p_payload_start,
+                             p_section->p_payload_end);
 
-        while (p_byte + 2 <= p_end)
-        {
-            uint8_t i_tag = p_byte[0];
-            uint8_t i_length = p_byte[1];
-            if (i_length + 2 <= p_end - p_byte)
-                dvbpsi_nit_descriptor_add(p_nit, i_tag, i_length, p_byte + 2);
-            p_byte += 2 + i_length;
-        }
-
-        /* Transport stream loop length */
-        p_end = 2 + p_byte + (((uint16_t)(p_byte[0] & 0x0f) << 8) | p_byte[1]);
-        if (p_end > p_section->p_payload_end)
-            p_end = p_section->p_payload_end;
-
-        p_byte += 2;
+        /* - NIT descriptors */
+        while (dvbpsi_descriptor_iter_next(&iter.network_descriptors))
+            dvbpsi_nit_descriptor_add(p_nit, iter.network_descriptors.i_tag,
+                                      iter.network_descriptors.i_length, iter.network_descriptors.p_data);
 
         /* - TSs */
-        while(p_byte + 6 <= p_end)
+        while (dvbpsi_nit_ts_iter_next(&iter))
         {
-            uint8_t *p_end2; /* descriptor loop end */
-
-            uint16_t i_ts_id = ((uint16_t)p_byte[0] << 8) | p_byte[1];
-            uint16_t i_orig_network_id = ((uint16_t)p_byte[2] << 8) | p_byte[3];
-            uint16_t i_ts_length = ((uint16_t)(p_byte[4] & 0x0f) << 8) | p_byte[5];
-
-            dvbpsi_nit_ts_t* p_ts = dvbpsi_nit_ts_add(p_nit, i_ts_id, i_orig_network_id);
+            dvbpsi_nit_ts_t* p_ts = dvbpsi_nit_ts_add(p_nit, iter.i_ts_id, iter.i_orig_network_id);
             if (!p_ts)
                 break;
 
             /* - TS descriptors */
-            p_byte += 6;
-            p_end2 = p_byte + i_ts_length;
-            if (p_end2 > p_section->p_payload_end)
-                p_end2 = p_section->p_payload_end;
-
-            while (p_byte + 2 <= p_end2)
-            {
-                uint8_t i_tag = p_byte[0];
-                uint8_t i_length = p_byte[1];
-                if (i_length + 2 <= p_end2 - p_byte)
-                    dvbpsi_nit_ts_descriptor_add(p_ts, i_tag, i_length, p_byte + 2);
-                p_byte += 2 + i_length;
-            }
+            while (dvbpsi_descriptor_iter_next(&iter.descriptors))
+                dvbpsi_nit_ts_descriptor_add(p_ts, iter.descriptors.i_tag,
+                                             iter.descriptors.i_length, iter.descriptors.p_data);
         }
         p_section = p_section->p_next;
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_nit_ts_iter_init
+ *****************************************************************************/
+bool dvbpsi_nit_ts_iter_init(dvbpsi_nit_ts_iter_t *p_iter,
+                             const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || (p_data[0] != 0x40 && p_data[0] != 0x41) || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitNITTSIter(p_iter, p_start, p_end);
+    p_iter->i_network_id = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_nit_ts_iter_next
+ *****************************************************************************/
+bool dvbpsi_nit_ts_iter_next(dvbpsi_nit_ts_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+    const uint8_t *p_end;
+
+    if (p_iter->p_end - p_byte < 6)
+        return false;
+
+    p_iter->i_ts_id = ((uint16_t)p_byte[0] << 8) | p_byte[1];
+    p_iter->i_orig_network_id = ((uint16_t)p_byte[2] << 8) | p_byte[3];
+    uint16_t i_ts_length = ((uint16_t)(p_byte[4] & 0x0f) << 8) | p_byte[5];
+
+    p_byte += 6;
+    p_end = i_ts_length < p_iter->p_end - p_byte ? p_byte + i_ts_length : p_iter->p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_end);
+    p_iter->p_next = p_end;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_nit_sections_generate
  *****************************************************************************
@@ -197,7 +197,7 @@ void dvbpsi_nit_delete(dvbpsi_nit_t *p_nit);
  * \fn dvbpsi_descriptor_t* dvbpsi_nit_descriptor_add(dvbpsi_nit_t* p_nit,
                                                       uint8_t i_tag,
                                                       uint8_t i_length,
-                                                      uint8_t* p_data)
+                                                      const uint8_t* p_data)
  * \brief Add a descriptor in the NIT.
  * \param p_nit pointer to the NIT structure
  * \param i_tag descriptor's tag
@@ -207,7 +207,7 @@ void dvbpsi_nit_delete(dvbpsi_nit_t *p_nit);
  */
 dvbpsi_descriptor_t* dvbpsi_nit_descriptor_add(dvbpsi_nit_t *p_nit,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data);
+                                               const uint8_t *p_data);
 
 /*****************************************************************************
  * dvbpsi_nit_ts_add
@@ -231,7 +231,7 @@ dvbpsi_nit_ts_t* dvbpsi_nit_ts_add(dvbpsi_nit_t* p_nit,
  * \fn dvbpsi_descriptor_t* dvbpsi_nit_ts_descriptor_add(dvbpsi_nit_ts_t* p_ts,
                                                          uint8_t i_tag,
                                                          uint8_t i_length,
-                                                         uint8_t* p_data)
+                                                         const uint8_t* p_data)
  * \brief Add a descriptor in the NIT TS.
  * \param p_ts pointer to the TS structure
  * \param i_tag descriptor's tag
@@ -241,7 +241,7 @@ dvbpsi_nit_ts_t* dvbpsi_nit_ts_add(dvbpsi_nit_t* p_nit,
  */
 dvbpsi_descriptor_t* dvbpsi_nit_ts_descriptor_add(dvbpsi_nit_ts_t* p_ts,
                                                   uint8_t i_tag, uint8_t i_length,
-                                                  uint8_t* p_data);
+                                                  const uint8_t* p_data);
 
 /*****************************************************************************
  * dvbpsi_nit_sections_generate
@@ -260,6 +260,61 @@ dvbpsi_descriptor_t* dvbpsi_nit_ts_descriptor_add(dvbpsi_nit_ts_t* p_ts,
 dvbpsi_psi_section_t* dvbpsi_nit_sections_generate(dvbpsi_t* p_dvbpsi, dvbpsi_nit_t* p_nit,
                                             uint8_t i_table_id);
 
+/*****************************************************************************
+ * dvbpsi_nit_ts_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_nit_ts_iter_s
+ * \brief Cursor over the transport streams of a raw NIT section.
+ *
+ * The cursor reads the section in place with the parsing of the NIT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections.
+ */
+/*!
+ * \typedef struct dvbpsi_nit_ts_iter_s dvbpsi_nit_ts_iter_t
+ * \brief dvbpsi_nit_ts_iter_t type definition.
+ */
+typedef struct dvbpsi_nit_ts_iter_s
+{
+  uint16_t                  i_network_id;       /*!< network_id */
+  dvbpsi_descriptor_iter_t  network_descriptors; /*!< network descriptors */
+
+  uint16_t                  i_ts_id;            /*!< transport_stream_id */
+  uint16_t                  i_orig_network_id;  /*!< original_network_id */
+  dvbpsi_descriptor_iter_t  descriptors;        /*!< TS descriptors */
+
+  const uint8_t *           p_next;             /*!< next TS, private */
+  const uint8_t *           p_end;              /*!< end of the loop, private */
+} dvbpsi_nit_ts_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_nit_ts_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_nit_ts_iter_init(dvbpsi_nit_ts_iter_t *p_iter,
+                                    const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw NIT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not a NIT section (table_id 0x40 or 0x41) or does
+ * not fit in i_size bytes. The CRC_32 is not checked, see dvbpsi_crc32().
+ */
+bool dvbpsi_nit_ts_iter_init(dvbpsi_nit_ts_iter_t *p_iter,
+                             const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_nit_ts_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_nit_ts_iter_next(dvbpsi_nit_ts_iter_t *p_iter)
+ * \brief Move the cursor to the next TS of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on a transport stream, false at the end of the section.
+ */
+bool dvbpsi_nit_ts_iter_next(dvbpsi_nit_ts_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
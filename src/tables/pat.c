@@ -331,18 +331,27 @@ void dvbpsi_pat_sections_gather(dvbpsi_t* p_dvbpsi, dvbpsi_psi_section_t* p_sect
     {
         assert(p_pat_decoder->pf_pat_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_pat_decoder->p_sections);
+
         /* Save the current information */
         p_pat_decoder->current_pat = *p_pat_decoder->p_building_pat;
 
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         if (dvbpsi_pat_sections_decode(p_pat_decoder->p_building_pat,
                                        p_pat_decoder->p_sections))
             p_pat_decoder->b_current_valid = true;
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
 
         /* signal the new PAT */
         if (p_pat_decoder->b_current_valid)
+        {
+            DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
             p_pat_decoder->pf_pat_callback(p_pat_decoder->p_cb_data,
                                            p_pat_decoder->p_building_pat);
+            DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
+        }
 
         /* Delete sectioins and Reinitialize the structures */
         dvbpsi_ReInitPAT(p_pat_decoder, !p_pat_decoder->b_current_valid);
@@ -350,6 +359,21 @@ void dvbpsi_pat_sections_gather(dvbpsi_t* p_dvbpsi, dvbpsi_psi_section_t* p_sect
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitPATProgramIter
+ *****************************************************************************
+ * Start a program cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitPATProgramIter(dvbpsi_pat_program_iter_t *p_iter,
+                                      const uint8_t *p_start, const uint8_t *p_end)
+{
+    p_iter->i_ts_id = 0;
+    p_iter->i_number = 0;
+    p_iter->i_pid = 0;
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_DecodePATSection
  *****************************************************************************
@@ -361,13 +385,12 @@ bool dvbpsi_pat_sections_decode(dvbpsi_pat_t* p_pat, dvbpsi_psi_section_t* p_sec
     bool b_valid = false;
     while (p_section)
     {
-        for (uint8_t *p_byte = p_section->p_payload_start;
-            p_byte < p_section->p_payload_end;
-            p_byte += 4)
+        dvbpsi_pat_program_iter_t iter;
+        dvbpsi_InitPATProgramIter(&iter, p_section->p_payload_start,
+                                  p_section->p_payload_end);
+        while (dvbpsi_pat_program_iter_next(&iter))
         {
-            uint16_t i_program_number = ((uint16_t)(p_byte[0]) << 8) | p_byte[1];
-            uint16_t i_pid = ((uint16_t)(p_byte[2] & 0x1f) << 8) | p_byte[3];
-            dvbpsi_pat_program_t* p_program = dvbpsi_pat_program_add(p_pat, i_program_number, i_pid);
+            dvbpsi_pat_program_t* p_program = dvbpsi_pat_program_add(p_pat, iter.i_number, iter.i_pid);
             if (p_program)
                 b_valid = true;
         }
@@ -377,6 +400,39 @@ bool dvbpsi_pat_sections_decode(dvbpsi_pat_t* p_pat, dvbpsi_psi_section_t* p_sec
     return b_valid;
 }
 
+/*****************************************************************************
+ * dvbpsi_pat_program_iter_init
+ *****************************************************************************/
+bool dvbpsi_pat_program_iter_init(dvbpsi_pat_program_iter_t *p_iter,
+                                  const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || p_data[0] != 0x00 || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitPATProgramIter(p_iter, p_start, p_end);
+    p_iter->i_ts_id = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_pat_program_iter_next
+ *****************************************************************************/
+bool dvbpsi_pat_program_iter_next(dvbpsi_pat_program_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+
+    if (p_iter->p_end - p_byte < 4)
+        return false;
+
+    p_iter->i_number = ((uint16_t)(p_byte[0]) << 8) | p_byte[1];
+    p_iter->i_pid = ((uint16_t)(p_byte[2] & 0x1f) << 8) | p_byte[3];
+    p_iter->p_next = p_byte + 4;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_pat_sections_generate
  *****************************************************************************
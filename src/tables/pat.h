@@ -204,6 +204,59 @@ dvbpsi_pat_program_t* dvbpsi_pat_program_add(dvbpsi_pat_t* p_pat,
 dvbpsi_psi_section_t* dvbpsi_pat_sections_generate(dvbpsi_t *p_dvbpsi,
                                             dvbpsi_pat_t* p_pat, int i_max_pps);
 
+/*****************************************************************************
+ * dvbpsi_pat_program_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_pat_program_iter_s
+ * \brief Cursor over the programs of a raw PAT section.
+ *
+ * The cursor reads the section in place with the parsing of the PAT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections.
+ */
+/*!
+ * \typedef struct dvbpsi_pat_program_iter_s dvbpsi_pat_program_iter_t
+ * \brief dvbpsi_pat_program_iter_t type definition.
+ */
+typedef struct dvbpsi_pat_program_iter_s
+{
+  uint16_t                  i_ts_id;            /*!< transport_stream_id */
+
+  uint16_t                  i_number;           /*!< program_number */
+  uint16_t                  i_pid;              /*!< PID of the NIT or PMT */
+
+  const uint8_t *           p_next;             /*!< next program, private */
+  const uint8_t *           p_end;              /*!< end of the loop, private */
+} dvbpsi_pat_program_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_pat_program_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_pat_program_iter_init(dvbpsi_pat_program_iter_t *p_iter,
+                                         const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw PAT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not a PAT section (table_id 0x00) or does
+ * not fit in i_size bytes. The CRC_32 is not checked, see dvbpsi_crc32().
+ */
+bool dvbpsi_pat_program_iter_init(dvbpsi_pat_program_iter_t *p_iter,
+                                  const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_pat_program_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_pat_program_iter_next(dvbpsi_pat_program_iter_t *p_iter)
+ * \brief Move the cursor to the next program of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on a program, false at the end of the section.
+ */
+bool dvbpsi_pat_program_iter_next(dvbpsi_pat_program_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
@@ -170,7 +170,7 @@ void dvbpsi_pmt_delete(dvbpsi_pmt_t* p_pmt)
  *****************************************************************************/
 dvbpsi_descriptor_t* dvbpsi_pmt_descriptor_add(dvbpsi_pmt_t* p_pmt,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t* p_data)
+                                               const uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor;
     p_descriptor = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -222,7 +222,7 @@ dvbpsi_pmt_es_t* dvbpsi_pmt_es_add(dvbpsi_pmt_t* p_pmt,
  *****************************************************************************/
 dvbpsi_descriptor_t* dvbpsi_pmt_es_descriptor_add(dvbpsi_pmt_es_t* p_es,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t* p_data)
+                                               const uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor;
     p_descriptor = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -388,21 +388,52 @@ void dvbpsi_pmt_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t* p_sect
     {
         assert(p_pmt_decoder->pf_pmt_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_pmt_decoder->p_sections);
+
         /* Save the current information */
         p_pmt_decoder->current_pmt = *p_pmt_decoder->p_building_pmt;
         p_pmt_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_pmt_sections_decode(p_pmt_decoder->p_building_pmt,
                                    p_pmt_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new PMT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_pmt_decoder->pf_pmt_callback(p_pmt_decoder->p_cb_data,
                                        p_pmt_decoder->p_building_pmt);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitPMT(p_pmt_decoder, false);
         assert(p_pmt_decoder->p_sections == NULL);
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitPMTESIter
+ *****************************************************************************
+ * Start an ES cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitPMTESIter(dvbpsi_pmt_es_iter_t *p_iter,
+                                 const uint8_t *p_start, const uint8_t *p_end)
+{
+    const uint8_t *p_info_end = p_start;
+
+    memset(p_iter, 0, sizeof(dvbpsi_pmt_es_iter_t));
+    if (p_end - p_start >= 4)
+    {
+        uint16_t i_info_length = ((uint16_t)(p_start[2] & 0x0f) << 8) | p_start[3];
+        p_iter->i_pcr_pid = ((uint16_t)(p_start[0] & 0x1f) << 8) | p_start[1];
+        p_start += 4;
+        p_info_end = i_info_length < p_end - p_start ? p_start + i_info_length : p_end;
+    }
+    dvbpsi_descriptor_iter_init(&p_iter->program_info, p_start, p_info_end);
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_info_end, p_info_end);
+    p_iter->p_next = p_info_end;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_pmt_sections_decode
  *****************************************************************************
@@ -411,50 +442,72 @@ void dvbpsi_pmt_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t* p_sect
 void dvbpsi_pmt_sections_decode(dvbpsi_pmt_t* p_pmt,
                                 dvbpsi_psi_section_t* p_section)
 {
-    uint8_t* p_byte, * p_end;
-
     while (p_section)
     {
+        dvbpsi_pmt_es_iter_t iter;
+        dvbpsi_InitPMTESIter(&iter, p_section->p_payload_start,
+                             p_section->p_payload_end);
+
         /* - PMT descriptors */
-        p_byte = p_section->p_payload_start + 4;
-        p_end = p_byte + (   ((uint16_t)(p_section->p_payload_start[2] & 0x0f) << 8)
-                           | p_section->p_payload_start[3]);
-        while (p_byte + 2 <= p_end)
-        {
-            uint8_t i_tag = p_byte[0];
-            uint8_t i_length = p_byte[1];
-            if (i_length + 2 <= p_end - p_byte)
-                dvbpsi_pmt_descriptor_add(p_pmt, i_tag, i_length, p_byte + 2);
-            p_byte += 2 + i_length;
-        }
+        while (dvbpsi_descriptor_iter_next(&iter.program_info))
+            dvbpsi_pmt_descriptor_add(p_pmt, iter.program_info.i_tag,
+                                      iter.program_info.i_length, iter.program_info.p_data);
 
         /* - ESs */
-        for (p_byte = p_end; p_byte + 5 <= p_section->p_payload_end;)
+        while (dvbpsi_pmt_es_iter_next(&iter))
         {
-            uint8_t i_type = p_byte[0];
-            uint16_t i_pid = ((uint16_t)(p_byte[1] & 0x1f) << 8) | p_byte[2];
-            uint16_t i_es_length = ((uint16_t)(p_byte[3] & 0x0f) << 8) | p_byte[4];
-            dvbpsi_pmt_es_t* p_es = dvbpsi_pmt_es_add(p_pmt, i_type, i_pid);
+            dvbpsi_pmt_es_t* p_es = dvbpsi_pmt_es_add(p_pmt, iter.i_type, iter.i_pid);
+            if (!p_es)
+                break;
+
             /* - ES descriptors */
-            p_byte += 5;
-            p_end = p_byte + i_es_length;
-            if (p_end > p_section->p_payload_end)
-            {
-                p_end = p_section->p_payload_end;
-            }
-            while (p_byte + 2 <= p_end)
-            {
-                uint8_t i_tag = p_byte[0];
-                uint8_t i_length = p_byte[1];
-                if (i_length + 2 <= p_end - p_byte)
-                    dvbpsi_pmt_es_descriptor_add(p_es, i_tag, i_length, p_byte + 2);
-                p_byte += 2 + i_length;
-            }
+            while (dvbpsi_descriptor_iter_next(&iter.descriptors))
+                dvbpsi_pmt_es_descriptor_add(p_es, iter.descriptors.i_tag,
+                                             iter.descriptors.i_length, iter.descriptors.p_data);
         }
         p_section = p_section->p_next;
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_pmt_es_iter_init
+ *****************************************************************************/
+bool dvbpsi_pmt_es_iter_init(dvbpsi_pmt_es_iter_t *p_iter,
+                             const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || p_data[0] != 0x02 || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitPMTESIter(p_iter, p_start, p_end);
+    p_iter->i_program_number = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_pmt_es_iter_next
+ *****************************************************************************/
+bool dvbpsi_pmt_es_iter_next(dvbpsi_pmt_es_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+    const uint8_t *p_end;
+
+    if (p_iter->p_end - p_byte < 5)
+        return false;
+
+    p_iter->i_type = p_byte[0];
+    p_iter->i_pid = ((uint16_t)(p_byte[1] & 0x1f) << 8) | p_byte[2];
+    uint16_t i_es_length = ((uint16_t)(p_byte[3] & 0x0f) << 8) | p_byte[4];
+
+    p_byte += 5;
+    p_end = i_es_length < p_iter->p_end - p_byte ? p_byte + i_es_length : p_iter->p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_end);
+    p_iter->p_next = p_end;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_pmt_sections_generate
  *****************************************************************************
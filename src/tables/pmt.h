@@ -192,7 +192,7 @@ void dvbpsi_pmt_delete(dvbpsi_pmt_t* p_pmt);
  * \fn dvbpsi_descriptor_t* dvbpsi_pmt_descriptor_add(dvbpsi_pmt_t* p_pmt,
                                                     uint8_t i_tag,
                                                     uint8_t i_length,
-                                                    uint8_t* p_data)
+                                                    const uint8_t* p_data)
  * \brief Add a descriptor in the PMT.
  * \param p_pmt pointer to the PMT structure
  * \param i_tag descriptor's tag
@@ -202,7 +202,7 @@ void dvbpsi_pmt_delete(dvbpsi_pmt_t* p_pmt);
  */
 dvbpsi_descriptor_t* dvbpsi_pmt_descriptor_add(dvbpsi_pmt_t* p_pmt,
                                              uint8_t i_tag, uint8_t i_length,
-                                             uint8_t* p_data);
+                                             const uint8_t* p_data);
 
 /*****************************************************************************
  * dvbpsi_pmt_es_add
@@ -226,7 +226,7 @@ dvbpsi_pmt_es_t* dvbpsi_pmt_es_add(dvbpsi_pmt_t* p_pmt,
  * \fn dvbpsi_descriptor_t* dvbpsi_pmt_es_descriptor_add(dvbpsi_pmt_es_t* p_es,
                                                       uint8_t i_tag,
                                                       uint8_t i_length,
-                                                      uint8_t* p_data)
+                                                      const uint8_t* p_data)
  * \brief Add a descriptor in the PMT ES.
  * \param p_es pointer to the ES structure
  * \param i_tag descriptor's tag
@@ -236,7 +236,7 @@ dvbpsi_pmt_es_t* dvbpsi_pmt_es_add(dvbpsi_pmt_t* p_pmt,
  */
 dvbpsi_descriptor_t* dvbpsi_pmt_es_descriptor_add(dvbpsi_pmt_es_t* p_es,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t* p_data);
+                                               const uint8_t* p_data);
 
 /*****************************************************************************
  * dvbpsi_pmt_sections_generate
@@ -253,6 +253,62 @@ dvbpsi_descriptor_t* dvbpsi_pmt_es_descriptor_add(dvbpsi_pmt_es_t* p_es,
  */
 dvbpsi_psi_section_t* dvbpsi_pmt_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_pmt_t* p_pmt);
 
+/*****************************************************************************
+ * dvbpsi_pmt_es_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_pmt_es_iter_s
+ * \brief Cursor over the elementary streams of a raw PMT section.
+ *
+ * The cursor reads the section in place with the parsing of the PMT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections.
+ */
+/*!
+ * \typedef struct dvbpsi_pmt_es_iter_s dvbpsi_pmt_es_iter_t
+ * \brief dvbpsi_pmt_es_iter_t type definition.
+ */
+typedef struct dvbpsi_pmt_es_iter_s
+{
+  uint16_t                      i_program_number;   /*!< program_number */
+  uint16_t                      i_pcr_pid;          /*!< PCR_PID */
+  dvbpsi_descriptor_iter_t      program_info;       /*!< program descriptors */
+
+  uint8_t                       i_type;             /*!< stream_type */
+  uint16_t                      i_pid;              /*!< elementary_PID */
+  dvbpsi_descriptor_iter_t      descriptors;        /*!< ES descriptors */
+
+  const uint8_t *               p_next;             /*!< next ES, private */
+  const uint8_t *               p_end;              /*!< end of the loop, private */
+} dvbpsi_pmt_es_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_pmt_es_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_pmt_es_iter_init(dvbpsi_pmt_es_iter_t *p_iter,
+                                    const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw PMT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not a PMT section (table_id 0x02) or does
+ * not fit in i_size bytes. The CRC_32 is not checked, see dvbpsi_crc32().
+ */
+bool dvbpsi_pmt_es_iter_init(dvbpsi_pmt_es_iter_t *p_iter,
+                             const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_pmt_es_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_pmt_es_iter_next(dvbpsi_pmt_es_iter_t *p_iter)
+ * \brief Move the cursor to the next ES of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on an ES, false at the end of the section.
+ */
+bool dvbpsi_pmt_es_iter_next(dvbpsi_pmt_es_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
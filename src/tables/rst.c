@@ -380,15 +380,22 @@ void dvbpsi_rst_sections_gather(dvbpsi_t *p_dvbpsi,
     {
         assert(p_rst_decoder->pf_rst_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_rst_decoder->p_sections);
+
         /* Save the current information */
         p_rst_decoder->current_rst = *p_rst_decoder->p_building_rst;
         p_rst_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_rst_sections_decode(p_rst_decoder->p_building_rst,
                                    p_rst_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new CAT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_rst_decoder->pf_rst_callback(p_rst_decoder->p_cb_data,
                                        p_rst_decoder->p_building_rst);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sectioins and Reinitialize the structures */
         dvbpsi_rst_reset(p_rst_decoder, false);
         assert(p_rst_decoder->p_sections == NULL);
@@ -244,7 +244,7 @@ dvbpsi_sdt_service_t *dvbpsi_sdt_service_add(dvbpsi_sdt_t* p_sdt,
 dvbpsi_descriptor_t *dvbpsi_sdt_service_descriptor_add(
                                                dvbpsi_sdt_service_t *p_service,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data)
+                                               const uint8_t *p_data)
 {
     dvbpsi_descriptor_t * p_descriptor;
     p_descriptor = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
@@ -413,21 +413,50 @@ void dvbpsi_sdt_sections_gather(dvbpsi_t *p_dvbpsi,
     {
         assert(p_sdt_decoder->pf_sdt_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_sdt_decoder->p_sections);
+
         /* Save the current information */
         p_sdt_decoder->current_sdt = *p_sdt_decoder->p_building_sdt;
         p_sdt_decoder->b_current_valid = true;
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_sdt_sections_decode(p_sdt_decoder->p_building_sdt,
                                    p_sdt_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new SDT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_sdt_decoder->pf_sdt_callback(p_sdt_decoder->p_cb_data,
                                        p_sdt_decoder->p_building_sdt);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitSDT(p_sdt_decoder, false);
         assert(p_sdt_decoder->p_sections == NULL);
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_InitSDTServiceIter
+ *****************************************************************************
+ * Start a service cursor over a section payload
+ *****************************************************************************/
+static void dvbpsi_InitSDTServiceIter(dvbpsi_sdt_service_iter_t *p_iter,
+                                      const uint8_t *p_start, const uint8_t *p_end)
+{
+    memset(p_iter, 0, sizeof(dvbpsi_sdt_service_iter_t));
+    if (p_end - p_start >= 3)
+    {
+        /* original_network_id, reserved_future_use */
+        p_iter->i_network_id = ((uint16_t)(p_start[0]) << 8) | p_start[1];
+        p_start += 3;
+    }
+    else
+        p_start = p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_start, p_start);
+    p_iter->p_next = p_start;
+    p_iter->p_end = p_end;
+}
+
 /*****************************************************************************
  * dvbpsi_sdt_sections_decode
  *****************************************************************************
@@ -436,41 +465,71 @@ void dvbpsi_sdt_sections_gather(dvbpsi_t *p_dvbpsi,
 void dvbpsi_sdt_sections_decode(dvbpsi_sdt_t* p_sdt,
                                 dvbpsi_psi_section_t* p_section)
 {
-    uint8_t *p_byte, *p_end;
-
     while (p_section)
     {
-        for (p_byte = p_section->p_payload_start + 3;
-             p_byte + 4 < p_section->p_payload_end;)
+        dvbpsi_sdt_service_iter_t iter;
+        dvbpsi_InitSDTServiceIter(&iter, p_section->p_payload_start,
+                                  p_section->p_payload_end);
+        while (dvbpsi_sdt_service_iter_next(&iter))
         {
-            uint16_t i_service_id = ((uint16_t)(p_byte[0]) << 8) | p_byte[1];
-            bool b_eit_schedule = ((p_byte[2] & 0x2) >> 1);
-            bool b_eit_present =  ((p_byte[2]) & 0x1);
-            uint8_t i_running_status = (uint8_t)(p_byte[3]) >> 5;
-            bool b_free_ca = ((p_byte[3] & 0x10) >> 4);
-            uint16_t i_srv_length = ((uint16_t)(p_byte[3] & 0xf) <<8) | p_byte[4];
             dvbpsi_sdt_service_t* p_service = dvbpsi_sdt_service_add(p_sdt,
-                    i_service_id, b_eit_schedule, b_eit_present,
-                    i_running_status, b_free_ca);
+                    iter.i_service_id, iter.b_eit_schedule, iter.b_eit_present,
+                    iter.i_running_status, iter.b_free_ca);
+            if (!p_service)
+                break;
 
             /* Service descriptors */
-            p_byte += 5;
-            p_end = p_byte + i_srv_length;
-            if( p_end > p_section->p_payload_end ) break;
-
-            while(p_byte + 2 <= p_end)
-            {
-                uint8_t i_tag = p_byte[0];
-                uint8_t i_length = p_byte[1];
-                if (i_length + 2 <= p_end - p_byte)
-                    dvbpsi_sdt_service_descriptor_add(p_service, i_tag, i_length, p_byte + 2);
-                p_byte += 2 + i_length;
-            }
+            while (dvbpsi_descriptor_iter_next(&iter.descriptors))
+                dvbpsi_sdt_service_descriptor_add(p_service, iter.descriptors.i_tag,
+                                                  iter.descriptors.i_length,
+                                                  iter.descriptors.p_data);
         }
         p_section = p_section->p_next;
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_sdt_service_iter_init
+ *****************************************************************************/
+bool dvbpsi_sdt_service_iter_init(dvbpsi_sdt_service_iter_t *p_iter,
+                                  const uint8_t *p_data, size_t i_size)
+{
+    const uint8_t *p_start, *p_end;
+
+    if (i_size < 3 || (p_data[0] != 0x42 && p_data[0] != 0x46) || !(p_data[1] & 0x80)
+        || !dvbpsi_section_payload(p_data, i_size, &p_start, &p_end))
+        return false;
+
+    dvbpsi_InitSDTServiceIter(p_iter, p_start, p_end);
+    p_iter->i_ts_id = ((uint16_t)(p_data[3]) << 8) | p_data[4];
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_sdt_service_iter_next
+ *****************************************************************************/
+bool dvbpsi_sdt_service_iter_next(dvbpsi_sdt_service_iter_t *p_iter)
+{
+    const uint8_t *p_byte = p_iter->p_next;
+    const uint8_t *p_end;
+
+    if (p_iter->p_end - p_byte < 5)
+        return false;
+
+    p_iter->i_service_id = ((uint16_t)(p_byte[0]) << 8) | p_byte[1];
+    p_iter->b_eit_schedule = ((p_byte[2] & 0x2) >> 1);
+    p_iter->b_eit_present = ((p_byte[2]) & 0x1);
+    p_iter->i_running_status = (uint8_t)(p_byte[3]) >> 5;
+    p_iter->b_free_ca = ((p_byte[3] & 0x10) >> 4);
+    uint16_t i_srv_length = ((uint16_t)(p_byte[3] & 0xf) << 8) | p_byte[4];
+
+    p_byte += 5;
+    p_end = i_srv_length < p_iter->p_end - p_byte ? p_byte + i_srv_length : p_iter->p_end;
+    dvbpsi_descriptor_iter_init(&p_iter->descriptors, p_byte, p_end);
+    p_iter->p_next = p_end;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_sdt_sections_generate
  *****************************************************************************
@@ -223,7 +223,7 @@ dvbpsi_sdt_service_t *dvbpsi_sdt_service_add(dvbpsi_sdt_t* p_sdt,
  * \fn dvbpsi_descriptor_t *dvbpsi_sdt_service_descriptor_add(
                                                dvbpsi_sdt_service_t *p_service,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data)
+                                               const uint8_t *p_data)
  * \brief Add a descriptor in the SDT service.
  * \param p_service pointer to the service structure
  * \param i_tag descriptor's tag
@@ -234,7 +234,7 @@ dvbpsi_sdt_service_t *dvbpsi_sdt_service_add(dvbpsi_sdt_t* p_sdt,
 dvbpsi_descriptor_t *dvbpsi_sdt_service_descriptor_add(
                                                dvbpsi_sdt_service_t *p_service,
                                                uint8_t i_tag, uint8_t i_length,
-                                               uint8_t *p_data);
+                                               const uint8_t *p_data);
 
 /*****************************************************************************
  * dvbpsi_sdt_sections_generate
@@ -253,6 +253,65 @@ dvbpsi_descriptor_t *dvbpsi_sdt_service_descriptor_add(
  */
 dvbpsi_psi_section_t *dvbpsi_sdt_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_sdt_t * p_sdt);
 
+/*****************************************************************************
+ * dvbpsi_sdt_service_iter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_sdt_service_iter_s
+ * \brief Cursor over the services of a raw SDT section.
+ *
+ * The cursor reads the section in place with the parsing of the SDT
+ * decoder, without allocation. It works on the sections given to a
+ * dvbpsi_section_cb as well as on stored sections.
+ */
+/*!
+ * \typedef struct dvbpsi_sdt_service_iter_s dvbpsi_sdt_service_iter_t
+ * \brief dvbpsi_sdt_service_iter_t type definition.
+ */
+typedef struct dvbpsi_sdt_service_iter_s
+{
+  uint16_t                  i_ts_id;            /*!< transport_stream_id */
+  uint16_t                  i_network_id;       /*!< original_network_id */
+
+  uint16_t                  i_service_id;       /*!< service_id */
+  bool                      b_eit_schedule;     /*!< EIT schedule flag */
+  bool                      b_eit_present;      /*!< EIT present/following
+                                                     flag */
+  uint8_t                   i_running_status;   /*!< Running status */
+  bool                      b_free_ca;          /*!< Free CA mode flag */
+  dvbpsi_descriptor_iter_t  descriptors;        /*!< service descriptors */
+
+  const uint8_t *           p_next;             /*!< next service, private */
+  const uint8_t *           p_end;              /*!< end of the loop, private */
+} dvbpsi_sdt_service_iter_t;
+
+/*****************************************************************************
+ * dvbpsi_sdt_service_iter_init
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sdt_service_iter_init(dvbpsi_sdt_service_iter_t *p_iter,
+                                         const uint8_t *p_data, size_t i_size)
+ * \brief Start a cursor over a raw SDT section.
+ * \param p_iter pointer to the cursor
+ * \param p_data pointer to the section, starting with its table_id
+ * \param i_size number of bytes available at p_data
+ * \return false if the section is not a SDT section (table_id 0x42 or 0x46) or does
+ * not fit in i_size bytes. The CRC_32 is not checked, see dvbpsi_crc32().
+ */
+bool dvbpsi_sdt_service_iter_init(dvbpsi_sdt_service_iter_t *p_iter,
+                                  const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_sdt_service_iter_next
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sdt_service_iter_next(dvbpsi_sdt_service_iter_t *p_iter)
+ * \brief Move the cursor to the next service of the section.
+ * \param p_iter pointer to the cursor
+ * \return true if the cursor is on a service, false at the end of the section.
+ */
+bool dvbpsi_sdt_service_iter_next(dvbpsi_sdt_service_iter_t *p_iter);
+
 #ifdef __cplusplus
 };
 #endif
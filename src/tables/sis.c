@@ -53,8 +53,9 @@
  *****************************************************************************
  * Initialize a SIS subtable decoder.
  *****************************************************************************/
-bool dvbpsi_sis_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
-                      dvbpsi_sis_callback pf_callback, void* p_cb_data)
+static bool dvbpsi_sis_Attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                              dvbpsi_sis_t *p_storage, dvbpsi_sis_callback pf_callback,
+                              void* p_cb_data)
 {
     assert(p_dvbpsi);
     assert(p_dvbpsi->p_decoder);
@@ -94,11 +95,36 @@ bool dvbpsi_sis_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
     /* SIS decoder information */
     p_sis_decoder->pf_sis_callback = pf_callback;
     p_sis_decoder->p_cb_data = p_cb_data;
+    p_sis_decoder->pf_decrypt = NULL;
+    p_sis_decoder->p_decrypt_data = NULL;
     p_sis_decoder->p_building_sis = NULL;
+    p_sis_decoder->p_storage = p_storage;
 
     return true;
 }
 
+bool dvbpsi_sis_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                      dvbpsi_sis_callback pf_callback, void* p_cb_data)
+{
+    return dvbpsi_sis_Attach(p_dvbpsi, i_table_id, i_extension, NULL,
+                             pf_callback, p_cb_data);
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_attach_storage
+ *****************************************************************************
+ * Initialize a SIS subtable decoder decoding into a caller provided SIS.
+ *****************************************************************************/
+bool dvbpsi_sis_attach_storage(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                               uint16_t i_extension, dvbpsi_sis_t *p_sis,
+                               dvbpsi_sis_callback pf_callback, void* p_cb_data)
+{
+    assert(p_sis);
+
+    return dvbpsi_sis_Attach(p_dvbpsi, i_table_id, i_extension, p_sis,
+                             pf_callback, p_cb_data);
+}
+
 /*****************************************************************************
  * dvbpsi_sis_detach
  *****************************************************************************
@@ -127,7 +153,8 @@ void dvbpsi_sis_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
 
     dvbpsi_sis_decoder_t* p_sis_decoder;
     p_sis_decoder = (dvbpsi_sis_decoder_t*)p_subdec->p_decoder;
-    if (p_sis_decoder->p_building_sis)
+    if (p_sis_decoder->p_building_sis &&
+        p_sis_decoder->p_building_sis != p_sis_decoder->p_storage)
         dvbpsi_sis_delete(p_sis_decoder->p_building_sis);
     p_sis_decoder->p_building_sis = NULL;
 
@@ -135,6 +162,58 @@ void dvbpsi_sis_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
     dvbpsi_DeleteDemuxSubDecoder(p_subdec);
 }
 
+/*****************************************************************************
+ * dvbpsi_sis_GetSubDec
+ *****************************************************************************
+ * The demux API is deprecated for applications, the library still builds
+ * its subtable decoders on it.
+ *****************************************************************************/
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+static dvbpsi_demux_subdec_t *dvbpsi_sis_GetSubDec(dvbpsi_demux_t *p_demux,
+                                                   uint8_t i_table_id, uint16_t i_extension)
+{
+    return dvbpsi_demuxGetSubDec(p_demux, i_table_id, i_extension);
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/*****************************************************************************
+ * dvbpsi_sis_set_decrypt
+ *****************************************************************************
+ * Install the decryption callback of a SIS decoder.
+ *****************************************************************************/
+bool dvbpsi_sis_set_decrypt(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                            dvbpsi_sis_crypt_callback pf_decrypt, void *p_cb_data)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_demux_t *p_demux = (dvbpsi_demux_t *) p_dvbpsi->p_decoder;
+
+    /* SIS decoders are always attached with an extension of 0 */
+    const uint16_t i_sis_extension = 0;
+    dvbpsi_demux_subdec_t* p_subdec;
+    p_subdec = dvbpsi_sis_GetSubDec(p_demux, i_table_id, i_sis_extension);
+    if (p_subdec == NULL)
+    {
+        dvbpsi_error(p_dvbpsi, "SIS Decoder",
+                         "No such SIS decoder (table_id == 0x%02x,"
+                         "extension == 0x%02x)",
+                         i_table_id, i_extension);
+        return false;
+    }
+
+    dvbpsi_sis_decoder_t* p_sis_decoder;
+    p_sis_decoder = (dvbpsi_sis_decoder_t*)p_subdec->p_decoder;
+    p_sis_decoder->pf_decrypt = pf_decrypt;
+    p_sis_decoder->p_decrypt_data = p_cb_data;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_sis_init
  *****************************************************************************
@@ -143,6 +222,8 @@ void dvbpsi_sis_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
 void dvbpsi_sis_init(dvbpsi_sis_t *p_sis, uint8_t i_table_id, uint16_t i_extension,
                      uint8_t i_version, bool b_current_next, uint8_t i_protocol_version)
 {
+    memset(p_sis, 0, sizeof(dvbpsi_sis_t));
+
     p_sis->i_table_id = i_table_id;
     p_sis->i_extension = i_extension;
 
@@ -158,19 +239,17 @@ void dvbpsi_sis_init(dvbpsi_sis_t *p_sis, uint8_t i_table_id, uint16_t i_extensi
 
     p_sis->i_pts_adjustment = (uint64_t)0;
     p_sis->cw_index = 0;
+    p_sis->i_tier = 0xfff;
 
     /* splice command */
     p_sis->i_splice_command_length = 0;
     p_sis->i_splice_command_type = 0x00;
-
-    /* FIXME: splice_info_section comes here */
+    p_sis->p_splice_command = NULL;
 
     /* descriptors */
     p_sis->i_descriptors_length = 0;
     p_sis->p_first_descriptor = NULL;
 
-    /* FIXME: alignment stuffing */
-
     p_sis->i_ecrc = 0;
 }
 
@@ -196,12 +275,13 @@ dvbpsi_sis_t* dvbpsi_sis_new(uint8_t i_table_id, uint16_t i_extension, uint8_t i
  *****************************************************************************/
 void dvbpsi_sis_empty(dvbpsi_sis_t* p_sis)
 {
-    /* FIXME: free splice_command_sections */
+    /* The splice command lives in the embedded storage */
+    p_sis->p_splice_command = NULL;
+    p_sis->b_splice_command_valid = false;
+    p_sis->i_segmentation_count = 0;
 
     dvbpsi_DeleteDescriptors(p_sis->p_first_descriptor);
     p_sis->p_first_descriptor = NULL;
-
-    /* FIXME: free alignment stuffing */
 }
 
 /*****************************************************************************
@@ -250,7 +330,8 @@ static void dvbpsi_ReInitSIS(dvbpsi_sis_decoder_t* p_decoder, const bool b_force
     if (b_force)
     {
         /* Free structures */
-        if (p_decoder->p_building_sis)
+        if (p_decoder->p_building_sis &&
+            p_decoder->p_building_sis != p_decoder->p_storage)
             dvbpsi_sis_delete(p_decoder->p_building_sis);
     }
     p_decoder->p_building_sis = NULL;
@@ -307,7 +388,15 @@ static bool dvbpsi_AddSectionSIS(dvbpsi_t *p_dvbpsi, dvbpsi_sis_decoder_t *p_sis
     /* Initialize the structures if it's the first section received */
     if (!p_sis_decoder->p_building_sis)
     {
-        p_sis_decoder->p_building_sis = dvbpsi_sis_new(
+        if (p_sis_decoder->p_storage)
+        {
+            p_sis_decoder->p_building_sis = p_sis_decoder->p_storage;
+            dvbpsi_sis_init(p_sis_decoder->p_building_sis,
+                            p_section->i_table_id, p_section->i_extension,
+                            p_section->i_version, p_section->b_current_next, 0);
+        }
+        else
+            p_sis_decoder->p_building_sis = dvbpsi_sis_new(
                             p_section->i_table_id, p_section->i_extension,
                             p_section->i_version, p_section->b_current_next, 0);
         if (p_sis_decoder->p_building_sis == NULL)
@@ -317,7 +406,7 @@ static bool dvbpsi_AddSectionSIS(dvbpsi_t *p_dvbpsi, dvbpsi_sis_decoder_t *p_sis
 
     /* Add to linked list of sections */
     if (dvbpsi_decoder_psi_section_add(DVBPSI_DECODER(p_sis_decoder), p_section))
-        dvbpsi_debug(p_dvbpsi, "SDT decoder", "overwrite section number %d",
+        dvbpsi_debug(p_dvbpsi, "SIS decoder", "overwrite section number %d",
                      p_section->i_number);
 
     return true;
@@ -363,26 +452,14 @@ void dvbpsi_sis_sections_gather(dvbpsi_t *p_dvbpsi,
     }
     else
     {
-        /* Perform a few sanity checks */
+        /* Perform a few sanity checks. A splice_info_section has no
+         * version_number, every valid section carries a new command and is
+         * delivered as soon as it is received. */
         if (p_sis_decoder->p_building_sis)
         {
             if (dvbpsi_CheckSIS(p_dvbpsi, p_sis_decoder, p_section))
                 dvbpsi_ReInitSIS(p_sis_decoder, true);
         }
-        else
-        {
-            if(     (p_sis_decoder->b_current_valid)
-                 && (p_sis_decoder->current_sis.i_version == p_section->i_version)
-                 && (p_sis_decoder->current_sis.b_current_next == p_section->b_current_next))
-             {
-                 /* Don't decode since this version is already decoded */
-                 dvbpsi_debug(p_dvbpsi, "SIT decoder",
-                             "ignoring already decoded section %d",
-                             p_section->i_number);
-                 dvbpsi_DeletePSISections(p_section);
-                 return;
-             }
-        }
     }
 
     /* Add section to SIS */
@@ -399,15 +476,21 @@ void dvbpsi_sis_sections_gather(dvbpsi_t *p_dvbpsi,
     {
         assert(p_sis_decoder->pf_sis_callback);
 
-        /* Save the current information */
-        p_sis_decoder->current_sis = *p_sis_decoder->p_building_sis;
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_sis_decoder->p_sections);
+
         p_sis_decoder->b_current_valid = true;
         /* Decode the sections */
-        dvbpsi_sis_sections_decode(p_dvbpsi, p_sis_decoder->p_building_sis,
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
+        dvbpsi_sis_sections_decode(p_dvbpsi, p_sis_decoder,
+                                   p_sis_decoder->p_building_sis,
                                    p_sis_decoder->p_sections);
-        /* signal the new SDT */
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
+        /* signal the new SIS */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_sis_decoder->pf_sis_callback(p_sis_decoder->p_cb_data,
                                        p_sis_decoder->p_building_sis);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitSIS(p_sis_decoder, false);
         assert(p_sis_decoder->p_sections == NULL);
@@ -415,164 +498,1044 @@ void dvbpsi_sis_sections_gather(dvbpsi_t *p_dvbpsi,
 }
 
 /*****************************************************************************
- * dvbpsi_sis_sections_decode
+ * dvbpsi_sis_Get33/dvbpsi_sis_Get40
  *****************************************************************************
- * SIS decoder.
+ * Read a 33 bits time stamp (reserved bits in front) or a 40 bits duration.
+ *****************************************************************************/
+static inline uint64_t dvbpsi_sis_Get33(const uint8_t *p)
+{
+    return ((uint64_t)(p[0] & 0x01) << 32) | ((uint64_t)p[1] << 24) |
+           ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 8) | (uint64_t)p[4];
+}
+
+static inline uint64_t dvbpsi_sis_Get40(const uint8_t *p)
+{
+    return ((uint64_t)p[0] << 32) | ((uint64_t)p[1] << 24) |
+           ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 8) | (uint64_t)p[4];
+}
+
+static inline uint32_t dvbpsi_sis_Get32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_decoder_ctx_t
+ *****************************************************************************
+ * Allocation state of the embedded storage while decoding one section.
  *****************************************************************************/
-void dvbpsi_sis_sections_decode(dvbpsi_t* p_dvbpsi, dvbpsi_sis_t* p_sis,
-                              dvbpsi_psi_section_t* p_section)
+typedef struct dvbpsi_sis_decoder_ctx_s
 {
-    uint8_t *p_byte, *p_end;
+    dvbpsi_sis_t    *p_sis;
 
-    while (p_section)
+    unsigned int    i_splice_time;
+    unsigned int    i_component;
+    unsigned int    i_event;
+    unsigned int    i_utc_component;
+    unsigned int    i_break_duration;
+    unsigned int    i_segmentation_component;
+} dvbpsi_sis_decoder_ctx_t;
+
+#define SIS_STORAGE_GET(ctx, array, counter, max)                          \
+    (((ctx)->counter < (max)) ? &(ctx)->p_sis->storage.array[(ctx)->counter++] \
+                              : NULL)
+
+/*****************************************************************************
+ * dvbpsi_sis_DecodeSpliceTime
+ *****************************************************************************
+ * splice_time(), returns the first byte after it or NULL on error.
+ *****************************************************************************/
+static const uint8_t *dvbpsi_sis_DecodeSpliceTime(dvbpsi_sis_decoder_ctx_t *p_ctx,
+                                                  const uint8_t *p, const uint8_t *p_end,
+                                                  dvbpsi_sis_splice_time_t **pp_time)
+{
+    if (p + 1 > p_end)
+        return NULL;
+
+    dvbpsi_sis_splice_time_t *p_time = SIS_STORAGE_GET(p_ctx, splice_time,
+                               i_splice_time, DVBPSI_SIS_MAX_COMPONENTS + 1);
+    if (!p_time)
+        return NULL;
+
+    p_time->p_next = NULL;
+    p_time->b_time_specified_flag = ((p[0] & 0x80) == 0x80);
+    p_time->i_pts_time = 0;
+    *pp_time = p_time;
+
+    if (!p_time->b_time_specified_flag)
+        return p + 1;
+
+    if (p + 5 > p_end)
+        return NULL;
+    p_time->i_pts_time = dvbpsi_sis_Get33(p);
+    return p + 5;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_DecodeBreakDuration
+ *****************************************************************************
+ * break_duration(), returns the first byte after it or NULL on error.
+ *****************************************************************************/
+static const uint8_t *dvbpsi_sis_DecodeBreakDuration(dvbpsi_sis_decoder_ctx_t *p_ctx,
+                                                     const uint8_t *p, const uint8_t *p_end,
+                                                     dvbpsi_sis_break_duration_t **pp_duration)
+{
+    if (p + 5 > p_end)
+        return NULL;
+
+    dvbpsi_sis_break_duration_t *p_duration = SIS_STORAGE_GET(p_ctx, break_duration,
+                               i_break_duration, DVBPSI_SIS_MAX_SPLICE_EVENTS);
+    if (!p_duration)
+        return NULL;
+
+    p_duration->b_auto_return = ((p[0] & 0x80) == 0x80);
+    p_duration->i_duration = dvbpsi_sis_Get33(p);
+    *pp_duration = p_duration;
+    return p + 5;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_DecodeSpliceSchedule
+ *****************************************************************************
+ * splice_schedule(), returns the first byte after it or NULL on error.
+ *****************************************************************************/
+static const uint8_t *dvbpsi_sis_DecodeSpliceSchedule(dvbpsi_sis_decoder_ctx_t *p_ctx,
+                                                      const uint8_t *p, const uint8_t *p_end)
+{
+    dvbpsi_sis_cmd_splice_schedule_t *p_cmd = &p_ctx->p_sis->cmd.splice_schedule;
+    dvbpsi_sis_splice_event_t **pp_last = &p_cmd->p_splice_event;
+
+    if (p + 1 > p_end)
+        return NULL;
+    p_cmd->i_splice_count = p[0];
+    p_cmd->p_splice_event = NULL;
+    p++;
+
+    for (int i = 0; i < p_cmd->i_splice_count; i++)
     {
-        for (p_byte = p_section->p_payload_start + 3;
-             p_byte < p_section->p_payload_end; )
+        if (p + 5 > p_end)
+            return NULL;
+
+        dvbpsi_sis_splice_event_t *p_event = SIS_STORAGE_GET(p_ctx, event,
+                                       i_event, DVBPSI_SIS_MAX_SPLICE_EVENTS);
+        if (!p_event)
+            return NULL;
+        memset(p_event, 0, sizeof(dvbpsi_sis_splice_event_t));
+        *pp_last = p_event;
+        pp_last = &p_event->p_next;
+
+        p_event->i_splice_event_id = dvbpsi_sis_Get32(p);
+        p_event->b_splice_event_cancel_indicator = ((p[4] & 0x80) == 0x80);
+        p += 5;
+        if (p_event->b_splice_event_cancel_indicator)
+            continue;
+
+        if (p + 1 > p_end)
+            return NULL;
+        p_event->b_out_of_network_indicator = ((p[0] & 0x80) == 0x80);
+        p_event->b_program_splice_flag = ((p[0] & 0x40) == 0x40);
+        p_event->b_duration_flag = ((p[0] & 0x20) == 0x20);
+        p++;
+
+        if (p_event->b_program_splice_flag)
         {
-            p_sis->i_protocol_version = p_byte[3];
-            p_sis->b_encrypted_packet = ((p_byte[4] & 0x80) == 0x80);
-            /* NOTE: cannot handle encrypted packet */
-            assert(p_sis->b_encrypted_packet);
-            p_sis->i_encryption_algorithm = ((p_byte[4] & 0x7E) >> 1);
-            p_sis->i_pts_adjustment = ((((uint64_t)p_byte[4] & 0x01) << 32) |
-                                        ((uint64_t)p_byte[5] << 24) |
-                                        ((uint64_t)p_byte[6] << 16) |
-                                        ((uint64_t)p_byte[7] << 8)  |
-                                         (uint64_t)p_byte[8]);
-            p_sis->cw_index = p_byte[9];
-            p_sis->i_splice_command_length = ((p_byte[11] & 0x0F) << 8) | p_byte[12];
-            p_sis->i_splice_command_type = p_byte[13];
+            if (p + 4 > p_end)
+                return NULL;
+            p_event->i_utc_splice_time = dvbpsi_sis_Get32(p);
+            p += 4;
+        }
+        else
+        {
+            if (p + 1 > p_end)
+                return NULL;
+            p_event->i_component_count = p[0];
+            p++;
 
-            uint32_t i_splice_command_length = p_sis->i_splice_command_length;
-            if (p_sis->i_splice_command_length == 0xfff)
+            dvbpsi_sis_component_utc_splice_time_t **pp_comp = &p_event->p_data;
+            for (int j = 0; j < p_event->i_component_count; j++)
             {
-                /* FIXME: size 0xfff of splice_command_section is undefined */
-                assert(p_sis->i_splice_command_length != 0xfff);
+                if (p + 5 > p_end)
+                    return NULL;
+                dvbpsi_sis_component_utc_splice_time_t *p_comp =
+                        SIS_STORAGE_GET(p_ctx, utc_component, i_utc_component,
+                                        DVBPSI_SIS_MAX_COMPONENTS);
+                if (!p_comp)
+                    return NULL;
+                p_comp->component_tag = p[0];
+                p_comp->i_utc_splice_time = dvbpsi_sis_Get32(p + 1);
+                p_comp->p_next = NULL;
+                *pp_comp = p_comp;
+                pp_comp = &p_comp->p_next;
+                p += 5;
             }
+        }
+
+        if (p_event->b_duration_flag)
+        {
+            p = dvbpsi_sis_DecodeBreakDuration(p_ctx, p, p_end,
+                                               &p_event->p_break_duration);
+            if (!p)
+                return NULL;
+        }
+
+        if (p + 4 > p_end)
+            return NULL;
+        p_event->i_unique_program_id = ((uint16_t)p[0] << 8) | p[1];
+        p_event->i_avail_num = p[2];
+        p_event->i_avails_expected = p[3];
+        p += 4;
+    }
+
+    return p;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_DecodeSpliceInsert
+ *****************************************************************************
+ * splice_insert(), returns the first byte after it or NULL on error.
+ *****************************************************************************/
+static const uint8_t *dvbpsi_sis_DecodeSpliceInsert(dvbpsi_sis_decoder_ctx_t *p_ctx,
+                                                    const uint8_t *p, const uint8_t *p_end)
+{
+    dvbpsi_sis_cmd_splice_insert_t *p_cmd = &p_ctx->p_sis->cmd.splice_insert;
+
+    if (p + 5 > p_end)
+        return NULL;
+    p_cmd->i_splice_event_id = dvbpsi_sis_Get32(p);
+    p_cmd->b_splice_event_cancel_indicator = ((p[4] & 0x80) == 0x80);
+    p += 5;
+    if (p_cmd->b_splice_event_cancel_indicator)
+        return p;
+
+    if (p + 1 > p_end)
+        return NULL;
+    p_cmd->b_out_of_network_indicator = ((p[0] & 0x80) == 0x80);
+    p_cmd->b_program_splice_flag = ((p[0] & 0x40) == 0x40);
+    p_cmd->b_duration_flag = ((p[0] & 0x20) == 0x20);
+    p_cmd->b_splice_immediate_flag = ((p[0] & 0x10) == 0x10);
+    p++;
+
+    if (p_cmd->b_program_splice_flag)
+    {
+        if (!p_cmd->b_splice_immediate_flag)
+        {
+            p = dvbpsi_sis_DecodeSpliceTime(p_ctx, p, p_end, &p_cmd->p_splice_time);
+            if (!p)
+                return NULL;
+        }
+    }
+    else
+    {
+        if (p + 1 > p_end)
+            return NULL;
+        p_cmd->i_component_count = p[0];
+        p++;
 
-            /* FIXME: handle splice_command_sections */
-            switch(p_sis->i_splice_command_type)
+        dvbpsi_sis_component_splice_time_t **pp_comp = &p_cmd->p_data;
+        for (int i = 0; i < p_cmd->i_component_count; i++)
+        {
+            if (p + 1 > p_end)
+                return NULL;
+            dvbpsi_sis_component_splice_time_t *p_comp =
+                    SIS_STORAGE_GET(p_ctx, component, i_component,
+                                    DVBPSI_SIS_MAX_COMPONENTS);
+            if (!p_comp)
+                return NULL;
+            p_comp->i_component_tag = p[0];
+            p_comp->p_splice_time = NULL;
+            p_comp->p_next = NULL;
+            *pp_comp = p_comp;
+            pp_comp = &p_comp->p_next;
+            p++;
+
+            if (!p_cmd->b_splice_immediate_flag)
             {
-                case 0x00: /* splice_null */
-                case 0x04: /* splice_schedule */
-                case 0x05: /* splice_insert */
-                case 0x06: /* time_signal */
-                case 0x07: /* bandwidth_reservation */
-                    break;
-                default:
-                    dvbpsi_error(p_dvbpsi, "SIS decoder", "invalid SIS Command found");
-                    break;
+                p = dvbpsi_sis_DecodeSpliceTime(p_ctx, p, p_end, &p_comp->p_splice_time);
+                if (!p)
+                    return NULL;
             }
+        }
+    }
+
+    if (p_cmd->b_duration_flag)
+    {
+        p = dvbpsi_sis_DecodeBreakDuration(p_ctx, p, p_end, &p_cmd->p_break_duration);
+        if (!p)
+            return NULL;
+    }
+
+    if (p + 4 > p_end)
+        return NULL;
+    p_cmd->i_unique_program_id = ((uint16_t)p[0] << 8) | p[1];
+    p_cmd->i_avail_num = p[2];
+    p_cmd->i_avails_expected = p[3];
+    return p + 4;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_DecodePrivateCommand
+ *****************************************************************************
+ * private_command(), the private bytes extend up to the end of the command.
+ *****************************************************************************/
+static const uint8_t *dvbpsi_sis_DecodePrivateCommand(dvbpsi_sis_decoder_ctx_t *p_ctx,
+                                                      const uint8_t *p, const uint8_t *p_end)
+{
+    dvbpsi_sis_cmd_private_t *p_cmd = &p_ctx->p_sis->cmd.private_command;
+
+    if (p + 4 > p_end)
+        return NULL;
+    p_cmd->i_identifier = dvbpsi_sis_Get32(p);
+    p += 4;
+
+    if (p_end - p > DVBPSI_SIS_MAX_PRIVATE_BYTES)
+        return NULL;
+    p_cmd->i_length = p_end - p;
+    memcpy(p_cmd->p_private_byte, p, p_cmd->i_length);
+    return p_end;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_DecodeSegmentation
+ *****************************************************************************
+ * segmentation_descriptor() payload following the identifier.
+ *****************************************************************************/
+static bool dvbpsi_sis_DecodeSegmentation(dvbpsi_sis_decoder_ctx_t *p_ctx,
+                                          const uint8_t *p, const uint8_t *p_end,
+                                          dvbpsi_sis_segmentation_t *p_seg)
+{
+    memset(p_seg, 0, sizeof(dvbpsi_sis_segmentation_t));
+
+    if (p + 5 > p_end)
+        return false;
+    p_seg->i_segmentation_event_id = dvbpsi_sis_Get32(p);
+    p_seg->b_segmentation_event_cancel_indicator = ((p[4] & 0x80) == 0x80);
+    p += 5;
+    if (p_seg->b_segmentation_event_cancel_indicator)
+        return true;
+
+    if (p + 1 > p_end)
+        return false;
+    p_seg->b_program_segmentation_flag = ((p[0] & 0x80) == 0x80);
+    p_seg->b_segmentation_duration_flag = ((p[0] & 0x40) == 0x40);
+    p_seg->b_delivery_not_restricted_flag = ((p[0] & 0x20) == 0x20);
+    if (!p_seg->b_delivery_not_restricted_flag)
+    {
+        p_seg->b_web_delivery_allowed_flag = ((p[0] & 0x10) == 0x10);
+        p_seg->b_no_regional_blackout_flag = ((p[0] & 0x08) == 0x08);
+        p_seg->b_archive_allowed_flag = ((p[0] & 0x04) == 0x04);
+        p_seg->i_device_restrictions = (p[0] & 0x03);
+    }
+    p++;
+
+    if (!p_seg->b_program_segmentation_flag)
+    {
+        if (p + 1 > p_end)
+            return false;
+        p_seg->i_component_count = p[0];
+        p++;
+
+        for (int i = 0; i < p_seg->i_component_count; i++)
+        {
+            if (p + 6 > p_end)
+                return false;
+            dvbpsi_sis_segmentation_component_t *p_comp =
+                    SIS_STORAGE_GET(p_ctx, segmentation_component,
+                                    i_segmentation_component,
+                                    DVBPSI_SIS_MAX_COMPONENTS);
+            if (!p_comp)
+                return false;
+            if (i == 0)
+                p_seg->p_components = p_comp;
+            p_comp->i_component_tag = p[0];
+            p_comp->i_pts_offset = dvbpsi_sis_Get33(p + 1);
+            p += 6;
+        }
+    }
 
-            /* Service descriptors */
-            uint8_t *p_desc = p_byte + 13 + i_splice_command_length;
-            p_sis->i_descriptors_length = (p_desc[0] << 8) | p_desc[1];
+    if (p_seg->b_segmentation_duration_flag)
+    {
+        if (p + 5 > p_end)
+            return false;
+        p_seg->i_segmentation_duration = dvbpsi_sis_Get40(p);
+        p += 5;
+    }
 
-            p_desc += 1;
-            p_end = p_desc + p_sis->i_descriptors_length;
-            if (p_end > p_section->p_payload_end) break;
+    if (p + 2 > p_end)
+        return false;
+    p_seg->i_segmentation_upid_type = p[0];
+    p_seg->i_segmentation_upid_length = p[1];
+    p += 2;
+    if (p + p_seg->i_segmentation_upid_length > p_end)
+        return false;
+    memcpy(p_seg->p_segmentation_upid, p, p_seg->i_segmentation_upid_length);
+    p += p_seg->i_segmentation_upid_length;
 
-            while (p_desc + 2 <= p_end)
+    if (p + 3 > p_end)
+        return false;
+    p_seg->i_segmentation_type_id = p[0];
+    p_seg->i_segment_num = p[1];
+    p_seg->i_segments_expected = p[2];
+    p += 3;
+
+    /* sub_segment_num and sub_segments_expected were added later on, old
+     * encoders may not send them */
+    switch (p_seg->i_segmentation_type_id)
+    {
+        case 0x34: case 0x36: case 0x38: case 0x3A:
+            if (p + 2 <= p_end)
             {
-                uint8_t i_tag = p_desc[0];
-                uint8_t i_length = p_desc[1];
-                if ((i_length <= 254) &&
-                    (i_length + 2 <= p_end - p_desc))
-                    dvbpsi_sis_descriptor_add(p_sis, i_tag, i_length, p_desc + 2);
-                p_desc += 2 + i_length;
+                p_seg->b_sub_segment = true;
+                p_seg->i_sub_segment_num = p[0];
+                p_seg->i_sub_segments_expected = p[1];
             }
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_sections_decode
+ *****************************************************************************
+ * SIS decoder.
+ *****************************************************************************/
+void dvbpsi_sis_sections_decode(dvbpsi_t* p_dvbpsi, dvbpsi_sis_decoder_t* p_sis_decoder,
+                                dvbpsi_sis_t* p_sis, dvbpsi_psi_section_t* p_section)
+{
+    for (; p_section; p_section = p_section->p_next)
+    {
+        /* The CRC_32 is already excluded from p_payload_end */
+        const uint8_t *p_byte = p_section->p_data;
+        const uint8_t *p_end = p_section->p_payload_end;
+        dvbpsi_sis_decoder_ctx_t ctx = { .p_sis = p_sis };
+
+        p_sis->p_splice_command = NULL;
+        p_sis->b_splice_command_valid = false;
+        p_sis->i_segmentation_count = 0;
 
-            if (p_sis->b_encrypted_packet)
+        if (p_end - p_byte < 14 + 2)
+        {
+            dvbpsi_error(p_dvbpsi, "SIS decoder", "section too short");
+            continue;
+        }
+
+        p_sis->i_protocol_version = p_byte[3];
+        p_sis->b_encrypted_packet = ((p_byte[4] & 0x80) == 0x80);
+        p_sis->i_encryption_algorithm = ((p_byte[4] & 0x7E) >> 1);
+        p_sis->i_pts_adjustment = dvbpsi_sis_Get33(&p_byte[4]);
+        p_sis->cw_index = p_byte[9];
+        p_sis->i_tier = ((uint16_t)p_byte[10] << 4) | (p_byte[11] >> 4);
+        p_sis->i_splice_command_length = ((p_byte[11] & 0x0F) << 8) | p_byte[12];
+        p_sis->i_splice_command_type = p_byte[13];
+
+        if (p_sis->b_encrypted_packet)
+        {
+            /* splice_command_type up to E_CRC_32 is encrypted */
+            if (p_sis_decoder == NULL || p_sis_decoder->pf_decrypt == NULL)
+            {
+                dvbpsi_debug(p_dvbpsi, "SIS decoder",
+                             "encrypted splice command (algorithm %d) not decoded",
+                             p_sis->i_encryption_algorithm);
+                continue;
+            }
+
+            uint8_t *p_crypt = p_section->p_data + 13;
+            size_t i_crypt = p_end - p_byte - 13;
+            if (i_crypt < 1 + 2 + 4 ||
+                !p_sis_decoder->pf_decrypt(p_sis_decoder->p_decrypt_data, p_sis,
+                                           p_crypt, i_crypt))
+            {
+                dvbpsi_error(p_dvbpsi, "SIS decoder", "decryption failed");
+                continue;
+            }
+            if (dvbpsi_crc32(p_crypt, i_crypt) != 0)
+            {
+                dvbpsi_error(p_dvbpsi, "SIS decoder",
+                             "E_CRC_32 mismatch (cw_index %d)", p_sis->cw_index);
+                continue;
+            }
+
+            p_sis->i_splice_command_type = p_byte[13];
+            p_sis->i_ecrc = dvbpsi_sis_Get32(p_end - 4);
+            /* alignment_stuffing is ignored after the descriptor loop */
+            p_end -= 4;
+        }
+
+        /* A splice_command_length of 0xfff means the length has to be
+         * derived from the command itself */
+        const bool b_length_known = (p_sis->i_splice_command_length != 0xfff);
+        const uint8_t *p_cmd = p_byte + 14;
+        const uint8_t *p_cmd_end = p_end;
+        if (b_length_known)
+        {
+            p_cmd_end = p_cmd + p_sis->i_splice_command_length;
+            if (p_cmd_end + 2 > p_end)
+            {
+                dvbpsi_error(p_dvbpsi, "SIS decoder",
+                             "invalid splice_command_length (%d)",
+                             p_sis->i_splice_command_length);
+                continue;
+            }
+        }
+
+        const uint8_t *p_next = p_cmd;
+        switch (p_sis->i_splice_command_type)
+        {
+            case 0x00: /* splice_null */
+            case 0x07: /* bandwidth_reservation */
+                break;
+            case 0x04: /* splice_schedule */
+                p_next = dvbpsi_sis_DecodeSpliceSchedule(&ctx, p_cmd, p_cmd_end);
+                p_sis->p_splice_command = &p_sis->cmd.splice_schedule;
+                break;
+            case 0x05: /* splice_insert */
+                memset(&p_sis->cmd.splice_insert, 0, sizeof(dvbpsi_sis_cmd_splice_insert_t));
+                p_next = dvbpsi_sis_DecodeSpliceInsert(&ctx, p_cmd, p_cmd_end);
+                p_sis->p_splice_command = &p_sis->cmd.splice_insert;
+                break;
+            case 0x06: /* time_signal */
+                p_next = dvbpsi_sis_DecodeSpliceTime(&ctx, p_cmd, p_cmd_end,
+                                                     &p_sis->cmd.time_signal.p_splice_time);
+                p_sis->p_splice_command = &p_sis->cmd.time_signal;
+                break;
+            case 0xff: /* private_command */
+                if (!b_length_known)
+                {
+                    dvbpsi_error(p_dvbpsi, "SIS decoder",
+                                 "private_command without splice_command_length");
+                    p_next = NULL;
+                    break;
+                }
+                p_next = dvbpsi_sis_DecodePrivateCommand(&ctx, p_cmd, p_cmd_end);
+                p_sis->p_splice_command = &p_sis->cmd.private_command;
+                break;
+            default:
+                dvbpsi_error(p_dvbpsi, "SIS decoder", "invalid SIS Command found");
+                p_next = NULL;
+                break;
+        }
+
+        if (p_next == NULL)
+        {
+            dvbpsi_error(p_dvbpsi, "SIS decoder",
+                         "malformed or too large splice command (type 0x%02x)",
+                         p_sis->i_splice_command_type);
+            p_sis->p_splice_command = NULL;
+            continue;
+        }
+        if (!b_length_known)
+        {
+            p_cmd_end = p_next;
+            p_sis->i_splice_command_length = p_cmd_end - p_cmd;
+            if (p_cmd_end + 2 > p_end)
+                continue;
+        }
+
+        /* Splice descriptors */
+        uint8_t *p_desc = p_section->p_data + (p_cmd_end - p_byte);
+        p_sis->i_descriptors_length = ((uint16_t)p_desc[0] << 8) | p_desc[1];
+        p_desc += 2;
+        const uint8_t *p_desc_end = p_desc + p_sis->i_descriptors_length;
+        if (p_desc_end > p_end)
+        {
+            dvbpsi_error(p_dvbpsi, "SIS decoder",
+                         "invalid descriptor_loop_length (%d)",
+                         p_sis->i_descriptors_length);
+            continue;
+        }
+
+        /* A caller provided SIS gets the raw descriptor loop */
+        const bool b_storage = p_sis_decoder && p_sis_decoder->p_storage == p_sis;
+        if (b_storage)
+            p_sis->p_descriptors = p_desc;
+
+        bool b_valid = true;
+        while (p_desc + 2 <= p_desc_end)
+        {
+            uint8_t i_tag = p_desc[0];
+            uint8_t i_length = p_desc[1];
+            if (i_length + 2 > p_desc_end - p_desc)
             {
-                /* FIXME: Currently ignored */
-                /* Calculate crc32 over decoded
-                 * p_sis->i_splice_command_type till p_sis->i_ecrc,
-                 * the result should be exactly p_sis->i_ecrc and indicates
-                 * a successfull decryption.
-                 */
-                p_desc += 4; /* E CRC 32 */
+                b_valid = false;
+                break;
             }
 
-            /* point to next section */
-            p_byte = p_desc + 4 /* CRC 32 */;
+            if (!b_storage)
+                dvbpsi_sis_descriptor_add(p_sis, i_tag, i_length, p_desc + 2);
+
+            /* segmentation_descriptor */
+            if (i_tag == 0x02 && i_length >= 4 &&
+                dvbpsi_sis_Get32(p_desc + 2) == DVBPSI_SIS_CUEI_IDENTIFIER)
+            {
+                if (p_sis->i_segmentation_count >= DVBPSI_SIS_MAX_SEGMENTATION)
+                {
+                    dvbpsi_error(p_dvbpsi, "SIS decoder",
+                                 "too many segmentation descriptors");
+                    b_valid = false;
+                }
+                else if (dvbpsi_sis_DecodeSegmentation(&ctx, p_desc + 6,
+                                    p_desc + 2 + i_length,
+                                    &p_sis->segmentation[p_sis->i_segmentation_count]))
+                    p_sis->i_segmentation_count++;
+                else
+                {
+                    dvbpsi_error(p_dvbpsi, "SIS decoder",
+                                 "malformed segmentation descriptor");
+                    b_valid = false;
+                }
+            }
+            p_desc += 2 + i_length;
         }
 
-        p_section = p_section->p_next;
+        p_sis->b_splice_command_valid = b_valid;
     }
 }
 
 /*****************************************************************************
- * dvbpsi_sis_sections_generate
+ * sis_writer_t
  *****************************************************************************
- * Generate SIS sections based on the dvbpsi_sis_t structure.
+ * Bounded writer into a caller supplied buffer. Writes past the end are
+ * dropped and remembered, so that the encoders only check once.
  *****************************************************************************/
-dvbpsi_psi_section_t *dvbpsi_sis_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_sis_t* p_sis)
+typedef struct sis_writer_s
 {
-    dvbpsi_psi_section_t * p_current = dvbpsi_NewPSISection(1024);
+    uint8_t *p;
+    uint8_t *p_end;
+    bool     b_overflow;
+} sis_writer_t;
 
-    p_current->i_table_id = 0xFC;
-    p_current->b_syntax_indicator = false;
-    p_current->b_private_indicator = false;
-    p_current->i_length = 3;                     /* header + CRC_32 */
+static inline void sis_Put8(sis_writer_t *w, uint8_t i_value)
+{
+    if (w->p < w->p_end)
+        *w->p++ = i_value;
+    else
+        w->b_overflow = true;
+}
 
-    /* FIXME: looks weird */
-    p_current->p_payload_end += 2;               /* just after the header */
-    p_current->p_payload_start = p_current->p_data + 3;
+static inline void sis_Put16(sis_writer_t *w, uint16_t i_value)
+{
+    sis_Put8(w, i_value >> 8);
+    sis_Put8(w, i_value);
+}
+
+static inline void sis_Put32(sis_writer_t *w, uint32_t i_value)
+{
+    sis_Put16(w, i_value >> 16);
+    sis_Put16(w, i_value);
+}
+
+/* 7 bits of flags/reserved followed by a 33 bits value */
+static inline void sis_Put33(sis_writer_t *w, uint8_t i_flags, uint64_t i_value)
+{
+    sis_Put8(w, (i_flags & 0xfe) | ((i_value >> 32) & 0x01));
+    sis_Put32(w, (uint32_t)i_value);
+}
+
+static inline void sis_PutBytes(sis_writer_t *w, const uint8_t *p_data, size_t i_length)
+{
+    if ((size_t)(w->p_end - w->p) < i_length)
+    {
+        w->b_overflow = true;
+        w->p = w->p_end;
+        return;
+    }
+    memcpy(w->p, p_data, i_length);
+    w->p += i_length;
+}
+
+static void sis_PutSpliceTime(sis_writer_t *w, const dvbpsi_sis_splice_time_t *p_time)
+{
+    if (p_time && p_time->b_time_specified_flag)
+        sis_Put33(w, 0xfe, p_time->i_pts_time);
+    else
+        sis_Put8(w, 0x7f);
+}
+
+static void sis_PutBreakDuration(sis_writer_t *w, const dvbpsi_sis_break_duration_t *p_duration)
+{
+    if (p_duration == NULL)
+    {
+        w->b_overflow = true; /* duration_flag without break_duration() */
+        return;
+    }
+    sis_Put33(w, p_duration->b_auto_return ? 0xfe : 0x7e, p_duration->i_duration);
+}
+
+/*****************************************************************************
+ * sis_EncodeSpliceSchedule
+ *****************************************************************************/
+static void sis_EncodeSpliceSchedule(sis_writer_t *w,
+                                     const dvbpsi_sis_cmd_splice_schedule_t *p_cmd)
+{
+    uint8_t i_count = 0;
+    for (const dvbpsi_sis_splice_event_t *p_event = p_cmd->p_splice_event;
+         p_event; p_event = p_event->p_next)
+        i_count++;
+    sis_Put8(w, i_count);
+
+    for (const dvbpsi_sis_splice_event_t *p_event = p_cmd->p_splice_event;
+         p_event; p_event = p_event->p_next)
+    {
+        sis_Put32(w, p_event->i_splice_event_id);
+        sis_Put8(w, p_event->b_splice_event_cancel_indicator ? 0xff : 0x7f);
+        if (p_event->b_splice_event_cancel_indicator)
+            continue;
+
+        sis_Put8(w, (p_event->b_out_of_network_indicator ? 0x80 : 0) |
+                    (p_event->b_program_splice_flag ? 0x40 : 0) |
+                    (p_event->b_duration_flag ? 0x20 : 0) | 0x1f);
+        if (p_event->b_program_splice_flag)
+            sis_Put32(w, p_event->i_utc_splice_time);
+        else
+        {
+            uint8_t i_components = 0;
+            for (const dvbpsi_sis_component_utc_splice_time_t *p_comp = p_event->p_data;
+                 p_comp; p_comp = p_comp->p_next)
+                i_components++;
+            sis_Put8(w, i_components);
+            for (const dvbpsi_sis_component_utc_splice_time_t *p_comp = p_event->p_data;
+                 p_comp; p_comp = p_comp->p_next)
+            {
+                sis_Put8(w, p_comp->component_tag);
+                sis_Put32(w, p_comp->i_utc_splice_time);
+            }
+        }
+        if (p_event->b_duration_flag)
+            sis_PutBreakDuration(w, p_event->p_break_duration);
+        sis_Put16(w, p_event->i_unique_program_id);
+        sis_Put8(w, p_event->i_avail_num);
+        sis_Put8(w, p_event->i_avails_expected);
+    }
+}
+
+/*****************************************************************************
+ * sis_EncodeSpliceInsert
+ *****************************************************************************/
+static void sis_EncodeSpliceInsert(sis_writer_t *w, const dvbpsi_sis_cmd_splice_insert_t *p_cmd)
+{
+    sis_Put32(w, p_cmd->i_splice_event_id);
+    sis_Put8(w, p_cmd->b_splice_event_cancel_indicator ? 0xff : 0x7f);
+    if (p_cmd->b_splice_event_cancel_indicator)
+        return;
+
+    sis_Put8(w, (p_cmd->b_out_of_network_indicator ? 0x80 : 0) |
+                (p_cmd->b_program_splice_flag ? 0x40 : 0) |
+                (p_cmd->b_duration_flag ? 0x20 : 0) |
+                (p_cmd->b_splice_immediate_flag ? 0x10 : 0) | 0x0f);
+
+    if (p_cmd->b_program_splice_flag)
+    {
+        if (!p_cmd->b_splice_immediate_flag)
+            sis_PutSpliceTime(w, p_cmd->p_splice_time);
+    }
+    else
+    {
+        uint8_t i_components = 0;
+        for (const dvbpsi_sis_component_splice_time_t *p_comp = p_cmd->p_data;
+             p_comp; p_comp = p_comp->p_next)
+            i_components++;
+        sis_Put8(w, i_components);
+        for (const dvbpsi_sis_component_splice_time_t *p_comp = p_cmd->p_data;
+             p_comp; p_comp = p_comp->p_next)
+        {
+            sis_Put8(w, p_comp->i_component_tag);
+            if (!p_cmd->b_splice_immediate_flag)
+                sis_PutSpliceTime(w, p_comp->p_splice_time);
+        }
+    }
+
+    if (p_cmd->b_duration_flag)
+        sis_PutBreakDuration(w, p_cmd->p_break_duration);
+    sis_Put16(w, p_cmd->i_unique_program_id);
+    sis_Put8(w, p_cmd->i_avail_num);
+    sis_Put8(w, p_cmd->i_avails_expected);
+}
+
+/*****************************************************************************
+ * sis_EncodeCommand
+ *****************************************************************************/
+static bool sis_EncodeCommand(sis_writer_t *w, const dvbpsi_sis_t *p_sis)
+{
+    switch (p_sis->i_splice_command_type)
+    {
+        case 0x00: /* splice_null */
+        case 0x07: /* bandwidth_reservation */
+            return true;
+        default:
+            break;
+    }
+
+    if (p_sis->p_splice_command == NULL)
+        return false;
+
+    switch (p_sis->i_splice_command_type)
+    {
+        case 0x04: /* splice_schedule */
+            sis_EncodeSpliceSchedule(w, p_sis->p_splice_command);
+            return true;
+        case 0x05: /* splice_insert */
+            sis_EncodeSpliceInsert(w, p_sis->p_splice_command);
+            return true;
+        case 0x06: /* time_signal */
+        {
+            const dvbpsi_sis_cmd_time_signal_t *p_cmd = p_sis->p_splice_command;
+            sis_PutSpliceTime(w, p_cmd->p_splice_time);
+            return true;
+        }
+        case 0xff: /* private_command */
+        {
+            const dvbpsi_sis_cmd_private_t *p_cmd = p_sis->p_splice_command;
+            if (p_cmd->i_length > DVBPSI_SIS_MAX_PRIVATE_BYTES)
+                return false;
+            sis_Put32(w, p_cmd->i_identifier);
+            sis_PutBytes(w, p_cmd->p_private_byte, p_cmd->i_length);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************
+ * sis_EncodeSegmentation
+ *****************************************************************************/
+static void sis_EncodeSegmentation(sis_writer_t *w, const dvbpsi_sis_segmentation_t *p_seg)
+{
+    uint8_t *p_length;
 
-    p_current->p_data[3] = p_sis->i_protocol_version;
-    p_current->p_data[4] = p_sis->b_encrypted_packet ? 0x80 : 0x0;
-    /* NOTE: cannot handle encrypted packet */
-    assert(p_sis->b_encrypted_packet);
-    p_current->p_data[4] |= ((p_sis->i_encryption_algorithm << 1) & 0x7E);
+    sis_Put8(w, 0x02);
+    p_length = w->p;
+    sis_Put8(w, 0); /* descriptor_length, filled in below */
+    sis_Put32(w, DVBPSI_SIS_CUEI_IDENTIFIER);
+    sis_Put32(w, p_seg->i_segmentation_event_id);
+    sis_Put8(w, p_seg->b_segmentation_event_cancel_indicator ? 0xff : 0x7f);
 
-    p_current->p_data[4] |= ((p_sis->i_pts_adjustment & 0x00800) >> 32);
-    p_current->p_data[5] = (p_sis->i_pts_adjustment >> 24);
-    p_current->p_data[6] = (p_sis->i_pts_adjustment >> 16);
-    p_current->p_data[7] = (p_sis->i_pts_adjustment >> 8);
-    p_current->p_data[8] =  p_sis->i_pts_adjustment;
+    if (!p_seg->b_segmentation_event_cancel_indicator)
+    {
+        uint8_t i_flags = (p_seg->b_program_segmentation_flag ? 0x80 : 0) |
+                          (p_seg->b_segmentation_duration_flag ? 0x40 : 0);
+        if (p_seg->b_delivery_not_restricted_flag)
+            i_flags |= 0x20 | 0x1f;
+        else
+            i_flags |= (p_seg->b_web_delivery_allowed_flag ? 0x10 : 0) |
+                       (p_seg->b_no_regional_blackout_flag ? 0x08 : 0) |
+                       (p_seg->b_archive_allowed_flag ? 0x04 : 0) |
+                       (p_seg->i_device_restrictions & 0x03);
+        sis_Put8(w, i_flags);
+
+        if (!p_seg->b_program_segmentation_flag)
+        {
+            sis_Put8(w, p_seg->i_component_count);
+            for (int i = 0; i < p_seg->i_component_count; i++)
+            {
+                sis_Put8(w, p_seg->p_components[i].i_component_tag);
+                sis_Put33(w, 0xfe, p_seg->p_components[i].i_pts_offset);
+            }
+        }
+
+        if (p_seg->b_segmentation_duration_flag)
+        {
+            sis_Put8(w, p_seg->i_segmentation_duration >> 32);
+            sis_Put32(w, (uint32_t)p_seg->i_segmentation_duration);
+        }
 
-    p_current->p_data[9]  = p_sis->cw_index;
-    p_current->p_data[11] = 0x00;
-    p_current->p_data[11]|= ((p_sis->i_splice_command_length >> 8) & 0x0F);
-    p_current->p_data[12] = (uint8_t) (p_sis->i_splice_command_length & 0xFF);
-    p_current->p_data[13] = p_sis->i_splice_command_type;
+        sis_Put8(w, p_seg->i_segmentation_upid_type);
+        sis_Put8(w, p_seg->i_segmentation_upid_length);
+        sis_PutBytes(w, p_seg->p_segmentation_upid, p_seg->i_segmentation_upid_length);
+        sis_Put8(w, p_seg->i_segmentation_type_id);
+        sis_Put8(w, p_seg->i_segment_num);
+        sis_Put8(w, p_seg->i_segments_expected);
+        if (p_seg->b_sub_segment)
+        {
+            sis_Put8(w, p_seg->i_sub_segment_num);
+            sis_Put8(w, p_seg->i_sub_segments_expected);
+        }
+    }
 
-    uint32_t i_desc_start = 13 + p_sis->i_splice_command_length;
-    if (p_sis->i_splice_command_length == 0xfff)
+    if (!w->b_overflow)
     {
-        /* FIXME: size 0xfff of splice_command_section is undefined */
-        assert(p_sis->i_splice_command_length != 0xfff);
+        size_t i_length = w->p - p_length - 1;
+        if (i_length > 255)
+            w->b_overflow = true;
+        else
+            *p_length = i_length;
     }
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_splice_command_encode
+ *****************************************************************************/
+bool dvbpsi_sis_splice_command_encode(const dvbpsi_sis_t *p_sis,
+                                      uint8_t *p_buf, size_t i_size, size_t *pi_length)
+{
+    assert(p_sis);
+    assert(p_buf);
+    assert(pi_length);
+
+    sis_writer_t w = { .p = p_buf, .p_end = p_buf + i_size, .b_overflow = false };
+    if (!sis_EncodeCommand(&w, p_sis) || w.b_overflow)
+        return false;
+
+    *pi_length = w.p - p_buf;
+    return true;
+}
 
-    /* FIXME: handle splice_command_sections */
+/*****************************************************************************
+ * dvbpsi_sis_segmentation_encode
+ *****************************************************************************/
+bool dvbpsi_sis_segmentation_encode(const dvbpsi_sis_segmentation_t *p_seg,
+                                    uint8_t *p_buf, size_t i_size, size_t *pi_length)
+{
+    assert(p_seg);
+    assert(p_buf);
+    assert(pi_length);
+
+    sis_writer_t w = { .p = p_buf, .p_end = p_buf + i_size, .b_overflow = false };
+    sis_EncodeSegmentation(&w, p_seg);
+    if (w.b_overflow)
+        return false;
+
+    *pi_length = w.p - p_buf;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_section_encode
+ *****************************************************************************/
+bool dvbpsi_sis_section_encode(const dvbpsi_sis_t *p_sis,
+                               dvbpsi_sis_crypt_callback pf_encrypt, void *p_cb_data,
+                               uint8_t *p_buf, size_t i_size, size_t *pi_length)
+{
+    assert(p_sis);
+    assert(p_buf);
+    assert(pi_length);
 
-    /* Service descriptors */
-    p_current->p_data[i_desc_start] = (p_sis->i_descriptors_length >> 8);
-    p_current->p_data[i_desc_start+1] = (uint8_t)(p_sis->i_descriptors_length & 0xFF);
+    if (p_sis->b_encrypted_packet && pf_encrypt == NULL)
+        return false;
 
-    p_current->p_payload_end += (i_desc_start + 1);
+    /* section_length is 12 bits */
+    if (i_size > 4096)
+        i_size = 4096;
+
+    sis_writer_t w = { .p = p_buf, .p_end = p_buf + i_size, .b_overflow = false };
+
+    /* Section header, section_length is filled in last */
+    sis_Put8(&w, 0xFC);
+    sis_Put16(&w, 0x3000);
+    sis_Put8(&w, p_sis->i_protocol_version);
+    sis_Put33(&w, (p_sis->b_encrypted_packet ? 0x80 : 0) |
+                  ((p_sis->i_encryption_algorithm << 1) & 0x7e),
+              p_sis->i_pts_adjustment);
+    sis_Put8(&w, p_sis->cw_index);
+    sis_Put8(&w, p_sis->i_tier >> 4);
+    sis_Put16(&w, (p_sis->i_tier & 0x0f) << 12); /* splice_command_length below */
+    sis_Put8(&w, p_sis->i_splice_command_type);
+    if (w.b_overflow)
+        return false;
 
-    uint32_t i_desc_length = 0;
+    /* Splice command */
+    uint8_t *p_crypt = w.p - 1;
+    uint8_t *p_cmd = w.p;
+    if (!sis_EncodeCommand(&w, p_sis) || w.b_overflow)
+        return false;
+    size_t i_cmd_length = w.p - p_cmd;
+    if (i_cmd_length >= 0xfff)
+        return false;
+    p_buf[11] |= (i_cmd_length >> 8) & 0x0f;
+    p_buf[12] = i_cmd_length & 0xff;
+
+    /* Descriptor loop */
+    uint8_t *p_loop = w.p;
+    sis_Put16(&w, 0);
+    for (const dvbpsi_descriptor_t *p_desc = p_sis->p_first_descriptor;
+         p_desc; p_desc = p_desc->p_next)
+    {
+        if (p_sis->i_segmentation_count > 0 && p_desc->i_tag == 0x02 &&
+            p_desc->i_length >= 4 &&
+            dvbpsi_sis_Get32(p_desc->p_data) == DVBPSI_SIS_CUEI_IDENTIFIER)
+            continue;
+        sis_Put8(&w, p_desc->i_tag);
+        sis_Put8(&w, p_desc->i_length);
+        sis_PutBytes(&w, p_desc->p_data, p_desc->i_length);
+    }
+    for (int i = 0; i < p_sis->i_segmentation_count && i < DVBPSI_SIS_MAX_SEGMENTATION; i++)
+        sis_EncodeSegmentation(&w, &p_sis->segmentation[i]);
+    if (w.b_overflow)
+        return false;
+    size_t i_loop_length = w.p - p_loop - 2;
+    p_loop[0] = i_loop_length >> 8;
+    p_loop[1] = i_loop_length & 0xff;
 
-    dvbpsi_descriptor_t * p_descriptor = p_sis->p_first_descriptor;
-    while ((p_descriptor != NULL) && (p_current->i_length <= 1018))
+    if (p_sis->b_encrypted_packet)
     {
-        i_desc_length += p_descriptor->i_length + 2;
-        p_descriptor = p_descriptor->p_next;
+        /* DES based algorithms work on blocks of 8 bytes, E_CRC_32 included */
+        if (p_sis->i_encryption_algorithm >= 1 && p_sis->i_encryption_algorithm <= 3)
+        {
+            while ((w.p - p_crypt + 4) % 8)
+                sis_Put8(&w, 0xff);
+        }
+        uint32_t i_ecrc = dvbpsi_crc32(p_crypt, w.p - p_crypt);
+        sis_Put32(&w, i_ecrc);
+        if (w.b_overflow)
+            return false;
+        if (!pf_encrypt(p_cb_data, p_sis, p_crypt, w.p - p_crypt))
+            return false;
+    }
 
-        /* p_payload_end is where the descriptor begins */
-        p_current->p_payload_end[0] = p_descriptor->i_tag;
-        p_current->p_payload_end[1] = p_descriptor->i_length;
-        memcpy(p_current->p_payload_end + 2, p_descriptor->p_data, p_descriptor->i_length);
-        /* Increase length by descriptor_length + 2 */
-        p_current->p_payload_end += p_descriptor->i_length + 2;
-        p_current->i_length += p_descriptor->i_length + 2;
+    /* CRC_32 */
+    size_t i_section_length = w.p - p_buf - 3 + 4;
+    p_buf[1] |= (i_section_length >> 8) & 0x0f;
+    p_buf[2] = i_section_length & 0xff;
+    sis_Put32(&w, dvbpsi_crc32(p_buf, w.p - p_buf));
+    if (w.b_overflow)
+        return false;
+
+    *pi_length = w.p - p_buf;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_sis_sections_generate
+ *****************************************************************************
+ * Generate SIS sections based on the dvbpsi_sis_t structure.
+ *****************************************************************************/
+dvbpsi_psi_section_t *dvbpsi_sis_sections_generate_encrypted(dvbpsi_t *p_dvbpsi,
+                                    dvbpsi_sis_t *p_sis, dvbpsi_sis_crypt_callback pf_encrypt,
+                                    void *p_cb_data)
+{
+    uint8_t p_buf[4096];
+    size_t i_length;
 
+    if (!dvbpsi_sis_section_encode(p_sis, pf_encrypt, p_cb_data,
+                                   p_buf, sizeof(p_buf), &i_length))
+    {
+        dvbpsi_error(p_dvbpsi, "SIS generator",
+                     "cannot encode splice_info_section (command type 0x%02x)",
+                     p_sis->i_splice_command_type);
+        return NULL;
     }
-    /* Coding error if this condition is not met */
-    assert( i_desc_length == p_sis->i_descriptors_length);
+
+    dvbpsi_psi_section_t *p_current = dvbpsi_NewPSISection(i_length);
+    if (p_current == NULL)
+        return NULL;
+
+    memcpy(p_current->p_data, p_buf, i_length);
+    p_current->i_table_id = 0xFC;
+    p_current->b_syntax_indicator = false;
+    p_current->b_private_indicator = false;
+    p_current->i_length = i_length - 3;
+    p_current->p_payload_start = p_current->p_data + 3;
+    p_current->p_payload_end = p_current->p_data + i_length - 4;
 
     /* Finalization */
     dvbpsi_BuildPSISection(p_dvbpsi, p_current);
     return p_current;
 }
+
+dvbpsi_psi_section_t *dvbpsi_sis_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_sis_t* p_sis)
+{
+    return dvbpsi_sis_sections_generate_encrypted(p_dvbpsi, p_sis, NULL, NULL);
+}
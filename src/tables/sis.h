@@ -37,70 +37,30 @@
 extern "C" {
 #endif
 
-/*****************************************************************************
- * dvbpsi_sis_t
- *****************************************************************************/
 /*!
- * \struct dvbpsi_sis_s
- * \brief SIS structure.
- *
- * This structure is used to store a decoded SIS service description.
- * (SCTE 35 2004 section 7.2).
+ * \def DVBPSI_SIS_MAX_COMPONENTS
+ * \brief Maximum number of components decoded per splice command or
+ * segmentation_descriptor.
  */
+#define DVBPSI_SIS_MAX_COMPONENTS       32
+
 /*!
- * \typedef struct dvbpsi_sis_s dvbpsi_sis_t
- * \brief dvbpsi_sis_t type definition.
+ * \def DVBPSI_SIS_MAX_SPLICE_EVENTS
+ * \brief Maximum number of splice events decoded from a splice_schedule().
  */
-typedef struct dvbpsi_sis_s
-{
-  /* section */
-  uint8_t                   i_table_id;         /*!< table id */
-  uint16_t                  i_extension;        /*!< subtable id */
-
-  uint16_t                  i_ts_id;            /*!< transport_stream_id */
-  uint8_t                   i_version;          /*!< version_number */
-  uint8_t                   i_protocol_version; /*!< Protocol version
-                                                     shall be 0 */
-  bool                      b_current_next;     /*!< current_next_indicator */
-
-  /* encryption */
-  bool                      b_encrypted_packet;     /*!< 1 when packet is
-                                                         encrypted */
-  uint8_t                   i_encryption_algorithm; /*!< Encryption algorithm
-                                                         used */
-
-  uint64_t                  i_pts_adjustment;       /*!< PTS offset */
-  uint8_t                   cw_index;               /*!< CA control word */
-
-  /* splice command */
-  uint16_t                  i_splice_command_length;/*!< Length of splice command */
-  uint8_t                   i_splice_command_type;  /*!< Splice command type */
-
-  /* Splice Command:
-   * splice_command_type     splice_info_section
-   *    0x00                    splice_null()
-   *    0x01                    reserved
-   *    0x02                    reserved
-   *    0x03                    reserved
-   *    0x04                    splice_schedule()
-   *    0x05                    splice_insert()
-   *    0x06                    time_signal()
-   *    0x07                    bandwidth_reservation()
-   *    0x08 - 0xff             reserved
-   */
-  void                      *p_splice_command;      /*!< Pointer to splice command
-                                                         structure */
-
-  /* descriptors */
-  uint16_t                  i_descriptors_length;   /*!< Descriptors loop
-                                                         length */
-  dvbpsi_descriptor_t       *p_first_descriptor;     /*!< First of the following
-                                                          SIS descriptors */
+#define DVBPSI_SIS_MAX_SPLICE_EVENTS    16
 
-  /* FIXME: alignment stuffing */
-  uint32_t i_ecrc; /*!< CRC 32 of decrypted splice_info_section */
+/*!
+ * \def DVBPSI_SIS_MAX_SEGMENTATION
+ * \brief Maximum number of segmentation_descriptor() decoded per section.
+ */
+#define DVBPSI_SIS_MAX_SEGMENTATION     8
 
-} __attribute__((packed)) dvbpsi_sis_t;
+/*!
+ * \def DVBPSI_SIS_MAX_PRIVATE_BYTES
+ * \brief Maximum number of private_byte kept from a private_command().
+ */
+#define DVBPSI_SIS_MAX_PRIVATE_BYTES    256
 
 /*****************************************************************************
  * Splice Commands
@@ -336,6 +296,232 @@ typedef struct dvbpsi_sis_cmd_bandwidth_reservation_s
     /* nothing */
 } dvbpsi_sis_cmd_bandwidth_reservation_t;
 
+
+/*!
+ * \typedef struct dvbpsi_sis_cmd_private_s dvbpsi_sis_cmd_private_t
+ * \brief private_command() splice command definition
+ */
+/*!
+ * \struct dvbpsi_sis_cmd_private_s
+ * \brief private_command() splice command definition
+ */
+typedef struct dvbpsi_sis_cmd_private_s
+{
+    uint32_t    i_identifier;   /*!< registered identifier (ISO/IEC 13818-1
+                                     registration_descriptor format_identifier) */
+    uint16_t    i_length;       /*!< number of private bytes */
+    uint8_t     p_private_byte[DVBPSI_SIS_MAX_PRIVATE_BYTES];
+                                /*!< private bytes */
+} dvbpsi_sis_cmd_private_t;
+
+/*****************************************************************************
+ * Segmentation descriptor
+ *****************************************************************************/
+/*!
+ * \def DVBPSI_SIS_CUEI_IDENTIFIER
+ * \brief Identifier of the splice descriptors defined by SCTE 35 ("CUEI").
+ */
+#define DVBPSI_SIS_CUEI_IDENTIFIER      0x43554549
+
+/*!
+ * \typedef struct dvbpsi_sis_segmentation_component_s dvbpsi_sis_segmentation_component_t
+ * \brief segmentation_descriptor() component definition
+ */
+/*!
+ * \struct dvbpsi_sis_segmentation_component_s
+ * \brief segmentation_descriptor() component definition
+ */
+typedef struct dvbpsi_sis_segmentation_component_s
+{
+    uint8_t     i_component_tag;    /*!< identifies the elementary PID stream */
+    uint64_t    i_pts_offset;       /*!< offset in 90 kHz ticks to be added to
+                                         the splice_time() of the command to
+                                         obtain the segmentation point of this
+                                         component (33 bits) */
+} dvbpsi_sis_segmentation_component_t;
+
+/*!
+ * \typedef struct dvbpsi_sis_segmentation_s dvbpsi_sis_segmentation_t
+ * \brief segmentation_descriptor() definition (SCTE 35 section 10.3.3)
+ */
+/*!
+ * \struct dvbpsi_sis_segmentation_s
+ * \brief segmentation_descriptor() definition (SCTE 35 section 10.3.3)
+ */
+typedef struct dvbpsi_sis_segmentation_s
+{
+    uint32_t    i_segmentation_event_id;               /*!< segmentation event identifier */
+    bool        b_segmentation_event_cancel_indicator; /*!< cancels the segmentation
+                                                            event when true */
+
+    /* if (!b_segmentation_event_cancel_indicator) */
+    bool        b_program_segmentation_flag;    /*!< segmentation applies to all
+                                                     components of the program */
+    bool        b_segmentation_duration_flag;   /*!< signals the presence of
+                                                     i_segmentation_duration */
+    bool        b_delivery_not_restricted_flag; /*!< no delivery restrictions apply */
+    /*      if (!b_delivery_not_restricted_flag) */
+    bool        b_web_delivery_allowed_flag;    /*!< web_delivery_allowed_flag */
+    bool        b_no_regional_blackout_flag;    /*!< no_regional_blackout_flag */
+    bool        b_archive_allowed_flag;         /*!< archive_allowed_flag */
+    uint8_t     i_device_restrictions;          /*!< device_restrictions (2 bits) */
+
+    /*      if (!b_program_segmentation_flag) */
+    uint8_t     i_component_count;              /*!< number of components */
+    dvbpsi_sis_segmentation_component_t *p_components;
+                                                /*!< array of i_component_count
+                                                     components */
+    /*      if (b_segmentation_duration_flag) */
+    uint64_t    i_segmentation_duration;        /*!< duration in 90 kHz ticks (40 bits) */
+
+    uint8_t     i_segmentation_upid_type;       /*!< segmentation_upid_type */
+    uint8_t     i_segmentation_upid_length;     /*!< segmentation_upid_length */
+    uint8_t     p_segmentation_upid[255];       /*!< segmentation_upid() */
+    uint8_t     i_segmentation_type_id;         /*!< segmentation_type_id */
+    uint8_t     i_segment_num;                  /*!< segment_num */
+    uint8_t     i_segments_expected;            /*!< segments_expected */
+
+    bool        b_sub_segment;                  /*!< sub_segment fields are present,
+                                                     only for segmentation_type_id
+                                                     0x34, 0x36, 0x38 and 0x3A */
+    uint8_t     i_sub_segment_num;              /*!< sub_segment_num */
+    uint8_t     i_sub_segments_expected;        /*!< sub_segments_expected */
+    /* end */
+} dvbpsi_sis_segmentation_t;
+
+/*****************************************************************************
+ * dvbpsi_sis_storage_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_sis_storage_s
+ * \brief Backing store of a decoded splice command.
+ *
+ * The SIS decoder does not allocate memory for the splice command, the lists
+ * of the command structures point into this storage which is embedded in the
+ * dvbpsi_sis_t structure. A section which needs more entries than available
+ * is reported as an error and its splice command is marked invalid.
+ */
+/*!
+ * \typedef struct dvbpsi_sis_storage_s dvbpsi_sis_storage_t
+ * \brief dvbpsi_sis_storage_t type definition.
+ */
+typedef struct dvbpsi_sis_storage_s
+{
+    dvbpsi_sis_splice_time_t    splice_time[DVBPSI_SIS_MAX_COMPONENTS + 1];
+                                    /*!< splice_time() entries */
+    dvbpsi_sis_component_splice_time_t component[DVBPSI_SIS_MAX_COMPONENTS];
+                                    /*!< splice_insert() components */
+    dvbpsi_sis_splice_event_t   event[DVBPSI_SIS_MAX_SPLICE_EVENTS];
+                                    /*!< splice_schedule() events */
+    dvbpsi_sis_component_utc_splice_time_t utc_component[DVBPSI_SIS_MAX_COMPONENTS];
+                                    /*!< splice_schedule() components */
+    dvbpsi_sis_break_duration_t break_duration[DVBPSI_SIS_MAX_SPLICE_EVENTS];
+                                    /*!< break_duration() entries */
+    dvbpsi_sis_segmentation_component_t segmentation_component[DVBPSI_SIS_MAX_COMPONENTS];
+                                    /*!< segmentation_descriptor() components */
+} dvbpsi_sis_storage_t;
+
+/*****************************************************************************
+ * dvbpsi_sis_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_sis_s
+ * \brief SIS structure.
+ *
+ * This structure is used to store a decoded SIS service description.
+ * (SCTE 35 2004 section 7.2).
+ *
+ * Since libdvbpsi 2.0.0 the structure is no longer packed and embeds the
+ * decoded splice command, so its layout and size differ from the 1.x
+ * releases. The 1.x members keep their order, the new members follow them.
+ */
+/*!
+ * \typedef struct dvbpsi_sis_s dvbpsi_sis_t
+ * \brief dvbpsi_sis_t type definition.
+ */
+typedef struct dvbpsi_sis_s
+{
+  /* section */
+  uint8_t                   i_table_id;         /*!< table id */
+  uint16_t                  i_extension;        /*!< subtable id */
+
+  uint16_t                  i_ts_id;            /*!< transport_stream_id */
+  uint8_t                   i_version;          /*!< version_number */
+  uint8_t                   i_protocol_version; /*!< Protocol version
+                                                     shall be 0 */
+  bool                      b_current_next;     /*!< current_next_indicator */
+
+  /* encryption */
+  bool                      b_encrypted_packet;     /*!< 1 when packet is
+                                                         encrypted */
+  uint8_t                   i_encryption_algorithm; /*!< Encryption algorithm
+                                                         used */
+
+  uint64_t                  i_pts_adjustment;       /*!< PTS offset */
+  uint8_t                   cw_index;               /*!< CA control word */
+
+  /* splice command */
+  uint16_t                  i_splice_command_length;/*!< Length of splice command */
+  uint8_t                   i_splice_command_type;  /*!< Splice command type */
+
+  /* Splice Command:
+   * splice_command_type     splice_info_section
+   *    0x00                    splice_null()
+   *    0x01                    reserved
+   *    0x02                    reserved
+   *    0x03                    reserved
+   *    0x04                    splice_schedule()
+   *    0x05                    splice_insert()
+   *    0x06                    time_signal()
+   *    0x07                    bandwidth_reservation()
+   *    0x08 - 0xfe             reserved
+   *    0xff                    private_command()
+   */
+  void                      *p_splice_command;      /*!< Pointer to splice command
+                                                         structure in cmd, NULL
+                                                         for commands without
+                                                         fields */
+
+  /* descriptors */
+  uint16_t                  i_descriptors_length;   /*!< Descriptors loop
+                                                         length */
+  dvbpsi_descriptor_t       *p_first_descriptor;     /*!< First of the following
+                                                          SIS descriptors */
+
+  uint32_t i_ecrc; /*!< CRC 32 of decrypted splice_info_section */
+
+  /* members added in libdvbpsi 2.0.0 */
+  uint16_t                  i_tier;                 /*!< authorization tier
+                                                         (12 bits) */
+  bool                      b_splice_command_valid; /*!< splice command and
+                                                         segmentation descriptors
+                                                         were fully decoded */
+  union
+  {
+      dvbpsi_sis_cmd_splice_schedule_t splice_schedule; /*!< splice_schedule() */
+      dvbpsi_sis_cmd_splice_insert_t   splice_insert;   /*!< splice_insert() */
+      dvbpsi_sis_cmd_time_signal_t     time_signal;     /*!< time_signal() */
+      dvbpsi_sis_cmd_private_t         private_command; /*!< private_command() */
+  } cmd;                                            /*!< decoded splice command */
+
+  uint8_t                   i_segmentation_count;   /*!< number of decoded
+                                                         segmentation descriptors */
+  dvbpsi_sis_segmentation_t segmentation[DVBPSI_SIS_MAX_SEGMENTATION];
+                                                    /*!< segmentation_descriptor()
+                                                         found in the descriptor
+                                                         loop */
+
+  const uint8_t             *p_descriptors;         /*!< raw descriptor loop,
+                                                         only set by a decoder
+                                                         attached with
+                                                         dvbpsi_sis_attach_storage()
+                                                         and valid during the
+                                                         callback */
+
+  dvbpsi_sis_storage_t      storage;                /*!< backing store of the
+                                                         splice command */
+} dvbpsi_sis_t;
+
 /*****************************************************************************
  * dvbpsi_sis_callback
  *****************************************************************************/
@@ -364,6 +550,34 @@ typedef void (* dvbpsi_sis_callback)(void* p_cb_data, dvbpsi_sis_t* p_new_sis);
 bool dvbpsi_sis_attach(dvbpsi_t* p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
                       dvbpsi_sis_callback pf_callback, void* p_cb_data);
 
+/*****************************************************************************
+ * dvbpsi_sis_attach_storage
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sis_attach_storage(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+          uint16_t i_extension, dvbpsi_sis_t *p_sis,
+          dvbpsi_sis_callback pf_callback, void* p_cb_data)
+ * \brief Creation and initialization of a SIS decoder which decodes every
+ * section into a structure provided by the caller. It is attached to p_dvbpsi.
+ * \param p_dvbpsi pointer to dvbpsi to hold decoder/demuxer structure
+ * \param i_table_id Table ID, 0xFC.
+ * \param i_extension Table ID extension.
+ * \param p_sis structure the sections are decoded into, it must stay valid
+ * until the decoder is detached
+ * \param pf_callback function to call back on new SIS.
+ * \param p_cb_data private data given in argument to the callback.
+ * \return true on success, false on failure
+ *
+ * The decoder does not allocate memory for the decoded sections: the callback
+ * receives p_sis, which it must not delete. The descriptor list
+ * dvbpsi_sis_t::p_first_descriptor is not built, dvbpsi_sis_t::p_descriptors
+ * points to the raw descriptor loop instead. Both p_sis and the descriptor
+ * loop are only valid during the callback.
+ */
+bool dvbpsi_sis_attach_storage(dvbpsi_t* p_dvbpsi, uint8_t i_table_id,
+                               uint16_t i_extension, dvbpsi_sis_t *p_sis,
+                               dvbpsi_sis_callback pf_callback, void* p_cb_data);
+
 /*****************************************************************************
  * dvbpsi_sis_detach
  *****************************************************************************/
@@ -447,6 +661,108 @@ dvbpsi_descriptor_t *dvbpsi_sis_descriptor_add(dvbpsi_sis_t *p_sis,
                                              uint8_t i_tag, uint8_t i_length,
                                              uint8_t *p_data);
 
+/*****************************************************************************
+ * dvbpsi_sis_crypt_callback
+ *****************************************************************************/
+/*!
+ * \typedef bool (* dvbpsi_sis_crypt_callback)(void *p_cb_data,
+                          const dvbpsi_sis_t *p_sis, uint8_t *p_data, size_t i_length)
+ * \brief Encryption and decryption callback type definition.
+ *
+ * The callback encrypts or decrypts in place the part of a
+ * splice_info_section from splice_command_type up to and including
+ * E_CRC_32. dvbpsi_sis_t::i_encryption_algorithm and dvbpsi_sis_t::cw_index
+ * select the algorithm and the control word. The callback returns false
+ * when it cannot handle the section.
+ */
+typedef bool (* dvbpsi_sis_crypt_callback)(void *p_cb_data, const dvbpsi_sis_t *p_sis,
+                                           uint8_t *p_data, size_t i_length);
+
+/*****************************************************************************
+ * dvbpsi_sis_set_decrypt
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sis_set_decrypt(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                          uint16_t i_extension, dvbpsi_sis_crypt_callback pf_decrypt,
+                          void *p_cb_data)
+ * \brief Install the decryption callback of an attached SIS decoder.
+ * \param p_dvbpsi pointer to dvbpsi to hold decoder/demuxer structure
+ * \param i_table_id Table ID, 0xFC.
+ * \param i_extension Table ID extension.
+ * \param pf_decrypt decryption callback, NULL to leave encrypted splice
+ * commands undecoded
+ * \param p_cb_data private data given in argument to the callback.
+ * \return true on success, false if there is no such decoder.
+ *
+ * Decrypted sections are only decoded when the E_CRC_32 matches, a wrong
+ * control word is reported as an error.
+ */
+bool dvbpsi_sis_set_decrypt(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension,
+                            dvbpsi_sis_crypt_callback pf_decrypt, void *p_cb_data);
+
+/*****************************************************************************
+ * dvbpsi_sis_splice_command_encode
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sis_splice_command_encode(const dvbpsi_sis_t *p_sis,
+                          uint8_t *p_buf, size_t i_size, size_t *pi_length)
+ * \brief Encode the splice command of a SIS structure.
+ * \param p_sis SIS structure, dvbpsi_sis_t::i_splice_command_type selects
+ * the command and dvbpsi_sis_t::p_splice_command points to it
+ * \param p_buf buffer to write the command to
+ * \param i_size size of p_buf
+ * \param pi_length filled in with the number of bytes written
+ * \return true on success, false if the command is unknown or does not fit.
+ */
+bool dvbpsi_sis_splice_command_encode(const dvbpsi_sis_t *p_sis,
+                                      uint8_t *p_buf, size_t i_size, size_t *pi_length);
+
+/*****************************************************************************
+ * dvbpsi_sis_segmentation_encode
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sis_segmentation_encode(const dvbpsi_sis_segmentation_t *p_seg,
+                          uint8_t *p_buf, size_t i_size, size_t *pi_length)
+ * \brief Encode a complete segmentation_descriptor().
+ * \param p_seg segmentation descriptor
+ * \param p_buf buffer to write the descriptor to, tag and length included
+ * \param i_size size of p_buf
+ * \param pi_length filled in with the number of bytes written
+ * \return true on success, false if the descriptor does not fit.
+ */
+bool dvbpsi_sis_segmentation_encode(const dvbpsi_sis_segmentation_t *p_seg,
+                                    uint8_t *p_buf, size_t i_size, size_t *pi_length);
+
+/*****************************************************************************
+ * dvbpsi_sis_section_encode
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sis_section_encode(const dvbpsi_sis_t *p_sis,
+                          dvbpsi_sis_crypt_callback pf_encrypt, void *p_cb_data,
+                          uint8_t *p_buf, size_t i_size, size_t *pi_length)
+ * \brief Encode a complete splice_info_section, CRC_32 included.
+ * \param p_sis SIS structure
+ * \param pf_encrypt encryption callback, only used when
+ * dvbpsi_sis_t::b_encrypted_packet is set
+ * \param p_cb_data private data given in argument to the callback.
+ * \param p_buf buffer to write the section to, 4096 bytes are always enough
+ * \param i_size size of p_buf
+ * \param pi_length filled in with the size of the section
+ * \return true on success, false on error.
+ *
+ * The descriptor loop holds the descriptors of
+ * dvbpsi_sis_t::p_first_descriptor followed by the segmentation descriptors
+ * of dvbpsi_sis_t::segmentation. Segmentation descriptors found in the
+ * descriptor list are skipped when dvbpsi_sis_t::i_segmentation_count is not
+ * 0, so that a decoded SIS is encoded back unchanged. The splice command
+ * length and the descriptor loop length are computed. For encrypted sections
+ * the E_CRC_32 is calculated and alignment stuffing is added for the DES
+ * based algorithms (1 to 3) before the callback is called.
+ */
+bool dvbpsi_sis_section_encode(const dvbpsi_sis_t *p_sis,
+                               dvbpsi_sis_crypt_callback pf_encrypt, void *p_cb_data,
+                               uint8_t *p_buf, size_t i_size, size_t *pi_length);
+
 /*****************************************************************************
  * dvbpsi_sis_sections_generate
  *****************************************************************************
@@ -460,9 +776,25 @@ dvbpsi_descriptor_t *dvbpsi_sis_descriptor_add(dvbpsi_sis_t *p_sis,
  * \return a pointer to the list of generated PSI sections.
  *
  * Generate SIS sections based on the dvbpsi_sis_t structure.
+ * @see dvbpsi_sis_section_encode()
  */
 dvbpsi_psi_section_t *dvbpsi_sis_sections_generate(dvbpsi_t *p_dvbpsi, dvbpsi_sis_t * p_sis);
 
+/*!
+ * \fn dvbpsi_psi_section_t *dvbpsi_sis_sections_generate_encrypted(dvbpsi_t *p_dvbpsi,
+                          dvbpsi_sis_t *p_sis, dvbpsi_sis_crypt_callback pf_encrypt,
+                          void *p_cb_data);
+ * \brief SIS generator for encrypted splice_info_sections
+ * \param p_dvbpsi handle to dvbpsi with attached decoder
+ * \param p_sis SIS structure
+ * \param pf_encrypt encryption callback
+ * \param p_cb_data private data given in argument to the callback.
+ * \return a pointer to the list of generated PSI sections.
+ */
+dvbpsi_psi_section_t *dvbpsi_sis_sections_generate_encrypted(dvbpsi_t *p_dvbpsi,
+                                    dvbpsi_sis_t *p_sis, dvbpsi_sis_crypt_callback pf_encrypt,
+                                    void *p_cb_data);
+
 #ifdef __cplusplus
 };
 #endif
@@ -39,9 +39,12 @@ typedef struct dvbpsi_sis_decoder_s
     dvbpsi_sis_callback           pf_sis_callback;
     void *                        p_cb_data;
 
+    dvbpsi_sis_crypt_callback     pf_decrypt;
+    void *                        p_decrypt_data;
+
     /* */
-    dvbpsi_sis_t                  current_sis;
     dvbpsi_sis_t                  *p_building_sis;
+    dvbpsi_sis_t                  *p_storage;     /* caller provided SIS */
 
 } dvbpsi_sis_decoder_t;
 
@@ -59,8 +62,8 @@ void dvbpsi_sis_sections_gather(dvbpsi_t* p_dvbpsi,
  *****************************************************************************
  * SIS decoder.
  *****************************************************************************/
-void dvbpsi_sis_sections_decode(dvbpsi_t* p_dvbpsi, dvbpsi_sis_t* p_sis,
-                               dvbpsi_psi_section_t* p_section);
+void dvbpsi_sis_sections_decode(dvbpsi_t* p_dvbpsi, dvbpsi_sis_decoder_t* p_sis_decoder,
+                               dvbpsi_sis_t* p_sis, dvbpsi_psi_section_t* p_section);
 
 #else
 #error "Multiple inclusions of sis_private.h"
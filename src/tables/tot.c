@@ -375,16 +375,23 @@ void dvbpsi_tot_sections_gather(dvbpsi_t* p_dvbpsi,
     {
         assert(p_tot_decoder->pf_tot_callback);
 
+        /* Account the acquisition of the table */
+        dvbpsi_decoder_table_complete(p_dvbpsi, p_tot_decoder->p_sections);
+
         /* Save the current information */
         p_tot_decoder->current_tot = *p_tot_decoder->p_building_tot;
         p_tot_decoder->b_current_valid = true;
 
         /* Decode the sections */
+        DVBPSI_TRACE_TABLE(table__decode__entry, p_dvbpsi);
         dvbpsi_tot_sections_decode(p_dvbpsi, p_tot_decoder->p_building_tot,
                                    p_tot_decoder->p_sections);
+        DVBPSI_TRACE_TABLE(table__decode__return, p_dvbpsi);
         /* signal the new TOT */
+        DVBPSI_TRACE_TABLE(table__callback__entry, p_dvbpsi);
         p_tot_decoder->pf_tot_callback(p_tot_decoder->p_cb_data,
                                        p_tot_decoder->p_building_tot);
+        DVBPSI_TRACE_TABLE(table__callback__return, p_dvbpsi);
         /* Delete sections and Reinitialize the structures */
         dvbpsi_ReInitTOT(p_tot_decoder, false);
         assert(p_tot_decoder->p_sections == NULL);
@@ -0,0 +1,915 @@
+/*****************************************************************************
+ * tr101290.c: ETSI TR 101 290 priority 1 and 2 monitor
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "psi.h"
+#include "descriptor.h"
+#include "ts.h"
+#include "tables/pat.h"
+#include "tables/pmt.h"
+#include "tr101290.h"
+
+#define TR101290_PID_COUNT      8192
+#define TR101290_NULL_PID       0x1fff
+#define TR101290_INVALID_CC     0xff
+
+/* Repetition timers are scanned at most this often (in microseconds) */
+#define TR101290_CHECK_INTERVAL 20000
+
+/* PCR values wrap around after 2^33 * 300 ticks of the 27 MHz clock */
+#define TR101290_PCR_WRAP       (UINT64_C(0x200000000) * 300)
+
+/* PID usage flags */
+#define TR101290_PAT            0x01
+#define TR101290_CAT            0x02
+#define TR101290_PMT            0x04
+#define TR101290_SI             0x08
+#define TR101290_PCR            0x10
+#define TR101290_ES             0x20
+
+#define TR101290_PSI            (TR101290_PAT | TR101290_CAT | TR101290_PMT | TR101290_SI)
+#define TR101290_REFERENCED     (TR101290_PCR | TR101290_ES)
+
+/*****************************************************************************
+ * tr101290_pid_t
+ *****************************************************************************
+ * Per PID state.
+ *****************************************************************************/
+typedef struct tr101290_pid_s
+{
+    dvbpsi_tr101290_t  *p_mon;          /* monitor owning this PID */
+    uint16_t            i_pid;
+    uint8_t             i_flags;        /* TR101290_* usage flags */
+    uint16_t            i_pmt_pid;      /* PMT that referenced this PID */
+    uint16_t            i_program;      /* program of the PMT of this PID */
+
+    /* Continuity counter */
+    uint8_t             i_cc;
+    bool                b_cc_duplicate;
+
+    /* PID_error */
+    int64_t             i_last_seen;
+    bool                b_pid_timeout;
+
+    /* PAT_error, PMT_error, CRC_error */
+    dvbpsi_t           *p_dvbpsi;       /* PSI decoder for this PID */
+    int64_t             i_last_section;
+    bool                b_section_timeout;
+
+    /* CAT_error */
+    bool                b_cat_reported;
+
+    /* PCR_repetition_error, PCR_discontinuity_indicator_error,
+     * PCR_accuracy_error */
+    int                 i_pcr_count;    /* valid entries in i_pcr/i_pcr_index */
+    uint64_t            i_pcr[2];       /* previous and last PCR values */
+    uint64_t            i_pcr_index[2]; /* stream packet index of these PCRs */
+    int64_t             i_pcr_date;
+    bool                b_pcr_timeout;
+
+    /* PTS_error */
+    bool                b_pts;
+    int64_t             i_pts_date;
+    bool                b_pts_timeout;
+
+    struct tr101290_pid_s *p_next;      /* next allocated PID */
+} tr101290_pid_t;
+
+/*****************************************************************************
+ * dvbpsi_tr101290_s
+ *****************************************************************************/
+struct dvbpsi_tr101290_s
+{
+    dvbpsi_tr101290_config_t config;
+
+    dvbpsi_tr101290_callback pf_callback;
+    void                    *p_cb_data;
+
+    dvbpsi_message_cb        pf_message;
+    enum dvbpsi_msg_level    i_msg_level;
+
+    /* Synchronisation */
+    bool                     b_sync;
+    int                      i_sync_good;
+    int                      i_sync_bad;
+
+    bool                     b_cat;      /* a CAT has been received */
+
+    uint64_t                 i_packets;  /* packets processed while in sync */
+    int64_t                  i_date;     /* arrival date of current packet */
+    int64_t                  i_last_check;
+    bool                     b_started;
+
+    uint64_t                 i_count[DVBPSI_TR101290_ERROR_MAX];
+
+    tr101290_pid_t          *p_first_pid;
+    tr101290_pid_t          *pp_pids[TR101290_PID_COUNT];
+};
+
+/*****************************************************************************
+ * Local prototypes
+ *****************************************************************************/
+static void tr101290_SectionCheck(dvbpsi_t *p_dvbpsi,
+                                  const dvbpsi_psi_section_t *p_section,
+                                  const bool b_valid);
+static void tr101290_PATCallback(void *p_cb_data, dvbpsi_pat_t *p_pat);
+static void tr101290_PMTCallback(void *p_cb_data, dvbpsi_pmt_t *p_pmt);
+
+/*****************************************************************************
+ * tr101290_Raise
+ *****************************************************************************
+ * Account an error and report it to the application.
+ *****************************************************************************/
+static void tr101290_Raise(dvbpsi_tr101290_t *p_mon, dvbpsi_tr101290_error_t i_error,
+                           uint16_t i_pid, uint8_t i_table_id, int64_t i_value)
+{
+    p_mon->i_count[i_error]++;
+    if (p_mon->pf_callback == NULL)
+        return;
+
+    dvbpsi_tr101290_alarm_t alarm;
+    alarm.i_error = i_error;
+    alarm.i_pid = i_pid;
+    alarm.i_table_id = i_table_id;
+    alarm.i_date = p_mon->i_date;
+    alarm.i_value = i_value;
+    p_mon->pf_callback(p_mon->p_cb_data, &alarm);
+}
+
+/*****************************************************************************
+ * tr101290_GetPID
+ *****************************************************************************
+ * Find the state of a PID, allocate it on first use.
+ *****************************************************************************/
+static tr101290_pid_t *tr101290_GetPID(dvbpsi_tr101290_t *p_mon, uint16_t i_pid)
+{
+    tr101290_pid_t *p_pid = p_mon->pp_pids[i_pid];
+    if (p_pid)
+        return p_pid;
+
+    p_pid = (tr101290_pid_t *)calloc(1, sizeof(tr101290_pid_t));
+    if (p_pid == NULL)
+        return NULL;
+
+    p_pid->p_mon = p_mon;
+    p_pid->i_pid = i_pid;
+    p_pid->i_cc = TR101290_INVALID_CC;
+    p_pid->i_last_seen = p_mon->i_date;
+    p_pid->i_last_section = p_mon->i_date;
+
+    p_pid->p_next = p_mon->p_first_pid;
+    p_mon->p_first_pid = p_pid;
+    p_mon->pp_pids[i_pid] = p_pid;
+    return p_pid;
+}
+
+/*****************************************************************************
+ * tr101290_SinkGather
+ *****************************************************************************
+ * Sections of PSI PIDs that are only checked for CRC_32 errors are dropped.
+ *****************************************************************************/
+static void tr101290_SinkGather(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section)
+{
+    dvbpsi_DeletePSISections(p_section);
+}
+
+/*****************************************************************************
+ * tr101290_AttachPSI
+ *****************************************************************************
+ * Create the PSI decoder that receives the sections of a PID.
+ *****************************************************************************/
+static bool tr101290_AttachPSI(dvbpsi_tr101290_t *p_mon, tr101290_pid_t *p_pid,
+                               uint8_t i_flags, uint16_t i_program_number)
+{
+    if (p_pid->p_dvbpsi)
+        return true;
+
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(p_mon->pf_message, p_mon->i_msg_level);
+    if (p_dvbpsi == NULL)
+        return false;
+
+    bool b_ok;
+    if (i_flags & TR101290_PAT)
+        b_ok = dvbpsi_pat_attach(p_dvbpsi, tr101290_PATCallback, p_mon);
+    else if (i_flags & TR101290_PMT)
+        b_ok = dvbpsi_pmt_attach(p_dvbpsi, i_program_number, tr101290_PMTCallback, p_pid);
+    else
+    {
+        p_dvbpsi->p_decoder = (dvbpsi_decoder_t *)dvbpsi_decoder_new(&tr101290_SinkGather,
+                                             4096, true, sizeof(dvbpsi_decoder_t));
+        b_ok = (p_dvbpsi->p_decoder != NULL);
+    }
+
+    if (!b_ok)
+    {
+        dvbpsi_delete(p_dvbpsi);
+        return false;
+    }
+
+    p_dvbpsi->pf_section = tr101290_SectionCheck;
+    p_dvbpsi->p_sys = p_pid;
+    p_pid->p_dvbpsi = p_dvbpsi;
+    p_pid->i_flags |= i_flags;
+    p_pid->i_program = i_program_number;
+    p_pid->i_last_section = p_mon->i_date;
+    p_pid->b_section_timeout = false;
+    return true;
+}
+
+/*****************************************************************************
+ * tr101290_DetachPSI
+ *****************************************************************************
+ * Destroy the PSI decoder of a PID.
+ *****************************************************************************/
+static void tr101290_DetachPSI(tr101290_pid_t *p_pid)
+{
+    dvbpsi_t *p_dvbpsi = p_pid->p_dvbpsi;
+    if (p_dvbpsi == NULL)
+        return;
+
+    if (p_pid->i_flags & TR101290_PAT)
+        dvbpsi_pat_detach(p_dvbpsi);
+    else if (p_pid->i_flags & TR101290_PMT)
+        dvbpsi_pmt_detach(p_dvbpsi);
+    else
+    {
+        dvbpsi_decoder_delete(p_dvbpsi->p_decoder);
+        p_dvbpsi->p_decoder = NULL;
+    }
+    dvbpsi_delete(p_dvbpsi);
+
+    p_pid->p_dvbpsi = NULL;
+    p_pid->i_flags &= ~TR101290_PSI;
+}
+
+/*****************************************************************************
+ * tr101290_SectionCheck
+ *****************************************************************************
+ * Called by libdvbpsi for each completed section of a monitored PSI PID.
+ *****************************************************************************/
+static void tr101290_SectionCheck(dvbpsi_t *p_dvbpsi,
+                                  const dvbpsi_psi_section_t *p_section,
+                                  const bool b_valid)
+{
+    tr101290_pid_t *p_pid = (tr101290_pid_t *)p_dvbpsi->p_sys;
+    dvbpsi_tr101290_t *p_mon = p_pid->p_mon;
+
+    /* 2.2 CRC_error */
+    if (!b_valid)
+    {
+        tr101290_Raise(p_mon, DVBPSI_TR101290_CRC_ERROR, p_pid->i_pid,
+                       p_section->i_table_id, 0);
+        return;
+    }
+
+    if (p_pid->i_flags & TR101290_PAT)
+    {
+        /* 1.3 PAT_error_2: section with table_id other than 0x00 on PID 0x0000 */
+        if (p_section->i_table_id != 0x00)
+        {
+            tr101290_Raise(p_mon, DVBPSI_TR101290_PAT_ERROR, p_pid->i_pid,
+                           p_section->i_table_id, 0);
+            return;
+        }
+    }
+    else if (p_pid->i_flags & TR101290_CAT)
+    {
+        /* 2.6 CAT_error: section with table_id other than 0x01 on PID 0x0001 */
+        if (p_section->i_table_id != 0x01)
+        {
+            tr101290_Raise(p_mon, DVBPSI_TR101290_CAT_ERROR, p_pid->i_pid,
+                           p_section->i_table_id, 0);
+            return;
+        }
+        if (!p_mon->b_cat)
+        {
+            p_mon->b_cat = true;
+            for (tr101290_pid_t *p = p_mon->p_first_pid; p; p = p->p_next)
+                p->b_cat_reported = false;
+        }
+    }
+    else if (p_pid->i_flags & TR101290_PMT)
+    {
+        if (p_section->i_table_id != 0x02)
+            return;
+    }
+    else
+        return;
+
+    /* 1.3 PAT_error_2 / 1.5 PMT_error_2: repetition interval */
+    const int64_t i_limit = (p_pid->i_flags & TR101290_PAT) ?
+                    p_mon->config.i_pat_interval : p_mon->config.i_pmt_interval;
+    const int64_t i_interval = p_mon->i_date - p_pid->i_last_section;
+    if ((p_pid->i_flags & (TR101290_PAT | TR101290_PMT)) &&
+        (i_interval > i_limit) && !p_pid->b_section_timeout)
+    {
+        tr101290_Raise(p_mon, (p_pid->i_flags & TR101290_PAT) ?
+                              DVBPSI_TR101290_PAT_ERROR : DVBPSI_TR101290_PMT_ERROR,
+                       p_pid->i_pid, p_section->i_table_id, i_interval);
+    }
+    p_pid->i_last_section = p_mon->i_date;
+    p_pid->b_section_timeout = false;
+}
+
+/*****************************************************************************
+ * tr101290_Unreference
+ *****************************************************************************
+ * Forget the PCR and elementary stream PIDs referenced by a PMT.
+ *****************************************************************************/
+static void tr101290_Unreference(dvbpsi_tr101290_t *p_mon, uint16_t i_pmt_pid)
+{
+    for (tr101290_pid_t *p_pid = p_mon->p_first_pid; p_pid; p_pid = p_pid->p_next)
+    {
+        if (!(p_pid->i_flags & TR101290_REFERENCED) || p_pid->i_pmt_pid != i_pmt_pid)
+            continue;
+        p_pid->i_flags &= ~TR101290_REFERENCED;
+        p_pid->i_pmt_pid = 0;
+    }
+}
+
+/*****************************************************************************
+ * tr101290_PMTProgram
+ *****************************************************************************
+ * A PMT PID shared by several programs is checked for the first one only.
+ *****************************************************************************/
+static dvbpsi_pat_program_t *tr101290_PMTProgram(dvbpsi_pat_t *p_pat, uint16_t i_pid)
+{
+    for (dvbpsi_pat_program_t *p_program = p_pat->p_first_program;
+         p_program; p_program = p_program->p_next)
+    {
+        if (p_program->i_number != 0 && p_program->i_pid == i_pid)
+            return p_program;
+    }
+    return NULL;
+}
+
+/*****************************************************************************
+ * tr101290_PATCallback
+ *****************************************************************************
+ * Track the PMT PIDs announced by a new PAT.
+ *****************************************************************************/
+static void tr101290_PATCallback(void *p_cb_data, dvbpsi_pat_t *p_pat)
+{
+    dvbpsi_tr101290_t *p_mon = (dvbpsi_tr101290_t *)p_cb_data;
+
+    if (!p_pat->b_current_next)
+    {
+        dvbpsi_pat_delete(p_pat);
+        return;
+    }
+
+    /* Forget PMT PIDs that are no longer announced, or announced for another
+     * program: their PMT decoder only accepts the previous program */
+    for (tr101290_pid_t *p_pid = p_mon->p_first_pid; p_pid; p_pid = p_pid->p_next)
+    {
+        if (!(p_pid->i_flags & TR101290_PMT))
+            continue;
+
+        dvbpsi_pat_program_t *p_program = tr101290_PMTProgram(p_pat, p_pid->i_pid);
+        if (p_program == NULL || p_program->i_number != p_pid->i_program)
+        {
+            tr101290_Unreference(p_mon, p_pid->i_pid);
+            tr101290_DetachPSI(p_pid);
+        }
+    }
+
+    for (dvbpsi_pat_program_t *p_program = p_pat->p_first_program;
+         p_program; p_program = p_program->p_next)
+    {
+        if (p_program->i_number == 0)
+            continue;
+
+        tr101290_pid_t *p_pid = tr101290_GetPID(p_mon, p_program->i_pid);
+        if (p_pid == NULL || p_pid->p_dvbpsi)
+            continue;
+
+        if (!tr101290_AttachPSI(p_mon, p_pid, TR101290_PMT, p_program->i_number))
+            dvbpsi_error(p_mon->pp_pids[0]->p_dvbpsi, "TR 101 290",
+                         "unable to monitor PMT PID %d", p_program->i_pid);
+    }
+
+    dvbpsi_pat_delete(p_pat);
+}
+
+/*****************************************************************************
+ * tr101290_PMTCallback
+ *****************************************************************************
+ * Track the PCR and elementary stream PIDs referenced by a new PMT.
+ *****************************************************************************/
+static void tr101290_PMTCallback(void *p_cb_data, dvbpsi_pmt_t *p_pmt)
+{
+    tr101290_pid_t *p_pmt_pid = (tr101290_pid_t *)p_cb_data;
+    dvbpsi_tr101290_t *p_mon = p_pmt_pid->p_mon;
+
+    if (!p_pmt->b_current_next)
+    {
+        dvbpsi_pmt_delete(p_pmt);
+        return;
+    }
+
+    /* Drop the references of the previous version */
+    tr101290_Unreference(p_mon, p_pmt_pid->i_pid);
+
+    tr101290_pid_t *p_pid;
+    if (p_pmt->i_pcr_pid != TR101290_NULL_PID)
+    {
+        p_pid = tr101290_GetPID(p_mon, p_pmt->i_pcr_pid);
+        if (p_pid)
+        {
+            if (!(p_pid->i_flags & TR101290_PCR))
+            {
+                p_pid->i_pcr_count = 0;
+                p_pid->i_pcr_date = p_mon->i_date;
+                p_pid->b_pcr_timeout = false;
+            }
+            p_pid->i_flags |= TR101290_PCR;
+            p_pid->i_pmt_pid = p_pmt_pid->i_pid;
+        }
+    }
+
+    for (dvbpsi_pmt_es_t *p_es = p_pmt->p_first_es; p_es; p_es = p_es->p_next)
+    {
+        p_pid = tr101290_GetPID(p_mon, p_es->i_pid);
+        if (p_pid == NULL)
+            continue;
+        p_pid->i_flags |= TR101290_ES;
+        p_pid->i_pmt_pid = p_pmt_pid->i_pid;
+    }
+
+    dvbpsi_pmt_delete(p_pmt);
+}
+
+/*****************************************************************************
+ * tr101290_CheckTimers
+ *****************************************************************************
+ * Report the repetition intervals that expired and are still running.
+ *****************************************************************************/
+static void tr101290_CheckTimers(dvbpsi_tr101290_t *p_mon)
+{
+    const dvbpsi_tr101290_config_t *p_cfg = &p_mon->config;
+    const int64_t i_date = p_mon->i_date;
+
+    p_mon->i_last_check = i_date;
+
+    for (tr101290_pid_t *p_pid = p_mon->p_first_pid; p_pid; p_pid = p_pid->p_next)
+    {
+        /* 1.3 PAT_error_2, 1.5 PMT_error_2 */
+        if ((p_pid->i_flags & (TR101290_PAT | TR101290_PMT)) && !p_pid->b_section_timeout)
+        {
+            const bool b_pat = (p_pid->i_flags & TR101290_PAT);
+            const int64_t i_interval = i_date - p_pid->i_last_section;
+            if (i_interval > (b_pat ? p_cfg->i_pat_interval : p_cfg->i_pmt_interval))
+            {
+                p_pid->b_section_timeout = true;
+                tr101290_Raise(p_mon, b_pat ? DVBPSI_TR101290_PAT_ERROR :
+                                              DVBPSI_TR101290_PMT_ERROR,
+                               p_pid->i_pid, b_pat ? 0x00 : 0x02, i_interval);
+            }
+        }
+
+        /* 1.6 PID_error */
+        if ((p_pid->i_flags & TR101290_REFERENCED) && !p_pid->b_pid_timeout &&
+            (i_date - p_pid->i_last_seen > p_cfg->i_pid_timeout))
+        {
+            p_pid->b_pid_timeout = true;
+            tr101290_Raise(p_mon, DVBPSI_TR101290_PID_ERROR, p_pid->i_pid, 0xff,
+                           i_date - p_pid->i_last_seen);
+        }
+
+        /* 2.3a PCR_repetition_error */
+        if ((p_pid->i_flags & TR101290_PCR) && !p_pid->b_pcr_timeout &&
+            (i_date - p_pid->i_pcr_date > p_cfg->i_pcr_interval))
+        {
+            p_pid->b_pcr_timeout = true;
+            tr101290_Raise(p_mon, DVBPSI_TR101290_PCR_REPETITION_ERROR, p_pid->i_pid,
+                           0xff, i_date - p_pid->i_pcr_date);
+        }
+
+        /* 2.5 PTS_error */
+        if ((p_pid->i_flags & TR101290_ES) && p_pid->b_pts && !p_pid->b_pts_timeout &&
+            (i_date - p_pid->i_pts_date > p_cfg->i_pts_interval))
+        {
+            p_pid->b_pts_timeout = true;
+            tr101290_Raise(p_mon, DVBPSI_TR101290_PTS_ERROR, p_pid->i_pid,
+                           0xff, i_date - p_pid->i_pts_date);
+        }
+    }
+}
+
+/*****************************************************************************
+ * tr101290_CheckPCR
+ *****************************************************************************
+ * PCR repetition, discontinuity and accuracy checks.
+ *****************************************************************************/
+static void tr101290_CheckPCR(dvbpsi_tr101290_t *p_mon, tr101290_pid_t *p_pid,
+                              const dvbpsi_ts_adaptation_field_t *p_af)
+{
+    const dvbpsi_tr101290_config_t *p_cfg = &p_mon->config;
+
+    /* 2.3a PCR_repetition_error */
+    const int64_t i_interval = p_mon->i_date - p_pid->i_pcr_date;
+    if (p_pid->i_pcr_count > 0 && i_interval > p_cfg->i_pcr_interval &&
+        !p_pid->b_pcr_timeout)
+        tr101290_Raise(p_mon, DVBPSI_TR101290_PCR_REPETITION_ERROR,
+                       p_pid->i_pid, 0xff, i_interval);
+    p_pid->i_pcr_date = p_mon->i_date;
+    p_pid->b_pcr_timeout = false;
+
+    if (p_af->b_discontinuity || p_pid->i_pcr_count == 0)
+    {
+        p_pid->i_pcr[1] = p_af->i_pcr;
+        p_pid->i_pcr_index[1] = p_mon->i_packets;
+        p_pid->i_pcr_count = 1;
+        return;
+    }
+
+    /* 2.3b PCR_discontinuity_indicator_error */
+    const uint64_t i_delta = (p_af->i_pcr + TR101290_PCR_WRAP - p_pid->i_pcr[1])
+                                % TR101290_PCR_WRAP;
+    if (i_delta > (uint64_t)p_cfg->i_pcr_discontinuity * (DVBPSI_PCR_CLOCK / 1000000))
+    {
+        tr101290_Raise(p_mon, DVBPSI_TR101290_PCR_DISCONTINUITY_ERROR,
+                       p_pid->i_pid, 0xff, (int64_t)i_delta);
+        p_pid->i_pcr[1] = p_af->i_pcr;
+        p_pid->i_pcr_index[1] = p_mon->i_packets;
+        p_pid->i_pcr_count = 1;
+        return;
+    }
+
+    /* 2.4 PCR_accuracy_error: the PCR is compared with the value expected from
+     * its position in a constant bitrate transport stream, the bitrate being
+     * derived from the two previous PCRs. */
+    if (p_pid->i_pcr_count == 2)
+    {
+        const uint64_t i_ticks = (p_pid->i_pcr[1] + TR101290_PCR_WRAP - p_pid->i_pcr[0])
+                                    % TR101290_PCR_WRAP;
+        const uint64_t i_span = p_pid->i_pcr_index[1] - p_pid->i_pcr_index[0];
+        const uint64_t i_elapsed = p_mon->i_packets - p_pid->i_pcr_index[1];
+        if (i_span > 0)
+        {
+            const int64_t i_expected = (int64_t)(i_ticks * i_elapsed / i_span);
+            int64_t i_error = (int64_t)i_delta - i_expected;
+            if (i_error < 0)
+                i_error = -i_error;
+            const int64_t i_error_ns = i_error * 1000 / (DVBPSI_PCR_CLOCK / 1000000);
+            if (i_error_ns > p_cfg->i_pcr_accuracy_ns)
+                tr101290_Raise(p_mon, DVBPSI_TR101290_PCR_ACCURACY_ERROR,
+                               p_pid->i_pid, 0xff, i_error_ns);
+        }
+    }
+
+    p_pid->i_pcr[0] = p_pid->i_pcr[1];
+    p_pid->i_pcr_index[0] = p_pid->i_pcr_index[1];
+    p_pid->i_pcr[1] = p_af->i_pcr;
+    p_pid->i_pcr_index[1] = p_mon->i_packets;
+    p_pid->i_pcr_count = 2;
+}
+
+/*****************************************************************************
+ * tr101290_CheckPTS
+ *****************************************************************************
+ * Look for a PTS in the PES header starting in this packet.
+ *****************************************************************************/
+static void tr101290_CheckPTS(dvbpsi_tr101290_t *p_mon, tr101290_pid_t *p_pid,
+                              const uint8_t *p_payload, const uint8_t *p_end)
+{
+    if (p_end - p_payload < 14)
+        return;
+    if (p_payload[0] != 0x00 || p_payload[1] != 0x00 || p_payload[2] != 0x01)
+        return;
+
+    /* stream_id without PES header extension */
+    switch (p_payload[3])
+    {
+        case 0xbc: case 0xbe: case 0xbf: case 0xf0:
+        case 0xf1: case 0xf2: case 0xf8: case 0xff:
+            return;
+        default:
+            break;
+    }
+
+    if ((p_payload[6] & 0xc0) != 0x80 || !(p_payload[7] & 0x80))
+        return;
+
+    /* 2.5 PTS_error */
+    const int64_t i_interval = p_mon->i_date - p_pid->i_pts_date;
+    if (p_pid->b_pts && i_interval > p_mon->config.i_pts_interval &&
+        !p_pid->b_pts_timeout)
+        tr101290_Raise(p_mon, DVBPSI_TR101290_PTS_ERROR, p_pid->i_pid,
+                       0xff, i_interval);
+
+    p_pid->b_pts = true;
+    p_pid->i_pts_date = p_mon->i_date;
+    p_pid->b_pts_timeout = false;
+}
+
+/*****************************************************************************
+ * tr101290_CheckCC
+ *****************************************************************************
+ * 1.4 Continuity_count_error.
+ *****************************************************************************/
+static void tr101290_CheckCC(dvbpsi_tr101290_t *p_mon, tr101290_pid_t *p_pid,
+                             const uint8_t *p_data, bool b_discontinuity)
+{
+    const uint8_t i_cc = p_data[3] & 0x0f;
+    const bool b_payload = (p_data[3] & 0x10);
+
+    if (p_pid->i_cc == TR101290_INVALID_CC || b_discontinuity)
+    {
+        p_pid->i_cc = i_cc;
+        p_pid->b_cc_duplicate = false;
+        return;
+    }
+
+    bool b_error = false;
+    if (!b_payload)
+        b_error = (i_cc != p_pid->i_cc);
+    else if (i_cc == ((p_pid->i_cc + 1) & 0x0f))
+        p_pid->b_cc_duplicate = false;
+    else if (i_cc == p_pid->i_cc && !p_pid->b_cc_duplicate)
+        p_pid->b_cc_duplicate = true; /* a packet may be sent twice */
+    else
+        b_error = true;
+
+    if (b_error)
+    {
+        tr101290_Raise(p_mon, DVBPSI_TR101290_CC_ERROR, p_pid->i_pid, 0xff, i_cc);
+        p_pid->b_cc_duplicate = false;
+    }
+    p_pid->i_cc = i_cc;
+}
+
+/*****************************************************************************
+ * tr101290_CheckSync
+ *****************************************************************************
+ * 1.1 TS_sync_loss and 1.2 Sync_byte_error. Returns true when the packet
+ * should be analysed further.
+ *****************************************************************************/
+static bool tr101290_CheckSync(dvbpsi_tr101290_t *p_mon, const uint8_t *p_data)
+{
+    if (p_data[0] == 0x47)
+    {
+        p_mon->i_sync_bad = 0;
+        if (!p_mon->b_sync && ++p_mon->i_sync_good >= 5)
+            p_mon->b_sync = true;
+        return p_mon->b_sync;
+    }
+
+    p_mon->i_sync_good = 0;
+    if (!p_mon->b_sync)
+        return false;
+
+    tr101290_Raise(p_mon, DVBPSI_TR101290_SYNC_BYTE_ERROR, TR101290_NULL_PID,
+                   0xff, p_data[0]);
+    if (++p_mon->i_sync_bad >= 2)
+    {
+        p_mon->b_sync = false;
+        tr101290_Raise(p_mon, DVBPSI_TR101290_TS_SYNC_LOSS, TR101290_NULL_PID,
+                       0xff, p_mon->i_sync_bad);
+    }
+    return false;
+}
+
+/*****************************************************************************
+ * dvbpsi_tr101290_config_default
+ *****************************************************************************/
+void dvbpsi_tr101290_config_default(dvbpsi_tr101290_config_t *p_config)
+{
+    assert(p_config);
+
+    p_config->i_pat_interval = 500000;
+    p_config->i_pmt_interval = 500000;
+    p_config->i_pid_timeout = 5000000;
+    p_config->i_pcr_interval = 100000;
+    p_config->i_pcr_discontinuity = 100000;
+    p_config->i_pcr_accuracy_ns = 500;
+    p_config->i_pts_interval = 700000;
+}
+
+/*****************************************************************************
+ * dvbpsi_tr101290_new
+ *****************************************************************************/
+dvbpsi_tr101290_t *dvbpsi_tr101290_new(const dvbpsi_tr101290_config_t *p_config,
+                                       dvbpsi_tr101290_callback pf_callback,
+                                       void *p_cb_data,
+                                       dvbpsi_message_cb pf_message,
+                                       enum dvbpsi_msg_level level)
+{
+    dvbpsi_tr101290_t *p_mon = (dvbpsi_tr101290_t *)calloc(1, sizeof(dvbpsi_tr101290_t));
+    if (p_mon == NULL)
+        return NULL;
+
+    if (p_config)
+        p_mon->config = *p_config;
+    else
+        dvbpsi_tr101290_config_default(&p_mon->config);
+
+    p_mon->pf_callback = pf_callback;
+    p_mon->p_cb_data = p_cb_data;
+    p_mon->pf_message = pf_message;
+    p_mon->i_msg_level = level;
+
+    /* PAT and CAT are always monitored, NIT, SDT/BAT, EIT and TDT/TOT are
+     * checked for CRC_32 errors */
+    static const uint16_t pi_si_pids[] = { 0x10, 0x11, 0x12, 0x14 };
+    tr101290_pid_t *p_pat = tr101290_GetPID(p_mon, 0x00);
+    tr101290_pid_t *p_cat = tr101290_GetPID(p_mon, 0x01);
+    if (!p_pat || !tr101290_AttachPSI(p_mon, p_pat, TR101290_PAT, 0) ||
+        !p_cat || !tr101290_AttachPSI(p_mon, p_cat, TR101290_CAT, 0))
+        goto error;
+
+    for (unsigned int i = 0; i < ARRAY_SIZE(pi_si_pids); i++)
+    {
+        tr101290_pid_t *p_pid = tr101290_GetPID(p_mon, pi_si_pids[i]);
+        if (!p_pid || !tr101290_AttachPSI(p_mon, p_pid, TR101290_SI, 0))
+            goto error;
+    }
+
+    return p_mon;
+
+error:
+    dvbpsi_tr101290_delete(p_mon);
+    return NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_tr101290_delete
+ *****************************************************************************/
+void dvbpsi_tr101290_delete(dvbpsi_tr101290_t *p_mon)
+{
+    if (p_mon == NULL)
+        return;
+
+    tr101290_pid_t *p_pid = p_mon->p_first_pid;
+    while (p_pid)
+    {
+        tr101290_pid_t *p_next = p_pid->p_next;
+        tr101290_DetachPSI(p_pid);
+        free(p_pid);
+        p_pid = p_next;
+    }
+    free(p_mon);
+}
+
+/*****************************************************************************
+ * dvbpsi_tr101290_packet_push
+ *****************************************************************************/
+void dvbpsi_tr101290_packet_push(dvbpsi_tr101290_t *p_mon,
+                                 const uint8_t *p_data, int64_t i_date)
+{
+    assert(p_mon);
+    assert(p_data);
+
+    p_mon->i_date = i_date;
+    if (!p_mon->b_started)
+    {
+        /* Repetition intervals start with the first packet */
+        for (tr101290_pid_t *p = p_mon->p_first_pid; p; p = p->p_next)
+        {
+            p->i_last_seen = i_date;
+            p->i_last_section = i_date;
+        }
+        p_mon->i_last_check = i_date;
+        p_mon->b_started = true;
+    }
+
+    if (tr101290_CheckSync(p_mon, p_data))
+    {
+        const uint16_t i_pid = dvbpsi_ts_pid(p_data);
+        p_mon->i_packets++;
+
+        /* 2.1 Transport_error: the content of the packet can't be trusted */
+        if (p_data[1] & 0x80)
+            tr101290_Raise(p_mon, DVBPSI_TR101290_TRANSPORT_ERROR, i_pid, 0xff, 0);
+        else if (i_pid != TR101290_NULL_PID)
+        {
+            tr101290_pid_t *p_pid = tr101290_GetPID(p_mon, i_pid);
+            if (p_pid == NULL)
+                return;
+
+            p_pid->i_last_seen = i_date;
+            p_pid->b_pid_timeout = false;
+
+            dvbpsi_ts_adaptation_field_t af;
+            bool b_af = dvbpsi_ts_adaptation_field_decode(p_data, &af);
+
+            tr101290_CheckCC(p_mon, p_pid, p_data, b_af && af.b_discontinuity);
+
+            const uint8_t i_scrambling = (p_data[3] & 0xc0) >> 6;
+            if (i_scrambling)
+            {
+                if (p_pid->i_flags & (TR101290_PAT | TR101290_PMT))
+                    tr101290_Raise(p_mon, (p_pid->i_flags & TR101290_PAT) ?
+                                   DVBPSI_TR101290_PAT_ERROR : DVBPSI_TR101290_PMT_ERROR,
+                                   i_pid, 0xff, i_scrambling);
+                /* 2.6 CAT_error: scrambled packets without CAT, reported once
+                 * per PID */
+                if (!p_mon->b_cat && !p_pid->b_cat_reported)
+                {
+                    p_pid->b_cat_reported = true;
+                    tr101290_Raise(p_mon, DVBPSI_TR101290_CAT_ERROR, i_pid,
+                                   0xff, i_scrambling);
+                }
+            }
+
+            if ((p_pid->i_flags & TR101290_PCR) && b_af && af.b_pcr)
+                tr101290_CheckPCR(p_mon, p_pid, &af);
+
+            if ((p_pid->i_flags & TR101290_ES) && (p_data[1] & 0x40) &&
+                (p_data[3] & 0x10) && !i_scrambling)
+            {
+                const uint8_t *p_payload = p_data + 4;
+                if (dvbpsi_ts_has_adaptation_field(p_data))
+                    p_payload += 1 + p_data[4];
+                if (p_payload < p_data + DVBPSI_TS_PACKET_SIZE)
+                    tr101290_CheckPTS(p_mon, p_pid, p_payload,
+                                      p_data + DVBPSI_TS_PACKET_SIZE);
+            }
+
+            if (p_pid->p_dvbpsi && !i_scrambling)
+                dvbpsi_packet_push_date(p_pid->p_dvbpsi, p_data, i_date);
+        }
+    }
+
+    if (i_date - p_mon->i_last_check >= TR101290_CHECK_INTERVAL)
+        tr101290_CheckTimers(p_mon);
+}
+
+/*****************************************************************************
+ * dvbpsi_tr101290_packets_push
+ *****************************************************************************/
+void dvbpsi_tr101290_packets_push(dvbpsi_tr101290_t *p_mon, const uint8_t *p_data,
+                                  size_t i_packets, int64_t i_date)
+{
+    assert(p_mon);
+    assert(p_data);
+
+    for (size_t i = 0; i < i_packets; i++)
+    {
+        dvbpsi_tr101290_packet_push(p_mon, p_data, i_date);
+        p_data += DVBPSI_TS_PACKET_SIZE;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_tr101290_check
+ *****************************************************************************/
+void dvbpsi_tr101290_check(dvbpsi_tr101290_t *p_mon, int64_t i_date)
+{
+    assert(p_mon);
+
+    if (!p_mon->b_started)
+        return;
+
+    p_mon->i_date = i_date;
+    tr101290_CheckTimers(p_mon);
+}
+
+/*****************************************************************************
+ * dvbpsi_tr101290_count
+ *****************************************************************************/
+uint64_t dvbpsi_tr101290_count(const dvbpsi_tr101290_t *p_mon,
+                               dvbpsi_tr101290_error_t i_error)
+{
+    assert(p_mon);
+
+    if ((unsigned int)i_error >= DVBPSI_TR101290_ERROR_MAX)
+        return 0;
+    return p_mon->i_count[i_error];
+}
@@ -0,0 +1,258 @@
+/*****************************************************************************
+ * tr101290.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <tr101290.h>
+ * \brief Application interface for the ETSI TR 101 290 monitor.
+ *
+ * Application interface for the ETSI TR 101 290 (ETR 290) priority 1 and
+ * priority 2 checks. The monitor is fed with every TS packet of a transport
+ * stream together with its arrival date. It decodes the PAT and PMTs itself
+ * to learn which PIDs are referenced and reports each detected error by
+ * callback to the application.
+ *
+ * All dates and intervals are expressed in microseconds.
+ */
+
+#ifndef _DVBPSI_TR101290_H_
+#define _DVBPSI_TR101290_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * dvbpsi_tr101290_error_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_tr101290_error_e
+ * \brief TR 101 290 indicators (ETSI TR 101 290 section 5.2).
+ */
+/*!
+ * \typedef enum dvbpsi_tr101290_error_e dvbpsi_tr101290_error_t
+ * \brief dvbpsi_tr101290_error_t type definition.
+ */
+typedef enum dvbpsi_tr101290_error_e
+{
+    /* First priority */
+    DVBPSI_TR101290_TS_SYNC_LOSS = 0,   /*!< 1.1 TS_sync_loss */
+    DVBPSI_TR101290_SYNC_BYTE_ERROR,    /*!< 1.2 Sync_byte_error */
+    DVBPSI_TR101290_PAT_ERROR,          /*!< 1.3 PAT_error_2 */
+    DVBPSI_TR101290_CC_ERROR,           /*!< 1.4 Continuity_count_error */
+    DVBPSI_TR101290_PMT_ERROR,          /*!< 1.5 PMT_error_2 */
+    DVBPSI_TR101290_PID_ERROR,          /*!< 1.6 PID_error */
+    /* Second priority */
+    DVBPSI_TR101290_TRANSPORT_ERROR,    /*!< 2.1 Transport_error */
+    DVBPSI_TR101290_CRC_ERROR,          /*!< 2.2 CRC_error */
+    DVBPSI_TR101290_PCR_REPETITION_ERROR,    /*!< 2.3a PCR_repetition_error */
+    DVBPSI_TR101290_PCR_DISCONTINUITY_ERROR, /*!< 2.3b PCR_discontinuity_indicator_error */
+    DVBPSI_TR101290_PCR_ACCURACY_ERROR, /*!< 2.4 PCR_accuracy_error */
+    DVBPSI_TR101290_PTS_ERROR,          /*!< 2.5 PTS_error */
+    DVBPSI_TR101290_CAT_ERROR,          /*!< 2.6 CAT_error */
+
+    DVBPSI_TR101290_ERROR_MAX           /*!< Number of indicators */
+} dvbpsi_tr101290_error_t;
+
+/*****************************************************************************
+ * dvbpsi_tr101290_alarm_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_tr101290_alarm_s
+ * \brief TR 101 290 alarm.
+ *
+ * This structure describes one detected error. It is only valid for the
+ * duration of the callback.
+ */
+/*!
+ * \typedef struct dvbpsi_tr101290_alarm_s dvbpsi_tr101290_alarm_t
+ * \brief dvbpsi_tr101290_alarm_t type definition.
+ */
+typedef struct dvbpsi_tr101290_alarm_s
+{
+    dvbpsi_tr101290_error_t i_error;    /*!< indicator that triggered */
+    uint16_t                i_pid;      /*!< PID concerned, 0x1fff if the
+                                             error is not PID specific */
+    uint8_t                 i_table_id; /*!< table_id concerned, 0xff if the
+                                             error is not table specific */
+    int64_t                 i_date;     /*!< arrival date of the packet that
+                                             revealed the error */
+    int64_t                 i_value;    /*!< measured value: interval for
+                                             repetition errors, PCR deviation
+                                             in ns for accuracy errors, received
+                                             continuity_counter for CC errors */
+} dvbpsi_tr101290_alarm_t;
+
+/*****************************************************************************
+ * dvbpsi_tr101290_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_tr101290_callback)(void *p_cb_data,
+                                    const dvbpsi_tr101290_alarm_t *p_alarm)
+ * \brief Callback type definition.
+ */
+typedef void (* dvbpsi_tr101290_callback)(void *p_cb_data,
+                                          const dvbpsi_tr101290_alarm_t *p_alarm);
+
+/*****************************************************************************
+ * dvbpsi_tr101290_config_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_tr101290_config_s
+ * \brief TR 101 290 monitor limits, in microseconds unless noted otherwise.
+ */
+/*!
+ * \typedef struct dvbpsi_tr101290_config_s dvbpsi_tr101290_config_t
+ * \brief dvbpsi_tr101290_config_t type definition.
+ */
+typedef struct dvbpsi_tr101290_config_s
+{
+    int64_t     i_pat_interval;     /*!< max PAT interval (500 ms) */
+    int64_t     i_pmt_interval;     /*!< max PMT interval (500 ms) */
+    int64_t     i_pid_timeout;      /*!< max interval for referenced PIDs
+                                         (user defined, default 5 s) */
+    int64_t     i_pcr_interval;     /*!< max PCR interval (100 ms) */
+    int64_t     i_pcr_discontinuity;/*!< max difference between two
+                                         consecutive PCR values (100 ms) */
+    int64_t     i_pcr_accuracy_ns;  /*!< max PCR deviation in ns (500 ns) */
+    int64_t     i_pts_interval;     /*!< max PTS interval (700 ms) */
+} dvbpsi_tr101290_config_t;
+
+/*****************************************************************************
+ * dvbpsi_tr101290_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_tr101290_s dvbpsi_tr101290_t
+ * \brief Opaque TR 101 290 monitor handle.
+ */
+typedef struct dvbpsi_tr101290_s dvbpsi_tr101290_t;
+
+/*****************************************************************************
+ * dvbpsi_tr101290_config_default
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_tr101290_config_default(dvbpsi_tr101290_config_t *p_config)
+ * \brief Fill in the limits recommended by ETSI TR 101 290.
+ * \param p_config pointer to the configuration to initialize
+ * \return nothing.
+ */
+void dvbpsi_tr101290_config_default(dvbpsi_tr101290_config_t *p_config);
+
+/*****************************************************************************
+ * dvbpsi_tr101290_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_tr101290_t *dvbpsi_tr101290_new(const dvbpsi_tr101290_config_t *p_config,
+                        dvbpsi_tr101290_callback pf_callback, void *p_cb_data,
+                        dvbpsi_message_cb pf_message, enum dvbpsi_msg_level level)
+ * \brief Create a TR 101 290 monitor for one transport stream.
+ * \param p_config limits to use, NULL for the defaults
+ * \param pf_callback function to call back on each detected error
+ * \param p_cb_data private data given in argument to the callback
+ * \param pf_message message callback handler for the internal PSI decoders,
+ * may be NULL
+ * \param level enum dvbpsi_msg_level for filtering logging messages
+ * \return pointer to the monitor, NULL on error.
+ */
+dvbpsi_tr101290_t *dvbpsi_tr101290_new(const dvbpsi_tr101290_config_t *p_config,
+                                       dvbpsi_tr101290_callback pf_callback,
+                                       void *p_cb_data,
+                                       dvbpsi_message_cb pf_message,
+                                       enum dvbpsi_msg_level level);
+
+/*****************************************************************************
+ * dvbpsi_tr101290_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_tr101290_delete(dvbpsi_tr101290_t *p_mon)
+ * \brief Destroy a TR 101 290 monitor.
+ * \param p_mon pointer to the monitor
+ * \return nothing.
+ */
+void dvbpsi_tr101290_delete(dvbpsi_tr101290_t *p_mon);
+
+/*****************************************************************************
+ * dvbpsi_tr101290_packet_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_tr101290_packet_push(dvbpsi_tr101290_t *p_mon,
+                                        const uint8_t *p_data, int64_t i_date)
+ * \brief Inject one TS packet into the monitor.
+ * \param p_mon pointer to the monitor
+ * \param p_data pointer to a 188 bytes TS packet
+ * \param i_date arrival date of the packet in microseconds
+ * \return nothing.
+ *
+ * Dates must be monotonic. Timeouts are evaluated when packets are pushed,
+ * so an application that may stop receiving packets should call
+ * dvbpsi_tr101290_check() from a timer.
+ */
+void dvbpsi_tr101290_packet_push(dvbpsi_tr101290_t *p_mon,
+                                 const uint8_t *p_data, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_tr101290_packets_push
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_tr101290_packets_push(dvbpsi_tr101290_t *p_mon,
+                      const uint8_t *p_data, size_t i_packets, int64_t i_date)
+ * \brief Inject a buffer of TS packets received at the same time.
+ * \param p_mon pointer to the monitor
+ * \param p_data pointer to i_packets * 188 bytes of TS packets
+ * \param i_packets number of TS packets in p_data
+ * \param i_date arrival date of the buffer in microseconds
+ * \return nothing.
+ */
+void dvbpsi_tr101290_packets_push(dvbpsi_tr101290_t *p_mon, const uint8_t *p_data,
+                                  size_t i_packets, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_tr101290_check
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_tr101290_check(dvbpsi_tr101290_t *p_mon, int64_t i_date)
+ * \brief Evaluate the repetition timers at the given date.
+ * \param p_mon pointer to the monitor
+ * \param i_date current date in microseconds
+ * \return nothing.
+ */
+void dvbpsi_tr101290_check(dvbpsi_tr101290_t *p_mon, int64_t i_date);
+
+/*****************************************************************************
+ * dvbpsi_tr101290_count
+ *****************************************************************************/
+/*!
+ * \fn uint64_t dvbpsi_tr101290_count(const dvbpsi_tr101290_t *p_mon,
+                                      dvbpsi_tr101290_error_t i_error)
+ * \brief Number of times an indicator has been raised.
+ * \param p_mon pointer to the monitor
+ * \param i_error indicator
+ * \return error count since the monitor was created.
+ */
+uint64_t dvbpsi_tr101290_count(const dvbpsi_tr101290_t *p_mon,
+                               dvbpsi_tr101290_error_t i_error);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of tr101290.h"
+#endif
@@ -0,0 +1,236 @@
+/*****************************************************************************
+ * ts.c: TS packet and adaptation field functions
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "ts.h"
+
+/*****************************************************************************
+ * ts_DecodeClockReference
+ *****************************************************************************
+ * Decode a 33 bits base + 9 bits extension clock reference into 27 MHz units.
+ *****************************************************************************/
+static inline uint64_t ts_DecodeClockReference(const uint8_t *p)
+{
+    uint64_t i_base = ((uint64_t)p[0] << 25) |
+                      ((uint64_t)p[1] << 17) |
+                      ((uint64_t)p[2] << 9)  |
+                      ((uint64_t)p[3] << 1)  |
+                      ((uint64_t)p[4] >> 7);
+    uint16_t i_ext  = ((uint16_t)(p[4] & 0x01) << 8) | p[5];
+
+    return i_base * 300 + i_ext;
+}
+
+/*****************************************************************************
+ * dvbpsi_ts_adaptation_field_decode
+ *****************************************************************************
+ * Decode the adaptation field of one TS packet.
+ *****************************************************************************/
+bool dvbpsi_ts_adaptation_field_decode(const uint8_t *p_packet,
+                                       dvbpsi_ts_adaptation_field_t *p_af)
+{
+    assert(p_packet);
+    assert(p_af);
+
+    memset(p_af, 0, sizeof(dvbpsi_ts_adaptation_field_t));
+
+    if (p_packet[0] != 0x47)
+        return false;
+
+    p_af->i_pid = dvbpsi_ts_pid(p_packet);
+
+    if (!dvbpsi_ts_has_adaptation_field(p_packet))
+        return false;
+
+    /* adaptation_field_length is at most 183 bytes */
+    uint8_t i_length = p_packet[4];
+    if (i_length > DVBPSI_TS_PACKET_SIZE - 5)
+        return false;
+
+    p_af->i_length = i_length;
+    if (i_length == 0) /* single stuffing byte */
+        return true;
+
+    const uint8_t i_flags = p_packet[5];
+    const unsigned int i_end = 5 + i_length;
+    unsigned int i_pos = 6;
+
+    p_af->b_discontinuity  = (i_flags & 0x80) == 0x80;
+    p_af->b_random_access  = (i_flags & 0x40) == 0x40;
+    p_af->b_es_priority    = (i_flags & 0x20) == 0x20;
+    p_af->b_pcr            = (i_flags & 0x10) == 0x10;
+    p_af->b_opcr           = (i_flags & 0x08) == 0x08;
+    p_af->b_splicing_point = (i_flags & 0x04) == 0x04;
+    p_af->b_private_data   = (i_flags & 0x02) == 0x02;
+    p_af->b_extension      = (i_flags & 0x01) == 0x01;
+
+    if (p_af->b_pcr)
+    {
+        if (i_pos + 6 > i_end)
+            goto error;
+        p_af->i_pcr = ts_DecodeClockReference(&p_packet[i_pos]);
+        i_pos += 6;
+    }
+
+    if (p_af->b_opcr)
+    {
+        if (i_pos + 6 > i_end)
+            goto error;
+        p_af->i_opcr = ts_DecodeClockReference(&p_packet[i_pos]);
+        i_pos += 6;
+    }
+
+    if (p_af->b_splicing_point)
+    {
+        if (i_pos + 1 > i_end)
+            goto error;
+        /* two's complement */
+        p_af->i_splice_countdown = (int8_t)p_packet[i_pos];
+        i_pos++;
+    }
+
+    if (p_af->b_private_data)
+    {
+        if (i_pos + 1 > i_end)
+            goto error;
+        p_af->i_private_data_length = p_packet[i_pos];
+        p_af->i_private_data_offset = i_pos + 1;
+        i_pos += 1 + p_af->i_private_data_length;
+        if (i_pos > i_end)
+            goto error;
+    }
+
+    if (p_af->b_extension)
+    {
+        if (i_pos + 1 > i_end)
+            goto error;
+        p_af->i_extension_length = p_packet[i_pos];
+        p_af->i_extension_offset = i_pos + 1;
+        i_pos += 1 + p_af->i_extension_length;
+        if (i_pos > i_end)
+            goto error;
+    }
+
+    return true;
+
+error:
+    /* Malformed adaptation field, do not report partial information */
+    memset(p_af, 0, sizeof(dvbpsi_ts_adaptation_field_t));
+    p_af->i_pid = dvbpsi_ts_pid(p_packet);
+    return false;
+}
+
+/*****************************************************************************
+ * dvbpsi_ts_adaptation_fields_decode
+ *****************************************************************************
+ * Decode the adaptation fields of a buffer of TS packets.
+ *****************************************************************************/
+size_t dvbpsi_ts_adaptation_fields_decode(const uint8_t *p_data, size_t i_packets,
+                                          dvbpsi_ts_adaptation_field_t *p_af)
+{
+    assert(p_data);
+    assert(p_af);
+
+    size_t i_found = 0;
+    for (size_t i = 0; i < i_packets; i++)
+    {
+        if (dvbpsi_ts_adaptation_field_decode(p_data, &p_af[i]))
+            i_found++;
+        p_data += DVBPSI_TS_PACKET_SIZE;
+    }
+    return i_found;
+}
+
+/*****************************************************************************
+ * dvbpsi_ts_af_extension_decode
+ *****************************************************************************
+ * Decode the adaptation_field_extension of a TS packet.
+ *****************************************************************************/
+bool dvbpsi_ts_af_extension_decode(const uint8_t *p_packet,
+                                   const dvbpsi_ts_adaptation_field_t *p_af,
+                                   dvbpsi_ts_af_extension_t *p_ext)
+{
+    assert(p_packet);
+    assert(p_af);
+    assert(p_ext);
+
+    memset(p_ext, 0, sizeof(dvbpsi_ts_af_extension_t));
+
+    if (!p_af->b_extension || p_af->i_extension_length == 0)
+        return false;
+
+    const uint8_t *p = &p_packet[p_af->i_extension_offset];
+    const uint8_t *p_end = p + p_af->i_extension_length;
+
+    p_ext->b_ltw             = (p[0] & 0x80) == 0x80;
+    p_ext->b_piecewise_rate  = (p[0] & 0x40) == 0x40;
+    p_ext->b_seamless_splice = (p[0] & 0x20) == 0x20;
+    p++;
+
+    if (p_ext->b_ltw)
+    {
+        if (p + 2 > p_end)
+            return false;
+        p_ext->b_ltw_valid  = (p[0] & 0x80) == 0x80;
+        p_ext->i_ltw_offset = ((uint16_t)(p[0] & 0x7f) << 8) | p[1];
+        p += 2;
+    }
+
+    if (p_ext->b_piecewise_rate)
+    {
+        if (p + 3 > p_end)
+            return false;
+        p_ext->i_piecewise_rate = ((uint32_t)(p[0] & 0x3f) << 16) |
+                                  ((uint32_t)p[1] << 8) | p[2];
+        p += 3;
+    }
+
+    if (p_ext->b_seamless_splice)
+    {
+        if (p + 5 > p_end)
+            return false;
+        p_ext->i_splice_type = (p[0] & 0xf0) >> 4;
+        p_ext->i_dts_next_au = ((uint64_t)(p[0] & 0x0e) << 29) |
+                               ((uint64_t)p[1] << 22) |
+                               ((uint64_t)(p[2] & 0xfe) << 14) |
+                               ((uint64_t)p[3] << 7) |
+                               ((uint64_t)p[4] >> 1);
+    }
+
+    return true;
+}
@@ -0,0 +1,215 @@
+/*****************************************************************************
+ * ts.h
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <ts.h>
+ * \brief Common TS packet tools.
+ *
+ * TS packet header and adaptation field decoding (ISO/IEC 13818-1
+ * section 2.4.3.4). The decoders work directly on 188 bytes TS packets and
+ * do not need a dvbpsi_t handle.
+ */
+
+#ifndef _DVBPSI_TS_H_
+#define _DVBPSI_TS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def DVBPSI_TS_PACKET_SIZE
+ * \brief Size of a TS packet in bytes.
+ */
+#define DVBPSI_TS_PACKET_SIZE   188
+
+/*!
+ * \def DVBPSI_PCR_CLOCK
+ * \brief Frequency of the system clock that PCR and OPCR values are
+ * expressed in (27 MHz).
+ */
+#define DVBPSI_PCR_CLOCK        27000000
+
+/*****************************************************************************
+ * TS packet header helpers
+ *****************************************************************************/
+/*!
+ * \fn static inline uint16_t dvbpsi_ts_pid(const uint8_t *p_packet)
+ * \brief Get the PID of a TS packet.
+ * \param p_packet pointer to a 188 bytes TS packet
+ * \return PID of the packet
+ */
+static inline uint16_t dvbpsi_ts_pid(const uint8_t *p_packet)
+{
+    return ((uint16_t)(p_packet[1] & 0x1f) << 8) | p_packet[2];
+}
+
+/*!
+ * \fn static inline bool dvbpsi_ts_has_adaptation_field(const uint8_t *p_packet)
+ * \brief Check if a TS packet carries an adaptation_field.
+ * \param p_packet pointer to a 188 bytes TS packet
+ * \return true if adaptation_field_control signals an adaptation field.
+ */
+static inline bool dvbpsi_ts_has_adaptation_field(const uint8_t *p_packet)
+{
+    return ((p_packet[3] & 0x20) == 0x20);
+}
+
+/*****************************************************************************
+ * dvbpsi_ts_adaptation_field_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_ts_adaptation_field_s
+ * \brief Decoded adaptation field.
+ *
+ * This structure is used to store a decoded adaptation field
+ * (ISO/IEC 13818-1 section 2.4.3.4). It is kept small so that arrays of
+ * records can be scanned in a tight loop. Variable length parts of the
+ * adaptation field (transport_private_data and adaptation_field_extension)
+ * are not copied, instead their offset from the start of the TS packet is
+ * stored.
+ */
+/*!
+ * \typedef struct dvbpsi_ts_adaptation_field_s dvbpsi_ts_adaptation_field_t
+ * \brief dvbpsi_ts_adaptation_field_t type definition.
+ */
+typedef struct dvbpsi_ts_adaptation_field_s
+{
+    uint64_t    i_pcr;              /*!< program_clock_reference in 27 MHz
+                                         units, valid if b_pcr is set */
+    uint64_t    i_opcr;             /*!< original_program_clock_reference in
+                                         27 MHz units, valid if b_opcr is set */
+    uint16_t    i_pid;              /*!< PID of the TS packet */
+    uint8_t     i_length;           /*!< adaptation_field_length */
+
+    bool        b_discontinuity;    /*!< discontinuity_indicator */
+    bool        b_random_access;    /*!< random_access_indicator */
+    bool        b_es_priority;      /*!< elementary_stream_priority_indicator */
+    bool        b_pcr;              /*!< PCR_flag */
+    bool        b_opcr;             /*!< OPCR_flag */
+    bool        b_splicing_point;   /*!< splicing_point_flag */
+    bool        b_private_data;     /*!< transport_private_data_flag */
+    bool        b_extension;        /*!< adaptation_field_extension_flag */
+
+    int8_t      i_splice_countdown; /*!< splice_countdown, valid if
+                                         b_splicing_point is set */
+
+    uint8_t     i_private_data_offset; /*!< offset of transport_private_data
+                                            in the TS packet */
+    uint8_t     i_private_data_length; /*!< transport_private_data_length */
+    uint8_t     i_extension_offset;    /*!< offset of the first byte after
+                                            adaptation_field_extension_length
+                                            in the TS packet */
+    uint8_t     i_extension_length;    /*!< adaptation_field_extension_length */
+} dvbpsi_ts_adaptation_field_t;
+
+/*****************************************************************************
+ * dvbpsi_ts_af_extension_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_ts_af_extension_s
+ * \brief Decoded adaptation field extension.
+ *
+ * This structure is used to store a decoded adaptation_field_extension
+ * (ISO/IEC 13818-1 section 2.4.3.4).
+ */
+/*!
+ * \typedef struct dvbpsi_ts_af_extension_s dvbpsi_ts_af_extension_t
+ * \brief dvbpsi_ts_af_extension_t type definition.
+ */
+typedef struct dvbpsi_ts_af_extension_s
+{
+    bool        b_ltw;              /*!< ltw_flag */
+    bool        b_piecewise_rate;   /*!< piecewise_rate_flag */
+    bool        b_seamless_splice;  /*!< seamless_splice_flag */
+
+    /* if (b_ltw) */
+    bool        b_ltw_valid;        /*!< ltw_valid_flag */
+    uint16_t    i_ltw_offset;       /*!< ltw_offset (15 bits) */
+
+    /* if (b_piecewise_rate) */
+    uint32_t    i_piecewise_rate;   /*!< piecewise_rate (22 bits) */
+
+    /* if (b_seamless_splice) */
+    uint8_t     i_splice_type;      /*!< splice_type (4 bits) */
+    uint64_t    i_dts_next_au;      /*!< DTS_next_AU (33 bits) */
+} dvbpsi_ts_af_extension_t;
+
+/*****************************************************************************
+ * dvbpsi_ts_adaptation_field_decode
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_ts_adaptation_field_decode(const uint8_t *p_packet,
+                                              dvbpsi_ts_adaptation_field_t *p_af)
+ * \brief Decode the adaptation field of a single TS packet.
+ * \param p_packet pointer to a 188 bytes TS packet
+ * \param p_af pointer to the record to fill in
+ * \return true if the packet carries a valid adaptation field, false
+ * otherwise.
+ *
+ * The record is always initialized: when the packet has no (valid)
+ * adaptation field all flags are cleared and only
+ * dvbpsi_ts_adaptation_field_t::i_pid is set.
+ */
+bool dvbpsi_ts_adaptation_field_decode(const uint8_t *p_packet,
+                                       dvbpsi_ts_adaptation_field_t *p_af);
+
+/*****************************************************************************
+ * dvbpsi_ts_adaptation_fields_decode
+ *****************************************************************************/
+/*!
+ * \fn size_t dvbpsi_ts_adaptation_fields_decode(const uint8_t *p_data,
+                                                 size_t i_packets,
+                                                 dvbpsi_ts_adaptation_field_t *p_af)
+ * \brief Decode the adaptation fields of a buffer of consecutive TS packets.
+ * \param p_data pointer to i_packets * 188 bytes of TS packets
+ * \param i_packets number of TS packets in p_data
+ * \param p_af array of at least i_packets records, one is filled in per
+ * TS packet
+ * \return the number of TS packets that carry a valid adaptation field.
+ */
+size_t dvbpsi_ts_adaptation_fields_decode(const uint8_t *p_data, size_t i_packets,
+                                          dvbpsi_ts_adaptation_field_t *p_af);
+
+/*****************************************************************************
+ * dvbpsi_ts_af_extension_decode
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_ts_af_extension_decode(const uint8_t *p_packet,
+                                          const dvbpsi_ts_adaptation_field_t *p_af,
+                                          dvbpsi_ts_af_extension_t *p_ext)
+ * \brief Decode the adaptation_field_extension of a TS packet.
+ * \param p_packet pointer to the 188 bytes TS packet p_af was decoded from
+ * \param p_af pointer to the decoded adaptation field
+ * \param p_ext pointer to the adaptation field extension to fill in
+ * \return true on success, false if there is no (valid) extension.
+ */
+bool dvbpsi_ts_af_extension_decode(const uint8_t *p_packet,
+                                   const dvbpsi_ts_adaptation_field_t *p_af,
+                                   dvbpsi_ts_af_extension_t *p_ext);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of ts.h"
+#endif